@@ -138,6 +138,39 @@ void ConnectionOptionsTest::testReadOnly()
     }
 }
 
+void ConnectionOptionsTest::testPerformanceProfile()
+{
+    KDbConnectionOptions opt;
+    QCOMPARE(opt.performanceProfile(), KDbConnectionOptions::PerformanceProfile::Default);
+    QCOMPARE(opt.property("performanceProfile").value().toString(), QString("default"));
+    opt.setPerformanceProfile(KDbConnectionOptions::PerformanceProfile::FastWal);
+    QCOMPARE(opt.performanceProfile(), KDbConnectionOptions::PerformanceProfile::FastWal);
+    QCOMPARE(opt.property("performanceProfile").value().toString(), QString("fast-wal"));
+    opt.insert("performanceProfile", "read-mostly-mmap");
+    QCOMPARE(opt.performanceProfile(), KDbConnectionOptions::PerformanceProfile::ReadMostlyMmap);
+    opt.setValue("performanceProfile", "durable");
+    QCOMPARE(opt.performanceProfile(), KDbConnectionOptions::PerformanceProfile::Durable);
+
+    // invalid names are ignored
+    QTest::ignoreMessage(QtWarningMsg, "QVariant(QString, \"fastest\") is not a valid performance profile");
+    opt.setValue("performanceProfile", "fastest");
+    QCOMPARE(opt.performanceProfile(), KDbConnectionOptions::PerformanceProfile::Durable);
+    // can't remove the option
+    opt.remove("performanceProfile");
+    QVERIFY(!opt.property("performanceProfile").isNull());
+
+    bool ok;
+    QCOMPARE(KDbConnectionOptions::performanceProfileForName("fast-wal", &ok),
+             KDbConnectionOptions::PerformanceProfile::FastWal);
+    QVERIFY(ok);
+    QCOMPARE(KDbConnectionOptions::performanceProfileForName("Fast-WAL", &ok),
+             KDbConnectionOptions::PerformanceProfile::Default);
+    QVERIFY(!ok);
+    QCOMPARE(KDbConnectionOptions::performanceProfileName(
+                 KDbConnectionOptions::PerformanceProfile::ReadMostlyMmap),
+             QString("read-mostly-mmap"));
+}
+
 void ConnectionOptionsTest::cleanupTestCase()
 {
 }
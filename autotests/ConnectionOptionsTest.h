@@ -31,6 +31,7 @@ private Q_SLOTS:
     void testCopyAndCompare();
     void testValue();
     void testReadOnly();
+    void testPerformanceProfile();
     void cleanupTestCase();
 };
 
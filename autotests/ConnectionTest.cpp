@@ -18,17 +18,115 @@
 */
 
 #include "ConnectionTest.h"
+#include "KDbStatementBuffer_p.h"
 
+#include <KDbAsyncQuery>
+#include <KDbColumnBatch>
 #include <KDbConnectionData>
 #include <KDbDriverManager>
+#include <KDbDataExport>
+#include <KDbDataImport>
 #include <KDbDriverMetaData>
+#include <KDbExpression>
+#include <KDbLookupFieldSchema>
+#include <KDbNativeStatementBuilder>
+#include <KDbReaderPool>
+#include <KDbRecordData>
+#include <KDbRecordEditBuffer>
+#include <KDbSqlResult>
+#include <KDbTableRebuilder>
+#include <KDbTracer>
+#include <KDbTransactionGuard>
 
+#include <QBuffer>
+#include <QDataStream>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QTest>
+#include <QThread>
+
+#include <functional>
+#include <limits>
 
 QTEST_GUILESS_MAIN(ConnectionTest)
 
+//! Runs a function in a separate thread
+class FunctionThread : public QThread
+{
+public:
+    explicit FunctionThread(const std::function<void()> &function) : m_function(function) {}
+protected:
+    void run() override { m_function(); }
+private:
+    const std::function<void()> m_function;
+};
+
+//! Records progress of export, cancels it after cancelAfter records
+class ExportProgress : public KDbExportProgressHandler
+{
+public:
+    bool exportProgress(qint64 records, qint64 bytes) override {
+        this->records = records;
+        this->bytes = bytes;
+        ++calls;
+        return cancelAfter < 0 || records < cancelAfter;
+    }
+    qint64 records = 0;
+    qint64 bytes = 0;
+    int calls = 0;
+    qint64 cancelAfter = -1;
+};
+
+//! Records progress and errors of import, cancels it after cancelAfter records
+class ImportProgress : public KDbImportProgressHandler
+{
+public:
+    bool importProgress(qint64 records, qint64 bytes) override {
+        this->records = records;
+        this->bytes = bytes;
+        return cancelAfter < 0 || records < cancelAfter;
+    }
+    void importError(const KDbImportError &error) override {
+        errors.append(error);
+    }
+    qint64 records = 0;
+    qint64 bytes = 0;
+    QList<KDbImportError> errors;
+    qint64 cancelAfter = -1;
+};
+
+//! Records progress of copying records by KDbTableRebuilder
+class RebuildProgress : public KDbTableRebuildProgressHandler
+{
+public:
+    bool rebuildProgress(qint64 copiedRecords, qint64 totalRecords, qint64 remainingMsecs) override {
+        copied = copiedRecords;
+        total = totalRecords;
+        remaining = remainingMsecs;
+        ++calls;
+        return cancelAfter < 0 || copiedRecords < cancelAfter;
+    }
+    qint64 copied = 0;
+    qint64 total = 0;
+    qint64 remaining = -1;
+    int calls = 0;
+    qint64 cancelAfter = -1;
+};
+
+//! Records notifications about discarded lookup values
+class LookupValuesListener : public KDbLookupValuesListener
+{
+public:
+    void lookupValuesChanged(KDbConnection *conn, const QString &tableName) override {
+        Q_UNUSED(conn)
+        tableNames.append(tableName);
+    }
+    QStringList tableNames;
+};
+
 void ConnectionTest::initTestCase()
 {
 }
@@ -128,6 +226,1283 @@ void ConnectionTest::testConnectToNonexistingDb()
     QVERIFY2(!utils.connection()->isConnected(), "Should not be connected");
 }
 
+void ConnectionTest::testAsyncQuery()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+
+    QScopedPointer<KDbAsyncQuery> query(
+        utils.connection()->executeQueryAsync(KDbEscapedString("SELECT id, name FROM persons ORDER BY id")));
+    QVERIFY(query);
+    QVERIFY(query->waitForFinished(10000));
+    QVERIFY(!query->isCanceled());
+    QVERIFY2(!query->result().isError(), qPrintable(query->result().message()));
+    QCOMPARE(query->recordCount(), 4);
+    QCOMPARE(query->record(0)->at(0).toInt(), 1);
+    QCOMPARE(query->record(3)->at(1).toString(), QLatin1String("John"));
+
+    QScopedPointer<KDbAsyncQuery> failingQuery(
+        utils.connection()->executeQueryAsync(KDbEscapedString("SELECT * FROM not_existing")));
+    QVERIFY(failingQuery);
+    QVERIFY(failingQuery->waitForFinished(10000));
+    QVERIFY(failingQuery->result().isError());
+
+    // queries are executed in order so the last one may still be queued when canceled
+    QScopedPointer<KDbAsyncQuery> query1(
+        utils.connection()->executeSqlAsync(KDbEscapedString("SELECT 1")));
+    QScopedPointer<KDbAsyncQuery> query2(
+        utils.connection()->executeSqlAsync(KDbEscapedString("SELECT 2")));
+    QVERIFY(query1);
+    QVERIFY(query2);
+    query2->cancel();
+    QVERIFY(query2->waitForFinished(10000));
+    QVERIFY(query1->waitForFinished(10000));
+    QVERIFY(!query1->result().isError());
+
+    // closing the database finishes the pending queries
+    QScopedPointer<KDbAsyncQuery> query3(
+        utils.connection()->executeQueryAsync(KDbEscapedString("SELECT * FROM persons")));
+    QVERIFY(query3);
+    QVERIFY(utils.testDisconnectAndDropDb());
+    QVERIFY(query3->isFinished());
+}
+
+void ConnectionTest::testStatementTimeout()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    const KDbEscapedString longStatement(
+        "WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM c WHERE x < 1000000000) "
+        "SELECT count(*) FROM c");
+
+    QCOMPARE(utils.connection()->statementTimeout(), 0);
+    QVERIFY(utils.connection()->setStatementTimeout(100));
+    QCOMPARE(utils.connection()->statementTimeout(), 100);
+    QVERIFY(!utils.connection()->executeSql(longStatement));
+    QCOMPARE(utils.connection()->result().code(), ERR_QUERY_CANCELED);
+
+    // simple statements are not affected
+    QVERIFY(utils.connection()->executeSql(KDbEscapedString("SELECT 1")));
+
+    // the timeout applies to the whole statement, not to each fetched record
+    KDbCursor *cursor = utils.connection()->executeQuery(KDbEscapedString(
+        "WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM c WHERE x < 1000000000) "
+        "SELECT x FROM c"));
+    QVERIFY(cursor);
+    QVERIFY(!cursor->eof());
+    QTest::qSleep(200);
+    while (cursor->moveNext()) {
+    }
+    QCOMPARE(cursor->result().code(), ERR_QUERY_CANCELED);
+    QVERIFY(utils.connection()->deleteCursor(cursor));
+
+    // the timeout applies to results of prepareSql() too
+    QElapsedTimer timer;
+    timer.start();
+    QSharedPointer<KDbSqlResult> result = utils.connection()->prepareSql(longStatement);
+    QVERIFY(result);
+    QVERIFY(!result->fetchRecord());
+    QVERIFY(result->lastResult().isError());
+    QVERIFY(timer.elapsed() < 10000);
+    result.clear();
+    QVERIFY(utils.connection()->setStatementTimeout(0));
+
+    // canceling interrupts the statement executed by the asynchronous query
+    QScopedPointer<KDbAsyncQuery> query(utils.connection()->executeSqlAsync(longStatement));
+    QVERIFY(query);
+    QTest::qWait(100);
+    query->cancel();
+    QVERIFY(query->waitForFinished(10000));
+    QVERIFY(query->isCanceled());
+
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testWriteBatching()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    const KDbEscapedString countSql("SELECT COUNT(*) FROM persons WHERE id >= 100");
+    int count = -1;
+
+    QVERIFY(!conn->isWriteBatchingEnabled());
+    QVERIFY(conn->setWriteBatchingEnabled(true, 3, 0));
+    QVERIFY(conn->isWriteBatchingEnabled());
+    for (int id = 100; id < 107; ++id) {
+        QVERIFY(conn->insertRecord(persons, id, 30, "Name", "Surname"));
+    }
+    QCOMPARE(conn->writeBatchStatistics().batches, 2);
+    QCOMPARE(conn->writeBatchStatistics().writes, qint64(6));
+    QVERIFY(conn->flushWriteBatch());
+    QCOMPARE(conn->writeBatchStatistics().batches, 3);
+    QCOMPARE(conn->writeBatchStatistics().writes, qint64(7));
+    QCOMPARE(conn->writeBatchStatistics().largestBatch, 3);
+    QVERIFY(conn->querySingleNumber(countSql, &count) == true);
+    QCOMPARE(count, 7);
+
+    // failed write does not affect other writes of the batch
+    QVERIFY(conn->insertRecord(persons, 107, 30, "Name", "Surname"));
+    QVERIFY(!conn->insertRecord(persons, 100, 30, "Duplicated", "Surname"));
+    QVERIFY(conn->insertRecord(persons, 108, 30, "Name", "Surname"));
+
+    // explicit transaction commits the pending batch first
+    {
+        KDbTransactionGuard tg(conn);
+        QVERIFY(tg.transaction().isActive());
+        QCOMPARE(conn->writeBatchStatistics().batches, 4);
+        QVERIFY(conn->insertRecord(persons, 109, 30, "Name", "Surname"));
+        QVERIFY(tg.commit());
+    }
+    QCOMPARE(conn->writeBatchStatistics().writes, qint64(9));
+    QVERIFY(conn->querySingleNumber(countSql, &count) == true);
+    QCOMPARE(count, 10);
+
+    QVERIFY(conn->setWriteBatchingEnabled(false));
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testNormalizedStatement_data()
+{
+    QTest::addColumn<QString>("sql");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("empty") << QString() << QString();
+    QTest::newRow("keywords") << QString("SELECT * FROM Persons")
+                              << QString("select * from persons");
+    QTest::newRow("whitespace") << QString("  SELECT\t*\n\n FROM  persons ")
+                                << QString("select * from persons");
+    QTest::newRow("numbers") << QString("SELECT 1, 2.5, .5, 1e-3, 0x1F FROM t1 WHERE id=17")
+                             << QString("select ?, ?, ?, ?, ? from t1 where id=?");
+    QTest::newRow("strings") << QString("INSERT INTO t VALUES ('abc', 'it''s', '')")
+                             << QString("insert into t values (?, ?, ?)");
+    QTest::newRow("quoted identifiers")
+        << QString("SELECT \"Name 1\", [Age 2], `X` FROM \"T\"\"1\"")
+        << QString("select \"Name 1\", [Age 2], `X` from \"T\"\"1\"");
+}
+
+void ConnectionTest::testNormalizedStatement()
+{
+    QFETCH(QString, sql);
+    QFETCH(QString, expected);
+    QCOMPARE(KDbTracer::normalizedStatement(KDbEscapedString(sql)).toString(), expected);
+    QCOMPARE(KDbTracer::fingerprint(KDbEscapedString(sql)),
+             KDbTracer::fingerprint(KDbEscapedString(expected)));
+}
+
+void ConnectionTest::testTraceStatistics()
+{
+    KDbTraceStatistics stats;
+    QCOMPARE(stats.slowQueryThreshold(), 100);
+    stats.setSlowQueryLogSize(2);
+    KDbTraceEvent event(KDbTraceEvent::Type::ExecuteSql);
+    event.sql = KDbEscapedString("DELETE FROM t WHERE id = 1");
+    event.fingerprint = KDbTracer::fingerprint(event.sql);
+    event.executeTime = 3000; // 3 us
+    stats.traceEvent(event);
+    event.sql = KDbEscapedString("DELETE FROM t WHERE id = 2");
+    event.executeTime = 200000000; // 200 ms
+    event.success = false;
+    stats.traceEvent(event);
+    stats.traceEvent(event);
+    stats.traceEvent(event);
+
+    const KDbTraceStatistics::Statement statement = stats.statement(event.fingerprint);
+    QCOMPARE(statement.count, qint64(4));
+    QCOMPARE(statement.failures, qint64(3));
+    QCOMPARE(statement.normalizedSql, KDbEscapedString("delete from t where id = ?"));
+    QCOMPARE(statement.maxTime, qint64(200000000));
+    QCOMPARE(statement.totalTime, qint64(600003000));
+    QCOMPARE(statement.histogram.count(), KDbTraceStatistics::HistogramSize);
+    QCOMPARE(statement.histogram[2], qint64(1)); // [2, 4) us
+    QCOMPARE(statement.percentile(25), qint64(4000));
+    QCOMPARE(statement.percentile(100), qint64(200000000));
+    QCOMPARE(stats.statements().count(), 1);
+    QCOMPARE(stats.slowQueries().count(), 2); // bounded by the log size
+    QCOMPARE(stats.statement(0).count, qint64(0));
+
+    stats.clear();
+    QVERIFY(stats.statements().isEmpty());
+    QVERIFY(stats.slowQueries().isEmpty());
+}
+
+void ConnectionTest::testTracing()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    int personCount = -1;
+    QVERIFY(conn->querySingleNumber(KDbEscapedString("SELECT COUNT(*) FROM persons"),
+                                    &personCount) == true);
+
+    KDbTraceStatistics stats;
+    QVERIFY(!conn->tracer());
+    conn->setTracer(&stats);
+    QCOMPARE(conn->tracer(), static_cast<KDbTracer*>(&stats));
+
+    const KDbEscapedString update1("UPDATE persons SET age = 31 WHERE id = 1");
+    QVERIFY(conn->executeSql(update1));
+    QVERIFY(conn->executeSql(KDbEscapedString("UPDATE persons SET age=32 WHERE id=2")));
+    QVERIFY(!conn->executeSql(KDbEscapedString("UPDATE nonexisting SET age = 1")));
+    KDbTraceStatistics::Statement statement = stats.statement(KDbTracer::fingerprint(update1));
+    QCOMPARE(statement.count, qint64(2));
+    QCOMPARE(statement.failures, qint64(0));
+    QVERIFY(statement.executeTime > 0);
+    statement = stats.statement(KDbTracer::fingerprint(KDbEscapedString("UPDATE nonexisting SET age = 1")));
+    QCOMPARE(statement.count, qint64(1));
+    QCOMPARE(statement.failures, qint64(1));
+
+    const KDbEscapedString select("SELECT id, name FROM persons");
+    KDbCursor *cursor = conn->executeQuery(select);
+    QVERIFY(cursor);
+    int records = 0;
+    for (cursor->moveFirst(); !cursor->eof(); cursor->moveNext()) {
+        QScopedPointer<KDbRecordData> record(cursor->storeCurrentRecord());
+        QVERIFY(record);
+        ++records;
+    }
+    QCOMPARE(records, personCount);
+    QVERIFY(conn->deleteCursor(cursor));
+    statement = stats.statement(KDbTracer::fingerprint(select));
+    QCOMPARE(statement.count, qint64(2)); // opening and closing
+    QCOMPARE(statement.records, qint64(personCount));
+    QVERIFY(statement.bytes > 0);
+
+    conn->setTracer(nullptr);
+    QVERIFY(conn->executeSql(update1));
+    QCOMPARE(stats.statement(KDbTracer::fingerprint(update1)).count, qint64(2));
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testPerformanceProfile()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    const QString dbPath = utils.connection()->data().databaseName();
+    QVERIFY(utils.testDisconnect());
+    QString value;
+
+    KDbConnectionOptions options;
+    options.setPerformanceProfile(KDbConnectionOptions::PerformanceProfile::FastWal);
+    options.insert("sqliteSynchronous", "FULL"); // override, case-insensitive
+    QVERIFY(utils.testConnectAndUse(dbPath, options));
+    KDbConnection *conn = utils.connection();
+    QVERIFY(conn->querySingleString(KDbEscapedString("PRAGMA journal_mode"), &value) == true);
+    QCOMPARE(value, QString("wal"));
+    QVERIFY(conn->querySingleString(KDbEscapedString("PRAGMA synchronous"), &value) == true);
+    QCOMPARE(value, QString("2")); // FULL
+    QVERIFY(conn->querySingleString(KDbEscapedString("PRAGMA secure_delete"), &value) == true);
+    QCOMPARE(value, QString("0"));
+    QVERIFY(utils.testDisconnect());
+
+    // invalid override
+    options.insert("sqliteJournalMode", "fastest");
+    KDbConnectionData cdata;
+    cdata.setDatabaseName(dbPath);
+    QVERIFY(utils.testConnect(cdata, options));
+    QVERIFY(!utils.connection()->useDatabase());
+    QCOMPARE(utils.connection()->result().code(), ERR_OTHER);
+    QVERIFY(utils.testDisconnect());
+
+    // the default profile keeps secure delete enabled
+    QVERIFY(utils.testConnectAndUse(dbPath));
+    conn = utils.connection();
+    QVERIFY(conn->querySingleString(KDbEscapedString("PRAGMA secure_delete"), &value) == true);
+    QCOMPARE(value, QString("1"));
+    QVERIFY(conn->querySingleString(KDbEscapedString("PRAGMA journal_mode"), &value) == true);
+    QCOMPARE(value, QString("wal")); // WAL mode is persistent
+    QVERIFY(conn->driver()->internalProperty("performance_profiles").value().toStringList()
+            .contains("read-mostly-mmap"));
+    QVERIFY(conn->driver()->internalProperty("performance_profile_fast_wal").value().toString()
+            .contains("journal_mode=wal"));
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testReaderPool()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    const QString dbPath = utils.connection()->data().databaseName();
+    QVERIFY(utils.testDisconnect());
+    KDbConnectionOptions options;
+    options.setPerformanceProfile(KDbConnectionOptions::PerformanceProfile::FastWal);
+    QVERIFY(utils.testConnectAndUse(dbPath, options));
+    KDbConnection *writer = utils.connection();
+    const KDbEscapedString countSql("SELECT COUNT(*) FROM persons");
+    int personCount = -1;
+    QVERIFY(writer->querySingleNumber(countSql, &personCount) == true);
+    QVERIFY(personCount > 0);
+
+    KDbReaderPool pool(writer, 2);
+    QCOMPARE(pool.writer(), writer);
+    QCOMPARE(pool.maxReaders(), 2);
+    QCOMPARE(pool.readerCount(), 0);
+    KDbConnection *reader = pool.reader();
+    QVERIFY(reader);
+    QCOMPARE(pool.reader(), reader); // bound to the current thread
+    QVERIFY(reader->options()->isReadOnly());
+    QCOMPARE(pool.readerCount(), 1);
+    QVERIFY(!reader->executeSql(KDbEscapedString("DELETE FROM persons")));
+
+    // reader of another thread
+    KDbConnection *threadReader = nullptr;
+    int threadCount = -1;
+    FunctionThread thread([&]() {
+        threadReader = pool.reader();
+        if (threadReader) {
+            threadReader->querySingleNumber(countSql, &threadCount);
+        }
+        pool.releaseReader();
+    });
+    thread.start();
+    QVERIFY(thread.wait());
+    QVERIFY(threadReader);
+    QVERIFY(threadReader != reader);
+    QCOMPARE(threadCount, personCount);
+    QCOMPARE(pool.readerCount(), 1);
+
+    // reader of a finished thread is released automatically, results are kept per thread
+    threadReader = nullptr;
+    int threadResultCode = ERR_NONE;
+    FunctionThread finishingThread([&]() {
+        threadReader = pool.reader();
+        pool.endSnapshot();
+        threadResultCode = pool.result().code();
+    });
+    finishingThread.start();
+    QVERIFY(finishingThread.wait());
+    QVERIFY(threadReader);
+    QCOMPARE(threadResultCode, ERR_NO_TRANSACTION_ACTIVE);
+    QVERIFY(!pool.result().isError());
+    QCOMPARE(pool.readerCount(), 1);
+
+    // snapshots
+    KDbReadSnapshot snapshot = pool.pinSnapshot();
+    if (snapshot.isNull()) {
+        QCOMPARE(pool.result().code(), ERR_UNSUPPORTED_DRV_FEATURE);
+        QVERIFY(!pool.endSnapshot());
+    } else {
+        QVERIFY(!pool.beginSnapshot(snapshot)); // already in snapshot
+        QVERIFY(writer->executeSql(KDbEscapedString("DELETE FROM persons WHERE id = 1")));
+        int count = -1;
+        QVERIFY(reader->querySingleNumber(countSql, &count) == true);
+        QCOMPARE(count, personCount); // pinned state
+        count = -1;
+        bool snapshotOpened = false;
+        FunctionThread snapshotThread([&]() {
+            snapshotOpened = pool.beginSnapshot(snapshot);
+            if (snapshotOpened) {
+                pool.reader()->querySingleNumber(countSql, &count);
+                pool.endSnapshot();
+            }
+            pool.releaseReader();
+        });
+        snapshotThread.start();
+        QVERIFY(snapshotThread.wait());
+        QVERIFY(snapshotOpened);
+        QCOMPARE(count, personCount);
+        QVERIFY(pool.endSnapshot());
+        QVERIFY(reader->querySingleNumber(countSql, &count) == true);
+        QCOMPARE(count, personCount - 1);
+    }
+    QVERIFY(pool.releaseReader());
+    QCOMPARE(pool.readerCount(), 0);
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testExportData()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    QVERIFY(conn->insertRecord(persons, 100, 30, "Doe, \"Jr\"", "Multi\nline"));
+    int personCount = -1;
+    QVERIFY(conn->querySingleNumber(KDbEscapedString("SELECT COUNT(*) FROM persons"),
+                                    &personCount) == true);
+    QVERIFY(personCount > 2);
+
+    // CSV
+    QByteArray data;
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    KDbExportOptions options;
+    QCOMPARE(options.format(), KDbExportFormat::Csv);
+    options.setBatchSize(2);
+    options.setMaxPendingBatches(1);
+    ExportProgress progress;
+    QVERIFY(conn->exportData(persons, &buffer, options, &progress) == true);
+    buffer.close();
+    QCOMPARE(progress.records, qint64(personCount));
+    QCOMPARE(progress.bytes, qint64(data.size()));
+    QCOMPARE(progress.calls, (personCount + 1) / 2);
+    QVERIFY(data.startsWith("id,age,name,surname\r\n"));
+    QVERIFY(data.contains("\r\n100,30,\"Doe, \"\"Jr\"\"\",\"Multi\nline\"\r\n"));
+
+    // JSON Lines
+    data.clear();
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    options.setFormat(KDbExportFormat::JsonLines);
+    QVERIFY(conn->exportData(persons, &buffer, options) == true);
+    buffer.close();
+    QList<QByteArray> lines = data.split('\n');
+    QCOMPARE(lines.count(), personCount + 1);
+    QVERIFY(lines.last().isEmpty());
+    for (int i = 0; i < personCount; ++i) {
+        const QJsonObject object = QJsonDocument::fromJson(lines[i]).object();
+        QCOMPARE(object.count(), 4);
+        if (object.value("id").toInt() == 100) {
+            QCOMPARE(object.value("name").toString(), QString("Doe, \"Jr\""));
+            QCOMPARE(object.value("surname").toString(), QString("Multi\nline"));
+            QCOMPARE(object.value("age").toInt(), 30);
+        }
+    }
+
+    // columnar
+    data.clear();
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    options.setFormat(KDbExportFormat::Columnar);
+    QVERIFY(conn->exportData(persons, &buffer, options) == true);
+    buffer.close();
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_4);
+    quint32 magic;
+    quint16 version;
+    quint32 columnCount;
+    stream >> magic >> version >> columnCount;
+    QCOMPARE(magic, quint32(0x4B444243));
+    QCOMPARE(version, quint16(1));
+    QCOMPARE(columnCount, quint32(4));
+    QString name;
+    qint32 type;
+    stream >> name >> type;
+    QCOMPARE(name, QString("id"));
+    QCOMPARE(type, qint32(KDbField::Integer));
+    for (int i = 1; i < 4; ++i) {
+        stream >> name >> type;
+    }
+    quint32 groupSize;
+    stream >> groupSize;
+    QCOMPARE(groupSize, quint32(2));
+    QByteArray nulls;
+    stream >> nulls;
+    QCOMPARE(nulls, QByteArray(1, '\0'));
+    qint64 id;
+    stream >> id;
+    QVERIFY(id > 0);
+    QCOMPARE(stream.status(), QDataStream::Ok);
+    QVERIFY(data.endsWith(QByteArray(4, '\0'))); // empty group ends the data
+
+    // cancellation
+    data.clear();
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    progress = ExportProgress();
+    progress.cancelAfter = 2;
+    options.setFormat(KDbExportFormat::Csv);
+    QVERIFY(conn->exportData(persons, &buffer, options, &progress) == cancelled);
+    QCOMPARE(progress.records, qint64(2));
+    buffer.close();
+
+    QVERIFY(!conn->exportData(persons, nullptr, options));
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testImportData()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    const KDbEscapedString countSql("SELECT COUNT(*) FROM persons");
+    int personCount = -1;
+    QVERIFY(conn->querySingleNumber(countSql, &personCount) == true);
+
+    // columns in other order, quoted values, line breaks and rejected records;
+    // small chunks so records are parsed by many tasks
+    QByteArray data("id,name,age,surname\r\n"
+                    "10,\"Doe, \"\"Jr\"\"\",30,\"Multi\nline\"\r\n"
+                    "11,Anne,-5,Smith\r\n"
+                    "12,Bob,,\r\n"
+                    "13,Carl,abc,Brown\n"
+                    "\n"
+                    "14,Dave,40,Green");
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    KDbImportOptions options;
+    QVERIFY(options.hasHeader());
+    options.setChunkSize(16);
+    options.setThreadCount(2);
+    options.setMaxErrors(-1);
+    ImportProgress progress;
+    QVERIFY(conn->importData(&buffer, persons, options, &progress) == true);
+    buffer.close();
+    QCOMPARE(progress.records, qint64(3));
+    QCOMPARE(progress.bytes, qint64(data.size()));
+    QCOMPARE(progress.errors.count(), 2);
+    QCOMPARE(progress.errors[0].line, qint64(4));
+    QCOMPARE(progress.errors[0].column, 2); // unsigned age
+    QCOMPARE(progress.errors[0].record, QString("11,Anne,-5,Smith"));
+    QCOMPARE(progress.errors[1].line, qint64(6));
+    QCOMPARE(progress.errors[1].column, 2);
+    int count = -1;
+    QVERIFY(conn->querySingleNumber(countSql, &count) == true);
+    QCOMPARE(count, personCount + 3);
+    QString text;
+    QVERIFY(conn->querySingleString(KDbEscapedString("SELECT name FROM persons WHERE id=10"),
+                                    &text) == true);
+    QCOMPARE(text, QString("Doe, \"Jr\""));
+    QVERIFY(conn->querySingleString(KDbEscapedString("SELECT surname FROM persons WHERE id=10"),
+                                    &text) == true);
+    QCOMPARE(text, QString("Multi\nline"));
+    QVERIFY(conn->querySingleNumber(
+                KDbEscapedString("SELECT COUNT(*) FROM persons WHERE id=12 AND age IS NULL"),
+                &count) == true);
+    QCOMPARE(count, 1);
+    personCount += 3;
+
+    // quotes inside unquoted values do not start quoted values, also when splitting chunks
+    data = "id;name;age;surname\n"
+           "15;O\"Brien;30;Smith\n"
+           "16;Anne;31;\"Multi\nline\"\n"
+           "17;Bob;32;\"Quoted\"\" \"\n";
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    options.setDelimiter(QLatin1Char(';'));
+    options.setChunkSize(1);
+    options.setMaxErrors(0);
+    progress = ImportProgress();
+    QVERIFY(conn->importData(&buffer, persons, options, &progress) == true);
+    buffer.close();
+    QCOMPARE(progress.records, qint64(3));
+    QVERIFY(progress.errors.isEmpty());
+    QVERIFY(conn->querySingleString(KDbEscapedString("SELECT name FROM persons WHERE id=15"),
+                                    &text) == true);
+    QCOMPARE(text, QString("O\"Brien"));
+    QVERIFY(conn->querySingleString(KDbEscapedString("SELECT surname FROM persons WHERE id=16"),
+                                    &text) == true);
+    QCOMPARE(text, QString("Multi\nline"));
+    QVERIFY(conn->querySingleString(KDbEscapedString("SELECT surname FROM persons WHERE id=17"),
+                                    &text) == true);
+    QCOMPARE(text, QString("Quoted\" "));
+    personCount += 3;
+
+    // by default the first rejected record fails the import and nothing is inserted
+    data = "20,21,Eve,Black\n21,x,Frank,White\n";
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    options = KDbImportOptions();
+    options.setHasHeader(false);
+    QVERIFY(conn->importData(&buffer, persons, options) == false);
+    buffer.close();
+    QVERIFY(conn->result().isError());
+    QVERIFY(conn->querySingleNumber(countSql, &count) == true);
+    QCOMPARE(count, personCount);
+
+    // cancellation rolls back inserted records
+    data = "30,31,Gary,Black\n31,32,Helen,White\n";
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    options.setChunkSize(1);
+    progress = ImportProgress();
+    progress.cancelAfter = 1;
+    QVERIFY(conn->importData(&buffer, persons, options, &progress) == cancelled);
+    buffer.close();
+    QCOMPARE(progress.records, qint64(1));
+    QVERIFY(conn->querySingleNumber(countSql, &count) == true);
+    QCOMPARE(count, personCount);
+
+    // unknown column
+    data = "id,weight\n1,2\n";
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QVERIFY(conn->importData(&buffer, persons) == false);
+    buffer.close();
+
+    // table inferred from the data
+    data = "Name,Born,Score,Active,Amount\n"
+           "Ann,2001-02-03,1.5,true,5000000000\n"
+           "Bob,1999-12-31,2,FALSE,\n";
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QScopedPointer<KDbTableSchema> inferred(KDb::inferImportTableSchema(&buffer, "inferred"));
+    QVERIFY(inferred);
+    QCOMPARE(buffer.pos(), qint64(0));
+    QCOMPARE(inferred->fieldCount(), 5);
+    QCOMPARE(inferred->field(0)->name(), QString("name"));
+    QCOMPARE(inferred->field(0)->type(), KDbField::Text);
+    QCOMPARE(inferred->field(1)->type(), KDbField::Date);
+    QCOMPARE(inferred->field(2)->type(), KDbField::Double);
+    QCOMPARE(inferred->field(3)->type(), KDbField::Boolean);
+    QCOMPARE(inferred->field(4)->type(), KDbField::BigInteger);
+    QVERIFY(conn->createTable(inferred.data()));
+    KDbTableSchema *table = inferred.take(); // owned by the connection now
+    QVERIFY(conn->importData(&buffer, table) == true);
+    buffer.close();
+    QVERIFY(conn->querySingleNumber(
+                KDbEscapedString("SELECT COUNT(*) FROM inferred WHERE amount IS NULL"),
+                &count) == true);
+    QCOMPARE(count, 1);
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testTableRebuilder()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    int personCount = -1;
+    QVERIFY(conn->querySingleNumber(KDbEscapedString("SELECT COUNT(*) FROM persons"),
+                                    &personCount) == true);
+    QCOMPARE(personCount, 4);
+
+    // renamed field and field of other type
+    KDbTableSchema *copy = new KDbTableSchema("persons_copy");
+    QVERIFY(copy->addField(new KDbField("id", KDbField::Integer, KDbField::PrimaryKey,
+                                        KDbField::Unsigned)));
+    QVERIFY(copy->addField(new KDbField("fullname", KDbField::Text)));
+    QVERIFY(copy->addField(new KDbField("age", KDbField::Text)));
+    QVERIFY(conn->createTable(copy));
+    const KDbEscapedString countSql("SELECT COUNT(*) FROM persons_copy");
+
+    // cancelled after two chunks of one record
+    RebuildProgress progress;
+    progress.cancelAfter = 2;
+    QVariant lastKey;
+    {
+        KDbTableRebuilder rebuilder(conn, persons, copy);
+        rebuilder.setChunkSize(1);
+        rebuilder.setProgressHandler(&progress);
+        rebuilder.setSourceFieldsByName();
+        rebuilder.setSourceField("fullname", "name");
+        QVERIFY(rebuilder.copyData() == cancelled);
+        QVERIFY(!rebuilder.isFinished());
+        QCOMPARE(rebuilder.copiedRecords(), qint64(2));
+        lastKey = rebuilder.lastKey();
+        QCOMPARE(lastKey.toInt(), 2);
+    }
+    QCOMPARE(progress.calls, 2);
+    QCOMPARE(progress.total, qint64(personCount));
+    QVERIFY(progress.remaining >= 0);
+    int count = -1;
+    QVERIFY(conn->querySingleNumber(countSql, &count) == true);
+    QCOMPARE(count, 2); // committed chunks are kept
+
+    // resumed by other rebuilder
+    progress = RebuildProgress();
+    {
+        KDbTableRebuilder rebuilder(conn, persons, copy);
+        rebuilder.setChunkSize(1);
+        rebuilder.setProgressHandler(&progress);
+        rebuilder.setSourceFieldsByName();
+        rebuilder.setSourceField("fullname", "name");
+        rebuilder.resume(lastKey, 2);
+        QVERIFY(rebuilder.copyData() == true);
+        QVERIFY(rebuilder.isFinished());
+        QCOMPARE(rebuilder.copiedRecords(), qint64(personCount));
+        QVERIFY(rebuilder.copyData() == true); // nothing more to copy
+    }
+    QCOMPARE(progress.copied, qint64(personCount));
+    QCOMPARE(progress.remaining, qint64(0));
+    QVERIFY(conn->querySingleNumber(countSql, &count) == true);
+    QCOMPARE(count, personCount);
+    QString text;
+    QVERIFY(conn->querySingleString(
+                KDbEscapedString("SELECT fullname FROM persons_copy WHERE id=3"), &text) == true);
+    QCOMPARE(text, QString("Bill"));
+    QVERIFY(conn->querySingleString(
+                KDbEscapedString("SELECT age FROM persons_copy WHERE id=3"), &text) == true);
+    QCOMPARE(text, QString("45"));
+
+    // altering non-empty table keeps its records
+    KDbTableSchema *newPersons = new KDbTableSchema(*persons, false);
+    QVERIFY(newPersons->addField(new KDbField("city", KDbField::Text)));
+    QVERIFY(conn->alterTable(persons, newPersons) == true);
+    persons = conn->tableSchema("persons");
+    QCOMPARE(persons, newPersons);
+    QVERIFY(persons->field("city"));
+    QVERIFY(conn->querySingleNumber(KDbEscapedString("SELECT COUNT(*) FROM persons"),
+                                    &count) == true);
+    QCOMPARE(count, personCount);
+    QVERIFY(conn->querySingleString(
+                KDbEscapedString("SELECT surname FROM persons WHERE id=2"), &text) == true);
+    QCOMPARE(text, QString("Walesa"));
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testStatementBuffer()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbStatementBuffer buffer(conn->driver(), 16);
+    KDbStatementBuffer kdbBuffer(nullptr, 16);
+
+    // identifiers are escaped in the same way as with the driver
+    const QStringList names({ "persons", "name_1", "", "select", "with \"quote\"", "with space",
+                              QString::fromUtf8("zażółć"), "back`tick", "x%1" });
+    for (const QString &name : names) {
+        buffer.clear();
+        buffer.appendIdentifier(name);
+        QCOMPARE(buffer.statement(), KDbEscapedString(conn->escapeIdentifier(name)));
+        kdbBuffer.clear();
+        kdbBuffer.appendIdentifier(name);
+        QCOMPARE(kdbBuffer.statement(), KDbEscapedString(KDb::escapeIdentifier(name)));
+    }
+
+    // numbers and values
+    buffer.clear();
+    buffer.appendNumber(0).append(',').appendNumber(-42).append(',')
+          .appendNumber(std::numeric_limits<qint64>::min()).append(',')
+          .appendNumber(std::numeric_limits<qint64>::max());
+    QCOMPARE(buffer.statement(),
+             KDbEscapedString("0,-42,-9223372036854775808,9223372036854775807"));
+    buffer.clear();
+    buffer.appendValue(KDbField::Text, QString("it's")).append(',').appendParameter();
+    QCOMPARE(buffer.statement(),
+             conn->driver()->valueToSql(KDbField::Text, QString("it's")) + ",?");
+
+    // a copy of the statement is not affected by reusing the buffer
+    buffer.clear();
+    buffer.append("DELETE FROM ").appendIdentifier("persons");
+    const KDbEscapedString statement(buffer.statement());
+    buffer.clear();
+    buffer.append("SELECT 1");
+    QCOMPARE(statement, KDbEscapedString("DELETE FROM ") + conn->escapeIdentifier("persons"));
+    QCOMPARE(buffer.statement(), KDbEscapedString("SELECT 1"));
+
+    // invalid values make the statement invalid until the buffer is cleared
+    buffer.append(KDbEscapedString::invalid()).appendIdentifier("persons");
+    QVERIFY(!buffer.statement().isValid());
+    buffer.clear();
+    QVERIFY(buffer.statement().isValid());
+    QVERIFY(buffer.isEmpty());
+
+    // data modification statements built by the connection
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    QVERIFY(conn->insertRecord(persons, 10, 33, "Ada", "O'Brien"));
+    QVERIFY(conn->insertRecord(persons, QList<QVariant>({ 11, 44, "Bob", "%1 \"x\"" })));
+    QString text;
+    QVERIFY(conn->querySingleString(
+                KDbEscapedString("SELECT surname FROM persons WHERE id=10"), &text) == true);
+    QCOMPARE(text, QString("O'Brien"));
+    QVERIFY(conn->querySingleString(
+                KDbEscapedString("SELECT surname FROM persons WHERE id=11"), &text) == true);
+    QCOMPARE(text, QString("%1 \"x\""));
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testDmlPlans()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    KDbQuerySchema *query = persons->query();
+    const KDbQueryColumnInfo::Vector columns(query->fieldsExpanded(conn));
+    QCOMPARE(columns.count(), 4); // id, age, name, surname
+    const auto surname = [conn](const QString &table, int id) {
+        QString text;
+        if (true != conn->querySingleString(
+                KDbEscapedString("SELECT surname FROM %1 WHERE id=%2").arg(table).arg(id), &text))
+        {
+            return QString("<none>");
+        }
+        return text;
+    };
+
+    // insert, then update the same columns several times
+    KDbRecordData data(columns.count());
+    KDbRecordEditBuffer buf(true);
+    buf.insert(columns[0], 10);
+    buf.insert(columns[1], 20);
+    buf.insert(columns[2], "Ann");
+    buf.insert(columns[3], "O'Neil");
+    QVERIFY(conn->insertRecord(query, &data, &buf));
+    QCOMPARE(data.at(3).toString(), QString("O'Neil"));
+    QCOMPARE(surname("persons", 10), QString("O'Neil"));
+    const QStringList surnames({ "Lee", "%1", "Lee-Smith" });
+    for (const QString &name : surnames) {
+        buf.clear();
+        buf.insert(columns[3], name);
+        QVERIFY(conn->updateRecord(query, &data, &buf));
+        QCOMPARE(data.at(3).toString(), name);
+        QCOMPARE(surname("persons", 10), name);
+    }
+    // other set of columns
+    buf.clear();
+    buf.insert(columns[1], 21);
+    buf.insert(columns[3], "Doe");
+    QVERIFY(conn->updateRecord(query, &data, &buf));
+    QCOMPARE(data.at(1).toInt(), 21);
+    QCOMPARE(surname("persons", 10), QString("Doe"));
+
+    // empty primary key is not accepted
+    KDbRecordData emptyKeyData(columns.count());
+    QVERIFY(!conn->updateRecord(query, &emptyKeyData, &buf));
+    QCOMPARE(conn->result().code(), ERR_UPDATE_NULL_PKEY_FIELD);
+    QVERIFY(!conn->deleteRecord(query, &emptyKeyData));
+    QCOMPARE(conn->result().code(), ERR_DELETE_NULL_PKEY_FIELD);
+
+    // plans are not reused after the table is renamed
+    QVERIFY(conn->alterTableName(persons, "people"));
+    buf.clear();
+    buf.insert(columns[3], "Renamed");
+    QVERIFY(conn->updateRecord(query, &data, &buf));
+    QCOMPARE(surname("people", 10), QString("Renamed"));
+    QVERIFY(conn->deleteRecord(query, &data));
+    QCOMPARE(surname("people", 10), QString("<none>"));
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testLookupValueCache()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *cars = conn->tableSchema("cars");
+    QVERIFY(cars);
+    // cars.owner displays name of the person
+    KDbLookupFieldSchema *lookup = new KDbLookupFieldSchema;
+    KDbLookupFieldSchemaRecordSource recordSource;
+    recordSource.setType(KDbLookupFieldSchemaRecordSource::Type::Table);
+    recordSource.setName("persons");
+    lookup->setRecordSource(recordSource);
+    lookup->setBoundColumn(0);
+    lookup->setVisibleColumns(QList<int>({ 2 }));
+    QVERIFY(cars->setLookupFieldSchema("owner", lookup));
+    KDbQuerySchema query(cars);
+    KDbQueryColumnInfo *ownerColumn = query.visibleFieldsExpanded(conn).value(1);
+    QVERIFY(ownerColumn);
+    QVERIFY(ownerColumn->indexForVisibleLookupValue() >= 0);
+    // visible values of owners ordered by car id
+    QString sql;
+    const auto ownerNames = [conn, &query, ownerColumn, &sql]() {
+        QStringList names;
+        KDbCursor *cursor = conn->executeQuery(&query);
+        if (!cursor) {
+            return names;
+        }
+        sql = cursor->result().sql().toString();
+        for (; !cursor->eof(); cursor->moveNext()) {
+            KDbRecordData data;
+            if (!cursor->storeCurrentRecord(&data)) {
+                break;
+            }
+            names.append(data.at(ownerColumn->indexForVisibleLookupValue()).toString());
+        }
+        conn->deleteCursor(cursor);
+        return names;
+    };
+    const QStringList expectedNames({ "Jaroslaw", "Lech", "Bill", "Bill", "John" });
+
+    // disabled by default: lookup table is joined
+    QCOMPARE(conn->lookupValueCacheLimit(), 0);
+    QCOMPARE(ownerNames(), expectedNames);
+    QVERIFY(sql.contains("LEFT OUTER JOIN"));
+    QVariant visibleValue;
+    QVERIFY(~conn->lookupVisibleValue(*lookup, 3, &visibleValue));
+
+    // small lookup table is cached
+    conn->setLookupValueCacheLimit(100);
+    QCOMPARE(ownerNames(), expectedNames);
+    QVERIFY(!sql.contains("LEFT OUTER JOIN"));
+    QVERIFY(conn->lookupVisibleValue(*lookup, 3, &visibleValue) == true);
+    QCOMPARE(visibleValue.toString(), QString("Bill"));
+    QVERIFY(conn->lookupVisibleValue(*lookup, 1000, &visibleValue) == false);
+    QVERIFY(visibleValue.isNull());
+
+    // edits of the lookup table discard cached values, other edits do not
+    LookupValuesListener listener;
+    conn->addLookupValuesListener(&listener);
+    QVERIFY(conn->executeSql(KDbEscapedString("UPDATE cars SET model='Polonez' WHERE id=2")));
+    QVERIFY(listener.tableNames.isEmpty());
+    QVERIFY(conn->executeSql(KDbEscapedString("UPDATE persons SET name='William' WHERE id=3")));
+    QCOMPARE(listener.tableNames, QStringList({ "persons" }));
+    QCOMPARE(ownerNames(), QStringList({ "Jaroslaw", "Lech", "William", "William", "John" }));
+    QVERIFY(conn->insertRecord(conn->tableSchema("persons"), 5, 50, "Ann", "Lee"));
+    QCOMPARE(listener.tableNames, QStringList({ "persons", "persons" }));
+    conn->clearLookupValueCache();
+    QCOMPARE(listener.tableNames, QStringList({ "persons", "persons" })); // nothing was cached
+    QVERIFY(conn->lookupVisibleValue(*lookup, 5, &visibleValue) == true);
+    QCOMPARE(visibleValue.toString(), QString("Ann"));
+    conn->clearLookupValueCache();
+    QCOMPARE(listener.tableNames, QStringList({ "persons", "persons", QString() }));
+    conn->removeLookupValuesListener(&listener);
+
+    // lookup table larger than the limit is joined
+    conn->setLookupValueCacheLimit(2);
+    QVERIFY(~conn->lookupVisibleValue(*lookup, 3, &visibleValue));
+    QCOMPARE(ownerNames(), QStringList({ "Jaroslaw", "Lech", "William", "William", "John" }));
+    QVERIFY(sql.contains("LEFT OUTER JOIN"));
+    conn->setLookupValueCacheLimit(0);
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testResultCache()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    KDbQuerySchema query(persons);
+    // types and values of all records of the query
+    const auto records = [conn, &query]() {
+        QStringList values;
+        KDbCursor *cursor = conn->executeQuery(&query);
+        if (!cursor) {
+            return values;
+        }
+        for (; !cursor->eof(); cursor->moveNext()) {
+            for (int i = 0; i < 3; ++i) {
+                const QVariant value(cursor->value(i));
+                values.append(QString::fromLatin1(value.typeName()) + QLatin1Char(':')
+                              + value.toString());
+            }
+        }
+        conn->deleteCursor(cursor);
+        return values;
+    };
+    // second connection modifies data without informing the cache
+    QScopedPointer<KDbConnection> other(conn->driver()->createConnection(conn->data()));
+    QVERIFY(other);
+    QVERIFY(other->connect());
+    QVERIFY(other->useDatabase(conn->currentDatabase()));
+    const KDbEscapedString renameBill("UPDATE persons SET name='William' WHERE name='Bill'");
+    const KDbEscapedString renameWilliam("UPDATE persons SET name='Bill' WHERE name='William'");
+    const QString william("QString:William");
+
+    // disabled by default
+    QCOMPARE(conn->resultCacheSize(), 0);
+    const QStringList initialRecords(records());
+    QVERIFY(initialRecords.contains("QString:Bill"));
+    QVERIFY(other->executeSql(renameBill));
+    QVERIFY(records().contains(william));
+    QVERIFY(other->executeSql(renameWilliam));
+
+    // results are stored and then read from the cache
+    conn->setResultCacheSize(1024 * 1024);
+    QCOMPARE(conn->resultCacheSize(), 1024 * 1024);
+    QCOMPARE(records(), initialRecords);
+    QVERIFY(other->executeSql(renameBill));
+    QCOMPARE(records(), initialRecords);
+
+    // modifications of other tables do not discard the result
+    QVERIFY(conn->executeSql(KDbEscapedString("UPDATE cars SET model='Polonez' WHERE id=2")));
+    QCOMPARE(records(), initialRecords);
+
+    // modifications of the table discard results of the query
+    QVERIFY(conn->executeSql(KDbEscapedString("UPDATE persons SET age=60 WHERE id=1")));
+    const QStringList modifiedRecords(records());
+    QVERIFY(modifiedRecords.contains(william));
+    QVERIFY(other->executeSql(renameWilliam));
+    QCOMPARE(records(), modifiedRecords);
+
+    // failed statements do not discard results
+    QVERIFY(!conn->executeSql(KDbEscapedString("UPDATE persons SET nonexisting=1 WHERE id=1")));
+    QCOMPARE(records(), modifiedRecords);
+
+    // prepared statements discard results once they are executed
+    QSharedPointer<KDbSqlResult> update(
+        conn->prepareSql(KDbEscapedString("UPDATE persons SET age=61 WHERE id=1")));
+    QVERIFY(update);
+    QVERIFY(!update->fetchRecord());
+    QVERIFY2(!update->lastResult().isError(), qPrintable(update->lastResult().message()));
+    update.clear();
+    QVERIFY(records().contains("QString:Bill"));
+    QVERIFY(other->executeSql(renameBill));
+    QVERIFY(records().contains("QString:Bill"));
+    QVERIFY(other->executeSql(renameWilliam));
+    conn->clearResultCache();
+    QVERIFY(records().contains("QString:Bill"));
+
+    // schema qualifiers of table names are ignored
+    QVERIFY(other->executeSql(renameBill));
+    QVERIFY(conn->executeSql(KDbEscapedString("UPDATE \"main\".\"persons\" SET age=60 WHERE id=1")));
+    QVERIFY(records().contains(william));
+    QVERIFY(other->executeSql(renameWilliam));
+    QVERIFY(conn->executeSql(KDbEscapedString("DELETE FROM main.persons WHERE id=0")));
+    QVERIFY(records().contains("QString:Bill"));
+
+    // modifications performed by triggers are not detected, see setResultCacheSize()
+    QVERIFY(conn->executeSql(KDbEscapedString(
+        "CREATE TRIGGER rename_bill AFTER UPDATE ON cars "
+        "BEGIN UPDATE persons SET name='William' WHERE name='Bill'; END")));
+    QVERIFY(records().contains("QString:Bill"));
+    QVERIFY(conn->executeSql(KDbEscapedString("UPDATE cars SET model='Syrena' WHERE id=2")));
+    QVERIFY(records().contains("QString:Bill"));
+    conn->clearResultCache();
+    QVERIFY(records().contains(william));
+    QVERIFY(conn->executeSql(KDbEscapedString("DROP TRIGGER rename_bill")));
+    QVERIFY(conn->executeSql(renameWilliam));
+    QVERIFY(records().contains("QString:Bill"));
+
+    // results larger than the cache are not stored
+    conn->setResultCacheSize(10);
+    QVERIFY(records().contains("QString:Bill"));
+    QVERIFY(other->executeSql(renameBill));
+    QVERIFY(records().contains(william));
+
+    // asynchronous modifications discard results once they are executed
+    conn->setResultCacheSize(1024 * 1024);
+    QVERIFY(records().contains(william));
+    QScopedPointer<KDbAsyncQuery> asyncRename(conn->executeSqlAsync(renameWilliam));
+    QVERIFY(asyncRename);
+    QVERIFY(asyncRename->waitForFinished(10000));
+    QVERIFY2(!asyncRename->result().isError(), qPrintable(asyncRename->result().message()));
+    QVERIFY(records().contains("QString:Bill"));
+    conn->setResultCacheSize(0);
+    QVERIFY(other->disconnect());
+    other.reset();
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testPrefetchCursor()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    const KDbEscapedString sql("SELECT id, name, age FROM persons ORDER BY id");
+    // types and values of all records of the cursor
+    const auto records = [](KDbCursor *cursor) {
+        QStringList values;
+        for (; !cursor->eof(); cursor->moveNext()) {
+            KDbRecordData data;
+            if (!cursor->storeCurrentRecord(&data)) {
+                values.append(QLatin1String("error"));
+            }
+            for (int i = 0; i < cursor->fieldCount(); ++i) {
+                const QVariant value(cursor->value(i));
+                values.append(QString::fromLatin1(value.typeName()) + QLatin1Char(':')
+                              + value.toString() + QLatin1Char('/') + data.value(i).toString());
+            }
+        }
+        return values;
+    };
+
+    KDbCursor *cursor = conn->executeQuery(persons);
+    QVERIFY(cursor);
+    const QStringList tableRecords(records(cursor));
+    QVERIFY(tableRecords.count() >= 3 * 3);
+    QVERIFY(conn->deleteCursor(cursor));
+    cursor = conn->executeQuery(sql);
+    QVERIFY(cursor);
+    const QStringList sqlRecords(records(cursor));
+    QVERIFY(conn->deleteCursor(cursor));
+
+    // the same records are returned with the option, also if only one record is prefetched
+    for (int depth : { 1, 2, 1024 }) {
+        cursor = conn->prepareQuery(persons, KDbCursor::Option::Prefetch);
+        QVERIFY(cursor);
+        QVERIFY(cursor->options() & KDbCursor::Option::Prefetch);
+        QVERIFY(!cursor->isBuffered());
+        QCOMPARE(cursor->prefetchDepth(), 1024);
+        cursor->setPrefetchDepth(depth);
+        QVERIFY(cursor->open());
+        QCOMPARE(records(cursor), tableRecords);
+        // reopening starts fetching again
+        QVERIFY(cursor->reopen());
+        QCOMPARE(records(cursor), tableRecords);
+        QVERIFY(conn->deleteCursor(cursor));
+        cursor = conn->executeQuery(sql, KDbCursor::Option::Prefetch);
+        QVERIFY(cursor);
+        QCOMPARE(records(cursor), sqlRecords);
+        QVERIFY(conn->deleteCursor(cursor));
+    }
+
+    // closing stops fetching of records that were not consumed
+    cursor = conn->prepareQuery(persons, KDbCursor::Option::Prefetch);
+    QVERIFY(cursor);
+    cursor->setPrefetchDepth(1);
+    QVERIFY(cursor->open());
+    QVERIFY(cursor->moveFirst());
+    QVERIFY(cursor->close());
+    QVERIFY(cursor->open());
+    QVERIFY(!cursor->eof());
+    QVERIFY(conn->deleteCursor(cursor));
+
+    // errors of the fetching cursor are reported with the original message
+    // (abs() overflows for id=3)
+    cursor = conn->executeQuery(
+        KDbEscapedString("SELECT id, abs(-9223372036854775805 - id) FROM persons"),
+        KDbCursor::Option::Prefetch);
+    QVERIFY(cursor);
+    while (cursor->moveNext()) {
+    }
+    QVERIFY(cursor->result().isError());
+    QCOMPARE(cursor->result().code(), ERR_CURSOR_RECORD_FETCHING);
+    QVERIFY2(cursor->result().serverMessage().contains("integer overflow"),
+             qPrintable(cursor->result().serverMessage()));
+    // the connection deletes the cursor together with its driver's cursor
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testFetchBatch()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    QVERIFY(conn->executeSql(KDbEscapedString("UPDATE persons SET name=NULL WHERE id=4")));
+    // values of all records of the cursor as strings
+    const auto records = [](KDbCursor *cursor) {
+        QStringList values;
+        for (; !cursor->eof(); cursor->moveNext()) {
+            for (int i = 0; i < cursor->fieldCount(); ++i) {
+                const QVariant value(cursor->value(i));
+                values.append(value.isNull() ? QString::fromLatin1("NULL") : value.toString());
+            }
+        }
+        return values;
+    };
+    // values of all records fetched in batches of batchSize records
+    const auto batchRecords = [](KDbCursor *cursor, KDbColumnBatch *batch, int batchSize) {
+        QStringList values;
+        int count;
+        while ((count = cursor->fetchBatch(batch, batchSize)) > 0) {
+            if (count > batchSize || batch->recordCount() != count
+                || batch->columnCount() != cursor->fieldCount())
+            {
+                return QStringList();
+            }
+            for (int r = 0; r < count; ++r) {
+                for (int i = 0; i < batch->columnCount(); ++i) {
+                    const QVariant value(batch->value(r, i));
+                    values.append(batch->isNull(r, i) ? QString::fromLatin1("NULL")
+                                                      : value.toString());
+                }
+            }
+        }
+        if (count < 0 || !cursor->eof()) {
+            return QStringList();
+        }
+        return values;
+    };
+
+    KDbCursor *cursor = conn->executeQuery(persons);
+    QVERIFY(cursor);
+    const QStringList expected(records(cursor));
+    QCOMPARE(expected.count(), 4 * 4);
+    QVERIFY(expected.contains("NULL"));
+    KDbColumnBatch batch;
+    for (int batchSize : { 1, 3, 4, 100 }) {
+        QVERIFY(cursor->reopen());
+        QCOMPARE(batchRecords(cursor, &batch, batchSize), expected);
+    }
+    QCOMPARE(cursor->fetchBatch(&batch, 10), 0);
+    QCOMPARE(batch.recordCount(), 0);
+
+    // typed columns: id, age, name, surname
+    QVERIFY(cursor->reopen());
+    QCOMPARE(cursor->fetchBatch(&batch, 10), 4);
+    QCOMPARE(batch.storage(1), KDbColumnBatch::Storage::Integer);
+    QCOMPARE(batch.storage(2), KDbColumnBatch::Storage::Text);
+    QCOMPARE(batch.fieldType(2), KDbField::Text);
+    QCOMPARE(batch.integers(1).count(), 4);
+    qint64 sum = 0;
+    for (qint64 age : batch.integers(1)) {
+        sum += age;
+    }
+    QCOMPARE(sum, qint64(27 + 60 + 45 + 35));
+    QCOMPARE(batch.nulls(2).count(), 4);
+    QCOMPARE(batch.nulls(2).count(true), 1);
+    QVERIFY(batch.isNull(3, 2));
+    QVERIFY(!batch.isNull(3, 3));
+
+    // fetching continues after the current record
+    QVERIFY(cursor->reopen());
+    QVERIFY(cursor->moveFirst());
+    QVERIFY(cursor->moveNext());
+    QCOMPARE(cursor->fetchBatch(&batch, 1), 1);
+    QCOMPARE(batch.value(0, 0).toInt(), cursor->value(0).toInt());
+    QCOMPARE(batch.value(0, 3), cursor->value(3));
+    QVERIFY(cursor->moveNext());
+    QCOMPARE(cursor->value(0).toInt(), 4);
+    QVERIFY(conn->deleteCursor(cursor));
+
+    // raw statements
+    const KDbEscapedString sql("SELECT id, name FROM persons ORDER BY id");
+    cursor = conn->executeQuery(sql);
+    QVERIFY(cursor);
+    const QStringList expectedSql(records(cursor));
+    QVERIFY(cursor->reopen());
+    QCOMPARE(batchRecords(cursor, &batch, 3), expectedSql);
+    QCOMPARE(batch.storage(0), KDbColumnBatch::Storage::Variant);
+    QVERIFY(conn->deleteCursor(cursor));
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testRecordCount()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    QCOMPARE(conn->recordCount(*persons), 4);
+    QCOMPARE(conn->approximateRecordCount(*persons), 4);
+    QVERIFY(conn->isEmpty(persons) == false);
+
+    // statistics are used when available, exact count is used for tables without statistics
+    QVERIFY(conn->executeSql(KDbEscapedString("ANALYZE")));
+    QVERIFY(conn->insertRecord(persons, QVariant(5), QVariant(50), QVariant("Ann"),
+                               QVariant("Brown")));
+    QCOMPARE(conn->recordCount(*persons), 5);
+    QCOMPARE(conn->approximateRecordCount(*persons), 4); // statistics are not updated
+    KDbTableSchema *notAnalyzed = new KDbTableSchema("not_analyzed");
+    notAnalyzed->addField(new KDbField("id", KDbField::Integer, KDbField::PrimaryKey));
+    QVERIFY(conn->createTable(notAnalyzed));
+    QVERIFY(conn->insertRecord(notAnalyzed, QVariant(1)));
+    QVERIFY(conn->insertRecord(notAnalyzed, QVariant(2)));
+    QCOMPARE(conn->approximateRecordCount(*notAnalyzed), 2);
+    QVERIFY(conn->executeSql(KDbEscapedString("DELETE FROM persons WHERE id = 5")));
+    const KDbNativeStatementBuilder builder(conn, KDb::DriverEscaping);
+    KDbEscapedString sql;
+
+    // ORDER BY is omitted
+    KDbQuerySchema query(persons);
+    QVERIFY(query.addToWhereExpression(persons->field("age"), 40, '>'));
+    QVERIFY(builder.generateSelectStatement(&sql, &query));
+    QVERIFY(sql.toString().contains("ORDER BY"));
+    QVERIFY(builder.generateCountStatement(&sql, &query));
+    QVERIFY(sql.startsWith("SELECT COUNT(*) FROM "));
+    QVERIFY(!sql.toString().contains("ORDER BY"));
+    QVERIFY(!sql.toString().contains("kdb__subquery"));
+    QCOMPARE(conn->recordCount(&query), 2);
+    QVERIFY(builder.generateExistsStatement(&sql, &query));
+    QVERIFY(sql.startsWith("SELECT 1 FROM "));
+    QVERIFY(conn->isEmpty(&query) == false);
+
+    KDbQuerySchema emptyQuery(persons);
+    QVERIFY(emptyQuery.addToWhereExpression(persons->field("age"), 100, '>'));
+    QCOMPARE(conn->recordCount(&emptyQuery), 0);
+    QVERIFY(conn->isEmpty(&emptyQuery) == true);
+
+    // aggregate functions always return one record, the query is counted as a subquery
+    KDbQuerySchema maxQuery;
+    maxQuery.addTable(persons);
+    KDbNArgExpression args;
+    args.append(KDbVariableExpression("age"));
+    QVERIFY(maxQuery.addExpression(KDbFunctionExpression("MAX", args)));
+    QVERIFY(maxQuery.addToWhereExpression(persons->field("age"), 100, '>'));
+    QVERIFY(builder.generateCountStatement(&sql, &maxQuery));
+    QVERIFY(sql.toString().contains("kdb__subquery"));
+    QCOMPARE(conn->recordCount(&maxQuery), 1);
+    QVERIFY(conn->isEmpty(&maxQuery) == false);
+
+    // lookup tables are not joined
+    KDbTableSchema *cars = conn->tableSchema("cars");
+    QVERIFY(cars);
+    KDbLookupFieldSchema *lookup = new KDbLookupFieldSchema;
+    KDbLookupFieldSchemaRecordSource recordSource;
+    recordSource.setType(KDbLookupFieldSchemaRecordSource::Type::Table);
+    recordSource.setName("persons");
+    lookup->setRecordSource(recordSource);
+    lookup->setBoundColumn(0);
+    lookup->setVisibleColumns(QList<int>({ 2 }));
+    QVERIFY(cars->setLookupFieldSchema("owner", lookup));
+    KDbQuerySchema carsQuery(cars);
+    QVERIFY(builder.generateSelectStatement(&sql, &carsQuery));
+    QVERIFY(sql.toString().contains("LEFT OUTER JOIN"));
+    QVERIFY(builder.generateCountStatement(&sql, &carsQuery));
+    QVERIFY(!sql.toString().contains("LEFT OUTER JOIN"));
+    QCOMPARE(conn->recordCount(&carsQuery), 5);
+
+    // raw statements are counted as subqueries
+    QCOMPARE(conn->recordCount(KDbEscapedString("SELECT id FROM persons WHERE age > 40")), 2);
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
 void ConnectionTest::cleanupTestCase()
 {
 }
@@ -30,6 +30,25 @@ private Q_SLOTS:
     void testConnectionData();
     void testCreateDb();
     void testConnectToNonexistingDb();
+    void testAsyncQuery();
+    void testStatementTimeout();
+    void testWriteBatching();
+    void testNormalizedStatement_data();
+    void testNormalizedStatement();
+    void testTraceStatistics();
+    void testTracing();
+    void testPerformanceProfile();
+    void testReaderPool();
+    void testExportData();
+    void testImportData();
+    void testTableRebuilder();
+    void testStatementBuffer();
+    void testDmlPlans();
+    void testLookupValueCache();
+    void testResultCache();
+    void testPrefetchCursor();
+    void testFetchBatch();
+    void testRecordCount();
     void cleanupTestCase();
 
 private:
@@ -18,7 +18,12 @@
 */
 
 #include "DriverTest.h"
+#include "KDbJsonTrader_p.h"
 
+#include <KDb>
+
+#include <QDir>
+#include <QTemporaryDir>
 #include <QTest>
 
 QTEST_GUILESS_MAIN(DriverTest)
@@ -37,6 +42,69 @@ void DriverTest::testSqliteDriver()
     QVERIFY(utils.testSqliteDriver());
 }
 
+static QStringList pluginFileNames(const QList<KDbJsonTrader::Plugin> &plugins)
+{
+    QStringList result;
+    for (const KDbJsonTrader::Plugin &plugin : plugins) {
+        result.append(plugin.fileName);
+    }
+    return result;
+}
+
+void DriverTest::testPluginIndex()
+{
+    QTemporaryDir indexDir;
+    QTemporaryDir pluginsDir;
+    QVERIFY(indexDir.isValid());
+    QVERIFY(pluginsDir.isValid());
+    const QString pluginPath(pluginsDir.path() + QLatin1String("/" KDB_BASE_NAME_LOWER));
+    QVERIFY(QDir().mkpath(pluginPath));
+    QFile file(pluginPath + QLatin1String("/notaplugin.txt"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QVERIFY(file.write("text") > 0);
+    file.close();
+    QCoreApplication::addLibraryPath(pluginsDir.path());
+    const QStringList paths(KDb::libraryPaths());
+    QVERIFY(paths.contains(pluginPath));
+
+    KDbJsonTrader *trader = KDbJsonTrader::self();
+    const QString savedIndexDirectory(trader->indexDirectory());
+    trader->setIndexDirectory(indexDir.path());
+    const QString serviceType(QLatin1String("KDb/Driver"));
+
+    // No index yet: all plugin paths are scanned
+    const QStringList fileNames(pluginFileNames(trader->plugins(serviceType)));
+    QCOMPARE(trader->lastScannedPathCount(), paths.count());
+
+    // Index is up to date: no path is scanned and the result is the same
+    QCOMPARE(pluginFileNames(trader->plugins(serviceType)), fileNames);
+    QCOMPARE(trader->lastScannedPathCount(), 0);
+
+    // A new subdirectory changes modification time of the path so only this path is scanned
+    QTest::qSleep(1100); // for file systems with coarse modification times
+    QVERIFY(QDir().mkpath(pluginPath + QLatin1String("/subdir")));
+    QCOMPARE(pluginFileNames(trader->plugins(serviceType)), fileNames);
+    QCOMPARE(trader->lastScannedPathCount(), 1);
+    QCOMPARE(pluginFileNames(trader->plugins(serviceType)), fileNames);
+    QCOMPARE(trader->lastScannedPathCount(), 0);
+
+    // Modified file is detected as well
+    QTest::qSleep(1100);
+    QVERIFY(file.open(QIODevice::Append));
+    QVERIFY(file.write("more text") > 0);
+    file.close();
+    QCOMPARE(pluginFileNames(trader->plugins(serviceType)), fileNames);
+    QCOMPARE(trader->lastScannedPathCount(), 1);
+
+    // Disabled index: all plugin paths are scanned every time
+    trader->setIndexDirectory(QString());
+    QCOMPARE(pluginFileNames(trader->plugins(serviceType)), fileNames);
+    QCOMPARE(trader->lastScannedPathCount(), paths.count());
+
+    trader->setIndexDirectory(savedIndexDirectory);
+    QCoreApplication::removeLibraryPath(pluginsDir.path());
+}
+
 void DriverTest::cleanupTestCase()
 {
 }
@@ -29,6 +29,7 @@ private Q_SLOTS:
     void initTestCase();
     void testDriverManager();
     void testSqliteDriver();
+    void testPluginIndex();
     void cleanupTestCase();
 private:
     KDbTestUtils utils;
@@ -23,6 +23,10 @@
 
 #include <KDbDateTime>
 #include <KDbExpression>
+#include <KDbExpressionEvaluator>
+#include <KDbRecordData>
+#include <KDbTableSchema>
+#include <KDbUtils>
 #include "parser/generated/sqlparser.h"
 #include "parser/KDbParser_p.h"
 
@@ -1495,6 +1499,250 @@ void ExpressionsTest::testFunctionExpressionValidate()
     QVERIFY(!validate(&f_noname));
 }
 
+//! Table used for evaluator tests: persons(id, name, age)
+class EvaluatorTestTable : public KDbTableSchema
+{
+public:
+    EvaluatorTestTable() : KDbTableSchema("persons")
+    {
+        addField(new KDbField("id", KDbField::Integer));
+        addField(new KDbField("name", KDbField::Text));
+        addField(new KDbField("age", KDbField::Integer));
+    }
+};
+
+static KDbRecordData* createPerson(const QVariant &id, const QVariant &name, const QVariant &age)
+{
+    KDbRecordData *record = new KDbRecordData(3);
+    (*record)[0] = id;
+    (*record)[1] = name;
+    (*record)[2] = age;
+    return record;
+}
+
+//! Compiles @a expr for the test table and evaluates it for @a record
+static QVariant evaluate(const KDbExpression &expr, const KDbRecordData &record)
+{
+    EvaluatorTestTable table;
+    KDbExpressionEvaluator evaluator;
+    if (!evaluator.compile(expr, table)) {
+        qInfo() << "Compilation of" << expr << "FAILED:" << evaluator.result();
+        return QVariant(QLatin1String("<compilation failed>"));
+    }
+    return evaluator.evaluate(record);
+}
+
+static KDbExpression variable(const QString &name)
+{
+    return KDbVariableExpression(name);
+}
+
+static KDbExpression integer(int value)
+{
+    return KDbConstExpression(KDbToken::INTEGER_CONST, value);
+}
+
+static KDbExpression text(const QString &value)
+{
+    return KDbConstExpression(KDbToken::CHARACTER_STRING_LITERAL, value);
+}
+
+static KDbExpression null()
+{
+    return KDbConstExpression(KDbToken::SQL_NULL, QVariant());
+}
+
+static KDbExpression function(const QString &name, const QList<KDbExpression> &argList)
+{
+    KDbNArgExpression args;
+    for (const KDbExpression &arg : argList) {
+        args.append(arg);
+    }
+    return KDbFunctionExpression(name, args);
+}
+
+void ExpressionsTest::testExpressionEvaluator()
+{
+    QScopedPointer<KDbRecordData> john(createPerson(1, "John", 42));
+
+    // arithmetic
+    QCOMPARE(evaluate(KDbBinaryExpression(
+        KDbBinaryExpression(variable("age"), '*', integer(2)), '+', integer(1)), *john),
+             QVariant(85));
+    QCOMPARE(evaluate(KDbBinaryExpression(integer(7), '/', integer(2)), *john), QVariant(3));
+    QCOMPARE(evaluate(KDbBinaryExpression(integer(7), '%', integer(4)), *john), QVariant(3));
+    QCOMPARE(evaluate(KDbBinaryExpression(
+        KDbConstExpression(KDbToken::REAL_CONST, 1.5), '*', integer(3)), *john), QVariant(4.5));
+    QCOMPARE(evaluate(KDbUnaryExpression('-', variable("persons.age")), *john), QVariant(-42));
+    QCOMPARE(evaluate(KDbBinaryExpression(integer(1), KDbToken::BITWISE_SHIFT_LEFT, integer(4)),
+                      *john), QVariant(16));
+
+    // text
+    QCOMPARE(evaluate(KDbBinaryExpression(variable("name"), KDbToken::CONCATENATION,
+                                          text(" Smith")), *john), QVariant("John Smith"));
+    QCOMPARE(evaluate(function("UPPER", { variable("name") }), *john), QVariant("JOHN"));
+    QCOMPARE(evaluate(function("LENGTH", { variable("name") }), *john), QVariant(4));
+    QCOMPARE(evaluate(function("SUBSTR", { variable("name"), integer(2), integer(2) }), *john),
+             QVariant("oh"));
+    QCOMPARE(evaluate(function("SUBSTR", { variable("name"), integer(-3) }), *john),
+             QVariant("ohn"));
+    QCOMPARE(evaluate(function("INSTR", { variable("name"), text("hn") }), *john), QVariant(3));
+    QCOMPARE(evaluate(function("TRIM", { text("a b or c"), text("orca ") }), *john),
+             QVariant("b"));
+    QCOMPARE(evaluate(function("SOUNDEX", { variable("name") }), *john), QVariant("J500"));
+    QCOMPARE(evaluate(function("HEX", { text("DEAD") }), *john), QVariant("44454144"));
+    QCOMPARE(evaluate(function("ROUND", { KDbConstExpression(KDbToken::REAL_CONST, -5.51) }),
+                      *john), QVariant(-6));
+    QCOMPARE(evaluate(function("CEILING", { KDbConstExpression(KDbToken::REAL_CONST, -99.001) }),
+                      *john), QVariant(-99));
+
+    // comparisons
+    QCOMPARE(evaluate(KDbBinaryExpression(variable("age"), '>', integer(30)), *john),
+             QVariant(true));
+    QCOMPARE(evaluate(KDbBinaryExpression(variable("name"), KDbToken::LIKE, text("j_h%")),
+                      *john), QVariant(true));
+    QCOMPARE(evaluate(KDbBinaryExpression(variable("name"), KDbToken::NOT_LIKE, text("%x%")),
+                      *john), QVariant(true));
+    QCOMPARE(evaluate(KDbBinaryExpression(variable("name"), '=', text("john")), *john),
+             QVariant(false));
+    KDbNArgExpression between(KDb::RelationalExpression, KDbToken::BETWEEN_AND);
+    between.append(variable("age"));
+    between.append(integer(40));
+    between.append(integer(50));
+    QCOMPARE(evaluate(between, *john), QVariant(true));
+    KDbNArgExpression list(KDb::ArgumentListExpression, ',');
+    list.append(integer(1));
+    list.append(integer(42));
+    QCOMPARE(evaluate(KDbBinaryExpression(variable("age"), KDbToken::SQL_IN, list), *john),
+             QVariant(true));
+    QCOMPARE(evaluate(function("GREATEST", { text("Z"), text("AA") }), *john), QVariant("Z"));
+
+    // query parameters
+    EvaluatorTestTable table;
+    KDbExpressionEvaluator evaluator;
+    QVERIFY(evaluator.compile(
+        KDbBinaryExpression(variable("age"), '>', KDbQueryParameterExpression("min age")),
+        table, QList<QVariant>() << 40));
+    QVERIFY(evaluator.matches(*john));
+
+    // errors
+    QVERIFY(!evaluator.compile(variable("surname"), table));
+    QVERIFY(!evaluator.isCompiled());
+    QCOMPARE(evaluator.result().code(), ERR_OBJECT_NOT_FOUND);
+    QVERIFY(!evaluator.compile(function("SUM", { variable("age") }), table));
+    QVERIFY(evaluator.result().isError());
+    QVERIFY(!evaluator.compile(
+        KDbBinaryExpression(variable("age"), '>', KDbQueryParameterExpression("min age")),
+        table));
+    QVERIFY(evaluator.evaluate(*john).isNull());
+}
+
+void ExpressionsTest::testExpressionEvaluatorNullSemantics()
+{
+    QScopedPointer<KDbRecordData> unknown(createPerson(2, QVariant(), QVariant()));
+
+    QVERIFY(evaluate(KDbBinaryExpression(variable("age"), '+', integer(1)), *unknown).isNull());
+    QVERIFY(evaluate(KDbBinaryExpression(variable("age"), '=', null()), *unknown).isNull());
+    QVERIFY(evaluate(KDbBinaryExpression(integer(1), '/', integer(0)), *unknown).isNull());
+    QCOMPARE(evaluate(KDbUnaryExpression(KDbToken::SQL_IS_NULL, variable("age")), *unknown),
+             QVariant(true));
+    QVERIFY(evaluate(KDbUnaryExpression(KDbToken::NOT, variable("age")), *unknown).isNull());
+
+    // three-valued logic
+    const KDbExpression ageIsSmall = KDbBinaryExpression(variable("age"), '<', integer(10));
+    QCOMPARE(evaluate(KDbBinaryExpression(ageIsSmall, KDbToken::AND,
+                                          KDbConstExpression(KDbToken::SQL_FALSE, false)),
+                      *unknown), QVariant(false));
+    QVERIFY(evaluate(KDbBinaryExpression(ageIsSmall, KDbToken::AND,
+                                         KDbConstExpression(KDbToken::SQL_TRUE, true)),
+                     *unknown).isNull());
+    QCOMPARE(evaluate(KDbBinaryExpression(ageIsSmall, KDbToken::OR,
+                                          KDbConstExpression(KDbToken::SQL_TRUE, true)),
+                      *unknown), QVariant(true));
+    QVERIFY(evaluate(KDbBinaryExpression(ageIsSmall, KDbToken::XOR,
+                                         KDbConstExpression(KDbToken::SQL_TRUE, true)),
+                     *unknown).isNull());
+
+    // IN: NULL if nothing matches and the list contains NULL
+    KDbNArgExpression list(KDb::ArgumentListExpression, ',');
+    list.append(integer(1));
+    list.append(null());
+    QVERIFY(evaluate(KDbBinaryExpression(integer(2), KDbToken::SQL_IN, list), *unknown).isNull());
+    QCOMPARE(evaluate(KDbBinaryExpression(integer(1), KDbToken::SQL_IN, list), *unknown),
+             QVariant(true));
+
+    // COALESCE and IFNULL return the first non-NULL argument
+    QCOMPARE(evaluate(function("COALESCE", { null(), variable("age"), integer(17), text("A") }),
+                      *unknown), QVariant(17));
+    QCOMPARE(evaluate(function("IFNULL", { variable("name"), text("?") }), *unknown),
+             QVariant("?"));
+    QVERIFY(evaluate(function("IFNULL", { null(), null() }), *unknown).isNull());
+
+    // GREATEST/MAX and LEAST/MIN return NULL if any argument is NULL
+    QVERIFY(evaluate(function("GREATEST", { integer(9), null(), integer(-1) }), *unknown).isNull());
+    QVERIFY(evaluate(function("MIN", { integer(9), variable("age") }), *unknown).isNull());
+    QCOMPARE(evaluate(function("MAX", { KDbConstExpression(KDbToken::REAL_CONST, 0.1),
+                                        KDbConstExpression(KDbToken::REAL_CONST, 7.1),
+                                        integer(7) }), *unknown), QVariant(7.1));
+    QCOMPARE(evaluate(function("LEAST", { integer(9), integer(-1) }), *unknown), QVariant(-1));
+
+    QVERIFY(evaluate(function("NULLIF", { integer(177), integer(177) }), *unknown).isNull());
+    QCOMPARE(evaluate(function("NULLIF", { text("John"), text("Smith") }), *unknown),
+             QVariant("John"));
+    QCOMPARE(evaluate(function("SOUNDEX", { variable("name") }), *unknown), QVariant("?000"));
+}
+
+void ExpressionsTest::testExpressionEvaluatorBatch()
+{
+    KDbUtils::AutodeletedList<KDbRecordData*> records;
+    for (int i = 0; i < 2500; ++i) {
+        records.append(createPerson(i, i % 3 == 0 ? QVariant() : QVariant(QString::number(i)),
+                                    i % 7 == 0 ? QVariant() : QVariant(i % 100)));
+    }
+    EvaluatorTestTable table;
+    KDbExpressionEvaluator evaluator;
+    QCOMPARE(evaluator.batchSize(), 1024);
+    evaluator.setBatchSize(1000);
+    QCOMPARE(evaluator.batchSize(), 1000);
+    evaluator.setBatchSize(0);
+    QCOMPARE(evaluator.batchSize(), 1000);
+
+    // (age >= 50 OR name LIKE '%5') AND id % 2 = 0
+    const KDbBinaryExpression condition(
+        KDbBinaryExpression(
+            KDbBinaryExpression(variable("age"), KDbToken::GREATER_OR_EQUAL, integer(50)),
+            KDbToken::OR,
+            KDbBinaryExpression(variable("name"), KDbToken::LIKE, text("%5"))),
+        KDbToken::AND,
+        KDbBinaryExpression(KDbBinaryExpression(variable("id"), '%', integer(2)), '=', integer(0)));
+    QVERIFY(evaluator.compile(condition, table));
+    const QBitArray matching = evaluator.filter(records);
+    QCOMPARE(matching.size(), records.count());
+    int count = 0;
+    for (int i = 0; i < records.count(); ++i) {
+        const int age = i % 100;
+        const bool expected = i % 2 == 0
+            && ((i % 7 != 0 && age >= 50) || (i % 3 != 0 && i % 10 == 5));
+        QCOMPARE(matching.testBit(i), expected);
+        QCOMPARE(evaluator.matches(*records.at(i)), expected);
+        if (expected) {
+            ++count;
+        }
+    }
+    QCOMPARE(matching.count(true), count);
+
+    // COALESCE(age, -1) * 2
+    QVERIFY(evaluator.compile(
+        KDbBinaryExpression(function("COALESCE", { variable("age"), integer(-1) }), '*', integer(2)),
+        table));
+    const QList<QVariant> values = evaluator.evaluate(records);
+    QCOMPARE(values.count(), records.count());
+    for (int i = 0; i < records.count(); ++i) {
+        QCOMPARE(values[i], QVariant(i % 7 == 0 ? -2 : (i % 100) * 2));
+        QCOMPARE(values[i], evaluator.evaluate(*records.at(i)));
+    }
+}
+
 void ExpressionsTest::cleanupTestCase()
 {
 }
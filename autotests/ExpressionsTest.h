@@ -46,6 +46,10 @@ private Q_SLOTS:
     void testBinaryExpressionValidate();
     void testFunctionExpressionValidate();
 
+    void testExpressionEvaluator();
+    void testExpressionEvaluatorNullSemantics();
+    void testExpressionEvaluatorBatch();
+
     void cleanupTestCase();
 };
 
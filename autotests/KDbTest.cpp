@@ -18,6 +18,7 @@
 */
 
 #include "KDbTest.h"
+#include "KDbEscaping_p.h"
 
 #include <KDb>
 #include <KDbConnectionData>
@@ -686,6 +687,111 @@ void KDbTest::testEscapeBLOB()
     QCOMPARE(KDb::escapeBLOB(blob, KDb::BLOBEscapingType::ByteaHex), escapedBytea);
 }
 
+void KDbTest::testEscapingKernels_data()
+{
+    QTest::addColumn<QString>("string");
+
+    QTest::newRow("") << QString();
+    QTest::newRow("plain") << QString("plain text");
+    QTest::newRow("special") << QString::fromLatin1("It's\ta \"quoted\"\\\n\r\b\0.", 21);
+    QTest::newRow("unicode") << QString::fromUtf8("Za\xc5\xbc\xc3\xb3\xc5\x82\xc4\x87 \xe4\xb8\xad "
+                                                 "\xf0\x9f\x98\x80'");
+    QTest::newRow("unpaired surrogates") << (QChar(0xd800) + QString("a") + QChar(0xdc00));
+}
+
+//! Reference implementation of kdbEscapeString(), character by character
+static QByteArray escapeStringUsingRules(const QString &string, const KDbStringEscapingRules &rules)
+{
+    QString result(QLatin1Char('\''));
+    for (const QChar c : string) {
+        const char *replacement = rules.replacement(c.unicode());
+        if (replacement) {
+            result += QLatin1String(replacement);
+        } else {
+            result += c;
+        }
+    }
+    result += QLatin1Char('\'');
+    return result.toUtf8();
+}
+
+void KDbTest::testEscapingKernels()
+{
+    QFETCH(QString, string);
+    // rules of the KDBSQL dialect and copies of rules of the MySQL, PostgreSQL and SQLite drivers
+    const KDbStringEscapingRules mysqlRules{
+        {'\\', "\\\\"}, {'\'', "\\'"}, {'"', "\\\""}, {'\n', "\\n"}, {'\r', "\\r"},
+        {'\t', "\\t"}, {'\b', "\\b"}, {'\0', "\\0"} };
+    const KDbStringEscapingRules postgresqlRules{ {'\\', "\\\\"}, {'\'', "\\'"} };
+    const KDbStringEscapingRules sqliteRules{ {'\'', "''"} };
+    const QList<const KDbStringEscapingRules*> rulesList{
+        &kdbSqlStringEscapingRules(), &mysqlRules, &postgresqlRules, &sqliteRules };
+    // repeat the string so vector kernels process blocks and tails of various lengths
+    for (int count = 1; count <= 40; count += 13) {
+        const QString repeated(string.repeated(count) + QLatin1String("end"));
+        QCOMPARE(escapeStringUsingRules(repeated, kdbSqlStringEscapingRules()),
+                 KDbEscapedString(KDb::escapeString(repeated)).toByteArray());
+        for (const KDbStringEscapingRules *rules : rulesList) {
+            const QByteArray expected(escapeStringUsingRules(repeated, *rules));
+            for (KDbEscapingKernel kernel : { KDbEscapingKernel::Scalar, KDbEscapingKernel::Sse2,
+                                              KDbEscapingKernel::Avx2 })
+            {
+                const KDbEscapedString escaped(kdbEscapeString(repeated, *rules, "'", "'", kernel));
+                QCOMPARE(escaped.toByteArray(), expected);
+                // worst-case allocation is released
+                QVERIFY(escaped.capacity() <= qMax(64, 2 * escaped.size() + 1));
+                QCOMPARE(kdbEscapeString(repeated.toUtf8(), *rules, "'", "'", kernel).toByteArray(),
+                         expected);
+            }
+        }
+    }
+    QByteArray blob;
+    for (int i = 0; i < 100; ++i) {
+        blob.append(char(i * 37));
+        for (KDb::BLOBEscapingType type : { KDb::BLOBEscapingType::XHex, KDb::BLOBEscapingType::Hex,
+                                            KDb::BLOBEscapingType::ByteaHex })
+        {
+            const KDbEscapedString expected(kdbEscapeBLOB(blob, type, KDbEscapingKernel::Scalar));
+            QCOMPARE(kdbEscapeBLOB(blob, type, KDbEscapingKernel::Sse2), expected);
+            QCOMPARE(kdbEscapeBLOB(blob, type, KDbEscapingKernel::Avx2), expected);
+        }
+    }
+}
+
+void KDbTest::testEscapeIdentifier_data()
+{
+    QTest::addColumn<QString>("identifier");
+    QTest::addColumn<bool>("keyword");
+    QTest::addColumn<QString>("escaped");
+
+    QTest::newRow("") << QString() << false << QString();
+    QTest::newRow("plain") << QString("persons") << false << QString("persons");
+    QTest::newRow("mixed case") << QString("Persons_2") << false << QString("Persons_2");
+    QTest::newRow("keyword") << QString("SELECT") << true << QString("\"SELECT\"");
+    QTest::newRow("lower-case keyword") << QString("select") << true << QString("\"select\"");
+    QTest::newRow("mixed case keyword") << QString("Select") << true << QString("\"Select\"");
+    QTest::newRow("keyword prefix") << QString("SELEC") << false << QString("SELEC");
+    QTest::newRow("keyword with suffix") << QString("selectx") << false << QString("selectx");
+    QTest::newRow("digit first") << QString("2persons") << false << QString("\"2persons\"");
+    QTest::newRow("space") << QString("first name") << false << QString("\"first name\"");
+    QTest::newRow("quote") << QString("a\"b") << false << QString("\"a\"\"b\"");
+    QTest::newRow("non-latin1") << QString::fromUtf8("\xc5\xbc") << false
+                                << QString::fromUtf8("\"\xc5\xbc\"");
+    QTest::newRow("long") << QString(100, 'a') << false << QString(100, 'a');
+}
+
+void KDbTest::testEscapeIdentifier()
+{
+    QFETCH(QString, identifier);
+    QFETCH(bool, keyword);
+    QFETCH(QString, escaped);
+    QCOMPARE(KDb::isKDbSqlKeyword(identifier.toLatin1()), keyword);
+    QCOMPARE(KDb::escapeIdentifier(identifier), escaped);
+    if (escaped.toLatin1() == escaped.toUtf8()) {
+        QCOMPARE(KDb::escapeIdentifier(identifier.toLatin1()), escaped.toLatin1());
+    }
+}
+
 void KDbTest::testPgsqlByteaToByteArray()
 {
     QCOMPARE(KDb::pgsqlByteaToByteArray(nullptr, 0), QByteArray());
@@ -41,6 +41,10 @@ private Q_SLOTS:
     void testUnescapeString();
     void testEscapeBLOB_data();
     void testEscapeBLOB();
+    void testEscapingKernels_data();
+    void testEscapingKernels();
+    void testEscapeIdentifier_data();
+    void testEscapeIdentifier();
     void testPgsqlByteaToByteArray();
     void testXHexToByteArray_data();
     void testXHexToByteArray();
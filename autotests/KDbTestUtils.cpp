@@ -34,6 +34,11 @@
 
 #include "../tests/features/tables_test_p.h"
 
+#ifdef KDB_IMPORT_STATIC_SQLITE_DRIVER
+#include <QtPlugin>
+Q_IMPORT_PLUGIN(SqliteDriverFactory)
+#endif
+
 namespace QTest
 {
 KDBTESTUTILS_EXPORT bool qCompare(const KDbEscapedString &val1, const KDbEscapedString &val2,
@@ -0,0 +1,288 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "TableViewDataTest.h"
+
+#include <QtTest>
+
+#include <KDbConnection>
+#include <KDbCursor>
+#include <KDbExpression>
+#include <KDbTableSchema>
+#include <KDbTableViewData>
+
+QTEST_GUILESS_MAIN(TableViewDataTest)
+
+//! @return data with @a count records with keys 0..count-1
+static KDbTableViewData* createData(int count)
+{
+    KDbTableViewData *data = new KDbTableViewData(KDbField::Integer, KDbField::Text);
+    for (int i = 0; i < count; ++i) {
+        KDbRecordData *record = data->createItem();
+        (*record)[0] = i;
+        data->append(record);
+    }
+    return data;
+}
+
+void TableViewDataTest::initTestCase()
+{
+    qRegisterMetaType<QList<int>>();
+}
+
+void TableViewDataTest::testDeleteRecords_data()
+{
+    QTest::addColumn<QList<int>>("recordsToDelete");
+    QTest::addColumn<QList<int>>("expectedDeleted");
+    QTest::addColumn<QList<int>>("expectedKeys");
+
+    QTest::newRow("none") << QList<int>() << QList<int>() << QList<int>{0, 1, 2, 3, 4};
+    QTest::newRow("first") << QList<int>{0} << QList<int>{0} << QList<int>{1, 2, 3, 4};
+    QTest::newRow("last") << QList<int>{4} << QList<int>{4} << QList<int>{0, 1, 2, 3};
+    QTest::newRow("some") << QList<int>{1, 3} << QList<int>{1, 3} << QList<int>{0, 2, 4};
+    QTest::newRow("all") << QList<int>{0, 1, 2, 3, 4} << QList<int>{0, 1, 2, 3, 4} << QList<int>();
+    QTest::newRow("unsorted, duplicated") << QList<int>{3, 1, 3} << QList<int>{1, 3}
+                                          << QList<int>{0, 2, 4};
+    QTest::newRow("out of range") << QList<int>{-1, 2, 5} << QList<int>{2}
+                                  << QList<int>{0, 1, 3, 4};
+}
+
+void TableViewDataTest::testDeleteRecords()
+{
+    QFETCH(QList<int>, recordsToDelete);
+    QFETCH(QList<int>, expectedDeleted);
+    QFETCH(QList<int>, expectedKeys);
+
+    QScopedPointer<KDbTableViewData> data(createData(5));
+    QSignalSpy spy(data.data(), &KDbTableViewData::recordsDeleted);
+    data->deleteRecords(recordsToDelete);
+    if (expectedDeleted.isEmpty()) {
+        QCOMPARE(spy.count(), 0);
+    } else {
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).value<QList<int>>(), expectedDeleted);
+    }
+    QList<int> keys;
+    for (int i = 0; i < data->count(); ++i) {
+        keys.append(data->at(i)->at(0).toInt());
+    }
+    QCOMPARE(keys, expectedKeys);
+}
+
+void TableViewDataTest::testClearInternal()
+{
+    QScopedPointer<KDbTableViewData> data(createData(100));
+    data->clearInternal();
+    QCOMPARE(data->count(), 0);
+    QVERIFY(data->isEmpty());
+}
+
+//! @return keys of records matching filter of @a data
+static QList<int> filteredKeys(KDbTableViewData *data)
+{
+    QList<int> keys;
+    for (int i = 0; i < data->filteredCount(); ++i) {
+        keys.append(data->filteredAt(i)->at(0).toInt());
+    }
+    return keys;
+}
+
+//! @return "key % divisor = 0" expression
+static KDbExpression keyDivisibleBy(int divisor)
+{
+    return KDbBinaryExpression(
+        KDbBinaryExpression(KDbVariableExpression("key"), '%',
+                            KDbConstExpression(KDbToken::INTEGER_CONST, divisor)),
+        '=', KDbConstExpression(KDbToken::INTEGER_CONST, 0));
+}
+
+void TableViewDataTest::testFilter()
+{
+    QScopedPointer<KDbTableViewData> data(createData(10));
+    QVERIFY(!data->isFiltered());
+    QCOMPARE(data->filteredCount(), 10);
+
+    QVERIFY(!data->setFilter(KDbVariableExpression("unknown")));
+    QVERIFY(!data->result().success);
+    QVERIFY(!data->isFiltered());
+
+    QVERIFY(data->setFilter(keyDivisibleBy(3)));
+    QVERIFY(data->isFiltered());
+    QVERIFY(!data->filter().isNull());
+    QCOMPARE(data->filteredIndices(), QVector<int>({0, 3, 6, 9}));
+    QCOMPARE(filteredKeys(data.data()), QList<int>({0, 3, 6, 9}));
+    QCOMPARE(data->count(), 10);
+    QVERIFY(!data->filteredAt(4));
+
+    // inserting
+    KDbRecordData *record = data->createItem();
+    (*record)[0] = 12;
+    data->insertRecord(record, 1);
+    record = data->createItem();
+    (*record)[0] = 13;
+    data->insertRecord(record, 0);
+    record = data->createItem();
+    (*record)[0] = 15;
+    data->append(record);
+    QCOMPARE(data->filteredIndices(), QVector<int>({1, 2, 5, 8, 11, 12}));
+    QCOMPARE(filteredKeys(data.data()), QList<int>({0, 12, 3, 6, 9, 15}));
+
+    // updating
+    record = data->at(4);
+    QCOMPARE(record->at(0).toInt(), 2);
+    QVERIFY(data->updateRecordEditBuffer(record, 0, 21));
+    QVERIFY(data->saveRecordChanges(record));
+    record = data->at(2);
+    QCOMPARE(record->at(0).toInt(), 12);
+    QVERIFY(data->updateRecordEditBuffer(record, 0, 11));
+    QVERIFY(data->saveRecordChanges(record));
+    QCOMPARE(filteredKeys(data.data()), QList<int>({0, 21, 3, 6, 9, 15}));
+
+    // deleting
+    QVERIFY(data->deleteRecord(data->at(1))); // key 0
+    data->deleteRecords(QList<int>{0, 5}); // keys 13 and 4
+    QCOMPARE(filteredKeys(data.data()), QList<int>({21, 3, 6, 9, 15}));
+    data->removeFirst(); // key 11
+    QCOMPARE(filteredKeys(data.data()), QList<int>({21, 3, 6, 9, 15}));
+    data->removeLast(); // key 15
+    QCOMPARE(filteredKeys(data.data()), QList<int>({21, 3, 6, 9}));
+
+    // sorting shares the permutation with the filter
+    data->setSorting(0, KDbOrderByColumn::SortOrder::Descending);
+    data->sort();
+    QCOMPARE(filteredKeys(data.data()), QList<int>({21, 9, 6, 3}));
+    QList<int> keys;
+    for (int i = 0; i < data->count(); ++i) {
+        keys.append(data->at(i)->at(0).toInt());
+    }
+    QCOMPARE(keys, QList<int>({21, 9, 8, 7, 6, 5, 3, 1}));
+    QCOMPARE(data->filteredIndices(), QVector<int>({0, 1, 4, 6}));
+
+    // changing and removing the filter
+    QVERIFY(data->setFilter(keyDivisibleBy(2)));
+    QCOMPARE(filteredKeys(data.data()), QList<int>({8, 6}));
+    data->clearFilter();
+    QVERIFY(!data->isFiltered());
+    QVERIFY(data->filteredIndices().isEmpty());
+    QCOMPARE(data->filteredCount(), data->count());
+    QVERIFY(data->setFilter(keyDivisibleBy(2)));
+    QVERIFY(data->setFilter(KDbExpression()));
+    QVERIFY(!data->isFiltered());
+
+    QVERIFY(data->setFilter(keyDivisibleBy(2)));
+    data->clearInternal();
+    QCOMPARE(data->filteredCount(), 0);
+}
+
+//! @return value of the primary key of record at @a index of @a data
+static int keyAt(KDbTableViewData *data, int index)
+{
+    KDbRecordData *record = data->at(index);
+    return record ? record->at(0).toInt() : -1;
+}
+
+void TableViewDataTest::testWindowed()
+{
+    QVERIFY(utils.testCreateDbWithTables("TableViewDataTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    // 4 persons exist, add more so there are 100 with ids and ages 1..100
+    for (int id = 5; id <= 100; ++id) {
+        QVERIFY(conn->insertRecord(persons, QVariant(id), QVariant(id), QVariant("Name"),
+                                   QVariant("Surname")));
+    }
+    QVERIFY(conn->executeSql(KDbEscapedString("UPDATE persons SET age = id")));
+    KDbCursor *cursor = conn->prepareQuery(persons);
+    QVERIFY(cursor);
+    {
+        KDbTableViewData data(cursor);
+        QVERIFY(!data.isWindowed());
+        QVERIFY(data.setWindowed(10 /* pageSize */, 2 /* maxCachedPages */));
+        QVERIFY(data.isWindowed());
+
+        // count and page loading
+        QCOMPARE(data.count(), 100);
+        QVERIFY(!data.isEmpty());
+        QCOMPARE(keyAt(&data, 0), 1);
+        QCOMPARE(keyAt(&data, 57), 58);
+        QCOMPARE(keyAt(&data, 99), 100);
+        QVERIFY(!data.at(100));
+        QCOMPARE(data.first()->at(0).toInt(), 1);
+        QCOMPARE(data.last()->at(0).toInt(), 100);
+
+        // LRU eviction: page 0 is used more recently than page 1 so page 1 is dropped
+        KDbRecordData *first = data.at(0);
+        QCOMPARE(keyAt(&data, 10), 11);
+        QCOMPARE(data.at(0), first);
+        QCOMPARE(keyAt(&data, 20), 21);
+        QCOMPARE(data.at(0), first);
+        QCOMPARE(data.indexOf(first), 0);
+        QCOMPARE(data.indexOf(data.at(25)), 25);
+        QCOMPARE(data.indexOf(data.at(25), 26), -1);
+
+        // records that are not cached are found by key
+        KDbRecordData notCached(4);
+        notCached[0] = 11;
+        QCOMPARE(data.indexOf(&notCached), 10);
+        notCached[0] = 1000;
+        QCOMPARE(data.indexOf(&notCached), -1);
+
+        // deleting from the window
+        data.deleteRecords(QList<int>{0, 5});
+        QCOMPARE(data.count(), 98);
+        QCOMPARE(keyAt(&data, 0), 2);
+        QCOMPARE(keyAt(&data, 4), 7);
+        QCOMPARE(keyAt(&data, 97), 100);
+
+        // inserting into the window
+        KDbRecordData *inserted = data.createItem();
+        (*inserted)[0] = 1000;
+        data.insertRecord(inserted, 3);
+        QCOMPARE(data.count(), 99);
+        QCOMPARE(data.at(3), inserted);
+        QCOMPARE(data.indexOf(inserted), 3);
+        QCOMPARE(keyAt(&data, 2), 4);
+        QCOMPARE(keyAt(&data, 4), 5);
+        QCOMPARE(keyAt(&data, 10), 12);
+        QCOMPARE(keyAt(&data, 98), 100);
+        inserted = data.createItem();
+        (*inserted)[0] = 1001;
+        data.insertRecord(inserted, data.count());
+        QCOMPARE(data.count(), 100);
+        QCOMPARE(data.last(), inserted);
+
+        // sorting at the backend, the window is reloaded
+        data.setSorting(1, KDbOrderByColumn::SortOrder::Descending);
+        data.sort();
+        QCOMPARE(data.count(), 100);
+        QCOMPARE(keyAt(&data, 0), 100);
+        QCOMPARE(keyAt(&data, 99), 1);
+        data.setSorting(1, KDbOrderByColumn::SortOrder::Ascending);
+        data.sort();
+        QCOMPARE(keyAt(&data, 0), 1);
+        QCOMPARE(keyAt(&data, 50), 51);
+    }
+    QVERIFY(conn->deleteCursor(cursor));
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void TableViewDataTest::cleanupTestCase()
+{
+}
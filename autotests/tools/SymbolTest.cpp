@@ -0,0 +1,141 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "SymbolTest.h"
+#include "KDbSymbol_p.h"
+#include "KDbUtils_p.h"
+
+#include <KDbField>
+#include <KDbFieldList>
+#include <KDbQuerySchema>
+#include <KDbTableSchema>
+
+#include <QTest>
+
+QTEST_GUILESS_MAIN(SymbolTest)
+
+void SymbolTest::initTestCase()
+{
+}
+
+void SymbolTest::testIntern()
+{
+    KDbSymbolTable table;
+    QVERIFY(KDbSymbol().isNull());
+    QVERIFY(table.intern(QString()).isNull());
+    QCOMPARE(table.count(), 0);
+
+    const KDbSymbol persons = table.intern("persons");
+    QVERIFY(!persons.isNull());
+    QCOMPARE(persons.name(), QString("persons"));
+    QCOMPARE(table.intern("persons"), persons);
+    QCOMPARE(table.intern(QString("per") + "sons"), persons);
+    QCOMPARE(qHash(table.intern("persons")), qHash(persons));
+    QCOMPARE(table.find("persons"), persons);
+    QVERIFY(table.intern("Persons") != persons); // case sensitive
+    QCOMPARE(table.count(), 2);
+
+    // lookups never grow the table
+    QVERIFY(table.find("cars").isNull());
+    QVERIFY(table.find(QString()).isNull());
+    QCOMPARE(table.count(), 2);
+
+    // symbols of other tables are different
+    KDbSymbolTable otherTable;
+    QVERIFY(otherTable.intern("persons") != persons);
+
+    table.clear();
+    QCOMPARE(table.count(), 0);
+    QVERIFY(table.find("persons").isNull());
+}
+
+void SymbolTest::testBindings()
+{
+    KDbSymbolTable table;
+    KDbTableSchema persons("persons");
+    KDbQuerySchema query;
+    KDbSymbol symbol = table.intern("persons");
+    QVERIFY(!symbol.table());
+    QVERIFY(!symbol.query());
+    symbol.setTable(&persons);
+    QCOMPARE(table.find("persons").table(), &persons);
+    QVERIFY(!table.find("persons").query());
+    symbol.setQuery(&query);
+    QCOMPARE(table.find("persons").query(), &query);
+
+    // bound symbols are not released
+    symbol.setTable(nullptr);
+    table.release(symbol);
+    QCOMPARE(table.find("persons"), symbol);
+    symbol.setQuery(nullptr);
+    table.release(symbol);
+    QVERIFY(table.find("persons").isNull());
+    QCOMPARE(table.count(), 0);
+
+    QVERIFY(!KDbSymbol().table());
+    QVERIFY(!KDbSymbol().query());
+    table.release(KDbSymbol());
+}
+
+void SymbolTest::testValueForLowerCaseName_data()
+{
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<QString>("lookup");
+
+    QTest::newRow("lowercase") << QString("owner") << QString("owner");
+    QTest::newRow("uppercase lookup") << QString("model") << QString("MODEL");
+    QTest::newRow("mixed case") << QString("year") << QString("yEaR");
+    QTest::newRow("long name") << QString(100, 'x') << QString(100, 'X');
+    QTest::newRow("non-ASCII") << QString::fromUtf8("żółw") << QString::fromUtf8("ŻÓŁW");
+}
+
+void SymbolTest::testValueForLowerCaseName()
+{
+    QFETCH(QString, name);
+    QFETCH(QString, lookup);
+    QHash<QString, int> hash;
+    hash.insert(name, 1);
+    QCOMPARE(kdbValueForLowerCaseName(hash, lookup), 1);
+    QCOMPARE(kdbValueForLowerCaseName(hash, name), 1);
+    QCOMPARE(kdbValueForLowerCaseName(hash, lookup + "_not_found", -1), -1);
+}
+
+void SymbolTest::testFieldListLookup()
+{
+    KDbFieldList list(true);
+    KDbField *id = new KDbField("ID", KDbField::Integer);
+    KDbField *name = new KDbField("Name", KDbField::Text);
+    QVERIFY(list.addField(id));
+    QVERIFY(list.addField(name));
+    QCOMPARE(list.field("id"), id);
+    QCOMPARE(list.field("ID"), id);
+    QCOMPARE(list.field("NaMe"), name);
+    QVERIFY(!list.field("surname"));
+    QVERIFY(list.renameField("NAME", "Surname"));
+    QVERIFY(!list.field("name"));
+    QCOMPARE(list.field("SURNAME"), name);
+    QVERIFY(!list.renameField(id, "surname"));
+    QVERIFY(list.removeField(name));
+    QVERIFY(!list.field("surname"));
+    QCOMPARE(list.fieldCount(), 1);
+}
+
+void SymbolTest::cleanupTestCase()
+{
+}
@@ -28,6 +28,8 @@
 #include "KDbDriverBehavior.h"
 #include "KDbDriverManager.h"
 #include "KDbDriver_p.h"
+#include "KDbEscaping_p.h"
+#include "KDbKeywordTable_p.h"
 #include "KDbLookupFieldSchema.h"
 #include "KDbMessageHandler.h"
 #include "KDbNativeStatementBuilder.h"
@@ -1326,21 +1328,48 @@ inline static T escapeIdentifier(const T& string, bool addQuotes)
     return newString;
 }
 
-static bool shouldAddQuotesToIdentifier(const QByteArray& string)
+//! @internal @return true if @a string is an identifier that is not a KDbSQL keyword,
+//! so it does not need escaping.
+static bool isPlainIdentifier(const QByteArray& string)
 {
-    return !string.isEmpty() && (!KDb::isIdentifier(string) || KDb::isKDbSqlKeyword(string));
+    return KDb::isIdentifier(string) && !KDb::isKDbSqlKeyword(string);
+}
+
+//! @overload
+//! Neither converts @a string to Latin1 nor allocates memory.
+static bool isPlainIdentifier(const QString& string)
+{
+    const int length = string.length();
+    char latin1[64]; // KDbSQL keywords are shorter
+    for (int i = 0; i < length; i++) {
+        const ushort c = string.at(i).unicode();
+        if (!(c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (i > 0 && c >= '0' && c <= '9'))) {
+            return false;
+        }
+        if (i < int(sizeof(latin1))) {
+            latin1[i] = char(c);
+        }
+    }
+    return length > 0
+        && (length > int(sizeof(latin1))
+            || !KDbDriverPrivate::kdbSQLKeywords.contains(latin1, length, Qt::CaseInsensitive));
 }
 
 QString KDb::escapeIdentifier(const QString& string)
 {
-    return ::escapeIdentifier<QString, QLatin1String, QLatin1Char, QChar>(
-        string, shouldAddQuotesToIdentifier(string.toLatin1()));
+    // fast path: most of identifiers are returned unchanged
+    if (string.isEmpty() || isPlainIdentifier(string)) {
+        return string;
+    }
+    return ::escapeIdentifier<QString, QLatin1String, QLatin1Char, QChar>(string, true);
 }
 
 QByteArray KDb::escapeIdentifier(const QByteArray& string)
 {
-    return ::escapeIdentifier<QByteArray, QByteArray, char, char>(
-        string, shouldAddQuotesToIdentifier(string));
+    if (string.isEmpty() || isPlainIdentifier(string)) {
+        return string;
+    }
+    return ::escapeIdentifier<QByteArray, QByteArray, char, char>(string, true);
 }
 
 QString KDb::escapeIdentifierAndAddQuotes(const QString& string)
@@ -1384,12 +1413,12 @@ QString KDb::escapeString(const QString& string)
 
 KDbEscapedString KDb::escapeString(KDbDriver *drv, const QString& string)
 {
-    return drv ? drv->escapeString(string) : KDbEscapedString(KDb::escapeString(string));
+    return drv ? drv->escapeString(string) : kdbEscapeString(string, kdbSqlStringEscapingRules());
 }
 
 KDbEscapedString KDb::escapeString(KDbConnection *conn, const QString& string)
 {
-    return conn ? conn->escapeString(string) : KDbEscapedString(KDb::escapeString(string));
+    return conn ? conn->escapeString(string) : kdbEscapeString(string, kdbSqlStringEscapingRules());
 }
 
 //! @see handleHex()
@@ -1593,69 +1622,13 @@ QString KDb::unescapeString(const QString& string, char quote, int *errorPositio
     return result;
 }
 
-//! @return hex digit '0'..'F' for integer number 0..15
-inline static char intToHexDigit(unsigned char val)
-{
-    return (val < 10) ? ('0' + val) : ('A' + (val - 10));
-}
-
 QString KDb::escapeBLOB(const QByteArray& array, BLOBEscapingType type)
 {
-    const int size = array.size();
-    if (size == 0 && type == BLOBEscapingType::ZeroXHex)
+    const KDbEscapedString escaped(kdbEscapeBLOB(array, type));
+    if (!escaped.isValid() || escaped.isEmpty()) {
         return QString();
-    int escaped_length = size * 2;
-    if (type == BLOBEscapingType::ZeroXHex || type == BLOBEscapingType::Octal)
-        escaped_length += 2/*0x or X'*/;
-    else if (type == BLOBEscapingType::XHex)
-        escaped_length += 3; //X' + '
-    else if (type == BLOBEscapingType::ByteaHex)
-        escaped_length += (4 + 8); // E'\x + '::bytea
-
-    QString str;
-    str.reserve(escaped_length);
-    if (str.capacity() < escaped_length) {
-        kdbWarning() << "Not enough memory (cannot allocate" << escaped_length << "characters)";
-        return QString();
-    }
-    if (type == BLOBEscapingType::XHex)
-        str = QString::fromLatin1("X'");
-    else if (type == BLOBEscapingType::ZeroXHex)
-        str = QString::fromLatin1("0x");
-    else if (type == BLOBEscapingType::Octal)
-        str = QString::fromLatin1("'");
-    else if (type == BLOBEscapingType::ByteaHex)
-        str = QString::fromLatin1("E'\\\\x");
-
-    if (type == BLOBEscapingType::Octal) {
-        // only escape nonprintable characters as in Table 8-7:
-        // https://www.postgresql.org/docs/8.1/interactive/datatype-binary.html
-        // i.e. escape for bytes: < 32, >= 127, 39 ('), 92(\).
-        for (int i = 0; i < size; i++) {
-            const unsigned char val = array[i];
-            if (val < 32 || val >= 127 || val == 39 || val == 92) {
-                str.append(QLatin1Char('\\'));
-                str.append(QLatin1Char('\\'));
-                str.append(QChar::fromLatin1('0' + val / 64));
-                str.append(QChar::fromLatin1('0' + (val % 64) / 8));
-                str.append(QChar::fromLatin1('0' + val % 8));
-            } else {
-                str.append(QChar::fromLatin1(val));
-            }
-        }
-    } else {
-        for (int i = 0; i < size; i++) {
-            const unsigned char val = array[i];
-            str.append(QChar::fromLatin1(intToHexDigit(val / 16)));
-            str.append(QChar::fromLatin1(intToHexDigit(val % 16)));
-        }
-    }
-    if (type == BLOBEscapingType::XHex || type == BLOBEscapingType::Octal) {
-        str.append(QLatin1Char('\''));
-    } else if (type == BLOBEscapingType::ByteaHex) {
-        str.append(QLatin1String("\'::bytea"));
     }
-    return str;
+    return QString::fromLatin1(escaped.constData(), escaped.size());
 }
 
 QByteArray KDb::pgsqlByteaToByteArray(const char* data, int length)
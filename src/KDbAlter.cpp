@@ -21,6 +21,7 @@
 #include "KDb.h"
 #include "KDbConnection.h"
 #include "KDbConnectionOptions.h"
+#include "KDbTableRebuilder.h"
 #include "kdb_debug.h"
 
 #include <QMap>
@@ -941,7 +942,8 @@ KDbTableSchema* KDbAlterTableHandler::execute(const QString& tableName, Executio
         args->result = true;
         return oldTable;
     }
-//! @todo transaction!
+    // Records are copied to the recreated table by KDbTableRebuilder in chunks,
+    // each in a separate transaction.
 
     // Create a new KDbTableSchema
     KDbTableSchema *newTable = recreateTable ? new KDbTableSchema(*oldTable, false/*!copy id*/) : oldTable;
@@ -1029,58 +1031,47 @@ KDbTableSchema* KDbAlterTableHandler::execute(const QString& tableName, Executio
 
     if (recreateTable) {
         // Copy the data:
-        // Build "INSERT INTO ... SELECT FROM ..." SQL statement
-        // The order is based on the order of the source table fields.
         // Notes:
         // -Some source fields can be skipped in case when there are deleted fields.
         // -Some destination fields can be skipped in case when there
         //  are new empty fields without fixed/default value.
-        KDbEscapedString sql = KDbEscapedString("INSERT INTO %1 (").arg(d->conn->escapeIdentifier(newTable->name()));
-        //insert list of dest. fields
-        bool first = true;
-        KDbEscapedString sourceFields;
+        KDbTableRebuilder rebuilder(d->conn, oldTable, newTable);
+        if (args->chunkSize > 0) {
+            rebuilder.setChunkSize(args->chunkSize);
+        }
+        rebuilder.setProgressHandler(args->progressHandler);
         foreach(KDbField* f, *newTable->fields()) {
             QString renamedFieldName(fieldHash.value(f->name()));
-            KDbEscapedString sourceSqlString;
             const KDbField::Type type = f->type(); // cache: evaluating type of expressions can be expensive
             if (!renamedFieldName.isEmpty()) {
                 //this field should be renamed
-                sourceSqlString = KDbEscapedString(d->conn->escapeIdentifier(renamedFieldName));
+                rebuilder.setSourceField(f->name(), renamedFieldName);
             } else if (!f->defaultValue().isNull()) {
                 //this field has a default value defined
 //! @todo support expressions (eg. TODAY()) as a default value
 //! @todo this field can be notNull or notEmpty - check whether the default is ok
 //!       (or do this checking also in the Table Designer?)
-                sourceSqlString = d->conn->driver()->valueToSql(type, f->defaultValue());
+                rebuilder.setSourceExpression(f->name(),
+                    d->conn->driver()->valueToSql(type, f->defaultValue()));
             } else if (f->isNotNull()) {
                 //this field cannot be null
-                sourceSqlString = d->conn->driver()->valueToSql(
-                                      type, KDb::emptyValueForFieldType(type));
+                rebuilder.setSourceExpression(f->name(),
+                    d->conn->driver()->valueToSql(type, KDb::emptyValueForFieldType(type)));
             } else if (f->isNotEmpty()) {
                 //this field cannot be empty - use any nonempty value..., e.g. " " for text or 0 for number
-                sourceSqlString = d->conn->driver()->valueToSql(
-                                      type, KDb::notEmptyValueForFieldType(type));
+                rebuilder.setSourceExpression(f->name(),
+                    d->conn->driver()->valueToSql(type, KDb::notEmptyValueForFieldType(type)));
             }
 //! @todo support unique, validatationRule, unsigned flags...
 //! @todo check for foreignKey values...
-
-            if (!sourceSqlString.isEmpty()) {
-                if (first) {
-                    first = false;
-                } else {
-                    sql.append(", ");
-                    sourceFields.append(", ");
-                }
-                sql += d->conn->escapeIdentifier(f->name());
-                sourceFields.append(sourceSqlString);
-            }
         }
-        sql += (") SELECT " + sourceFields + " FROM " + oldTable->name());
-        kdbDebug() << " ** " << sql;
-        if (!d->conn->executeSql(sql)) {
-            m_result = d->conn->result();
-//! @todo delete newTable...
-            args->result = false;
+        const tristate copied = rebuilder.copyData();
+        if (copied != true) {
+            m_result = rebuilder.result();
+            if (true != d->conn->dropTable(newTable)) { // also deletes newTable
+                kdbWarning() << "Could not drop temporary table";
+            }
+            args->result = copied;
             return nullptr;
         }
 
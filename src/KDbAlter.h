@@ -29,6 +29,7 @@
 #include <QHash>
 
 class KDbConnection;
+class KDbTableRebuildProgressHandler;
 
 //! @short A tool for handling altering database table schema.
 /*! In relational (and other) databases, table schema altering is not an easy task.
@@ -463,7 +464,9 @@ public:
                 , requirements(0)
                 , result(false)
                 , simulate(false)
-                , onlyComputeRequirements(false) {
+                , onlyComputeRequirements(false)
+                , chunkSize(0)
+                , progressHandler(nullptr) {
         }
         /*! If not 0, debug is directed here. Used only in the alter table test suite. */
         QString* debugString;
@@ -476,6 +479,14 @@ public:
         /*! Set to true if requirements should be computed
          and the execute() method should return afterwards. */
         bool onlyComputeRequirements;
+        /*! Maximum number of records copied in a single transaction when the table is recreated,
+         see KDbTableRebuilder::setChunkSize(). If 0, the default is used.
+         @since 3.3 */
+        int chunkSize;
+        /*! If not 0, notified about progress of copying records when the table is recreated.
+         Copying is cancelled when the handler returns false.
+         @since 3.3 */
+        KDbTableRebuildProgressHandler *progressHandler;
     private:
         Q_DISABLE_COPY(ExecutionArguments)
     };
@@ -0,0 +1,253 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbAsyncQuery.h"
+#include "KDbAsyncQuery_p.h"
+#include "KDbConnection.h"
+#include "KDbCursor.h"
+#include "KDbRecordData.h"
+#include "kdb_debug.h"
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QTimer>
+
+KDbAsyncQuery::KDbAsyncQuery()
+    : QObject()
+    , d(new Private)
+{
+}
+
+KDbAsyncQuery::~KDbAsyncQuery()
+{
+    if (!d->finished) {
+        cancel();
+    }
+    delete d;
+}
+
+KDbEscapedString KDbAsyncQuery::sql() const
+{
+    return d->job ? d->job->sql : KDbEscapedString();
+}
+
+bool KDbAsyncQuery::isFinished() const
+{
+    return d->finished;
+}
+
+bool KDbAsyncQuery::isCanceled() const
+{
+    return d->canceled;
+}
+
+int KDbAsyncQuery::recordCount() const
+{
+    return d->finished ? d->job->records.count() : 0;
+}
+
+KDbRecordData* KDbAsyncQuery::record(int index) const
+{
+    return d->finished ? d->job->records.value(index) : nullptr;
+}
+
+QList<KDbRecordData*> KDbAsyncQuery::takeRecords()
+{
+    if (!d->finished) {
+        return QList<KDbRecordData*>();
+    }
+    QList<KDbRecordData*> records;
+    records.swap(d->job->records);
+    return records;
+}
+
+bool KDbAsyncQuery::waitForFinished(int msecs)
+{
+    if (d->finished) {
+        return true;
+    }
+    QEventLoop loop;
+    connect(this, &KDbAsyncQuery::finished, &loop, &QEventLoop::quit);
+    if (msecs >= 0) {
+        QTimer::singleShot(msecs, &loop, &QEventLoop::quit);
+    }
+    loop.exec(QEventLoop::ExcludeUserInputEvents);
+    return d->finished;
+}
+
+void KDbAsyncQuery::cancel()
+{
+    if (d->finished) {
+        return;
+    }
+    if (d->worker && d->worker->dequeue(d->job)) {
+        d->finished = true;
+        d->canceled = true;
+        emit finished();
+        return;
+    }
+    if (d->worker) {
+        d->worker->cancel(d->job);
+    }
+}
+
+//-------------------------------
+
+KDbAsyncQueryWorker::KDbAsyncQueryWorker(KDbConnection *connection, const QString &databaseName)
+    : m_connection(connection)
+    , m_databaseName(databaseName)
+{
+    qRegisterMetaType<KDbAsyncQueryJobPointer>();
+    connect(this, &KDbAsyncQueryWorker::jobFinished, this, &KDbAsyncQueryWorker::slotJobFinished,
+            Qt::QueuedConnection);
+}
+
+KDbAsyncQueryWorker::~KDbAsyncQueryWorker()
+{
+    stop();
+    delete m_connection;
+}
+
+void KDbAsyncQueryWorker::enqueue(const KDbAsyncQueryJobPointer &job)
+{
+    QMutexLocker locker(&m_mutex);
+    m_jobs.enqueue(job);
+    m_condition.wakeOne();
+}
+
+bool KDbAsyncQueryWorker::dequeue(const KDbAsyncQueryJobPointer &job)
+{
+    QMutexLocker locker(&m_mutex);
+    return m_jobs.removeOne(job);
+}
+
+void KDbAsyncQueryWorker::cancel(const KDbAsyncQueryJobPointer &job)
+{
+    job->canceled.store(1);
+    QMutexLocker locker(&m_mutex);
+    if (m_currentJob == job) {
+        m_connection->cancel(); // interrupt the statement if the driver supports this
+    }
+}
+
+void KDbAsyncQueryWorker::stop()
+{
+    QQueue<KDbAsyncQueryJobPointer> pendingJobs;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stop = true;
+        if (m_currentJob) {
+            m_currentJob->canceled.store(1);
+            m_connection->cancel();
+        }
+        pendingJobs.swap(m_jobs);
+        m_condition.wakeAll();
+    }
+    wait();
+    // deliver notification about the job that has been executed while stopping
+    QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
+    for (const KDbAsyncQueryJobPointer &job : qAsConst(pendingJobs)) {
+        job->canceled.store(1);
+        slotJobFinished(job);
+    }
+}
+
+void KDbAsyncQueryWorker::run()
+{
+    const bool connected = m_connection->connect()
+        && (m_databaseName.isEmpty() || m_connection->useDatabase(m_databaseName, false));
+    if (!connected) {
+        kdbWarning() << "Could not open connection for asynchronous queries:" << m_connection->result();
+    }
+    forever {
+        KDbAsyncQueryJobPointer job;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (!m_stop && m_jobs.isEmpty()) {
+                m_condition.wait(&m_mutex);
+            }
+            if (m_stop) {
+                break;
+            }
+            job = m_jobs.dequeue();
+            m_currentJob = job;
+        }
+        if (connected) {
+            execute(job.data());
+        } else {
+            job->result = m_connection->result();
+        }
+        {
+            QMutexLocker locker(&m_mutex);
+            m_currentJob.clear();
+        }
+        emit jobFinished(job);
+    }
+    m_connection->disconnect();
+}
+
+void KDbAsyncQueryWorker::execute(KDbAsyncQueryJob *job)
+{
+    if (job->canceled.load()) {
+        return;
+    }
+    job->executed = true;
+    if (job->type == KDbAsyncQueryJob::Type::Sql) {
+        if (!m_connection->executeSql(job->sql)) {
+            job->result = m_connection->result();
+        }
+        return;
+    }
+    KDbCursor *cursor = m_connection->executeQuery(job->sql);
+    if (!cursor) {
+        job->result = m_connection->result();
+        return;
+    }
+    if (cursor->moveFirst() || !cursor->result().isError()) {
+        while (!cursor->eof() && !job->canceled.load()) {
+            KDbRecordData *record = cursor->storeCurrentRecord();
+            if (!record) {
+                break;
+            }
+            job->records.append(record);
+            if (!cursor->moveNext() && cursor->result().isError()) {
+                break;
+            }
+        }
+    }
+    if (cursor->result().isError()) {
+        job->result = cursor->result();
+    }
+    m_connection->deleteCursor(cursor);
+}
+
+void KDbAsyncQueryWorker::slotJobFinished(const KDbAsyncQueryJobPointer &job)
+{
+    if (job->executed && !job->result.isError()) {
+        emit statementExecuted(job->sql);
+    }
+    KDbAsyncQuery *handle = job->handle;
+    if (!handle || handle->d->finished) {
+        return;
+    }
+    handle->m_result = job->result;
+    handle->d->finished = true;
+    handle->d->canceled = job->canceled.load();
+    emit handle->finished();
+}
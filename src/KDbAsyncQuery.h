@@ -0,0 +1,92 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_ASYNCQUERY_H
+#define KDB_ASYNCQUERY_H
+
+#include <QObject>
+
+#include "KDbEscapedString.h"
+#include "KDbResult.h"
+
+class KDbRecordData;
+
+/*! @brief Handle of a query executed asynchronously.
+
+ Objects of this class are returned by KDbConnection::executeQueryAsync() and
+ KDbConnection::executeSqlAsync(). The finished() signal is emitted when execution
+ is finished, canceled or failed. Then result() and the retrieved records can be accessed.
+
+ The handle is owned by the caller. Deleting the handle cancels the query.
+ @since 3.3
+*/
+class KDB_EXPORT KDbAsyncQuery : public QObject, public KDbResultable
+{
+    Q_OBJECT
+public:
+    ~KDbAsyncQuery() override;
+
+    //! @return the SQL statement executed by this query
+    KDbEscapedString sql() const;
+
+    //! @return true if execution of the query is finished, canceled or failed
+    bool isFinished() const;
+
+    //! @return true if the query has been canceled before it has finished
+    bool isCanceled() const;
+
+    //! @return number of records retrieved
+    //! Records are only retrieved for queries created by KDbConnection::executeQueryAsync().
+    int recordCount() const;
+
+    //! @return record at position @a index or @c nullptr if there is no such record.
+    //! The record is owned by this handle.
+    KDbRecordData* record(int index) const;
+
+    //! @return all the retrieved records. Ownership of the records is passed to the caller
+    //! and they are removed from this handle.
+    QList<KDbRecordData*> takeRecords();
+
+    /*! Blocks until execution of the query is finished or until @a msecs milliseconds passed.
+     If @a msecs is -1, there is no timeout. Events are processed while waiting.
+     @return true if the query is finished. */
+    bool waitForFinished(int msecs = -1);
+
+public Q_SLOTS:
+    /*! Cancels the query. If the query is still waiting for execution, it is removed from
+     the queue and finished() is emitted. Otherwise retrieving records is stopped and
+     finished() is emitted when the executing thread notices the request. */
+    void cancel();
+
+Q_SIGNALS:
+    //! Emitted when execution of the query is finished, canceled or failed
+    void finished();
+
+private:
+    KDbAsyncQuery();
+
+    friend class KDbAsyncQueryWorker;
+    friend class KDbConnectionPrivate;
+
+    Q_DISABLE_COPY(KDbAsyncQuery)
+    class Private;
+    Private * const d;
+};
+
+#endif
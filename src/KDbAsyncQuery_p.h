@@ -0,0 +1,141 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_ASYNCQUERY_P_H
+#define KDB_ASYNCQUERY_P_H
+
+#include "KDbAsyncQuery.h"
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QPointer>
+#include <QQueue>
+#include <QSharedPointer>
+#include <QThread>
+#include <QWaitCondition>
+
+class KDbAsyncQueryWorker;
+class KDbConnection;
+
+//! @internal Data of a single asynchronous query, shared by the handle and the worker.
+//! Results are only written by the worker thread before the job is reported as finished.
+class KDbAsyncQueryJob
+{
+public:
+    enum class Type {
+        Query, //!< SELECT statement, records are retrieved
+        Sql    //!< statement without results
+    };
+
+    KDbAsyncQueryJob(Type aType, const KDbEscapedString &aSql)
+        : type(aType), sql(aSql)
+    {
+    }
+
+    ~KDbAsyncQueryJob() {
+        qDeleteAll(records);
+    }
+
+    const Type type;
+    const KDbEscapedString sql;
+    KDbResult result;
+    QList<KDbRecordData*> records;
+    QAtomicInt canceled;
+    //! true if the statement has been executed, set by the worker thread
+    bool executed = false;
+    //! Handle of the job, only accessed from the thread of the handle
+    QPointer<KDbAsyncQuery> handle;
+private:
+    Q_DISABLE_COPY(KDbAsyncQueryJob)
+};
+
+typedef QSharedPointer<KDbAsyncQueryJob> KDbAsyncQueryJobPointer;
+
+Q_DECLARE_METATYPE(KDbAsyncQueryJobPointer)
+
+class Q_DECL_HIDDEN KDbAsyncQuery::Private
+{
+public:
+    Private() {}
+    KDbAsyncQueryJobPointer job;
+    QPointer<KDbAsyncQueryWorker> worker;
+    bool finished = false;
+    bool canceled = false;
+private:
+    Q_DISABLE_COPY(Private)
+};
+
+/*! @internal Thread executing asynchronous queries of a connection.
+ The thread uses its own connection to the same database, created for the same
+ driver, connection data and options, so queries are executed sequentially
+ without blocking the original connection. */
+class KDbAsyncQueryWorker : public QThread
+{
+    Q_OBJECT
+public:
+    //! Creates worker for @a connection that will use database @a databaseName.
+    //! Ownership of @a connection is passed to the worker.
+    KDbAsyncQueryWorker(KDbConnection *connection, const QString &databaseName);
+
+    //! Stops the thread and deletes the connection
+    ~KDbAsyncQueryWorker() override;
+
+    //! Appends @a job to the queue of jobs to execute.
+    void enqueue(const KDbAsyncQueryJobPointer &job);
+
+    //! Removes @a job from the queue. @return false if the job is not waiting for execution.
+    bool dequeue(const KDbAsyncQueryJobPointer &job);
+
+    //! Requests canceling of @a job if it is being executed.
+    //! Its statement is interrupted using KDbConnection::cancel() if supported by the driver.
+    void cancel(const KDbAsyncQueryJobPointer &job);
+
+    /*! Stops the thread. Jobs waiting for execution are canceled, currently executed
+     job is canceled and finished. Handles of all the jobs are notified. */
+    void stop();
+
+Q_SIGNALS:
+    //! Emitted by the worker thread when @a job is finished
+    void jobFinished(const KDbAsyncQueryJobPointer &job);
+
+    //! Emitted in the thread of the worker object after statement @a sql has been executed
+    //! by the worker thread, before handle of the job is notified
+    void statementExecuted(const KDbEscapedString &sql);
+
+protected:
+    void run() override;
+
+private Q_SLOTS:
+    //! Notifies handle of the @a job, called in the thread of the worker object
+    void slotJobFinished(const KDbAsyncQueryJobPointer &job);
+
+private:
+    void execute(KDbAsyncQueryJob *job);
+
+    KDbConnection * const m_connection;
+    const QString m_databaseName;
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+    QQueue<KDbAsyncQueryJobPointer> m_jobs;
+    KDbAsyncQueryJobPointer m_currentJob;
+    bool m_stop = false;
+    Q_DISABLE_COPY(KDbAsyncQueryWorker)
+};
+
+#endif
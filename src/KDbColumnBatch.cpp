@@ -0,0 +1,285 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbColumnBatch.h"
+
+//! Values of a single column of KDbColumnBatch
+class KDbColumnBatchColumn
+{
+public:
+    //! @return number of values
+    int count() const {
+        switch (storage) {
+        case KDbColumnBatch::Storage::Integer: return integers.count();
+        case KDbColumnBatch::Storage::Real: return reals.count();
+        case KDbColumnBatch::Storage::Text: return texts.count();
+        case KDbColumnBatch::Storage::Blob: return blobs.count();
+        case KDbColumnBatch::Storage::Variant: return variants.count();
+        }
+        return 0;
+    }
+
+    //! Marks value of record @a record as null
+    void setNull(int record) {
+        if (nulls.size() <= record) {
+            nulls.resize(record + 1);
+        }
+        nulls.setBit(record);
+    }
+
+    KDbColumnBatch::Storage storage = KDbColumnBatch::Storage::Variant;
+    KDbField::Type fieldType = KDbField::InvalidType;
+    QBitArray nulls;
+    QVector<qint64> integers;
+    QVector<double> reals;
+    QVector<QString> texts;
+    QVector<QByteArray> blobs;
+    QVector<QVariant> variants;
+};
+
+class Q_DECL_HIDDEN KDbColumnBatch::Private
+{
+public:
+    Private() {}
+
+    QVector<KDbColumnBatchColumn> columns;
+    int recordCount = 0;
+    Q_DISABLE_COPY(Private)
+};
+
+//! @return storage used for values of fields of type @a type
+static KDbColumnBatch::Storage storageForType(KDbField::Type type)
+{
+    if (KDbField::isIntegerType(type) || type == KDbField::Boolean) {
+        return KDbColumnBatch::Storage::Integer;
+    }
+    if (KDbField::isFPNumericType(type)) {
+        return KDbColumnBatch::Storage::Real;
+    }
+    if (KDbField::isTextType(type)) {
+        return KDbColumnBatch::Storage::Text;
+    }
+    if (type == KDbField::BLOB) {
+        return KDbColumnBatch::Storage::Blob;
+    }
+    return KDbColumnBatch::Storage::Variant;
+}
+
+//! Removes values of @a vector keeping memory for @a capacity values
+template <typename T>
+static void resetVector(QVector<T> *vector, int capacity, bool used)
+{
+    if (!used) {
+        vector->clear();
+        return;
+    }
+    vector->resize(0);
+    vector->reserve(capacity);
+}
+
+KDbColumnBatch::KDbColumnBatch()
+    : d(new Private)
+{
+}
+
+KDbColumnBatch::~KDbColumnBatch()
+{
+    delete d;
+}
+
+int KDbColumnBatch::columnCount() const
+{
+    return d->columns.count();
+}
+
+int KDbColumnBatch::recordCount() const
+{
+    return d->recordCount;
+}
+
+KDbColumnBatch::Storage KDbColumnBatch::storage(int column) const
+{
+    return d->columns.at(column).storage;
+}
+
+KDbField::Type KDbColumnBatch::fieldType(int column) const
+{
+    return d->columns.at(column).fieldType;
+}
+
+const QBitArray& KDbColumnBatch::nulls(int column) const
+{
+    return d->columns.at(column).nulls;
+}
+
+bool KDbColumnBatch::isNull(int record, int column) const
+{
+    const QBitArray &nulls = d->columns.at(column).nulls;
+    return record < nulls.size() && nulls.testBit(record);
+}
+
+const QVector<qint64>& KDbColumnBatch::integers(int column) const
+{
+    return d->columns.at(column).integers;
+}
+
+const QVector<double>& KDbColumnBatch::reals(int column) const
+{
+    return d->columns.at(column).reals;
+}
+
+const QVector<QString>& KDbColumnBatch::texts(int column) const
+{
+    return d->columns.at(column).texts;
+}
+
+const QVector<QByteArray>& KDbColumnBatch::blobs(int column) const
+{
+    return d->columns.at(column).blobs;
+}
+
+const QVector<QVariant>& KDbColumnBatch::variants(int column) const
+{
+    return d->columns.at(column).variants;
+}
+
+QVariant KDbColumnBatch::value(int record, int column) const
+{
+    if (column < 0 || column >= d->columns.count() || record < 0 || record >= d->recordCount
+        || isNull(record, column))
+    {
+        return QVariant();
+    }
+    const KDbColumnBatchColumn &c = d->columns.at(column);
+    switch (c.storage) {
+    case Storage::Integer: {
+        const qint64 integer = c.integers.at(record);
+        if (c.fieldType == KDbField::Boolean) {
+            return QVariant(integer != 0);
+        }
+        if (c.fieldType == KDbField::BigInteger) {
+            return QVariant(integer);
+        }
+        return QVariant(int(integer));
+    }
+    case Storage::Real:
+        return QVariant(c.reals.at(record));
+    case Storage::Text:
+        return QVariant(c.texts.at(record));
+    case Storage::Blob:
+        return QVariant(c.blobs.at(record));
+    case Storage::Variant:
+        return c.variants.at(record);
+    }
+    return QVariant();
+}
+
+void KDbColumnBatch::reset(const QVector<KDbField::Type> &types, int capacity)
+{
+    d->recordCount = 0;
+    d->columns.resize(types.count());
+    for (int i = 0; i < types.count(); ++i) {
+        KDbColumnBatchColumn *c = &d->columns[i];
+        c->fieldType = types.at(i);
+        c->storage = storageForType(c->fieldType);
+        c->nulls.fill(false, capacity);
+        resetVector(&c->integers, capacity, c->storage == Storage::Integer);
+        resetVector(&c->reals, capacity, c->storage == Storage::Real);
+        resetVector(&c->texts, capacity, c->storage == Storage::Text);
+        resetVector(&c->blobs, capacity, c->storage == Storage::Blob);
+        resetVector(&c->variants, capacity, c->storage == Storage::Variant);
+    }
+}
+
+void KDbColumnBatch::appendNull(int column)
+{
+    KDbColumnBatchColumn *c = &d->columns[column];
+    c->setNull(c->count());
+    switch (c->storage) {
+    case Storage::Integer:
+        c->integers.append(0);
+        break;
+    case Storage::Real:
+        c->reals.append(0.0);
+        break;
+    case Storage::Text:
+        c->texts.append(QString());
+        break;
+    case Storage::Blob:
+        c->blobs.append(QByteArray());
+        break;
+    case Storage::Variant:
+        c->variants.append(QVariant());
+        break;
+    }
+}
+
+void KDbColumnBatch::appendInteger(int column, qint64 value)
+{
+    d->columns[column].integers.append(value);
+}
+
+void KDbColumnBatch::appendReal(int column, double value)
+{
+    d->columns[column].reals.append(value);
+}
+
+void KDbColumnBatch::appendText(int column, const QString &value)
+{
+    d->columns[column].texts.append(value);
+}
+
+void KDbColumnBatch::appendBlob(int column, const QByteArray &value)
+{
+    d->columns[column].blobs.append(value);
+}
+
+void KDbColumnBatch::appendValue(int column, const QVariant &value)
+{
+    if (value.isNull()) {
+        appendNull(column);
+        return;
+    }
+    KDbColumnBatchColumn *c = &d->columns[column];
+    switch (c->storage) {
+    case Storage::Integer:
+        c->integers.append(value.toLongLong());
+        break;
+    case Storage::Real:
+        c->reals.append(value.toDouble());
+        break;
+    case Storage::Text:
+        c->texts.append(value.toString());
+        break;
+    case Storage::Blob:
+        c->blobs.append(value.toByteArray());
+        break;
+    case Storage::Variant:
+        c->variants.append(value);
+        break;
+    }
+}
+
+void KDbColumnBatch::setRecordCount(int count)
+{
+    d->recordCount = count;
+    for (KDbColumnBatchColumn &c : d->columns) {
+        c.nulls.resize(count);
+    }
+}
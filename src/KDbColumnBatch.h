@@ -0,0 +1,145 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_COLUMNBATCH_H
+#define KDB_COLUMNBATCH_H
+
+#include "KDbField.h"
+
+#include <QBitArray>
+#include <QVector>
+
+/*! @brief Records fetched by KDbCursor::fetchBatch(), stored by columns
+
+ Values of each column are stored in a vector of a type selected by the column's field type,
+ see storage(). Null values are marked in a bitmap of the column, see nulls(); the vector
+ contains a default value for them, so value of record @a r is always at index @a r.
+ Columns of cursors defined by raw SQL statements have no field type and use
+ Storage::Variant.
+
+ The batch can be reused for subsequent calls of KDbCursor::fetchBatch(); memory allocated
+ for the values is kept.
+
+ Example of summing values of the first column:
+ @code
+ KDbColumnBatch batch;
+ qint64 sum = 0;
+ while (cursor->fetchBatch(&batch, 1024) > 0) {
+     const QVector<qint64> &values = batch.integers(0);
+     const QBitArray &nulls = batch.nulls(0);
+     for (int i = 0; i < batch.recordCount(); ++i) {
+         if (!nulls.testBit(i)) {
+             sum += values[i];
+         }
+     }
+ }
+ @endcode
+ @since 3.3
+*/
+class KDB_EXPORT KDbColumnBatch
+{
+public:
+    //! Storage of values of a column
+    enum class Storage {
+        Integer, //!< integer and boolean values, see integers()
+        Real,    //!< floating point values, see reals()
+        Text,    //!< text values, see texts()
+        Blob,    //!< BLOB values, see blobs()
+        Variant  //!< values of other types, see variants()
+    };
+
+    KDbColumnBatch();
+
+    ~KDbColumnBatch();
+
+    //! @return number of columns
+    int columnCount() const;
+
+    //! @return number of records
+    int recordCount() const;
+
+    //! @return storage of values of column @a column
+    Storage storage(int column) const;
+
+    //! @return field type of column @a column, KDbField::InvalidType for columns
+    //! of raw SQL statements
+    KDbField::Type fieldType(int column) const;
+
+    //! @return bitmap of null values of column @a column, bit @a r is set if value
+    //! of record @a r is null
+    const QBitArray& nulls(int column) const;
+
+    //! @return true if value of column @a column of record @a record is null
+    bool isNull(int record, int column) const;
+
+    //! @return values of column @a column with Storage::Integer storage
+    const QVector<qint64>& integers(int column) const;
+
+    //! @return values of column @a column with Storage::Real storage
+    const QVector<double>& reals(int column) const;
+
+    //! @return values of column @a column with Storage::Text storage
+    const QVector<QString>& texts(int column) const;
+
+    //! @return values of column @a column with Storage::Blob storage
+    const QVector<QByteArray>& blobs(int column) const;
+
+    //! @return values of column @a column with Storage::Variant storage
+    const QVector<QVariant>& variants(int column) const;
+
+    /*! @return value of column @a column of record @a record converted to QVariant.
+     Values of boolean columns are returned as bool, values of integer columns as int,
+     except for KDbField::BigInteger columns returned as qint64.
+     This method is slower than accessing the vectors directly. */
+    QVariant value(int record, int column) const;
+
+    /*! Removes all records and sets columns to ones with field types @a types.
+     Memory for @a capacity records is reserved. Used by KDbCursor. */
+    void reset(const QVector<KDbField::Type> &types, int capacity);
+
+    //! Appends null value to column @a column. Used by drivers.
+    void appendNull(int column);
+
+    //! Appends @a value to column @a column with Storage::Integer storage. Used by drivers.
+    void appendInteger(int column, qint64 value);
+
+    //! Appends @a value to column @a column with Storage::Real storage. Used by drivers.
+    void appendReal(int column, double value);
+
+    //! Appends @a value to column @a column with Storage::Text storage. Used by drivers.
+    void appendText(int column, const QString &value);
+
+    //! Appends @a value to column @a column with Storage::Blob storage. Used by drivers.
+    void appendBlob(int column, const QByteArray &value);
+
+    //! Appends @a value converted to storage of column @a column. Null values are appended
+    //! as nulls. Used by drivers.
+    void appendValue(int column, const QVariant &value);
+
+    //! Sets number of records to @a count. Each column should contain @a count values.
+    //! Used by KDbCursor.
+    void setRecordCount(int count);
+
+private:
+    class Private;
+    Private * const d;
+    Q_DISABLE_COPY(KDbColumnBatch)
+};
+
+#endif
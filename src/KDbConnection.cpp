@@ -19,12 +19,16 @@
 
 #include "KDbConnection.h"
 #include "KDbConnection_p.h"
+#include "KDbAsyncQuery.h"
 #include "KDbCursor.h"
+#include "KDbDataExport_p.h"
+#include "KDbDataImport_p.h"
 #include "KDbDriverBehavior.h"
 #include "KDbDriverMetaData.h"
 #include "KDbDriver_p.h"
 #include "KDbLookupFieldSchema.h"
 #include "KDbNativeStatementBuilder.h"
+#include "KDbPrefetchCursor_p.h"
 #include "KDbQuerySchema.h"
 #include "KDbQuerySchema_p.h"
 #include "KDbRecordData.h"
@@ -33,14 +37,19 @@
 #include "KDbSqlRecord.h"
 #include "KDbSqlResult.h"
 #include "KDbTableOrQuerySchema.h"
+#include "KDbTableRebuilder.h"
 #include "KDbTableSchemaChangeListener.h"
 #include "KDbTransactionData.h"
 #include "KDbTransactionGuard.h"
+#include "KDbTracer_p.h"
 #include "kdb_debug.h"
 
 #include <QDir>
 #include <QFileInfo>
 #include <QDomDocument>
+#include <QTimer>
+
+#include <algorithm>
 
 /*! Version number of extended table schema.
 
@@ -55,6 +64,17 @@ KDbConnectionInternal::KDbConnectionInternal(KDbConnection *conn)
 {
 }
 
+void KDbConnectionInternal::statementTimedOut()
+{
+    connection->d->statementInterruption.testAndSetOrdered(
+        KDbConnectionPrivate::NoInterruption, KDbConnectionPrivate::StatementTimedOut);
+}
+
+void KDbConnectionInternal::statementExecuted(const KDbEscapedString &sql)
+{
+    connection->d->statementExecuted(sql);
+}
+
 class CursorDeleter
 {
 public:
@@ -63,6 +83,52 @@ public:
     }
 };
 
+//! @return @a options without KDbCursor::Option::Prefetch, used for creating driver's cursors
+static KDbCursor::Options withoutPrefetch(KDbCursor::Options options)
+{
+    return options & ~KDbCursor::Options(KDbCursor::Option::Prefetch);
+}
+
+//! @return cursor prefetching records of @a cursor if @a options contain
+//! KDbCursor::Option::Prefetch, @a cursor otherwise
+static KDbCursor* prefetchingCursor(KDbCursor *cursor, KDbCursor::Options options)
+{
+    if (!cursor || !(options & KDbCursor::Option::Prefetch)) {
+        return cursor;
+    }
+    return KDbPrefetchCursor::create(cursor);
+}
+
+//! Marks data modification that can be grouped in a batch of writes.
+//! Unless finish(true) is called, the write is considered as failed.
+class BatchedWrite
+{
+public:
+    explicit BatchedWrite(KDbConnectionPrivate *d)
+        : m_d(d), m_started(d->beginBatchedWrite())
+    {
+    }
+    ~BatchedWrite() {
+        if (m_started && !m_finished) {
+            (void)m_d->endBatchedWrite(false);
+        }
+    }
+    //! @return false if the write could not be started
+    bool isStarted() const {
+        return m_started;
+    }
+    //! Finishes the write, @a ok is its result. @return @a ok or false if committing failed.
+    bool finish(bool ok) {
+        m_finished = true;
+        return m_d->endBatchedWrite(ok);
+    }
+private:
+    KDbConnectionPrivate * const m_d;
+    const bool m_started;
+    bool m_finished = false;
+    Q_DISABLE_COPY(BatchedWrite)
+};
+
 //================================================
 
 class Q_DECL_HIDDEN KDbConnectionOptions::Private
@@ -86,6 +152,20 @@ KDbConnectionOptions::KDbConnectionOptions()
  : d(new Private)
 {
     KDbUtils::PropertySet::insert("readOnly", false, tr("Read only", "Read only connection"));
+    KDbUtils::PropertySet::insert("performanceProfile",
+                                  performanceProfileName(PerformanceProfile::Default),
+                                  tr("Performance profile"));
+}
+
+//! @return true if @a value is a valid value of the "performanceProfile" option, warns otherwise
+static bool isValidPerformanceProfile(const QVariant &value)
+{
+    bool ok;
+    KDbConnectionOptions::performanceProfileForName(value.toString(), &ok);
+    if (!ok) {
+        kdbWarning() << value << "is not a valid performance profile";
+    }
+    return ok;
 }
 
 KDbConnectionOptions::KDbConnectionOptions(const KDbConnectionOptions &other)
@@ -125,6 +205,9 @@ void KDbConnectionOptions::insert(const QByteArray &name, const QVariant &value,
         setReadOnly(value.toBool());
         return;
     }
+    if (name == "performanceProfile" && !isValidPerformanceProfile(value)) {
+        return;
+    }
     QString realCaption;
     if (property(name).caption().isEmpty()) { // don't allow to change the caption
         realCaption = caption;
@@ -134,7 +217,7 @@ void KDbConnectionOptions::insert(const QByteArray &name, const QVariant &value,
 
 void KDbConnectionOptions::setCaption(const QByteArray &name, const QString &caption)
 {
-    if (name == "readOnly") {
+    if (name == "readOnly" || name == "performanceProfile") {
         return;
     }
     KDbUtils::PropertySet::setCaption(name, caption);
@@ -146,12 +229,15 @@ void KDbConnectionOptions::setValue(const QByteArray &name, const QVariant &valu
         setReadOnly(value.toBool());
         return;
     }
+    if (name == "performanceProfile" && !isValidPerformanceProfile(value)) {
+        return;
+    }
     KDbUtils::PropertySet::setValue(name, value);
 }
 
 void KDbConnectionOptions::remove(const QByteArray &name)
 {
-    if (name == "readOnly") {
+    if (name == "readOnly" || name == "performanceProfile") {
         return;
     }
     KDbUtils::PropertySet::remove(name);
@@ -165,6 +251,44 @@ void KDbConnectionOptions::setReadOnly(bool set)
     KDbUtils::PropertySet::setValue("readOnly", set);
 }
 
+KDbConnectionOptions::PerformanceProfile KDbConnectionOptions::performanceProfile() const
+{
+    return performanceProfileForName(property("performanceProfile").value().toString());
+}
+
+void KDbConnectionOptions::setPerformanceProfile(PerformanceProfile profile)
+{
+    KDbUtils::PropertySet::setValue("performanceProfile", performanceProfileName(profile));
+}
+
+static const char* const performanceProfileNames[] = {
+    "default", "durable", "fast-wal", "read-mostly-mmap"
+};
+
+//static
+QString KDbConnectionOptions::performanceProfileName(PerformanceProfile profile)
+{
+    return QLatin1String(performanceProfileNames[static_cast<int>(profile)]);
+}
+
+//static
+KDbConnectionOptions::PerformanceProfile KDbConnectionOptions::performanceProfileForName(
+        const QString &name, bool *ok)
+{
+    for (int i = 0; i <= static_cast<int>(PerformanceProfile::ReadMostlyMmap); ++i) {
+        if (name == QLatin1String(performanceProfileNames[i])) {
+            if (ok) {
+                *ok = true;
+            }
+            return static_cast<PerformanceProfile>(i);
+        }
+    }
+    if (ok) {
+        *ok = false;
+    }
+    return PerformanceProfile::Default;
+}
+
 void KDbConnectionOptions::setConnection(KDbConnection *connection)
 {
     d->connection = connection;
@@ -179,12 +303,16 @@ KDbConnectionPrivate::KDbConnectionPrivate(KDbConnection* const conn, KDbDriver
         , options(_options)
         , driver(drv)
         , dbProperties(conn)
+        , statementBuffer(drv)
+        , lookupValues(conn)
 {
     options.setConnection(conn);
 }
 
 KDbConnectionPrivate::~KDbConnectionPrivate()
 {
+    delete writeBatchTimer;
+    deleteAsyncQueryWorker();
     options.setConnection(nullptr);
     deleteAllCursors();
     delete m_parser;
@@ -201,6 +329,295 @@ void KDbConnectionPrivate::deleteAllCursors()
     }
 }
 
+KDbAsyncQuery* KDbConnectionPrivate::executeAsync(KDbAsyncQueryJob::Type type,
+                                                  const KDbEscapedString &sql)
+{
+    if (!conn->checkIsDatabaseUsed()) {
+        return nullptr;
+    }
+    if (sql.isEmpty()) {
+        conn->m_result = KDbResult(ERR_SQL_EXECUTION_ERROR,
+                                   KDbConnection::tr("Statement is empty."));
+        return nullptr;
+    }
+    if (!asyncQueryWorker) {
+        KDbConnection *workerConnection = driver->createConnection(connData, options);
+        if (!workerConnection) {
+            conn->m_result = driver->result();
+            return nullptr;
+        }
+        asyncQueryWorker = new KDbAsyncQueryWorker(workerConnection, usedDatabase);
+        // versions of modified tables are bumped when the worker has executed the statement,
+        // not earlier, so results of queries executed in the meantime are not kept in caches
+        QObject::connect(asyncQueryWorker, &KDbAsyncQueryWorker::statementExecuted,
+                         asyncQueryWorker, [this](const KDbEscapedString &statement) {
+                             statementExecuted(statement);
+                         });
+        asyncQueryWorker->start();
+    }
+    KDbAsyncQueryJobPointer job(new KDbAsyncQueryJob(type, sql));
+    KDbAsyncQuery *query = new KDbAsyncQuery;
+    query->d->job = job;
+    query->d->worker = asyncQueryWorker;
+    job->handle = query;
+    asyncQueryWorker->enqueue(job);
+    return query;
+}
+
+void KDbConnectionPrivate::deleteAsyncQueryWorker()
+{
+    delete asyncQueryWorker;
+    asyncQueryWorker = nullptr;
+}
+
+void KDbConnectionPrivate::resetStatementInterruption()
+{
+    statementInterruption.storeRelease(NoInterruption);
+}
+
+bool KDbConnectionPrivate::takeStatementInterruption(KDbResult *result)
+{
+    switch (statementInterruption.fetchAndStoreOrdered(NoInterruption)) {
+    case StatementCanceled:
+        result->setCode(ERR_QUERY_CANCELED);
+        result->setMessage(tr("Execution of the statement has been canceled."));
+        return true;
+    case StatementTimedOut:
+        result->setCode(ERR_QUERY_CANCELED);
+        result->setMessage(tr("Execution of the statement has timed out."));
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+//! @return next word of @a sql starting at @a *pos, quotes of identifiers are removed
+static QByteArray nextWord(const QByteArray &sql, int *pos)
+{
+    int i = *pos;
+    while (i < sql.length() && QChar::isSpace(uchar(sql.at(i)))) {
+        ++i;
+    }
+    if (i >= sql.length()) {
+        *pos = i;
+        return QByteArray();
+    }
+    char closing = 0;
+    switch (sql.at(i)) {
+    case '"': closing = '"'; break;
+    case '`': closing = '`'; break;
+    case '[': closing = ']'; break;
+    default:;
+    }
+    int start = i;
+    if (closing) {
+        ++start;
+        i = sql.indexOf(closing, start);
+        if (i < 0) {
+            i = sql.length();
+        }
+        *pos = i + 1;
+        return sql.mid(start, i - start);
+    }
+    while (i < sql.length() && !QChar::isSpace(uchar(sql.at(i)))
+           && sql.at(i) != '(' && sql.at(i) != ';' && sql.at(i) != '.')
+    {
+        ++i;
+    }
+    *pos = i;
+    return sql.mid(start, i - start);
+}
+
+//! @return next table name of @a sql starting at @a *pos without the schema qualifier,
+//! e.g. "t" for main.t or "public"."t"
+static QByteArray nextTableName(const QByteArray &sql, int *pos)
+{
+    QByteArray name(nextWord(sql, pos));
+    while (*pos < sql.length() && sql.at(*pos) == '.') {
+        ++(*pos);
+        name = nextWord(sql, pos);
+    }
+    return name;
+}
+
+/*! @return true if statement @a sql can modify data. Name of the modified table is set
+ in @a tableName; it is empty if the statement is not recognized as a modification
+ of a single table, e.g. for schema changes or rollbacks. */
+static bool modifiesData(const KDbEscapedString &sql, QString *tableName)
+{
+    const QByteArray statement(sql.toByteArray());
+    int pos = 0;
+    const QByteArray command(nextWord(statement, &pos).toUpper());
+    QByteArray table;
+    if (command == "SELECT" || command == "BEGIN" || command == "COMMIT" || command == "END"
+        || command == "SAVEPOINT" || command == "RELEASE" || command == "PRAGMA"
+        || command == "EXPLAIN" || command == "SHOW" || command == "SET")
+    {
+        return false;
+    } else if (command == "INSERT" || command == "REPLACE" || command == "UPDATE") {
+        table = nextTableName(statement, &pos);
+        if (table.toUpper() == "OR") { // "INSERT OR REPLACE INTO" or "UPDATE OR IGNORE"
+            nextWord(statement, &pos);
+            table = nextTableName(statement, &pos);
+        }
+        if (command != "UPDATE" && table.toUpper() == "INTO") {
+            table = nextTableName(statement, &pos);
+        }
+    } else if (command == "DELETE") {
+        table = nextTableName(statement, &pos);
+        if (table.toUpper() == "FROM") {
+            table = nextTableName(statement, &pos);
+        }
+    }
+    *tableName = QString::fromUtf8(table);
+    return true;
+}
+
+void KDbConnectionPrivate::statementExecuted(const KDbEscapedString &sql)
+{
+    if (!resultCache.isEnabled() && lookupValues.isEmpty()) {
+        return;
+    }
+    QString tableName;
+    if (modifiesData(sql, &tableName)) {
+        tableModified(tableName);
+    }
+}
+
+void KDbConnectionPrivate::tableModified(const QString &tableName)
+{
+    resultCache.tableModified(tableName);
+    lookupValues.tableChanged(tableName);
+}
+
+bool KDbConnectionPrivate::cursorContainsRecordIdInfo(const KDbQuerySchema *query) const
+{
+    return query && query->masterTable()
+           && driver->behavior()->ROW_ID_FIELD_RETURNS_LAST_AUTOINCREMENTED_VALUE == false;
+}
+
+bool KDbConnectionPrivate::generateCursorStatement(KDbEscapedString *sql, KDbQuerySchema *query,
+                                                   const QList<QVariant> &params,
+                                                   bool alsoRetrieveRecordId)
+{
+    KDbSelectStatementOptions options;
+    options.setAlsoRetrieveRecordId(alsoRetrieveRecordId);
+    options.setUseLookupValueCache(lookupValues.maxRecords > 0);
+    KDbNativeStatementBuilder builder(conn, KDb::DriverEscaping);
+    return builder.generateSelectStatement(sql, query, options, params) && !sql->isEmpty();
+}
+
+KDbCursor* KDbConnectionPrivate::prepareCachedQuery(KDbQuerySchema *query,
+                                                    const QList<QVariant> &params,
+                                                    KDbCursor::Options options)
+{
+    KDbEscapedString sql;
+    if (!query || !generateCursorStatement(&sql, query, params, cursorContainsRecordIdInfo(query))) {
+        return nullptr;
+    }
+    const QSharedPointer<const KDbResultCacheData> data(
+        resultCache.data(KDbResultCache::key(sql, params)));
+    if (!data) {
+        return nullptr;
+    }
+    KDbCursor *cursor = new KDbResultCacheCursor(conn, query, data, options);
+    cursor->setQueryParameters(params);
+    return cursor;
+}
+
+bool KDbConnectionPrivate::beginBatchedWrite()
+{
+    if (!writeBatchingEnabled || !autoCommit) {
+        return true;
+    }
+    if (!writeBatchTransaction.isActive()) {
+        if (!transactions.isEmpty()) {
+            return true; // transaction started by the user is in progress, don't interfere
+        }
+        writeBatchTransaction = conn->beginTransaction();
+        if (writeBatchTransaction.isNull()) {
+            return false;
+        }
+        writeBatchSize = 0;
+        writeBatchAge.start();
+        if (writeBatchMaxDelay > 0) {
+            if (!writeBatchTimer) {
+                writeBatchTimer = new QTimer;
+                writeBatchTimer->setSingleShot(true);
+                QObject::connect(writeBatchTimer, &QTimer::timeout, [this]() {
+                    if (!flushWriteBatch()) {
+                        kdbWarning() << "Could not commit batch of writes:" << conn->result();
+                    }
+                });
+            }
+            writeBatchTimer->start(writeBatchMaxDelay);
+        }
+    }
+    if (driver->behavior()->FAILED_STATEMENT_ABORTS_TRANSACTION) {
+        // isolate the write so its failure does not abort the whole batch
+        if (!conn->executeSql(KDbEscapedString("SAVEPOINT kdb__write_batch"))) {
+            return false;
+        }
+        writeBatchSavepoint = true;
+    }
+    return true;
+}
+
+bool KDbConnectionPrivate::endBatchedWrite(bool ok)
+{
+    if (!writeBatchTransaction.isActive()) {
+        return ok;
+    }
+    const KDbResult result = conn->result(); // keep error of the write
+    if (writeBatchSavepoint) {
+        writeBatchSavepoint = false;
+        if (!conn->executeSql(ok ? KDbEscapedString("RELEASE SAVEPOINT kdb__write_batch")
+                                 : KDbEscapedString("ROLLBACK TO SAVEPOINT kdb__write_batch")))
+        {
+            if (ok) {
+                return false;
+            }
+            kdbWarning() << "Could not roll back to savepoint:" << conn->result();
+        }
+    }
+    if (ok) {
+        ++writeBatchSize;
+    }
+    if (writeBatchSize >= writeBatchMaxWrites
+        || (writeBatchMaxDelay > 0 && writeBatchAge.hasExpired(writeBatchMaxDelay)))
+    {
+        if (!flushWriteBatch()) {
+            return false;
+        }
+    }
+    conn->m_result = result;
+    return ok;
+}
+
+bool KDbConnectionPrivate::flushWriteBatch()
+{
+    if (writeBatchTimer) {
+        writeBatchTimer->stop();
+    }
+    const KDbTransaction trans = writeBatchTransaction;
+    const int size = writeBatchSize;
+    writeBatchTransaction = KDbTransaction();
+    writeBatchSize = 0;
+    if (!trans.isActive()) { // e.g. the user has committed the default transaction
+        return true;
+    }
+    if (!conn->commitTransaction(trans)) {
+        return false;
+    }
+    if (size > 0) {
+        ++writeBatchStatistics.batches;
+        writeBatchStatistics.writes += size;
+        writeBatchStatistics.largestBatch = qMax(writeBatchStatistics.largestBatch, size);
+    }
+    return true;
+}
+
 void KDbConnectionPrivate::errorInvalidDBContents(const QString& details)
 {
     conn->m_result = KDbResult(ERR_INVALID_DATABASE_CONTENTS,
@@ -269,7 +686,7 @@ void KDbConnectionPrivate::insertTable(KDbTableSchema* tableSchema)
     } else {
         m_tables.insert(tableSchema->id(), tableSchema);
     }
-    m_tablesByName.insert(tableSchema->name(), tableSchema);
+    m_symbols.intern(tableSchema->name()).setTable(tableSchema);
 }
 
 void KDbConnectionPrivate::removeTable(int id)
@@ -280,8 +697,10 @@ void KDbConnectionPrivate::removeTable(int id)
         return;
     }
     KDbTableSchemaChangeListener::unregisterForChanges(conn, toDelete.data());
-    const int count = m_tablesByName.remove(toDelete->name());
-    Q_ASSERT_X(count == 1, "KDbConnectionPrivate::removeTable", "Table to remove not found");
+    dmlPlans.removeTable(toDelete.data());
+    Q_ASSERT_X(table(toDelete->name()) == toDelete.data(), "KDbConnectionPrivate::removeTable",
+               "Table to remove not found");
+    unbindTable(toDelete.data());
 }
 
 void KDbConnectionPrivate::takeTable(KDbTableSchema* tableSchema)
@@ -289,15 +708,26 @@ void KDbConnectionPrivate::takeTable(KDbTableSchema* tableSchema)
     if (m_tables.isEmpty()) {
         return;
     }
+    dmlPlans.removeTable(tableSchema);
     m_tables.take(tableSchema->id());
-    m_tablesByName.take(tableSchema->name());
+    unbindTable(tableSchema);
 }
 
 void KDbConnectionPrivate::renameTable(KDbTableSchema* tableSchema, const QString& newName)
 {
-    m_tablesByName.take(tableSchema->name());
+    unbindTable(tableSchema);
+    dmlPlans.removeTable(tableSchema);
     tableSchema->setName(newName);
-    m_tablesByName.insert(tableSchema->name(), tableSchema);
+    m_symbols.intern(tableSchema->name()).setTable(tableSchema);
+}
+
+void KDbConnectionPrivate::unbindTable(KDbTableSchema* tableSchema)
+{
+    KDbSymbol symbol(m_symbols.find(tableSchema->name()));
+    if (symbol.table() == tableSchema) {
+        symbol.setTable(nullptr);
+        m_symbols.release(symbol);
+    }
 }
 
 void KDbConnectionPrivate::changeTableId(KDbTableSchema* tableSchema, int newId)
@@ -308,7 +738,15 @@ void KDbConnectionPrivate::changeTableId(KDbTableSchema* tableSchema, int newId)
 
 void KDbConnectionPrivate::clearTables()
 {
-    m_tablesByName.clear();
+    dmlPlans.clear();
+    lookupValues.clear();
+    resultCache.clear();
+    for (KDbTableSchema *table : qAsConst(m_tables)) {
+        unbindTable(table);
+    }
+    for (KDbTableSchema *table : qAsConst(m_internalKDbTables)) {
+        unbindTable(table);
+    }
     qDeleteAll(m_internalKDbTables);
     m_internalKDbTables.clear();
     QHash<int, KDbTableSchema*> tablesToDelete(m_tables);
@@ -319,12 +757,12 @@ void KDbConnectionPrivate::clearTables()
 void KDbConnectionPrivate::insertQuery(KDbQuerySchema* query)
 {
     m_queries.insert(query->id(), query);
-    m_queriesByName.insert(query->name(), query);
+    m_symbols.intern(query->name()).setQuery(query);
 }
 
 void KDbConnectionPrivate::removeQuery(KDbQuerySchema* querySchema)
 {
-    m_queriesByName.remove(querySchema->name());
+    unbindQuery(querySchema);
     m_queries.remove(querySchema->id());
     delete querySchema;
 }
@@ -332,12 +770,24 @@ void KDbConnectionPrivate::removeQuery(KDbQuerySchema* querySchema)
 void KDbConnectionPrivate::setQueryObsolete(KDbQuerySchema* query)
 {
     obsoleteQueries.insert(query);
-    m_queriesByName.take(query->name());
+    unbindQuery(query);
     m_queries.take(query->id());
 }
 
+void KDbConnectionPrivate::unbindQuery(KDbQuerySchema* query)
+{
+    KDbSymbol symbol(m_symbols.find(query->name()));
+    if (symbol.query() == query) {
+        symbol.setQuery(nullptr);
+        m_symbols.release(symbol);
+    }
+}
+
 void KDbConnectionPrivate::clearQueries()
 {
+    for (KDbQuerySchema *query : qAsConst(m_queries)) {
+        unbindQuery(query);
+    }
     qDeleteAll(m_queries);
     m_queries.clear();
 }
@@ -437,6 +887,232 @@ void KDbConnectionPrivate::removeFieldsExpanded(const KDbQuerySchema *query)
 {
     //kdbDebug() << "**CACHE REMOVE**" << query;
     m_fieldsExpandedCache.remove(query);
+    dmlPlans.removeQuery(query);
+}
+
+//! @return primary key of @a table or @c nullptr if there is no key or it has no fields
+static KDbIndexSchema* nonEmptyPrimaryKey(KDbTableSchema *table)
+{
+    KDbIndexSchema *pkey = table->primaryKey();
+    return (pkey && !pkey->fields()->isEmpty()) ? pkey : nullptr;
+}
+
+KDbDmlPlan* KDbConnectionPrivate::dmlPlan(KDbDmlPlan::Type type, KDbQuerySchema *query,
+                                          bool useRecordId,
+                                          const QVector<KDbQueryColumnInfo*> &columns)
+{
+    KDbDmlPlan *cached = dmlPlans.find(query, type, useRecordId, columns);
+    if (cached) {
+        return cached;
+    }
+    KDbTableSchema *mt = query->masterTable();
+    if (!mt) {
+        kdbWarning() << " -- NO MASTER TABLE!";
+        switch (type) {
+        case KDbDmlPlan::Type::Update:
+            conn->m_result = KDbResult(ERR_UPDATE_NO_MASTER_TABLE,
+                KDbConnection::tr("Could not update record because there is no master table defined."));
+            break;
+        case KDbDmlPlan::Type::Insert:
+            conn->m_result = KDbResult(ERR_INSERT_NO_MASTER_TABLE,
+                KDbConnection::tr("Could not insert record because there is no master table specified."));
+            break;
+        case KDbDmlPlan::Type::Delete:
+            conn->m_result = KDbResult(ERR_DELETE_NO_MASTER_TABLE,
+                KDbConnection::tr("Could not delete record because there is no master table specified."));
+            break;
+        }
+        return nullptr;
+    }
+    KDbIndexSchema *pkey = nonEmptyPrimaryKey(mt);
+    QScopedPointer<KDbDmlPlan> plan(new KDbDmlPlan(type, query, useRecordId, columns));
+    plan->masterTable = mt;
+    plan->columnsOrderExpanded = query->columnsOrder(conn, KDbQuerySchema::ColumnsOrderMode::ExpandedList);
+    // segments are small and long-lived, so don't reserve space for them
+    KDbStatementBuffer sql(driver, 0);
+    bool needsKey = true;
+    switch (type) {
+    case KDbDmlPlan::Type::Update: {
+        if (!useRecordId && !pkey) {
+            kdbWarning() << " -- NO MASTER TABLE's PKEY!";
+            conn->m_result = KDbResult(ERR_UPDATE_NO_MASTER_TABLES_PKEY,
+                KDbConnection::tr("Could not update record because master table has no primary key defined."));
+//! @todo perhaps we can try to update without using PKEY?
+            return nullptr;
+        }
+        if (pkey && pkey->fieldCount() != query->pkeyFieldCount(conn)) { //sanity check
+            kdbWarning() << " -- NO ENTIRE MASTER TABLE's PKEY SPECIFIED!";
+            conn->m_result = KDbResult(ERR_UPDATE_NO_ENTIRE_MASTER_TABLES_PKEY,
+                KDbConnection::tr("Could not update record because it does not contain entire primary key of master table."));
+            return nullptr;
+        }
+        sql.append("UPDATE ").appendIdentifier(mt->name()).append(" SET ");
+        bool first = true;
+        for (KDbQueryColumnInfo *ci : columns) {
+            KDbField *field = ci->field();
+            if (field->table() != mt)
+                continue; // skip values for fields outside of the master table (e.g. a "visible value" of the lookup field)
+            if (first)
+                first = false;
+            else
+                sql.append(',');
+            const bool affectedFieldsAddOk = plan->affectedFields.addField(field);
+            Q_ASSERT(affectedFieldsAddOk);
+            sql.appendIdentifier(field->name()).append('=');
+            plan->addValue(&sql, field->type(), ci);
+        }
+        sql.append(" WHERE ");
+        break;
+    }
+    case KDbDmlPlan::Type::Insert: {
+        if (!useRecordId && !pkey) {
+            kdbWarning() << " -- WARNING: NO MASTER TABLE's PKEY";
+        }
+        needsKey = false;
+        // add default values, if available (for any column without value explicitly set)
+        const KDbQueryColumnInfo::Vector fieldsExpanded(
+            query->fieldsExpanded(conn, KDbQuerySchema::FieldsExpandedMode::Unique));
+        plan->fieldsExpandedCount = fieldsExpanded.count();
+        for (KDbQueryColumnInfo *ci : fieldsExpanded) {
+            if (ci->field() && KDb::isDefaultValueAllowed(*ci->field())
+                    && !ci->field()->defaultValue().isNull()
+                    && !std::binary_search(columns.constBegin(), columns.constEnd(), ci))
+            {
+                plan->defaultColumns.append(ci);
+            }
+        }
+        sql.append("INSERT INTO ").appendIdentifier(mt->name()).append(" (");
+        QVector<KDbQueryColumnInfo*> valueColumns;
+        if (columns.isEmpty() && plan->defaultColumns.isEmpty()) {
+            // empty record inserting requested:
+            if (!useRecordId && !pkey) {
+                kdbWarning() << "MASTER TABLE's PKEY REQUIRED FOR INSERTING EMPTY RECORDS: INSERT CANCELLED";
+                conn->m_result = KDbResult(ERR_INSERT_NO_MASTER_TABLES_PKEY,
+                    KDbConnection::tr("Could not insert record because master table has no primary key specified."));
+                return nullptr;
+            }
+            if (pkey && pkey->fieldCount() != query->pkeyFieldCount(conn)) { // sanity check
+                kdbWarning() << "NO ENTIRE MASTER TABLE's PKEY SPECIFIED!";
+                conn->m_result = KDbResult(ERR_INSERT_NO_ENTIRE_MASTER_TABLES_PKEY,
+                    KDbConnection::tr("Could not insert record because it does not contain "
+                                      "entire master table's primary key."));
+                return nullptr;
+            }
+            //at least one value is needed for VALUES section: find it and set to NULL:
+            KDbField *anyField = mt->anyNonPKField();
+            if (!anyField) {
+                if (!pkey) {
+                    kdbWarning() << "WARNING: NO FIELD AVAILABLE TO SET IT TO NULL";
+                    return nullptr;
+                }
+                //try to set NULL in pkey field (could not work for every SQL engine!)
+                anyField = pkey->fields()->first();
+            }
+            sql.appendIdentifier(anyField->name()).append(") VALUES (");
+            plan->addValue(&sql, anyField->type(), nullptr/*NULL*/);
+            const bool affectedFieldsAddOk = plan->affectedFields.addField(anyField);
+            Q_ASSERT(affectedFieldsAddOk);
+        } else {
+            // non-empty record inserting requested:
+            for (KDbQueryColumnInfo *ci : columns + plan->defaultColumns) {
+                KDbField *field = ci->field();
+                if (field->table() != mt)
+                    continue; // skip values for fields outside of the master table (e.g. a "visible value" of the lookup field)
+                if (!valueColumns.isEmpty()) {
+                    sql.append(',');
+                }
+                const bool affectedFieldsAddOk = plan->affectedFields.addField(field);
+                Q_ASSERT(affectedFieldsAddOk);
+                sql.appendIdentifier(field->name());
+                valueColumns.append(ci);
+            }
+            sql.append(") VALUES (");
+            bool first = true;
+            for (KDbQueryColumnInfo *ci : qAsConst(valueColumns)) {
+                if (first)
+                    first = false;
+                else
+                    sql.append(',');
+                plan->addValue(&sql, ci->field()->type(), ci);
+            }
+        }
+        sql.append(')');
+        KDbQueryColumnInfo::List *aif_list = query->autoIncrementFields(conn);
+        if (pkey && !aif_list->isEmpty()) {
+            //! @todo now only if PKEY is present, this should also work when there's no PKEY
+            KDbField *idField = aif_list->first()->field();
+            KDbStatementBuffer aif_sql(driver, 0);
+            aif_sql.append("SELECT ").append(query->autoIncrementSqlFieldsList(conn))
+                   .append(" FROM ").appendIdentifier(idField->table()->name())
+                   .append(" WHERE ").appendIdentifier(idField->name()).append('=');
+            plan->autoIncrementSql = aif_sql.statement();
+            plan->autoIncrementSql.squeeze();
+        }
+        break;
+    }
+    case KDbDmlPlan::Type::Delete:
+//! @todo allow to delete from a table without pkey
+        if (!useRecordId && !pkey) {
+            kdbWarning() << " -- WARNING: NO MASTER TABLE's PKEY";
+            conn->m_result = KDbResult(ERR_DELETE_NO_MASTER_TABLES_PKEY,
+                KDbConnection::tr("Could not delete record because there is no primary key for master table specified."));
+            return nullptr;
+        }
+        if (pkey && pkey->fieldCount() != query->pkeyFieldCount(conn)) { //sanity check
+            kdbWarning() << " -- NO ENTIRE MASTER TABLE's PKEY SPECIFIED!";
+            conn->m_result = KDbResult(ERR_DELETE_NO_ENTIRE_MASTER_TABLES_PKEY,
+                KDbConnection::tr("Could not delete record because it does not contain entire master table's primary key."));
+            return nullptr;
+        }
+        sql.append("DELETE FROM ").appendIdentifier(mt->name()).append(" WHERE ");
+        break;
+    }
+    if (needsKey) {
+        if (pkey) {
+            const QVector<int> pkeyFieldsOrder(query->pkeyFieldsOrder(conn));
+            int i = 0;
+            for (KDbField *f : qAsConst(*pkey->fields())) {
+                if (i > 0)
+                    sql.append(" AND ");
+                sql.appendIdentifier(f->name()).append('=');
+                plan->addKey(&sql, f, pkeyFieldsOrder.at(i));
+                i++;
+            }
+        } else { //use RecordId
+            sql.appendIdentifier(driver->behavior()->ROW_ID_FIELD_NAME).append('=');
+            plan->addKey(&sql, nullptr, -1);
+        }
+    }
+    plan->finish(&sql);
+    KDbDmlPlan *result = plan.take();
+    dmlPlans.insert(result);
+    return result;
+}
+
+bool KDbConnectionPrivate::dmlPlanValues(const KDbDmlPlan &plan,
+                                         const KDbRecordEditBuffer::DbHash &buffer,
+                                         const KDbRecordData &data, QVector<QVariant> *values)
+{
+    values->clear();
+    values->reserve(plan.valueTypes.count());
+    for (KDbQueryColumnInfo *ci : plan.valueColumns) {
+        values->append(ci ? buffer.value(ci) : QVariant()/*NULL*/);
+    }
+    for (int i = 0; i < plan.keyFields.count(); ++i) {
+        const int position = plan.keyPositions.at(i);
+        const QVariant val(position >= 0 ? data.at(position) : data.at(data.size() - 1));
+        KDbField *f = plan.keyFields.at(i);
+        if (f && (val.isNull() || !val.isValid())) {
+            conn->m_result = KDbResult(
+                plan.type == KDbDmlPlan::Type::Update ? ERR_UPDATE_NULL_PKEY_FIELD
+                                                      : ERR_DELETE_NULL_PKEY_FIELD,
+                KDbConnection::tr("Primary key's field \"%1\" cannot be empty.").arg(f->name()));
+            //js todo: pass the field's name somewhere!
+            return false;
+        }
+        values->append(val);
+    }
+    return true;
 }
 
 //================================================
@@ -845,6 +1521,10 @@ bool KDbConnection::useDatabase(const QString &dbName, bool kexiCompatible, bool
         d->databaseVersion.setMajor(major);
         d->databaseVersion.setMinor(minor);
     }
+    if (d->statementTimeout > 0 && !drv_setStatementTimeout(d->statementTimeout)) {
+        kdbWarning() << "Could not set statement timeout of" << d->statementTimeout
+                     << "ms for database" << my_dbName;
+    }
     d->usedDatabase = my_dbName;
     return true;
 }
@@ -858,6 +1538,11 @@ bool KDbConnection::closeDatabase()
 
     bool ret = true;
 
+    //commit pending writes, they are expected to be stored
+    if (!d->flushWriteBatch()) {
+        ret = false;
+    }
+
     /*! @todo (js) add CLEVER algorithm here for nested transactions */
     if (d->driver->transactionsSupported()) {
         //rollback all transactions
@@ -876,6 +1561,8 @@ bool KDbConnection::closeDatabase()
         d->transactions.clear(); //free trans. data
     }
 
+    //stop asynchronous queries, they use the same database
+    d->deleteAsyncQueryWorker();
     //delete own cursors:
     d->deleteAllCursors();
     //delete own schemas
@@ -1108,19 +1795,19 @@ QList<int> KDbConnection::objectIds(int objectType, bool* ok)
 //yeah, it is very efficient:
 #define C_A(a) , const QVariant& c ## a
 
-#define V_A0 d->driver->valueToSql( tableSchema->field(0), c0 )
-#define V_A(a) + ',' + d->driver->valueToSql( \
-        tableSchema->field(a) ? tableSchema->field(a)->type() : KDbField::Text, c ## a )
-
-//  kdbDebug() << "******** " << QString("INSERT INTO ") +
-//   escapeIdentifier(tableSchema->name()) +
-//   " VALUES (" + vals + ")";
+#define V_A0 buffer.appendValue(tableSchema->field(0), c0);
+#define V_A(a) buffer.append(',').appendValue( \
+        tableSchema->field(a) ? tableSchema->field(a)->type() : KDbField::Text, c ## a );
 
 QSharedPointer<KDbSqlResult> KDbConnection::insertRecordInternal(const QString &tableSchemaName,
                                                                  KDbFieldList *fields,
                                                                  const KDbEscapedString &sql)
 {
     QSharedPointer<KDbSqlResult> res;
+    BatchedWrite write(d);
+    if (!write.isStarted()) {
+        return res;
+    }
     if (!drv_beforeInsert(tableSchemaName,fields )) {
         return res;
     }
@@ -1142,16 +1829,21 @@ QSharedPointer<KDbSqlResult> KDbConnection::insertRecordInternal(const QString &
     if (res->lastResult().isError()) {
         res.clear();
     }
+    if (!write.finish(!res.isNull())) {
+        res.clear();
+    }
     return res;
 }
 
 #define C_INS_REC(args, vals) \
     QSharedPointer<KDbSqlResult> KDbConnection::insertRecord(KDbTableSchema* tableSchema args) { \
-        return insertRecordInternal(tableSchema->name(), tableSchema, \
-                   KDbEscapedString("INSERT INTO ") + escapeIdentifier(tableSchema->name()) \
-                       + " (" \
-                       + tableSchema->sqlFieldsList(this) \
-                       + ") VALUES (" + vals + ')'); \
+        KDbStatementBuffer &buffer(d->statementBuffer); \
+        buffer.clear(); \
+        buffer.append("INSERT INTO ").appendIdentifier(tableSchema->name()) \
+              .append(" (").append(tableSchema->sqlFieldsList(this)).append(") VALUES ("); \
+        vals \
+        buffer.append(')'); \
+        return insertRecordInternal(tableSchema->name(), tableSchema, buffer.statement()); \
     }
 
 #define C_INS_REC_ALL \
@@ -1170,22 +1862,22 @@ C_INS_REC_ALL
 #undef V_A
 #undef C_INS_REC
 
-#define V_A0 value += d->driver->valueToSql( it.next(), c0 );
-#define V_A( a ) value += (',' + d->driver->valueToSql( it.next(), c ## a ));
+#define V_A0 buffer.appendValue(it.next(), c0);
+#define V_A(a) buffer.append(',').appendValue(it.next(), c ## a);
 
 #define C_INS_REC(args, vals) \
     QSharedPointer<KDbSqlResult> KDbConnection::insertRecord(KDbFieldList* fields args) \
     { \
-        KDbEscapedString value; \
         const KDbField::List *flist = fields->fields(); \
         QListIterator<KDbField*> it(*flist); \
+        const QString tableName((it.hasNext() && it.peekNext()->table()) ? it.peekNext()->table()->name() : QLatin1String("??")); \
+        KDbStatementBuffer &buffer(d->statementBuffer); \
+        buffer.clear(); \
+        buffer.append("INSERT INTO ").appendIdentifier(tableName) \
+              .append(" (").append(fields->sqlFieldsList(this)).append(") VALUES ("); \
         vals \
-        it.toFront(); \
-        QString tableName((it.hasNext() && it.peekNext()->table()) ? it.next()->table()->name() : QLatin1String("??")); \
-        return insertRecordInternal(tableName, fields, \
-                   KDbEscapedString(QLatin1String("INSERT INTO ") + escapeIdentifier(tableName)) \
-                   + " (" + fields->sqlFieldsList(this) \
-                   + ") VALUES (" + value + ')'); \
+        buffer.append(')'); \
+        return insertRecordInternal(tableName, fields, buffer.statement()); \
     }
 
 C_INS_REC_ALL
@@ -1207,23 +1899,22 @@ QSharedPointer<KDbSqlResult> KDbConnection::insertRecord(KDbTableSchema *tableSc
     }
     KDbField::ListIterator fieldsIt(flist->constBegin());
     QList<QVariant>::ConstIterator it = values.constBegin();
-    KDbEscapedString sql;
-    sql.reserve(4096);
+    KDbStatementBuffer &buffer(d->statementBuffer);
+    buffer.clear();
     while (fieldsIt != flist->constEnd() && (it != values.end())) {
         KDbField *f = *fieldsIt;
-        if (sql.isEmpty()) {
-            sql = KDbEscapedString("INSERT INTO ") + escapeIdentifier(tableSchema->name())
-                  + " VALUES (";
+        if (buffer.isEmpty()) {
+            buffer.append("INSERT INTO ").appendIdentifier(tableSchema->name()).append(" VALUES (");
         }
         else {
-            sql += ',';
+            buffer.append(',');
         }
-        sql += d->driver->valueToSql(f, *it);
-//  kdbDebug() << "val" << i++ << ": " << d->driver->valueToSql( f, *it );
+        buffer.appendValue(f, *it);
         ++it;
         ++fieldsIt;
     }
-    sql += ')';
+    buffer.append(')');
+    const KDbEscapedString sql(buffer.statement());
     m_result.setSql(sql);
     res = insertRecordInternal(tableSchema->name(), tableSchema, sql);
     return res;
@@ -1239,63 +1930,176 @@ QSharedPointer<KDbSqlResult> KDbConnection::insertRecord(KDbFieldList *fields,
         return res;
     }
     KDbField::ListIterator fieldsIt(flist->constBegin());
-    KDbEscapedString sql;
-    sql.reserve(4096);
+    KDbStatementBuffer &buffer(d->statementBuffer);
+    buffer.clear();
     QList<QVariant>::ConstIterator it = values.constBegin();
     const QString tableName(flist->first()->table()->name());
     while (fieldsIt != flist->constEnd() && it != values.constEnd()) {
         KDbField *f = *fieldsIt;
-        if (sql.isEmpty()) {
-            sql = KDbEscapedString("INSERT INTO ") + escapeIdentifier(tableName) + '(' +
-                  fields->sqlFieldsList(this) + ") VALUES (";
+        if (buffer.isEmpty()) {
+            buffer.append("INSERT INTO ").appendIdentifier(tableName).append('(')
+                  .append(fields->sqlFieldsList(this)).append(") VALUES (");
         }
         else {
-            sql += ',';
+            buffer.append(',');
         }
-        sql += d->driver->valueToSql(f, *it);
-//  kdbDebug() << "val" << i++ << ": " << d->driver->valueToSql( f, *it );
+        buffer.appendValue(f, *it);
         ++it;
         ++fieldsIt;
         if (fieldsIt == flist->constEnd())
             break;
     }
-    sql += ')';
-    m_result.setSql(sql);
-    res = insertRecordInternal(tableName, fields, sql);
-    return res;
+    buffer.append(')');
+    const KDbEscapedString sql(buffer.statement());
+    m_result.setSql(sql);
+    res = insertRecordInternal(tableName, fields, sql);
+    return res;
+}
+
+inline static bool checkSql(const KDbEscapedString& sql, KDbResult* result)
+{
+    Q_ASSERT(result);
+    if (!sql.isValid()) {
+        *result = KDbResult(ERR_SQL_EXECUTION_ERROR,
+                            KDbConnection::tr("SQL statement for execution is invalid or empty."));
+        result->setErrorSql(sql); //remember for error handling
+        return false;
+    }
+    return true;
+}
+
+QSharedPointer<KDbSqlResult> KDbConnection::prepareSql(const KDbEscapedString& sql)
+{
+    m_result.setSql(sql);
+    KDbTraceScope trace(d->tracer, KDbTraceEvent::Type::PrepareSql);
+    QSharedPointer<KDbSqlResult> result(drv_prepareSql(sql));
+    trace.mark(&KDbTraceEvent::prepareTime);
+    trace.finish(sql, !result.isNull());
+    if (result) {
+        // Some drivers execute the statement already here, others on the first fetch
+        // and then report it using KDbConnectionInternal::statementExecuted().
+        d->statementExecuted(sql);
+    }
+    return result;
+}
+
+bool KDbConnection::executeSql(const KDbEscapedString& sql)
+{
+    m_result.setSql(sql);
+    if (!checkSql(sql, &m_result)) {
+        return false;
+    }
+    d->resetStatementInterruption();
+    KDbTraceScope trace(d->tracer, KDbTraceEvent::Type::ExecuteSql);
+    const bool ok = drv_executeSql(sql);
+    trace.mark(&KDbTraceEvent::executeTime);
+    trace.finish(sql, ok);
+    if (!ok) {
+        m_result.setMessage(QString()); //clear as this could be most probably just "Unknown error" string.
+        m_result.setErrorSql(sql);
+        d->takeStatementInterruption(&m_result);
+        m_result.prependMessage(ERR_SQL_EXECUTION_ERROR,
+                                tr("Error while executing SQL statement."));
+        kdbWarning() << m_result;
+        return false;
+    }
+    d->statementExecuted(sql);
+    return true;
+}
+
+bool KDbConnection::cancel()
+{
+    d->statementInterruption.storeRelease(KDbConnectionPrivate::StatementCanceled);
+    if (!drv_cancel()) {
+        d->resetStatementInterruption();
+        return false;
+    }
+    return true;
 }
 
-inline static bool checkSql(const KDbEscapedString& sql, KDbResult* result)
+bool KDbConnection::setStatementTimeout(int msecs)
 {
-    Q_ASSERT(result);
-    if (!sql.isValid()) {
-        *result = KDbResult(ERR_SQL_EXECUTION_ERROR,
-                            KDbConnection::tr("SQL statement for execution is invalid or empty."));
-        result->setErrorSql(sql); //remember for error handling
+    msecs = qMax(0, msecs);
+    if (isDatabaseUsed() && !drv_setStatementTimeout(msecs)) {
+        m_result = KDbResult(ERR_UNSUPPORTED_DRV_FEATURE,
+                             tr("Statement timeouts are not supported for \"%1\" driver.")
+                                .arg(d->driver->metaData()->name()));
         return false;
     }
+    d->statementTimeout = msecs;
     return true;
 }
 
-QSharedPointer<KDbSqlResult> KDbConnection::prepareSql(const KDbEscapedString& sql)
+int KDbConnection::statementTimeout() const
 {
-    m_result.setSql(sql);
-    return QSharedPointer<KDbSqlResult>(drv_prepareSql(sql));
+    return d->statementTimeout;
 }
 
-bool KDbConnection::executeSql(const KDbEscapedString& sql)
+bool KDbConnection::drv_cancel()
 {
-    m_result.setSql(sql);
-    if (!checkSql(sql, &m_result)) {
+    return false;
+}
+
+bool KDbConnection::drv_setStatementTimeout(int msecs)
+{
+    Q_UNUSED(msecs);
+    return false;
+}
+
+KDbReadSnapshotData* KDbConnection::drv_pinReadSnapshot()
+{
+    return nullptr;
+}
+
+bool KDbConnection::drv_beginReadSnapshot(KDbReadSnapshotData *snapshot)
+{
+    Q_UNUSED(snapshot);
+    return false;
+}
+
+bool KDbConnection::drv_endReadSnapshot()
+{
+    return false;
+}
+
+bool KDbConnection::drv_updateTableStatistics(const QString &tableName)
+{
+    Q_UNUSED(tableName);
+    return true;
+}
+
+tristate KDbConnection::drv_approximateRecordCount(const KDbTableSchema &tableSchema, int *count)
+{
+    Q_UNUSED(tableSchema);
+    Q_UNUSED(count);
+    return cancelled;
+}
+
+bool KDbConnection::drv_insertBatch(KDbFieldList *fields, const KDbImportBatch &batch)
+{
+    KDbPreparedStatement statement = prepareStatement(KDbPreparedStatement::InsertStatement, fields);
+    if (!statement.isValid()) {
+        if (!m_result.isError()) {
+            m_result = KDbResult(ERR_OTHER, tr("Could not prepare statement for inserting records."));
+        }
         return false;
     }
-    if (!drv_executeSql(sql)) {
-        m_result.setMessage(QString()); //clear as this could be most probably just "Unknown error" string.
-        m_result.setErrorSql(sql);
-        m_result.prependMessage(ERR_SQL_EXECUTION_ERROR,
-                                tr("Error while executing SQL statement."));
-        kdbWarning() << m_result;
-        return false;
+    const int columnCount = batch.columns.count();
+    KDbPreparedStatementParameters parameters;
+    parameters.reserve(columnCount);
+    for (int record = 0; record < batch.recordCount; ++record) {
+        parameters.clear();
+        for (int column = 0; column < columnCount; ++column) {
+            parameters.append(batch.columns[column][record]);
+        }
+        if (!statement.execute(parameters)) {
+            if (!m_result.isError()) {
+                m_result = statement.result().isError()
+                        ? statement.result()
+                        : KDbResult(ERR_OTHER, tr("Could not insert record."));
+            }
+            return false;
+        }
     }
     return true;
 }
@@ -1613,6 +2417,7 @@ tristate KDbConnection::dropTableInternal(KDbTableSchema* tableSchema, bool also
     tristate res = KDbTableSchemaChangeListener::closeListeners(this, tableSchema);
     if (true != res)
         return res;
+    d->dmlPlans.removeTable(tableSchema);
 
     //sanity checks:
     if (d->driver->isSystemObjectName(tableSchema->name())) {
@@ -1674,6 +2479,7 @@ tristate KDbConnection::alterTable(KDbTableSchema* tableSchema, KDbTableSchema*
     tristate res = KDbTableSchemaChangeListener::closeListeners(this, tableSchema);
     if (true != res)
         return res;
+    d->dmlPlans.removeTable(tableSchema);
 
     if (tableSchema == newTableSchema) {
         m_result = KDbResult(ERR_OBJECT_THE_SAME,
@@ -1681,20 +2487,44 @@ tristate KDbConnection::alterTable(KDbTableSchema* tableSchema, KDbTableSchema*
                                 .arg(tableSchema->name()));
         return false;
     }
-//! @todo (js) implement real altering
 //! @todo (js) update any structure (e.g. query) that depend on this table!
-    bool ok = true;
-    bool empty;
-#if 0 //! @todo uncomment:
-    empty = isEmpty(tableSchema, ok) && ok;
-#else
-    empty = true;
-#endif
+    const tristate empty = isEmpty(tableSchema);
+    if (~empty) {
+        return cancelled;
+    }
     if (empty) {
-        ok = createTable(newTableSchema, KDbConnection::CreateTableOption::Default
-                             | KDbConnection::CreateTableOption::DropDestination);
+        return createTable(newTableSchema, KDbConnection::CreateTableOption::Default
+                                           | KDbConnection::CreateTableOption::DropDestination);
+    }
+    // Copy data to a temporary table with the new schema, then replace the table with it
+    const QString newName = newTableSchema->name();
+    newTableSchema->setName(KDb::temporaryTableName(this, newName));
+    if (!createTable(newTableSchema, KDbConnection::CreateTableOption::Default)) {
+        newTableSchema->setName(newName);
+        return false;
     }
-    return ok;
+    KDbTableRebuilder rebuilder(this, tableSchema, newTableSchema);
+    rebuilder.setSourceFieldsByName();
+    res = rebuilder.copyData();
+    if (res == true) {
+        if (alterTableName(newTableSchema, newName, AlterTableNameOption::Default
+                                                    | AlterTableNameOption::DropDestination))
+        {
+            return true;
+        }
+        res = false;
+    } else if (res == false) {
+        m_result = rebuilder.result();
+    }
+    // Remove the temporary table, the caller still owns newTableSchema
+    const KDbResult result = m_result;
+    if (true != dropTableInternal(newTableSchema, false)) {
+        kdbWarning() << "Could not drop temporary table" << newTableSchema->name();
+    }
+    d->takeTable(newTableSchema);
+    newTableSchema->setName(newName);
+    m_result = result;
+    return res;
 }
 
 bool KDbConnection::alterTableName(KDbTableSchema* tableSchema, const QString& newName,
@@ -1892,6 +2722,11 @@ bool KDbConnection::drv_createTable(const QString& tableName)
 
 bool KDbConnection::beginAutoCommitTransaction(KDbTransactionGuard* tg)
 {
+    // schema modifications are never part of a batch of writes
+    if (!d->flushWriteBatch()) {
+        tg->setTransaction(KDbTransaction());
+        return false;
+    }
     if ((d->driver->behavior()->features & KDbDriver::IgnoreTransactions)
             || !d->autoCommit) {
         tg->setTransaction(KDbTransaction());
@@ -1954,6 +2789,8 @@ KDbTransaction KDbConnection::beginTransaction()
 {
     if (!checkIsDatabaseUsed())
         return KDbTransaction();
+    if (!d->flushWriteBatch())
+        return KDbTransaction();
     KDbTransaction trans;
     if (d->driver->behavior()->features & KDbDriver::IgnoreTransactions) {
         //we're creating dummy transaction data here,
@@ -2101,12 +2938,46 @@ bool KDbConnection::setAutoCommit(bool on)
 {
     if (d->autoCommit == on || d->driver->behavior()->features & KDbDriver::IgnoreTransactions)
         return true;
+    if (!d->flushWriteBatch())
+        return false;
     if (!drv_setAutoCommit(on))
         return false;
     d->autoCommit = on;
     return true;
 }
 
+bool KDbConnection::setWriteBatchingEnabled(bool set, int maxWrites, int maxDelay)
+{
+    if (set && !d->driver->transactionsSupported()) {
+        m_result = KDbResult(ERR_UNSUPPORTED_DRV_FEATURE,
+                             tr("Transactions are not supported for \"%1\" driver.")
+                                .arg(d->driver->metaData()->name()));
+        return false;
+    }
+    if (!d->flushWriteBatch()) {
+        return false;
+    }
+    d->writeBatchingEnabled = set;
+    d->writeBatchMaxWrites = qMax(1, maxWrites);
+    d->writeBatchMaxDelay = maxDelay;
+    return true;
+}
+
+bool KDbConnection::isWriteBatchingEnabled() const
+{
+    return d->writeBatchingEnabled;
+}
+
+bool KDbConnection::flushWriteBatch()
+{
+    return d->flushWriteBatch();
+}
+
+KDbConnection::WriteBatchStatistics KDbConnection::writeBatchStatistics() const
+{
+    return d->writeBatchStatistics;
+}
+
 KDbTransactionData* KDbConnection::drv_beginTransaction()
 {
     if (!executeSql(KDbEscapedString("BEGIN")))
@@ -2133,7 +3004,7 @@ KDbCursor* KDbConnection::executeQuery(const KDbEscapedString& sql, KDbCursor::O
 {
     if (sql.isEmpty())
         return nullptr;
-    KDbCursor *c = prepareQuery(sql, options);
+    KDbCursor *c = prefetchingCursor(prepareQuery(sql, withoutPrefetch(options)), options);
     if (!c)
         return nullptr;
     if (!c->open()) {//err - kill that
@@ -2147,7 +3018,11 @@ KDbCursor* KDbConnection::executeQuery(const KDbEscapedString& sql, KDbCursor::O
 KDbCursor* KDbConnection::executeQuery(KDbQuerySchema* query, const QList<QVariant>& params,
                                        KDbCursor::Options options)
 {
-    KDbCursor *c = prepareQuery(query, params, options);
+    KDbCursor *c = d->resultCache.isEnabled() ? d->prepareCachedQuery(query, params, options)
+                                              : nullptr;
+    if (!c) {
+        c = prepareQuery(query, params, options);
+    }
     if (!c)
         return nullptr;
     if (!c->open()) {//err - kill that
@@ -2170,16 +3045,74 @@ KDbCursor* KDbConnection::executeQuery(KDbTableSchema* table, KDbCursor::Options
 
 KDbCursor* KDbConnection::prepareQuery(KDbTableSchema* table, KDbCursor::Options options)
 {
-    return prepareQuery(table->query(), options);
+    return prepareQuery(table->query(), QList<QVariant>(), options);
 }
 
 KDbCursor* KDbConnection::prepareQuery(KDbQuerySchema* query, const QList<QVariant>& params,
                                        KDbCursor::Options options)
 {
-    KDbCursor* cursor = prepareQuery(query, options);
+    KDbCursor* cursor = prepareQuery(query, withoutPrefetch(options));
     if (cursor)
         cursor->setQueryParameters(params);
-    return cursor;
+    return prefetchingCursor(cursor, options);
+}
+
+KDbAsyncQuery* KDbConnection::executeQueryAsync(const KDbEscapedString &sql)
+{
+    clearResult();
+    return d->executeAsync(KDbAsyncQueryJob::Type::Query, sql);
+}
+
+KDbAsyncQuery* KDbConnection::executeQueryAsync(KDbQuerySchema *query,
+                                                const QList<QVariant> &params)
+{
+    clearResult();
+    if (!query) {
+        return nullptr;
+    }
+    KDbNativeStatementBuilder builder(this, KDb::DriverEscaping);
+    KDbEscapedString sql;
+    if (!builder.generateSelectStatement(&sql, query, params)) {
+        m_result = KDbResult(ERR_SQL_EXECUTION_ERROR,
+                             tr("Could not generate SQL statement for the query."));
+        return nullptr;
+    }
+    return d->executeAsync(KDbAsyncQueryJob::Type::Query, sql);
+}
+
+KDbAsyncQuery* KDbConnection::executeSqlAsync(const KDbEscapedString &sql)
+{
+    clearResult();
+    return d->executeAsync(KDbAsyncQueryJob::Type::Sql, sql);
+}
+
+tristate KDbConnection::exportData(KDbQuerySchema *query, QIODevice *device,
+                                   const KDbExportOptions &options,
+                                   KDbExportProgressHandler *handler)
+{
+    clearResult();
+    if (!query) {
+        return false;
+    }
+    return kdbExportData(this, query, device, options, handler, &m_result);
+}
+
+tristate KDbConnection::exportData(KDbTableSchema *table, QIODevice *device,
+                                   const KDbExportOptions &options,
+                                   KDbExportProgressHandler *handler)
+{
+    return exportData(table ? table->query() : nullptr, device, options, handler);
+}
+
+tristate KDbConnection::importData(QIODevice *device, KDbTableSchema *table,
+                                   const KDbImportOptions &options,
+                                   KDbImportProgressHandler *handler)
+{
+    clearResult();
+    if (!checkIsDatabaseUsed()) {
+        return false;
+    }
+    return kdbImportData(this, device, table, options, handler, &m_result);
 }
 
 bool KDbConnection::deleteCursor(KDbCursor *cursor)
@@ -2586,12 +3519,21 @@ tristate KDbConnection::resultExists(const KDbEscapedString &sql, QueryRecordOpt
 
 tristate KDbConnection::isEmpty(KDbTableSchema* table)
 {
+    return table ? isEmpty(table->query()) : cancelled;
+}
+
+tristate KDbConnection::isEmpty(KDbQuerySchema* query, const QList<QVariant>& params)
+{
+    if (!query) {
+        return cancelled;
+    }
     const KDbNativeStatementBuilder builder(this, KDb::DriverEscaping);
     KDbEscapedString sql;
-    if (!builder.generateSelectStatement(&sql, table)) {
+    if (!builder.generateExistsStatement(&sql, query, params)) {
         return cancelled;
     }
-    const tristate result = resultExists(sql);
+    // the statement is already limited to one record
+    const tristate result = resultExists(sql, QueryRecordOptions());
     if (~result) {
         return cancelled;
     }
@@ -3077,16 +4019,13 @@ void KDbConnection::setAvailableDatabaseName(const QString& dbName)
 
 //! @internal used in updateRecord(), insertRecord(),
 inline static void updateRecordDataWithNewValues(
-        KDbConnection *conn, KDbQuerySchema* query, KDbRecordData* data,
-        const KDbRecordEditBuffer::DbHash& b,
-        QHash<KDbQueryColumnInfo*, int>* columnsOrderExpanded)
+        KDbRecordData* data, const KDbRecordEditBuffer::DbHash& b,
+        const QHash<KDbQueryColumnInfo*, int>& columnsOrderExpanded)
 {
-    *columnsOrderExpanded
-        = query->columnsOrder(conn, KDbQuerySchema::ColumnsOrderMode::ExpandedList);
     QHash<KDbQueryColumnInfo*, int>::ConstIterator columnsOrderExpandedIt;
     for (KDbRecordEditBuffer::DbHash::ConstIterator it = b.constBegin();it != b.constEnd();++it) {
-        columnsOrderExpandedIt = columnsOrderExpanded->constFind(it.key());
-        if (columnsOrderExpandedIt == columnsOrderExpanded->constEnd()) {
+        columnsOrderExpandedIt = columnsOrderExpanded.constFind(it.key());
+        if (columnsOrderExpandedIt == columnsOrderExpanded.constEnd()) {
             kdbWarning() << "(KDbConnection) \"now also assign new value in memory\" step"
                        "- could not find item" << it.key()->aliasOrName();
             continue;
@@ -3095,6 +4034,18 @@ inline static void updateRecordDataWithNewValues(
     }
 }
 
+//! @internal @return columns of @a b sorted by address, used as a key of data modification plans
+static QVector<KDbQueryColumnInfo*> editedColumns(const KDbRecordEditBuffer::DbHash& b)
+{
+    QVector<KDbQueryColumnInfo*> columns;
+    columns.reserve(b.count());
+    for (KDbRecordEditBuffer::DbHash::ConstIterator it = b.constBegin();it != b.constEnd();++it) {
+        columns.append(it.key());
+    }
+    std::sort(columns.begin(), columns.end());
+    return columns;
+}
+
 bool KDbConnection::updateRecord(KDbQuerySchema* query, KDbRecordData* data, KDbRecordEditBuffer* buf, bool useRecordId)
 {
 // Each SQL identifier needs to be escaped in the generated query.
@@ -3106,94 +4057,45 @@ bool KDbConnection::updateRecord(KDbQuerySchema* query, KDbRecordData* data, KDb
         kdbDebug() << " -- NO CHANGES DATA!";
         return true;
     }
-    KDbTableSchema *mt = query->masterTable();
-    if (!mt) {
-        kdbWarning() << " -- NO MASTER TABLE!";
-        m_result = KDbResult(ERR_UPDATE_NO_MASTER_TABLE,
-                             tr("Could not update record because there is no master table defined."));
+    const KDbRecordEditBuffer::DbHash b = buf->dbBuffer();
+    KDbDmlPlan *plan = d->dmlPlan(KDbDmlPlan::Type::Update, query, useRecordId,
+                                        editedColumns(b));
+    if (!plan) {
         return false;
     }
-    KDbIndexSchema *pkey = (mt->primaryKey() && !mt->primaryKey()->fields()->isEmpty()) ? mt->primaryKey() : nullptr;
-    if (!useRecordId && !pkey) {
-        kdbWarning() << " -- NO MASTER TABLE's PKEY!";
-        m_result = KDbResult(ERR_UPDATE_NO_MASTER_TABLES_PKEY,
-            tr("Could not update record because master table has no primary key defined."));
-//! @todo perhaps we can try to update without using PKEY?
+    //update the record:
+    QVector<QVariant> values;
+    if (!d->dmlPlanValues(*plan, b, *data, &values)) {
         return false;
     }
-    //update the record:
-    KDbEscapedString sql;
-    sql.reserve(4096);
-    sql = KDbEscapedString("UPDATE ") + escapeIdentifier(mt->name()) + " SET ";
-    KDbEscapedString sqlset, sqlwhere;
-    sqlset.reserve(1024);
-    sqlwhere.reserve(1024);
-    KDbRecordEditBuffer::DbHash b = buf->dbBuffer();
+    plan->render(&d->statementBuffer, values);
+    const KDbEscapedString statement(d->statementBuffer.statement());
+    KDbTableSchema *mt = plan->masterTable;
+    KDbFieldList *affectedFields = &plan->affectedFields;
 
-    //gather the fields which are updated ( have values in KDbRecordEditBuffer)
-    KDbFieldList affectedFields;
-    for (KDbRecordEditBuffer::DbHash::ConstIterator it = b.constBegin();it != b.constEnd();++it) {
-        if (it.key()->field()->table() != mt)
-            continue; // skip values for fields outside of the master table (e.g. a "visible value" of the lookup field)
-        if (!sqlset.isEmpty())
-            sqlset += ',';
-        KDbField* currentField = it.key()->field();
-        const bool affectedFieldsAddOk = affectedFields.addField(currentField);
-        Q_ASSERT(affectedFieldsAddOk);
-        sqlset += KDbEscapedString(escapeIdentifier(currentField->name())) + '=' +
-                  d->driver->valueToSql(currentField, it.value());
-    }
-    if (pkey) {
-        //kdbDebug() << pkey->fieldCount() << " ? " << query->pkeyFieldCount();
-        if (pkey->fieldCount() != query->pkeyFieldCount(this)) { //sanity check
-            kdbWarning() << " -- NO ENTIRE MASTER TABLE's PKEY SPECIFIED!";
-            m_result = KDbResult(ERR_UPDATE_NO_ENTIRE_MASTER_TABLES_PKEY,
-                                 tr("Could not update record because it does not contain entire primary key of master table."));
-            return false;
-        }
-        if (!pkey->fields()->isEmpty()) {
-            int i = 0;
-            const QVector<int> pkeyFieldsOrder(query->pkeyFieldsOrder(this));
-            for (KDbField *f : qAsConst(*pkey->fields())) {
-                if (!sqlwhere.isEmpty())
-                    sqlwhere += " AND ";
-                const QVariant val(data->at(pkeyFieldsOrder.at(i)));
-                if (val.isNull() || !val.isValid()) {
-                    m_result = KDbResult(ERR_UPDATE_NULL_PKEY_FIELD,
-                                         tr("Primary key's field \"%1\" cannot be empty.").arg(f->name()));
-                    //js todo: pass the field's name somewhere!
-                    return false;
-                }
-                sqlwhere += KDbEscapedString(escapeIdentifier(f->name())) + '=' +
-                            d->driver->valueToSql(f, val);
-                i++;
-            }
-        }
-    } else { //use RecordId
-        sqlwhere = KDbEscapedString(escapeIdentifier(d->driver->behavior()->ROW_ID_FIELD_NAME)) + '='
-                   + d->driver->valueToSql(KDbField::BigInteger, (*data)[data->size() - 1]);
-    }
-    sql += (sqlset + " WHERE " + sqlwhere);
-    //kdbDebug() << " -- SQL == " << ((sql.length() > 400) ? (sql.left(400) + "[.....]") : sql);
+    BatchedWrite write(d);
+    if (!write.isStarted())
+        return false;
 
     // preprocessing before update
-    if (!drv_beforeUpdate(mt->name(), &affectedFields))
+    if (!drv_beforeUpdate(mt->name(), affectedFields))
         return false;
 
-    bool res = executeSql(sql);
+    bool res = executeSql(statement);
 
     // postprocessing after update
-    if (!drv_afterUpdate(mt->name(), &affectedFields))
+    if (!drv_afterUpdate(mt->name(), affectedFields))
         return false;
 
+    res = write.finish(res);
+
     if (!res) {
         m_result = KDbResult(ERR_UPDATE_SERVER_ERROR,
                              tr("Record updating on the server failed."));
         return false;
     }
     //success: now also assign new values in memory:
-    QHash<KDbQueryColumnInfo*, int> columnsOrderExpanded;
-    updateRecordDataWithNewValues(this, query, data, b, &columnsOrderExpanded);
+    updateRecordDataWithNewValues(data, b, plan->columnsOrderExpanded);
     return true;
 }
 
@@ -3206,116 +4108,40 @@ bool KDbConnection::insertRecord(KDbQuerySchema* query, KDbRecordData* data, KDb
     if (buf.dbBuffer().isEmpty()) {
       kdbDebug() << " -- NO CHANGES DATA!";
       return true; }*/
-    KDbTableSchema *mt = query->masterTable();
-    if (!mt) {
-        kdbWarning() << " -- NO MASTER TABLE!";
-        m_result = KDbResult(ERR_INSERT_NO_MASTER_TABLE,
-                             tr("Could not insert record because there is no master table specified."));
+    KDbRecordEditBuffer::DbHash b = buf->dbBuffer();
+    KDbDmlPlan *plan = d->dmlPlan(KDbDmlPlan::Type::Insert, query, getRecordId,
+                                        editedColumns(b));
+    if (!plan) {
         return false;
     }
-    KDbIndexSchema *pkey
-        = (mt->primaryKey() && !mt->primaryKey()->fields()->isEmpty()) ? mt->primaryKey() : nullptr;
-    if (!getRecordId && !pkey) {
-        kdbWarning() << " -- WARNING: NO MASTER TABLE's PKEY";
+    // add default values (for any column without value explicitly set)
+    for (KDbQueryColumnInfo *ci : plan->defaultColumns) {
+        b.insert(ci, ci->field()->defaultValue());
     }
-
-    KDbEscapedString sqlcols, sqlvals;
-    sqlcols.reserve(1024);
-    sqlvals.reserve(1024);
-
     //insert the record:
-    KDbEscapedString sql;
-    sql.reserve(4096);
-    sql = KDbEscapedString("INSERT INTO ") + escapeIdentifier(mt->name()) + " (";
-    KDbRecordEditBuffer::DbHash b = buf->dbBuffer();
-
-    // add default values, if available (for any column without value explicitly set)
-    const KDbQueryColumnInfo::Vector fieldsExpanded(
-        query->fieldsExpanded(this, KDbQuerySchema::FieldsExpandedMode::Unique));
-    int fieldsExpandedCount = fieldsExpanded.count();
-    for (int i = 0; i < fieldsExpandedCount; i++) {
-        KDbQueryColumnInfo *ci = fieldsExpanded.at(i);
-        if (ci->field() && KDb::isDefaultValueAllowed(*ci->field())
-                && !ci->field()->defaultValue().isNull()
-                && !b.contains(ci))
-        {
-            //kdbDebug() << "adding default value" << ci->field->defaultValue().toString() << "for column" << ci->field->name();
-            b.insert(ci, ci->field()->defaultValue());
-        }
-    }
-
-    //collect fields which have values in KDbRecordEditBuffer
-    KDbFieldList affectedFields;
-
-    if (b.isEmpty()) {
-        // empty record inserting requested:
-        if (!getRecordId && !pkey) {
-            kdbWarning() << "MASTER TABLE's PKEY REQUIRED FOR INSERTING EMPTY RECORDS: INSERT CANCELLED";
-            m_result = KDbResult(ERR_INSERT_NO_MASTER_TABLES_PKEY,
-                                 tr("Could not insert record because master table has no primary key specified."));
-            return false;
-        }
-        if (pkey) {
-            const QVector<int> pkeyFieldsOrder(query->pkeyFieldsOrder(this));
-            //   kdbDebug() << pkey->fieldCount() << " ? " << query->pkeyFieldCount();
-            if (pkey->fieldCount() != query->pkeyFieldCount(this)) { // sanity check
-                kdbWarning() << "NO ENTIRE MASTER TABLE's PKEY SPECIFIED!";
-                m_result = KDbResult(ERR_INSERT_NO_ENTIRE_MASTER_TABLES_PKEY,
-                                     tr("Could not insert record because it does not contain "
-                                        "entire master table's primary key."));
-                return false;
-            }
-        }
-        //at least one value is needed for VALUES section: find it and set to NULL:
-        KDbField *anyField = mt->anyNonPKField();
-        if (!anyField) {
-            if (!pkey) {
-                kdbWarning() << "WARNING: NO FIELD AVAILABLE TO SET IT TO NULL";
-                return false;
-            } else {
-                //try to set NULL in pkey field (could not work for every SQL engine!)
-                anyField = pkey->fields()->first();
-            }
-        }
-        sqlcols += escapeIdentifier(anyField->name());
-        sqlvals += d->driver->valueToSql(anyField, QVariant()/*NULL*/);
-        const bool affectedFieldsAddOk = affectedFields.addField(anyField);
-        Q_ASSERT(affectedFieldsAddOk);
-    } else {
-        // non-empty record inserting requested:
-        for (KDbRecordEditBuffer::DbHash::ConstIterator it = b.constBegin();it != b.constEnd();++it) {
-            if (it.key()->field()->table() != mt)
-                continue; // skip values for fields outside of the master table (e.g. a "visible value" of the lookup field)
-            if (!sqlcols.isEmpty()) {
-                sqlcols += ',';
-                sqlvals += ',';
-            }
-            KDbField* currentField = it.key()->field();
-            const bool affectedFieldsAddOk = affectedFields.addField(currentField);
-            Q_ASSERT(affectedFieldsAddOk);
-            sqlcols += escapeIdentifier(currentField->name());
-            sqlvals += d->driver->valueToSql(currentField, it.value());
-        }
+    QVector<QVariant> values;
+    if (!d->dmlPlanValues(*plan, b, *data, &values)) {
+        return false;
     }
-    sql += (sqlcols + ") VALUES (" + sqlvals + ')');
-// kdbDebug() << " -- SQL == " << sql;
+    KDbStatementBuffer &sql(d->statementBuffer);
+    plan->render(&sql, values);
 
     // low-level insert
-    QSharedPointer<KDbSqlResult> result = insertRecordInternal(mt->name(), &affectedFields, sql);
+    QSharedPointer<KDbSqlResult> result = insertRecordInternal(plan->masterTable->name(),
+                                                               &plan->affectedFields,
+                                                               sql.statement());
     if (!result) {
         m_result = KDbResult(ERR_INSERT_SERVER_ERROR,
                              tr("Record inserting on the server failed."));
         return false;
     }
     //success: now also assign a new value in memory:
-    QHash<KDbQueryColumnInfo*, int> columnsOrderExpanded;
-    updateRecordDataWithNewValues(this, query, data, b, &columnsOrderExpanded);
+    updateRecordDataWithNewValues(data, b, plan->columnsOrderExpanded);
 
     //fetch autoincremented values
-    KDbQueryColumnInfo::List *aif_list = query->autoIncrementFields(this);
     quint64 recordId = 0;
-    if (pkey && !aif_list->isEmpty()) {
-        //! @todo now only if PKEY is present, this should also work when there's no PKEY
+    if (!plan->autoIncrementSql.isEmpty()) {
+        KDbQueryColumnInfo::List *aif_list = query->autoIncrementFields(this);
         KDbQueryColumnInfo *id_columnInfo = aif_list->first();
         //! @todo safe to cast it?
         quint64 last_id
@@ -3327,21 +4153,16 @@ bool KDbConnection::insertRecord(KDbQuerySchema* query, KDbRecordData* data, KDb
             return false;
         }
         KDbRecordData aif_data;
-        KDbEscapedString getAutoIncForInsertedValue("SELECT "
-                                             + query->autoIncrementSqlFieldsList(this)
-                                             + " FROM "
-                                             + escapeIdentifier(id_columnInfo->field()->table()->name())
-                                             + " WHERE "
-                                             + escapeIdentifier(id_columnInfo->field()->name()) + '='
-                                             + QByteArray::number(last_id));
-        if (true != querySingleRecord(getAutoIncForInsertedValue, &aif_data)) {
+        sql.clear();
+        sql.append(plan->autoIncrementSql).append(QByteArray::number(last_id));
+        if (true != querySingleRecord(sql.statement(), &aif_data)) {
             //! @todo show error
             return false;
         }
         int i = 0;
         foreach(KDbQueryColumnInfo *ci, *aif_list) {
 //   kdbDebug() << "AUTOINCREMENTED FIELD" << fi->field->name() << "==" << aif_data[i].toInt();
-            ((*data)[ columnsOrderExpanded.value(ci)]
+            ((*data)[ plan->columnsOrderExpanded.value(ci)]
                 = aif_data.value(i)).convert(ci->field()->variantType()); //cast to get proper type
             i++;
         }
@@ -3353,7 +4174,7 @@ bool KDbConnection::insertRecord(KDbQuerySchema* query, KDbRecordData* data, KDb
             return false;
         }
     }
-    if (getRecordId && /*sanity check*/data->size() > fieldsExpanded.size()) {
+    if (getRecordId && /*sanity check*/data->size() > plan->fieldsExpandedCount) {
 //  kdbDebug() << "new ROWID ==" << ROWID;
         (*data)[data->size() - 1] = recordId;
     }
@@ -3364,62 +4185,20 @@ bool KDbConnection::deleteRecord(KDbQuerySchema* query, KDbRecordData* data, boo
 {
 // Each SQL identifier needs to be escaped in the generated query.
     clearResult();
-    KDbTableSchema *mt = query->masterTable();
-    if (!mt) {
-        kdbWarning() << " -- NO MASTER TABLE!";
-        m_result = KDbResult(ERR_DELETE_NO_MASTER_TABLE,
-                             tr("Could not delete record because there is no master table specified."));
+    const KDbDmlPlan *plan = d->dmlPlan(KDbDmlPlan::Type::Delete, query, useRecordId,
+                                        QVector<KDbQueryColumnInfo*>());
+    if (!plan) {
         return false;
     }
-    KDbIndexSchema *pkey = (mt->primaryKey() && !mt->primaryKey()->fields()->isEmpty()) ? mt->primaryKey() : nullptr;
-
-//! @todo allow to delete from a table without pkey
-    if (!useRecordId && !pkey) {
-        kdbWarning() << " -- WARNING: NO MASTER TABLE's PKEY";
-        m_result = KDbResult(ERR_DELETE_NO_MASTER_TABLES_PKEY,
-                             tr("Could not delete record because there is no primary key for master table specified."));
+    QVector<QVariant> values;
+    if (!d->dmlPlanValues(*plan, KDbRecordEditBuffer::DbHash(), *data, &values)) {
         return false;
     }
+    plan->render(&d->statementBuffer, values);
+    const KDbEscapedString statement(d->statementBuffer.statement());
 
-    //update the record:
-    KDbEscapedString sql;
-    sql.reserve(4096);
-    sql = KDbEscapedString("DELETE FROM ") + escapeIdentifier(mt->name()) + " WHERE ";
-    KDbEscapedString sqlwhere;
-    sqlwhere.reserve(1024);
-
-    if (pkey) {
-        const QVector<int> pkeyFieldsOrder(query->pkeyFieldsOrder(this));
-        //kdbDebug() << pkey->fieldCount() << " ? " << query->pkeyFieldCount();
-        if (pkey->fieldCount() != query->pkeyFieldCount(this)) { //sanity check
-            kdbWarning() << " -- NO ENTIRE MASTER TABLE's PKEY SPECIFIED!";
-            m_result = KDbResult(ERR_DELETE_NO_ENTIRE_MASTER_TABLES_PKEY,
-                                 tr("Could not delete record because it does not contain entire master table's primary key."));
-            return false;
-        }
-        int i = 0;
-        foreach(KDbField *f, *pkey->fields()) {
-            if (!sqlwhere.isEmpty())
-                sqlwhere += " AND ";
-            QVariant val(data->at(pkeyFieldsOrder.at(i)));
-            if (val.isNull() || !val.isValid()) {
-                m_result = KDbResult(ERR_DELETE_NULL_PKEY_FIELD,
-                                     tr("Primary key's field \"%1\" cannot be empty.").arg(f->name()));
-//js todo: pass the field's name somewhere!
-                return false;
-            }
-            sqlwhere += KDbEscapedString(escapeIdentifier(f->name())) + '=' +
-                         d->driver->valueToSql(f, val);
-            i++;
-        }
-    } else {//use RecordId
-        sqlwhere = KDbEscapedString(escapeIdentifier(d->driver->behavior()->ROW_ID_FIELD_NAME)) + '='
-                    + d->driver->valueToSql(KDbField::BigInteger, (*data)[data->size() - 1]);
-    }
-    sql += sqlwhere;
-    //kdbDebug() << " -- SQL == " << sql;
-
-    if (!executeSql(sql)) {
+    BatchedWrite write(d);
+    if (!write.isStarted() || !write.finish(executeSql(statement))) {
         m_result = KDbResult(ERR_DELETE_SERVER_ERROR,
                              tr("Record deletion on the server failed."));
         return false;
@@ -3439,10 +4218,13 @@ bool KDbConnection::deleteAllRecords(KDbQuerySchema* query)
     if (!pkey || pkey->fields()->isEmpty()) {
         kdbWarning() << "-- WARNING: NO MASTER TABLE's PKEY";
     }
-    KDbEscapedString sql = KDbEscapedString("DELETE FROM ") + escapeIdentifier(mt->name());
-    //kdbDebug() << "-- SQL == " << sql;
+    KDbStatementBuffer &sql(d->statementBuffer);
+    sql.clear();
+    sql.append("DELETE FROM ").appendIdentifier(mt->name());
+    const KDbEscapedString statement(sql.statement());
 
-    if (!executeSql(sql)) {
+    BatchedWrite write(d);
+    if (!write.isStarted() || !write.finish(executeSql(statement))) {
         m_result = KDbResult(ERR_DELETE_SERVER_ERROR,
                              tr("Record deletion on the server failed."));
         return false;
@@ -3454,7 +4236,7 @@ int KDbConnection::recordCount(const KDbEscapedString& sql)
 {
     int count = -1; //will be changed only on success of querySingleNumber()
     const tristate result = querySingleNumber(
-        KDbEscapedString("SELECT COUNT() FROM (") + sql + ") AS kdb__subquery", &count);
+        KDbEscapedString("SELECT COUNT(*) FROM (") + sql + ") AS kdb__subquery", &count);
     if (~result) {
         count = 0;
     }
@@ -3478,12 +4260,11 @@ int KDbConnection::recordCount(KDbQuerySchema* querySchema, const QList<QVariant
 //! @todo does not work with non-SQL data sources
     int count = -1; //will be changed only on success of querySingleNumber()
     KDbNativeStatementBuilder builder(this, KDb::DriverEscaping);
-    KDbEscapedString subSql;
-    if (!builder.generateSelectStatement(&subSql, querySchema, params)) {
+    KDbEscapedString sql;
+    if (!builder.generateCountStatement(&sql, querySchema, params)) {
         return -1;
     }
-    const tristate result = querySingleNumber(
-        KDbEscapedString("SELECT COUNT(*) FROM (") + subSql + ") AS kdb__subquery", &count);
+    const tristate result = querySingleNumber(sql, &count);
     if (~result) {
         count = 0;
     }
@@ -3501,6 +4282,19 @@ int KDbConnection::recordCount(KDbTableOrQuerySchema* tableOrQuery, const QList<
     return -1;
 }
 
+int KDbConnection::approximateRecordCount(const KDbTableSchema& tableSchema)
+{
+    int count = -1;
+    const tristate result = drv_approximateRecordCount(tableSchema, &count);
+    if (result == true) {
+        return count;
+    }
+    if (result == false) {
+        return -1;
+    }
+    return recordCount(tableSchema); // no statistics available
+}
+
 KDbConnectionOptions* KDbConnection::options()
 {
     return &d->options;
@@ -3525,7 +4319,80 @@ KDbPreparedStatement KDbConnection::prepareStatement(KDbPreparedStatement::Type
     KDbPreparedStatementInterface *iface = prepareStatementInternal();
     if (!iface)
         return KDbPreparedStatement();
-    return KDbPreparedStatement(iface, type, fields, whereFieldNames);
+    KDbPreparedStatement statement(iface, type, fields, whereFieldNames);
+    statement.d->connection = this;
+    return statement;
+}
+
+KDbTracer* KDbConnection::tracer() const
+{
+    return d->tracer;
+}
+
+void KDbConnection::setTracer(KDbTracer *tracer)
+{
+    d->tracer = tracer;
+}
+
+int KDbConnection::lookupValueCacheLimit() const
+{
+    return d->lookupValues.maxRecords;
+}
+
+void KDbConnection::setLookupValueCacheLimit(int maxRecords)
+{
+    d->lookupValues.maxRecords = qMax(0, maxRecords);
+    d->lookupValues.clear();
+}
+
+tristate KDbConnection::lookupVisibleValue(const KDbLookupFieldSchema &lookup,
+                                           const QVariant &boundValue, QVariant *visibleValue)
+{
+    Q_ASSERT(visibleValue);
+    const QSharedPointer<const KDbLookupValueCache::Values> values(d->lookupValues.values(lookup));
+    if (!values) {
+        return cancelled;
+    }
+    const auto it = boundValue.isNull() ? values->constEnd()
+                                        : values->constFind(KDbLookupValueCache::key(boundValue));
+    if (it == values->constEnd()) {
+        *visibleValue = QVariant();
+        return false;
+    }
+    *visibleValue = it.value();
+    return true;
+}
+
+void KDbConnection::clearLookupValueCache()
+{
+    d->lookupValues.tableChanged(QString());
+}
+
+void KDbConnection::addLookupValuesListener(KDbLookupValuesListener *listener)
+{
+    if (listener && !d->lookupValues.listeners.contains(listener)) {
+        d->lookupValues.listeners.append(listener);
+    }
+}
+
+void KDbConnection::removeLookupValuesListener(KDbLookupValuesListener *listener)
+{
+    d->lookupValues.listeners.removeOne(listener);
+}
+
+int KDbConnection::resultCacheSize() const
+{
+    return d->resultCache.maxSize();
+}
+
+void KDbConnection::setResultCacheSize(int size)
+{
+    d->resultCache.setMaxSize(size);
+}
+
+void KDbConnection::clearResultCache()
+{
+    d->resultCache.clear();
 }
 
 KDbEscapedString KDbConnection::recentSqlString() const {
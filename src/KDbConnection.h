@@ -22,25 +22,36 @@
 
 #include "KDbCursor.h"
 #include "KDbDriver.h"
+#include "KDbExportOptions.h"
+#include "KDbImportOptions.h"
 #include "KDbPreparedStatement.h"
 #include "KDbTableSchema.h"
 #include "KDbTransaction.h"
 #include "KDbTristate.h"
 
+class KDbAsyncQuery;
 class KDbConnectionData;
 class KDbConnectionOptions;
 class KDbConnectionPrivate;
 class KDbConnectionProxy;
 class KDbDriver;
+class KDbExportProgressHandler;
+class KDbImportBatch;
+class KDbImportProgressHandler;
+class KDbLookupFieldSchema;
+class KDbLookupValuesListener;
 class KDbProperties;
+class KDbReadSnapshotData;
 class KDbRecordData;
 class KDbRecordEditBuffer;
 class KDbServerVersionInfo;
 class KDbSqlResult;
 class KDbTableSchemaChangeListener;
 class KDbTableSchemaChangeListenerPrivate;
+class KDbTracer;
 class KDbTransactionGuard;
 class KDbVersionInfo;
+class QIODevice;
 
 /*! @short Provides database connection, allowing queries and data modification.
 
@@ -363,6 +374,143 @@ public:
      @see autoCommit() */
     bool setAutoCommit(bool on);
 
+    //! Statistics of batches of writes, see setWriteBatchingEnabled()
+    //! @since 3.3
+    struct WriteBatchStatistics {
+        int batches = 0;      //!< number of committed batches
+        qint64 writes = 0;    //!< number of writes in the committed batches
+        int largestBatch = 0; //!< number of writes in the largest committed batch
+        //! @return average number of writes per batch
+        inline double averageBatchSize() const {
+            return batches == 0 ? 0.0 : double(writes) / batches;
+        }
+    };
+
+    /*! Enables or disables batching of autocommitted writes.
+
+     When auto commit is on, every data modification performed with insertRecord(),
+     updateRecord(), deleteRecord() or deleteAllRecords() is committed separately.
+     For backends like SQLite every commit means synchronization with the disk so many
+     small writes are slow. If batching is enabled, these writes are grouped within a single
+     transaction that is committed after @a maxWrites writes, after the first write of the batch
+     is older than @a maxDelay milliseconds, on flushWriteBatch() or when the database is closed.
+     The time limit is also checked by a timer so it requires running event loop in the
+     connection's thread; otherwise the batch is committed on the next write.
+     If @a maxDelay is 0 or negative, there is no time limit.
+
+     Writes collected in a batch are not durable until the batch is committed. Batching is
+     not used while there are transactions started by the user, e.g. using KDbTransactionGuard,
+     and any pending batch is committed before such transaction or schema modification begins,
+     so durability of explicit transactions is not affected.
+     A failed write does not affect other writes of the batch.
+
+     Disabling batching commits the pending batch.
+     @return false and sets ERR_UNSUPPORTED_DRV_FEATURE if the driver does not support
+     transactions or if committing the pending batch failed.
+     @since 3.3 */
+    bool setWriteBatchingEnabled(bool set, int maxWrites = 1000, int maxDelay = 5);
+
+    //! @return true if batching of autocommitted writes is enabled
+    //! @see setWriteBatchingEnabled()
+    //! @since 3.3
+    bool isWriteBatchingEnabled() const;
+
+    /*! Commits the pending batch of writes, if any. @return true on success.
+     @see setWriteBatchingEnabled()
+     @since 3.3 */
+    bool flushWriteBatch();
+
+    //! @return statistics of batches of writes committed by this connection
+    //! @since 3.3
+    WriteBatchStatistics writeBatchStatistics() const;
+
+    //! @return tracer of this connection, @c nullptr by default
+    //! @see setTracer()
+    //! @since 3.3
+    KDbTracer* tracer() const;
+
+    /*! Sets tracer for this connection. The tracer receives information about executed
+     statements, opened cursors and executed prepared statements, see KDbTracer for details.
+     Ownership of @a tracer is not transferred; it has to exist as long as it is set.
+     @c nullptr disables tracing. Tracing is disabled by default.
+     @since 3.3 */
+    void setTracer(KDbTracer *tracer);
+
+    //! @return maximum number of records of lookup record sources cached by this connection,
+    //! 0 by default
+    //! @see setLookupValueCacheLimit()
+    //! @since 3.3
+    int lookupValueCacheLimit() const;
+
+    /*! Sets maximum number of records of lookup record sources cached by this connection.
+
+     Tables and named queries used as record sources of lookup fields (see KDbLookupFieldSchema)
+     that have at most @a maxRecords records are loaded once and their visible values are cached.
+     Cursors opened for queries containing lookup columns then obtain visible values from the
+     cache instead of joining the record sources in every statement. Larger record sources
+     are still joined. Cached values are discarded when a statement modifying a table they depend
+     on is executed using this connection, and KDbLookupValuesListener objects are notified.
+     Changes performed by other connections or processes are not detected.
+
+     For cursors using the cache, KDbCursor::value() returns null for columns of visible lookup
+     values; visible values are set in records retrieved using KDbCursor::storeCurrentRecord().
+
+     Setting @a maxRecords to 0 disables the cache, what is the default. Cached values
+     are discarded on every call.
+     @since 3.3 */
+    void setLookupValueCacheLimit(int maxRecords);
+
+    /*! Finds visible value of lookup field @a lookup for bound value @a boundValue using
+     the lookup value cache. The record source is loaded if needed.
+     @return true and sets @a visibleValue if the value has been found, false if there is no
+     record for @a boundValue and cancelled if the cache is disabled or the record source
+     cannot be cached, e.g. because it has more than lookupValueCacheLimit() records.
+     @since 3.3 */
+    tristate lookupVisibleValue(const KDbLookupFieldSchema &lookup, const QVariant &boundValue,
+                                QVariant *visibleValue);
+
+    /*! Discards all cached visible values of lookup record sources and notifies listeners.
+     @since 3.3 */
+    void clearLookupValueCache();
+
+    /*! Registers @a listener for notifications about discarded cached lookup values.
+     Ownership of @a listener is not transferred; it has to be removed before it is deleted.
+     @see setLookupValueCacheLimit()
+     @since 3.3 */
+    void addLookupValuesListener(KDbLookupValuesListener *listener);
+
+    //! Unregisters @a listener added with addLookupValuesListener()
+    //! @since 3.3
+    void removeLookupValuesListener(KDbLookupValuesListener *listener);
+
+    //! @return maximum size in bytes of query results cached by this connection, 0 by default
+    //! @see setResultCacheSize()
+    //! @since 3.3
+    int resultCacheSize() const;
+
+    /*! Sets maximum size in bytes of query results cached by this connection.
+
+     When the cache is enabled, records fetched by cursors of queries defined by KDbQuerySchema
+     until the end of results are stored by columns, identified by the generated statement and
+     query parameters. Subsequent executeQuery() calls for the same statement and parameters
+     return cursors that read the stored records instead of executing the statement.
+     Results are discarded when a statement modifying any table they read is executed using
+     this connection. Changes performed by other connections or processes are not detected.
+     Only the table named in the statement is considered modified, so changes performed
+     by triggers or by cascading foreign key actions on other tables are not detected either;
+     call clearResultCache() after such statements.
+     The least recently used results are removed when the size is exceeded; results larger
+     than @a size are not stored.
+
+     Setting @a size to 0 disables the cache, what is the default. Cached results
+     are discarded in this case.
+     @since 3.3 */
+    void setResultCacheSize(int size);
+
+    //! Discards all query results cached by this connection
+    //! @since 3.3
+    void clearResultCache();
+
     /*! Connection-specific string escaping. Default implementation uses driver's escaping.
      Use KDbEscapedString::isValid() to check if escaping has been performed successfully.
      Invalid strings are set to null in addition, that is KDbEscapedString::isNull() is true,
@@ -440,6 +588,71 @@ public:
     Q_REQUIRED_RESULT KDbCursor *executeQuery(KDbTableSchema *table,
                                               KDbCursor::Options options = KDbCursor::Option::None);
 
+    /*! Executes SELECT query described by a raw SQL statement @a sql asynchronously.
+     The statement is executed in a separate thread using a separate connection to the
+     currently used database, created with the same driver, connection data and options.
+     Queries are executed in order of calling this method or executeSqlAsync().
+     All the resulting records are retrieved, they are available using the returned handle
+     after the KDbAsyncQuery::finished() signal is emitted.
+     Because a separate connection is used, uncommitted changes made within transactions
+     of this connection are not visible to the query.
+     @return handle of the query owned by the caller, or @c nullptr if there is no database
+     used or the connection for asynchronous queries could not be created.
+     @since 3.3 */
+    Q_REQUIRED_RESULT KDbAsyncQuery *executeQueryAsync(const KDbEscapedString &sql);
+
+    /*! @overload executeQueryAsync(const KDbEscapedString &sql)
+     Statement is build from data provided by @a query schema and values of parameters
+     @a params. Resulting records contain values for columns returned by
+     KDbQuerySchema::fieldsExpanded(this, KDbQuerySchema::FieldsExpandedMode::WithInternalFields).
+     @since 3.3 */
+    Q_REQUIRED_RESULT KDbAsyncQuery *executeQueryAsync(KDbQuerySchema *query,
+                                                       const QList<QVariant> &params = QList<QVariant>());
+
+    /*! Executes raw SQL statement @a sql asynchronously, like executeSql() does.
+     No records are retrieved. See executeQueryAsync() for details.
+     @since 3.3 */
+    Q_REQUIRED_RESULT KDbAsyncQuery *executeSqlAsync(const KDbEscapedString &sql);
+
+    /*! Exports records of @a query to @a device in format specified by @a options.
+     Records are fetched by the calling thread in batches of KDbExportOptions::batchSize()
+     records and converted by a separate thread. Fetching waits if
+     KDbExportOptions::maxPendingBatches() batches are waiting for conversion, so memory
+     used does not depend on number of records. Converted data is written to @a device by
+     the calling thread. If @a handler is provided, it is notified about progress after each
+     written batch and it can cancel the export.
+     @return true on success, false on failure and cancelled if the export has been cancelled
+     by @a handler. Data written before failure or cancellation is not removed from @a device.
+     @since 3.3 */
+    tristate exportData(KDbQuerySchema *query, QIODevice *device,
+                        const KDbExportOptions &options = KDbExportOptions(),
+                        KDbExportProgressHandler *handler = nullptr);
+
+    /*! @overload
+     Exports all records of table @a table.
+     @since 3.3 */
+    tristate exportData(KDbTableSchema *table, QIODevice *device,
+                        const KDbExportOptions &options = KDbExportOptions(),
+                        KDbExportProgressHandler *handler = nullptr);
+
+    /*! Imports records from @a device to table @a table. Format of the data is specified by
+     @a options. The input is read by the calling thread in chunks of at least
+     KDbImportOptions::chunkSize() bytes that are parsed by multiple threads to batches
+     of typed values and inserted in order by the calling thread within a single transaction,
+     using the fastest method offered by the driver. Values are converted to types of the
+     table's fields; integer and Boolean values are checked using KDbFieldValidator, text
+     values are checked against maximum length of the fields.
+     Records that can't be converted are rejected and reported to @a handler. If more than
+     KDbImportOptions::maxErrors() records are rejected the import fails. If @a handler is
+     provided, it is also notified about progress after each inserted batch and it can cancel
+     the import. KDb::inferImportTableSchema() can be used to create a table for the data.
+     @return true on success, false on failure and cancelled if the import has been cancelled
+     by @a handler. On failure or cancellation the transaction is rolled back.
+     @since 3.3 */
+    tristate importData(QIODevice *device, KDbTableSchema *table,
+                        const KDbImportOptions &options = KDbImportOptions(),
+                        KDbImportProgressHandler *handler = nullptr);
+
     /*! Deletes cursor @a cursor previously created by functions like executeQuery()
      for this connection.
      There is an attempt to close the cursor with KDbCursor::close() if it was opened.
@@ -581,9 +794,17 @@ public:
     tristate resultExists(const KDbEscapedString &sql,
                           QueryRecordOptions options = QueryRecordOption::Default);
 
-    /*! @return true if there is at least one record in @a table. */
+    /*! @return true if there is no record in @a table, false if there is at least one record.
+     A "SELECT 1 FROM table LIMIT 1" statement is used. On error returns @c cancelled. */
     tristate isEmpty(KDbTableSchema* table);
 
+    /*! @overload
+     Operates on a query schema. @a params are optional values of parameters that will be inserted
+     into [] placeholders. Columns, relations for visible lookup columns and ORDER BY are omitted
+     from the statement, see KDbNativeStatementBuilder::generateExistsStatement().
+     @since 3.3 */
+    tristate isEmpty(KDbQuerySchema* query, const QList<QVariant>& params = QList<QVariant>());
+
     /**
      * @brief Return recently used SQL string
      *
@@ -689,8 +910,10 @@ public:
     tristate dropTable(const QString& tableName);
 
     /*! Alters @a tableSchema using @a newTableSchema in memory and on the db backend.
+     If the table contains records, they are copied to a table created using @a newTableSchema
+     by KDbTableRebuilder. Values of fields existing in both schemas are copied, converted
+     if types of the fields differ. The new table then replaces the old one.
      @return true on success, cancelled if altering was cancelled. */
-//! @todo (js): implement real altering
 //! @todo (js): update any structure (e.g. query) that depend on this table!
     tristate alterTable(KDbTableSchema* tableSchema, KDbTableSchema* newTableSchema);
 
@@ -836,6 +1059,31 @@ public:
      */
     bool executeSql(const KDbEscapedString& sql);
 
+    /*! Requests cancellation of the statement that is currently executed by this connection,
+     e.g. by executeSql() or by an opened cursor fetching records.
+     This method is thread-safe, it is intended to be called from a thread other than the one
+     executing the statement. The interrupted operation fails and its result is set to the
+     ERR_QUERY_CANCELED error code. Nothing happens if no statement is being executed.
+     @return true if the request has been passed to the driver; false if the driver does not
+     support cancellation.
+     @since 3.3 */
+    bool cancel();
+
+    /*! Sets timeout for execution of a single statement to @a msecs milliseconds.
+     Statements that take longer are interrupted and fail with the ERR_QUERY_CANCELED
+     error code. For queries opened by cursors the time is measured from fetching of the first
+     record until the cursor is closed. The value of 0 (the default) means there is no timeout.
+     The setting is stored and applied to every database used by this connection.
+     @return false and sets ERR_UNSUPPORTED_DRV_FEATURE error if the driver does not support
+     statement timeouts.
+     @since 3.3 */
+    bool setStatementTimeout(int msecs);
+
+    /*! @return timeout for execution of a single statement in milliseconds, 0 means no timeout.
+     @see setStatementTimeout()
+     @since 3.3 */
+    int statementTimeout() const;
+
     /*! Stores object (id, name, caption, description)
     described by @a object on the backend. It is expected that entry on the
     backend already exists, so it's updated. Changes to identifier attribute are not allowed.
@@ -958,6 +1206,21 @@ public:
     int recordCount(KDbTableOrQuerySchema* tableOrQuery,
                                const QList<QVariant>& params = QList<QVariant>());
 
+    /**
+     * @brief Returns approximate number of records of given table
+     *
+     * For database backends that maintain table statistics the number is read from
+     * the statistics without counting the records, so it can be inaccurate: it reflects state
+     * of the table at the time the statistics have been updated, e.g. by SQLite's ANALYZE or
+     * PostgreSQL's autovacuum. This is sufficient e.g. for sizing scroll bars of large tables.
+     * If there are no statistics for @a tableSchema, the exact number is returned like
+     * in recordCount(const KDbTableSchema&).
+     * -1 is returned if error occurred.
+     *
+     * @since 3.3
+     */
+    int approximateRecordCount(const KDbTableSchema& tableSchema);
+
     //! Identifier escaping function in the associated KDbDriver.
     /*! Calls the identifier escaping function in this connection to
      escape table and column names.  This should be used when explicitly
@@ -1108,6 +1371,58 @@ protected:
      */
     virtual bool drv_executeSql(const KDbEscapedString& sql) = 0;
 
+    /*! For reimplementation: interrupts execution of the statement currently executed
+     by this connection. Called by cancel(), possibly from a different thread, so
+     implementation should only use thread-safe calls of the native API.
+     Default implementation does nothing and returns false meaning cancellation is not supported.
+     @since 3.3 */
+    virtual bool drv_cancel();
+
+    /*! For reimplementation: sets timeout for execution of a single statement
+     to @a msecs milliseconds; 0 means no timeout. Called when a database is used.
+     Default implementation returns false meaning timeouts are not supported.
+     @since 3.3 */
+    virtual bool drv_setStatementTimeout(int msecs);
+
+    /*! For reimplementation: starts a read transaction and pins its state for KDbReaderPool.
+     Called for read-only connections only. The transaction is ended by drv_endReadSnapshot().
+     @return handle of the snapshot, owned by the caller, or @c nullptr on failure.
+     Default implementation returns @c nullptr meaning snapshots are not supported.
+     @since 3.3 */
+    virtual KDbReadSnapshotData* drv_pinReadSnapshot();
+
+    /*! For reimplementation: starts a read transaction that sees state pinned by @a snapshot,
+     which has been returned by drv_pinReadSnapshot() of another connection to the same database.
+     Default implementation returns false meaning snapshots are not supported.
+     @since 3.3 */
+    virtual bool drv_beginReadSnapshot(KDbReadSnapshotData *snapshot);
+
+    /*! For reimplementation: ends read transaction started by drv_pinReadSnapshot()
+     or drv_beginReadSnapshot(). Default implementation returns false.
+     @since 3.3 */
+    virtual bool drv_endReadSnapshot();
+
+    /*! For reimplementation: inserts records of @a batch to the table owning @a fields.
+     Values of the batch are already converted to types of @a fields, in order of @a fields.
+     Called by importData() within a transaction.
+     Default implementation executes prepared INSERT statement for each record.
+     @since 3.3 */
+    virtual bool drv_insertBatch(KDbFieldList *fields, const KDbImportBatch &batch);
+
+    /*! For reimplementation: updates statistics used by the database for planning queries
+     on table @a tableName, e.g. after the table has been filled by KDbTableRebuilder.
+     Default implementation does nothing and returns true.
+     @since 3.3 */
+    virtual bool drv_updateTableStatistics(const QString &tableName);
+
+    /*! For reimplementation: stores approximate number of records of @a tableSchema obtained
+     from statistics maintained by the database in @a count, see approximateRecordCount().
+     @return true on success, @c cancelled if there are no statistics for the table
+     and false on error.
+     Default implementation returns @c cancelled.
+     @since 3.3 */
+    virtual tristate drv_approximateRecordCount(const KDbTableSchema &tableSchema, int *count);
+
     /*! For reimplementation: loads list of databases' names available for this connection
      and adds these names to @a list. If your server is not able to offer such a list,
      consider reimplementing drv_databaseExists() instead.
@@ -1430,15 +1745,24 @@ private:
 
     Q_DISABLE_COPY(KDbConnection)
     friend class KDbConnectionPrivate;
+    friend class KDbConnectionInternal;
     friend class KDbAlterTableHandler;
     friend class KDbConnectionProxy;
     friend class KDbCursor;
     friend class KDbDriver;
+    friend class KDbNativeStatementBuilder;
+    friend class KDbPrefetchCursor;
+    friend class KDbPreparedStatement;
     friend class KDbProperties; //!< for setError()
     friend class KDbQuerySchema;
     friend class KDbQuerySchemaPrivate;
+    friend class KDbReaderPool;
+    friend class KDbTableRebuilder;
     friend class KDbTableSchemaChangeListenerPrivate;
     friend class KDbTableSchema; //!< for removeMe()
+    friend tristate kdbImportData(KDbConnection *conn, QIODevice *device, KDbTableSchema *table,
+                                  const KDbImportOptions &options,
+                                  KDbImportProgressHandler *handler, KDbResult *result);
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(KDbConnection::QueryRecordOptions)
@@ -36,6 +36,18 @@ class KDB_EXPORT KDbConnectionOptions : public KDbUtils::PropertySet
 {
     Q_DECLARE_TR_FUNCTIONS(KDbConnectionOptions)
 public:
+    /*! Performance profile of a connection.
+     Drivers map profiles to their settings, e.g. the SQLite driver sets journal mode,
+     synchronization level, cache size and memory-mapped I/O. Individual settings
+     can be overridden by driver-specific options, see the driver's documentation.
+     @since 3.3 */
+    enum class PerformanceProfile {
+        Default,       //!< Default settings of the driver, the same as in earlier versions of KDb
+        Durable,       //!< Maximum durability, committed data survives power loss
+        FastWal,       //!< Fast writes using write-ahead log and relaxed synchronization
+        ReadMostlyMmap //!< Fast reads using memory-mapped I/O and a large cache
+    };
+
     KDbConnectionOptions();
 
     KDbConnectionOptions(const KDbConnectionOptions &other);
@@ -61,9 +73,31 @@ public:
      Only works if connection is not yet established. */
     void setReadOnly(bool set);
 
+    /*! @return performance profile, PerformanceProfile::Default by default.
+     The profile is stored as "performanceProfile" option with value equal to
+     performanceProfileName(). Drivers apply it when the database is opened.
+     @since 3.3 */
+    PerformanceProfile performanceProfile() const;
+
+    /*! Sets performance profile to @a profile.
+     The profile takes effect next time a database is opened by the connection.
+     @since 3.3 */
+    void setPerformanceProfile(PerformanceProfile profile);
+
+    //! @return name of performance profile @a profile: "default", "durable", "fast-wal"
+    //! or "read-mostly-mmap"
+    //! @since 3.3
+    static QString performanceProfileName(PerformanceProfile profile);
+
+    //! @return performance profile for name @a name (see performanceProfileName()).
+    //! PerformanceProfile::Default is returned and @a ok is set to false if @a name is invalid.
+    //! @since 3.3
+    static PerformanceProfile performanceProfileForName(const QString &name, bool *ok = nullptr);
+
     //! Inserts option with a given @a name, @a value and @a caption.
     //! If such option exists, value is updated but caption only if existing caption is empty.
     //! @a name must be a valid identifier (see KDb::isIdentifier()).
+    //! Invalid values of the "performanceProfile" option are ignored.
     void insert(const QByteArray &name, const QVariant &value, const QString &caption = QString());
 
     //! Sets caption for option @a name to @a caption.
@@ -242,6 +242,82 @@ bool KDbConnectionProxy::setAutoCommit(bool on)
     return d->connection->setAutoCommit(on);
 }
 
+bool KDbConnectionProxy::setWriteBatchingEnabled(bool set, int maxWrites, int maxDelay)
+{
+    return d->connection->setWriteBatchingEnabled(set, maxWrites, maxDelay);
+}
+
+bool KDbConnectionProxy::isWriteBatchingEnabled() const
+{
+    return d->connection->isWriteBatchingEnabled();
+}
+
+bool KDbConnectionProxy::flushWriteBatch()
+{
+    return d->connection->flushWriteBatch();
+}
+
+KDbConnection::WriteBatchStatistics KDbConnectionProxy::writeBatchStatistics() const
+{
+    return d->connection->writeBatchStatistics();
+}
+
+KDbTracer* KDbConnectionProxy::tracer() const
+{
+    return d->connection->tracer();
+}
+
+void KDbConnectionProxy::setTracer(KDbTracer *tracer)
+{
+    d->connection->setTracer(tracer);
+}
+
+int KDbConnectionProxy::lookupValueCacheLimit() const
+{
+    return d->connection->lookupValueCacheLimit();
+}
+
+void KDbConnectionProxy::setLookupValueCacheLimit(int maxRecords)
+{
+    d->connection->setLookupValueCacheLimit(maxRecords);
+}
+
+tristate KDbConnectionProxy::lookupVisibleValue(const KDbLookupFieldSchema &lookup,
+                                                const QVariant &boundValue, QVariant *visibleValue)
+{
+    return d->connection->lookupVisibleValue(lookup, boundValue, visibleValue);
+}
+
+void KDbConnectionProxy::clearLookupValueCache()
+{
+    d->connection->clearLookupValueCache();
+}
+
+void KDbConnectionProxy::addLookupValuesListener(KDbLookupValuesListener *listener)
+{
+    d->connection->addLookupValuesListener(listener);
+}
+
+void KDbConnectionProxy::removeLookupValuesListener(KDbLookupValuesListener *listener)
+{
+    d->connection->removeLookupValuesListener(listener);
+}
+
+int KDbConnectionProxy::resultCacheSize() const
+{
+    return d->connection->resultCacheSize();
+}
+
+void KDbConnectionProxy::setResultCacheSize(int size)
+{
+    d->connection->setResultCacheSize(size);
+}
+
+void KDbConnectionProxy::clearResultCache()
+{
+    d->connection->clearResultCache();
+}
+
 KDbEscapedString KDbConnectionProxy::escapeString(const QString& str) const
 {
     return d->connection->escapeString(str);
@@ -283,6 +359,43 @@ KDbCursor* KDbConnectionProxy::executeQuery(KDbTableSchema* table, KDbCursor::Op
     return d->connection->executeQuery(table, options);
 }
 
+KDbAsyncQuery* KDbConnectionProxy::executeQueryAsync(const KDbEscapedString &sql)
+{
+    return d->connection->executeQueryAsync(sql);
+}
+
+KDbAsyncQuery* KDbConnectionProxy::executeQueryAsync(KDbQuerySchema *query,
+                                                     const QList<QVariant> &params)
+{
+    return d->connection->executeQueryAsync(query, params);
+}
+
+KDbAsyncQuery* KDbConnectionProxy::executeSqlAsync(const KDbEscapedString &sql)
+{
+    return d->connection->executeSqlAsync(sql);
+}
+
+tristate KDbConnectionProxy::exportData(KDbQuerySchema *query, QIODevice *device,
+                                        const KDbExportOptions &options,
+                                        KDbExportProgressHandler *handler)
+{
+    return d->connection->exportData(query, device, options, handler);
+}
+
+tristate KDbConnectionProxy::exportData(KDbTableSchema *table, QIODevice *device,
+                                        const KDbExportOptions &options,
+                                        KDbExportProgressHandler *handler)
+{
+    return d->connection->exportData(table, device, options, handler);
+}
+
+tristate KDbConnectionProxy::importData(QIODevice *device, KDbTableSchema *table,
+                                        const KDbImportOptions &options,
+                                        KDbImportProgressHandler *handler)
+{
+    return d->connection->importData(device, table, options, handler);
+}
+
 bool KDbConnectionProxy::deleteCursor(KDbCursor *cursor)
 {
     return d->connection->deleteCursor(cursor);
@@ -395,6 +508,11 @@ tristate KDbConnectionProxy::isEmpty(KDbTableSchema* table)
     return d->connection->isEmpty(table);
 }
 
+tristate KDbConnectionProxy::isEmpty(KDbQuerySchema* query, const QList<QVariant>& params)
+{
+    return d->connection->isEmpty(query, params);
+}
+
 KDbEscapedString KDbConnectionProxy::recentSqlString() const
 {
     return d->connection->recentSqlString();
@@ -519,6 +637,21 @@ bool KDbConnectionProxy::executeSql(const KDbEscapedString& sql)
     return d->connection->executeSql(sql);
 }
 
+bool KDbConnectionProxy::cancel()
+{
+    return d->connection->cancel();
+}
+
+bool KDbConnectionProxy::setStatementTimeout(int msecs)
+{
+    return d->connection->setStatementTimeout(msecs);
+}
+
+int KDbConnectionProxy::statementTimeout() const
+{
+    return d->connection->statementTimeout();
+}
+
 bool KDbConnectionProxy::storeObjectData(KDbObject* object)
 {
     return d->connection->storeObjectData(object);
@@ -648,6 +781,47 @@ bool KDbConnectionProxy::drv_executeSql(const KDbEscapedString& sql)
     return d->connection->drv_executeSql(sql);
 }
 
+bool KDbConnectionProxy::drv_cancel()
+{
+    return d->connection->drv_cancel();
+}
+
+bool KDbConnectionProxy::drv_setStatementTimeout(int msecs)
+{
+    return d->connection->drv_setStatementTimeout(msecs);
+}
+
+KDbReadSnapshotData* KDbConnectionProxy::drv_pinReadSnapshot()
+{
+    return d->connection->drv_pinReadSnapshot();
+}
+
+bool KDbConnectionProxy::drv_beginReadSnapshot(KDbReadSnapshotData *snapshot)
+{
+    return d->connection->drv_beginReadSnapshot(snapshot);
+}
+
+bool KDbConnectionProxy::drv_endReadSnapshot()
+{
+    return d->connection->drv_endReadSnapshot();
+}
+
+bool KDbConnectionProxy::drv_insertBatch(KDbFieldList *fields, const KDbImportBatch &batch)
+{
+    return d->connection->drv_insertBatch(fields, batch);
+}
+
+bool KDbConnectionProxy::drv_updateTableStatistics(const QString &tableName)
+{
+    return d->connection->drv_updateTableStatistics(tableName);
+}
+
+tristate KDbConnectionProxy::drv_approximateRecordCount(const KDbTableSchema &tableSchema,
+                                                        int *count)
+{
+    return d->connection->drv_approximateRecordCount(tableSchema, count);
+}
+
 bool KDbConnectionProxy::drv_getDatabasesList(QStringList* list)
 {
     return d->connection->drv_getDatabasesList(list);
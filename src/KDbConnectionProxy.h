@@ -126,6 +126,52 @@ public:
 
     bool setAutoCommit(bool on);
 
+    //! @since 3.3
+    bool setWriteBatchingEnabled(bool set, int maxWrites = 1000, int maxDelay = 5);
+
+    //! @since 3.3
+    bool isWriteBatchingEnabled() const;
+
+    //! @since 3.3
+    bool flushWriteBatch();
+
+    //! @since 3.3
+    WriteBatchStatistics writeBatchStatistics() const;
+
+    //! @since 3.3
+    KDbTracer* tracer() const;
+
+    //! @since 3.3
+    void setTracer(KDbTracer *tracer);
+
+    //! @since 3.3
+    int lookupValueCacheLimit() const;
+
+    //! @since 3.3
+    void setLookupValueCacheLimit(int maxRecords);
+
+    //! @since 3.3
+    tristate lookupVisibleValue(const KDbLookupFieldSchema &lookup, const QVariant &boundValue,
+                                QVariant *visibleValue);
+
+    //! @since 3.3
+    void clearLookupValueCache();
+
+    //! @since 3.3
+    void addLookupValuesListener(KDbLookupValuesListener *listener);
+
+    //! @since 3.3
+    void removeLookupValuesListener(KDbLookupValuesListener *listener);
+
+    //! @since 3.3
+    int resultCacheSize() const;
+
+    //! @since 3.3
+    void setResultCacheSize(int size);
+
+    //! @since 3.3
+    void clearResultCache();
+
     KDbEscapedString escapeString(const QString& str) const override;
 
     KDbCursor *prepareQuery(const KDbEscapedString &sql,
@@ -147,6 +193,31 @@ public:
 
     KDbCursor* executeQuery(KDbTableSchema* table, KDbCursor::Options options = KDbCursor::Option::None);
 
+    //! @since 3.3
+    KDbAsyncQuery *executeQueryAsync(const KDbEscapedString &sql);
+
+    //! @since 3.3
+    KDbAsyncQuery *executeQueryAsync(KDbQuerySchema *query,
+                                     const QList<QVariant> &params = QList<QVariant>());
+
+    //! @since 3.3
+    KDbAsyncQuery *executeSqlAsync(const KDbEscapedString &sql);
+
+    //! @since 3.3
+    tristate exportData(KDbQuerySchema *query, QIODevice *device,
+                        const KDbExportOptions &options = KDbExportOptions(),
+                        KDbExportProgressHandler *handler = nullptr);
+
+    //! @since 3.3
+    tristate exportData(KDbTableSchema *table, QIODevice *device,
+                        const KDbExportOptions &options = KDbExportOptions(),
+                        KDbExportProgressHandler *handler = nullptr);
+
+    //! @since 3.3
+    tristate importData(QIODevice *device, KDbTableSchema *table,
+                        const KDbImportOptions &options = KDbImportOptions(),
+                        KDbImportProgressHandler *handler = nullptr);
+
     bool deleteCursor(KDbCursor *cursor);
 
     KDbTableSchema* tableSchema(int tableId);
@@ -201,6 +272,9 @@ public:
 
     tristate isEmpty(KDbTableSchema* table);
 
+    //! @since 3.3
+    tristate isEmpty(KDbQuerySchema* query, const QList<QVariant>& params = QList<QVariant>());
+
     KDbEscapedString recentSqlString() const override;
 
     //PROTOTYPE:
@@ -263,6 +337,15 @@ public:
 
     bool executeSql(const KDbEscapedString& sql);
 
+    //! @since 3.3
+    bool cancel();
+
+    //! @since 3.3
+    bool setStatementTimeout(int msecs);
+
+    //! @since 3.3
+    int statementTimeout() const;
+
     bool storeObjectData(KDbObject* object);
 
     bool storeNewObjectData(KDbObject* object);
@@ -320,6 +403,30 @@ public:
 
     bool drv_executeSql(const KDbEscapedString& sql) override;
 
+    //! @since 3.3
+    bool drv_cancel() override;
+
+    //! @since 3.3
+    bool drv_setStatementTimeout(int msecs) override;
+
+    //! @since 3.3
+    KDbReadSnapshotData* drv_pinReadSnapshot() override;
+
+    //! @since 3.3
+    bool drv_beginReadSnapshot(KDbReadSnapshotData *snapshot) override;
+
+    //! @since 3.3
+    bool drv_endReadSnapshot() override;
+
+    //! @since 3.3
+    bool drv_insertBatch(KDbFieldList *fields, const KDbImportBatch &batch) override;
+
+    //! @since 3.3
+    bool drv_updateTableStatistics(const QString &tableName) override;
+
+    //! @since 3.3
+    tristate drv_approximateRecordCount(const KDbTableSchema &tableSchema, int *count) override;
+
     bool drv_getDatabasesList(QStringList* list) override;
 
     bool drv_databaseExists(const QString &dbName, bool ignoreErrors = true) override;
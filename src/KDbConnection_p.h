@@ -20,20 +20,44 @@
 #ifndef KDB_CONNECTION_P_H
 #define KDB_CONNECTION_P_H
 
+#include "KDbAsyncQuery_p.h"
 #include "KDbConnectionData.h"
 #include "KDbConnection.h"
 #include "KDbConnectionOptions.h"
+#include "KDbDmlPlan_p.h"
+#include "KDbLookupValueCache_p.h"
 #include "kdb_export.h"
 #include "KDbParser.h"
 #include "KDbProperties.h"
 #include "KDbQuerySchema_p.h"
+#include "KDbRecordEditBuffer.h"
+#include "KDbResultCache_p.h"
+#include "KDbStatementBuffer_p.h"
+#include "KDbSymbol_p.h"
 #include "KDbVersionInfo.h"
 
+#include <QElapsedTimer>
+
+class QTimer;
+
 //! Interface for accessing connection's internal result, for use by drivers.
 class KDB_EXPORT KDbConnectionInternal
 {
 public:
     explicit KDbConnectionInternal(KDbConnection *conn);
+
+    /*! Informs the connection that execution of the current statement has been interrupted
+     by the driver because of exceeding KDbConnection::statementTimeout().
+     Thread-safe. Cancellation requested by KDbConnection::cancel() has higher priority.
+     @since 3.3 */
+    void statementTimedOut();
+
+    /*! Informs the connection that statement @a sql has been executed by the driver
+     outside of KDbConnection::executeSql() or KDbConnection::prepareSql(), e.g. on the first
+     step of a prepared statement. Cached query results are discarded if needed.
+     @since 3.3 */
+    void statementExecuted(const KDbEscapedString &sql);
+
     KDbConnection* const connection;
 private:
     Q_DISABLE_COPY(KDbConnectionInternal)
@@ -60,7 +84,7 @@ public:
     }
 
     inline KDbTableSchema* table(const QString& name) const {
-        return m_tablesByName.value(name);
+        return m_symbols.find(name).table();
     }
 
     inline KDbTableSchema* table(int id) const {
@@ -94,7 +118,7 @@ public:
     void clearTables();
 
     inline KDbQuerySchema* query(const QString& name) const {
-        return m_queriesByName.value(name);
+        return m_symbols.find(name).query();
     }
 
     inline KDbQuerySchema* query(int id) const {
@@ -132,6 +156,74 @@ public:
     //! Removes cached fields expanded information for @a query
     void removeFieldsExpanded(const KDbQuerySchema *query);
 
+    /*! @return plan of data modification statement of type @a type for @a query
+     and edited columns @a columns sorted by address. The plan is built if needed and cached.
+     On failure sets error in the connection's result and returns @c nullptr. */
+    KDbDmlPlan* dmlPlan(KDbDmlPlan::Type type, KDbQuerySchema *query, bool useRecordId,
+                        const QVector<KDbQueryColumnInfo*> &columns);
+
+    /*! Collects values for slots of @a plan from edit buffer @a buffer and record @a data.
+     @return false and sets error in the connection's result if a primary key's value is empty. */
+    bool dmlPlanValues(const KDbDmlPlan &plan, const KDbRecordEditBuffer::DbHash &buffer,
+                       const KDbRecordData &data, QVector<QVariant> *values);
+
+    /*! Creates handle for asynchronous execution of @a sql and appends it to the queue
+     of the worker thread. The thread is started if needed.
+     @return the handle or @c nullptr on failure. */
+    KDbAsyncQuery* executeAsync(KDbAsyncQueryJob::Type type, const KDbEscapedString &sql);
+
+    //! Stops the worker thread used for asynchronous queries, if it exists.
+    void deleteAsyncQueryWorker();
+
+    //! Values of statementInterruption
+    enum StatementInterruption {
+        NoInterruption = 0,
+        StatementCanceled,
+        StatementTimedOut
+    };
+
+    /*! Clears interruption status of the current statement.
+     Called before a new statement is executed. */
+    void resetStatementInterruption();
+
+    /*! If execution of the last statement has been interrupted, clears the status, sets
+     ERR_QUERY_CANCELED error code with appropriate message in @a result and returns true. */
+    bool takeStatementInterruption(KDbResult *result);
+
+    /*! Called before a data modification that can be grouped in a batch of writes.
+     If batching is enabled and no user transaction is started, begins a new batch if needed.
+     @return false on failure. */
+    bool beginBatchedWrite();
+
+    /*! Called after data modification started with beginBatchedWrite(), @a ok is its result.
+     Commits the batch if its limits are reached. @return @a ok or false if committing failed. */
+    bool endBatchedWrite(bool ok);
+
+    //! Commits the pending batch of writes, if any. @return true on success.
+    bool flushWriteBatch();
+
+    /*! Informs caches that statement @a sql is executed using the connection.
+     Cached data of tables the statement can modify is discarded. */
+    void statementExecuted(const KDbEscapedString &sql);
+
+    /*! Informs caches that table @a tableName is modified using the connection.
+     Empty @a tableName means that any table could be modified. */
+    void tableModified(const QString &tableName);
+
+    //! @return true if cursors of @a query contain record id information
+    bool cursorContainsRecordIdInfo(const KDbQuerySchema *query) const;
+
+    /*! Generates statement @a sql selecting records of @a query with parameters @a params
+     for a cursor. @a alsoRetrieveRecordId should be true if the cursor contains record id
+     information. @return false on failure. */
+    bool generateCursorStatement(KDbEscapedString *sql, KDbQuerySchema *query,
+                                 const QList<QVariant> &params, bool alsoRetrieveRecordId);
+
+    /*! @return cursor returning records of @a query with parameters @a params from
+     the result cache or @c nullptr if the result is not cached. The cursor is not opened. */
+    KDbCursor* prepareCachedQuery(KDbQuerySchema *query, const QList<QVariant> &params,
+                                  KDbCursor::Options options);
+
     KDbConnection* const conn; //!< The @a KDbConnection instance this @a KDbConnectionPrivate belongs to.
     KDbConnectionData connData; //!< the @a KDbConnectionData used within that connection.
 
@@ -197,15 +289,54 @@ public:
 
     bool insideCloseDatabase = false; //!< helper: true while closeDatabase() is executed
 
+    //! Worker thread for asynchronous queries, created on demand by executeAsync()
+    KDbAsyncQueryWorker *asyncQueryWorker = nullptr;
+
+    //! One of the StatementInterruption values, set possibly from other threads
+    QAtomicInt statementInterruption;
+
+    //! Timeout for execution of a single statement in milliseconds, 0 means no timeout
+    int statementTimeout = 0;
+
+    bool writeBatchingEnabled = false; //!< see KDbConnection::setWriteBatchingEnabled()
+    int writeBatchMaxWrites = 1000;
+    int writeBatchMaxDelay = 5;
+    KDbTransaction writeBatchTransaction; //!< transaction of the pending batch of writes
+    int writeBatchSize = 0; //!< number of successful writes in the pending batch
+    bool writeBatchSavepoint = false; //!< true if savepoint of the current write is created
+    QElapsedTimer writeBatchAge; //!< measures time since the first write of the pending batch
+    QTimer *writeBatchTimer = nullptr; //!< commits the pending batch after writeBatchMaxDelay
+    KDbConnection::WriteBatchStatistics writeBatchStatistics;
+
+    KDbTracer *tracer = nullptr; //!< see KDbConnection::setTracer(), not owned
+
+    //! Buffer reused for building data modification statements
+    KDbStatementBuffer statementBuffer;
+
+    //! Plans of data modification statements, see dmlPlan()
+    KDbDmlPlanCache dmlPlans;
+
+    //! Visible values of lookup record sources, see KDbConnection::setLookupValueCacheLimit()
+    KDbLookupValueCache lookupValues;
+
+    //! Results of queries, see KDbConnection::setResultCacheSize()
+    KDbResultCache resultCache;
+
 private:
+    //! Unbinds @a tableSchema from symbol of its name, if it is bound
+    void unbindTable(KDbTableSchema* tableSchema);
+
+    //! Unbinds @a query from symbol of its name, if it is bound
+    void unbindQuery(KDbQuerySchema* query);
+
     //! Table schemas retrieved on demand with tableSchema()
     QHash<int, KDbTableSchema*> m_tables;
-    QHash<QString, KDbTableSchema*> m_tablesByName;
+    //! Names of loaded tables and queries, bound to their schemas
+    KDbSymbolTable m_symbols;
     //! used just for removing system KDbTableSchema objects on db close.
     QSet<KDbInternalTableSchema*> m_internalKDbTables;
     //! Query schemas retrieved on demand with querySchema()
     QHash<int, KDbQuerySchema*> m_queries;
-    QHash<QString, KDbQuerySchema*> m_queriesByName;
     KDbUtils::AutodeletedHash<const KDbQuerySchema*, KDbQuerySchemaFieldsExpanded*> m_fieldsExpandedCache;
     Q_DISABLE_COPY(KDbConnectionPrivate)
 };
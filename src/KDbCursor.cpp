@@ -18,17 +18,23 @@
 */
 
 #include "KDbCursor.h"
+#include "KDbColumnBatch.h"
 #include "KDbConnection.h"
+#include "KDbConnection_p.h"
 #include "KDbDriver.h"
 #include "KDbDriverBehavior.h"
 #include "KDbError.h"
 #include "KDb.h"
+#include "KDbLookupFieldSchema.h"
 #include "KDbNativeStatementBuilder.h"
 #include "KDbQuerySchema.h"
 #include "KDbRecordData.h"
 #include "KDbRecordEditBuffer.h"
+#include "KDbTracer_p.h"
 #include "kdb_debug.h"
 
+#include <QScopedPointer>
+
 class Q_DECL_HIDDEN KDbCursor::Private
 {
 public:
@@ -61,8 +67,156 @@ public:
     //<members related to buffering>
     bool atBuffer; //!< true if we already point to the buffer with curr_coldata
     //</members related to buffering>
+
+    //! Lookup column with visible values obtained from the connection's lookup value cache
+    struct CachedLookup {
+        int boundPosition; //!< position of the bound value in record
+        int visiblePosition; //!< position of the visible value in record
+        QSharedPointer<const KDbLookupValueCache::Values> values;
+    };
+
+    /*! Finds lookup columns among first @a logicalFieldCount columns of @a columns
+     that have visible values cached by the connection.
+     Visible values of these columns are not selected by the statement. */
+    void setupCachedLookups(const KDbQueryColumnInfo::Vector &columns, int logicalFieldCount,
+                            int recordSize)
+    {
+        cachedLookups.clear();
+        if (conn->d->lookupValues.maxRecords <= 0) {
+            return;
+        }
+        for (int i = 0; i < logicalFieldCount; ++i) {
+            KDbQueryColumnInfo *ci = columns.at(i);
+            const int visiblePosition = ci->indexForVisibleLookupValue();
+            if (visiblePosition < 0 || visiblePosition >= recordSize) {
+                continue;
+            }
+            KDbField *f = ci->field();
+            const KDbLookupFieldSchema *lookup
+                = f->table() ? f->table()->lookupFieldSchema(*f) : nullptr;
+            if (!lookup) {
+                continue;
+            }
+            const QSharedPointer<const KDbLookupValueCache::Values> values(
+                conn->d->lookupValues.cachedValues(*lookup));
+            if (values) {
+                cachedLookups.append({ i, visiblePosition, values });
+            }
+        }
+    }
+
+    //! Sets cached visible values of lookup columns in @a data
+    void setCachedLookupValues(KDbRecordData *data) const
+    {
+        for (const CachedLookup &lookup : cachedLookups) {
+            const QVariant bound(data->at(lookup.boundPosition));
+            (*data)[lookup.visiblePosition] = bound.isNull()
+                ? QVariant() : lookup.values->value(KDbLookupValueCache::key(bound));
+        }
+    }
+
+    //! Lookup columns of the current statement that use the lookup value cache
+    QVector<CachedLookup> cachedLookups;
+
+    /*! Starts collecting records fetched by @a cursor for the connection's result cache
+     if the cache is enabled and it has no current result of the cursor's statement.
+     Only records of cursors defined by query schemas are collected. */
+    void startResultCaching(const KDbCursor &cursor)
+    {
+        resultCacheData.reset();
+        KDbResultCache *cache = &conn->d->resultCache;
+        if (!cache->isEnabled() || !cursor.m_query || internal) {
+            return;
+        }
+        resultCacheKey = KDbResultCache::key(cursor.result().sql(), queryParameters);
+        if (cache->data(resultCacheKey)) {
+            return;
+        }
+        resultCacheData.reset(new KDbResultCacheData);
+        cache->setDependencies(resultCacheData.data(),
+                               KDbResultCache::dependencies(conn, cursor.m_query));
+    }
+
+    /*! Appends record fetched by @a cursor to the collected records. The records are stored
+     in the result cache when the end of data is reached. Collecting is stopped on errors
+     or when the records do not fit in the cache. */
+    void resultCachingFetched(const KDbCursor &cursor)
+    {
+        if (!resultCacheData) {
+            return;
+        }
+        KDbResultCache *cache = &conn->d->resultCache;
+        if (cursor.m_fetchResult == FetchResult::Ok) {
+            KDbRecordData data(cursor.m_fieldsToStoreInRecord);
+            if (cursor.drv_storeCurrentRecord(&data)
+                && resultCacheData->append(data, cache->maxSize()))
+            {
+                return;
+            }
+        } else if (cursor.m_fetchResult == FetchResult::End) {
+            resultCacheData->fieldCount = cursor.m_fieldCount;
+            resultCacheData->fieldsToStoreInRecord = cursor.m_fieldsToStoreInRecord;
+            cache->insert(resultCacheKey, resultCacheData.take());
+        }
+        resultCacheData.reset();
+    }
+
+    //! Records collected for the connection's result cache, see startResultCaching()
+    QScopedPointer<KDbResultCacheData> resultCacheData;
+    QByteArray resultCacheKey; //!< key of result collected in resultCacheData
+
+    //! @return tracer of the connection or @c nullptr if the cursor is not traced
+    inline KDbTracer* tracer() const
+    {
+        return internal ? nullptr : conn->d->tracer;
+    }
+
+    /*! Calls KDbConnectionPrivate::takeStatementInterruption() for @a result unless
+     the cursor is internal. Interruptions of statements of internal cursors are
+     reported by the cursors that use them. */
+    inline bool takeStatementInterruption(KDbResult *result)
+    {
+        return !internal && conn->d->takeStatementInterruption(result);
+    }
+
+    //! Field types of columns of batches fetched by KDbCursor::fetchBatch(), set on demand
+    QVector<KDbField::Type> batchFieldTypes;
+    bool batchFieldTypesSet = false;
+
+    bool internal = false; //!< see KDbCursor::setInternal()
+    int prefetchDepth = 1024; //!< see KDbCursor::setPrefetchDepth()
+
+    //<members related to tracing, summarized on close>
+    qint64 traceFetchTime = 0;
+    qint64 traceRecords = 0;
+    qint64 traceBytes = 0;
+    //</members related to tracing>
 };
 
+//! @return approximate number of bytes occupied by value @a value, used for tracing
+static qint64 approximateValueSize(const QVariant &value)
+{
+    if (value.isNull()) {
+        return 0;
+    }
+    switch (value.type()) {
+    case QVariant::String:
+        return value.toString().size() * int(sizeof(QChar));
+    case QVariant::ByteArray:
+        return value.toByteArray().size();
+    default:;
+    }
+    return 8;
+}
+
+//! Adds approximate size of values of @a data to @a bytes
+static void addApproximateSize(const KDbRecordData &data, qint64 *bytes)
+{
+    for (int i = 0; i < data.count(); ++i) {
+        *bytes += approximateValueSize(data[i]);
+    }
+}
+
 KDbCursor::KDbCursor(KDbConnection* conn, const KDbEscapedString& sql, Options options)
         : m_query(nullptr)
         , m_options(options)
@@ -99,8 +253,7 @@ void KDbCursor::init(KDbConnection* conn)
     m_buffering_completed = false;
     m_fetchResult = FetchResult::Invalid;
 
-    d->containsRecordIdInfo = (m_query && m_query->masterTable())
-                              && d->conn->driver()->behavior()->ROW_ID_FIELD_RETURNS_LAST_AUTOINCREMENTED_VALUE == false;
+    d->containsRecordIdInfo = d->conn->d->cursorContainsRecordIdInfo(m_query);
 
     if (m_query) {
         //get list of all fields
@@ -145,6 +298,11 @@ bool KDbCursor::readAhead() const
     return d->readAhead;
 }
 
+void KDbCursor::setInternal()
+{
+    d->internal = true;
+}
+
 KDbConnection* KDbCursor::connection()
 {
     return d->conn;
@@ -187,6 +345,10 @@ KDbRecordData* KDbCursor::storeCurrentRecord() const
         delete data;
         return nullptr;
     }
+    d->setCachedLookupValues(data);
+    if (d->tracer()) {
+        addApproximateSize(*data, &d->traceBytes);
+    }
     return data;
 }
 
@@ -196,7 +358,14 @@ bool KDbCursor::storeCurrentRecord(KDbRecordData* data) const
         return false;
     }
     data->resize(m_fieldsToStoreInRecord);
-    return drv_storeCurrentRecord(data);
+    if (!drv_storeCurrentRecord(data)) {
+        return false;
+    }
+    d->setCachedLookupValues(data);
+    if (d->tracer()) {
+        addApproximateSize(*data, &d->traceBytes);
+    }
+    return true;
 }
 
 bool KDbCursor::open()
@@ -205,6 +374,12 @@ bool KDbCursor::open()
         if (!close())
             return false;
     }
+    KDbTraceScope trace(d->tracer(), KDbTraceEvent::Type::OpenCursor);
+    d->traceFetchTime = 0;
+    d->traceRecords = 0;
+    d->traceBytes = 0;
+    d->cachedLookups.clear();
+    d->batchFieldTypesSet = false;
     if (!d->rawSql.isEmpty()) {
         m_result.setSql(d->rawSql);
     }
@@ -215,31 +390,38 @@ bool KDbCursor::open()
                                  tr("No query statement or schema defined."));
             return false;
         }
-        KDbSelectStatementOptions options;
-        options.setAlsoRetrieveRecordId(d->containsRecordIdInfo); /*get record Id if needed*/
-        KDbNativeStatementBuilder builder(d->conn, KDb::DriverEscaping);
         KDbEscapedString sql;
-        if (!builder.generateSelectStatement(&sql, m_query, options, d->queryParameters)
-            || sql.isEmpty())
-        {
+        const bool generated = d->conn->d->generateCursorStatement(
+            &sql, m_query, d->queryParameters, d->containsRecordIdInfo /*get record Id if needed*/);
+        trace.mark(&KDbTraceEvent::generateTime);
+        if (!generated) {
             kdbDebug() << "no statement generated!";
             m_result = KDbResult(ERR_SQL_EXECUTION_ERROR,
                                  tr("Could not generate query statement."));
             return false;
         }
         m_result.setSql(sql);
+        d->setupCachedLookups(*m_visibleFieldsExpanded, m_logicalFieldCount,
+                              m_fieldsToStoreInRecord);
 #ifdef KDB_DEBUG_GUI
         KDb::debugGUI(QString::fromLatin1("SQL for query \"%1\": ")
                          .arg(KDb::iifNotEmpty(m_query->name(), QString::fromLatin1("<unnamed>")))
                       + m_result.sql().toString());
 #endif
     }
+    d->startResultCaching(*this);
+    d->conn->d->resetStatementInterruption();
     d->opened = drv_open(m_result.sql());
+    trace.mark(&KDbTraceEvent::executeTime);
+    trace.finish(m_result.sql(), d->opened);
     m_afterLast = false; //we are not @ the end
     m_at = 0; //we are before 1st rec
     if (!d->opened) {
-        m_result.setCode(ERR_SQL_EXECUTION_ERROR);
-        m_result.setMessage(tr("Error opening database cursor."));
+        d->resultCacheData.reset();
+        if (!d->takeStatementInterruption(&m_result)) {
+            m_result.setCode(ERR_SQL_EXECUTION_ERROR);
+            m_result.setMessage(tr("Error opening database cursor."));
+        }
         return false;
     }
     d->validRecord = false;
@@ -253,13 +435,33 @@ bool KDbCursor::open()
     return !m_result.isError();
 }
 
+bool KDbCursor::cancel()
+{
+    return d->conn->cancel();
+}
+
 bool KDbCursor::close()
 {
     if (!d->opened) {
         return true;
     }
+    d->resultCacheData.reset();
     bool ret = drv_close();
 
+    if (KDbTracer *tracer = d->tracer()) {
+        KDbTraceEvent event(KDbTraceEvent::Type::CloseCursor);
+        event.sql = m_result.sql();
+        event.fingerprint = KDbTracer::fingerprint(event.sql);
+        event.fetchTime = d->traceFetchTime;
+        event.records = d->traceRecords;
+        event.bytes = d->traceBytes;
+        event.success = ret;
+        tracer->traceEvent(event);
+    }
+    d->traceFetchTime = 0;
+    d->traceRecords = 0;
+    d->traceBytes = 0;
+
     clearBuffer();
 
     d->opened = false;
@@ -410,6 +612,16 @@ void KDbCursor::setBuffered(bool buffered)
     m_options ^= KDbCursor::Option::Buffered;
 }
 
+int KDbCursor::prefetchDepth() const
+{
+    return d->prefetchDepth;
+}
+
+void KDbCursor::setPrefetchDepth(int depth)
+{
+    d->prefetchDepth = qMax(1, depth);
+}
+
 void KDbCursor::clearBuffer()
 {
     if (!isBuffered() || m_fieldCount == 0)
@@ -421,9 +633,37 @@ void KDbCursor::clearBuffer()
     d->atBuffer = false;
 }
 
+/*! Sets error of fetching next record to @a result. Server error code and message set by
+ the driver in @a result are kept, so details of the original error are not lost. */
+static void setFetchingError(KDbResult *result)
+{
+    KDbResult error(ERR_CURSOR_RECORD_FETCHING, KDbCursor::tr("Could not fetch next record."));
+    if (result->serverErrorCode() != 0) {
+        error.setServerErrorCode(result->serverErrorCode());
+    }
+    error.setServerMessage(result->serverMessage());
+    *result = error;
+}
+
 bool KDbCursor::getNextRecord()
 {
     m_fetchResult = FetchResult::Invalid; //by default: invalid result of record fetching
+    KDbTracer *tracer = d->tracer();
+    const auto fetchNextRecord = [this, tracer]() {
+        if (!tracer) {
+            drv_getNextRecord();
+            d->resultCachingFetched(*this);
+            return;
+        }
+        QElapsedTimer timer;
+        timer.start();
+        drv_getNextRecord();
+        d->traceFetchTime += timer.nsecsElapsed();
+        if (m_fetchResult == FetchResult::Ok) {
+            ++d->traceRecords;
+        }
+        d->resultCachingFetched(*this);
+    };
 
     if (m_options & KDbCursor::Option::Buffered) {//this cursor is buffered:
 //  kdbDebug() << "m_at < m_records_in_buf :: " << (long)m_at << " < " << m_records_in_buf;
@@ -441,7 +681,7 @@ bool KDbCursor::getNextRecord()
                     //retrieve record only if we are not after
                     //the last buffer's item (i.e. when buffer is not fully filled):
 //     kdbDebug()<<"==== buffering: drv_getNextRecord() ====";
-                    drv_getNextRecord();
+                    fetchNextRecord();
                 }
                 if (m_fetchResult != FetchResult::Ok) {//there is no record
                     m_buffering_completed = true; //no more records for buffer
@@ -450,8 +690,9 @@ bool KDbCursor::getNextRecord()
                     m_afterLast = true;
                     m_at = -1; //position is invalid now and will not be used
                     if (m_fetchResult == FetchResult::Error) {
-                        m_result = KDbResult(ERR_CURSOR_RECORD_FETCHING,
-                                             tr("Could not fetch next record."));
+                        if (!d->takeStatementInterruption(&m_result)) {
+                            setFetchingError(&m_result);
+                        }
                         return false;
                     }
                     return false; // in case of m_fetchResult = FetchResult::End or m_fetchResult = FetchInvalid
@@ -465,7 +706,7 @@ bool KDbCursor::getNextRecord()
     } else {//we are after last retrieved record: we need to physically fetch next record:
         if (!d->readAhead) {//we have no record that was read ahead
 //   kdbDebug()<<"==== no prefetched record ====";
-            drv_getNextRecord();
+            fetchNextRecord();
             if (m_fetchResult != FetchResult::Ok) {//there is no record
 //    kdbDebug()<<"m_fetchResult != FetchResult::Ok ********";
                 d->validRecord = false;
@@ -474,8 +715,9 @@ bool KDbCursor::getNextRecord()
                 if (m_fetchResult == FetchResult::End) {
                     return false;
                 }
-                m_result = KDbResult(ERR_CURSOR_RECORD_FETCHING,
-                                     tr("Could not fetch next record."));
+                if (!d->takeStatementInterruption(&m_result)) {
+                    setFetchingError(&m_result);
+                }
                 return false;
             }
         } else { //we have a record that was read ahead: eat this
@@ -495,6 +737,105 @@ bool KDbCursor::getNextRecord()
     return true;
 }
 
+int KDbCursor::fetchBatch(KDbColumnBatch *batch, int maxRecords)
+{
+    if (!batch || !d->opened) {
+        return -1;
+    }
+    const int columnCount = fieldCount();
+    if (!d->batchFieldTypesSet) {
+        d->batchFieldTypes.resize(columnCount);
+        for (int i = 0; i < columnCount; ++i) {
+            d->batchFieldTypes[i] = (m_visibleFieldsExpanded && i < m_visibleFieldsExpanded->count())
+                ? m_visibleFieldsExpanded->at(i)->field()->type() : KDbField::InvalidType;
+        }
+        d->batchFieldTypesSet = columnCount > 0;
+    }
+    batch->reset(d->batchFieldTypes, qMax(0, maxRecords));
+    d->resultCacheData.reset(); // records fetched in batches are not collected
+    if (m_afterLast || maxRecords <= 0) {
+        return 0;
+    }
+    KDbRecordData data;
+    const auto appendCurrentRecord = [this, batch, columnCount, &data]() {
+        data.resize(m_fieldsToStoreInRecord);
+        if (!drv_storeCurrentRecord(&data)) {
+            return false;
+        }
+        for (int i = 0; i < columnCount; ++i) {
+            batch->appendValue(i, i < data.count() ? data.at(i) : QVariant());
+        }
+        return true;
+    };
+    int count = 0;
+    if (d->readAhead) { // the record read ahead on opening is the first one
+        if (!appendCurrentRecord()) {
+            return -1;
+        }
+        d->readAhead = false;
+        d->validRecord = true;
+        ++m_at;
+        ++count;
+        if (count == maxRecords) {
+            batch->setRecordCount(count);
+            return count;
+        }
+    }
+    KDbTracer *tracer = d->tracer();
+    QElapsedTimer timer;
+    if (tracer) {
+        timer.start();
+    }
+    const int fetched = drv_fetchBatch(batch, maxRecords - count);
+    if (fetched < 0) {
+        // not supported by the driver: fetch records one by one
+        while (count < maxRecords && getNextRecord()) {
+            if (!appendCurrentRecord()) {
+                m_result = KDbResult(ERR_CURSOR_RECORD_FETCHING,
+                                     tr("Could not fetch next record."));
+                return -1;
+            }
+            ++count;
+        }
+        if (m_fetchResult == FetchResult::Error) {
+            return -1;
+        }
+        batch->setRecordCount(count);
+        return count;
+    }
+    if (tracer) {
+        d->traceFetchTime += timer.nsecsElapsed();
+        d->traceRecords += fetched;
+    }
+    m_at += fetched;
+    count += fetched;
+    if (fetched > 0) {
+        d->validRecord = true;
+        d->atBuffer = true;
+    }
+    if (m_fetchResult != FetchResult::Ok) { // no more records
+        d->validRecord = false;
+        m_afterLast = true;
+        m_at = -1;
+        m_buffering_completed = true;
+        if (m_fetchResult == FetchResult::Error) {
+            if (!d->takeStatementInterruption(&m_result)) {
+                setFetchingError(&m_result);
+            }
+            return -1;
+        }
+    }
+    batch->setRecordCount(count);
+    return count;
+}
+
+int KDbCursor::drv_fetchBatch(KDbColumnBatch *batch, int maxRecords)
+{
+    Q_UNUSED(batch)
+    Q_UNUSED(maxRecords)
+    return -1;
+}
+
 bool KDbCursor::updateRecord(KDbRecordData* data, KDbRecordEditBuffer* buf, bool useRecordId)
 {
 //! @todo doesn't update cursor's buffer YET!
@@ -26,6 +26,7 @@
 #include "KDbResult.h"
 #include "KDbQueryColumnInfo.h"
 
+class KDbColumnBatch;
 class KDbConnection;
 class KDbRecordData;
 class KDbQuerySchema;
@@ -60,6 +61,13 @@ class KDbRecordEditBuffer;
   and reused when needed. Unbuffered cursor always requires one record fetching from
   db connection at every step done with moveNext(), movePrev(), etc.
 
+  Cursors created by KDbConnection::executeQuery() or KDbConnection::prepareQuery() with
+  the KDbCursor::Option::Prefetch option fetch records in a separate thread, so waiting for
+  the database overlaps with processing of the records. Such cursors are never buffered,
+  see setPrefetchDepth() for details. Statements of prefetching cursors are executed using
+  the cursor's connection by another thread, so the connection should not be used for
+  other statements until the cursor is closed.
+
   Notes:
   - Do not use delete operator for KDbCursor objects - this will fail; use KDbConnection::deleteCursor()
   instead.
@@ -72,7 +80,9 @@ public:
     //! Options that describe behavior of database cursor
     enum class Option {
         None = 0,
-        Buffered = 1
+        Buffered = 1,
+        Prefetch = 2 //!< Records are fetched in a separate thread, see setPrefetchDepth()
+                     //!< @since 3.3
     };
     Q_DECLARE_FLAGS(Options, Option)
 
@@ -96,6 +106,15 @@ public:
       If the cursor is closed, nothing happens. */
     virtual bool close();
 
+    /*! Requests cancellation of the statement executed by the cursor's connection.
+     This method is thread-safe. If the cursor is opening or fetching records,
+     the operation fails and result() contains the ERR_QUERY_CANCELED error code.
+     Equivalent of connection()->cancel().
+     @return false if the driver does not support cancellation.
+     @see KDbConnection::cancel()
+     @since 3.3 */
+    bool cancel();
+
     /*! @return query schema used to define this cursor
      or 0 if the cursor is not defined by a query schema but by a raw SQL statement. */
     KDbQuerySchema *query() const;
@@ -126,6 +145,23 @@ public:
     */
     void setBuffered(bool buffered);
 
+    /*! @return maximum number of records fetched in advance by cursors with
+     the KDbCursor::Option::Prefetch option. 1024 by default.
+     @since 3.3 */
+    int prefetchDepth() const;
+
+    /*! Sets maximum number of records fetched in advance by cursors with
+     the KDbCursor::Option::Prefetch option to @a depth.
+
+     Records of such cursors are fetched and decoded by a separate thread while the records
+     fetched previously are processed. They are passed in up to four batches of @a depth / 4
+     records; the fetching thread waits while all batches are full. Lower depth uses less
+     memory, higher depth hides longer fetching delays. Values lower than 1 are changed to 1.
+     The depth is used when the cursor is opened next time.
+     Closing the cursor stops the fetching thread and discards records fetched in advance.
+     @since 3.3 */
+    void setPrefetchDepth(int depth);
+
     /*! Moves current position to the first record and retrieves it.
       @return true if the first record was retrieved.
       False could mean that there was an error or there is no record available. */
@@ -225,6 +261,20 @@ public:
      @c false is returned if @a data is @c nullptr. */
     bool storeCurrentRecord(KDbRecordData* data) const;
 
+    /*! Fetches up to @a maxRecords records following the current position into @a batch.
+
+     Previous contents of @a batch are replaced, memory allocated by @a batch is reused.
+     The batch contains fieldCount() columns. Records are fetched by the driver in a loop
+     without creating KDbRecordData objects or QVariant values for each value where
+     possible, so this is the fastest way of reading large number of records.
+
+     After fetching, the last fetched record is the current record. If there are no more
+     records, eof() returns true. Records fetched in batches are not stored in
+     the connection's result cache.
+     @return number of fetched records, 0 if there are no more records or -1 on error.
+     @since 3.3 */
+    int fetchBatch(KDbColumnBatch *batch, int maxRecords);
+
     bool updateRecord(KDbRecordData* data, KDbRecordEditBuffer* buf, bool useRecordId = false);
 
     bool insertRecord(KDbRecordData* data, KDbRecordEditBuffer* buf, bool getRecrordId = false);
@@ -287,6 +337,20 @@ protected:
     //! @internal clears buffer with reimplemented drv_clearBuffer(). */
     void clearBuffer();
 
+    /*! Fetches up to @a maxRecords records following the current record into @a batch,
+     used by fetchBatch(). The current record (at() for buffered cursors) is not fetched.
+     For each record a value is appended to each column of @a batch using the column's
+     storage. m_fetchResult should be set to FetchResult::End if there are no more records,
+     FetchResult::Error on error and FetchResult::Ok otherwise. After fetching,
+     the last fetched record should be the current record, and for buffered cursors
+     drv_bufferMovePointerNext() should move to the record following it.
+     Note for driver developers: reimplement to fetch records without
+     drv_getNextRecord() and drv_storeCurrentRecord() calls for each record.
+     @return number of fetched records or -1 if this is not supported by the driver.
+     Default implementation returns -1; records are then fetched one by one.
+     @since 3.3 */
+    virtual int drv_fetchBatch(KDbColumnBatch *batch, int maxRecords);
+
     /*! Puts current record's data into @a data (makes a deep copy of each field).
      This method has unspecified behavior if the cursor is not at valid record.
      @return true on success.
@@ -326,8 +390,14 @@ protected:
 private:
     bool readAhead() const;
 
+    /*! Marks this cursor as used internally by another cursor. Internal cursors are not
+     traced, their records are not stored in the connection's result cache and interruptions
+     of their statements are reported by the other cursor. */
+    void setInternal();
+
     Q_DISABLE_COPY(KDbCursor)
     friend class CursorDeleter;
+    friend class KDbPrefetchCursor;
     class Private;
     Private * const d;
 };
@@ -0,0 +1,585 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbDataExport_p.h"
+#include "KDbColumnBatch.h"
+#include "KDbConnection.h"
+#include "KDbCursor.h"
+#include "KDbQueryColumnInfo.h"
+#include "KDbQuerySchema.h"
+
+#include <QDataStream>
+#include <QDate>
+#include <QDateTime>
+#include <QIODevice>
+#include <QTime>
+#include <QtNumeric>
+
+KDbExportOptions::~KDbExportOptions()
+{
+}
+
+//--------------------------------------
+
+KDbExportProgressHandler::KDbExportProgressHandler()
+{
+}
+
+KDbExportProgressHandler::~KDbExportProgressHandler()
+{
+}
+
+//--------------------------------------
+
+//! @return text representation of @a value used by the text formats
+static QString valueToText(const QVariant &value)
+{
+    switch (value.type()) {
+    case QVariant::Date:
+        return value.toDate().toString(Qt::ISODate);
+    case QVariant::DateTime:
+        return value.toDateTime().toString(Qt::ISODate);
+    case QVariant::Time:
+        return value.toTime().toString(Qt::ISODate);
+    case QVariant::ByteArray:
+        return QString::fromLatin1(value.toByteArray().toBase64());
+    default:
+        return value.toString();
+    }
+}
+
+//! Encoder for the KDbExportFormat::Csv format
+class CsvExportEncoder : public KDbExportEncoder
+{
+public:
+    CsvExportEncoder(const QStringList &names, const QVector<KDbField::Type> &types,
+                     QChar delimiter, bool includeHeader)
+        : KDbExportEncoder(names, types)
+        , m_delimiter(delimiter)
+        , m_includeHeader(includeHeader)
+    {
+    }
+
+    QByteArray header() override {
+        if (!m_includeHeader) {
+            return QByteArray();
+        }
+        QString text;
+        for (int i = 0; i < m_names.count(); ++i) {
+            if (i > 0) {
+                text += m_delimiter;
+            }
+            appendField(&text, m_names[i]);
+        }
+        text += QLatin1String("\r\n");
+        return text.toUtf8();
+    }
+
+    QByteArray encode(const KDbColumnBatch &batch) override {
+        QString text;
+        text.reserve(batch.recordCount() * batch.columnCount() * 8);
+        for (int r = 0; r < batch.recordCount(); ++r) {
+            for (int c = 0; c < batch.columnCount(); ++c) {
+                if (c > 0) {
+                    text += m_delimiter;
+                }
+                if (!batch.isNull(r, c)) {
+                    appendField(&text, valueToText(batch.value(r, c)));
+                }
+            }
+            text += QLatin1String("\r\n");
+        }
+        return text.toUtf8();
+    }
+
+private:
+    //! Appends @a value to @a text, quoted if needed
+    void appendField(QString *text, const QString &value) const {
+        bool quote = false;
+        for (const QChar c : value) {
+            if (c == m_delimiter || c == QLatin1Char('"') || c == QLatin1Char('\n')
+                || c == QLatin1Char('\r'))
+            {
+                quote = true;
+                break;
+            }
+        }
+        if (!quote) {
+            *text += value;
+            return;
+        }
+        *text += QLatin1Char('"');
+        for (const QChar c : value) {
+            if (c == QLatin1Char('"')) {
+                *text += QLatin1Char('"');
+            }
+            *text += c;
+        }
+        *text += QLatin1Char('"');
+    }
+
+    const QChar m_delimiter;
+    const bool m_includeHeader;
+};
+
+//! Appends @a string to @a data as JSON string literal
+static void appendJsonString(QByteArray *data, const QString &string)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    const QByteArray utf8 = string.toUtf8();
+    data->append('"');
+    for (const char c : utf8) {
+        switch (c) {
+        case '"': data->append("\\\""); break;
+        case '\\': data->append("\\\\"); break;
+        case '\n': data->append("\\n"); break;
+        case '\r': data->append("\\r"); break;
+        case '\t': data->append("\\t"); break;
+        case '\b': data->append("\\b"); break;
+        case '\f': data->append("\\f"); break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                data->append("\\u00");
+                data->append(hexDigits[(c >> 4) & 0xf]);
+                data->append(hexDigits[c & 0xf]);
+            } else {
+                data->append(c);
+            }
+        }
+    }
+    data->append('"');
+}
+
+//! Encoder for the KDbExportFormat::JsonLines format
+class JsonLinesExportEncoder : public KDbExportEncoder
+{
+public:
+    JsonLinesExportEncoder(const QStringList &names, const QVector<KDbField::Type> &types)
+        : KDbExportEncoder(names, types)
+    {
+        // keys are encoded once
+        for (int i = 0; i < names.count(); ++i) {
+            QByteArray key(i == 0 ? "{" : ",");
+            appendJsonString(&key, names[i]);
+            key.append(':');
+            m_keys.append(key);
+        }
+    }
+
+    QByteArray encode(const KDbColumnBatch &batch) override {
+        QByteArray data;
+        data.reserve(batch.recordCount() * batch.columnCount() * 16);
+        for (int r = 0; r < batch.recordCount(); ++r) {
+            for (int c = 0; c < batch.columnCount(); ++c) {
+                data.append(m_keys[c]);
+                if (batch.isNull(r, c)) {
+                    data.append("null");
+                } else {
+                    appendValue(&data, batch.value(r, c));
+                }
+            }
+            data.append(batch.columnCount() == 0 ? "{}\n" : "}\n");
+        }
+        return data;
+    }
+
+private:
+    static void appendValue(QByteArray *data, const QVariant &value) {
+        if (value.isNull()) {
+            data->append("null");
+            return;
+        }
+        switch (value.type()) {
+        case QVariant::Bool:
+            data->append(value.toBool() ? "true" : "false");
+            break;
+        case QVariant::Int:
+        case QVariant::LongLong:
+            data->append(QByteArray::number(value.toLongLong()));
+            break;
+        case QVariant::UInt:
+        case QVariant::ULongLong:
+            data->append(QByteArray::number(value.toULongLong()));
+            break;
+        case QVariant::Double:
+            if (qIsFinite(value.toDouble())) {
+                data->append(value.toString().toLatin1());
+            } else {
+                data->append("null");
+            }
+            break;
+        default:
+            appendJsonString(data, valueToText(value));
+        }
+    }
+
+    QList<QByteArray> m_keys;
+};
+
+//! Encoder for the KDbExportFormat::Columnar format
+class ColumnarExportEncoder : public KDbExportEncoder
+{
+public:
+    ColumnarExportEncoder(const QStringList &names, const QVector<KDbField::Type> &types)
+        : KDbExportEncoder(names, types)
+    {
+    }
+
+    QByteArray header() override {
+        QByteArray data;
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_4);
+        stream << quint32(0x4B444243) << quint16(1) << quint32(m_names.count());
+        for (int i = 0; i < m_names.count(); ++i) {
+            stream << m_names[i] << qint32(m_types[i]);
+        }
+        return data;
+    }
+
+    QByteArray encode(const KDbColumnBatch &batch) override {
+        QByteArray data;
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_4);
+        stream << quint32(batch.recordCount());
+        for (int c = 0; c < batch.columnCount(); ++c) {
+            const QBitArray &columnNulls = batch.nulls(c);
+            QByteArray nulls((batch.recordCount() + 7) / 8, '\0');
+            for (int r = 0; r < batch.recordCount(); ++r) {
+                if (columnNulls.testBit(r)) {
+                    nulls[r / 8] = nulls[r / 8] | char(1 << (r % 8));
+                }
+            }
+            stream << nulls;
+            writeColumn(&stream, batch, c, m_types[c]);
+        }
+        return data;
+    }
+
+    QByteArray footer() override {
+        QByteArray data;
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_4);
+        stream << quint32(0);
+        return data;
+    }
+
+private:
+    //! Writes non-null values of column @a column of @a batch, reads the typed vectors directly
+    static void writeColumn(QDataStream *stream, const KDbColumnBatch &batch, int column,
+                            KDbField::Type type)
+    {
+        const QBitArray &nulls = batch.nulls(column);
+        const int recordCount = batch.recordCount();
+        switch (batch.storage(column)) {
+        case KDbColumnBatch::Storage::Integer: {
+            const QVector<qint64> &values = batch.integers(column);
+            for (int r = 0; r < recordCount; ++r) {
+                if (nulls.testBit(r)) {
+                    continue;
+                }
+                if (type == KDbField::Boolean) {
+                    *stream << quint8(values[r] != 0 ? 1 : 0);
+                } else {
+                    *stream << values[r];
+                }
+            }
+            break;
+        }
+        case KDbColumnBatch::Storage::Real: {
+            const QVector<double> &values = batch.reals(column);
+            for (int r = 0; r < recordCount; ++r) {
+                if (!nulls.testBit(r)) {
+                    *stream << values[r];
+                }
+            }
+            break;
+        }
+        case KDbColumnBatch::Storage::Text: {
+            const QVector<QString> &values = batch.texts(column);
+            for (int r = 0; r < recordCount; ++r) {
+                if (!nulls.testBit(r)) {
+                    *stream << values[r];
+                }
+            }
+            break;
+        }
+        case KDbColumnBatch::Storage::Blob: {
+            const QVector<QByteArray> &values = batch.blobs(column);
+            for (int r = 0; r < recordCount; ++r) {
+                if (!nulls.testBit(r)) {
+                    *stream << values[r];
+                }
+            }
+            break;
+        }
+        case KDbColumnBatch::Storage::Variant: {
+            const QVector<QVariant> &values = batch.variants(column);
+            for (int r = 0; r < recordCount; ++r) {
+                if (!nulls.testBit(r)) {
+                    writeValue(stream, type, values[r]);
+                }
+            }
+            break;
+        }
+        }
+    }
+
+    static void writeValue(QDataStream *stream, KDbField::Type type, const QVariant &value) {
+        switch (type) {
+        case KDbField::Byte:
+        case KDbField::ShortInteger:
+        case KDbField::Integer:
+        case KDbField::BigInteger:
+            *stream << qint64(value.toLongLong());
+            break;
+        case KDbField::Boolean:
+            *stream << quint8(value.toBool() ? 1 : 0);
+            break;
+        case KDbField::Float:
+        case KDbField::Double:
+            *stream << value.toDouble();
+            break;
+        case KDbField::Date:
+            *stream << value.toDate();
+            break;
+        case KDbField::DateTime:
+            *stream << value.toDateTime();
+            break;
+        case KDbField::Time:
+            *stream << value.toTime();
+            break;
+        case KDbField::BLOB:
+            *stream << value.toByteArray();
+            break;
+        default:
+            *stream << value.toString();
+        }
+    }
+};
+
+KDbExportEncoder::KDbExportEncoder(const QStringList &names, const QVector<KDbField::Type> &types)
+    : m_names(names)
+    , m_types(types)
+{
+}
+
+KDbExportEncoder::~KDbExportEncoder()
+{
+}
+
+//static
+KDbExportEncoder* KDbExportEncoder::create(const KDbExportOptions &options,
+                                           const QStringList &names,
+                                           const QVector<KDbField::Type> &types)
+{
+    switch (options.format()) {
+    case KDbExportFormat::Csv:
+        return new CsvExportEncoder(names, types, options.delimiter(), options.includeHeader());
+    case KDbExportFormat::JsonLines:
+        return new JsonLinesExportEncoder(names, types);
+    case KDbExportFormat::Columnar:
+        return new ColumnarExportEncoder(names, types);
+    }
+    return nullptr;
+}
+
+QByteArray KDbExportEncoder::header()
+{
+    return QByteArray();
+}
+
+QByteArray KDbExportEncoder::footer()
+{
+    return QByteArray();
+}
+
+//--------------------------------------
+
+KDbExportWorker::KDbExportWorker(KDbExportEncoder *encoder, int maxPendingBatches)
+    : m_encoder(encoder)
+    , m_maxPendingBatches(qMax(1, maxPendingBatches))
+{
+}
+
+KDbExportWorker::~KDbExportWorker()
+{
+    stop();
+    wait();
+    qDeleteAll(m_batches);
+}
+
+void KDbExportWorker::enqueue(KDbColumnBatch *batch)
+{
+    QMutexLocker locker(&m_mutex);
+    while (m_batches.count() >= m_maxPendingBatches && !m_stop) {
+        m_batchesChanged.wait(&m_mutex);
+    }
+    if (m_stop) {
+        delete batch;
+        return;
+    }
+    m_batches.enqueue(batch);
+    m_batchesChanged.wakeAll();
+}
+
+void KDbExportWorker::finish()
+{
+    QMutexLocker locker(&m_mutex);
+    m_finish = true;
+    m_batchesChanged.wakeAll();
+}
+
+void KDbExportWorker::stop()
+{
+    QMutexLocker locker(&m_mutex);
+    m_stop = true;
+    m_batchesChanged.wakeAll();
+}
+
+bool KDbExportWorker::takeChunks(QList<Chunk> *chunks, bool wait)
+{
+    QMutexLocker locker(&m_mutex);
+    while (wait && m_chunks.isEmpty() && !m_done) {
+        m_chunksChanged.wait(&m_mutex);
+    }
+    chunks->append(m_chunks);
+    m_chunks.clear();
+    return !m_done || !chunks->isEmpty();
+}
+
+void KDbExportWorker::appendChunk(const QByteArray &data, int recordCount)
+{
+    if (data.isEmpty() && recordCount == 0) {
+        return;
+    }
+    Chunk chunk;
+    chunk.data = data;
+    chunk.recordCount = recordCount;
+    QMutexLocker locker(&m_mutex);
+    m_chunks.append(chunk);
+    m_chunksChanged.wakeAll();
+}
+
+void KDbExportWorker::run()
+{
+    appendChunk(m_encoder->header(), 0);
+    bool stopped = false;
+    while (true) {
+        QMutexLocker locker(&m_mutex);
+        while (m_batches.isEmpty() && !m_finish && !m_stop) {
+            m_batchesChanged.wait(&m_mutex);
+        }
+        stopped = m_stop;
+        if (stopped || m_batches.isEmpty()) {
+            break;
+        }
+        QScopedPointer<KDbColumnBatch> batch(m_batches.dequeue());
+        m_batchesChanged.wakeAll(); // there is space for the next batch
+        locker.unlock();
+        appendChunk(m_encoder->encode(*batch), batch->recordCount());
+    }
+    if (!stopped) {
+        appendChunk(m_encoder->footer(), 0);
+    }
+    QMutexLocker locker(&m_mutex);
+    m_done = true;
+    m_chunksChanged.wakeAll();
+}
+
+//--------------------------------------
+
+tristate kdbExportData(KDbConnection *conn, KDbQuerySchema *query, QIODevice *device,
+                       const KDbExportOptions &options, KDbExportProgressHandler *handler,
+                       KDbResult *result)
+{
+    if (!device || !device->isWritable()) {
+        *result = KDbResult(ERR_OTHER, KDbConnection::tr("Device for exporting data is not writable."));
+        return false;
+    }
+    KDbCursor *cursor = conn->executeQuery(query);
+    if (!cursor) {
+        *result = conn->result();
+        return false;
+    }
+    const int columnCount = cursor->fieldCount();
+    const KDbQueryColumnInfo::Vector columns = query->visibleFieldsExpanded(conn);
+    QStringList names;
+    QVector<KDbField::Type> types;
+    for (int i = 0; i < columnCount; ++i) {
+        names.append(columns[i]->aliasOrName());
+        types.append(columns[i]->field()->type());
+    }
+    const int batchSize = qMax(1, options.batchSize());
+    KDbExportWorker worker(KDbExportEncoder::create(options, names, types),
+                           options.maxPendingBatches());
+    worker.start();
+
+    qint64 records = 0;
+    qint64 bytes = 0;
+    tristate res = true;
+    // Writes converted chunks to the device, @return false when no more chunks will come
+    const auto writeChunks = [&](bool wait) -> bool {
+        QList<KDbExportWorker::Chunk> chunks;
+        const bool more = worker.takeChunks(&chunks, wait);
+        for (const KDbExportWorker::Chunk &chunk : chunks) {
+            if (device->write(chunk.data) != chunk.data.size()) {
+                *result = KDbResult(ERR_OTHER, KDbConnection::tr("Could not write exported data. %1")
+                                                   .arg(device->errorString()));
+                res = false;
+                return false;
+            }
+            records += chunk.recordCount;
+            bytes += chunk.data.size();
+            if (handler && chunk.recordCount > 0 && !handler->exportProgress(records, bytes)) {
+                res = cancelled;
+                return false;
+            }
+        }
+        return more;
+    };
+
+    // records are fetched by columns, without creating record data and values for each cell
+    QScopedPointer<KDbColumnBatch> batch(new KDbColumnBatch);
+    int fetched;
+    while ((fetched = cursor->fetchBatch(batch.data(), batchSize)) > 0) {
+        worker.enqueue(batch.take());
+        batch.reset(new KDbColumnBatch);
+        writeChunks(false);
+        if (res != true) {
+            break;
+        }
+    }
+    if (res == true && fetched < 0) {
+        *result = cursor->result().isError()
+                ? cursor->result()
+                : KDbResult(ERR_CURSOR_RECORD_FETCHING,
+                            KDbConnection::tr("Could not fetch records for export."));
+        res = false;
+    }
+    if (res == true) {
+        worker.finish();
+        while (writeChunks(true)) {
+        }
+    }
+    if (res != true) {
+        worker.stop();
+    }
+    conn->deleteCursor(cursor);
+    return res;
+}
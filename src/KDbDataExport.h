@@ -0,0 +1,48 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_DATAEXPORT_H
+#define KDB_DATAEXPORT_H
+
+#include "kdb_export.h"
+
+#include <QtGlobal>
+
+/*! @brief Interface for receiving progress of KDbConnection::exportData()
+
+ exportProgress() is called in the thread that called KDbConnection::exportData()
+ each time a batch of records has been written.
+ @since 3.3
+*/
+class KDB_EXPORT KDbExportProgressHandler
+{
+public:
+    KDbExportProgressHandler();
+
+    virtual ~KDbExportProgressHandler();
+
+    /*! Called when @a records records and @a bytes bytes have been written so far.
+     @return false to cancel the export. */
+    virtual bool exportProgress(qint64 records, qint64 bytes) = 0;
+
+private:
+    Q_DISABLE_COPY(KDbExportProgressHandler)
+};
+
+#endif
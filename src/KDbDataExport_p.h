@@ -0,0 +1,127 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_DATAEXPORT_P_H
+#define KDB_DATAEXPORT_P_H
+
+#include "KDbDataExport.h"
+#include "KDbExportOptions.h"
+#include "KDbField.h"
+#include "KDbTristate.h"
+
+#include <QMutex>
+#include <QQueue>
+#include <QScopedPointer>
+#include <QThread>
+#include <QVariant>
+#include <QVector>
+#include <QWaitCondition>
+
+class KDbColumnBatch;
+class KDbConnection;
+class KDbQuerySchema;
+class KDbResult;
+class QIODevice;
+
+//! @internal Converts batches of records to the exported format
+class KDbExportEncoder
+{
+public:
+    KDbExportEncoder(const QStringList &names, const QVector<KDbField::Type> &types);
+
+    virtual ~KDbExportEncoder();
+
+    //! @return encoder for format of @a options
+    static KDbExportEncoder* create(const KDbExportOptions &options, const QStringList &names,
+                                    const QVector<KDbField::Type> &types);
+
+    //! @return data written before the records
+    virtual QByteArray header();
+
+    //! @return encoded records of @a batch
+    virtual QByteArray encode(const KDbColumnBatch &batch) = 0;
+
+    //! @return data written after the records
+    virtual QByteArray footer();
+
+protected:
+    const QStringList m_names;
+    const QVector<KDbField::Type> m_types;
+private:
+    Q_DISABLE_COPY(KDbExportEncoder)
+};
+
+/*! @internal Thread converting batches of records using an encoder.
+ Batches are enqueued by the exporting thread that also takes the converted chunks
+ and writes them, so the output device is only used by one thread. */
+class KDbExportWorker : public QThread
+{
+public:
+    //! Converted data
+    struct Chunk {
+        QByteArray data;
+        int recordCount = 0;
+    };
+
+    //! Creates worker for @a encoder, ownership of @a encoder is passed to the worker
+    KDbExportWorker(KDbExportEncoder *encoder, int maxPendingBatches);
+
+    //! Stops the thread
+    ~KDbExportWorker() override;
+
+    //! Appends @a batch for conversion, blocks while maximum number of batches is pending.
+    //! Ownership of @a batch is passed to the worker.
+    void enqueue(KDbColumnBatch *batch);
+
+    //! Informs the worker that no more batches will be enqueued
+    void finish();
+
+    //! Stops conversion, pending batches are discarded
+    void stop();
+
+    /*! Moves converted chunks to @a chunks. If @a wait is true and there are no chunks,
+     blocks until a chunk is available or the conversion is done.
+     @return false if the conversion is done and there are no more chunks. */
+    bool takeChunks(QList<Chunk> *chunks, bool wait);
+
+protected:
+    void run() override;
+
+private:
+    void appendChunk(const QByteArray &data, int recordCount);
+
+    const QScopedPointer<KDbExportEncoder> m_encoder;
+    const int m_maxPendingBatches;
+    QMutex m_mutex;
+    QWaitCondition m_batchesChanged;
+    QWaitCondition m_chunksChanged;
+    QQueue<KDbColumnBatch*> m_batches;
+    QList<Chunk> m_chunks;
+    bool m_finish = false;
+    bool m_stop = false;
+    bool m_done = false;
+    Q_DISABLE_COPY(KDbExportWorker)
+};
+
+//! @internal Implementation of KDbConnection::exportData()
+tristate kdbExportData(KDbConnection *conn, KDbQuerySchema *query, QIODevice *device,
+                       const KDbExportOptions &options, KDbExportProgressHandler *handler,
+                       KDbResult *result);
+
+#endif
@@ -0,0 +1,688 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbDataImport_p.h"
+#include "KDb.h"
+#include "KDbConnection.h"
+#include "KDbConnection_p.h"
+#include "KDbFieldValidator.h"
+#include "KDbTableSchema.h"
+#include "KDbTransactionGuard.h"
+
+#include <QAtomicInt>
+#include <QIODevice>
+#include <QLocale>
+#include <QRunnable>
+#include <QScopedPointer>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
+#include <QtNumeric>
+
+#include <limits>
+
+KDbImportOptions::~KDbImportOptions()
+{
+}
+
+KDbImportError::KDbImportError()
+{
+}
+
+KDbImportProgressHandler::KDbImportProgressHandler()
+{
+}
+
+KDbImportProgressHandler::~KDbImportProgressHandler()
+{
+}
+
+void KDbImportProgressHandler::importError(const KDbImportError &error)
+{
+    Q_UNUSED(error);
+}
+
+//--------------------------------------
+
+KDbImportBatch::KDbImportBatch(int columnCount)
+    : columns(columnCount)
+{
+}
+
+//--------------------------------------
+
+KDbCsvParser::KDbCsvParser(const QString &data, QChar delimiter, qint64 firstLine)
+    : m_data(data)
+    , m_delimiter(delimiter)
+    , m_line(firstLine)
+{
+}
+
+bool KDbCsvParser::next(QVector<KDbCsvValue> *values, qint64 *line, QString *record, bool *ok)
+{
+    const int size = m_data.size();
+    while (m_pos < size) {
+        values->clear();
+        *ok = true;
+        *line = m_line;
+        const int start = m_pos;
+        int end = -1; // end of the record's text, without the line break
+        KDbCsvValue value;
+        while (end < 0) {
+            if (m_pos < size && m_data.at(m_pos) == QLatin1Char('"')) {
+                value.quoted = true;
+                ++m_pos;
+                bool closed = false;
+                while (m_pos < size) {
+                    const QChar c = m_data.at(m_pos++);
+                    if (c == QLatin1Char('"')) {
+                        if (m_pos < size && m_data.at(m_pos) == QLatin1Char('"')) {
+                            value.text.append(c);
+                            ++m_pos;
+                        } else {
+                            closed = true;
+                            break;
+                        }
+                    } else {
+                        if (c == QLatin1Char('\n')) {
+                            ++m_line;
+                        }
+                        value.text.append(c);
+                    }
+                }
+                if (!closed) {
+                    *ok = false;
+                    values->append(value);
+                    end = size;
+                    break;
+                }
+            }
+            // unquoted value or characters following the closing quote
+            const int partStart = m_pos;
+            while (m_pos < size) {
+                const QChar c = m_data.at(m_pos);
+                if (c == m_delimiter || c == QLatin1Char('\n')) {
+                    break;
+                }
+                ++m_pos;
+            }
+            int partEnd = m_pos;
+            if (partEnd > partStart && m_data.at(partEnd - 1) == QLatin1Char('\r')
+                && (m_pos == size || m_data.at(m_pos) == QLatin1Char('\n')))
+            {
+                --partEnd; // CR of the CRLF line break
+            }
+            value.text.append(m_data.midRef(partStart, partEnd - partStart));
+            values->append(value);
+            value = KDbCsvValue();
+            if (m_pos == size) {
+                end = partEnd;
+            } else if (m_data.at(m_pos) == m_delimiter) {
+                ++m_pos;
+            } else { // line feed
+                end = partEnd;
+                ++m_pos;
+                ++m_line;
+            }
+        }
+        *record = m_data.mid(start, end - start);
+        if (!record->isEmpty()) {
+            return true;
+        }
+        // skip empty lines
+    }
+    return false;
+}
+
+//--------------------------------------
+
+KDbImportSplitter::KDbImportSplitter(QIODevice *device, QChar delimiter)
+    : m_device(device)
+    , m_delimiter(QString(delimiter).toUtf8())
+{
+}
+
+bool KDbImportSplitter::read(int size, QByteArray *chunk, qint64 *firstLine)
+{
+    while (true) {
+        const char *data = m_buffer.constData();
+        const int bufferSize = m_buffer.size();
+        const int delimiterSize = m_delimiter.size();
+        const char delimiterEnd = m_delimiter.at(delimiterSize - 1);
+        for (; m_scanned < bufferSize && m_boundary < size; ++m_scanned) {
+            const char c = data[m_scanned];
+            if (c == '\n') {
+                ++m_lineFeeds;
+            }
+            switch (m_state) {
+            case State::Quoted:
+                if (c == '"') {
+                    m_state = State::QuotedQuote;
+                }
+                continue;
+            case State::QuotedQuote:
+                if (c == '"') { // escaped quote
+                    m_state = State::Quoted;
+                    continue;
+                }
+                break; // characters following the closing quote
+            case State::FieldStart:
+                if (c == '"') {
+                    m_state = State::Quoted;
+                    continue;
+                }
+                break;
+            case State::Unquoted:
+                break;
+            }
+            if (c == '\n') {
+                m_state = State::FieldStart;
+                m_boundary = m_scanned + 1;
+                m_boundaryLineFeeds = m_lineFeeds;
+            } else if (c == delimiterEnd && m_scanned >= delimiterSize - 1
+                       && qstrncmp(data + m_scanned - delimiterSize + 1, m_delimiter.constData(),
+                                   uint(delimiterSize)) == 0)
+            {
+                m_state = State::FieldStart;
+            } else {
+                m_state = State::Unquoted;
+            }
+        }
+        if (m_boundary > 0 && m_boundary >= size) {
+            break;
+        }
+        const QByteArray more = m_device->read(qMax(size, 64 * 1024));
+        if (!more.isEmpty()) {
+            m_bytesRead += more.size();
+            m_buffer.append(more);
+            continue;
+        }
+        if (m_device->isSequential() && m_device->waitForReadyRead(30000)) {
+            continue;
+        }
+        // end of the input, the last record has no line feed
+        if (m_buffer.isEmpty()) {
+            return false;
+        }
+        m_boundary = m_buffer.size();
+        m_boundaryLineFeeds = m_lineFeeds;
+        m_scanned = m_buffer.size();
+        m_state = State::FieldStart;
+        break;
+    }
+    *chunk = m_buffer.left(m_boundary);
+    m_buffer.remove(0, m_boundary);
+    *firstLine = m_line;
+    m_line += m_boundaryLineFeeds;
+    m_scanned -= m_boundary;
+    m_lineFeeds -= m_boundaryLineFeeds;
+    m_boundary = 0;
+    m_boundaryLineFeeds = 0;
+    return true;
+}
+
+//--------------------------------------
+
+KDbImportBatchQueue::KDbImportBatchQueue()
+{
+}
+
+KDbImportBatchQueue::~KDbImportBatchQueue()
+{
+    qDeleteAll(m_batches);
+}
+
+void KDbImportBatchQueue::put(int sequence, KDbImportBatch *batch)
+{
+    QMutexLocker locker(&m_mutex);
+    m_batches.insert(sequence, batch);
+    m_batchAdded.wakeAll();
+}
+
+KDbImportBatch* KDbImportBatchQueue::take(int sequence)
+{
+    QMutexLocker locker(&m_mutex);
+    while (!m_batches.contains(sequence)) {
+        m_batchAdded.wait(&m_mutex);
+    }
+    return m_batches.take(sequence);
+}
+
+//--------------------------------------
+
+namespace {
+
+//! Properties of a field receiving imported values, cached so parsing threads do not use the schema
+struct ImportColumn {
+    KDbField *field = nullptr;
+    KDbField::Type type = KDbField::InvalidType;
+    QString name;
+    int maxLength = 0;
+    bool required = false;
+};
+
+//! Data shared by parsing tasks
+struct ImportContext {
+    QVector<ImportColumn> columns;
+    QChar delimiter;
+    KDbImportBatchQueue queue;
+    QAtomicInt stop;
+};
+
+/*! Converts text of @a value to type of @a column. Integer and Boolean values are checked using
+ @a validator. @return false and sets @a errorMessage if the value is not acceptable. */
+bool convertValue(const ImportColumn &column, const QValidator *validator,
+                  const KDbCsvValue &value, QVariant *result, QString *errorMessage)
+{
+    const KDbField::Type type = column.type;
+    const bool textType = KDbField::isTextType(type);
+    const QString text = textType ? value.text : value.text.trimmed();
+    if (text.isEmpty() && !(textType && value.quoted)) {
+        if (column.required) {
+            *errorMessage = KDbConnection::tr("Value of field \"%1\" is required.").arg(column.name);
+            return false;
+        }
+        *result = QVariant();
+        return true;
+    }
+    if (textType) {
+        if (column.maxLength > 0 && text.length() > column.maxLength) {
+            *errorMessage = KDbConnection::tr("Value of field \"%1\" is longer than %2 characters.")
+                                .arg(column.name).arg(column.maxLength);
+            return false;
+        }
+        *result = text;
+        return true;
+    }
+    bool ok = true;
+    if (KDbField::isIntegerType(type) || type == KDbField::Boolean) {
+        QString number = text;
+        if (type == KDbField::Boolean) {
+            if (0 == number.compare(QLatin1String("true"), Qt::CaseInsensitive)) {
+                number = QLatin1String("1");
+            } else if (0 == number.compare(QLatin1String("false"), Qt::CaseInsensitive)) {
+                number = QLatin1String("0");
+            }
+        }
+        int pos = 0;
+        ok = !validator || validator->validate(number, pos) == QValidator::Acceptable;
+        if (ok) {
+            if (type == KDbField::Boolean) {
+                *result = QVariant(number == QLatin1String("1"));
+            } else if (type == KDbField::BigInteger && column.field->isUnsigned()) {
+                *result = number.toULongLong(&ok);
+            } else {
+                *result = number.toLongLong(&ok);
+            }
+        }
+    } else if (KDbField::isFPNumericType(type)) {
+        const double number = QLocale::c().toDouble(text, &ok);
+        ok = ok && qIsFinite(number);
+        *result = number;
+    } else if (type == KDbField::Date) {
+        const QDate date = QDate::fromString(text, Qt::ISODate);
+        ok = date.isValid();
+        *result = date;
+    } else if (type == KDbField::DateTime) {
+        const QDateTime dateTime = QDateTime::fromString(text, Qt::ISODate);
+        ok = dateTime.isValid();
+        *result = dateTime;
+    } else if (type == KDbField::Time) {
+        const QTime time = QTime::fromString(text, Qt::ISODate);
+        ok = time.isValid();
+        *result = time;
+    } else if (type == KDbField::BLOB) {
+        *result = QByteArray::fromBase64(text.toLatin1());
+    } else {
+        *result = text;
+    }
+    if (!ok) {
+        *errorMessage = KDbConnection::tr("Value \"%1\" is not valid for field \"%2\".")
+                            .arg(value.text, column.name);
+    }
+    return ok;
+}
+
+//! Parses a chunk of input to a batch of records
+class ParseTask : public QRunnable
+{
+public:
+    ParseTask(ImportContext *context, int sequence, const QByteArray &chunk, qint64 firstLine)
+        : m_context(context), m_sequence(sequence), m_chunk(chunk), m_firstLine(firstLine)
+    {
+    }
+
+    void run() override
+    {
+        const QVector<ImportColumn> &columns = m_context->columns;
+        const int columnCount = columns.count();
+        QScopedPointer<KDbImportBatch> batch(new KDbImportBatch(columnCount));
+        if (m_context->stop.load()) {
+            m_context->queue.put(m_sequence, batch.take());
+            return;
+        }
+        // Validators are QObjects so they are created in the parsing thread
+        QVector<QValidator*> validators(columnCount);
+        for (int i = 0; i < columnCount; ++i) {
+            const KDbField::Type type = columns[i].type;
+            if (KDbField::isIntegerType(type) || type == KDbField::Boolean) {
+                validators[i] = new KDbFieldValidator(*columns[i].field);
+            }
+        }
+        KDbCsvParser parser(QString::fromUtf8(m_chunk), m_context->delimiter, m_firstLine);
+        QVector<KDbCsvValue> values;
+        QVector<QVariant> record(columnCount);
+        qint64 line;
+        QString text;
+        bool ok;
+        while (parser.next(&values, &line, &text, &ok)) {
+            KDbImportError error;
+            if (!ok) {
+                error.message = KDbConnection::tr("Quoted value is not terminated.");
+            } else if (values.count() != columnCount) {
+                error.message = KDbConnection::tr("Expected %1 values, found %2.")
+                                    .arg(columnCount).arg(values.count());
+            } else {
+                for (int i = 0; i < columnCount; ++i) {
+                    if (!convertValue(columns[i], validators[i], values[i], &record[i],
+                                      &error.message))
+                    {
+                        error.column = i;
+                        break;
+                    }
+                }
+            }
+            if (!error.message.isEmpty()) {
+                error.line = line;
+                error.record = text;
+                batch->errors.append(error);
+                continue;
+            }
+            for (int i = 0; i < columnCount; ++i) {
+                batch->columns[i].append(record[i]);
+            }
+            ++batch->recordCount;
+        }
+        qDeleteAll(validators);
+        m_context->queue.put(m_sequence, batch.take());
+    }
+
+private:
+    ImportContext * const m_context;
+    const int m_sequence;
+    const QByteArray m_chunk;
+    const qint64 m_firstLine;
+};
+} // namespace
+
+tristate kdbImportData(KDbConnection *conn, QIODevice *device, KDbTableSchema *table,
+                       const KDbImportOptions &options, KDbImportProgressHandler *handler,
+                       KDbResult *result)
+{
+    if (!device || !device->isReadable()) {
+        *result = KDbResult(ERR_OTHER, KDbConnection::tr("Device for importing data is not readable."));
+        return false;
+    }
+    if (!table) {
+        *result = KDbResult(ERR_OTHER, KDbConnection::tr("No table specified for importing data."));
+        return false;
+    }
+    KDbImportSplitter splitter(device, options.delimiter());
+    QByteArray chunk;
+    qint64 firstLine;
+    QList<int> fieldIndexes;
+    if (options.hasHeader()) {
+        if (!splitter.read(1, &chunk, &firstLine)) {
+            return true; // no data
+        }
+        KDbCsvParser parser(QString::fromUtf8(chunk), options.delimiter(), firstLine);
+        QVector<KDbCsvValue> names;
+        qint64 line;
+        QString text;
+        bool ok;
+        if (!parser.next(&names, &line, &text, &ok)) {
+            return true; // no data
+        }
+        for (const KDbCsvValue &name : names) {
+            const KDbField *field = table->field(name.text.trimmed());
+            const int index = field ? table->indexOf(*field) : -1;
+            if (index < 0) {
+                *result = KDbResult(ERR_OBJECT_NOT_FOUND,
+                                    KDbConnection::tr("Field \"%1\" does not exist in table \"%2\".")
+                                        .arg(name.text, table->name()));
+                return false;
+            }
+            if (fieldIndexes.contains(index)) {
+                *result = KDbResult(ERR_OTHER,
+                                    KDbConnection::tr("Field \"%1\" is specified more than once.")
+                                        .arg(name.text));
+                return false;
+            }
+            fieldIndexes.append(index);
+        }
+    } else {
+        for (int i = 0; i < table->fieldCount(); ++i) {
+            fieldIndexes.append(i);
+        }
+    }
+    const QScopedPointer<KDbFieldList> fields(table->subList(fieldIndexes));
+    if (!fields || fields->isEmpty()) {
+        *result = KDbResult(ERR_OTHER, KDbConnection::tr("No fields to import data to."));
+        return false;
+    }
+    ImportContext context;
+    context.delimiter = options.delimiter();
+    for (KDbField *field : *fields->fields()) {
+        ImportColumn column;
+        column.field = field;
+        column.type = field->type();
+        column.name = field->name();
+        column.maxLength = field->type() == KDbField::Text ? field->maxLength() : 0;
+        column.required = field->isNotNull() && !field->isAutoIncrement();
+        context.columns.append(column);
+    }
+
+    KDbTransactionGuard tg;
+    if (!conn->beginAutoCommitTransaction(&tg)) {
+        *result = conn->result();
+        return false;
+    }
+    const int threadCount = options.threadCount() > 0 ? options.threadCount()
+                                                      : qMax(1, QThread::idealThreadCount());
+    const int maxPendingChunks = threadCount * 2;
+    const int chunkSize = qMax(1, options.chunkSize());
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+    int submitted = 0;
+    int processed = 0;
+    bool end = false;
+    qint64 records = 0;
+    qint64 errors = 0;
+    tristate res = true;
+    while (true) {
+        while (!end && submitted - processed < maxPendingChunks) {
+            if (splitter.read(chunkSize, &chunk, &firstLine)) {
+                pool.start(new ParseTask(&context, submitted++, chunk, firstLine));
+            } else {
+                end = true;
+            }
+        }
+        if (processed == submitted) {
+            break;
+        }
+        const QScopedPointer<KDbImportBatch> batch(context.queue.take(processed++));
+        for (const KDbImportError &error : batch->errors) {
+            ++errors;
+            if (handler) {
+                handler->importError(error);
+            }
+            if (options.maxErrors() >= 0 && errors > options.maxErrors()) {
+                *result = KDbResult(ERR_OTHER,
+                                    KDbConnection::tr("Record at line %1 has been rejected. %2")
+                                        .arg(error.line).arg(error.message));
+                res = false;
+                break;
+            }
+        }
+        if (res != true) {
+            break;
+        }
+        if (batch->recordCount > 0) {
+            if (!conn->drv_insertBatch(fields.data(), *batch)) {
+                *result = conn->result();
+                res = false;
+                break;
+            }
+            // drivers can insert using native bulk statements not seen by the connection
+            conn->d->tableModified(table->name());
+            records += batch->recordCount;
+        }
+        if (handler && !handler->importProgress(records, splitter.bytesRead())) {
+            res = cancelled;
+            break;
+        }
+    }
+    context.stop.store(1);
+    pool.waitForDone();
+    if (res == true && !conn->commitAutoCommitTransaction(tg.transaction())) {
+        *result = conn->result();
+        return false;
+    }
+    return res; // the guard rolls back the transaction on failure
+}
+
+//--------------------------------------
+
+KDbTableSchema* KDb::inferImportTableSchema(QIODevice *device, const QString &tableName,
+                                            const KDbImportOptions &options)
+{
+    if (!device || !device->isReadable()) {
+        return nullptr;
+    }
+    // Collect complete records from the beginning of the input without consuming it
+    const QByteArray sample = device->peek(qMax(1, options.chunkSize()));
+    KDbCsvParser parser(QString::fromUtf8(sample), options.delimiter(), 1);
+    QVector<KDbCsvValue> values;
+    qint64 line;
+    QString text;
+    bool ok;
+    QStringList names;
+    if (options.hasHeader()) {
+        if (!parser.next(&values, &line, &text, &ok) || !ok) {
+            return nullptr;
+        }
+        for (const KDbCsvValue &value : values) {
+            names.append(value.text.trimmed());
+        }
+    }
+    //! Types that are still possible for a column
+    struct Candidates {
+        bool boolean = true;
+        bool integer = true;
+        bool bigInteger = true;
+        bool number = true;
+        bool date = true;
+        bool dateTime = true;
+        bool time = true;
+        int maxLength = 0;
+    };
+    QVector<Candidates> columns(names.count());
+    const int sampleSize = qMax(1, options.sampleSize());
+    const bool complete = sample.size() < options.chunkSize();
+    for (int count = 0; count < sampleSize && parser.next(&values, &line, &text, &ok);) {
+        if (!ok || (!complete && parser.atEnd())) {
+            break; // the last record may be truncated
+        }
+        if (columns.count() < values.count()) {
+            columns.resize(values.count());
+        }
+        for (int i = 0; i < values.count(); ++i) {
+            Candidates &c = columns[i];
+            const QString value = values[i].text.trimmed();
+            c.maxLength = qMax(c.maxLength, values[i].text.length());
+            if (value.isEmpty()) {
+                continue;
+            }
+            c.boolean = c.boolean && (0 == value.compare(QLatin1String("true"), Qt::CaseInsensitive)
+                                   || 0 == value.compare(QLatin1String("false"), Qt::CaseInsensitive));
+            bool numberOk;
+            if (c.integer || c.bigInteger) {
+                const qlonglong integer = value.toLongLong(&numberOk);
+                c.bigInteger = c.bigInteger && numberOk;
+                c.integer = c.integer && numberOk && integer >= std::numeric_limits<qint32>::min()
+                        && integer <= std::numeric_limits<qint32>::max();
+            }
+            if (c.number) {
+                c.number = qIsFinite(QLocale::c().toDouble(value, &numberOk)) && numberOk;
+            }
+            c.date = c.date && QDate::fromString(value, Qt::ISODate).isValid();
+            c.dateTime = c.dateTime && value.contains(QLatin1Char('T'))
+                    && QDateTime::fromString(value, Qt::ISODate).isValid();
+            c.time = c.time && QTime::fromString(value, Qt::ISODate).isValid();
+        }
+        ++count;
+    }
+    if (columns.isEmpty()) {
+        return nullptr;
+    }
+    KDbTableSchema *table = new KDbTableSchema(tableName);
+    QSet<QString> usedNames;
+    for (int i = 0; i < columns.count(); ++i) {
+        const Candidates &c = columns[i];
+        QString name = KDb::stringToIdentifier(names.value(i));
+        if (name.isEmpty() || name == QLatin1String("_")) {
+            name = QString::fromLatin1("column%1").arg(i + 1);
+        }
+        const QString baseName = name;
+        for (int suffix = 2; usedNames.contains(name.toLower()); ++suffix) {
+            name = baseName + QString::number(suffix);
+        }
+        usedNames.insert(name.toLower());
+        KDbField::Type type;
+        if (c.maxLength == 0) {
+            type = KDbField::Text;
+        } else if (c.boolean) {
+            type = KDbField::Boolean;
+        } else if (c.integer) {
+            type = KDbField::Integer;
+        } else if (c.bigInteger) {
+            type = KDbField::BigInteger;
+        } else if (c.number) {
+            type = KDbField::Double;
+        } else if (c.date) {
+            type = KDbField::Date;
+        } else if (c.dateTime) {
+            type = KDbField::DateTime;
+        } else if (c.time) {
+            type = KDbField::Time;
+        } else if (c.maxLength <= KDbField::defaultMaxLength()) {
+            type = KDbField::Text;
+        } else {
+            type = KDbField::LongText;
+        }
+        KDbField *field = new KDbField(name, type);
+        field->setCaption(names.value(i));
+        if (!table->addField(field)) {
+            delete field;
+            delete table;
+            return nullptr;
+        }
+    }
+    return table;
+}
@@ -0,0 +1,88 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_DATAIMPORT_H
+#define KDB_DATAIMPORT_H
+
+#include "KDbImportOptions.h"
+
+#include <QString>
+
+class KDbTableSchema;
+class QIODevice;
+
+/*! @brief Record rejected by KDbConnection::importData()
+ @since 3.3
+*/
+class KDB_EXPORT KDbImportError
+{
+public:
+    KDbImportError();
+
+    qint64 line = 0;   //!< number of the first line of the record in the input, counted from 1
+    int column = -1;   //!< index of the rejected column or -1 if the whole record is rejected
+    QString message;   //!< reason of the rejection
+    QString record;    //!< text of the rejected record
+};
+
+/*! @brief Interface for receiving progress of KDbConnection::importData()
+
+ Methods are called in the thread that called KDbConnection::importData().
+ @since 3.3
+*/
+class KDB_EXPORT KDbImportProgressHandler
+{
+public:
+    KDbImportProgressHandler();
+
+    virtual ~KDbImportProgressHandler();
+
+    /*! Called each time a batch of records has been inserted, @a records records
+     have been inserted and @a bytes bytes of input have been read so far.
+     @return false to cancel the import. */
+    virtual bool importProgress(qint64 records, qint64 bytes) = 0;
+
+    /*! Called for each rejected record, in order of records.
+     The default implementation does nothing. */
+    virtual void importError(const KDbImportError &error);
+
+private:
+    Q_DISABLE_COPY(KDbImportProgressHandler)
+};
+
+namespace KDb
+{
+
+/*! @return new table schema named @a tableName with fields suitable for data
+ available in @a device in format accepted by KDbConnection::importData().
+
+ Up to KDbImportOptions::sampleSize() records are examined, data is only peeked so it is still
+ available for importing. The narrowest type matching all non-empty values of a column is
+ selected, in order: Boolean (values "true" or "false"), Integer, BigInteger, Double,
+ Date, DateTime, Time, Text and LongText (for values longer than KDbField::defaultMaxLength()).
+ Names of fields are created from the header using KDb::stringToIdentifier() or are
+ "column1", "column2"... if there is no header. Returns @c nullptr if there is no data.
+
+ The schema is not created in the database, use KDbConnection::createTable() for that.
+ @since 3.3 */
+KDB_EXPORT KDbTableSchema* inferImportTableSchema(QIODevice *device, const QString &tableName,
+                                                  const KDbImportOptions &options = KDbImportOptions());
+}
+
+#endif
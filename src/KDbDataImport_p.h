@@ -0,0 +1,140 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_DATAIMPORT_P_H
+#define KDB_DATAIMPORT_P_H
+
+#include "KDbDataImport.h"
+#include "KDbField.h"
+#include "KDbTristate.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QVariant>
+#include <QVector>
+#include <QWaitCondition>
+
+class KDbConnection;
+class KDbResult;
+
+//! @internal Values of a batch of parsed records, stored by columns
+class KDbImportBatch
+{
+public:
+    explicit KDbImportBatch(int columnCount);
+
+    int recordCount = 0;
+    QVector<QVector<QVariant>> columns;
+    QList<KDbImportError> errors; //!< rejected records, not included in columns
+};
+
+//! @internal A value of CSV record
+struct KDbCsvValue {
+    QString text;
+    bool quoted = false;
+};
+
+//! @internal Parser of CSV records, see KDbImportOptions for the accepted format
+class KDbCsvParser
+{
+public:
+    KDbCsvParser(const QString &data, QChar delimiter, qint64 firstLine);
+
+    /*! Parses next record to @a values.
+     @a line is set to number of the first line of the record, @a record to the record's text.
+     @return false if there are no more records or true if record has been parsed.
+     @a ok is set to false if the record has unterminated quoted value. */
+    bool next(QVector<KDbCsvValue> *values, qint64 *line, QString *record, bool *ok);
+
+    //! @return true if all the data has been parsed
+    bool atEnd() const { return m_pos >= m_data.size(); }
+
+private:
+    const QString m_data;
+    const QChar m_delimiter;
+    int m_pos = 0;
+    qint64 m_line;
+};
+
+/*! @internal Reads input in chunks of complete records.
+ Only quotes, delimiters and line feeds are examined, so UTF-8 encoded chunks can be split
+ without decoding. Like in KDbCsvParser, a quote only starts a quoted value at the start
+ of a field; other quotes are part of values. */
+class KDbImportSplitter
+{
+public:
+    //! Creates splitter for @a device with records having fields separated by @a delimiter
+    KDbImportSplitter(QIODevice *device, QChar delimiter);
+
+    /*! Reads complete records of at least @a size bytes (unless the input ends) to @a chunk.
+     @a firstLine is set to number of the first line of the chunk.
+     @return false at the end of the input. */
+    bool read(int size, QByteArray *chunk, qint64 *firstLine);
+
+    //! @return number of bytes read from the device so far
+    qint64 bytesRead() const { return m_bytesRead; }
+
+private:
+    //! State of scanning of the current field
+    enum class State {
+        FieldStart,  //!< at start of a field
+        Unquoted,    //!< in an unquoted value or after closing quote of a quoted value
+        Quoted,      //!< in a quoted value
+        QuotedQuote  //!< after a quote in a quoted value, it is closing or escaped quote
+    };
+
+    QIODevice * const m_device;
+    const QByteArray m_delimiter; //!< UTF-8 encoded delimiter
+    QByteArray m_buffer;
+    int m_scanned = 0;      //!< number of examined bytes of the buffer
+    State m_state = State::FieldStart;
+    int m_boundary = 0;     //!< position after the last line feed ending a record
+    int m_lineFeeds = 0;    //!< number of line feeds in the examined part
+    int m_boundaryLineFeeds = 0; //!< number of line feeds before m_boundary
+    qint64 m_line = 1;      //!< number of the first line of the buffer
+    qint64 m_bytesRead = 0;
+};
+
+//! @internal Parsed batches ordered by sequence numbers of chunks
+class KDbImportBatchQueue
+{
+public:
+    KDbImportBatchQueue();
+
+    ~KDbImportBatchQueue();
+
+    //! Adds @a batch parsed from chunk number @a sequence, ownership is passed to the queue
+    void put(int sequence, KDbImportBatch *batch);
+
+    //! Waits for batch parsed from chunk number @a sequence, ownership is passed to the caller
+    KDbImportBatch* take(int sequence);
+
+private:
+    QMutex m_mutex;
+    QWaitCondition m_batchAdded;
+    QHash<int, KDbImportBatch*> m_batches;
+    Q_DISABLE_COPY(KDbImportBatchQueue)
+};
+
+//! @internal Implementation of KDbConnection::importData()
+tristate kdbImportData(KDbConnection *conn, QIODevice *device, KDbTableSchema *table,
+                       const KDbImportOptions &options, KDbImportProgressHandler *handler,
+                       KDbResult *result);
+
+#endif
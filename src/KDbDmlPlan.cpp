@@ -0,0 +1,154 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbDmlPlan_p.h"
+#include "KDbStatementBuffer_p.h"
+
+KDbDmlPlan::KDbDmlPlan(Type type, const KDbQuerySchema *query, bool useRecordId,
+                       const QVector<KDbQueryColumnInfo*> &columns)
+    : type(type)
+    , query(query)
+    , useRecordId(useRecordId)
+    , columns(columns)
+{
+}
+
+KDbDmlPlan::~KDbDmlPlan()
+{
+}
+
+//! Moves contents of @a sql to a new segment of @a segments
+static void takeSegment(KDbStatementBuffer *sql, QVector<KDbEscapedString> *segments)
+{
+    KDbEscapedString segment(sql->statement());
+    sql->clear();
+    segment.squeeze(); // plans are long-lived
+    segments->append(segment);
+}
+
+void KDbDmlPlan::addValue(KDbStatementBuffer *sql, KDbField::Type type, KDbQueryColumnInfo *column)
+{
+    Q_ASSERT(keyFields.isEmpty());
+    takeSegment(sql, &segments);
+    valueTypes.append(type);
+    valueColumns.append(column);
+}
+
+void KDbDmlPlan::addKey(KDbStatementBuffer *sql, KDbField *field, int position)
+{
+    takeSegment(sql, &segments);
+    valueTypes.append(field ? field->type() : KDbField::BigInteger);
+    keyFields.append(field);
+    keyPositions.append(field ? position : -1);
+}
+
+void KDbDmlPlan::finish(KDbStatementBuffer *sql)
+{
+    takeSegment(sql, &segments);
+}
+
+void KDbDmlPlan::render(KDbStatementBuffer *sql, const QVector<QVariant> &values) const
+{
+    Q_ASSERT(values.count() == valueTypes.count());
+    Q_ASSERT(segments.count() == valueTypes.count() + 1);
+    sql->clear();
+    for (int i = 0; i < valueTypes.count(); ++i) {
+        sql->append(segments.at(i)).appendValue(valueTypes.at(i), values.at(i));
+    }
+    sql->append(segments.last());
+}
+
+//================================================
+
+KDbDmlPlanCache::KDbDmlPlanCache()
+{
+}
+
+KDbDmlPlanCache::~KDbDmlPlanCache()
+{
+    clear();
+}
+
+KDbDmlPlan* KDbDmlPlanCache::find(const KDbQuerySchema *query, KDbDmlPlan::Type type,
+                                  bool useRecordId,
+                                  const QVector<KDbQueryColumnInfo*> &columns) const
+{
+    const auto it = m_plans.constFind(query);
+    if (it == m_plans.constEnd()) {
+        return nullptr;
+    }
+    for (KDbDmlPlan *plan : it.value()) {
+        if (plan->matches(type, useRecordId, columns)) {
+            return plan;
+        }
+    }
+    return nullptr;
+}
+
+void KDbDmlPlanCache::insert(KDbDmlPlan *plan)
+{
+    Q_ASSERT(plan);
+    QList<KDbDmlPlan*> &plans = m_plans[plan->query];
+    plans.append(plan);
+    if (plans.count() > maxPlansPerQuery) {
+        delete plans.takeFirst();
+    }
+}
+
+void KDbDmlPlanCache::removeQuery(const KDbQuerySchema *query)
+{
+    qDeleteAll(m_plans.take(query));
+}
+
+void KDbDmlPlanCache::removeTable(const KDbTableSchema *table)
+{
+    for (auto it = m_plans.begin(); it != m_plans.end();) {
+        QList<KDbDmlPlan*> &plans = it.value();
+        for (auto planIt = plans.begin(); planIt != plans.end();) {
+            if ((*planIt)->masterTable == table) {
+                delete *planIt;
+                planIt = plans.erase(planIt);
+            } else {
+                ++planIt;
+            }
+        }
+        if (plans.isEmpty()) {
+            it = m_plans.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void KDbDmlPlanCache::clear()
+{
+    for (const QList<KDbDmlPlan*> &plans : qAsConst(m_plans)) {
+        qDeleteAll(plans);
+    }
+    m_plans.clear();
+}
+
+int KDbDmlPlanCache::count() const
+{
+    int result = 0;
+    for (const QList<KDbDmlPlan*> &plans : m_plans) {
+        result += plans.count();
+    }
+    return result;
+}
@@ -0,0 +1,137 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_DMLPLAN_P_H
+#define KDB_DMLPLAN_P_H
+
+#include "KDbEscapedString.h"
+#include "KDbField.h"
+#include "KDbFieldList.h"
+
+#include <QHash>
+#include <QVector>
+
+class KDbQueryColumnInfo;
+class KDbQuerySchema;
+class KDbStatementBuffer;
+class KDbTableSchema;
+
+/*! @internal Compiled data modification statement used by KDbConnection::updateRecord(),
+ KDbConnection::insertRecord() and KDbConnection::deleteRecord().
+
+ A plan is built for a query schema and a set of edited columns. It keeps the master table,
+ positions of primary key values in record data and text of the statement with escaped
+ identifiers, split around values. Only values have to be converted for a next statement. */
+class KDbDmlPlan
+{
+public:
+    enum class Type {
+        Update,
+        Insert,
+        Delete
+    };
+
+    KDbDmlPlan(Type type, const KDbQuerySchema *query, bool useRecordId,
+               const QVector<KDbQueryColumnInfo*> &columns);
+
+    ~KDbDmlPlan();
+
+    //! @return true if the plan has been built for @a type, @a useRecordId and @a columns
+    inline bool matches(Type type, bool useRecordId,
+                        const QVector<KDbQueryColumnInfo*> &columns) const
+    {
+        return this->type == type && this->useRecordId == useRecordId && this->columns == columns;
+    }
+
+    //! Ends a segment of statement text with contents of @a sql and adds slot for a value
+    //! of type @a type taken from @a column. Null value is used if @a column is @c nullptr.
+    void addValue(KDbStatementBuffer *sql, KDbField::Type type, KDbQueryColumnInfo *column);
+
+    //! Ends a segment of statement text with contents of @a sql and adds slot for value
+    //! of key field @a field taken from position @a position of record data.
+    //! If @a field is @c nullptr, the record identifier (the last item) is used.
+    void addKey(KDbStatementBuffer *sql, KDbField *field, int position);
+
+    //! Ends the statement text with contents of @a sql
+    void finish(KDbStatementBuffer *sql);
+
+    //! Writes statement for @a values to @a sql. There is one value for each slot,
+    //! values of edited columns first.
+    void render(KDbStatementBuffer *sql, const QVector<QVariant> &values) const;
+
+    const Type type;
+    const KDbQuerySchema * const query;
+    const bool useRecordId; //!< record identifier is used instead of primary key (Insert: is retrieved)
+    const QVector<KDbQueryColumnInfo*> columns; //!< edited columns, sorted
+
+    KDbTableSchema *masterTable = nullptr;
+    QVector<KDbField::Type> valueTypes; //!< types of values of all slots
+    QVector<KDbQueryColumnInfo*> valueColumns; //!< columns providing values of edited columns
+    QVector<KDbField*> keyFields; //!< fields of keys, @c nullptr for record identifier
+    QVector<int> keyPositions; //!< positions of key values in record data, -1 for the last item
+    QVector<KDbEscapedString> segments; //!< statement text around values
+    KDbFieldList affectedFields; //!< fields modified by the statement, not owned
+    QHash<KDbQueryColumnInfo*, int> columnsOrderExpanded; //!< positions of columns in record data
+    QVector<KDbQueryColumnInfo*> defaultColumns; //!< Insert: columns set to default values
+    int fieldsExpandedCount = 0; //!< Insert: number of unique expanded columns of the query
+    KDbEscapedString autoIncrementSql; //!< Insert: SELECT for autoincremented values, without key
+
+private:
+    Q_DISABLE_COPY(KDbDmlPlan)
+};
+
+/*! @internal Cache of data modification plans of a connection.
+ Plans of a query are removed when cached data of the query is cleared, plans of a table
+ are removed when the table is altered, renamed or dropped. */
+class KDbDmlPlanCache
+{
+public:
+    KDbDmlPlanCache();
+
+    ~KDbDmlPlanCache();
+
+    //! @return plan of @a query for @a type, @a useRecordId and @a columns or @c nullptr
+    KDbDmlPlan* find(const KDbQuerySchema *query, KDbDmlPlan::Type type, bool useRecordId,
+                     const QVector<KDbQueryColumnInfo*> &columns) const;
+
+    //! Inserts @a plan, ownership is transferred. The least recently inserted plan
+    //! of the query is removed if there are more than maxPlansPerQuery plans.
+    void insert(KDbDmlPlan *plan);
+
+    //! Removes plans of @a query
+    void removeQuery(const KDbQuerySchema *query);
+
+    //! Removes plans having @a table as master table
+    void removeTable(const KDbTableSchema *table);
+
+    //! Removes all plans
+    void clear();
+
+    //! @return number of cached plans
+    int count() const;
+
+    //! Maximum number of plans for a single query
+    static const int maxPlansPerQuery = 16;
+
+private:
+    QHash<const KDbQuerySchema*, QList<KDbDmlPlan*>> m_plans;
+    Q_DISABLE_COPY(KDbDmlPlanCache)
+};
+
+#endif
@@ -27,7 +27,9 @@
 #include "KDbDriver_p.h"
 #include "KDbDriverBehavior.h"
 #include "KDbError.h"
+#include "KDbEscaping_p.h"
 #include "KDbExpression.h"
+#include "KDbKeywordTable_p.h"
 #include "kdb_debug.h"
 
 #include <algorithm>
@@ -196,7 +198,7 @@ KDbEscapedString valueToSqlInternal(const KDbDriver *driver, KDbField::Type ftyp
     case KDbField::Text:
     case KDbField::LongText: {
         return driver ? driver->escapeString(v.toString())
-                      : KDbEscapedString(KDb::escapeString(v.toString()));
+                      : kdbEscapeString(v.toString(), kdbSqlStringEscapingRules());
     }
     case KDbField::Byte:
     case KDbField::ShortInteger:
@@ -230,10 +232,10 @@ KDbEscapedString valueToSqlInternal(const KDbDriver *driver, KDbField::Type ftyp
         }
         if (v.type() == QVariant::String) {
             return driver ? driver->escapeBLOB(v.toString().toUtf8())
-                          : KDbEscapedString(KDb::escapeBLOB(v.toString().toUtf8(), KDb::BLOBEscapingType::ZeroXHex));
+                          : kdbEscapeBLOB(v.toString().toUtf8(), KDb::BLOBEscapingType::ZeroXHex);
         }
         return driver ? driver->escapeBLOB(v.toByteArray())
-                      : KDbEscapedString(KDb::escapeBLOB(v.toByteArray(), KDb::BLOBEscapingType::ZeroXHex));
+                      : kdbEscapeBLOB(v.toByteArray(), KDb::BLOBEscapingType::ZeroXHex);
     }
     case KDbField::InvalidType:
         return KDbEscapedString("!INVALIDTYPE!");
@@ -300,6 +302,11 @@ void KDbDriver::initDriverSpecificKeywords(const char* const* keywords)
     d->driverSpecificSqlKeywords.setStrings(keywords);
 }
 
+void KDbDriver::initDriverSpecificKeywords(const KDbKeywordTable *table)
+{
+    d->driverSpecificKeywordTable = table;
+}
+
 KDbEscapedString KDbDriver::addLimitTo1(const KDbEscapedString& sql, bool add)
 {
     return add ? (sql + " LIMIT 1") : sql;
@@ -307,6 +314,9 @@ KDbEscapedString KDbDriver::addLimitTo1(const KDbEscapedString& sql, bool add)
 
 bool KDbDriver::isDriverSpecificKeyword(const QByteArray& word) const
 {
+    if (d->driverSpecificKeywordTable) {
+        return d->driverSpecificKeywordTable->contains(word);
+    }
     return d->driverSpecificSqlKeywords.contains(word);
 }
 
@@ -379,6 +389,13 @@ KDbEscapedString KDbDriver::ceilingOrFloorFunctionToString(
     return KDbFunctionExpression::toString(name, this, args, params, callStack);
 }
 
+KDbEscapedString KDbDriver::typeConversionToString(const KDbEscapedString &expression,
+                                                   const KDbField &field) const
+{
+    Q_UNUSED(field);
+    return expression;
+}
+
 KDbEscapedString KDbDriver::unicodeFunctionToString(
                                         const KDbNArgExpression &args,
                                         KDbQuerySchemaParameterValueListIterator* params,
@@ -397,14 +414,9 @@ KDbEscapedString KDbDriver::concatenateFunctionToString(const KDbBinaryExpressio
 
 //---------------
 
-Q_GLOBAL_STATIC_WITH_ARGS(
-    KDbUtils::StaticSetOfStrings,
-    KDb_kdbSqlKeywords,
-    (KDbDriverPrivate::kdbSQLKeywords) )
-
 KDB_EXPORT bool KDb::isKDbSqlKeyword(const QByteArray& word)
 {
-    return KDb_kdbSqlKeywords->contains(word.toUpper());
+    return KDbDriverPrivate::kdbSQLKeywords.contains(word, Qt::CaseInsensitive);
 }
 
 KDB_EXPORT QString KDb::escapeIdentifier(const KDbDriver* driver,
@@ -37,6 +37,7 @@ class KDbBinaryExpression;
 class KDbNArgExpression;
 class KDbQuerySchemaParameterValueListIterator;
 class KDbDriverPrivate;
+struct KDbKeywordTable;
 
 #define KDB_DRIVER_PLUGIN_FACTORY(class_name, name) \
     K_PLUGIN_FACTORY_WITH_JSON(class_name ## Factory, name, registerPlugin<class_name>();)
@@ -313,6 +314,15 @@ public:
                                             KDbQuerySchemaParameterValueListIterator* params,
                                             KDb::ExpressionCallStack* callStack) const;
 
+    //! Generates native (driver-specific) conversion of value of SQL expression @a expression
+    //! to type of field @a field, used when values are copied between fields of different types.
+    //! Default implementation returns @a expression, leaving conversion to the database
+    //! which works for SQLite and MySQL.
+    //! Special case is for PostgreSQL (CAST()).
+    //! @since 3.3
+    virtual KDbEscapedString typeConversionToString(const KDbEscapedString &expression,
+                                                    const KDbField &field) const;
+
     //! Generates native (driver-specific) function call for concatenation of two strings.
     //! Default implementation USES infix "||" operator.
     //! Special case is for MYSQL (CONCAT()).
@@ -395,6 +405,13 @@ protected:
       @a keywords should be 0-terminated array of null-terminated strings. */
     void initDriverSpecificKeywords(const char* const* keywords);
 
+    /*! @overload
+      Used to initialise driver-specific keywords using a perfect hash table @a table
+      generated by tools/sql_keywords.sh. The table is not copied, so it should be static.
+      Lookup in the table does not need any memory allocation.
+      @since 3.3 */
+    void initDriverSpecificKeywords(const KDbKeywordTable *table);
+
     /*! @return SQL statement @a sql modified by appending a "LIMIT 1" clause,
      (if possible and if @a add is @c true). Used for optimization for the server side.
      Can be reimplemented for other drivers. */
@@ -191,6 +191,13 @@ public:
      Used in KDbConnection::resultExists() for optimization. It's set to true for SQLite driver. */
     bool SELECT_1_SUBQUERY_SUPPORTED;
 
+    /*! True if a failed statement makes the current transaction unusable so the transaction
+     can be only rolled back. This is the case for PostgreSQL. False by default.
+     Used by KDbConnection to isolate writes grouped in a batch using savepoints,
+     see KDbConnection::setWriteBatchingEnabled().
+     @since 3.3 */
+    bool FAILED_STATEMENT_ABORTS_TRANSACTION;
+
     /*! Literal for boolean true. "1" by default
         which is typically expected by backends even while the standard says "TRUE":
         https://troels.arvin.dk/db/rdbms/#data_types-boolean
@@ -56,6 +56,7 @@ void DriverManagerInternal::clear()
     m_drivers.clear();
     qDeleteAll(m_driversMetaData);
     m_driversMetaData.clear();
+    m_staticDriverInstances.clear();
 }
 
 void DriverManagerInternal::slotAppQuits()
@@ -99,15 +100,15 @@ void DriverManagerInternal::lookupDriversInternal()
     clearResult();
 
     //drivermanagerDebug() << "Load all plugins";
-    QList<QPluginLoader*> offers
-            = KDbJsonTrader::self()->query(QLatin1String("KDb/Driver"));
+    const QList<KDbJsonTrader::Plugin> offers
+            = KDbJsonTrader::self()->plugins(QLatin1String("KDb/Driver"));
     const QString expectedVersion = QString::fromLatin1("%1.%2")
             .arg(KDB_STABLE_VERSION_MAJOR).arg(KDB_STABLE_VERSION_MINOR);
     QMimeDatabase mimedb;
-    foreach(const QPluginLoader *loader, offers) {
-        //QJsonObject json = loader->metaData();
-        //drivermanagerDebug() << json;
-        QScopedPointer<KDbDriverMetaData> metaData(new KDbDriverMetaData(*loader));
+    for (const KDbJsonTrader::Plugin &offer : offers) {
+        //drivermanagerDebug() << offer.metaData;
+        QScopedPointer<KDbDriverMetaData> metaData(
+            new KDbDriverMetaData(offer.metaData, offer.fileName));
         //qDebug() << "VER:" << metaData->version();
         if (metaData->version() != expectedVersion) {
             kdbWarning() << "Driver with ID" << metaData->id()
@@ -139,11 +140,12 @@ void DriverManagerInternal::lookupDriversInternal()
         for (const QString &mimeType : resolvedMimeTypes) {
             m_metadata_by_mimetype.insertMulti(mimeType, metaData.data());
         }
+        if (offer.staticInstance) {
+            m_staticDriverInstances.insert(metaData->id(), offer.staticInstance);
+        }
         m_driversMetaData.insert(metaData->id(), metaData.data());
         metaData.take();
     }
-    qDeleteAll(offers);
-    offers.clear();
 }
 
 QStringList DriverManagerInternal::driverIds()
@@ -215,7 +217,16 @@ KDbDriver* DriverManagerInternal::driver(const QString& id)
     }
 
     const KDbDriverMetaData *metaData = m_driversMetaData.value(id.toLower());
-    KPluginFactory *factory = qobject_cast<KPluginFactory*>(metaData->instantiate());
+    const QtPluginInstanceFunction staticInstance = m_staticDriverInstances.value(metaData->id());
+    KPluginFactory *factory = qobject_cast<KPluginFactory*>(
+        staticInstance ? staticInstance() : metaData->instantiate());
+    if (!factory && staticInstance) {
+        m_result = KDbResult(ERR_DRIVERMANAGER,
+                             tr("Could not load static database driver \"%1\".")
+                                .arg(metaData->id()));
+        kdbWarning() << m_result.message();
+        return nullptr;
+    }
     if (!factory) {
         m_result = KDbResult(ERR_DRIVERMANAGER,
                              tr("Could not load database driver's plugin file \"%1\".")
@@ -34,6 +34,16 @@ class KDbDriver;
 class KDbDriverMetaData;
 
 //! A driver manager for finding and loading driver plugins.
+/*! Metadata of driver plugins is cached in index files stored in the "kdb3" subdirectory
+ of the generic cache location (see QStandardPaths::GenericCacheLocation), one per plugin
+ path. Plugin files are only opened to read the metadata if modification time of the plugin
+ path, any of its subdirectories or plugin files has changed. The index can be disabled
+ by setting a KDB_NO_PLUGIN_INDEX environment variable.
+
+ If KDb is built with the KDB_STATIC_DRIVERS option, drivers are static libraries that
+ applications link to and register using Q_IMPORT_PLUGIN(), e.g.
+ Q_IMPORT_PLUGIN(SqliteDriverFactory). Such drivers take precedence over driver plugin
+ files with the same ID. */
 class KDB_EXPORT KDbDriverManager
 {
     Q_DECLARE_TR_FUNCTIONS(KDbDriverManager)
@@ -21,6 +21,7 @@
 #define KDB_DRIVER_MANAGER_P_H
 
 #include <QMap>
+#include <QtPlugin>
 #include "config-kdb.h"
 #include "KDbResult.h"
 
@@ -76,6 +77,8 @@ private:
     QMap<QString, KDbDriverMetaData*> m_metadata_by_mimetype;
     QMap<QString, KDbDriverMetaData*> m_driversMetaData; //!< used to store driver metadata
     QMap<QString, KDbDriver*> m_drivers; //!< for owning drivers
+    //! instance functions of drivers linked statically, see KDB_STATIC_DRIVERS
+    QMap<QString, QtPluginInstanceFunction> m_staticDriverInstances;
     QString m_pluginsDir;
     QStringList m_possibleProblems;
     bool m_lookupDriversNeeded;
@@ -50,6 +50,11 @@ KDbDriverMetaData::KDbDriverMetaData(const QPluginLoader &loader)
 {
 }
 
+KDbDriverMetaData::KDbDriverMetaData(const QJsonObject &metaData, const QString &fileName)
+    : KPluginMetaData(metaData, fileName), d(new Private(this))
+{
+}
+
 KDbDriverMetaData::~KDbDriverMetaData()
 {
     delete d;
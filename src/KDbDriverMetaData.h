@@ -44,6 +44,11 @@ public:
 
 protected:
     explicit KDbDriverMetaData(const QPluginLoader &loader);
+
+    //! Creates metadata from @a metaData JSON object of plugin file @a fileName.
+    //! @a fileName is empty for static plugins.
+    //! @since 3.3
+    KDbDriverMetaData(const QJsonObject &metaData, const QString &fileName);
     friend class DriverManagerInternal;
 
 private:
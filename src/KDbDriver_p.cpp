@@ -49,6 +49,7 @@ KDbDriverBehavior::KDbDriverBehavior(KDbDriver *driver)
         , IS_DB_OPEN_AFTER_CREATE(false)
         , _1ST_ROW_READ_AHEAD_REQUIRED_TO_KNOW_IF_THE_RESULT_IS_EMPTY(false)
         , SELECT_1_SUBQUERY_SUPPORTED(false)
+        , FAILED_STATEMENT_ABORTS_TRANSACTION(false)
         , BOOLEAN_TRUE_LITERAL(QLatin1Char('1'))
         , BOOLEAN_FALSE_LITERAL(QLatin1Char('0'))
         , TEXT_TYPE_MAX_LENGTH(0)
@@ -114,6 +115,7 @@ KDbDriverPrivate::KDbDriverPrivate(KDbDriver *aDriver)
         , driverBehavior(driver)
         , metaData(nullptr)
         , adminTools(nullptr)
+        , driverSpecificKeywordTable(nullptr)
 {
 }
 
@@ -29,6 +29,7 @@ class KDbAdminTools;
 class KDbConnection;
 class KDbDriver;
 class KDbDriverMetaData;
+struct KDbKeywordTable;
 
 /*! Private driver's data members. */
 class KDbDriverPrivate
@@ -64,12 +65,16 @@ public:
     */
     KDbUtils::StaticSetOfStrings driverSpecificSqlKeywords;
 
+    /*! Perfect hash table of driver-specific SQL keywords generated by
+      tools/sql_keywords.sh. Used instead of driverSpecificSqlKeywords if set. */
+    const KDbKeywordTable *driverSpecificKeywordTable;
+
     /*! KDbSQL keywords that need to be escaped if used as an identifier (e.g.
     for a table or column name).  These keywords will be escaped by the
     front-end, even if they are not recognised by the backend to provide
     UI consistency and to allow DB migration without changing the queries.
     */
-    static const char* const kdbSQLKeywords[];
+    static const KDbKeywordTable kdbSQLKeywords;
 
     friend class KDbDriver;
 private:
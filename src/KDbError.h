@@ -104,6 +104,8 @@ namespace KDb {
 #define ERR_SQL_EXECUTION_ERROR 260 //!< general server error for sql statement execution
 //!< usually returned by KDbConnection::executeSql()
 #define ERR_SQL_PARSE_ERROR 270 //!< Parse error coming from arser::parse()
+#define ERR_QUERY_CANCELED 280 //!< execution of statement has been canceled
+//!< using KDbConnection::cancel() or it has exceeded KDbConnection::statementTimeout()
 
 #define ERR_OTHER 0xffff //!< use this if you have not (yet?) the name for given error
 
@@ -100,7 +100,7 @@ public:
         return *this;
     }
 
-    inline int capacity() const { return QByteArray::isEmpty(); }
+    inline int capacity() const { return QByteArray::capacity(); }
     inline void reserve(int size) { QByteArray::reserve(size); }
     inline void squeeze() { QByteArray::squeeze(); }
 
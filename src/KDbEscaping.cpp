@@ -0,0 +1,501 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbEscaping_p.h"
+#include "kdb_debug.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define KDB_ESCAPING_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(KDB_ESCAPING_SSE2) && defined(__AVX2__)
+#define KDB_ESCAPING_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(Q_CC_MSVC) && !defined(Q_CC_CLANG)
+#include <intrin.h>
+#endif
+
+//! Maximum number of bytes written for a single UTF-16 unit or UTF-8 byte
+static const int maxBytesPerCharacter = 3;
+
+//! Maximum number of characters with replacements, compared by the vector kernels
+static const int maxSpecialCharacters = 8;
+
+//! @return index of the lowest bit set in nonzero @a mask
+static inline int lowestBit(quint32 mask)
+{
+#if defined(Q_CC_GNU)
+    return __builtin_ctz(mask);
+#elif defined(Q_CC_MSVC)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    int index = 0;
+    for (; !(mask & 1); mask >>= 1) {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+//! Appends @a length bytes of @a data at @a dst
+static inline void appendBytes(char *&dst, const char *data, int length)
+{
+    memcpy(dst, data, length);
+    dst += length;
+}
+
+//! Writes escaped UTF-8 form of UTF-16 character at @a src to @a dst.
+//! Unpaired surrogates are written as '?' like in QString::toUtf8().
+//! @return number of consumed units
+static inline int escapeUtf16Character(const ushort *src, const ushort *end,
+                                       const KDbStringEscapingRules &rules, char *&dst)
+{
+    const uint u = *src;
+    if (u < 0x80) {
+        const char *replacement = rules.replacement(u);
+        if (replacement) {
+            appendBytes(dst, replacement, rules.replacementLength(u));
+        } else {
+            *dst++ = char(u);
+        }
+        return 1;
+    }
+    if (u < 0x800) {
+        *dst++ = char(0xc0 | (u >> 6));
+        *dst++ = char(0x80 | (u & 0x3f));
+        return 1;
+    }
+    if (QChar::isSurrogate(u)) {
+        if (QChar::isHighSurrogate(u) && (src + 1) < end && QChar::isLowSurrogate(src[1])) {
+            const uint ucs4 = QChar::surrogateToUcs4(ushort(u), src[1]);
+            *dst++ = char(0xf0 | (ucs4 >> 18));
+            *dst++ = char(0x80 | ((ucs4 >> 12) & 0x3f));
+            *dst++ = char(0x80 | ((ucs4 >> 6) & 0x3f));
+            *dst++ = char(0x80 | (ucs4 & 0x3f));
+            return 2;
+        }
+        *dst++ = '?';
+        return 1;
+    }
+    *dst++ = char(0xe0 | (u >> 12));
+    *dst++ = char(0x80 | ((u >> 6) & 0x3f));
+    *dst++ = char(0x80 | (u & 0x3f));
+    return 1;
+}
+
+//! Writes escaped UTF-8 byte @a c to @a dst
+static inline void escapeUtf8Character(uchar c, const KDbStringEscapingRules &rules, char *&dst)
+{
+    const char *replacement = rules.replacement(c);
+    if (replacement) {
+        appendBytes(dst, replacement, rules.replacementLength(c));
+    } else {
+        *dst++ = char(c);
+    }
+}
+
+//! @return uppercase hex digit for 0..15
+static inline char hexDigit(uchar value)
+{
+    return value < 10 ? char('0' + value) : char('A' + value - 10);
+}
+
+#ifdef KDB_ESCAPING_AVX2
+/* Vector kernels process the input in blocks. A whole block is stored before checking it
+ because the output buffer always has space for maxBytesPerCharacter bytes per input unit;
+ only the part preceding the first character that needs escaping or encoding is kept. */
+
+static void escapeUtf16Avx2(const ushort *&src, const ushort *end,
+                            const KDbStringEscapingRules &rules, char *&dst)
+{
+    const QByteArray &specials = rules.specialCharacters();
+    __m256i specialVectors[maxSpecialCharacters];
+    for (int i = 0; i < specials.size(); ++i) {
+        specialVectors[i] = _mm256_set1_epi16(uchar(specials[i]));
+    }
+    const __m256i nonAsciiBits = _mm256_set1_epi16(short(0xff80));
+    const __m256i zero = _mm256_setzero_si256();
+    while (end - src >= 16) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        const __m256i ascii = _mm256_cmpeq_epi16(_mm256_and_si256(v, nonAsciiBits), zero);
+        __m256i special = zero;
+        for (int i = 0; i < specials.size(); ++i) {
+            special = _mm256_or_si256(special, _mm256_cmpeq_epi16(v, specialVectors[i]));
+        }
+        const quint32 plainMask = quint32(_mm256_movemask_epi8(_mm256_andnot_si256(special, ascii)));
+        // packing works within 128-bit lanes, move the second lane's bytes next to the first
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0xD8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(packed));
+        if (plainMask == 0xffffffffu) {
+            src += 16;
+            dst += 16;
+            continue;
+        }
+        const int plainCount = lowestBit(~plainMask) / 2;
+        src += plainCount;
+        dst += plainCount;
+        src += escapeUtf16Character(src, end, rules, dst);
+    }
+}
+
+static void escapeUtf8Avx2(const uchar *&src, const uchar *end,
+                           const KDbStringEscapingRules &rules, char *&dst)
+{
+    const QByteArray &specials = rules.specialCharacters();
+    __m256i specialVectors[maxSpecialCharacters];
+    for (int i = 0; i < specials.size(); ++i) {
+        specialVectors[i] = _mm256_set1_epi8(specials[i]);
+    }
+    while (end - src >= 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        __m256i special = _mm256_setzero_si256();
+        for (int i = 0; i < specials.size(); ++i) {
+            special = _mm256_or_si256(special, _mm256_cmpeq_epi8(v, specialVectors[i]));
+        }
+        const quint32 specialMask = quint32(_mm256_movemask_epi8(special));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), v);
+        if (specialMask == 0) {
+            src += 32;
+            dst += 32;
+            continue;
+        }
+        const int plainCount = lowestBit(specialMask);
+        src += plainCount;
+        dst += plainCount;
+        escapeUtf8Character(*src++, rules, dst);
+    }
+}
+
+//! @return uppercase hex digits for nibbles in @a nibbles
+static inline __m256i hexDigitsAvx2(__m256i nibbles)
+{
+    const __m256i letters = _mm256_and_si256(_mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9)),
+                                             _mm256_set1_epi8('A' - '0' - 10));
+    return _mm256_add_epi8(_mm256_add_epi8(nibbles, _mm256_set1_epi8('0')), letters);
+}
+
+static void hexAvx2(const uchar *&src, const uchar *end, char *&dst)
+{
+    const __m256i lowNibble = _mm256_set1_epi8(0x0f);
+    while (end - src >= 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        const __m256i high = hexDigitsAvx2(_mm256_and_si256(_mm256_srli_epi16(v, 4), lowNibble));
+        const __m256i low = hexDigitsAvx2(_mm256_and_si256(v, lowNibble));
+        // interleaving works within 128-bit lanes, reorder the lanes
+        const __m256i first = _mm256_unpacklo_epi8(high, low);
+        const __m256i second = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst),
+                            _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 32),
+                            _mm256_permute2x128_si256(first, second, 0x31));
+        src += 32;
+        dst += 64;
+    }
+}
+#endif // KDB_ESCAPING_AVX2
+
+#ifdef KDB_ESCAPING_SSE2
+static void escapeUtf16Sse2(const ushort *&src, const ushort *end,
+                            const KDbStringEscapingRules &rules, char *&dst)
+{
+    const QByteArray &specials = rules.specialCharacters();
+    __m128i specialVectors[maxSpecialCharacters];
+    for (int i = 0; i < specials.size(); ++i) {
+        specialVectors[i] = _mm_set1_epi16(uchar(specials[i]));
+    }
+    const __m128i nonAsciiBits = _mm_set1_epi16(short(0xff80));
+    const __m128i zero = _mm_setzero_si128();
+    while (end - src >= 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        const __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(v, nonAsciiBits), zero);
+        __m128i special = zero;
+        for (int i = 0; i < specials.size(); ++i) {
+            special = _mm_or_si128(special, _mm_cmpeq_epi16(v, specialVectors[i]));
+        }
+        const quint32 plainMask = quint32(_mm_movemask_epi8(_mm_andnot_si128(special, ascii)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(v, v));
+        if (plainMask == 0xffff) {
+            src += 8;
+            dst += 8;
+            continue;
+        }
+        const int plainCount = lowestBit(~plainMask) / 2;
+        src += plainCount;
+        dst += plainCount;
+        src += escapeUtf16Character(src, end, rules, dst);
+    }
+}
+
+static void escapeUtf8Sse2(const uchar *&src, const uchar *end,
+                           const KDbStringEscapingRules &rules, char *&dst)
+{
+    const QByteArray &specials = rules.specialCharacters();
+    __m128i specialVectors[maxSpecialCharacters];
+    for (int i = 0; i < specials.size(); ++i) {
+        specialVectors[i] = _mm_set1_epi8(specials[i]);
+    }
+    while (end - src >= 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        __m128i special = _mm_setzero_si128();
+        for (int i = 0; i < specials.size(); ++i) {
+            special = _mm_or_si128(special, _mm_cmpeq_epi8(v, specialVectors[i]));
+        }
+        const quint32 specialMask = quint32(_mm_movemask_epi8(special));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v);
+        if (specialMask == 0) {
+            src += 16;
+            dst += 16;
+            continue;
+        }
+        const int plainCount = lowestBit(specialMask);
+        src += plainCount;
+        dst += plainCount;
+        escapeUtf8Character(*src++, rules, dst);
+    }
+}
+
+//! @return uppercase hex digits for nibbles in @a nibbles
+static inline __m128i hexDigitsSse2(__m128i nibbles)
+{
+    const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)),
+                                          _mm_set1_epi8('A' - '0' - 10));
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+}
+
+static void hexSse2(const uchar *&src, const uchar *end, char *&dst)
+{
+    const __m128i lowNibble = _mm_set1_epi8(0x0f);
+    while (end - src >= 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        const __m128i high = hexDigitsSse2(_mm_and_si128(_mm_srli_epi16(v, 4), lowNibble));
+        const __m128i low = hexDigitsSse2(_mm_and_si128(v, lowNibble));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi8(high, low));
+        src += 16;
+        dst += 32;
+    }
+}
+#endif // KDB_ESCAPING_SSE2
+
+KDbEscapingKernel kdbDefaultEscapingKernel()
+{
+#if defined(KDB_ESCAPING_AVX2)
+    return KDbEscapingKernel::Avx2;
+#elif defined(KDB_ESCAPING_SSE2)
+    return KDbEscapingKernel::Sse2;
+#else
+    return KDbEscapingKernel::Scalar;
+#endif
+}
+
+KDbStringEscapingRules::KDbStringEscapingRules(std::initializer_list<Replacement> replacements)
+{
+    std::fill(m_replacements, m_replacements + 128, nullptr);
+    std::fill(m_lengths, m_lengths + 128, quint8(0));
+    for (const Replacement &r : replacements) {
+        const uchar c = r.character;
+        const int length = qstrlen(r.replacement);
+        Q_ASSERT(c < 128);
+        Q_ASSERT(length <= maxBytesPerCharacter);
+        m_replacements[c] = r.replacement;
+        m_lengths[c] = quint8(length);
+        m_specialCharacters.append(char(c));
+    }
+    Q_ASSERT(m_specialCharacters.size() <= maxSpecialCharacters);
+}
+
+const KDbStringEscapingRules& kdbSqlStringEscapingRules()
+{
+    static const KDbStringEscapingRules rules{
+        {'\'', "''"}, {'\t', "\\t"}, {'\\', "\\\\"}, {'\n', "\\n"}, {'\r', "\\r"}, {'\0', "\\0"}};
+    return rules;
+}
+
+//! Resizes @a result to @a length bytes and writes @a prefix.
+//! @return position after the prefix or @c nullptr if the string would be too large
+static char* allocateEscaped(KDbEscapedString *result, qint64 length, const char *prefix)
+{
+    // leave space for QByteArray's header and terminating zero
+    if (length > qint64(std::numeric_limits<int>::max() - 64)) {
+        kdbWarning() << "Not enough memory (cannot allocate" << length << "bytes)";
+        *result = KDbEscapedString::invalid();
+        return nullptr;
+    }
+    result->resize(int(length));
+    char *dst = result->data();
+    appendBytes(dst, prefix, qstrlen(prefix));
+    return dst;
+}
+
+//! Appends @a suffix at @a dst and truncates @a result to the written data
+static void finishEscaped(KDbEscapedString *result, char *dst, const char *suffix)
+{
+    appendBytes(dst, suffix, qstrlen(suffix));
+    const int length = int(dst - result->data());
+    result->resize(length);
+    // resize() keeps the worst-case allocation, release it if most of it is unused
+    const int capacity = result->capacity();
+    if (capacity > 64 && length < capacity / 2) {
+        result->squeeze();
+    }
+}
+
+KDbEscapedString kdbEscapeString(const QString &string, const KDbStringEscapingRules &rules,
+                                 const char *prefix, const char *suffix, KDbEscapingKernel kernel)
+{
+    KDbEscapedString result;
+    char *dst = allocateEscaped(
+        &result, qint64(string.length()) * maxBytesPerCharacter + qstrlen(prefix) + qstrlen(suffix),
+        prefix);
+    if (!dst) {
+        return result;
+    }
+    const ushort *src = string.utf16();
+    const ushort *end = src + string.length();
+#ifdef KDB_ESCAPING_AVX2
+    if (kernel == KDbEscapingKernel::Avx2) {
+        escapeUtf16Avx2(src, end, rules, dst);
+    }
+#endif
+#ifdef KDB_ESCAPING_SSE2
+    if (kernel != KDbEscapingKernel::Scalar) {
+        escapeUtf16Sse2(src, end, rules, dst);
+    }
+#endif
+    Q_UNUSED(kernel);
+    while (src < end) {
+        src += escapeUtf16Character(src, end, rules, dst);
+    }
+    finishEscaped(&result, dst, suffix);
+    return result;
+}
+
+KDbEscapedString kdbEscapeString(const QByteArray &string, const KDbStringEscapingRules &rules,
+                                 const char *prefix, const char *suffix, KDbEscapingKernel kernel)
+{
+    KDbEscapedString result;
+    char *dst = allocateEscaped(
+        &result, qint64(string.length()) * maxBytesPerCharacter + qstrlen(prefix) + qstrlen(suffix),
+        prefix);
+    if (!dst) {
+        return result;
+    }
+    const uchar *src = reinterpret_cast<const uchar*>(string.constData());
+    const uchar *end = src + string.length();
+#ifdef KDB_ESCAPING_AVX2
+    if (kernel == KDbEscapingKernel::Avx2) {
+        escapeUtf8Avx2(src, end, rules, dst);
+    }
+#endif
+#ifdef KDB_ESCAPING_SSE2
+    if (kernel != KDbEscapingKernel::Scalar) {
+        escapeUtf8Sse2(src, end, rules, dst);
+    }
+#endif
+    Q_UNUSED(kernel);
+    while (src < end) {
+        escapeUtf8Character(*src++, rules, dst);
+    }
+    finishEscaped(&result, dst, suffix);
+    return result;
+}
+
+KDbEscapedString kdbEscapeBLOB(const QByteArray &array, KDb::BLOBEscapingType type,
+                               KDbEscapingKernel kernel)
+{
+    const int size = array.size();
+    const char *prefix = "";
+    const char *suffix = "";
+    switch (type) {
+    case KDb::BLOBEscapingType::XHex:
+        prefix = "X'";
+        suffix = "'";
+        break;
+    case KDb::BLOBEscapingType::ZeroXHex:
+        if (size == 0) {
+            return KDbEscapedString();
+        }
+        prefix = "0x";
+        break;
+    case KDb::BLOBEscapingType::Hex:
+        break;
+    case KDb::BLOBEscapingType::Octal:
+        prefix = "'";
+        suffix = "'";
+        break;
+    case KDb::BLOBEscapingType::ByteaHex:
+        prefix = "E'\\\\x";
+        suffix = "'::bytea";
+        break;
+    }
+    // octal escaping uses up to 5 characters per byte: \\ooo
+    const int bytesPerByte = type == KDb::BLOBEscapingType::Octal ? 5 : 2;
+    KDbEscapedString result;
+    char *dst = allocateEscaped(
+        &result, qint64(size) * bytesPerByte + qstrlen(prefix) + qstrlen(suffix), prefix);
+    if (!dst) {
+        return result;
+    }
+    const uchar *src = reinterpret_cast<const uchar*>(array.constData());
+    const uchar *end = src + size;
+    if (type == KDb::BLOBEscapingType::Octal) {
+        // only escape nonprintable characters as in Table 8-7:
+        // https://www.postgresql.org/docs/8.1/interactive/datatype-binary.html
+        // i.e. escape for bytes: < 32, >= 127, 39 ('), 92(\).
+        for (; src < end; ++src) {
+            const uchar val = *src;
+            if (val < 32 || val >= 127 || val == 39 || val == 92) {
+                *dst++ = '\\';
+                *dst++ = '\\';
+                *dst++ = char('0' + val / 64);
+                *dst++ = char('0' + (val % 64) / 8);
+                *dst++ = char('0' + val % 8);
+            } else {
+                *dst++ = char(val);
+            }
+        }
+    } else {
+#ifdef KDB_ESCAPING_AVX2
+        if (kernel == KDbEscapingKernel::Avx2) {
+            hexAvx2(src, end, dst);
+        }
+#endif
+#ifdef KDB_ESCAPING_SSE2
+        if (kernel != KDbEscapingKernel::Scalar) {
+            hexSse2(src, end, dst);
+        }
+#endif
+        Q_UNUSED(kernel);
+        for (; src < end; ++src) {
+            *dst++ = hexDigit(*src >> 4);
+            *dst++ = hexDigit(*src & 0x0f);
+        }
+    }
+    finishEscaped(&result, dst, suffix);
+    return result;
+}
@@ -0,0 +1,89 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_ESCAPING_P_H
+#define KDB_ESCAPING_P_H
+
+#include "KDb.h"
+#include "KDbEscapedString.h"
+
+#include <initializer_list>
+
+//! @internal Instruction sets used by kernels of kdbEscapeString() and kdbEscapeBLOB()
+enum class KDbEscapingKernel {
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+//! @internal @return the fastest escaping kernel available in this build of KDb.
+//! SSE2 and AVX2 kernels are available if KDb is compiled for CPUs supporting them.
+KDB_EXPORT KDbEscapingKernel kdbDefaultEscapingKernel();
+
+/*! @internal Rules of escaping string literals: replacements of ASCII characters.
+ Other characters are copied unchanged. Replacements are at most 3 bytes long
+ and at most 8 characters can be replaced. */
+class KDB_EXPORT KDbStringEscapingRules
+{
+public:
+    struct Replacement {
+        char character;
+        const char *replacement;
+    };
+
+    explicit KDbStringEscapingRules(std::initializer_list<Replacement> replacements);
+
+    //! @return replacement of character @a c, @c nullptr if it is copied unchanged
+    inline const char* replacement(uint c) const {
+        return c < 128 ? m_replacements[c] : nullptr;
+    }
+
+    //! @return length of replacement of ASCII character @a c
+    inline int replacementLength(uint c) const { return m_lengths[c]; }
+
+    //! @return characters that have replacements
+    inline const QByteArray& specialCharacters() const { return m_specialCharacters; }
+
+private:
+    const char* m_replacements[128];
+    quint8 m_lengths[128];
+    QByteArray m_specialCharacters;
+    Q_DISABLE_COPY(KDbStringEscapingRules)
+};
+
+//! @internal @return rules of escaping strings for the KDBSQL dialect, see KDb::escapeString()
+KDB_EXPORT const KDbStringEscapingRules& kdbSqlStringEscapingRules();
+
+/*! @internal @return UTF-8 encoded @a string escaped using @a rules, between @a prefix
+ and @a suffix. The string is converted and escaped in one pass, directly into the result. */
+KDB_EXPORT KDbEscapedString kdbEscapeString(const QString &string, const KDbStringEscapingRules &rules,
+                                            const char *prefix = "'", const char *suffix = "'",
+                                            KDbEscapingKernel kernel = kdbDefaultEscapingKernel());
+
+//! @internal @overload for UTF-8 encoded @a string
+KDB_EXPORT KDbEscapedString kdbEscapeString(const QByteArray &string, const KDbStringEscapingRules &rules,
+                                            const char *prefix = "'", const char *suffix = "'",
+                                            KDbEscapingKernel kernel = kdbDefaultEscapingKernel());
+
+/*! @internal @return escaped @a array like KDb::escapeBLOB() but directly as KDbEscapedString.
+ Invalid string is returned if the result would be too large. */
+KDB_EXPORT KDbEscapedString kdbEscapeBLOB(const QByteArray &array, KDb::BLOBEscapingType type,
+                                          KDbEscapingKernel kernel = kdbDefaultEscapingKernel());
+
+#endif
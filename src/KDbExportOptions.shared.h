@@ -0,0 +1,101 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_KDBEXPORTOPTIONS_H
+#define KDB_KDBEXPORTOPTIONS_H
+
+#include "kdb_export.h"
+
+#include <QChar>
+
+//! Format of data exported by KDbConnection::exportData(), see KDbExportOptions for details
+//! @since 3.3
+enum class KDbExportFormat {
+    Csv,
+    JsonLines,
+    Columnar
+};
+
+/*! @brief Options used in KDbConnection::exportData()
+
+ Formats of the exported data:
+ - Csv: comma-separated values as described in RFC 4180, UTF-8 encoded. Fields containing
+   delimiter, quotes or line breaks are quoted. Null values are exported as empty fields.
+ - JsonLines: one JSON object per record, see http://jsonlines.org. Keys are column names
+   in order of columns. Null values are exported as null.
+ - Columnar: typed binary format written with QDataStream (version Qt_5_4, big endian):
+   header (quint32 magic 0x4B444243 "KDBC", quint16 version 1, quint32 number of columns,
+   then QString name and qint32 KDbField::Type of each column) followed by groups of records.
+   Each group contains quint32 number of records N and then consecutive data of each column:
+   QByteArray bitmap of null values (bit i set if value of record i is null) and N - nulls
+   values stored as qint64 for integer types, quint8 for Boolean, double for floating point
+   types, QDate, QTime and QDateTime for date/time types, QByteArray for BLOB and QString for
+   other types. Group of 0 records ends the data.
+
+ In all formats date/time values are exported using ISO 8601 (Qt::ISODate) and BLOBs
+ in text formats are exported using base64 encoding.
+ @since 3.3
+*/
+class KDB_EXPORT KDbExportOptions //SDC: operator==
+{
+public:
+    /*!
+    @getter
+    @return format of the exported data. KDbExportFormat::Csv by default.
+    @setter
+    Sets format of the exported data.
+    */
+    KDbExportFormat format; //SDC: default=KDbExportFormat::Csv
+
+    /*!
+    @getter
+    @return delimiter of fields for the CSV format. ',' by default.
+    @setter
+    Sets delimiter of fields for the CSV format.
+    */
+    QChar delimiter; //SDC: default=QLatin1Char(',')
+
+    /*!
+    @getter
+    @return @c true if names of columns are exported in the first line of the CSV format.
+    @c true by default.
+    @setter
+    Specifies whether names of columns are exported in the first line of the CSV format.
+    */
+    bool includeHeader; //SDC: default=true
+
+    /*!
+    @getter
+    @return number of records converted as a single batch. 1024 by default.
+    @setter
+    Sets number of records converted as a single batch.
+    */
+    int batchSize; //SDC: default=1024
+
+    /*!
+    @getter
+    @return maximum number of batches fetched but not yet converted. 4 by default.
+    Together with batchSize() it limits memory used by the export.
+    @setter
+    Sets maximum number of batches fetched but not yet converted.
+    */
+    int maxPendingBatches; //SDC: default=4
+};
+
+#endif
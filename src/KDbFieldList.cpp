@@ -19,6 +19,8 @@
 
 #include "KDbFieldList.h"
 #include "KDbConnection.h"
+#include "KDbStatementBuffer_p.h"
+#include "KDbUtils_p.h"
 #include "kdb_debug.h"
 
 class Q_DECL_HIDDEN KDbFieldList::Private
@@ -41,7 +43,7 @@ public:
 
     bool renameFieldInternal(KDbField *field, const QString& newNameLower)
     {
-        if (fieldsByName.value(newNameLower)) {
+        if (fieldByName(newNameLower)) {
             kdbWarning() << "Field" << newNameLower << "already exists";
             return false;
         }
@@ -51,9 +53,15 @@ public:
         return true;
     }
 
+    //! @return field for name @a name, the lookup is case insensitive
+    inline KDbField* fieldByName(const QString &name) const
+    {
+        return kdbValueForLowerCaseName(fieldsByName, name);
+    }
+
     KDbField::List fields;
 
-    //!< Fields collected by name. Not used by KDbQuerySchema.
+    //!< Fields collected by lowercase name. Not used by KDbQuerySchema.
     QHash<QString, KDbField*> fieldsByName;
 
     KDbField::List *autoincFields = nullptr;
@@ -140,7 +148,7 @@ bool KDbFieldList::insertField(int index, KDbField *field)
 
 bool KDbFieldList::renameField(const QString& oldName, const QString& newName)
 {
-    KDbField *field = d->fieldsByName.value(oldName.toLower());
+    KDbField *field = d->fieldByName(oldName);
     if (!field) {
         kdbWarning() << "Fiels" << oldName << "not found";
         return false;
@@ -150,7 +158,7 @@ bool KDbFieldList::renameField(const QString& oldName, const QString& newName)
 
 bool KDbFieldList::renameField(KDbField *field, const QString& newName)
 {
-    if (!field || field != d->fieldsByName.value(field->name().toLower())) {
+    if (!field || field != d->fieldByName(field->name())) {
         kdbWarning() << "No field found"
                       << QString::fromLatin1("\"%1\"").arg(field ? field->name() : QString());
         return false;
@@ -203,12 +211,12 @@ const KDbField* KDbFieldList::field(int id) const
 
 KDbField* KDbFieldList::field(const QString& name)
 {
-    return d->fieldsByName.value(name.toLower());
+    return d->fieldByName(name);
 }
 
 const KDbField* KDbFieldList::field(const QString& name) const
 {
-    return d->fieldsByName.value(name.toLower());
+    return d->fieldByName(name);
 }
 
 bool KDbFieldList::hasField(const KDbField& field) const
@@ -239,7 +247,7 @@ KDB_EXPORT QDebug operator<<(QDebug dbg, const KDbFieldList& list)
 #define _ADD_FIELD(fname) \
     { \
         if (fname.isEmpty()) return fl; \
-        KDbField *f = d->fieldsByName.value(fname.toLower()); \
+        KDbField *f = d->fieldByName(fname); \
         if (!f || !fl->addField(f)) { kdbWarning() << subListWarning1(fname); delete fl; return nullptr; } \
     }
 
@@ -296,7 +304,7 @@ KDbFieldList* KDbFieldList::subList(const QStringList& list)
 #define _ADD_FIELD(fname) \
     { \
         if (fname.isEmpty()) return fl; \
-        KDbField *f = d->fieldsByName.value(QLatin1String(fname.toLower())); \
+        KDbField *f = d->fieldByName(QLatin1String(fname)); \
         if (!f || !fl->addField(f)) { kdbWarning() << subListWarning1(QLatin1String(fname)); delete fl; return nullptr; } \
     }
 
@@ -357,29 +365,19 @@ KDbEscapedString KDbFieldList::sqlFieldsList(const KDbField::List& list, KDbConn
                                        const QString& separator, const QString& tableOrAlias,
                                        KDb::IdentifierEscapingType escapingType)
 {
-    KDbEscapedString result;
-    result.reserve(256);
+    KDbStatementBuffer result((conn && escapingType == KDb::DriverEscaping) ? conn->driver() : nullptr, 256);
     bool start = true;
-    QString tableOrAliasAndDot;
-    if (!tableOrAlias.isEmpty()) {
-        tableOrAliasAndDot
-                 = ((conn && escapingType == KDb::DriverEscaping)
-                        ? conn->escapeIdentifier(tableOrAlias)
-                        : KDb::escapeIdentifier(tableOrAlias))
-                   + QLatin1Char('.');
-    }
     foreach(KDbField *f, list) {
         if (!start)
             result.append(separator);
         else
             start = false;
-        result = (result + tableOrAliasAndDot +
-                   ((conn && escapingType == KDb::DriverEscaping)
-                        ? conn->escapeIdentifier(f->name())
-                        : KDb::escapeIdentifier(f->name()))
-                 );
+        if (!tableOrAlias.isEmpty()) {
+            result.appendIdentifier(tableOrAlias).append('.');
+        }
+        result.appendIdentifier(f->name());
     }
-    return result;
+    return result.statement();
 }
 
 KDbEscapedString KDbFieldList::sqlFieldsList(KDbConnection *conn,
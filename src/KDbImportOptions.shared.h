@@ -0,0 +1,94 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_KDBIMPORTOPTIONS_H
+#define KDB_KDBIMPORTOPTIONS_H
+
+#include "kdb_export.h"
+
+#include <QChar>
+
+/*! @brief Options used in KDbConnection::importData()
+
+ Imported data is UTF-8 encoded text in the CSV format as described in RFC 4180.
+ Fields can be quoted; quoted fields can contain delimiters, quotes (written twice)
+ and line breaks. Empty unquoted fields are imported as null values.
+
+ The input is split into chunks of complete records that are parsed by multiple threads.
+ At most two chunks per thread are read ahead, so together with chunkSize() the number
+ of threads limits memory used by the import.
+ @since 3.3
+*/
+class KDB_EXPORT KDbImportOptions //SDC: operator==
+{
+public:
+    /*!
+    @getter
+    @return delimiter of fields. ',' by default.
+    @setter
+    Sets delimiter of fields.
+    */
+    QChar delimiter; //SDC: default=QLatin1Char(',')
+
+    /*!
+    @getter
+    @return @c true if the first record contains names of columns. @c true by default.
+    If there is no header, columns are imported to fields of the table in order of fields.
+    @setter
+    Specifies whether the first record contains names of columns.
+    */
+    bool hasHeader; //SDC: default=true
+
+    /*!
+    @getter
+    @return minimal size of a chunk of input parsed as a whole, in bytes. 1 MiB by default.
+    Chunks always end at a record boundary.
+    @setter
+    Sets minimal size of a chunk of input parsed as a whole.
+    */
+    int chunkSize; //SDC: default=1048576
+
+    /*!
+    @getter
+    @return number of records examined by KDb::inferImportTableSchema(). 1000 by default.
+    @setter
+    Sets number of records examined by KDb::inferImportTableSchema().
+    */
+    int sampleSize; //SDC: default=1000
+
+    /*!
+    @getter
+    @return maximum number of rejected records. 0 by default.
+    The import fails when more records are rejected; -1 means no limit.
+    @setter
+    Sets maximum number of rejected records.
+    */
+    int maxErrors; //SDC: default=0
+
+    /*!
+    @getter
+    @return number of threads parsing the input.
+    0 (the default) means QThread::idealThreadCount().
+    @setter
+    Sets number of threads parsing the input.
+    */
+    int threadCount; //SDC: default=0
+};
+
+#endif
@@ -0,0 +1,132 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_KEYWORDTABLE_P_H
+#define KDB_KEYWORDTABLE_P_H
+
+#include <QByteArray>
+
+//! @internal @return upper-case version of ASCII character @a c
+constexpr char kdbKeywordUpper(char c)
+{
+    return (c >= 'a' && c <= 'z') ? char(c - 'a' + 'A') : c;
+}
+
+//! @internal @return FNV-1a hash of upper-case characters of @a word of length @a length
+constexpr quint32 kdbKeywordFnv(const char *word, int length, quint32 hash)
+{
+    return length <= 0 ? hash
+                       : kdbKeywordFnv(word + 1, length - 1,
+                                       (hash ^ quint8(kdbKeywordUpper(*word))) * 16777619u);
+}
+
+//! @internal Final mixing of bits of @a hash
+constexpr quint32 kdbKeywordMix(quint32 hash)
+{
+    return ((hash ^ (hash >> 15)) * 0x2c1b3c6du) ^ (((hash ^ (hash >> 15)) * 0x2c1b3c6du) >> 12);
+}
+
+/*! @internal @return case-insensitive hash of @a word of length @a length for seed @a seed.
+ Has to be kept in sync with tools/sql_keywords_table.py. */
+constexpr quint32 kdbKeywordHash(const char *word, int length, quint32 seed)
+{
+    return kdbKeywordMix(kdbKeywordFnv(word, length, 2166136261u ^ (seed * 0x9e3779b9u)));
+}
+
+/*! @internal Perfect hash table of upper-case SQL keywords.
+
+ Tables are generated by tools/sql_keywords.sh using tools/sql_keywords_table.py, so lookup
+ needs one hash computation for the bucket, at most one for the slot and one string
+ comparison. Keywords are distributed to displacementCount buckets by
+ kdbKeywordHash(word, length, 0). Non-negative displacement d of a bucket means its keywords
+ are at slots kdbKeywordHash(word, length, d), negative displacement d means the only keyword
+ of the bucket is at slot -d - 1. All lookup methods are constexpr so the tables are checked
+ at compile time, see isValid(). */
+struct KDbKeywordTable
+{
+    //! @return true if @a word of length @a length is a keyword.
+    //! For case-insensitive lookup @a word can contain lower-case characters.
+    constexpr bool contains(const char *word, int length,
+                            Qt::CaseSensitivity cs = Qt::CaseSensitive) const
+    {
+        return length > 0
+            && matches(keywords[slot(displacements[kdbKeywordHash(word, length, 0)
+                                                & quint32(displacementCount - 1)],
+                                  word, length)],
+                       word, length, cs == Qt::CaseSensitive);
+    }
+
+    //! @overload
+    inline bool contains(const QByteArray &word, Qt::CaseSensitivity cs = Qt::CaseSensitive) const
+    {
+        return contains(word.constData(), word.length(), cs);
+    }
+
+    //! @return true if every keyword of the table is found by contains()
+    constexpr bool isValid() const
+    {
+        return slotCount > 0 && (slotCount & (slotCount - 1)) == 0
+            && displacementCount > 0 && (displacementCount & (displacementCount - 1)) == 0
+            && isValid(0, slotCount);
+    }
+
+    const char* const *keywords; //!< slots with keywords, nullptr for empty slots
+    int slotCount; //!< number of slots, a power of two
+    const int *displacements; //!< displacements of buckets
+    int displacementCount; //!< number of buckets, a power of two
+
+private:
+    constexpr int slot(int displacement, const char *word, int length) const
+    {
+        return displacement < 0
+            ? -displacement - 1
+            : int(kdbKeywordHash(word, length, quint32(displacement)) & quint32(slotCount - 1));
+    }
+
+    static constexpr bool matches(const char *keyword, const char *word, int length,
+                                  bool caseSensitive)
+    {
+        return keyword && equals(keyword, word, length, caseSensitive);
+    }
+
+    static constexpr bool equals(const char *keyword, const char *word, int length,
+                                 bool caseSensitive)
+    {
+        return length == 0
+            ? *keyword == '\0'
+            : (*keyword != '\0'
+               && (caseSensitive ? *word == *keyword : kdbKeywordUpper(*word) == *keyword)
+               && equals(keyword + 1, word + 1, length - 1, caseSensitive));
+    }
+
+    static constexpr int keywordLength(const char *string)
+    {
+        return *string ? 1 + keywordLength(string + 1) : 0;
+    }
+
+    // slots are split into halves to keep recursion depth low
+    constexpr bool isValid(int from, int to) const
+    {
+        return to - from == 1
+            ? (!keywords[from] || contains(keywords[from], keywordLength(keywords[from])))
+            : (isValid(from, (from + to) / 2) && isValid((from + to) / 2, to));
+    }
+};
+
+#endif
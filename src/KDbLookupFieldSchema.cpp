@@ -757,3 +757,13 @@ bool KDbLookupFieldSchema::operator==(const KDbLookupFieldSchema &other) const
 {
     return *d == *other.d;
 }
+
+//----------------------------
+
+KDbLookupValuesListener::KDbLookupValuesListener()
+{
+}
+
+KDbLookupValuesListener::~KDbLookupValuesListener()
+{
+}
@@ -24,6 +24,7 @@
 
 #include "kdb_export.h"
 
+class KDbConnection;
 class QStringList;
 class QDomElement;
 class QDomDocument;
@@ -243,6 +244,30 @@ private:
     Private * const d;
 };
 
+/*! @brief Interface for receiving notifications about changes of cached lookup values
+
+ Listeners are registered with KDbConnection::addLookupValuesListener().
+ lookupValuesChanged() is called when visible values of lookup record sources cached by
+ the connection have been discarded because a table they depend on has been modified,
+ so views displaying visible values of lookup columns can update them.
+ @see KDbConnection::setLookupValueCacheLimit()
+ @since 3.3
+*/
+class KDB_EXPORT KDbLookupValuesListener
+{
+public:
+    KDbLookupValuesListener();
+
+    virtual ~KDbLookupValuesListener();
+
+    /*! Called when cached visible values depending on table @a tableName have been discarded
+     by connection @a conn. Empty @a tableName means that all cached values have been discarded. */
+    virtual void lookupValuesChanged(KDbConnection *conn, const QString &tableName) = 0;
+
+private:
+    Q_DISABLE_COPY(KDbLookupValuesListener)
+};
+
 //! Sends lookup field schema's record source information @a source to debug output @a dbg.
 KDB_EXPORT QDebug operator<<(QDebug dbg, const KDbLookupFieldSchemaRecordSource& source);
 
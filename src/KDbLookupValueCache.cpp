@@ -0,0 +1,220 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbLookupValueCache_p.h"
+#include "KDbConnection.h"
+#include "KDbCursor.h"
+#include "KDbLookupFieldSchema.h"
+#include "KDbNativeStatementBuilder.h"
+#include "KDbQuerySchema.h"
+#include "KDbStatementBuffer_p.h"
+#include "KDbTableSchema.h"
+#include "kdb_debug.h"
+
+#include <QScopedPointer>
+
+KDbLookupValueCache::KDbLookupValueCache(KDbConnection *conn)
+    : m_conn(conn)
+{
+}
+
+KDbLookupValueCache::~KDbLookupValueCache()
+{
+}
+
+//! @return key identifying record source and columns of @a lookup
+static QString entryKey(const KDbLookupFieldSchema &lookup)
+{
+    const KDbLookupFieldSchemaRecordSource recordSource(lookup.recordSource());
+    QString key(recordSource.typeName() + QLatin1Char(':') + recordSource.name().toLower()
+                + QLatin1Char(':') + QString::number(lookup.boundColumn()));
+    for (int column : lookup.visibleColumns()) {
+        key += QLatin1Char(',') + QString::number(column);
+    }
+    return key;
+}
+
+QSharedPointer<const KDbLookupValueCache::Values> KDbLookupValueCache::values(
+    const KDbLookupFieldSchema &lookup)
+{
+    if (maxRecords <= 0) {
+        return QSharedPointer<const Values>();
+    }
+    const QString key(entryKey(lookup));
+    const auto it = m_entries.constFind(key);
+    if (it != m_entries.constEnd()) {
+        return it.value().values;
+    }
+    Entry entry;
+    if (!load(lookup, &entry)) {
+        return QSharedPointer<const Values>();
+    }
+    m_entries.insert(key, entry);
+    return entry.values;
+}
+
+QSharedPointer<const KDbLookupValueCache::Values> KDbLookupValueCache::cachedValues(
+    const KDbLookupFieldSchema &lookup) const
+{
+    if (m_entries.isEmpty()) {
+        return QSharedPointer<const Values>();
+    }
+    return m_entries.value(entryKey(lookup)).values;
+}
+
+bool KDbLookupValueCache::load(const KDbLookupFieldSchema &lookup, Entry *entry)
+{
+    const KDbLookupFieldSchemaRecordSource recordSource(lookup.recordSource());
+    const QList<int> visibleColumns(lookup.visibleColumns());
+    if (lookup.boundColumn() < 0 || visibleColumns.isEmpty()) {
+        return false;
+    }
+    // Types of the bound and visible columns (in this order) and position
+    // of these columns in the result of the statement
+    QVector<KDbField*> fields;
+    QVector<int> positions;
+    KDbEscapedString sql;
+    if (recordSource.type() == KDbLookupFieldSchemaRecordSource::Type::Table) {
+        KDbTableSchema *table = m_conn->tableSchema(recordSource.name());
+        if (!table) {
+            return false;
+        }
+        KDbStatementBuffer buffer(m_conn->driver());
+        buffer.append("SELECT ");
+        int position = 0;
+        for (int column : QList<int>({ lookup.boundColumn() }) + visibleColumns) {
+            KDbField *field = table->field(column);
+            if (!field) {
+                return false;
+            }
+            if (position > 0) {
+                buffer.append(", ");
+            }
+            buffer.appendIdentifier(field->name());
+            fields.append(field);
+            positions.append(position++);
+        }
+        buffer.append(" FROM ").appendIdentifier(table->name());
+        sql = buffer.statement();
+        entry->tables.append(table->name().toLower());
+    } else if (recordSource.type() == KDbLookupFieldSchemaRecordSource::Type::Query) {
+        KDbQuerySchema *query = m_conn->querySchema(recordSource.name());
+        if (!query) {
+            return false;
+        }
+        const KDbQueryColumnInfo::Vector fieldsExpanded(query->fieldsExpanded(m_conn));
+        for (int column : QList<int>({ lookup.boundColumn() }) + visibleColumns) {
+            if (column >= fieldsExpanded.count()) {
+                return false;
+            }
+            fields.append(fieldsExpanded.at(column)->field());
+            positions.append(column);
+        }
+        KDbNativeStatementBuilder builder(m_conn, KDb::DriverEscaping);
+        if (!builder.generateSelectStatement(&sql, query)) {
+            return false;
+        }
+        for (const KDbTableSchema *table : *query->tables()) {
+            entry->tables.append(table->name().toLower());
+        }
+    } else {
+        return false; // other types of record sources are not cached
+    }
+
+    KDbCursor *cursor = m_conn->executeQuery(sql);
+    if (!cursor) {
+        return false;
+    }
+    QScopedPointer<Values> values(new Values);
+    bool tooLarge = false;
+    for (; !cursor->eof(); cursor->moveNext()) {
+        if (values->count() >= maxRecords) {
+            tooLarge = true;
+            break;
+        }
+        QVariant bound(cursor->value(positions.first()));
+        if (bound.isNull()) {
+            continue; // never matches
+        }
+        QVariant visible;
+        if (fields.count() == 2) { // single visible column: the value as-is
+            visible = cursor->value(positions.at(1));
+            if (!visible.isNull()) {
+                visible.convert(fields.at(1)->variantType());
+            }
+        } else { // multiple visible columns: values joined with ' ' like in the joined statement
+            QStringList parts;
+            for (int i = 1; i < fields.count(); ++i) {
+                const QVariant part(cursor->value(positions.at(i)));
+                if (part.isNull()) {
+                    parts.clear();
+                    break;
+                }
+                parts.append(part.toString());
+            }
+            if (!parts.isEmpty()) {
+                visible = parts.join(QLatin1Char(' '));
+            }
+        }
+        bound.convert(fields.first()->variantType());
+        values->insert(key(bound), visible);
+    }
+    const bool ok = !cursor->result().isError();
+    m_conn->deleteCursor(cursor);
+    if (!ok) {
+        return false;
+    }
+    if (!tooLarge) {
+        entry->values = QSharedPointer<const Values>(values.take());
+    }
+    return true;
+}
+
+void KDbLookupValueCache::tableChanged(const QString &tableName)
+{
+    if (m_entries.isEmpty()) {
+        return;
+    }
+    if (tableName.isEmpty()) {
+        m_entries.clear();
+    } else {
+        const QString name(tableName.toLower());
+        bool removed = false;
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            if (it.value().tables.contains(name)) {
+                it = m_entries.erase(it);
+                removed = true;
+            } else {
+                ++it;
+            }
+        }
+        if (!removed) {
+            return;
+        }
+    }
+    const QList<KDbLookupValuesListener*> listenersToNotify(listeners);
+    for (KDbLookupValuesListener *listener : listenersToNotify) {
+        listener->lookupValuesChanged(m_conn, tableName);
+    }
+}
+
+void KDbLookupValueCache::clear()
+{
+    m_entries.clear();
+}
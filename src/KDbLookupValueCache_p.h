@@ -0,0 +1,90 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_LOOKUPVALUECACHE_P_H
+#define KDB_LOOKUPVALUECACHE_P_H
+
+#include <QHash>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVariant>
+
+class KDbConnection;
+class KDbDriver;
+class KDbLookupFieldSchema;
+class KDbLookupValuesListener;
+
+/*! @internal Cache of visible values of lookup record sources of a connection.
+
+ Small tables and queries used as lookup record sources are loaded once and their visible
+ values are indexed by bound values, so cursors can resolve visible values of lookup columns
+ without joining the record sources again. Values of a record source are discarded by
+ tableChanged() when a statement modifying any of its tables is executed using the connection. */
+class KDbLookupValueCache
+{
+public:
+    //! Visible values of a record source indexed by keys of bound values, see key()
+    typedef QHash<QString, QVariant> Values;
+
+    explicit KDbLookupValueCache(KDbConnection *conn);
+
+    ~KDbLookupValueCache();
+
+    /*! @return visible values of record source of @a lookup, loaded if needed.
+     @c nullptr is returned if the cache is disabled, the record source has more than
+     maxRecords records, its type is not supported or it could not be loaded. */
+    QSharedPointer<const Values> values(const KDbLookupFieldSchema &lookup);
+
+    //! @return visible values of record source of @a lookup if they are already cached
+    QSharedPointer<const Values> cachedValues(const KDbLookupFieldSchema &lookup) const;
+
+    //! @return key of bound value @a value
+    static inline QString key(const QVariant &value) { return value.toString(); }
+
+    //! @return true if no values are cached
+    inline bool isEmpty() const { return m_entries.isEmpty(); }
+
+    /*! Discards values depending on table @a tableName and notifies listeners.
+     Empty @a tableName discards all values. */
+    void tableChanged(const QString &tableName);
+
+    //! Discards all values without notifying listeners
+    void clear();
+
+    //! Maximum number of records of a cached record source, 0 disables the cache
+    int maxRecords = 0;
+
+    QList<KDbLookupValuesListener*> listeners;
+
+private:
+    //! Cached record source
+    struct Entry {
+        QSharedPointer<const Values> values; //!< @c nullptr if the record source is too large
+        QStringList tables; //!< lower-case names of tables the values depend on
+    };
+
+    //! Loads values of record source of @a lookup into @a entry, @return false on failure
+    bool load(const KDbLookupFieldSchema &lookup, Entry *entry);
+
+    KDbConnection * const m_conn;
+    QHash<QString, Entry> m_entries;
+    Q_DISABLE_COPY(KDbLookupValueCache)
+};
+
+#endif
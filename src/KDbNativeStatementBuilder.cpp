@@ -19,6 +19,7 @@
 
 #include "KDbNativeStatementBuilder.h"
 #include "KDbConnection.h"
+#include "KDbConnection_p.h"
 #include "kdb_debug.h"
 #include "KDbDriverBehavior.h"
 #include "KDbDriver_p.h"
@@ -29,6 +30,7 @@
 #include "KDbQuerySchema.h"
 #include "KDbQuerySchemaParameter.h"
 #include "KDbRelationship.h"
+#include "KDbStatementBuffer_p.h"
 
 KDbSelectStatementOptions::~KDbSelectStatementOptions()
 {
@@ -36,13 +38,124 @@ KDbSelectStatementOptions::~KDbSelectStatementOptions()
 
 //================================================
 
+//! Kind of statement generated by selectStatementInternal()
+enum class SelectStatementKind {
+    Records, //!< "SELECT <columns> ..." statement
+    Count,   //!< "SELECT COUNT(*) ..." statement without columns and ORDER BY
+    Exists   //!< "SELECT 1 ..." statement without columns and ORDER BY
+};
+
+static bool selectStatementInternal(KDbStatementBuffer *sql,
+                                    KDbConnection *connection,
+                                    KDb::IdentifierEscapingType dialect,
+                                    KDbQuerySchema* querySchema,
+                                    const KDbSelectStatementOptions& options,
+                                    const QList<QVariant>& parameters,
+                                    SelectStatementKind kind = SelectStatementKind::Records);
+
+//! @return true if @a expr contains call of an aggregate function
+static bool containsAggregate(const KDbExpression &expr)
+{
+    if (expr.expressionClass() == KDb::AggregationExpression) {
+        return true;
+    }
+    if (expr.isFunction()) {
+        return containsAggregate(expr.toFunction().arguments());
+    }
+    if (expr.isNArg()) {
+        const KDbNArgExpression nargExpr(expr.toNArg());
+        for (int i = 0; i < nargExpr.argCount(); ++i) {
+            if (containsAggregate(nargExpr.arg(i))) {
+                return true;
+            }
+        }
+    } else if (expr.isUnary()) {
+        return containsAggregate(expr.toUnary().arg());
+    } else if (expr.isBinary()) {
+        const KDbBinaryExpression binaryExpr(expr.toBinary());
+        return containsAggregate(binaryExpr.left()) || containsAggregate(binaryExpr.right());
+    }
+    return false;
+}
+
 class Q_DECL_HIDDEN KDbNativeStatementBuilder::Private
 {
 public:
-    Private() {}
+    Private(KDbConnection *conn, KDb::IdentifierEscapingType _dialect)
+        : connection(conn)
+        , dialect(_dialect)
+        , buffer(dialect == KDb::DriverEscaping && conn ? conn->driver() : nullptr)
+    {
+    }
+
+    bool generateSelectStatement(KDbEscapedString *target, KDbQuerySchema* querySchema,
+                                 const KDbSelectStatementOptions& options,
+                                 const QList<QVariant>& parameters)
+    {
+        buffer.clear();
+        if (!selectStatementInternal(&buffer, connection, dialect, querySchema, options, parameters)) {
+            return false;
+        }
+        *target = buffer.statement();
+        return true;
+    }
+
+    /*! Generates statement of kind @a kind for counting records of @a querySchema or checking
+     if there is any record. Columns, lookup joins and ORDER BY do not change number of records
+     so they are omitted. Queries with aggregate functions or native statements are wrapped
+     in a subquery. */
+    bool generateCountingStatement(KDbEscapedString *target, KDbQuerySchema* querySchema,
+                                   const QList<QVariant>& parameters, SelectStatementKind kind)
+    {
+        KDbSelectStatementOptions options;
+        options.setAddVisibleLookupColumns(false);
+        buffer.clear();
+        if (isCountable(querySchema)) {
+            if (!selectStatementInternal(&buffer, connection, dialect, querySchema, options,
+                                         parameters, kind))
+            {
+                return false;
+            }
+        } else {
+            buffer.append(kind == SelectStatementKind::Count ? "SELECT COUNT(*) FROM ("
+                                                             : "SELECT 1 FROM (");
+            if (!selectStatementInternal(&buffer, connection, dialect, querySchema, options,
+                                         parameters))
+            {
+                return false;
+            }
+            buffer.append(") AS kdb__subquery");
+        }
+        *target = buffer.statement();
+        return true;
+    }
+
+    //! @return true if number of records of @a querySchema does not depend on its columns
+    static bool isCountable(KDbQuerySchema* querySchema)
+    {
+        if (!querySchema->statement().isEmpty()) {
+            return false;
+        }
+        for (const KDbField *f : *querySchema->fields()) {
+            if (f->isExpression() && containsAggregate(f->expression())) {
+                return false; // e.g. "SELECT COUNT(*) FROM t" always returns one record
+            }
+        }
+        return true;
+    }
+
+    //! @return true if visible values of @a lookup are cached by @a connection,
+    //! the values are loaded if needed
+    static bool hasCachedLookupValues(KDbConnection *connection, const KDbLookupFieldSchema &lookup)
+    {
+        return connection && !connection->d->lookupValues.values(lookup).isNull();
+    }
+
     //! @todo use equivalent of QPointer<KDbConnection>
     KDbConnection *connection;
     KDb::IdentifierEscapingType dialect;
+    //! Buffer reused for generated statements
+    KDbStatementBuffer buffer;
 
 private:
     Q_DISABLE_COPY(Private)
@@ -52,10 +165,8 @@ private:
 
 KDbNativeStatementBuilder::KDbNativeStatementBuilder(KDbConnection *connection,
                                                      KDb::IdentifierEscapingType dialect)
-    : d(new Private)
+    : d(new Private(connection, dialect))
 {
-    d->connection = connection;
-    d->dialect = dialect;
 }
 
 KDbNativeStatementBuilder::~KDbNativeStatementBuilder()
@@ -63,25 +174,26 @@ KDbNativeStatementBuilder::~KDbNativeStatementBuilder()
     delete d;
 }
 
-static bool selectStatementInternal(KDbEscapedString *target,
+static bool selectStatementInternal(KDbStatementBuffer *sql,
                                     KDbConnection *connection,
                                     KDb::IdentifierEscapingType dialect,
                                     KDbQuerySchema* querySchema,
                                     const KDbSelectStatementOptions& options,
-                                    const QList<QVariant>& parameters)
+                                    const QList<QVariant>& parameters,
+                                    SelectStatementKind kind)
 {
-    Q_ASSERT(target);
+    Q_ASSERT(sql);
     Q_ASSERT(querySchema);
 //"SELECT FROM ..." is theoretically allowed "
 //if (querySchema.fieldCount()<1)
 //  return QString();
 // Each SQL identifier needs to be escaped in the generated query.
 
-    const KDbDriver *driver = dialect == KDb::DriverEscaping ? connection->driver() : nullptr;
+    const KDbDriver *driver = sql->driver();
 
     if (!querySchema->statement().isEmpty()) {
 //! @todo replace with KDbNativeQuerySchema? It shouldn't be here.
-        *target = querySchema->statement();
+        sql->append(querySchema->statement());
         return true;
     }
 
@@ -102,10 +214,10 @@ static bool selectStatementInternal(KDbEscapedString *target,
         }
     }
 
-    KDbEscapedString sql; //final sql string
-    sql.reserve(4096);
-    KDbEscapedString s_additional_joins; //additional joins needed for lookup fields
-    KDbEscapedString s_additional_fields; //additional fields to append to the fields list
+    sql->append("SELECT ");
+    const int columnsStart = sql->length();
+    KDbStatementBuffer s_additional_joins(driver, 0); //additional joins needed for lookup fields
+    KDbStatementBuffer s_additional_fields(driver, 0); //additional fields to append to the fields list
     int internalUniqueTableAliasNumber = 0; //used to build internalUniqueTableAliases
     int internalUniqueQueryAliasNumber = 0; //used to build internalUniqueQueryAliases
     number = 0;
@@ -115,14 +227,23 @@ static bool selectStatementInternal(KDbEscapedString *target,
     KDbQuerySchemaParameterValueListIterator *paramValuesItPtr
         = parameters.isEmpty() ? nullptr : &paramValuesIt;
     foreach(KDbField *f, *querySchema->fields()) {
+        if (kind != SelectStatementKind::Records) {
+            // columns are not selected but parameters of their expressions precede
+            // parameters of the WHERE expression
+            if (paramValuesItPtr && querySchema->isColumnVisible(number) && f->isExpression()) {
+                f->expression().toString(driver, paramValuesItPtr);
+            }
+            number++;
+            continue;
+        }
         if (querySchema->isColumnVisible(number)) {
-            if (!sql.isEmpty())
-                sql += ", ";
+            if (sql->length() > columnsStart)
+                sql->append(", ");
 
             if (f->isQueryAsterisk()) {
                 KDbQueryAsterisk *asterisk = static_cast<KDbQueryAsterisk*>(f);
                 if (!singleTable && asterisk->isSingleTableAsterisk()) { //single-table *
-                    sql.append(KDb::escapeIdentifier(driver, asterisk->table()->name())).append(".*");
+                    sql->appendIdentifier(asterisk->table()->name()).append(".*");
                 } else {
                     /* All-tables asterisk
                      NOTE: do not output in this form because there can be extra tables
@@ -134,18 +255,19 @@ static bool selectStatementInternal(KDbEscapedString *target,
                      - use this: SELECT orders.*, customers.contactname FROM orders LEFT OUTER JOIN
                                  customers ON orders.customerid=customers.customerid
                     */
-                    KDbEscapedString s_tables;
+                    bool firstTable = true;
                     for (KDbTableSchema *table : qAsConst(*tables)) {
-                        if (!s_tables.isEmpty()) {
-                            s_tables += ", ";
+                        if (firstTable) {
+                            firstTable = false;
+                        } else {
+                            sql->append(", ");
                         }
-                        s_tables.append(KDb::escapeIdentifier(driver, table->name()) + QLatin1String(".*"));
+                        sql->appendIdentifier(table->name()).append(".*");
                     }
-                    sql += s_tables;
                 }
             } else {
                 if (f->isExpression()) {
-                    sql += f->expression().toString(driver, paramValuesItPtr);
+                    sql->append(f->expression().toString(driver, paramValuesItPtr));
                 } else {
                     if (!f->table()) {//sanity check
                         return false;
@@ -166,19 +288,29 @@ static bool selectStatementInternal(KDbEscapedString *target,
                         }
                     }
                     if (!singleTable && !tableName.isEmpty()) {
-                        sql.append(KDb::escapeIdentifier(driver, tableName)).append('.');
+                        sql->appendIdentifier(tableName).append('.');
                     }
-                    sql += KDb::escapeIdentifier(driver, f->name());
+                    sql->appendIdentifier(f->name());
                 }
                 const QString aliasString(querySchema->columnAlias(number));
                 if (!aliasString.isEmpty()) {
-                    sql.append(" AS ").append(KDb::escapeIdentifier(driver, aliasString));
+                    sql->append(" AS ").appendIdentifier(aliasString);
                 }
 //! @todo add option that allows to omit "AS" keyword
             }
             KDbLookupFieldSchema *lookupFieldSchema = (options.addVisibleLookupColumns() && f->table())
                                                    ? f->table()->lookupFieldSchema(*f) : nullptr;
-            if (lookupFieldSchema && lookupFieldSchema->boundColumn() >= 0) {
+            if (lookupFieldSchema && lookupFieldSchema->boundColumn() >= 0
+                && options.useLookupValueCache()
+                && KDbNativeStatementBuilder::Private::hasCachedLookupValues(connection,
+                                                                            *lookupFieldSchema))
+            {
+                // Visible value is set by the cursor using the connection's lookup value cache,
+                // NULL keeps position of the remaining columns
+                if (!s_additional_fields.isEmpty())
+                    s_additional_fields.append(", ");
+                s_additional_fields.append("NULL");
+            } else if (lookupFieldSchema && lookupFieldSchema->boundColumn() >= 0) {
                 // Lookup field schema found
                 // Now we also need to fetch "visible" value from the lookup table, not only the value of binding.
                 // -> build LEFT OUTER JOIN clause for this purpose (LEFT, not INNER because the binding can be broken)
@@ -194,26 +326,25 @@ static bool selectStatementInternal(KDbEscapedString *target,
                             && (boundField = lookupTable->field(lookupFieldSchema->boundColumn()))) {
                         //add LEFT OUTER JOIN
                         if (!s_additional_joins.isEmpty())
-                            s_additional_joins += ' ';
+                            s_additional_joins.append(' ');
                         const QString internalUniqueTableAlias(
                             QLatin1String("__kdb_") + lookupTable->name() + QLatin1Char('_')
                             + QString::number(internalUniqueTableAliasNumber++));
-                        s_additional_joins += KDbEscapedString("LEFT OUTER JOIN %1 AS %2 ON %3.%4=%5.%6")
-                            .arg(KDb::escapeIdentifier(driver, lookupTable->name()))
-                            .arg(KDb::escapeIdentifier(driver, internalUniqueTableAlias))
-                            .arg(KDb::escapeIdentifier(driver, querySchema->tableAliasOrName(f->table()->name())))
-                            .arg(KDb::escapeIdentifier(driver, f->name()))
-                            .arg(KDb::escapeIdentifier(driver, internalUniqueTableAlias))
-                            .arg(KDb::escapeIdentifier(driver, boundField->name()));
+                        s_additional_joins.append("LEFT OUTER JOIN ")
+                            .appendIdentifier(lookupTable->name())
+                            .append(" AS ").appendIdentifier(internalUniqueTableAlias)
+                            .append(" ON ")
+                            .appendIdentifier(querySchema->tableAliasOrName(f->table()->name()), f->name())
+                            .append('=').appendIdentifier(internalUniqueTableAlias, boundField->name());
 
                         //add visibleField to the list of SELECTed fields //if it is not yet present there
                         if (!s_additional_fields.isEmpty())
-                            s_additional_fields += ", ";
+                            s_additional_fields.append(", ");
 //! @todo Add lookup schema option for separator other than ' ' or even option for placeholders like "Name ? ?"
 //! @todo Add possibility for joining the values at client side.
-                        s_additional_fields += visibleColumns->sqlFieldsList(
+                        s_additional_fields.append(visibleColumns->sqlFieldsList(
                                                    connection, QLatin1String(" || ' ' || "), internalUniqueTableAlias,
-                                                   dialect);
+                                                   dialect));
                     }
                     delete visibleColumns;
                 } else if (recordSource.type() == KDbLookupFieldSchemaRecordSource::Type::Query) {
@@ -240,30 +371,25 @@ static bool selectStatementInternal(KDbEscapedString *target,
                     }
                     //add LEFT OUTER JOIN
                     if (!s_additional_joins.isEmpty())
-                        s_additional_joins += ' ';
-                    KDbEscapedString internalUniqueQueryAlias(KDb::escapeIdentifier(
-                        driver,
+                        s_additional_joins.append(' ');
+                    const QString internalUniqueQueryAlias(
                         kdb_subquery_prefix + lookupQuery->name() + QLatin1Char('_')
-                            + QString::number(internalUniqueQueryAliasNumber++)));
-                    KDbNativeStatementBuilder builder(connection, dialect);
-                    KDbEscapedString subSql;
-                    if (!builder.generateSelectStatement(&subSql, lookupQuery, options,
-                                                         parameters))
+                            + QString::number(internalUniqueQueryAliasNumber++));
+                    s_additional_joins.append("LEFT OUTER JOIN (");
+                    if (!selectStatementInternal(&s_additional_joins, connection, dialect, lookupQuery,
+                                                 options, parameters))
                     {
                         return false;
                     }
-                    s_additional_joins += KDbEscapedString("LEFT OUTER JOIN (%1) AS %2 ON %3.%4=%5.%6")
-                        .arg(subSql)
-                        .arg(internalUniqueQueryAlias)
-                        .arg(KDb::escapeIdentifier(driver, f->table()->name()))
-                        .arg(KDb::escapeIdentifier(driver, f->name()))
-                        .arg(internalUniqueQueryAlias)
-                        .arg(KDb::escapeIdentifier(driver, boundColumnInfo->aliasOrName()));
+                    s_additional_joins.append(") AS ").appendIdentifier(internalUniqueQueryAlias)
+                        .append(" ON ").appendIdentifier(f->table()->name(), f->name())
+                        .append('=').appendIdentifier(internalUniqueQueryAlias,
+                                                      boundColumnInfo->aliasOrName());
 
                     if (!s_additional_fields.isEmpty())
-                        s_additional_fields += ", ";
+                        s_additional_fields.append(", ");
                     const QList<int> visibleColumns(lookupFieldSchema->visibleColumns());
-                    KDbEscapedString expression;
+                    bool firstColumn = true;
                     foreach(int visibleColumnIndex, visibleColumns) {
 //! @todo Add lookup schema option for separator other than ' ' or even option for placeholders like "Name ? ?"
 //! @todo Add possibility for joining the values at client side.
@@ -272,14 +398,13 @@ static bool selectStatementInternal(KDbEscapedString *target,
                             << fieldsExpanded.count() << " <= " << visibleColumnIndex;
                             return false;
                         }
-                        if (!expression.isEmpty())
-                            expression += " || ' ' || ";
-                        expression += (
-                            internalUniqueQueryAlias + '.'
-                            + KDb::escapeIdentifier(driver, fieldsExpanded.value(visibleColumnIndex)->aliasOrName())
-                        );
+                        if (firstColumn)
+                            firstColumn = false;
+                        else
+                            s_additional_fields.append(" || ' ' || ");
+                        s_additional_fields.appendIdentifier(
+                            internalUniqueQueryAlias, fieldsExpanded.value(visibleColumnIndex)->aliasOrName());
                     }
-                    s_additional_fields += expression;
                 }
                 else {
                     kdbWarning() << "unsupported record source type" << recordSource.typeName();
@@ -290,105 +415,117 @@ static bool selectStatementInternal(KDbEscapedString *target,
         number++;
     }
 
+    if (kind == SelectStatementKind::Count) {
+        sql->append("COUNT(*)");
+    } else if (kind == SelectStatementKind::Exists) {
+        sql->append('1');
+    }
+
     //add lookup fields
     if (!s_additional_fields.isEmpty())
-        sql += (", " + s_additional_fields);
+        sql->append(", ").append(s_additional_fields);
 
     if (driver && options.alsoRetrieveRecordId()) { //append rowid column
         //! @todo Check if the rowid isn't already part of regular SELECT columns, if so, don't add
-        KDbEscapedString s;
-        if (!sql.isEmpty())
-            s = ", ";
+        if (sql->length() > columnsStart)
+            sql->append(", ");
         if (querySchema->masterTable()) {
-            s += KDb::escapeIdentifier(driver, querySchema->tableAliasOrName(querySchema->masterTable()->name()));
-            s += '.';
+            sql->appendIdentifier(querySchema->tableAliasOrName(querySchema->masterTable()->name()));
+            sql->append('.');
         }
-        s += KDbDriverPrivate::behavior(driver)->ROW_ID_FIELD_NAME;
-        sql += s;
+        sql->append(KDbDriverPrivate::behavior(driver)->ROW_ID_FIELD_NAME);
     }
 
-    if (sql.isEmpty()) {
-        sql.prepend("SELECT"); // "SELECT FROM ..." case
-    } else {
-        sql.prepend("SELECT ");
+    if (sql->length() == columnsStart) {
+        sql->truncate(columnsStart - 1); // "SELECT FROM ..." case
     }
     if (!tables->isEmpty() || !subqueries_for_lookup_data.isEmpty()) {
-        sql += " FROM ";
-        KDbEscapedString s_from;
+        sql->append(" FROM ");
         number = 0;
         foreach(KDbTableSchema *table, *tables) {
-            if (!s_from.isEmpty())
-                s_from += ", ";
-            s_from += KDb::escapeIdentifier(driver, table->name());
+            if (number > 0)
+                sql->append(", ");
+            sql->appendIdentifier(table->name());
             const QString aliasString(querySchema->tableAlias(number));
             if (!aliasString.isEmpty())
-                s_from.append(" AS ").append(KDb::escapeIdentifier(driver, aliasString));
+                sql->append(" AS ").appendIdentifier(aliasString);
             number++;
         }
         // add subqueries for lookup data
         int subqueries_for_lookup_data_counter = 0;
         foreach(KDbQuerySchema* subQuery, subqueries_for_lookup_data) {
-            if (!s_from.isEmpty())
-                s_from += ", ";
-            KDbEscapedString subSql;
-            if (!selectStatementInternal(&subSql, connection, dialect, subQuery, options, parameters)) {
+            if (number > 0 || subqueries_for_lookup_data_counter > 0)
+                sql->append(", ");
+            sql->append('(');
+            if (!selectStatementInternal(sql, connection, dialect, subQuery, options, parameters)) {
                 return false;
             }
-            s_from += '(' + subSql + ") AS "
-                + KDb::escapeIdentifier(
-                      driver,
-                      kdb_subquery_prefix + QString::number(subqueries_for_lookup_data_counter++));
+            sql->append(") AS ").appendIdentifier(
+                kdb_subquery_prefix + QString::number(subqueries_for_lookup_data_counter++));
         }
-        sql += s_from;
     }
-    KDbEscapedString s_where;
-    s_where.reserve(4096);
 
     //JOINS
     if (!s_additional_joins.isEmpty()) {
-        sql += ' ' + s_additional_joins + ' ';
+        sql->append(' ').append(s_additional_joins).append(' ');
     }
 
 //! @todo: we're using WHERE for joins now; use INNER/LEFT/RIGHT JOIN later
 
     //WHERE
-    bool wasWhere = false; //for later use
+    const int whereStart = sql->length();
+    sql->append(" WHERE ");
+    const int conditionsStart = sql->length();
+    const bool wasWhere = !querySchema->relationships()->isEmpty();
+    const bool hasWhereExpression = !querySchema->whereExpression().isNull();
+    if (wasWhere && hasWhereExpression) {
+        //! @todo () are not always needed
+        sql->append('(');
+    }
+    bool firstRelationship = true;
     foreach(KDbRelationship *rel, *querySchema->relationships()) {
-        if (s_where.isEmpty()) {
-            wasWhere = true;
-        } else
-            s_where += " AND ";
-        KDbEscapedString s_where_sub;
+        if (firstRelationship)
+            firstRelationship = false;
+        else
+            sql->append(" AND ");
+        const bool multiplePairs = rel->fieldPairs()->count() > 1;
+        if (multiplePairs) {
+            sql->append('(');
+        }
+        bool firstPair = true;
         foreach(const KDbField::Pair &pair, *rel->fieldPairs()) {
-            if (!s_where_sub.isEmpty())
-                s_where_sub += " AND ";
-            s_where_sub +=
-               KDbEscapedString(KDb::escapeIdentifier(driver, pair.first->table()->name())) + '.' +
-               KDb::escapeIdentifier(driver, pair.first->name()) + " = " +
-               KDb::escapeIdentifier(driver, pair.second->table()->name()) + '.' +
-               KDb::escapeIdentifier(driver, pair.second->name());
+            if (firstPair)
+                firstPair = false;
+            else
+                sql->append(" AND ");
+            sql->appendIdentifier(pair.first->table()->name(), pair.first->name())
+                .append(" = ")
+                .appendIdentifier(pair.second->table()->name(), pair.second->name());
         }
-        if (rel->fieldPairs()->count() > 1) {
-            s_where_sub.prepend('(');
-            s_where_sub += ')';
+        if (multiplePairs) {
+            sql->append(')');
         }
-        s_where += s_where_sub;
     }
     //EXPLICITLY SPECIFIED WHERE EXPRESSION
-    if (!querySchema->whereExpression().isNull()) {
+    if (hasWhereExpression) {
         if (wasWhere) {
-            //! @todo () are not always needed
-            s_where = '(' + s_where + ") AND ("
-                + querySchema->whereExpression().toString(driver, paramValuesItPtr) + ')';
-        } else {
-            s_where = querySchema->whereExpression().toString(driver, paramValuesItPtr);
+            sql->append(") AND (");
         }
+        sql->append(querySchema->whereExpression().toString(driver, paramValuesItPtr));
+        if (wasWhere) {
+            sql->append(')');
+        }
+    }
+    if (sql->length() == conditionsStart) {
+        sql->truncate(whereStart);
     }
-    if (!s_where.isEmpty())
-        sql += " WHERE " + s_where;
 //! @todo (js) add other sql parts
     //(use wasWhere here)
 
+    if (kind != SelectStatementKind::Records) { // order does not matter
+        return true;
+    }
+
     // ORDER BY
     KDbEscapedString orderByString(querySchema->orderByColumnList()->toSqlString(
         !singleTable /*includeTableName*/, connection, querySchema, dialect));
@@ -413,10 +550,8 @@ static bool selectStatementInternal(KDbEscapedString *target,
                                                        connection, querySchema, dialect);
     }
     if (!orderByString.isEmpty())
-        sql += (" ORDER BY " + orderByString);
+        sql->append(" ORDER BY ").append(orderByString);
 
-    //kdbDebug() << sql;
-    *target = sql;
     return true;
 }
 
@@ -425,15 +560,14 @@ bool KDbNativeStatementBuilder::generateSelectStatement(KDbEscapedString *target
                                                         const KDbSelectStatementOptions& options,
                                                         const QList<QVariant>& parameters) const
 {
-    return selectStatementInternal(target, d->connection, d->dialect, querySchema, options, parameters);
+    return d->generateSelectStatement(target, querySchema, options, parameters);
 }
 
 bool KDbNativeStatementBuilder::generateSelectStatement(KDbEscapedString *target,
                                                         KDbQuerySchema* querySchema,
                                                         const QList<QVariant>& parameters) const
 {
-    return selectStatementInternal(target, d->connection, d->dialect, querySchema, KDbSelectStatementOptions(),
-                                   parameters);
+    return d->generateSelectStatement(target, querySchema, KDbSelectStatementOptions(), parameters);
 }
 
 bool KDbNativeStatementBuilder::generateSelectStatement(KDbEscapedString *target,
@@ -443,6 +577,27 @@ bool KDbNativeStatementBuilder::generateSelectStatement(KDbEscapedString *target
     return generateSelectStatement(target, tableSchema->query(), options);
 }
 
+bool KDbNativeStatementBuilder::generateCountStatement(KDbEscapedString *target,
+                                                       KDbQuerySchema* querySchema,
+                                                       const QList<QVariant>& parameters) const
+{
+    return d->generateCountingStatement(target, querySchema, parameters,
+                                        SelectStatementKind::Count);
+}
+
+bool KDbNativeStatementBuilder::generateExistsStatement(KDbEscapedString *target,
+                                                        KDbQuerySchema* querySchema,
+                                                        const QList<QVariant>& parameters) const
+{
+    if (!d->generateCountingStatement(target, querySchema, parameters,
+                                      SelectStatementKind::Exists))
+    {
+        return false;
+    }
+    *target = d->connection->driver()->addLimitTo1(*target);
+    return true;
+}
+
 bool KDbNativeStatementBuilder::generateCreateTableStatement(KDbEscapedString *target,
                                                              const KDbTableSchema& tableSchema) const
 {
@@ -450,86 +605,85 @@ bool KDbNativeStatementBuilder::generateCreateTableStatement(KDbEscapedString *t
         return false;
     }
     // Each SQL identifier needs to be escaped in the generated query.
-    const KDbDriver *driver = d->dialect == KDb::DriverEscaping ? d->connection->driver() : nullptr;
-    KDbEscapedString sql;
-    sql.reserve(4096);
-    sql = KDbEscapedString("CREATE TABLE ")
-            + KDb::escapeIdentifier(driver, tableSchema.name()) + " (";
+    const KDbDriver *driver = d->buffer.driver();
+    const KDbDriverBehavior *behavior = d->connection->driver()->behavior();
+    KDbStatementBuffer &sql(d->buffer);
+    sql.clear();
+    sql.append("CREATE TABLE ").appendIdentifier(tableSchema.name()).append(" (");
     bool first = true;
     for (const KDbField *field : *tableSchema.fields()) {
         if (first)
             first = false;
         else
-            sql += ", ";
-        KDbEscapedString v = KDbEscapedString(KDb::escapeIdentifier(driver, field->name())) + ' ';
+            sql.append(", ");
+        sql.appendIdentifier(field->name()).append(' ');
         const bool autoinc = field->isAutoIncrement();
         const bool pk = field->isPrimaryKey() || (autoinc && driver && driver->behavior()->AUTO_INCREMENT_REQUIRES_PK);
 //! @todo warning: ^^^^^ this allows only one autonumber per table when AUTO_INCREMENT_REQUIRES_PK==true!
         const KDbField::Type type = field->type(); // cache: evaluating type of expressions can be expensive
-        if (autoinc && d->connection->driver()->behavior()->SPECIAL_AUTO_INCREMENT_DEF) {
+        if (autoinc && behavior->SPECIAL_AUTO_INCREMENT_DEF) {
             if (pk)
-                v.append(d->connection->driver()->behavior()->AUTO_INCREMENT_TYPE).append(' ')
-                 .append(d->connection->driver()->behavior()->AUTO_INCREMENT_PK_FIELD_OPTION);
+                sql.append(behavior->AUTO_INCREMENT_TYPE).append(' ')
+                   .append(behavior->AUTO_INCREMENT_PK_FIELD_OPTION);
             else
-                v.append(d->connection->driver()->behavior()->AUTO_INCREMENT_TYPE).append(' ')
-                 .append(d->connection->driver()->behavior()->AUTO_INCREMENT_FIELD_OPTION);
+                sql.append(behavior->AUTO_INCREMENT_TYPE).append(' ')
+                   .append(behavior->AUTO_INCREMENT_FIELD_OPTION);
         } else {
-            if (autoinc && !d->connection->driver()->behavior()->AUTO_INCREMENT_TYPE.isEmpty())
-                v += d->connection->driver()->behavior()->AUTO_INCREMENT_TYPE;
+            if (autoinc && !behavior->AUTO_INCREMENT_TYPE.isEmpty())
+                sql.append(behavior->AUTO_INCREMENT_TYPE);
             else
-                v += d->connection->driver()->sqlTypeName(type, *field);
+                sql.append(d->connection->driver()->sqlTypeName(type, *field));
 
             if (KDbField::isIntegerType(type) && field->isUnsigned()) {
-                v.append(' ').append(d->connection->driver()->behavior()->UNSIGNED_TYPE_KEYWORD);
+                sql.append(' ').append(behavior->UNSIGNED_TYPE_KEYWORD);
             }
 
             if (KDbField::isFPNumericType(type) && field->precision() > 0) {
+                sql.append('(').appendNumber(field->precision());
                 if (field->scale() > 0)
-                    v += QString::fromLatin1("(%1,%2)").arg(field->precision()).arg(field->scale());
-                else
-                    v += QString::fromLatin1("(%1)").arg(field->precision());
+                    sql.append(',').appendNumber(field->scale());
+                sql.append(')');
             }
             else if (type == KDbField::Text) {
                 int realMaxLen;
-                if (d->connection->driver()->behavior()->TEXT_TYPE_MAX_LENGTH == 0) {
+                if (behavior->TEXT_TYPE_MAX_LENGTH == 0) {
                     realMaxLen = field->maxLength(); // allow to skip (N)
                 }
                 else { // max length specified by driver
                     if (field->maxLength() == 0) { // as long as possible
-                        realMaxLen = d->connection->driver()->behavior()->TEXT_TYPE_MAX_LENGTH;
+                        realMaxLen = behavior->TEXT_TYPE_MAX_LENGTH;
                     }
                     else { // not longer than specified by driver
-                        realMaxLen = qMin(d->connection->driver()->behavior()->TEXT_TYPE_MAX_LENGTH, field->maxLength());
+                        realMaxLen = qMin(behavior->TEXT_TYPE_MAX_LENGTH, field->maxLength());
                     }
                 }
                 if (realMaxLen > 0) {
-                    v += QString::fromLatin1("(%1)").arg(realMaxLen);
+                    sql.append('(').appendNumber(realMaxLen).append(')');
                 }
             }
 
             if (autoinc) {
-                v.append(' ').append(pk ? d->connection->driver()->behavior()->AUTO_INCREMENT_PK_FIELD_OPTION
-                                        : d->connection->driver()->behavior()->AUTO_INCREMENT_FIELD_OPTION);
+                sql.append(' ').append(pk ? behavior->AUTO_INCREMENT_PK_FIELD_OPTION
+                                          : behavior->AUTO_INCREMENT_FIELD_OPTION);
             }
             else {
                 //! @todo here is automatically a single-field key created
                 if (pk)
-                    v += " PRIMARY KEY";
+                    sql.append(" PRIMARY KEY");
             }
             if (!pk && field->isUniqueKey())
-                v += " UNIQUE";
+                sql.append(" UNIQUE");
 ///@todo IS this ok for all engines?: if (!autoinc && !field->isPrimaryKey() && field->isNotNull())
             if (!autoinc && !pk && field->isNotNull())
-                v += " NOT NULL"; //only add not null option if no autocommit is set
+                sql.append(" NOT NULL"); //only add not null option if no autocommit is set
             if (d->connection->driver()->supportsDefaultValue(*field) && field->defaultValue().isValid()) {
                 KDbEscapedString valToSql(d->connection->driver()->valueToSql(field, field->defaultValue()));
                 if (!valToSql.isEmpty()) //for sanity
-                    v += " DEFAULT " + valToSql;
+                    sql.append(" DEFAULT ").append(valToSql);
             }
         }
-        sql += v;
     }
-    sql += ')';
-    *target = sql;
+    sql.append(')');
+    *target = sql.statement();
     return true;
 }
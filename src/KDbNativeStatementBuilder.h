@@ -66,6 +66,27 @@ public:
     bool generateSelectStatement(KDbEscapedString *target, KDbTableSchema* tableSchema,
                                  const KDbSelectStatementOptions& options = KDbSelectStatementOptions()) const;
 
+    /*! Generates a native "SELECT COUNT(*) ..." statement string that can be used for counting
+     records of query defined by @a querySchema and @a parameters.
+
+     Columns, relations (LEFT OUTER JOIN) for visible lookup columns and ORDER BY do not change
+     number of records so they are omitted. If the query contains aggregate functions or is
+     defined by a native statement, it is counted as a subquery.
+     @a target and @a querySchema must not be 0. The statement is written to @ref *target on success.
+     @return true on success.
+     @since 3.3 */
+    bool generateCountStatement(KDbEscapedString *target, KDbQuerySchema* querySchema,
+                                const QList<QVariant>& parameters = QList<QVariant>()) const;
+
+    /*! Generates a native "SELECT 1 ... LIMIT 1" statement string that returns one record
+     if query defined by @a querySchema and @a parameters returns any record, and no records
+     otherwise. Parts of the query are omitted like in generateCountStatement().
+     @a target and @a querySchema must not be 0. The statement is written to @ref *target on success.
+     @return true on success.
+     @since 3.3 */
+    bool generateExistsStatement(KDbEscapedString *target, KDbQuerySchema* querySchema,
+                                 const QList<QVariant>& parameters = QList<QVariant>()) const;
+
     /*! Generates a native "CREATE TABLE ..." statement string that can be used for creation
      of @a tableSchema in the database. The statement is written to @ref *target on success.
      @return true on success.
@@ -0,0 +1,280 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbPrefetchCursor_p.h"
+#include "KDbConnection.h"
+#include "KDbRecordData.h"
+
+//! Maximum number of batches in the ring of a prefetching cursor
+static const int PREFETCH_RING_CAPACITY = 4;
+
+KDbPrefetchBatch::KDbPrefetchBatch(int recordSize, int capacity)
+    : recordSize(recordSize)
+{
+    values.reserve(recordSize * capacity);
+}
+
+//--------------------------------------
+
+KDbPrefetchRing::KDbPrefetchRing(int capacity)
+    : m_slots(capacity, nullptr)
+    , m_freeSlots(capacity)
+{
+}
+
+KDbPrefetchRing::~KDbPrefetchRing()
+{
+    qDeleteAll(m_slots);
+}
+
+bool KDbPrefetchRing::push(KDbPrefetchBatch *batch)
+{
+    m_freeSlots.acquire();
+    if (m_cancelled.load()) {
+        delete batch;
+        return false;
+    }
+    m_slots[m_tail] = batch;
+    m_tail = (m_tail + 1) % m_slots.count();
+    m_usedSlots.release();
+    return true;
+}
+
+KDbPrefetchBatch* KDbPrefetchRing::pop()
+{
+    m_usedSlots.acquire();
+    KDbPrefetchBatch *batch = m_slots[m_head];
+    m_slots[m_head] = nullptr;
+    m_head = (m_head + 1) % m_slots.count();
+    m_freeSlots.release();
+    return batch;
+}
+
+void KDbPrefetchRing::cancel()
+{
+    m_cancelled.store(1);
+    m_freeSlots.release(); // wakes up the producer blocked in push()
+}
+
+//--------------------------------------
+
+KDbPrefetchThread::KDbPrefetchThread(KDbPrefetchCursor *cursor)
+    : m_cursor(cursor)
+{
+}
+
+void KDbPrefetchThread::run()
+{
+    m_cursor->produce();
+}
+
+//--------------------------------------
+
+KDbPrefetchCursor* KDbPrefetchCursor::create(KDbCursor *cursor)
+{
+    Q_ASSERT(cursor);
+    // the driver's cursor is deleted by this cursor, not by the connection
+    cursor->connection()->takeCursor(cursor);
+    cursor->setInternal();
+    const Options options((cursor->options() & ~Options(Option::Buffered)) | Option::Prefetch);
+    if (cursor->query()) {
+        return new KDbPrefetchCursor(cursor, cursor->query(), options);
+    }
+    return new KDbPrefetchCursor(cursor, cursor->rawSql(), options);
+}
+
+KDbPrefetchCursor::KDbPrefetchCursor(KDbCursor *cursor, KDbQuerySchema *query, Options options)
+    : KDbCursor(cursor->connection(), query, options)
+    , m_cursor(cursor)
+{
+    setQueryParameters(cursor->queryParameters());
+}
+
+KDbPrefetchCursor::KDbPrefetchCursor(KDbCursor *cursor, const KDbEscapedString &sql,
+                                     Options options)
+    : KDbCursor(cursor->connection(), sql, options)
+    , m_cursor(cursor)
+{
+}
+
+KDbPrefetchCursor::~KDbPrefetchCursor()
+{
+    close();
+    delete m_cursor;
+}
+
+QVariant KDbPrefetchCursor::value(int i)
+{
+    if (!m_batch || m_record < 0 || i < 0 || i >= m_batch->recordSize) {
+        return QVariant();
+    }
+    return m_batch->value(m_record, i);
+}
+
+const char ** KDbPrefetchCursor::recordData() const
+{
+    return nullptr;
+}
+
+bool KDbPrefetchCursor::drv_open(const KDbEscapedString &sql)
+{
+    Q_UNUSED(sql)
+    m_cursor->setQueryParameters(queryParameters());
+    if (!m_cursor->open()) {
+        m_result = m_cursor->result();
+        return false;
+    }
+    const int depth = prefetchDepth();
+    const int capacity = qMin(PREFETCH_RING_CAPACITY, depth);
+    m_batchSize = qMax(1, depth / capacity);
+    m_batch.reset();
+    m_record = -1;
+    m_ring.reset(new KDbPrefetchRing(capacity));
+    m_thread.reset(new KDbPrefetchThread(this));
+    m_thread->start();
+    return true;
+}
+
+bool KDbPrefetchCursor::drv_close()
+{
+    stopProducer();
+    return m_cursor->close();
+}
+
+void KDbPrefetchCursor::stopProducer()
+{
+    if (m_ring) {
+        m_ring->cancel();
+    }
+    if (m_thread) {
+        m_thread->wait();
+    }
+    m_thread.reset();
+    m_ring.reset();
+    m_batch.reset();
+    m_record = -1;
+}
+
+void KDbPrefetchCursor::produce()
+{
+    // values of raw statements are decoded by value() because drivers store them
+    // as strings in drv_storeCurrentRecord()
+    const bool rawStatement = !m_cursor->m_query;
+    KDbRecordData data;
+    QScopedPointer<KDbPrefetchBatch> batch;
+    bool fetched = m_cursor->moveFirst();
+    while (true) {
+        if (!batch) {
+            batch.reset(new KDbPrefetchBatch(rawStatement ? m_cursor->m_fieldCount
+                                                          : m_cursor->m_fieldsToStoreInRecord,
+                                             m_batchSize));
+        }
+        if (!fetched) {
+            batch->end = true;
+            batch->error = m_cursor->result().isError();
+            batch->result = m_cursor->result();
+        } else if (rawStatement) {
+            for (int i = 0; i < batch->recordSize; ++i) {
+                batch->values.append(m_cursor->value(i));
+            }
+            ++batch->recordCount;
+        } else {
+            data.resize(batch->recordSize);
+            if (m_cursor->drv_storeCurrentRecord(&data)) {
+                for (int i = 0; i < batch->recordSize; ++i) {
+                    batch->values.append(data.at(i));
+                }
+                ++batch->recordCount;
+            } else {
+                batch->end = true;
+                batch->error = true;
+                batch->result = m_cursor->result();
+            }
+        }
+        batch->fieldCount = m_cursor->m_fieldCount;
+        batch->fieldsToStoreInRecord = m_cursor->m_fieldsToStoreInRecord;
+        if (batch->end || batch->recordCount == m_batchSize) {
+            const bool end = batch->end;
+            if (!m_ring->push(batch.take()) || end) {
+                return;
+            }
+        }
+        if (m_ring->isCancelled()) {
+            return;
+        }
+        fetched = m_cursor->moveNext();
+    }
+}
+
+void KDbPrefetchCursor::drv_getNextRecord()
+{
+    if (m_batch && m_record + 1 < m_batch->recordCount) {
+        ++m_record;
+        m_fetchResult = FetchResult::Ok;
+        return;
+    }
+    while (!m_batch || !m_batch->end) {
+        m_batch.reset(m_ring->pop());
+        m_record = -1;
+        m_fieldCount = m_batch->fieldCount;
+        m_fieldsToStoreInRecord = m_batch->fieldsToStoreInRecord;
+        if (m_batch->recordCount > 0) {
+            m_record = 0;
+            m_fetchResult = FetchResult::Ok;
+            return;
+        }
+    }
+    m_record = m_batch->recordCount;
+    if (m_batch->error) {
+        m_result = m_batch->result; // details of the error are kept by getNextRecord()
+        m_fetchResult = FetchResult::Error;
+    } else {
+        m_fetchResult = FetchResult::End;
+    }
+}
+
+void KDbPrefetchCursor::drv_appendCurrentRecordToBuffer()
+{
+    // not buffered
+}
+
+void KDbPrefetchCursor::drv_bufferMovePointerNext()
+{
+}
+
+void KDbPrefetchCursor::drv_bufferMovePointerPrev()
+{
+}
+
+void KDbPrefetchCursor::drv_bufferMovePointerTo(qint64 at)
+{
+    Q_UNUSED(at)
+}
+
+bool KDbPrefetchCursor::drv_storeCurrentRecord(KDbRecordData *data) const
+{
+    if (!m_batch || m_record < 0 || m_record >= m_batch->recordCount) {
+        return false;
+    }
+    const int count = qMin(data->count(), m_batch->recordSize);
+    for (int i = 0; i < count; ++i) {
+        (*data)[i] = m_batch->value(m_record, i);
+    }
+    return true;
+}
@@ -0,0 +1,153 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_PREFETCHCURSOR_P_H
+#define KDB_PREFETCHCURSOR_P_H
+
+#include "KDbCursor.h"
+
+#include <QAtomicInt>
+#include <QScopedPointer>
+#include <QSemaphore>
+#include <QThread>
+#include <QVector>
+
+class KDbPrefetchCursor;
+
+//! @internal Records fetched by the producer thread of KDbPrefetchCursor
+class KDbPrefetchBatch
+{
+public:
+    KDbPrefetchBatch(int recordSize, int capacity);
+
+    //! @return value of column @a column of record @a record
+    inline const QVariant& value(int record, int column) const {
+        return values.at(record * recordSize + column);
+    }
+
+    const int recordSize; //!< number of values of each record
+    int recordCount = 0;
+    QVector<QVariant> values; //!< values of records, record after record
+    int fieldCount = 0; //!< field count of the fetching cursor after the last record
+    int fieldsToStoreInRecord = 0; //!< record size of the fetching cursor after the last record
+    bool end = false; //!< true if there are no more records after this batch
+    bool error = false; //!< true if fetching failed after the last record of this batch
+    KDbResult result; //!< result of the fetching cursor if error is true
+};
+
+/*! @internal Bounded ring of batches passed from a single producer to a single consumer.
+ Slots are handed over using two semaphores counting free and used slots, so the producer
+ blocks while all slots are used and the consumer blocks while no slot is used. Each index
+ is only modified by one of the threads, no mutex is locked. */
+class KDbPrefetchRing
+{
+public:
+    explicit KDbPrefetchRing(int capacity);
+
+    //! Deletes batches that were not taken
+    ~KDbPrefetchRing();
+
+    /*! Appends @a batch, blocks while the ring is full. Ownership of @a batch is passed
+     to the ring. @return false if the ring has been cancelled, @a batch is deleted then. */
+    bool push(KDbPrefetchBatch *batch);
+
+    //! Takes the oldest batch, blocks while the ring is empty.
+    //! Ownership of the batch is passed to the caller.
+    KDbPrefetchBatch* pop();
+
+    //! Cancels the ring, push() returns false from now on
+    void cancel();
+
+    //! @return true if the ring has been cancelled
+    inline bool isCancelled() const { return m_cancelled.load(); }
+
+private:
+    QVector<KDbPrefetchBatch*> m_slots;
+    QSemaphore m_freeSlots;
+    QSemaphore m_usedSlots;
+    int m_head = 0; //!< next slot to pop, used by the consumer only
+    int m_tail = 0; //!< next slot to push, used by the producer only
+    QAtomicInt m_cancelled;
+    Q_DISABLE_COPY(KDbPrefetchRing)
+};
+
+//! @internal Thread fetching records of KDbPrefetchCursor
+class KDbPrefetchThread : public QThread
+{
+public:
+    explicit KDbPrefetchThread(KDbPrefetchCursor *cursor);
+
+protected:
+    void run() override;
+
+private:
+    KDbPrefetchCursor * const m_cursor;
+    Q_DISABLE_COPY(KDbPrefetchThread)
+};
+
+/*! @internal Cursor with the KDbCursor::Option::Prefetch option.
+
+ Records are fetched by a driver's cursor in a separate thread and passed in batches
+ through a bounded ring, see KDbCursor::setPrefetchDepth(). The driver's cursor is owned
+ by this cursor and is only used by the producer thread between opening and closing. */
+class KDbPrefetchCursor : public KDbCursor
+{
+public:
+    /*! @return cursor prefetching records of driver's cursor @a cursor.
+     Ownership of @a cursor is passed to the returned cursor. */
+    static KDbPrefetchCursor* create(KDbCursor *cursor);
+
+    ~KDbPrefetchCursor() override;
+
+    QVariant value(int i) override;
+
+    //! @return @c nullptr, records are not stored as strings
+    const char ** recordData() const override;
+
+protected:
+    bool drv_open(const KDbEscapedString &sql) override;
+    bool drv_close() override;
+    void drv_getNextRecord() override;
+    void drv_appendCurrentRecordToBuffer() override;
+    void drv_bufferMovePointerNext() override;
+    void drv_bufferMovePointerPrev() override;
+    void drv_bufferMovePointerTo(qint64 at) override;
+    bool drv_storeCurrentRecord(KDbRecordData *data) const override;
+
+private:
+    KDbPrefetchCursor(KDbCursor *cursor, KDbQuerySchema *query, Options options);
+    KDbPrefetchCursor(KDbCursor *cursor, const KDbEscapedString &sql, Options options);
+
+    //! Fetches records of m_cursor into m_ring, called by the producer thread
+    void produce();
+
+    //! Stops the producer thread and deletes batches that were not consumed
+    void stopProducer();
+
+    KDbCursor * const m_cursor; //!< driver's cursor
+    QScopedPointer<KDbPrefetchRing> m_ring;
+    QScopedPointer<KDbPrefetchThread> m_thread;
+    QScopedPointer<KDbPrefetchBatch> m_batch; //!< batch containing the current record
+    int m_record = -1; //!< current record in m_batch
+    int m_batchSize = 0; //!< number of records in a batch, set on opening
+    friend class KDbPrefetchThread;
+    Q_DISABLE_COPY(KDbPrefetchCursor)
+};
+
+#endif
@@ -18,9 +18,12 @@
 */
 
 #include "KDbPreparedStatement.h"
+#include "KDbConnection.h"
+#include "KDbConnection_p.h"
 #include "KDbPreparedStatementInterface.h"
 #include "KDbSqlResult.h"
 #include "KDbTableSchema.h"
+#include "KDbTracer_p.h"
 #include "kdb_debug.h"
 
 KDbPreparedStatement::Data::Data()
@@ -34,6 +37,7 @@ KDbPreparedStatement::Data::Data(Type _type, KDbPreparedStatementInterface* _ifa
     : type(_type), fields(_fields), whereFieldNames(_whereFieldNames)
     , fieldsForParameters(nullptr), whereFields(nullptr), dirty(true), iface(_iface)
     , lastInsertRecordId(std::numeric_limits<quint64>::max())
+    , connection(nullptr)
 {
 }
 
@@ -61,28 +65,47 @@ KDbPreparedStatement::~KDbPreparedStatement()
 
 bool KDbPreparedStatement::execute(const KDbPreparedStatementParameters& parameters)
 {
+    KDbTraceScope trace(d->connection ? d->connection->tracer() : nullptr,
+                        KDbTraceEvent::Type::ExecutePreparedStatement);
     if (d->dirty) {
         KDbEscapedString s;
-        if (!generateStatementString(&s)) { // sets d->fieldsForParameters too
+        const bool generated = generateStatementString(&s); // sets d->fieldsForParameters too
+        trace.mark(&KDbTraceEvent::generateTime);
+        if (!generated) {
             m_result.setCode(ERR_OTHER);
+            trace.finish(s, false);
             return false;
         }
 //! @todo error message?
         if (s.isEmpty()) {
             m_result.setCode(ERR_OTHER);
+            trace.finish(s, false);
             return false;
         }
-        if (!d->iface->prepare(s)) {
+        const bool prepared = d->iface->prepare(s);
+        trace.mark(&KDbTraceEvent::prepareTime);
+        if (!prepared) {
             m_result.setCode(ERR_OTHER);
+            trace.finish(s, false);
             return false;
         }
+        d->sql = s;
         d->dirty = false;
+    } else if (trace.isActive()) {
+        trace.event()->cacheHit = true;
     }
     QSharedPointer<KDbSqlResult> result
         = d->iface->execute(d->type, *d->fieldsForParameters, d->fields, parameters);
+    trace.mark(&KDbTraceEvent::executeTime);
+    trace.finish(d->sql, !result.isNull());
     if (!result) {
         return false;
     }
+    if (d->type == InsertStatement && d->connection && !d->fields->isEmpty()
+        && d->fields->field(0)->table())
+    {
+        d->connection->d->tableModified(d->fields->field(0)->table()->name());
+    }
     d->lastInsertRecordId = result->lastInsertRecordId();
     return true;
 }
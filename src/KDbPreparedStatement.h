@@ -27,6 +27,7 @@
 #include "KDbField.h"
 #include "KDbResult.h"
 
+class KDbConnection;
 class KDbFieldList;
 class KDbPreparedStatementInterface;
 
@@ -99,6 +100,8 @@ public:
                     //!< prepared (possible again) before calling executeInternal()
         KDbPreparedStatementInterface *iface;
         quint64 lastInsertRecordId;
+        KDbConnection *connection; //!< connection that created the statement, used for tracing
+        KDbEscapedString sql; //!< recently prepared statement, used for tracing
     };
 
     //! Creates an invalid prepared statement.
@@ -992,45 +992,24 @@ KDbQuerySchemaFieldsExpanded *KDbQuerySchema::computeFieldsExpanded(KDbConnectio
         }
         cache->columnsOrderExpanded.insert(ci, i);
         //remember field by name/alias/table.name if there's no such string yet in d->columnInfosByNameExpanded
-        if (!ci->alias().isEmpty()) {
-            //store alias and table.alias
-            if (!cache->columnInfosByNameExpanded.contains(ci->alias())) {
-                cache->columnInfosByNameExpanded.insert(ci->alias(), ci);
-            }
-            QString tableAndAlias(ci->alias());
-            if (ci->field()->table())
-                tableAndAlias.prepend(ci->field()->table()->name() + QLatin1Char('.'));
-            if (!cache->columnInfosByNameExpanded.contains(tableAndAlias)) {
-                cache->columnInfosByNameExpanded.insert(tableAndAlias, ci);
-            }
-            //the same for "unexpanded" list
-            if (columnInfosOutsideAsterisks.contains(ci)) {
-                if (!cache->columnInfosByName.contains(ci->alias())) {
-                    cache->columnInfosByName.insert(ci->alias(), ci);
-                }
-                if (!cache->columnInfosByName.contains(tableAndAlias)) {
-                    cache->columnInfosByName.insert(tableAndAlias, ci);
-                }
-            }
-        } else {
-            //no alias: store name and table.name
-            if (!cache->columnInfosByNameExpanded.contains(ci->field()->name())) {
-                cache->columnInfosByNameExpanded.insert(ci->field()->name(), ci);
-            }
-            QString tableAndName(ci->field()->name());
-            if (ci->field()->table())
-                tableAndName.prepend(ci->field()->table()->name() + QLatin1Char('.'));
-            if (!cache->columnInfosByNameExpanded.contains(tableAndName)) {
-                cache->columnInfosByNameExpanded.insert(tableAndName, ci);
+        //store alias and table.alias or name and table.name if there is no alias
+        const QString name(ci->alias().isEmpty() ? ci->field()->name() : ci->alias());
+        const QString tableAndName(ci->field()->table()
+                                   ? ci->field()->table()->name() + QLatin1Char('.') + name
+                                   : name);
+        if (!cache->columnInfosByNameExpanded.contains(name)) {
+            cache->columnInfosByNameExpanded.insert(name, ci);
+        }
+        if (!cache->columnInfosByNameExpanded.contains(tableAndName)) {
+            cache->columnInfosByNameExpanded.insert(tableAndName, ci);
+        }
+        //the same for "unexpanded" list
+        if (columnInfosOutsideAsterisks.contains(ci)) {
+            if (!cache->columnInfosByName.contains(name)) {
+                cache->columnInfosByName.insert(name, ci);
             }
-            //the same for "unexpanded" list
-            if (columnInfosOutsideAsterisks.contains(ci)) {
-                if (!cache->columnInfosByName.contains(ci->field()->name())) {
-                    cache->columnInfosByName.insert(ci->field()->name(), ci);
-                }
-                if (!cache->columnInfosByName.contains(tableAndName)) {
-                    cache->columnInfosByName.insert(tableAndName, ci);
-                }
+            if (!cache->columnInfosByName.contains(tableAndName)) {
+                cache->columnInfosByName.insert(tableAndName, ci);
             }
         }
     }
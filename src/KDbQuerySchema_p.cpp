@@ -143,13 +143,14 @@ void KDbQuerySchemaPrivate::tryRegenerateExprAliases()
 
 bool KDbQuerySchemaPrivate::setColumnAliasInternal(int position, const QString& alias)
 {
-    const int currentPos = columnPositionsForAliases.value(alias.toLower(), -1);
+    const int currentPos = columnPositionForAlias(alias);
     if (currentPos == position) {
         return true; // already set
     }
     if (currentPos == -1) {
-        columnAliases.insert(position, alias.toLower());
-        columnPositionsForAliases.insert(alias.toLower(), position);
+        const QString aliasLower(alias.toLower());
+        columnAliases.insert(position, aliasLower);
+        columnPositionsForAliases.insert(aliasLower, position);
         maxIndexWithAlias = qMax(maxIndexWithAlias, position);
         return true;
     }
@@ -24,6 +24,7 @@
 #include "KDbExpression.h"
 #include "KDbQueryColumnInfo.h"
 #include "KDbQuerySchema.h"
+#include "KDbUtils_p.h"
 
 #include <QBitArray>
 #include <QWeakPointer>
@@ -77,11 +78,12 @@ public:
     bool setColumnAlias(int position, const QString& alias);
 
     inline bool setTableAlias(int position, const QString& alias) {
-        if (tablePositionsForAliases.contains(alias.toLower())) {
+        if (tablePositionForAlias(alias) != -1) {
             return false;
         }
-        tableAliases.insert(position, alias.toLower());
-        tablePositionsForAliases.insert(alias.toLower(), position);
+        const QString aliasLower(alias.toLower());
+        tableAliases.insert(position, aliasLower);
+        tablePositionsForAliases.insert(aliasLower, position);
         return true;
     }
 
@@ -105,11 +107,11 @@ public:
     }
 
     inline int tablePositionForAlias(const QString& alias) const {
-        return tablePositionsForAliases.value(alias.toLower(), -1);
+        return kdbValueForLowerCaseName(tablePositionsForAliases, alias, -1);
     }
 
     inline int columnPositionForAlias(const QString& alias) const {
-        return columnPositionsForAliases.value(alias.toLower(), -1);
+        return kdbValueForLowerCaseName(columnPositionsForAliases, alias, -1);
     }
 
     //! Accessor for buildSelectQuery()
@@ -139,10 +141,10 @@ protected:
     /*! Used to mapping columns to its aliases for this query */
     QHash<int, QString> columnAliases;
 
-    /*! Collects table positions for aliases: used in tablePositionForAlias(). */
+    /*! Collects table positions for lowercase aliases: used in tablePositionForAlias(). */
     QHash<QString, int> tablePositionsForAliases;
 
-    /*! Collects column positions for aliases: used in columnPositionForAlias(). */
+    /*! Collects column positions for lowercase aliases: used in columnPositionForAlias(). */
     QHash<QString, int> columnPositionsForAliases;
 
 public:
@@ -260,6 +262,7 @@ public:
      by fieldsExpanded() */
     QHash<KDbQueryColumnInfo*, int> columnsOrderExpanded;
 
+    //! Column infos by names, aliases, "table.name" and "table.alias" strings
     QHash<QString, KDbQueryColumnInfo*> columnInfosByNameExpanded;
 
     QHash<QString, KDbQueryColumnInfo*> columnInfosByName; //!< Same as columnInfosByNameExpanded but asterisks are skipped
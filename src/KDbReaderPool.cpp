@@ -0,0 +1,323 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbReaderPool.h"
+#include "KDbConnection.h"
+#include "KDbConnectionData.h"
+#include "KDbConnectionOptions.h"
+#include "KDbDriver.h"
+#include "KDbDriverMetaData.h"
+#include "kdb_debug.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QThread>
+
+KDbReadSnapshotData::KDbReadSnapshotData()
+{
+}
+
+KDbReadSnapshotData::~KDbReadSnapshotData()
+{
+}
+
+//--------------------------------------
+
+KDbReadSnapshot::KDbReadSnapshot()
+{
+}
+
+KDbReadSnapshot::KDbReadSnapshot(KDbReadSnapshotData *data)
+    : d(data)
+{
+}
+
+KDbReadSnapshot::~KDbReadSnapshot()
+{
+}
+
+bool KDbReadSnapshot::isNull() const
+{
+    return d.isNull();
+}
+
+bool KDbReadSnapshot::operator==(const KDbReadSnapshot &other) const
+{
+    return d == other.d;
+}
+
+//--------------------------------------
+
+class Q_DECL_HIDDEN KDbReaderPool::Private
+{
+public:
+    Private() {}
+
+    //! Data of a thread using the pool
+    struct ThreadData {
+        KDbConnection *connection = nullptr; //!< reader connection of the thread
+        bool inSnapshot = false;
+        KDbResult result; //!< result of the last operation called from the thread
+        QMetaObject::Connection finishedConnection; //!< connection to QThread::finished()
+    };
+
+    //! Closes and deletes @a connection, @return true on successful close
+    static bool deleteReader(KDbConnection *connection) {
+        const bool ok = connection->disconnect();
+        delete connection;
+        return ok;
+    }
+
+    /*! @return data of the calling thread, created if needed. Data of a thread is removed
+     when the thread finishes, so a new thread created at the same address does not get it.
+     The mutex should be locked. */
+    ThreadData& currentThreadData(KDbReaderPool *pool) {
+        QThread *thread = QThread::currentThread();
+        ThreadData &data = threads[thread];
+        if (!data.finishedConnection) {
+            // finished() is emitted by the finishing thread so its reader can be deleted there
+            data.finishedConnection = QObject::connect(thread, &QThread::finished,
+                [pool]() { pool->releaseThread(); });
+        }
+        return data;
+    }
+
+    KDbConnection *writer = nullptr;
+    int maxReaders = 0;
+    int readerCount = 0;
+    //! Guards thread data and creating or deleting connections, the driver is not thread-safe
+    mutable QMutex mutex;
+    QHash<QThread*, ThreadData> threads;
+private:
+    Q_DISABLE_COPY(Private)
+};
+
+KDbReaderPool::KDbReaderPool(KDbConnection *writer, int maxReaders)
+    : d(new Private)
+{
+    Q_ASSERT(writer);
+    d->writer = writer;
+    d->maxReaders = maxReaders > 0 ? maxReaders : qMax(1, QThread::idealThreadCount());
+}
+
+KDbReaderPool::~KDbReaderPool()
+{
+    QMutexLocker locker(&d->mutex);
+    for (const Private::ThreadData &data : d->threads) {
+        QObject::disconnect(data.finishedConnection);
+        if (data.connection && !Private::deleteReader(data.connection)) {
+            kdbWarning() << "Could not close reader connection";
+        }
+    }
+    d->threads.clear();
+    locker.unlock();
+    delete d;
+}
+
+KDbConnection* KDbReaderPool::writer() const
+{
+    return d->writer;
+}
+
+int KDbReaderPool::maxReaders() const
+{
+    return d->maxReaders;
+}
+
+int KDbReaderPool::readerCount() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->readerCount;
+}
+
+KDbResult KDbReaderPool::result() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->threads.value(QThread::currentThread()).result;
+}
+
+void KDbReaderPool::clearResult()
+{
+    QMutexLocker locker(&d->mutex);
+    auto it = d->threads.find(QThread::currentThread());
+    if (it != d->threads.end()) {
+        it->result = KDbResult();
+    }
+}
+
+KDbConnection* KDbReaderPool::reader()
+{
+    QMutexLocker locker(&d->mutex);
+    return readerLocked();
+}
+
+KDbConnection* KDbReaderPool::readerLocked()
+{
+    Private::ThreadData &data = d->currentThreadData(this);
+    if (data.connection) {
+        return data.connection;
+    }
+    data.result = KDbResult();
+    if (!d->writer->isDatabaseUsed()) {
+        data.result = KDbResult(ERR_NO_DB_USED, tr("No database is used by the writer connection."));
+        return nullptr;
+    }
+    if (d->readerCount >= d->maxReaders) {
+        data.result = KDbResult(ERR_OTHER, tr("Maximum number of %1 readers has been reached.")
+                                               .arg(d->maxReaders));
+        return nullptr;
+    }
+    // Copy options of the writer except the read-only flag that can't be changed
+    // for a copy because the copy still refers to the writer connection.
+    KDbConnectionOptions options;
+    const KDbConnectionOptions *writerOptions = d->writer->options();
+    for (const QByteArray &name : writerOptions->names()) {
+        if (name != "readOnly") {
+            options.insert(name, writerOptions->property(name).value());
+        }
+    }
+    options.setReadOnly(true);
+    KDbConnection *connection = d->writer->driver()->createConnection(d->writer->data(), options);
+    if (!connection) {
+        data.result = d->writer->driver()->result();
+        return nullptr;
+    }
+    if (!connection->connect() || !connection->useDatabase(d->writer->currentDatabase())) {
+        data.result = connection->result();
+        Private::deleteReader(connection);
+        return nullptr;
+    }
+    data.connection = connection;
+    data.inSnapshot = false;
+    ++d->readerCount;
+    return connection;
+}
+
+bool KDbReaderPool::releaseReader()
+{
+    QMutexLocker locker(&d->mutex);
+    return releaseReaderLocked();
+}
+
+bool KDbReaderPool::releaseReaderLocked()
+{
+    auto it = d->threads.find(QThread::currentThread());
+    if (it == d->threads.end()) {
+        return true;
+    }
+    it->result = KDbResult();
+    KDbConnection *connection = it->connection;
+    if (!connection) {
+        return true;
+    }
+    if (it->inSnapshot) {
+        connection->drv_endReadSnapshot();
+    }
+    it->connection = nullptr;
+    it->inSnapshot = false;
+    --d->readerCount;
+    if (!Private::deleteReader(connection)) {
+        it->result = KDbResult(ERR_CLOSE_FAILED, tr("Could not close reader connection."));
+        return false;
+    }
+    return true;
+}
+
+void KDbReaderPool::releaseThread()
+{
+    QMutexLocker locker(&d->mutex);
+    if (!releaseReaderLocked()) {
+        kdbWarning() << "Could not close reader connection of finished thread";
+    }
+    QObject::disconnect(d->threads.take(QThread::currentThread()).finishedConnection);
+}
+
+KDbReadSnapshot KDbReaderPool::pinSnapshot()
+{
+    QMutexLocker locker(&d->mutex);
+    KDbConnection *connection = readerLocked();
+    if (!connection) {
+        return KDbReadSnapshot();
+    }
+    Private::ThreadData &data = d->currentThreadData(this);
+    if (data.inSnapshot) {
+        data.result = KDbResult(ERR_TRANSACTION_ACTIVE,
+                                tr("Reader of the current thread is already in a snapshot."));
+        return KDbReadSnapshot();
+    }
+    KDbReadSnapshotData *snapshotData = connection->drv_pinReadSnapshot();
+    if (!snapshotData) {
+        if (connection->result().isError()) {
+            data.result = connection->result();
+        } else {
+            data.result = KDbResult(ERR_UNSUPPORTED_DRV_FEATURE,
+                                    tr("Snapshots are not supported for \"%1\" driver.")
+                                       .arg(connection->driver()->metaData()->name()));
+        }
+        return KDbReadSnapshot();
+    }
+    snapshotData->pool = this;
+    data.inSnapshot = true;
+    return KDbReadSnapshot(snapshotData);
+}
+
+bool KDbReaderPool::beginSnapshot(const KDbReadSnapshot &snapshot)
+{
+    QMutexLocker locker(&d->mutex);
+    Private::ThreadData &data = d->currentThreadData(this);
+    data.result = KDbResult();
+    if (snapshot.isNull() || snapshot.d->pool != this) {
+        data.result = KDbResult(ERR_OTHER,
+                                tr("Snapshot has not been pinned by this reader pool."));
+        return false;
+    }
+    KDbConnection *connection = readerLocked();
+    if (!connection) {
+        return false;
+    }
+    if (data.inSnapshot) {
+        data.result = KDbResult(ERR_TRANSACTION_ACTIVE,
+                                tr("Reader of the current thread is already in a snapshot."));
+        return false;
+    }
+    if (!connection->drv_beginReadSnapshot(snapshot.d.data())) {
+        data.result = connection->result();
+        return false;
+    }
+    data.inSnapshot = true;
+    return true;
+}
+
+bool KDbReaderPool::endSnapshot()
+{
+    QMutexLocker locker(&d->mutex);
+    Private::ThreadData &data = d->currentThreadData(this);
+    data.result = KDbResult();
+    if (!data.connection || !data.inSnapshot) {
+        data.result = KDbResult(ERR_NO_TRANSACTION_ACTIVE,
+                                tr("Reader of the current thread is not in a snapshot."));
+        return false;
+    }
+    data.inSnapshot = false;
+    if (!data.connection->drv_endReadSnapshot()) {
+        data.result = data.connection->result();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,177 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_READERPOOL_H
+#define KDB_READERPOOL_H
+
+#include <QCoreApplication>
+#include <QSharedPointer>
+
+#include "KDbResult.h"
+
+class KDbConnection;
+class KDbReaderPool;
+
+/*! @brief Driver-specific data of a read snapshot
+
+ Drivers supporting snapshots subclass it and return objects of the subclass
+ from KDbConnection::drv_pinReadSnapshot(). Native resources should be freed in the destructor.
+ @since 3.3
+*/
+class KDB_EXPORT KDbReadSnapshotData
+{
+public:
+    KDbReadSnapshotData();
+    virtual ~KDbReadSnapshotData();
+
+private:
+    KDbReaderPool *pool = nullptr; //!< pool that pinned the snapshot
+    friend class KDbReaderPool;
+    Q_DISABLE_COPY(KDbReadSnapshotData)
+};
+
+/*! @brief Handle of a consistent state of a database pinned by KDbReaderPool::pinSnapshot()
+
+ The handle is implicitly shared and can be passed between threads.
+ Native snapshot is freed when the last copy of the handle is destroyed.
+ @since 3.3
+*/
+class KDB_EXPORT KDbReadSnapshot
+{
+public:
+    //! Creates a null snapshot
+    KDbReadSnapshot();
+
+    ~KDbReadSnapshot();
+
+    //! @return true if this is a null snapshot
+    bool isNull() const;
+
+    //! @return true if @a other refers to the same snapshot
+    bool operator==(const KDbReadSnapshot &other) const;
+
+    //! @return true if @a other refers to other snapshot
+    inline bool operator!=(const KDbReadSnapshot &other) const { return !operator==(other); }
+
+private:
+    explicit KDbReadSnapshot(KDbReadSnapshotData *data);
+
+    QSharedPointer<KDbReadSnapshotData> d;
+    friend class KDbReaderPool;
+};
+
+/*! @brief A pool of read-only connections bound to threads
+
+ The pool allows concurrent reads from the database used by a single writer connection.
+ Each thread calling reader() gets its own read-only connection to the same database,
+ created on first use and reused by subsequent calls from that thread. A connection obtained
+ from the pool should only be used by the thread that obtained it.
+
+ For SQLite the writer should use write-ahead logging, e.g. by setting
+ KDbConnectionOptions::PerformanceProfile::FastWal before connecting. Then readers do not block
+ the writer and the writer does not block readers.
+
+ Several queries can see the same, consistent state of the database using snapshots:
+ pinSnapshot() starts a read transaction on reader of the calling thread and returns
+ a handle that other threads can pass to beginSnapshot() to read the same state.
+ The pinning reader keeps the snapshot available until endSnapshot() is called from its thread.
+ Snapshots are optional driver feature; for SQLite they require a library built with
+ the SQLITE_ENABLE_SNAPSHOT option.
+
+ Methods of the pool can be called from any thread. In case of failure result() contains
+ the error; results are kept separately for each thread. Errors of queries are available
+ from the reader connections.
+
+ The writer connection is not owned by the pool and has to outlive it; readers are
+ owned by the pool. Reader of a thread is deleted automatically when the thread finishes,
+ so threads using the pool should finish before the pool is deleted.
+ @since 3.3
+*/
+class KDB_EXPORT KDbReaderPool : public KDbResultable
+{
+    Q_DECLARE_TR_FUNCTIONS(KDbReaderPool)
+public:
+    /*! Creates a pool of readers for database used by @a writer.
+     At most @a maxReaders connections are created; if @a maxReaders is 0,
+     QThread::idealThreadCount() is used. */
+    explicit KDbReaderPool(KDbConnection *writer, int maxReaders = 0);
+
+    //! Closes and deletes all readers
+    ~KDbReaderPool() override;
+
+    //! @return the writer connection
+    KDbConnection* writer() const;
+
+    //! @return maximum number of readers
+    int maxReaders() const;
+
+    //! @return number of readers created so far and not released
+    int readerCount() const;
+
+    /*! @return result of the last operation performed by the pool for the calling thread.
+     Hides KDbResultable::result() because results are kept for each thread separately. */
+    KDbResult result() const;
+
+    //! Clears result of the calling thread, hides KDbResultable::clearResult()
+    void clearResult();
+
+    /*! @return read-only connection bound to the calling thread.
+     The connection is created if needed. @c nullptr is returned if the writer is not
+     connected to a database, maximum number of readers has been reached or the reader could
+     not be opened. The connection is owned by the pool. */
+    KDbConnection* reader();
+
+    /*! Closes and deletes reader of the calling thread, if there is one.
+     It is called automatically when a thread that used reader() finishes.
+     @return false if the reader could not be closed cleanly. */
+    bool releaseReader();
+
+    /*! Starts a read transaction on reader of the calling thread and pins its state.
+     Until endSnapshot() is called, queries executed by the reader see the pinned state and
+     other threads can read the same state using beginSnapshot().
+     @return null snapshot on failure, e.g. if the driver does not support snapshots
+     or the reader is already in a snapshot. */
+    KDbReadSnapshot pinSnapshot();
+
+    /*! Starts a read transaction on reader of the calling thread that sees
+     state of the database pinned by @a snapshot.
+     @return false on failure, e.g. if the pinning reader already ended the snapshot and
+     the database has been checkpointed since then. */
+    bool beginSnapshot(const KDbReadSnapshot &snapshot);
+
+    /*! Ends read transaction started on reader of the calling thread by pinSnapshot()
+     or beginSnapshot(). */
+    bool endSnapshot();
+
+private:
+    //! Implementation of reader(), the mutex should be locked
+    KDbConnection* readerLocked();
+
+    //! Implementation of releaseReader(), the mutex should be locked
+    bool releaseReaderLocked();
+
+    //! Releases reader and result of the calling thread when it finishes
+    void releaseThread();
+
+    Q_DISABLE_COPY(KDbReaderPool)
+    class Private;
+    Private * const d;
+};
+
+#endif
@@ -0,0 +1,405 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbResultCache_p.h"
+#include "KDbConnection.h"
+#include "KDbLookupFieldSchema.h"
+#include "KDbQuerySchema.h"
+#include "KDbRecordData.h"
+#include "KDbTableSchema.h"
+
+#include <QDataStream>
+
+//! @return approximate number of bytes occupied by @a value stored as variant
+static int variantSize(const QVariant &value)
+{
+    int size = int(sizeof(QVariant));
+    switch (value.type()) {
+    case QVariant::String:
+        size += value.toString().size() * int(sizeof(QChar));
+        break;
+    case QVariant::ByteArray:
+        size += value.toByteArray().size();
+        break;
+    default:;
+    }
+    return size;
+}
+
+KDbResultCacheData::KDbResultCacheData()
+{
+}
+
+bool KDbResultCacheData::append(const KDbRecordData &data, int maxSize)
+{
+    if (m_recordCount == 0) {
+        m_columns.resize(data.count());
+    }
+    for (int i = 0; i < m_columns.count(); ++i) {
+        append(&m_columns[i], m_recordCount, i < data.count() ? data.at(i) : QVariant());
+    }
+    ++m_recordCount;
+    return m_size <= maxSize;
+}
+
+void KDbResultCacheData::append(Column *column, int record, const QVariant &value)
+{
+    if (column->storage == Column::Storage::Undecided) {
+        if (!value.isValid()) {
+            column->nulls.resize(record + 1);
+            column->nulls.setBit(record);
+            return;
+        }
+        if (value.isNull()) { // typed nulls are only preserved by variants
+            column->storage = Column::Storage::Variant;
+        } else {
+            switch (value.type()) {
+            case QVariant::Bool:
+            case QVariant::Int:
+            case QVariant::UInt:
+            case QVariant::LongLong:
+            case QVariant::ULongLong:
+                column->storage = Column::Storage::Integer;
+                column->type = value.type();
+                break;
+            case QVariant::Double:
+                column->storage = Column::Storage::Real;
+                break;
+            default:
+                column->storage = Column::Storage::Variant;
+            }
+        }
+        switch (column->storage) {
+        case Column::Storage::Integer:
+            column->integers.resize(record);
+            m_size += record * int(sizeof(qint64));
+            break;
+        case Column::Storage::Real:
+            column->reals.resize(record);
+            m_size += record * int(sizeof(double));
+            break;
+        default:
+            column->variants.resize(record);
+            column->nulls.clear();
+            m_size += record * int(sizeof(QVariant));
+        }
+    }
+    switch (column->storage) {
+    case Column::Storage::Integer:
+        if (!value.isValid()) {
+            column->nulls.resize(record + 1);
+            column->nulls.setBit(record);
+            column->integers.append(0);
+            m_size += int(sizeof(qint64));
+            return;
+        }
+        if (value.type() == column->type && !value.isNull()) {
+            column->integers.append(value.type() == QVariant::ULongLong
+                                    ? qint64(value.toULongLong()) : value.toLongLong());
+            m_size += int(sizeof(qint64));
+            return;
+        }
+        convertToVariants(column, record);
+        break;
+    case Column::Storage::Real:
+        if (!value.isValid()) {
+            column->nulls.resize(record + 1);
+            column->nulls.setBit(record);
+            column->reals.append(0.0);
+            m_size += int(sizeof(double));
+            return;
+        }
+        if (value.type() == QVariant::Double && !value.isNull()) {
+            column->reals.append(value.toDouble());
+            m_size += int(sizeof(double));
+            return;
+        }
+        convertToVariants(column, record);
+        break;
+    default:;
+    }
+    column->variants.append(value);
+    m_size += variantSize(value);
+}
+
+void KDbResultCacheData::convertToVariants(Column *column, int recordCount)
+{
+    QVector<QVariant> variants;
+    variants.reserve(recordCount + 1);
+    const int numberSize = column->storage == Column::Storage::Integer
+            ? int(sizeof(qint64)) : int(sizeof(double));
+    for (int i = 0; i < recordCount; ++i) {
+        if (i < column->nulls.size() && column->nulls.testBit(i)) {
+            variants.append(QVariant());
+        } else if (column->storage == Column::Storage::Integer) {
+            const qint64 integer = column->integers.at(i);
+            switch (column->type) {
+            case QVariant::Bool: variants.append(QVariant(integer != 0)); break;
+            case QVariant::Int: variants.append(QVariant(int(integer))); break;
+            case QVariant::UInt: variants.append(QVariant(uint(integer))); break;
+            case QVariant::ULongLong: variants.append(QVariant(quint64(integer))); break;
+            default: variants.append(QVariant(integer));
+            }
+        } else {
+            variants.append(QVariant(column->reals.at(i)));
+        }
+        m_size += variantSize(variants.last()) - numberSize;
+    }
+    column->storage = Column::Storage::Variant;
+    column->variants = variants;
+    column->integers.clear();
+    column->reals.clear();
+    column->nulls.clear();
+}
+
+QVariant KDbResultCacheData::value(int record, int column) const
+{
+    if (record < 0 || record >= m_recordCount || column < 0 || column >= m_columns.count()) {
+        return QVariant();
+    }
+    const Column &c = m_columns.at(column);
+    if (record < c.nulls.size() && c.nulls.testBit(record)) {
+        return QVariant();
+    }
+    switch (c.storage) {
+    case Column::Storage::Integer: {
+        const qint64 integer = c.integers.at(record);
+        switch (c.type) {
+        case QVariant::Bool: return QVariant(integer != 0);
+        case QVariant::Int: return QVariant(int(integer));
+        case QVariant::UInt: return QVariant(uint(integer));
+        case QVariant::ULongLong: return QVariant(quint64(integer));
+        default:;
+        }
+        return QVariant(integer);
+    }
+    case Column::Storage::Real:
+        return QVariant(c.reals.at(record));
+    case Column::Storage::Variant:
+        return c.variants.at(record);
+    default:;
+    }
+    return QVariant();
+}
+
+//--------------------------------------
+
+KDbResultCache::KDbResultCache()
+{
+    m_entries.setMaxCost(0);
+}
+
+KDbResultCache::~KDbResultCache()
+{
+}
+
+void KDbResultCache::setMaxSize(int size)
+{
+    m_entries.setMaxCost(qMax(0, size));
+    if (size <= 0) {
+        m_entries.clear();
+    }
+}
+
+QByteArray KDbResultCache::key(const KDbEscapedString &sql, const QList<QVariant> &params)
+{
+    QByteArray result(sql.toByteArray());
+    if (!params.isEmpty()) {
+        QDataStream stream(&result, QIODevice::Append);
+        stream << params;
+    }
+    return result;
+}
+
+QStringList KDbResultCache::dependencies(KDbConnection *conn, KDbQuerySchema *query)
+{
+    QStringList tables;
+    for (const KDbTableSchema *table : *query->tables()) {
+        tables.append(table->name().toLower());
+    }
+    // record sources of lookup fields are joined to the query
+    for (const KDbQueryColumnInfo *ci : query->fieldsExpanded(conn)) {
+        KDbField *f = ci->field();
+        const KDbLookupFieldSchema *lookup
+            = f->table() ? f->table()->lookupFieldSchema(*f) : nullptr;
+        if (!lookup) {
+            continue;
+        }
+        const KDbLookupFieldSchemaRecordSource recordSource(lookup->recordSource());
+        if (recordSource.type() == KDbLookupFieldSchemaRecordSource::Type::Table) {
+            tables.append(recordSource.name().toLower());
+        } else if (recordSource.type() == KDbLookupFieldSchemaRecordSource::Type::Query) {
+            KDbQuerySchema *lookupQuery = conn->querySchema(recordSource.name());
+            if (lookupQuery) {
+                for (const KDbTableSchema *table : *lookupQuery->tables()) {
+                    tables.append(table->name().toLower());
+                }
+            }
+        }
+    }
+    tables.removeDuplicates();
+    return tables;
+}
+
+QSharedPointer<const KDbResultCacheData> KDbResultCache::data(const QByteArray &key)
+{
+    QSharedPointer<const KDbResultCacheData> *entry = m_entries.object(key);
+    if (!entry) {
+        return QSharedPointer<const KDbResultCacheData>();
+    }
+    if (!isCurrent(**entry)) {
+        m_entries.remove(key);
+        return QSharedPointer<const KDbResultCacheData>();
+    }
+    return *entry;
+}
+
+void KDbResultCache::setDependencies(KDbResultCacheData *data, const QStringList &tables) const
+{
+    data->tables = tables;
+    data->tableVersions.clear();
+    for (const QString &table : tables) {
+        data->tableVersions.append(m_tableVersions.value(table));
+    }
+    data->allTablesVersion = m_allTablesVersion;
+}
+
+void KDbResultCache::insert(const QByteArray &key, KDbResultCacheData *data)
+{
+    if (!isEnabled() || !isCurrent(*data)) {
+        delete data;
+        return;
+    }
+    // deletes the data if it is larger than the cache
+    m_entries.insert(key, new QSharedPointer<const KDbResultCacheData>(data),
+                     qMax(1, data->size()));
+}
+
+void KDbResultCache::tableModified(const QString &tableName)
+{
+    if (tableName.isEmpty()) {
+        ++m_allTablesVersion;
+        m_entries.clear();
+    } else {
+        ++m_tableVersions[tableName.toLower()];
+    }
+}
+
+void KDbResultCache::clear()
+{
+    m_entries.clear();
+}
+
+bool KDbResultCache::isCurrent(const KDbResultCacheData &data) const
+{
+    if (data.allTablesVersion != m_allTablesVersion) {
+        return false;
+    }
+    for (int i = 0; i < data.tables.count(); ++i) {
+        if (m_tableVersions.value(data.tables.at(i)) != data.tableVersions.at(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//--------------------------------------
+
+KDbResultCacheCursor::KDbResultCacheCursor(KDbConnection *conn, KDbQuerySchema *query,
+                                           const QSharedPointer<const KDbResultCacheData> &data,
+                                           Options options)
+    : KDbCursor(conn, query, options)
+    , m_data(data)
+{
+}
+
+KDbResultCacheCursor::~KDbResultCacheCursor()
+{
+    close();
+}
+
+QVariant KDbResultCacheCursor::value(int i)
+{
+    if (i < 0 || i >= m_fieldCount) {
+        return QVariant();
+    }
+    return m_data->value(m_record, i);
+}
+
+const char ** KDbResultCacheCursor::recordData() const
+{
+    return nullptr;
+}
+
+bool KDbResultCacheCursor::drv_open(const KDbEscapedString &sql)
+{
+    Q_UNUSED(sql)
+    m_record = -1;
+    m_fieldCount = m_data->fieldCount;
+    m_fieldsToStoreInRecord = m_data->fieldsToStoreInRecord;
+    return true;
+}
+
+bool KDbResultCacheCursor::drv_close()
+{
+    m_record = -1;
+    return true;
+}
+
+void KDbResultCacheCursor::drv_getNextRecord()
+{
+    if (m_record + 1 < m_data->recordCount()) {
+        ++m_record;
+        m_fetchResult = FetchResult::Ok;
+    } else {
+        m_record = m_data->recordCount();
+        m_fetchResult = FetchResult::End;
+    }
+}
+
+void KDbResultCacheCursor::drv_appendCurrentRecordToBuffer()
+{
+    // all records are already stored
+}
+
+void KDbResultCacheCursor::drv_bufferMovePointerNext()
+{
+    ++m_record;
+}
+
+void KDbResultCacheCursor::drv_bufferMovePointerPrev()
+{
+    --m_record;
+}
+
+void KDbResultCacheCursor::drv_bufferMovePointerTo(qint64 at)
+{
+    m_record = int(at);
+}
+
+bool KDbResultCacheCursor::drv_storeCurrentRecord(KDbRecordData *data) const
+{
+    if (m_record < 0 || m_record >= m_data->recordCount()) {
+        return false;
+    }
+    for (int i = 0; i < data->count(); ++i) {
+        (*data)[i] = m_data->value(m_record, i);
+    }
+    return true;
+}
@@ -0,0 +1,181 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_RESULTCACHE_P_H
+#define KDB_RESULTCACHE_P_H
+
+#include "KDbCursor.h"
+
+#include <QBitArray>
+#include <QCache>
+#include <QHash>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVector>
+
+class KDbRecordData;
+
+/*! @internal Records of a query result stored by KDbResultCache.
+ Values are stored by columns; integer and floating point columns without typed nulls
+ are stored as plain numbers. */
+class KDbResultCacheData
+{
+public:
+    KDbResultCacheData();
+
+    //! Appends values of record @a data. @return false if the size exceeds @a maxSize.
+    bool append(const KDbRecordData &data, int maxSize);
+
+    //! @return value of column @a column of record @a record
+    QVariant value(int record, int column) const;
+
+    //! @return approximate number of bytes occupied by the data
+    inline int size() const { return m_size; }
+
+    //! @return number of records
+    inline int recordCount() const { return m_recordCount; }
+
+    //! @return number of columns
+    inline int columnCount() const { return m_columns.count(); }
+
+    int fieldCount = 0; //!< field count of the cursor that fetched the records
+    int fieldsToStoreInRecord = 0; //!< record size of the cursor that fetched the records
+
+    QStringList tables; //!< lower-case names of tables the records depend on
+    QVector<quint64> tableVersions; //!< versions of the tables when the records were fetched
+    quint64 allTablesVersion = 0; //!< see KDbResultCache::tableModified()
+
+private:
+    //! Values of a single column
+    struct Column {
+        //! Storage of values of a column, decided by the first non-null value
+        enum class Storage {
+            Undecided, //!< only nulls so far
+            Integer,   //!< integers and booleans in integers, nulls in nulls
+            Real,      //!< doubles in reals, nulls in nulls
+            Variant    //!< values of any type in variants
+        };
+        Storage storage = Storage::Undecided;
+        QVariant::Type type = QVariant::Invalid; //!< type of Integer values
+        QVector<qint64> integers;
+        QVector<double> reals;
+        QVector<QVariant> variants;
+        QBitArray nulls;
+    };
+
+    //! Appends @a value as record @a record of @a column, updates m_size
+    void append(Column *column, int record, const QVariant &value);
+
+    //! Converts numbers of @a column to variants, updates m_size
+    void convertToVariants(Column *column, int recordCount);
+
+    QVector<Column> m_columns;
+    int m_recordCount = 0;
+    int m_size = 0;
+    Q_DISABLE_COPY(KDbResultCacheData)
+};
+
+/*! @internal Cache of results of queries executed using a connection.
+
+ Results are identified by generated statements and parameters, see key(). A result depends
+ on versions of tables it reads, bumped by tableModified() when a statement modifying
+ a table is executed by the connection. Results with outdated versions are never returned.
+ Only the table named in the statement is bumped; tables modified indirectly by triggers
+ or cascading foreign key actions keep their versions.
+ The least recently used results are removed when the size of the cache exceeds maxSize(). */
+class KDbResultCache
+{
+public:
+    KDbResultCache();
+
+    ~KDbResultCache();
+
+    //! @return true if maxSize() is greater than 0
+    inline bool isEnabled() const { return m_entries.maxCost() > 0; }
+
+    //! @return maximum size of cached results in bytes
+    inline int maxSize() const { return m_entries.maxCost(); }
+
+    //! Sets maximum size of cached results in bytes, 0 disables the cache and clears it
+    void setMaxSize(int size);
+
+    //! @return key of result of statement @a sql executed with parameters @a params
+    static QByteArray key(const KDbEscapedString &sql, const QList<QVariant> &params);
+
+    //! @return lower-case names of tables read by @a query, including lookup record sources
+    static QStringList dependencies(KDbConnection *conn, KDbQuerySchema *query);
+
+    //! @return current result for @a key or @c nullptr if there is no such result
+    QSharedPointer<const KDbResultCacheData> data(const QByteArray &key);
+
+    //! Sets names of tables that @a data depends on to @a tables and remembers their versions
+    void setDependencies(KDbResultCacheData *data, const QStringList &tables) const;
+
+    /*! Stores @a data as result for @a key if versions of its tables did not change since
+     setDependencies() was called. Ownership of @a data is passed to the cache. */
+    void insert(const QByteArray &key, KDbResultCacheData *data);
+
+    //! Bumps version of table @a tableName, empty @a tableName bumps versions of all tables
+    void tableModified(const QString &tableName);
+
+    //! Removes all results
+    void clear();
+
+private:
+    //! @return true if versions of tables of @a data are current
+    bool isCurrent(const KDbResultCacheData &data) const;
+
+    QCache<QByteArray, QSharedPointer<const KDbResultCacheData>> m_entries;
+    QHash<QString, quint64> m_tableVersions;
+    quint64 m_allTablesVersion = 0; //!< bumped on modifications of unknown tables
+    Q_DISABLE_COPY(KDbResultCache)
+};
+
+//! @internal Cursor returning records of a result stored in KDbResultCache
+class KDbResultCacheCursor : public KDbCursor
+{
+public:
+    KDbResultCacheCursor(KDbConnection *conn, KDbQuerySchema *query,
+                         const QSharedPointer<const KDbResultCacheData> &data,
+                         Options options = KDbCursor::Option::None);
+
+    ~KDbResultCacheCursor() override;
+
+    QVariant value(int i) override;
+
+    //! @return @c nullptr, records are not stored as strings
+    const char ** recordData() const override;
+
+protected:
+    bool drv_open(const KDbEscapedString &sql) override;
+    bool drv_close() override;
+    void drv_getNextRecord() override;
+    void drv_appendCurrentRecordToBuffer() override;
+    void drv_bufferMovePointerNext() override;
+    void drv_bufferMovePointerPrev() override;
+    void drv_bufferMovePointerTo(qint64 at) override;
+    bool drv_storeCurrentRecord(KDbRecordData *data) const override;
+
+private:
+    const QSharedPointer<const KDbResultCacheData> m_data;
+    int m_record = -1; //!< current record
+    Q_DISABLE_COPY(KDbResultCacheCursor)
+};
+
+#endif
@@ -48,6 +48,20 @@ public:
     Specifies whether if relations (LEFT OUTER JOIN) for visible lookup columns should be added.
     */
     bool addVisibleLookupColumns; //SDC: default=true
+
+    /*!
+    @getter
+    @return @c true if visible values of lookup columns should be obtained from lookup value
+    cache of the connection instead of relations (LEFT OUTER JOIN) if the record source is cached.
+    NULL is selected for these columns; KDbCursor sets the cached visible values in records.
+    Used only if addVisibleLookupColumns() is @c true. @c false by default.
+    @see KDbConnection::setLookupValueCacheLimit()
+    @since 3.3
+    @setter
+    Specifies whether visible values of lookup columns should be obtained from lookup value cache.
+    @since 3.3
+    */
+    bool useLookupValueCache; //SDC: default=false
 };
 
 #endif
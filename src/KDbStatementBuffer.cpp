@@ -0,0 +1,110 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbStatementBuffer_p.h"
+#include "KDbDriver.h"
+#include "KDbDriverBehavior.h"
+#include "KDbDriver_p.h"
+
+//! @return true if @a c can be a part of identifier that drivers never escape
+static inline bool isPlainIdentifierCharacter(ushort c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+KDbStatementBuffer::KDbStatementBuffer(const KDbDriver *driver, int reservedSize)
+    : m_driver(driver)
+    , m_reservedSize(reservedSize)
+    , m_openingQuote(driver ? KDbDriverPrivate::behavior(driver)->OPENING_QUOTATION_MARK_BEGIN_FOR_IDENTIFIER : '"')
+    , m_closingQuote(driver ? KDbDriverPrivate::behavior(driver)->CLOSING_QUOTATION_MARK_BEGIN_FOR_IDENTIFIER : '"')
+{
+    if (m_reservedSize > 0) {
+        m_data.reserve(m_reservedSize);
+    }
+}
+
+KDbStatementBuffer::~KDbStatementBuffer()
+{
+}
+
+void KDbStatementBuffer::clear()
+{
+    if (m_data.isValid()) {
+        m_data.resize(0);
+    } else {
+        m_data.clear();
+    }
+    if (m_reservedSize > 0) {
+        // no-op if the memory is not shared with a copy of the previous statement
+        m_data.reserve(m_reservedSize);
+    }
+}
+
+KDbStatementBuffer& KDbStatementBuffer::appendNumber(qint64 number)
+{
+    char digits[24];
+    char *end = digits + sizeof(digits);
+    char *begin = end;
+    quint64 n = number < 0 ? (quint64(0) - quint64(number)) : quint64(number);
+    do {
+        *--begin = char('0' + n % 10);
+        n /= 10;
+    } while (n > 0);
+    if (number < 0) {
+        *--begin = '-';
+    }
+    m_data.append(begin, int(end - begin));
+    return *this;
+}
+
+KDbStatementBuffer& KDbStatementBuffer::appendIdentifier(const QString &name)
+{
+    if (!m_driver) {
+        m_data.append(KDb::escapeIdentifier(name));
+        return *this;
+    }
+    if (!m_data.isValid()) {
+        return *this;
+    }
+    // Fast path: drivers only escape quotation marks, so identifiers built of ASCII
+    // letters, digits and underscores are copied directly between the quotation marks.
+    const int oldLength = m_data.size();
+    const int length = name.length();
+    m_data.resize(oldLength + length + 2);
+    char *out = m_data.data() + oldLength;
+    *out++ = m_openingQuote;
+    const ushort *chars = name.utf16();
+    for (int i = 0; i < length; ++i) {
+        const ushort c = chars[i];
+        if (!isPlainIdentifierCharacter(c)) {
+            m_data.resize(oldLength);
+            m_data.append(m_driver->escapeIdentifier(name));
+            return *this;
+        }
+        *out++ = char(c);
+    }
+    *out = m_closingQuote;
+    return *this;
+}
+
+KDbStatementBuffer& KDbStatementBuffer::appendValue(KDbField::Type type, const QVariant &value)
+{
+    m_data.append(KDb::valueToSql(m_driver, type, value));
+    return *this;
+}
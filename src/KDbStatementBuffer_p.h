@@ -0,0 +1,128 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_STATEMENTBUFFER_P_H
+#define KDB_STATEMENTBUFFER_P_H
+
+#include "KDbEscapedString.h"
+#include "KDbField.h"
+
+class KDbDriver;
+
+/*! @internal Buffer for building SQL statements in a single growing memory block.
+
+ Keywords, identifiers, literals and parameter markers are appended in place, without
+ temporary strings for identifiers that need no escaping. Quotation marks of the driver
+ are used for identifiers, values are converted using KDbDriver::valueToSql().
+ If no driver is set, KDb SQL escaping is used.
+
+ The buffer can be reused for many statements: clear() keeps the allocated memory.
+ Take a copy of statement() before executing it; the copy is implicitly shared
+ so clearing the buffer while the copy is still referenced allocates a new block. */
+class KDB_EXPORT KDbStatementBuffer
+{
+public:
+    explicit KDbStatementBuffer(const KDbDriver *driver = nullptr, int reservedSize = 1024);
+
+    ~KDbStatementBuffer();
+
+    //! @return driver used for escaping, @c nullptr for KDb SQL escaping
+    inline const KDbDriver* driver() const { return m_driver; }
+
+    //! Removes contents of the buffer, keeps the allocated memory
+    void clear();
+
+    //! @return true if the buffer is empty
+    inline bool isEmpty() const { return m_data.isEmpty(); }
+
+    //! @return length of the statement in bytes
+    inline int length() const { return m_data.size(); }
+
+    //! Truncates the statement to @a length bytes
+    inline void truncate(int length) { m_data.truncate(length); }
+
+    //! @return the statement, invalid if any of the appended values was invalid
+    inline KDbEscapedString statement() const { return m_data; }
+
+    inline KDbStatementBuffer& append(char c) {
+        m_data.append(c);
+        return *this;
+    }
+
+    inline KDbStatementBuffer& append(const char *s) {
+        m_data.append(s);
+        return *this;
+    }
+
+    inline KDbStatementBuffer& append(const QByteArray &s) {
+        m_data.append(s);
+        return *this;
+    }
+
+    //! Appends @a s encoded in UTF-8
+    inline KDbStatementBuffer& append(const QString &s) {
+        m_data.append(s);
+        return *this;
+    }
+
+    inline KDbStatementBuffer& append(const KDbEscapedString &s) {
+        m_data.append(s);
+        return *this;
+    }
+
+    inline KDbStatementBuffer& append(const KDbStatementBuffer &other) {
+        m_data.append(other.m_data);
+        return *this;
+    }
+
+    //! Appends @a number in decimal form
+    KDbStatementBuffer& appendNumber(qint64 number);
+
+    //! Appends identifier @a name escaped for the driver
+    KDbStatementBuffer& appendIdentifier(const QString &name);
+
+    //! Appends "table.field" with both identifiers escaped for the driver
+    inline KDbStatementBuffer& appendIdentifier(const QString &tableName, const QString &name) {
+        return appendIdentifier(tableName).append('.').appendIdentifier(name);
+    }
+
+    //! Appends @a value of type @a type converted to SQL literal
+    KDbStatementBuffer& appendValue(KDbField::Type type, const QVariant &value);
+
+    //! @overload
+    inline KDbStatementBuffer& appendValue(const KDbField *field, const QVariant &value) {
+        return appendValue(field ? field->type() : KDbField::InvalidType, value);
+    }
+
+    //! Appends parameter marker of prepared statements
+    inline KDbStatementBuffer& appendParameter() {
+        m_data.append('?');
+        return *this;
+    }
+
+private:
+    const KDbDriver *m_driver;
+    const int m_reservedSize;
+    char m_openingQuote;
+    char m_closingQuote;
+    KDbEscapedString m_data;
+    Q_DISABLE_COPY(KDbStatementBuffer)
+};
+
+#endif
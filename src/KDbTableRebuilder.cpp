@@ -0,0 +1,276 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbTableRebuilder.h"
+#include "KDbConnection.h"
+#include "KDbDriver.h"
+#include "KDbIndexSchema.h"
+#include "KDbRecordData.h"
+#include "KDbTableSchema.h"
+#include "KDbTransactionGuard.h"
+#include "kdb_debug.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+
+KDbTableRebuildProgressHandler::KDbTableRebuildProgressHandler()
+{
+}
+
+KDbTableRebuildProgressHandler::~KDbTableRebuildProgressHandler()
+{
+}
+
+//--------------------------------------
+
+class Q_DECL_HIDDEN KDbTableRebuilder::Private
+{
+public:
+    Private() {}
+
+    //! @return field of the source table's primary key used for splitting records
+    //! into chunks, or @c nullptr if there is no suitable key
+    KDbField* keyField() const {
+        const KDbIndexSchema *pkey = source->primaryKey();
+        if (!pkey || pkey->fieldCount() != 1) {
+            return nullptr;
+        }
+        KDbField *field = pkey->field(0);
+        return field->type() == KDbField::BLOB ? nullptr : field;
+    }
+
+    KDbConnection *conn = nullptr;
+    KDbTableSchema *source = nullptr;
+    KDbTableSchema *destination = nullptr;
+    int chunkSize = 10000;
+    KDbTableRebuildProgressHandler *handler = nullptr;
+    //! SQL expressions computing values of destination fields, by field name
+    QHash<QString, KDbEscapedString> sources;
+    QVariant lastKey;
+    qint64 copiedRecords = 0;
+    bool finished = false;
+private:
+    Q_DISABLE_COPY(Private)
+};
+
+KDbTableRebuilder::KDbTableRebuilder(KDbConnection *conn, KDbTableSchema *source,
+                                     KDbTableSchema *destination)
+    : d(new Private)
+{
+    Q_ASSERT(conn);
+    Q_ASSERT(source);
+    Q_ASSERT(destination);
+    d->conn = conn;
+    d->source = source;
+    d->destination = destination;
+}
+
+KDbTableRebuilder::~KDbTableRebuilder()
+{
+    delete d;
+}
+
+int KDbTableRebuilder::chunkSize() const
+{
+    return d->chunkSize;
+}
+
+void KDbTableRebuilder::setChunkSize(int records)
+{
+    d->chunkSize = qMax(1, records);
+}
+
+KDbTableRebuildProgressHandler* KDbTableRebuilder::progressHandler() const
+{
+    return d->handler;
+}
+
+void KDbTableRebuilder::setProgressHandler(KDbTableRebuildProgressHandler *handler)
+{
+    d->handler = handler;
+}
+
+void KDbTableRebuilder::setSourceFieldsByName()
+{
+    for (const KDbField *field : *d->destination->fields()) {
+        if (d->source->field(field->name())) {
+            setSourceField(field->name(), field->name());
+        }
+    }
+}
+
+void KDbTableRebuilder::setSourceField(const QString &fieldName, const QString &sourceFieldName)
+{
+    const KDbField *field = d->destination->field(fieldName);
+    const KDbField *sourceField = d->source->field(sourceFieldName);
+    if (!field || !sourceField) {
+        kdbWarning() << "No field" << fieldName << "or source field" << sourceFieldName;
+        return;
+    }
+    const KDbEscapedString expression(d->conn->escapeIdentifier(sourceField->name()));
+    d->sources.insert(field->name(), sourceField->type() == field->type()
+                                     ? expression
+                                     : d->conn->driver()->typeConversionToString(expression, *field));
+}
+
+void KDbTableRebuilder::setSourceExpression(const QString &fieldName,
+                                            const KDbEscapedString &expression)
+{
+    const KDbField *field = d->destination->field(fieldName);
+    if (!field) {
+        kdbWarning() << "No field" << fieldName;
+        return;
+    }
+    d->sources.insert(field->name(), expression);
+}
+
+tristate KDbTableRebuilder::copyData()
+{
+    clearResult();
+    if (d->finished) {
+        return true;
+    }
+    // Lists of fields in order of the destination table
+    KDbEscapedString fieldNames;
+    KDbEscapedString expressions;
+    for (const KDbField *field : *d->destination->fields()) {
+        const KDbEscapedString expression = d->sources.value(field->name());
+        if (expression.isEmpty()) {
+            continue;
+        }
+        if (!fieldNames.isEmpty()) {
+            fieldNames += ", ";
+            expressions += ", ";
+        }
+        fieldNames += d->conn->escapeIdentifier(field->name());
+        expressions += expression;
+    }
+    if (fieldNames.isEmpty()) {
+        m_result = KDbResult(ERR_OTHER, tr("No source of data specified for fields of table \"%1\".")
+                                           .arg(d->destination->name()));
+        return false;
+    }
+
+    KDbRecordData record;
+    const KDbEscapedString sourceTable(d->conn->escapeIdentifier(d->source->name()));
+    tristate res = d->conn->querySingleRecord(
+        KDbEscapedString("SELECT COUNT(*) FROM ") + sourceTable, &record,
+        KDbConnection::QueryRecordOptions());
+    if (res != true || record.isEmpty()) {
+        m_result = d->conn->result();
+        return false;
+    }
+    const qint64 totalRecords = record.at(0).toLongLong();
+    const KDbEscapedString insertSql = KDbEscapedString("INSERT INTO %1 (%2) SELECT %3 FROM %4")
+        .arg(KDbEscapedString(d->conn->escapeIdentifier(d->destination->name())),
+             fieldNames, expressions, sourceTable);
+    const KDbField *keyField = d->keyField();
+    const KDbEscapedString key(keyField ? d->conn->escapeIdentifier(keyField->name()) : QString());
+    QElapsedTimer timer;
+    timer.start();
+    qint64 copiedThisRun = 0;
+    while (true) {
+        KDbEscapedString sql(insertSql);
+        QVariant upperKey;
+        if (keyField) {
+            // Values are appended, not substituted, so they can contain '%' characters
+            KDbEscapedString where;
+            if (!d->lastKey.isNull()) {
+                where = " WHERE " + key + " > "
+                        + d->conn->driver()->valueToSql(keyField, d->lastKey);
+            }
+            // Find key of the last record of this chunk; there is none for the last chunk
+            res = d->conn->querySingleRecord(
+                "SELECT " + key + " FROM " + sourceTable + where + " ORDER BY " + key
+                    + KDbEscapedString(" LIMIT 1 OFFSET %1").arg(d->chunkSize - 1),
+                &record, KDbConnection::QueryRecordOptions());
+            if (res == false) {
+                m_result = d->conn->result();
+                return false;
+            }
+            if (res == true) {
+                upperKey = record.at(0);
+                where += (where.isEmpty() ? " WHERE " : " AND ") + key + " <= "
+                         + d->conn->driver()->valueToSql(keyField, upperKey);
+            }
+            sql += where + " ORDER BY " + key;
+        }
+        KDbTransactionGuard tg;
+        if (!d->conn->beginAutoCommitTransaction(&tg)) {
+            m_result = d->conn->result();
+            return false;
+        }
+        if (!d->conn->executeSql(sql) || !d->conn->commitAutoCommitTransaction(tg.transaction())) {
+            m_result = d->conn->result();
+            return false;
+        }
+        if (upperKey.isNull()) {
+            copiedThisRun += qMax(qint64(0), totalRecords - d->copiedRecords);
+            d->copiedRecords = qMax(d->copiedRecords, totalRecords);
+            d->finished = true;
+        } else {
+            copiedThisRun += d->chunkSize;
+            d->copiedRecords += d->chunkSize;
+            d->lastKey = upperKey;
+        }
+        if (d->handler) {
+            const qint64 remainingRecords = qMax(qint64(0), totalRecords - d->copiedRecords);
+            qint64 remainingMsecs = -1;
+            if (d->finished) {
+                remainingMsecs = 0;
+            } else if (copiedThisRun > 0) {
+                remainingMsecs = timer.elapsed() * remainingRecords / copiedThisRun;
+            }
+            if (!d->handler->rebuildProgress(d->copiedRecords, totalRecords, remainingMsecs)
+                && !d->finished)
+            {
+                return cancelled;
+            }
+        }
+        if (d->finished) {
+            break;
+        }
+    }
+    if (!d->conn->drv_updateTableStatistics(d->destination->name())) {
+        kdbWarning() << "Could not update statistics of table" << d->destination->name();
+    }
+    return true;
+}
+
+bool KDbTableRebuilder::isFinished() const
+{
+    return d->finished;
+}
+
+qint64 KDbTableRebuilder::copiedRecords() const
+{
+    return d->copiedRecords;
+}
+
+QVariant KDbTableRebuilder::lastKey() const
+{
+    return d->lastKey;
+}
+
+void KDbTableRebuilder::resume(const QVariant &lastKey, qint64 copiedRecords)
+{
+    d->lastKey = lastKey;
+    d->copiedRecords = copiedRecords;
+    d->finished = false;
+}
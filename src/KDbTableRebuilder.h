@@ -0,0 +1,137 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_TABLEREBUILDER_H
+#define KDB_TABLEREBUILDER_H
+
+#include <QCoreApplication>
+#include <QVariant>
+
+#include "KDbResult.h"
+#include "KDbTristate.h"
+
+class KDbConnection;
+class KDbEscapedString;
+class KDbTableSchema;
+
+/*! @brief Interface for receiving progress of KDbTableRebuilder::copyData()
+
+ rebuildProgress() is called in the thread that called KDbTableRebuilder::copyData()
+ each time a chunk of records has been copied and committed.
+ @since 3.3
+*/
+class KDB_EXPORT KDbTableRebuildProgressHandler
+{
+public:
+    KDbTableRebuildProgressHandler();
+
+    virtual ~KDbTableRebuildProgressHandler();
+
+    /*! Called when @a copiedRecords of @a totalRecords records have been copied.
+     @a remainingMsecs is estimated time needed to copy the remaining records in milliseconds,
+     or -1 if it is not known yet.
+     @return false to cancel copying; it can be resumed later by calling
+     KDbTableRebuilder::copyData() again. */
+    virtual bool rebuildProgress(qint64 copiedRecords, qint64 totalRecords, qint64 remainingMsecs) = 0;
+
+private:
+    Q_DISABLE_COPY(KDbTableRebuildProgressHandler)
+};
+
+/*! @brief Copies records between tables in chunks, e.g. when a table is rebuilt with new schema
+
+ Records of the source table are copied to the destination table using "INSERT INTO ... SELECT"
+ statements, each covering a range of at most chunkSize() values of the source table's primary
+ key, in order of the key. Each chunk is copied in a separate transaction, so the database is not
+ locked for the whole copying and the work done is not lost when copying fails or is cancelled:
+ calling copyData() again resumes after the last copied chunk. State can be also restored by
+ another object using resume(), e.g. after restarting the application.
+
+ Values of destination fields are computed from the source record as specified using
+ setSourceField() or setSourceExpression(). Values of source fields are converted to numeric
+ and text types of the destination fields by the database in the same statement.
+ Destination fields without a source are not set.
+
+ If the source table does not have a single-field primary key, records are copied by a single
+ statement in one transaction.
+
+ After copying, statistics of the destination table used by the database for query planning
+ are updated if the driver supports that.
+ @since 3.3
+*/
+class KDB_EXPORT KDbTableRebuilder : public KDbResultable
+{
+    Q_DECLARE_TR_FUNCTIONS(KDbTableRebuilder)
+public:
+    //! Creates rebuilder copying records of table @a source to table @a destination
+    //! using connection @a conn. Both tables have to exist in the database.
+    KDbTableRebuilder(KDbConnection *conn, KDbTableSchema *source, KDbTableSchema *destination);
+
+    ~KDbTableRebuilder() override;
+
+    //! @return maximum number of records copied in a single transaction. 10000 by default.
+    int chunkSize() const;
+
+    //! Sets maximum number of records copied in a single transaction
+    void setChunkSize(int records);
+
+    //! @return handler notified about progress of copying
+    KDbTableRebuildProgressHandler* progressHandler() const;
+
+    //! Sets handler notified about progress of copying, ownership is not transferred
+    void setProgressHandler(KDbTableRebuildProgressHandler *handler);
+
+    //! Sets source of each destination field to the source field with the same name, if any
+    void setSourceFieldsByName();
+
+    /*! Sets source of destination field @a fieldName to source field @a sourceFieldName.
+     The value is converted if types of the fields differ. */
+    void setSourceField(const QString &fieldName, const QString &sourceFieldName);
+
+    /*! Sets source of destination field @a fieldName to SQL expression @a expression
+     evaluated for each source record. */
+    void setSourceExpression(const QString &fieldName, const KDbEscapedString &expression);
+
+    /*! Copies records that have not been copied yet.
+     @return true when all records have been copied, false on failure and cancelled if
+     copying has been cancelled by progressHandler(). In the latter cases calling copyData()
+     again resumes copying after the last committed chunk. */
+    tristate copyData();
+
+    //! @return true if all records have been copied
+    bool isFinished() const;
+
+    //! @return number of records copied so far
+    qint64 copiedRecords() const;
+
+    //! @return primary key value of the last copied record, null if nothing has been copied
+    QVariant lastKey() const;
+
+    /*! Restores state of copying saved from another rebuilder using the same tables,
+     so copyData() continues after record with primary key @a lastKey
+     and @a copiedRecords records are assumed to be copied. */
+    void resume(const QVariant &lastKey, qint64 copiedRecords);
+
+private:
+    Q_DISABLE_COPY(KDbTableRebuilder)
+    class Private;
+    Private * const d;
+};
+
+#endif
@@ -0,0 +1,328 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbTracer.h"
+
+#include <QDebug>
+#include <QHash>
+#include <QMutex>
+
+#include <algorithm>
+
+QDebug operator<<(QDebug dbg, const KDbTraceEvent &event)
+{
+    static const char* const typeNames[] = {
+        "ExecuteSql", "PrepareSql", "OpenCursor", "CloseCursor", "ExecutePreparedStatement"
+    };
+    QDebugStateSaver saver(dbg);
+    dbg.nospace() << "KDbTraceEvent(" << typeNames[static_cast<int>(event.type)]
+                  << " SQL=" << event.sql.toString()
+                  << " FINGERPRINT=" << QByteArray::number(event.fingerprint, 16).constData()
+                  << " GENERATE=" << event.generateTime
+                  << " PREPARE=" << event.prepareTime
+                  << " EXECUTE=" << event.executeTime
+                  << " FETCH=" << event.fetchTime
+                  << " RECORDS=" << event.records
+                  << " BYTES=" << event.bytes
+                  << " CACHE_HIT=" << event.cacheHit
+                  << " SUCCESS=" << event.success << ')';
+    return dbg;
+}
+
+//--------------------------------------
+
+KDbTracer::KDbTracer()
+{
+}
+
+KDbTracer::~KDbTracer()
+{
+}
+
+static inline bool isIdentifierChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+            || c == '_' || (c & 0x80);
+}
+
+static inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+//! Calls @a append for each character of normalized version of @a sql
+template <typename Appender>
+static void normalize(const KDbEscapedString &sql, Appender append)
+{
+    const char *s = sql.constData();
+    const int size = sql.size();
+    bool pendingSpace = false;
+    bool empty = true;
+    char last = 0; // recently appended character
+    const auto put = [&](char c) {
+        if (pendingSpace && !empty) {
+            append(' ');
+        }
+        pendingSpace = false;
+        empty = false;
+        append(c);
+        last = c;
+    };
+    for (int i = 0; i < size;) {
+        const char c = s[i];
+        if (isSpace(c)) {
+            pendingSpace = true;
+            ++i;
+        } else if (c == '\'') { // string literal, quotes are escaped by doubling
+            ++i;
+            while (i < size) {
+                if (s[i] == '\'') {
+                    if (i + 1 < size && s[i + 1] == '\'') {
+                        i += 2;
+                        continue;
+                    }
+                    ++i;
+                    break;
+                }
+                ++i;
+            }
+            put('?');
+        } else if (c == '"' || c == '`' || c == '[') { // quoted identifier, kept as is
+            const char closing = c == '[' ? ']' : c;
+            put(c);
+            ++i;
+            while (i < size) {
+                put(s[i]);
+                ++i;
+                if (s[i - 1] == closing) {
+                    if (closing != ']' && i < size && s[i] == closing) { // escaped quote
+                        put(s[i]);
+                        ++i;
+                        continue;
+                    }
+                    break;
+                }
+            }
+        } else if (isDigit(c) || (c == '.' && i + 1 < size && isDigit(s[i + 1]))) {
+            if (!empty && !pendingSpace && isIdentifierChar(last)) { // part of identifier
+                put(c);
+                ++i;
+                continue;
+            }
+            // numeric literal, e.g. 12, 1.5, .5, 1e-3 or 0x1F
+            ++i;
+            while (i < size) {
+                const char n = s[i];
+                if (isIdentifierChar(n) || n == '.') {
+                    ++i;
+                } else if ((n == '+' || n == '-') && (s[i - 1] == 'e' || s[i - 1] == 'E')) {
+                    ++i;
+                } else {
+                    break;
+                }
+            }
+            put('?');
+        } else {
+            put((c >= 'A' && c <= 'Z') ? char(c + ('a' - 'A')) : c);
+            ++i;
+        }
+    }
+}
+
+//static
+quint64 KDbTracer::fingerprint(const KDbEscapedString &sql)
+{
+    // 64-bit FNV-1a
+    quint64 hash = Q_UINT64_C(14695981039346656037);
+    normalize(sql, [&hash](char c) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= Q_UINT64_C(1099511628211);
+    });
+    return hash;
+}
+
+//static
+KDbEscapedString KDbTracer::normalizedStatement(const KDbEscapedString &sql)
+{
+    QByteArray result;
+    result.reserve(sql.size());
+    normalize(sql, [&result](char c) { result.append(c); });
+    return KDbEscapedString(result);
+}
+
+//--------------------------------------
+
+KDbTraceStatistics::Statement::Statement()
+    : histogram(HistogramSize, 0)
+{
+}
+
+qint64 KDbTraceStatistics::Statement::percentile(double percent) const
+{
+    if (count == 0) {
+        return 0;
+    }
+    const qint64 rank = qMax(qint64(1), qint64(count * qBound(0.0, percent, 100.0) / 100.0 + 0.5));
+    qint64 sum = 0;
+    for (int i = 0; i < histogram.count(); ++i) {
+        sum += histogram[i];
+        if (sum >= rank) {
+            const qint64 upperBound = qint64(1000) << i; // 2^i microseconds
+            return i == histogram.count() - 1 ? maxTime : qMin(upperBound, maxTime);
+        }
+    }
+    return maxTime;
+}
+
+//! @return index of histogram bucket for time @a nsecs
+static int histogramBucket(qint64 nsecs)
+{
+    qint64 usecs = nsecs / 1000;
+    int bucket = 0;
+    while (usecs > 0 && bucket < KDbTraceStatistics::HistogramSize - 1) {
+        usecs >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+class Q_DECL_HIDDEN KDbTraceStatistics::Private
+{
+public:
+    Private() {}
+
+    mutable QMutex mutex;
+    QHash<quint64, Statement> statements;
+    QList<SlowQuery> slowQueries;
+    int slowQueryThreshold = 100;
+    int slowQueryLogSize = 100;
+private:
+    Q_DISABLE_COPY(Private)
+};
+
+KDbTraceStatistics::KDbTraceStatistics()
+    : d(new Private)
+{
+}
+
+KDbTraceStatistics::~KDbTraceStatistics()
+{
+    delete d;
+}
+
+void KDbTraceStatistics::traceEvent(const KDbTraceEvent &event)
+{
+    const qint64 totalTime = event.totalTime();
+    QMutexLocker locker(&d->mutex);
+    Statement &statement = d->statements[event.fingerprint];
+    if (statement.count == 0) {
+        statement.fingerprint = event.fingerprint;
+        statement.normalizedSql = normalizedStatement(event.sql);
+    }
+    ++statement.count;
+    if (!event.success) {
+        ++statement.failures;
+    }
+    if (event.cacheHit) {
+        ++statement.cacheHits;
+    }
+    statement.records += event.records;
+    statement.bytes += event.bytes;
+    statement.totalTime += totalTime;
+    statement.generateTime += event.generateTime;
+    statement.prepareTime += event.prepareTime;
+    statement.executeTime += event.executeTime;
+    statement.fetchTime += event.fetchTime;
+    statement.maxTime = qMax(statement.maxTime, totalTime);
+    ++statement.histogram[histogramBucket(totalTime)];
+
+    if (d->slowQueryThreshold > 0 && d->slowQueryLogSize > 0
+        && totalTime >= qint64(d->slowQueryThreshold) * 1000000)
+    {
+        SlowQuery slowQuery;
+        slowQuery.event = event;
+        slowQuery.time = QDateTime::currentDateTime();
+        d->slowQueries.append(slowQuery);
+        while (d->slowQueries.count() > d->slowQueryLogSize) {
+            d->slowQueries.removeFirst();
+        }
+    }
+}
+
+QList<KDbTraceStatistics::Statement> KDbTraceStatistics::statements() const
+{
+    QMutexLocker locker(&d->mutex);
+    QList<Statement> result(d->statements.values());
+    locker.unlock();
+    std::sort(result.begin(), result.end(), [](const Statement &a, const Statement &b) {
+        return a.totalTime > b.totalTime;
+    });
+    return result;
+}
+
+KDbTraceStatistics::Statement KDbTraceStatistics::statement(quint64 fingerprint) const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->statements.value(fingerprint);
+}
+
+QList<KDbTraceStatistics::SlowQuery> KDbTraceStatistics::slowQueries() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->slowQueries;
+}
+
+int KDbTraceStatistics::slowQueryThreshold() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->slowQueryThreshold;
+}
+
+void KDbTraceStatistics::setSlowQueryThreshold(int msecs)
+{
+    QMutexLocker locker(&d->mutex);
+    d->slowQueryThreshold = msecs;
+}
+
+int KDbTraceStatistics::slowQueryLogSize() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->slowQueryLogSize;
+}
+
+void KDbTraceStatistics::setSlowQueryLogSize(int size)
+{
+    QMutexLocker locker(&d->mutex);
+    d->slowQueryLogSize = qMax(0, size);
+    while (d->slowQueries.count() > d->slowQueryLogSize) {
+        d->slowQueries.removeFirst();
+    }
+}
+
+void KDbTraceStatistics::clear()
+{
+    QMutexLocker locker(&d->mutex);
+    d->statements.clear();
+    d->slowQueries.clear();
+}
@@ -0,0 +1,201 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_TRACER_H
+#define KDB_TRACER_H
+
+#include "KDbEscapedString.h"
+
+#include <QDateTime>
+#include <QList>
+#include <QVector>
+
+//! @short Information about a single database operation traced by KDbTracer
+/*! Times are expressed in nanoseconds. Phases that do not apply to given operation
+ are set to 0, e.g. only operations created from schema objects have nonzero generateTime.
+ @since 3.3 */
+class KDB_EXPORT KDbTraceEvent
+{
+public:
+    //! Type of traced operation
+    enum class Type {
+        ExecuteSql,               //!< KDbConnection::executeSql()
+        PrepareSql,               //!< KDbConnection::prepareSql()
+        OpenCursor,               //!< KDbCursor::open()
+        CloseCursor,              //!< KDbCursor::close(), summarizes records fetched by the cursor
+        ExecutePreparedStatement  //!< KDbPreparedStatement::execute()
+    };
+
+    KDbTraceEvent() {}
+
+    explicit KDbTraceEvent(Type t) : type(t) {}
+
+    //! @return sum of times of all phases
+    inline qint64 totalTime() const {
+        return generateTime + prepareTime + executeTime + fetchTime;
+    }
+
+    Type type = Type::ExecuteSql;
+    KDbEscapedString sql;       //!< SQL statement of the operation
+    quint64 fingerprint = 0;    //!< See KDbTracer::fingerprint()
+    qint64 generateTime = 0;    //!< Time spent on generating SQL from schema objects
+    qint64 prepareTime = 0;     //!< Time spent on preparing (compiling) the statement
+    qint64 executeTime = 0;     //!< Time spent on executing the statement
+    qint64 fetchTime = 0;       //!< Time spent on fetching records by the driver
+    qint64 records = 0;         //!< Number of records fetched
+    qint64 bytes = 0;           //!< Approximate number of bytes of values decoded from records
+    bool cacheHit = false;      //!< True if a cached statement or result has been reused
+    bool success = true;        //!< False if the operation failed
+};
+
+//! Sends information about trace event @a event to debug output @a dbg.
+//! @since 3.3
+KDB_EXPORT QDebug operator<<(QDebug dbg, const KDbTraceEvent &event);
+
+//! @short An interface for receiving information about operations performed by connections
+/*! Tracer is set for connection using KDbConnection::setTracer(). traceEvent() is then
+ called by the connection, its cursors and prepared statements after executeSql(),
+ prepareSql(), KDbCursor::open(), KDbCursor::close() and KDbPreparedStatement::execute().
+ Records fetched by a cursor are summarized by the KDbTraceEvent::Type::CloseCursor event.
+
+ traceEvent() is called in the thread of the connection so it should return quickly.
+ If no tracer is set, the only cost of tracing is checking a pointer.
+ See KDbTraceStatistics for a tracer that aggregates the events.
+ @since 3.3 */
+class KDB_EXPORT KDbTracer
+{
+public:
+    KDbTracer();
+
+    virtual ~KDbTracer();
+
+    //! Called after each traced operation
+    virtual void traceEvent(const KDbTraceEvent &event) = 0;
+
+    /*! @return fingerprint of @a sql, i.e. a hash of normalizedStatement(). Statements that
+     only differ in values of literals, whitespace or case of keywords have the same
+     fingerprint. */
+    static quint64 fingerprint(const KDbEscapedString &sql);
+
+    /*! @return normalized version of @a sql: numeric and string literals are replaced
+     with '?', sequences of whitespace are replaced with a single space and characters
+     outside of quoted identifiers are converted to lowercase. */
+    static KDbEscapedString normalizedStatement(const KDbEscapedString &sql);
+
+private:
+    Q_DISABLE_COPY(KDbTracer)
+};
+
+//! @short A tracer that aggregates statistics of statements and logs slow queries
+/*! Events are grouped by fingerprints of their statements (see KDbTracer::fingerprint()).
+ For each group count of executions, failures, fetched records and a histogram of times
+ is collected. Events that took at least slowQueryThreshold() milliseconds are added
+ to a bounded slow query log.
+
+ Methods of this class are thread-safe, e.g. statistics can be read from another thread
+ than the one of the traced connection.
+ @since 3.3 */
+class KDB_EXPORT KDbTraceStatistics : public KDbTracer
+{
+public:
+    //! Number of buckets of Statement::histogram
+    static const int HistogramSize = 32;
+
+    //! Statistics of statements having the same fingerprint
+    class KDB_EXPORT Statement
+    {
+    public:
+        Statement();
+
+        /*! @return estimated @a percent percentile of total times of the statement
+         in nanoseconds, e.g. 50 for the median or 99. The value is an upper bound
+         of the histogram bucket containing the percentile. */
+        qint64 percentile(double percent) const;
+
+        //! @return average total time in nanoseconds
+        inline qint64 averageTime() const { return count == 0 ? 0 : totalTime / count; }
+
+        quint64 fingerprint = 0;
+        KDbEscapedString normalizedSql; //!< See KDbTracer::normalizedStatement()
+        qint64 count = 0;        //!< Number of traced operations
+        qint64 failures = 0;     //!< Number of failed operations
+        qint64 cacheHits = 0;    //!< Number of operations that reused cached statement or result
+        qint64 records = 0;      //!< Number of fetched records
+        qint64 bytes = 0;        //!< Approximate number of bytes decoded from the records
+        qint64 totalTime = 0;    //!< Sum of total times in nanoseconds
+        qint64 generateTime = 0; //!< Sum of SQL generation times in nanoseconds
+        qint64 prepareTime = 0;  //!< Sum of preparation times in nanoseconds
+        qint64 executeTime = 0;  //!< Sum of execution times in nanoseconds
+        qint64 fetchTime = 0;    //!< Sum of fetching times in nanoseconds
+        qint64 maxTime = 0;      //!< Maximum total time in nanoseconds
+
+        /*! Histogram of total times: bucket 0 counts operations that took less than
+         1 microsecond, bucket i > 0 counts operations that took at least 2^(i-1) and less
+         than 2^i microseconds. The last bucket also counts all longer operations. */
+        QVector<qint64> histogram;
+    };
+
+    //! Entry of the slow query log
+    class KDB_EXPORT SlowQuery
+    {
+    public:
+        KDbTraceEvent event;
+        QDateTime time; //!< Time when the event has been received
+    };
+
+    KDbTraceStatistics();
+
+    ~KDbTraceStatistics() override;
+
+    void traceEvent(const KDbTraceEvent &event) override;
+
+    //! @return statistics for all fingerprints, ordered by descending total time
+    QList<Statement> statements() const;
+
+    //! @return statistics for @a fingerprint, Statement::count is 0 if there are none
+    Statement statement(quint64 fingerprint) const;
+
+    //! @return the slow query log, oldest entries go first
+    QList<SlowQuery> slowQueries() const;
+
+    //! @return minimal total time of an operation in milliseconds needed to add it
+    //! to the slow query log. The default is 100. 0 or less disables the log.
+    int slowQueryThreshold() const;
+
+    //! Sets minimal total time of an operation in milliseconds needed to add it
+    //! to the slow query log. 0 or less disables the log.
+    void setSlowQueryThreshold(int msecs);
+
+    //! @return maximum number of entries of the slow query log. The default is 100.
+    //! If the log is full, oldest entries are removed.
+    int slowQueryLogSize() const;
+
+    //! Sets maximum number of entries of the slow query log.
+    void setSlowQueryLogSize(int size);
+
+    //! Removes all statistics and clears the slow query log
+    void clear();
+
+private:
+    Q_DISABLE_COPY(KDbTraceStatistics)
+    class Private;
+    Private * const d;
+};
+
+#endif
@@ -0,0 +1,74 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_TRACER_P_H
+#define KDB_TRACER_P_H
+
+#include "KDbTracer.h"
+
+#include <QElapsedTimer>
+
+/*! @internal Measures phases of an operation traced by @a tracer.
+ Does nothing but checking the tracer pointer if @a tracer is @c nullptr. */
+class KDbTraceScope
+{
+public:
+    inline KDbTraceScope(KDbTracer *tracer, KDbTraceEvent::Type type)
+        : m_tracer(tracer)
+    {
+        if (m_tracer) {
+            m_event.type = type;
+            m_timer.start();
+        }
+    }
+
+    //! @return true if the operation is traced
+    inline bool isActive() const { return m_tracer; }
+
+    //! Adds time elapsed since the previous mark to phase @a phase of the event,
+    //! e.g. mark(&KDbTraceEvent::executeTime)
+    inline void mark(qint64 KDbTraceEvent::*phase) {
+        if (m_tracer) {
+            const qint64 now = m_timer.nsecsElapsed();
+            m_event.*phase += now - m_lastMark;
+            m_lastMark = now;
+        }
+    }
+
+    //! @return the event, only meaningful if isActive() is true
+    inline KDbTraceEvent* event() { return &m_event; }
+
+    //! Sends the event for statement @a sql to the tracer
+    inline void finish(const KDbEscapedString &sql, bool success) {
+        if (m_tracer) {
+            m_event.sql = sql;
+            m_event.fingerprint = KDbTracer::fingerprint(sql);
+            m_event.success = success;
+            m_tracer->traceEvent(m_event);
+        }
+    }
+
+private:
+    KDbTracer * const m_tracer;
+    KDbTraceEvent m_event;
+    QElapsedTimer m_timer;
+    qint64 m_lastMark = 0;
+};
+
+#endif
@@ -70,6 +70,15 @@
 //! @brief Defined if a GUI for debugging is enabled
 #cmakedefine KDB_DEBUG_GUI
 
+//! @def KDB_STATIC_DRIVERS
+//! @brief Defined if database drivers are built as static plugins
+//!
+//! Applications have to link to the driver libraries (e.g. kdb_sqlitedriver) and register
+//! them using Q_IMPORT_PLUGIN() with the driver's factory class name, e.g.
+//! Q_IMPORT_PLUGIN(SqliteDriverFactory).
+//! @since 3.3
+#cmakedefine KDB_STATIC_DRIVERS
+
 //! @def KDB_UNFINISHED
 //! @brief Defined if unfinished features of KDb are enabled
 #cmakedefine KDB_UNFINISHED
@@ -25,10 +25,13 @@
 #include "MysqlPreparedStatement.h"
 #include "mysql_debug.h"
 #include "KDbConnectionData.h"
+#include "KDbDataImport_p.h"
 #include "KDbVersionInfo.h"
 
 #include <QRegularExpression>
 
+#include <limits>
+
 MysqlConnection::MysqlConnection(KDbDriver *driver, const KDbConnectionData& connData,
                                  const KDbConnectionOptions &options)
         : KDbConnection(driver, connData, options)
@@ -192,6 +195,185 @@ bool MysqlConnection::drv_executeSql(const KDbEscapedString& sql)
     return true;
 }
 
+bool MysqlConnection::drv_cancel()
+{
+    return d->killCurrentQuery(data());
+}
+
+bool MysqlConnection::drv_setStatementTimeout(int msecs)
+{
+    if (QByteArray(mysql_get_server_info(d->mysql)).contains("MariaDB")) {
+        // MariaDB >= 10.1, value in seconds
+        return drv_executeSql(KDbEscapedString("SET SESSION max_statement_time = %1")
+                              .arg(msecs / 1000.0));
+    }
+    // MySQL >= 5.7.8, applies to SELECT statements only
+    return drv_executeSql(KDbEscapedString("SET SESSION max_execution_time = %1").arg(msecs));
+}
+
+//! Appends @a value to @a data using the format of LOAD DATA with default escaping
+static void appendLoadDataValue(QByteArray *data, KDbField::Type type, const QVariant &value)
+{
+    if (value.isNull()) {
+        data->append("\\N");
+        return;
+    }
+    QByteArray bytes;
+    switch (type) {
+    case KDbField::Boolean:
+        data->append(value.toBool() ? '1' : '0');
+        return;
+    case KDbField::Byte:
+    case KDbField::ShortInteger:
+    case KDbField::Integer:
+    case KDbField::BigInteger:
+        data->append(value.toByteArray());
+        return;
+    case KDbField::Float:
+    case KDbField::Double:
+        data->append(QByteArray::number(value.toDouble(), 'g', 17));
+        return;
+    case KDbField::Date:
+        data->append(value.toDate().toString(Qt::ISODate).toLatin1());
+        return;
+    case KDbField::DateTime:
+        data->append(value.toDateTime().toString(QLatin1String("yyyy-MM-dd HH:mm:ss.zzz")).toLatin1());
+        return;
+    case KDbField::Time:
+        data->append(value.toTime().toString(QLatin1String("HH:mm:ss.zzz")).toLatin1());
+        return;
+    case KDbField::BLOB:
+        bytes = value.toByteArray();
+        break;
+    default:
+        bytes = value.toString().toUtf8();
+    }
+    for (const char c : bytes) {
+        switch (c) {
+        case '\\': data->append("\\\\"); break;
+        case '\n': data->append("\\n"); break;
+        case '\r': data->append("\\r"); break;
+        case '\t': data->append("\\t"); break;
+        case '\0': data->append("\\0"); break;
+        default: data->append(c);
+        }
+    }
+}
+
+namespace {
+//! Data read by LOAD DATA LOCAL INFILE
+struct LocalInfileSource {
+    QByteArray data;
+    int position = 0;
+};
+
+int localInfileInit(void **ptr, const char *fileName, void *userData)
+{
+    Q_UNUSED(fileName);
+    *ptr = userData;
+    return 0;
+}
+
+int localInfileRead(void *ptr, char *buffer, unsigned int size)
+{
+    LocalInfileSource *source = static_cast<LocalInfileSource*>(ptr);
+    const int count = qMin(static_cast<int>(size), source->data.size() - source->position);
+    memcpy(buffer, source->data.constData() + source->position, count);
+    source->position += count;
+    return count;
+}
+
+void localInfileEnd(void *ptr)
+{
+    Q_UNUSED(ptr);
+}
+
+int localInfileError(void *ptr, char *message, unsigned int messageSize)
+{
+    Q_UNUSED(ptr);
+    qstrncpy(message, "Could not read imported data", messageSize);
+    return 2000; // CR_UNKNOWN_ERROR
+}
+} // namespace
+
+bool MysqlConnection::drv_insertBatch(KDbFieldList *fields, const KDbImportBatch &batch)
+{
+    const KDbField::List *fieldList = fields->fields();
+    QByteArray sql("LOAD DATA LOCAL INFILE 'kdb_import' INTO TABLE ");
+    sql += escapeIdentifier(fieldList->first()->table()->name()).toUtf8();
+    sql += " CHARACTER SET utf8 FIELDS TERMINATED BY '\\t' ESCAPED BY '\\\\'"
+           " LINES TERMINATED BY '\\n' (";
+    QVector<KDbField::Type> types;
+    for (const KDbField *field : *fieldList) {
+        if (!types.isEmpty()) {
+            sql += ", ";
+        }
+        sql += escapeIdentifier(field->name()).toUtf8();
+        types.append(field->type());
+    }
+    sql += ')';
+    LocalInfileSource source;
+    const int columnCount = types.count();
+    for (int record = 0; record < batch.recordCount; ++record) {
+        for (int column = 0; column < columnCount; ++column) {
+            if (column > 0) {
+                source.data.append('\t');
+            }
+            appendLoadDataValue(&source.data, types[column], batch.columns[column][record]);
+        }
+        source.data.append('\n');
+    }
+    d->setLocalInfileEnabled(true);
+    mysql_set_local_infile_handler(d->mysql, localInfileInit, localInfileRead, localInfileEnd,
+                                   localInfileError, &source);
+    const bool ok = d->executeSql(KDbEscapedString(sql));
+    mysql_set_local_infile_default(d->mysql);
+    d->setLocalInfileEnabled(false);
+    if (ok) {
+        return true;
+    }
+    switch (mysql_errno(d->mysql)) {
+    case 1148: // ER_NOT_ALLOWED_COMMAND
+    case 2068: // CR_LOAD_DATA_LOCAL_INFILE_REJECTED
+    case 3948: // ER_CLIENT_LOCAL_FILES_DISABLED
+        // loading local data is not allowed by the server or the client
+        return KDbConnection::drv_insertBatch(fields, batch);
+    default:
+        break;
+    }
+    storeResult();
+    return false;
+}
+
+bool MysqlConnection::drv_updateTableStatistics(const QString &tableName)
+{
+    // ANALYZE TABLE returns a result set that has to be consumed
+    QScopedPointer<KDbSqlResult> result(
+        drv_prepareSql(KDbEscapedString("ANALYZE TABLE %1").arg(escapeIdentifier(tableName))));
+    return !result.isNull();
+}
+
+tristate MysqlConnection::drv_approximateRecordCount(const KDbTableSchema &tableSchema,
+                                                     int *count)
+{
+    // TABLE_ROWS is exact for MyISAM and estimated for InnoDB tables
+    QString rows;
+    const tristate result = querySingleString(
+        KDbEscapedString("SELECT TABLE_ROWS FROM information_schema.TABLES "
+                         "WHERE TABLE_SCHEMA=DATABASE() AND TABLE_NAME=%1")
+            .arg(escapeString(tableSchema.name())), &rows);
+    if (result != true) {
+        return result == false ? tristate(false) : cancelled;
+    }
+    bool ok;
+    const qint64 records = rows.toLongLong(&ok);
+    if (!ok) { // NULL
+        return cancelled;
+    }
+    *count = int(qMin(records, qint64(std::numeric_limits<int>::max())));
+    return true;
+}
+
 QString MysqlConnection::serverResultName() const
 {
     return MysqlConnectionInternal::serverResultName(d->mysql);
@@ -63,6 +63,17 @@ protected:
     bool drv_dropDatabase(const QString &dbName = QString()) override;
     Q_REQUIRED_RESULT KDbSqlResult *drv_prepareSql(const KDbEscapedString &sql) override;
     bool drv_executeSql(const KDbEscapedString& sql) override;
+    //! Implemented using "KILL QUERY" executed on a separate connection
+    bool drv_cancel() override;
+    //! Implemented using max_execution_time (MySQL) or max_statement_time (MariaDB) variable
+    bool drv_setStatementTimeout(int msecs) override;
+    //! Inserts records using LOAD DATA LOCAL INFILE reading from memory,
+    //! falls back to the default implementation if loading local data is not allowed
+    bool drv_insertBatch(KDbFieldList *fields, const KDbImportBatch &batch) override;
+    //! Executes ANALYZE TABLE for the table
+    bool drv_updateTableStatistics(const QString &tableName) override;
+    //! Reads number of records from information_schema.TABLES
+    tristate drv_approximateRecordCount(const KDbTableSchema &tableSchema, int *count) override;
 
     //! Implemented for KDbResultable
     QString serverResultName() const override;
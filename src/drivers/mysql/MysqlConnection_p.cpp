@@ -88,6 +88,9 @@ bool MysqlConnectionInternal::db_connect(const KDbConnectionData& data)
     const QByteArray userName(data.userName().toLatin1());
     const QByteArray password(data.password().toLatin1());
     int client_flag = 0; //!< @todo support client_flag?
+    // Announce support for LOAD DATA LOCAL INFILE used for importing data;
+    // loading is disabled again after connecting and only enabled while importing.
+    setLocalInfileEnabled(true);
     if (mysql_real_connect(mysql, hostName.isEmpty() ? nullptr : hostName.constData(),
                            data.userName().isEmpty() ? nullptr : userName.constData(),
                            data.password().isNull() ? nullptr : password.constData(),
@@ -96,11 +99,18 @@ bool MysqlConnectionInternal::db_connect(const KDbConnectionData& data)
                            client_flag))
     {
         serverVersion = mysql_get_server_version(mysql);
+        setLocalInfileEnabled(false);
         return true;
     }
     return false;
 }
 
+void MysqlConnectionInternal::setLocalInfileEnabled(bool set)
+{
+    const unsigned int enable = set ? 1 : 0;
+    mysql_options(mysql, MYSQL_OPT_LOCAL_INFILE, &enable);
+}
+
 bool MysqlConnectionInternal::db_disconnect()
 {
     mysql_close(mysql);
@@ -128,6 +138,24 @@ bool MysqlConnectionInternal::executeSql(const KDbEscapedString& sql)
     return 0 == mysql_real_query(mysql, sql.constData(), sql.length());
 }
 
+bool MysqlConnectionInternal::killCurrentQuery(const KDbConnectionData& data)
+{
+    if (!mysql) {
+        return false;
+    }
+    const unsigned long threadId = mysql_thread_id(mysql);
+    MysqlConnectionInternal killer(connection);
+    if (!killer.db_connect(data)) {
+        mysqlWarning() << "Could not connect to the server to cancel statement";
+        return false;
+    }
+    if (!killer.executeSql(KDbEscapedString("KILL QUERY %1").arg(qulonglong(threadId)))) {
+        mysqlWarning() << "Could not cancel statement:" << mysql_error(killer.mysql);
+        return false;
+    }
+    return true;
+}
+
 //static
 QString MysqlConnectionInternal::serverResultName(MYSQL *mysql)
 {
@@ -138,7 +166,12 @@ QString MysqlConnectionInternal::serverResultName(MYSQL *mysql)
 void MysqlConnectionInternal::storeResult(KDbResult *result)
 {
     result->setServerMessage(QString::fromLatin1(mysql_error(mysql)));
-    result->setServerErrorCode(mysql_errno(mysql));
+    const unsigned int errorCode = mysql_errno(mysql);
+    result->setServerErrorCode(errorCode);
+    // ER_QUERY_TIMEOUT of MySQL and ER_STATEMENT_TIMEOUT of MariaDB
+    if (errorCode == 3024 || errorCode == 1969) {
+        statementTimedOut();
+    }
 }
 
 //--------------------------------------
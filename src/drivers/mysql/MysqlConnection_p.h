@@ -58,12 +58,20 @@ public:
     //! Disconnects from the database
     bool db_disconnect();
 
+    //! Enables or disables loading of local data using LOAD DATA LOCAL INFILE
+    void setLocalInfileEnabled(bool set);
+
     //! Selects a database that is about to be used
     bool useDatabase(const QString &dbName = QString());
 
     //! Executes query for a raw SQL statement @a sql using mysql_real_query()
     bool executeSql(const KDbEscapedString& sql);
 
+    /*! Interrupts statement currently executed by this connection.
+     "KILL QUERY" is executed for this purpose using a temporary connection
+     established with @a data because the original connection is busy. */
+    bool killCurrentQuery(const KDbConnectionData& data);
+
     static QString serverResultName(MYSQL *mysql);
 
     void storeResult(KDbResult *result);
@@ -21,6 +21,7 @@
 #include "MysqlCursor.h"
 #include "MysqlConnection.h"
 #include "MysqlConnection_p.h"
+#include "KDbColumnBatch.h"
 #include "KDbError.h"
 #include "KDb.h"
 #include "KDbRecordData.h"
@@ -138,6 +139,77 @@ bool MysqlCursor::drv_storeCurrentRecord(KDbRecordData* data) const
     return true;
 }
 
+//! Appends value @a data of length @a length to column @a i of @a batch.
+//! Values that cannot be stored directly are converted for field type @a type.
+static void appendToBatch(KDbColumnBatch *batch, int i, const char *data, unsigned long length,
+                          KDbField::Type type)
+{
+    if (!data) {
+        batch->appendNull(i);
+        return;
+    }
+    bool ok;
+    switch (batch->storage(i)) {
+    case KDbColumnBatch::Storage::Integer: {
+        const qint64 value = QByteArray::fromRawData(data, int(length)).toLongLong(&ok);
+        if (ok) {
+            batch->appendInteger(i, value);
+            return;
+        }
+        break;
+    }
+    case KDbColumnBatch::Storage::Real: {
+        const double value = QByteArray::fromRawData(data, int(length)).toDouble(&ok);
+        if (ok) {
+            batch->appendReal(i, value);
+            return;
+        }
+        break;
+    }
+    case KDbColumnBatch::Storage::Text:
+        batch->appendText(i, QString::fromUtf8(data, int(length)));
+        return;
+    case KDbColumnBatch::Storage::Blob:
+        batch->appendBlob(i, QByteArray(data, int(length)));
+        return;
+    default:;
+    }
+    batch->appendValue(i, KDb::cstringToVariant(data, type == KDbField::InvalidType ? KDbField::Text : type,
+                                                &ok, int(length)));
+}
+
+int MysqlCursor::drv_fetchBatch(KDbColumnBatch *batch, int maxRecords)
+{
+    const qint64 first = m_at; // index of the record following the current one
+    m_fetchResult = FetchResult::Ok;
+    if (first < 0 || first >= d->numRows) {
+        m_fetchResult = FetchResult::End;
+        return 0;
+    }
+    const int columnCount = batch->columnCount();
+    mysql_data_seek(d->mysqlres, first);
+    int count = 0;
+    while (count < maxRecords) {
+        if (first + count >= d->numRows) {
+            m_fetchResult = FetchResult::End;
+            break;
+        }
+        MYSQL_ROW row = mysql_fetch_row(d->mysqlres);
+        unsigned long *lengths = mysql_fetch_lengths(d->mysqlres);
+        if (!row || !lengths) {
+            m_fetchResult = FetchResult::Error;
+            break;
+        }
+        d->mysqlrow = row;
+        d->lengths = lengths;
+        for (int i = 0; i < columnCount; ++i) {
+            appendToBatch(batch, i, row[i], lengths[i], batch->fieldType(i));
+        }
+        ++count;
+    }
+    return count;
+}
+
 void MysqlCursor::drv_appendCurrentRecordToBuffer()
 {
 }
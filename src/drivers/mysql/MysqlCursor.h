@@ -41,6 +41,7 @@ public:
     bool drv_open(const KDbEscapedString& sql) override;
     bool drv_close() override;
     void drv_getNextRecord() override;
+    int drv_fetchBatch(KDbColumnBatch *batch, int maxRecords) override;
     void drv_appendCurrentRecordToBuffer() override;
     void drv_bufferMovePointerNext() override;
     void drv_bufferMovePointerPrev() override;
@@ -22,6 +22,7 @@
 
 #include "MysqlDriver.h"
 #include "KDbDriverBehavior.h"
+#include "KDbEscaping_p.h"
 #include "KDbExpression.h"
 #include "KDbPreparedStatement.h"
 #include "MysqlConnection.h"
@@ -55,7 +56,7 @@ MysqlDriver::MysqlDriver(QObject *parent, const QVariantList &args)
     beh->RANDOM_FUNCTION = QLatin1String("RAND");
     beh->GET_TABLE_NAMES_SQL = KDbEscapedString("SHOW TABLES");
 
-    initDriverSpecificKeywords(keywords);
+    initDriverSpecificKeywords(&keywords);
 
     //predefined properties
 #if MYSQL_VERSION_ID < 40000
@@ -122,80 +123,31 @@ bool MysqlDriver::supportsDefaultValue(const KDbField &field) const
     }
 }
 
-KDbEscapedString MysqlDriver::escapeString(const QString& str) const
-{
-    //escape as in https://dev.mysql.com/doc/refman/5.0/en/string-syntax.html
+//! Rules of escaping string literals for MySQL,
+//! see https://dev.mysql.com/doc/refman/5.0/en/string-syntax.html
 //! @todo support more characters, like %, _
+static const KDbStringEscapingRules& mysqlEscapingRules()
+{
+    static const KDbStringEscapingRules rules{
+        {'\\', "\\\\"}, {'\'', "\\'"}, {'"', "\\\""}, {'\n', "\\n"},
+        {'\r', "\\r"}, {'\t', "\\t"}, {'\b', "\\b"}, {'\0', "\\0"}};
+    return rules;
+}
 
-    const int old_length = str.length();
-    int i;
-    for (i = 0; i < old_length; i++) {   //anything to escape?
-        const unsigned int ch = str[i].unicode();
-        if (ch == '\\' || ch == '\'' || ch == '"' || ch == '\n' || ch == '\r' || ch == '\t' || ch == '\b' || ch == '\0')
-            break;
-    }
-    if (i >= old_length) { //no characters to escape
-        return KDbEscapedString("'") + KDbEscapedString(str) + '\'';
-    }
-
-    QChar *new_string = new QChar[ old_length * 3 + 1 ]; // a worst case approximation
-//! @todo move new_string to KDbDriver::m_new_string or so...
-    int new_length = 0;
-    new_string[new_length++] = QLatin1Char('\''); //prepend '
-    for (i = 0; i < old_length; i++, new_length++) {
-        const unsigned int ch = str[i].unicode();
-        if (ch == '\\') {
-            new_string[new_length++] = QLatin1Char('\\');
-            new_string[new_length] = QLatin1Char('\\');
-        } else if (ch <= '\'') {//check for speedup
-            if (ch == '\'') {
-                new_string[new_length++] = QLatin1Char('\\');
-                new_string[new_length] = QLatin1Char('\'');
-            } else if (ch == '"') {
-                new_string[new_length++] = QLatin1Char('\\');
-                new_string[new_length] = QLatin1Char('"');
-            } else if (ch == '\n') {
-                new_string[new_length++] = QLatin1Char('\\');
-                new_string[new_length] = QLatin1Char('n');
-            } else if (ch == '\r') {
-                new_string[new_length++] = QLatin1Char('\\');
-                new_string[new_length] = QLatin1Char('r');
-            } else if (ch == '\t') {
-                new_string[new_length++] = QLatin1Char('\\');
-                new_string[new_length] = QLatin1Char('t');
-            } else if (ch == '\b') {
-                new_string[new_length++] = QLatin1Char('\\');
-                new_string[new_length] = QLatin1Char('b');
-            } else if (ch == '\0') {
-                new_string[new_length++] = QLatin1Char('\\');
-                new_string[new_length] = QLatin1Char('0');
-            } else
-                new_string[new_length] = str[i];
-        } else
-            new_string[new_length] = str[i];
-    }
-
-    new_string[new_length++] = QLatin1Char('\''); //append '
-    KDbEscapedString result(QString(new_string, new_length));
-    delete [] new_string;
-    return result;
+KDbEscapedString MysqlDriver::escapeString(const QString& str) const
+{
+    return kdbEscapeString(str, mysqlEscapingRules());
 }
 
 KDbEscapedString MysqlDriver::escapeBLOB(const QByteArray& array) const
 {
-    return KDbEscapedString(KDb::escapeBLOB(array, KDb::BLOBEscapingType::ZeroXHex));
+    return kdbEscapeBLOB(array, KDb::BLOBEscapingType::ZeroXHex);
 }
 
 KDbEscapedString MysqlDriver::escapeString(const QByteArray& str) const
 {
 //! @todo optimize using mysql_real_escape_string()?
-//! see https://dev.mysql.com/doc/refman/5.0/en/string-syntax.html
-
-    return KDbEscapedString("'") + KDbEscapedString(str)
-           .replace('\\', "\\\\")
-           .replace('\'', "\\''")
-           .replace('"', "\\\"")
-           + '\'';
+    return kdbEscapeString(str, mysqlEscapingRules());
 }
 
 /*! Add back-ticks to an identifier, and replace any back-ticks within
@@ -95,7 +95,7 @@ protected:
     bool supportsDefaultValue(const KDbField &field) const override;
 
 private:
-    static const char *keywords[];
+    static const KDbKeywordTable keywords;
     QString m_longTextPrimaryKeyType;
     Q_DISABLE_COPY(MysqlDriver)
 };
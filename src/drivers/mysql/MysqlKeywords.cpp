@@ -1,10 +1,9 @@
 /* This file is part of the KDE project
    Copyright (C) 2004 Martin Ellis <martin.ellis@kdemail.net>
-   Copyright (C) 2004 Jarosław Staniek <staniek@kde.org>
+   Copyright (C) 2004-2018 Jarosław Staniek <staniek@kde.org>
 
    This file has been automatically generated from
-   tools/sql_keywords/sql_keywords.sh and
-   mysql-4.1.7/sql/lex.h.
+   tools/sql_keywords.sh and mysql-4.1.7/sql/lex.h.
 
    Please edit the sql_keywords.sh, not this file!
 
@@ -25,331 +24,301 @@
 */
 
 #include "MysqlDriver.h"
+#include "KDbKeywordTable_p.h"
 
-const char* MysqlDriver::keywords[] = {
-    "ACTION",
-    "ADD",
-    "AGAINST",
-    "AGGREGATE",
-    "ALTER",
-    "ANALYZE",
-    "ANY",
-    "ASCII",
-    "AUTO_INCREMENT",
-    "AVG",
-    "AVG_ROW_LENGTH",
-    "BACKUP",
-    "BDB",
-    "BERKELEYDB",
-    "BIGINT",
-    "BINARY",
-    "BINLOG",
-    "BIT",
-    "BLOB",
-    "BOOL",
-    "BOOLEAN",
-    "BOTH",
-    "BTREE",
-    "BYTE",
-    "CACHE",
-    "CHANGE",
-    "CHANGED",
-    "CHAR",
-    "CHARACTER",
-    "CHARSET",
-    "CHECKSUM",
-    "CIPHER",
-    "CLIENT",
-    "CLOSE",
-    "COLLATION",
-    "COLUMN",
-    "COLUMNS",
-    "COMMENT",
-    "COMMITTED",
-    "COMPRESSED",
-    "CONCURRENT",
-    "CONVERT",
-    "CUBE",
-    "CURRENT_DATE",
-    "CURRENT_TIME",
-    "CURRENT_TIMESTAMP",
-    "CURRENT_USER",
-    "DATA",
-    "DATABASES",
-    "DATE",
-    "DATETIME",
-    "DAY",
-    "DAY_HOUR",
-    "DAY_MICROSECOND",
-    "DAY_MINUTE",
-    "DAY_SECOND",
-    "DEALLOCATE",
-    "DEC",
-    "DECIMAL",
-    "DELAYED",
-    "DELAY_KEY_WRITE",
-    "DESCRIBE",
-    "DES_KEY_FILE",
-    "DIRECTORY",
-    "DISABLE",
-    "DISCARD",
-    "DISTINCTROW",
-    "DIV",
-    "DO",
-    "DOUBLE",
-    "DUAL",
-    "DUMPFILE",
-    "DUPLICATE",
-    "DYNAMIC",
-    "ENABLE",
-    "ENCLOSED",
-    "ENGINE",
-    "ENGINES",
-    "ENUM",
-    "ERRORS",
-    "ESCAPE",
-    "ESCAPED",
-    "EVENTS",
-    "EXECUTE",
-    "EXISTS",
-    "EXPANSION",
-    "EXTENDED",
-    "FALSE",
-    "FAST",
-    "FIELDS",
-    "FILE",
-    "FIRST",
-    "FIXED",
-    "FLOAT",
-    "FLOAT4",
-    "FLOAT8",
-    "FLUSH",
-    "FORCE",
-    "FULLTEXT",
-    "FUNCTION",
-    "GEOMETRY",
-    "GEOMETRYCOLLECTION",
-    "GET_FORMAT",
-    "GLOBAL",
-    "GRANT",
-    "GRANTS",
-    "HANDLER",
-    "HASH",
-    "HELP",
-    "HIGH_PRIORITY",
-    "HOSTS",
-    "HOUR",
-    "HOUR_MICROSECOND",
-    "HOUR_MINUTE",
-    "HOUR_SECOND",
-    "IDENTIFIED",
-    "IF",
-    "IMPORT",
-    "INDEXES",
-    "INFILE",
-    "INNOBASE",
-    "INNODB",
-    "INSERT_METHOD",
-    "INT",
-    "INT1",
-    "INT2",
-    "INT3",
-    "INT4",
-    "INT8",
-    "INTERVAL",
-    "IO_THREAD",
-    "ISOLATION",
-    "ISSUER",
-    "KEYS",
-    "KILL",
-    "LAST",
-    "LEADING",
-    "LEAVES",
-    "LEVEL",
-    "LINES",
-    "LINESTRING",
-    "LOAD",
-    "LOCAL",
-    "LOCALTIME",
-    "LOCALTIMESTAMP",
-    "LOCK",
-    "LOCKS",
-    "LOGS",
-    "LONG",
-    "LONGBLOB",
-    "LONGTEXT",
-    "LOW_PRIORITY",
-    "MASTER",
-    "MASTER_CONNECT_RETRY",
-    "MASTER_HOST",
-    "MASTER_LOG_FILE",
-    "MASTER_LOG_POS",
-    "MASTER_PASSWORD",
-    "MASTER_PORT",
-    "MASTER_SERVER_ID",
-    "MASTER_SSL",
-    "MASTER_SSL_CA",
-    "MASTER_SSL_CAPATH",
-    "MASTER_SSL_CERT",
-    "MASTER_SSL_CIPHER",
-    "MASTER_SSL_KEY",
-    "MASTER_USER",
-    "MAX_CONNECTIONS_PER_HOUR",
-    "MAX_QUERIES_PER_HOUR",
-    "MAX_ROWS",
-    "MAX_UPDATES_PER_HOUR",
-    "MEDIUM",
-    "MEDIUMBLOB",
-    "MEDIUMINT",
-    "MEDIUMTEXT",
-    "MICROSECOND",
-    "MIDDLEINT",
-    "MINUTE",
-    "MINUTE_MICROSECOND",
-    "MINUTE_SECOND",
-    "MIN_ROWS",
-    "MOD",
-    "MODE",
-    "MODIFY",
-    "MONTH",
-    "MULTILINESTRING",
-    "MULTIPOINT",
-    "MULTIPOLYGON",
-    "NAMES",
-    "NATIONAL",
-    "NDB",
-    "NDBCLUSTER",
-    "NCHAR",
-    "NEW",
-    "NEXT",
-    "NO",
-    "NONE",
-    "NO_WRITE_TO_BINLOG",
-    "NUMERIC",
-    "NVARCHAR",
-    "OLD_PASSWORD",
-    "ONE_SHOT",
-    "OPEN",
-    "OPTIMIZE",
-    "OPTION",
-    "OPTIONALLY",
-    "OUTFILE",
-    "PACK_KEYS",
-    "PARTIAL",
-    "PASSWORD",
-    "POINT",
-    "POLYGON",
-    "PRECISION",
-    "PREPARE",
-    "PREV",
-    "PRIVILEGES",
-    "PROCEDURE",
-    "PROCESS",
-    "PROCESSLIST",
-    "PURGE",
-    "QUERY",
-    "QUICK",
-    "RAID0",
-    "RAID_CHUNKS",
-    "RAID_CHUNKSIZE",
-    "RAID_TYPE",
-    "READ",
-    "REAL",
-    "REGEXP",
-    "RELAY_LOG_FILE",
-    "RELAY_LOG_POS",
-    "RELAY_THREAD",
-    "RELOAD",
-    "RENAME",
-    "REPAIR",
-    "REPEATABLE",
-    "REPLICATION",
-    "REQUIRE",
-    "RESET",
-    "RESTORE",
-    "RETURNS",
-    "REVOKE",
-    "RLIKE",
-    "ROLLUP",
-    "ROWS",
-    "ROW_FORMAT",
-    "RTREE",
-    "SAVEPOINT",
-    "SECOND",
-    "SECOND_MICROSECOND",
-    "SEPARATOR",
-    "SERIAL",
-    "SERIALIZABLE",
-    "SESSION",
-    "SHARE",
-    "SHOW",
-    "SHUTDOWN",
-    "SIGNED",
-    "SIMPLE",
-    "SLAVE",
-    "SMALLINT",
-    "SOME",
-    "SONAME",
-    "SOUNDS",
-    "SPATIAL",
-    "SQL_BIG_RESULT",
-    "SQL_BUFFER_RESULT",
-    "SQL_CACHE",
-    "SQL_CALC_FOUND_ROWS",
-    "SQL_NO_CACHE",
-    "SQL_SMALL_RESULT",
-    "SQL_THREAD",
-    "SSL",
-    "START",
-    "STARTING",
-    "STATUS",
-    "STOP",
-    "STORAGE",
-    "STRAIGHT_JOIN",
-    "STRING",
-    "STRIPED",
-    "SUBJECT",
-    "SUPER",
-    "TABLES",
-    "TABLESPACE",
-    "TERMINATED",
-    "TEXT",
-    "TIME",
-    "TIMESTAMP",
-    "TINYBLOB",
-    "TINYINT",
-    "TINYTEXT",
-    "TRAILING",
-    "TRUE",
-    "TRUNCATE",
-    "TYPE",
-    "TYPES",
-    "UNCOMMITTED",
-    "UNICODE",
-    "UNLOCK",
-    "UNSIGNED",
-    "UNTIL",
-    "USAGE",
-    "USE",
-    "USER",
-    "USER_RESOURCES",
-    "USE_FRM",
-    "UTC_DATE",
-    "UTC_TIME",
-    "UTC_TIMESTAMP",
-    "VALUE",
-    "VARBINARY",
-    "VARCHAR",
-    "VARCHARACTER",
-    "VARIABLES",
-    "VARYING",
-    "WARNINGS",
-    "WITH",
-    "WORK",
-    "WRITE",
-    "X509",
-    "YEAR",
-    "YEAR_MONTH",
-    "ZEROFILL",
-    nullptr
+//! 324 keywords in 1024 slots
+static constexpr const char* mysqlKeywordSlots[] = {
+    "TYPE", "ACTION", "HOUR_MICROSECOND", "GEOMETRY",
+    "ROWS", "INTERVAL", "CUBE", "PASSWORD",
+    "TYPES", "REPAIR", "DISCARD", "FORCE",
+    "MEDIUM", "START", "CHANGE", "CONCURRENT",
+    "SAVEPOINT", "DAY_MINUTE", "COLUMN", "INNOBASE",
+    "BINARY", "FLUSH", "LEAVES", "MASTER_SSL_CIPHER",
+    "UNICODE", "NDB", "FILE", "USE",
+    "UTC_TIMESTAMP", "UNLOCK", "MASTER_SSL_CA", "MEDIUMINT",
+    "WORK", "QUERY", "PACK_KEYS", "STARTING",
+    "LOGS", "ZEROFILL", "PREV", "FULLTEXT",
+    "NO_WRITE_TO_BINLOG", "MASTER_SERVER_ID", "IF", "CIPHER",
+    "SQL_CACHE", "BERKELEYDB", "TABLES", "COLLATION",
+    "DATETIME", "X509", "SHARE", "INT4",
+    "SECOND", "MULTILINESTRING", "NO", "TEXT",
+    "CLOSE", "LEADING", "VARIABLES", "REPLICATION",
+    "PARTIAL", "DEALLOCATE", "COMMENT", "DECIMAL",
+    "RESTORE", "LOCK", "AUTO_INCREMENT", "DATE",
+    "INNODB", "BIGINT", "CHARSET", "RAID_CHUNKS",
+    "MONTH", "SHOW", "IDENTIFIED", "DELAYED",
+    "MOD", "REAL", "TRUE", "OPTIONALLY",
+    "BDB", "COMPRESSED", "RAID_CHUNKSIZE", "MASTER_HOST",
+    "REVOKE", "ENUM", "DAY", "RELAY_THREAD",
+    "NVARCHAR", "INT8", "EVENTS", "PRIVILEGES",
+    "ENABLE", "BTREE", "MASTER_SSL_KEY", "VARCHARACTER",
+    "ANALYZE", "MODIFY", "PREPARE", "DEC",
+    "RESET", "MASTER_USER", "TRUNCATE", "DYNAMIC",
+    "BOOL", "MASTER_PORT", "DESCRIBE", "BINLOG",
+    "HOUR", "LONGTEXT", "RELAY_LOG_FILE", "MASTER",
+    "QUICK", "MASTER_LOG_POS", "GET_FORMAT", "RAID_TYPE",
+    "DIV", "LINES", "AVG", "POINT",
+    "MINUTE_SECOND", "UNCOMMITTED", "MODE", "BIT",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "MASTER_SSL_CERT", nullptr,
+    nullptr, nullptr, "ENCLOSED", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "TIME", "LOAD", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "REQUIRE", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "UNSIGNED",
+    nullptr, "STRIPED", nullptr, nullptr,
+    nullptr, nullptr, nullptr, "DELAY_KEY_WRITE",
+    nullptr, nullptr, nullptr, nullptr,
+    "LOCALTIME", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "LOW_PRIORITY", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "MASTER_SSL", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "MICROSECOND", "NEW", "GEOMETRYCOLLECTION", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "RELOAD", "BLOB", nullptr,
+    "SLAVE", nullptr, nullptr, nullptr,
+    nullptr, nullptr, "SUBJECT", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "DAY_SECOND", nullptr, nullptr, nullptr,
+    "HIGH_PRIORITY", nullptr, nullptr, nullptr,
+    nullptr, nullptr, "STORAGE", nullptr,
+    nullptr, "ASCII", nullptr, "CHAR",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "YEAR_MONTH", nullptr,
+    nullptr, nullptr, "NDBCLUSTER", "ESCAPE",
+    nullptr, nullptr, nullptr, nullptr,
+    "DISTINCTROW", nullptr, "SERIALIZABLE", nullptr,
+    "DUAL", "VARBINARY", nullptr, nullptr,
+    nullptr, "UTC_TIME", nullptr, nullptr,
+    nullptr, "IO_THREAD", "TIMESTAMP", nullptr,
+    "TERMINATED", nullptr, nullptr, nullptr,
+    "DES_KEY_FILE", nullptr, nullptr, nullptr,
+    "ISOLATION", nullptr, nullptr, nullptr,
+    nullptr, nullptr, "SQL_NO_CACHE", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "DUMPFILE", nullptr, "NEXT",
+    nullptr, "SQL_BIG_RESULT", nullptr, nullptr,
+    nullptr, "SEPARATOR", "BOTH", "SQL_CALC_FOUND_ROWS",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "USER",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "NONE", nullptr,
+    nullptr, nullptr, "HOUR_SECOND", "CHARACTER",
+    nullptr, nullptr, nullptr, "SONAME",
+    "USER_RESOURCES", nullptr, nullptr, nullptr,
+    "INT", nullptr, nullptr, nullptr,
+    nullptr, "SQL_BUFFER_RESULT", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "OLD_PASSWORD",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "LOCKS", "CACHE", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "ADD", nullptr,
+    nullptr, nullptr, "INSERT_METHOD", nullptr,
+    nullptr, nullptr, "PROCESSLIST", nullptr,
+    nullptr, "DISABLE", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "SSL",
+    nullptr, nullptr, nullptr, "NATIONAL",
+    nullptr, nullptr, nullptr, nullptr,
+    "FALSE", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "LONGBLOB",
+    "HANDLER", nullptr, "INDEXES", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "SECOND_MICROSECOND", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "SIGNED", nullptr, nullptr,
+    "DOUBLE", "VARCHAR", nullptr, nullptr,
+    nullptr, "DATA", "EXTENDED", nullptr,
+    "INFILE", nullptr, "RENAME", nullptr,
+    "MASTER_PASSWORD", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "RELAY_LOG_POS", "MEDIUMTEXT",
+    nullptr, nullptr, "FIXED", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "LOCALTIMESTAMP", "READ", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "CURRENT_USER",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "UNTIL", "DIRECTORY",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "BOOLEAN", nullptr, nullptr,
+    "ALTER", nullptr, nullptr, nullptr,
+    "AGGREGATE", "OPTIMIZE", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "STATUS", nullptr,
+    "INT2", nullptr, nullptr, nullptr,
+    nullptr, nullptr, "NAMES", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "FIRST", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "MIDDLEINT", "YEAR", nullptr, nullptr,
+    nullptr, "CHANGED", "HOUR_MINUTE", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "RETURNS",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "MASTER_LOG_FILE", nullptr,
+    nullptr, "ROLLUP", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "LEVEL", "MASTER_SSL_CAPATH", "AVG_ROW_LENGTH",
+    nullptr, nullptr, "SMALLINT", "MEDIUMBLOB",
+    "VARYING", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "CLIENT", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "OPTION", nullptr, nullptr, "COMMITTED",
+    "IMPORT", nullptr, nullptr, nullptr,
+    nullptr, "AGAINST", "BYTE", nullptr,
+    "CHECKSUM", nullptr, nullptr, "CURRENT_TIMESTAMP",
+    "HOSTS", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "OUTFILE", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "SIMPLE", nullptr, nullptr, nullptr,
+    nullptr, "EXISTS", nullptr, nullptr,
+    "RTREE", nullptr, nullptr, nullptr,
+    "REGEXP", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "DO", nullptr, nullptr, nullptr,
+    "KEYS", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "EXPANSION", nullptr, nullptr, nullptr,
+    nullptr, "DUPLICATE", "TINYTEXT", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "OPEN",
+    nullptr, nullptr, "ERRORS", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "NUMERIC", nullptr,
+    "MIN_ROWS", "TRAILING", "ENGINE", "RLIKE",
+    nullptr, "RAID0", nullptr, "COLUMNS",
+    nullptr, nullptr, nullptr, nullptr,
+    "WRITE", nullptr, nullptr, "SQL_THREAD",
+    nullptr, nullptr, nullptr, "FLOAT8",
+    nullptr, nullptr, nullptr, "PRECISION",
+    nullptr, "GRANTS", nullptr, nullptr,
+    nullptr, nullptr, nullptr, "TINYBLOB",
+    nullptr, "MAX_ROWS", nullptr, nullptr,
+    nullptr, "MASTER_CONNECT_RETRY", nullptr, nullptr,
+    nullptr, nullptr, "MINUTE_MICROSECOND", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "SPATIAL",
+    nullptr, "FAST", "HELP", nullptr,
+    "STRAIGHT_JOIN", "PROCEDURE", "TINYINT", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "ENGINES", "HASH", nullptr, nullptr,
+    nullptr, "VALUE", nullptr, "BACKUP",
+    nullptr, "MAX_UPDATES_PER_HOUR", nullptr, "INT3",
+    nullptr, nullptr, nullptr, nullptr,
+    "FLOAT4", nullptr, nullptr, nullptr,
+    nullptr, "STRING", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "MAX_CONNECTIONS_PER_HOUR", nullptr, "MULTIPOINT", nullptr,
+    "LOCAL", nullptr, "SOME", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "EXECUTE", nullptr, nullptr,
+    nullptr, nullptr, "USE_FRM", nullptr,
+    "SERIAL", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "DATABASES", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "LAST",
+    nullptr, "MULTIPOLYGON", nullptr, nullptr,
+    nullptr, nullptr, "ONE_SHOT", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "DAY_MICROSECOND", nullptr,
+    nullptr, nullptr, "TABLESPACE", nullptr,
+    nullptr, "SHUTDOWN", "LONG", nullptr,
+    nullptr, nullptr, nullptr, "FIELDS",
+    nullptr, "PURGE", nullptr, nullptr,
+    nullptr, nullptr, "DAY_HOUR", nullptr,
+    nullptr, "UTC_DATE", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "WARNINGS", nullptr, nullptr, nullptr,
+    nullptr, "ROW_FORMAT", nullptr, "MAX_QUERIES_PER_HOUR",
+    "NCHAR", nullptr, "FLOAT", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "LINESTRING",
+    nullptr, nullptr, nullptr, "PROCESS",
+    "SUPER", "SESSION", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "MINUTE", nullptr,
+    nullptr, nullptr, nullptr, "POLYGON",
+    nullptr, "STOP", nullptr, nullptr,
+    nullptr, "CURRENT_TIME", nullptr, "KILL",
+    nullptr, nullptr, nullptr, "ESCAPED",
+    "USAGE", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "CONVERT", nullptr, nullptr,
+    "GLOBAL", nullptr, nullptr, "REPEATABLE",
+    nullptr, nullptr, "ISSUER", nullptr,
+    nullptr, "SQL_SMALL_RESULT", nullptr, nullptr,
+    nullptr, nullptr, "WITH", nullptr,
+    nullptr, "ANY", nullptr, nullptr,
+    nullptr, "INT1", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "FUNCTION", nullptr, "GRANT", nullptr,
+    nullptr, nullptr, "CURRENT_DATE", "SOUNDS",
 };
+
+static constexpr int mysqlKeywordDisplacements[] = {
+    -1, -1, 2, 1, -1, -1, 1, -1, -1, 1,
+    -4, 1, 1, 1, -5, 1, 1, -1, -6, -1,
+    -7, -1, 1, 1, 1, 1, 1, -8, 1, -9,
+    1, -10, -11, 1, -13, 1, -14, -1, -15, 3,
+    -16, -18, -19, -20, -21, -22, 1, -23, -1, 1,
+    1, -1, 1, 1, -24, -25, -1, -26, -27, -28,
+    1, -29, -30, -1, 1, -31, -32, -33, -34, -1,
+    -1, 1, -35, 1, -1, 1, 1, -37, 2, -38,
+    -42, 3, -1, 1, -43, 2, 1, -44, -1, -45,
+    1, -46, 1, 3, -1, -1, -1, -1, -47, -48,
+    -1, -1, -49, -50, -1, -1, -51, -52, -1, -53,
+    -54, 1, -1, 1, -1, -56, 2, -57, -58, -1,
+    1, 2, -1, 1, -1, -1, -1, -60, 1, 4,
+    1, -61, -62, -63, 1, 1, 1, -1, -64, 1,
+    1, 1, 2, -67, 1, -1, -68, -1, -1, -70,
+    -71, 2, -1, -73, 1, -1, -1, -1, 1, -1,
+    -74, 1, -76, 3, -1, -77, -80, -81, -1, -82,
+    1, -84, 2, -85, -86, -87, -88, 1, 2, -1,
+    1, 1, 2, 1, 2, 2, 1, 1, 1, -1,
+    -90, 2, 1, -91, -92, -1, 2, -1, -95, -97,
+    -1, -1, -1, -1, -98, 2, -99, -100, 1, -101,
+    -102, -1, -1, 1, -104, 1, -1, 1, -105, -106,
+    -1, 4, -107, 1, 1, 1, -108, -109, -1, -110,
+    1, -111, -112, -1, -1, -113, -114, -115, 4, -117,
+    -1, -118, -1, -1, 1, -119, -1, -1, -120, -1,
+    -121, 1, -122, 1, -124, 4,
+};
+
+static constexpr KDbKeywordTable mysqlKeywordTable = {
+    mysqlKeywordSlots, 1024, mysqlKeywordDisplacements, 256
+};
+
+static_assert(mysqlKeywordTable.isValid(), "Invalid keyword table");
+
+const KDbKeywordTable MysqlDriver::keywords = mysqlKeywordTable;
@@ -24,6 +24,7 @@
 #include "PostgresqlCursor.h"
 #include "postgresql_debug.h"
 #include "KDbConnectionData.h"
+#include "KDbDataImport_p.h"
 #include "KDbError.h"
 #include "KDbGlobal.h"
 #include "KDbVersionInfo.h"
@@ -31,6 +32,8 @@
 #include <QFileInfo>
 #include <QHostAddress>
 
+#include <limits>
+
 #define MIN_SERVER_VERSION_MAJOR 7
 #define MIN_SERVER_VERSION_MINOR 1
 
@@ -244,6 +247,161 @@ bool PostgresqlConnection::drv_executeSql(const KDbEscapedString& sql)
     return status == PGRES_TUPLES_OK || status == PGRES_COMMAND_OK;
 }
 
+bool PostgresqlConnection::drv_cancel()
+{
+    if (!d->conn) {
+        return false;
+    }
+    PGcancel *cancel = PQgetCancel(d->conn);
+    if (!cancel) {
+        return false;
+    }
+    char errbuf[256];
+    const bool ok = PQcancel(cancel, errbuf, sizeof(errbuf));
+    if (!ok) {
+        postgresqlWarning() << "Could not cancel statement:" << errbuf;
+    }
+    PQfreeCancel(cancel);
+    return ok;
+}
+
+bool PostgresqlConnection::drv_setStatementTimeout(int msecs)
+{
+    return drv_executeSql(KDbEscapedString("SET statement_timeout = %1").arg(msecs));
+}
+
+//! Appends @a value to @a data using the text format of COPY
+static void appendCopyValue(QByteArray *data, KDbField::Type type, const QVariant &value)
+{
+    if (value.isNull()) {
+        data->append("\\N");
+        return;
+    }
+    QByteArray text;
+    switch (type) {
+    case KDbField::Boolean:
+        data->append(value.toBool() ? 't' : 'f');
+        return;
+    case KDbField::Byte:
+    case KDbField::ShortInteger:
+    case KDbField::Integer:
+    case KDbField::BigInteger:
+        data->append(value.toByteArray());
+        return;
+    case KDbField::Float:
+    case KDbField::Double:
+        data->append(QByteArray::number(value.toDouble(), 'g', 17));
+        return;
+    case KDbField::Date:
+        data->append(value.toDate().toString(Qt::ISODate).toLatin1());
+        return;
+    case KDbField::DateTime:
+        data->append(value.toDateTime().toString(QLatin1String("yyyy-MM-ddTHH:mm:ss.zzz")).toLatin1());
+        return;
+    case KDbField::Time:
+        data->append(value.toTime().toString(QLatin1String("HH:mm:ss.zzz")).toLatin1());
+        return;
+    case KDbField::BLOB:
+        data->append("\\\\x"); // escaped backslash of the bytea hex format
+        data->append(value.toByteArray().toHex());
+        return;
+    default:
+        text = value.toString().toUtf8();
+    }
+    for (const char c : text) {
+        switch (c) {
+        case '\\': data->append("\\\\"); break;
+        case '\n': data->append("\\n"); break;
+        case '\r': data->append("\\r"); break;
+        case '\t': data->append("\\t"); break;
+        default: data->append(c);
+        }
+    }
+}
+
+bool PostgresqlConnection::drv_insertBatch(KDbFieldList *fields, const KDbImportBatch &batch)
+{
+    const KDbField::List *fieldList = fields->fields();
+    QByteArray sql("COPY ");
+    sql += escapeIdentifier(fieldList->first()->table()->name()).toUtf8() + " (";
+    QVector<KDbField::Type> types;
+    for (const KDbField *field : *fieldList) {
+        if (!types.isEmpty()) {
+            sql += ", ";
+        }
+        sql += escapeIdentifier(field->name()).toUtf8();
+        types.append(field->type());
+    }
+    sql += ") FROM STDIN";
+    PGresult *result = d->executeSql(KDbEscapedString(sql));
+    ExecStatusType status = PQresultStatus(result);
+    if (status != PGRES_COPY_IN) {
+        d->storeResultAndClear(&m_result, &result, status);
+        return false;
+    }
+    PQclear(result);
+    // Send the data in pieces of about 64 KiB
+    QByteArray data;
+    bool ok = true;
+    const int columnCount = types.count();
+    for (int record = 0; record < batch.recordCount && ok; ++record) {
+        for (int column = 0; column < columnCount; ++column) {
+            if (column > 0) {
+                data.append('\t');
+            }
+            appendCopyValue(&data, types[column], batch.columns[column][record]);
+        }
+        data.append('\n');
+        if (data.size() >= 64 * 1024 || record == batch.recordCount - 1) {
+            ok = PQputCopyData(d->conn, data.constData(), data.size()) == 1;
+            data.clear();
+        }
+    }
+    if (PQputCopyEnd(d->conn, ok ? nullptr : "could not send data") != 1) {
+        ok = false;
+    }
+    // Collect results of the COPY statement
+    while ((result = PQgetResult(d->conn))) {
+        status = PQresultStatus(result);
+        if (status == PGRES_COMMAND_OK) {
+            PQclear(result);
+        } else {
+            ok = false;
+            d->storeResultAndClear(&m_result, &result, status);
+        }
+    }
+    if (!ok && !m_result.isError()) {
+        d->storeResult(&m_result);
+    }
+    return ok;
+}
+
+bool PostgresqlConnection::drv_updateTableStatistics(const QString &tableName)
+{
+    return drv_executeSql(KDbEscapedString("ANALYZE %1").arg(escapeIdentifier(tableName)));
+}
+
+tristate PostgresqlConnection::drv_approximateRecordCount(const KDbTableSchema &tableSchema,
+                                                          int *count)
+{
+    QString tuples;
+    const tristate result = querySingleString(
+        KDbEscapedString("SELECT reltuples FROM pg_class WHERE relkind='r' AND relname=%1")
+            .arg(escapeString(tableSchema.name())), &tuples);
+    if (result != true) {
+        return result == false ? tristate(false) : cancelled;
+    }
+    bool ok;
+    const double records = tuples.toDouble(&ok);
+    // reltuples is -1 (0 before PostgreSQL 14) for tables that have never been analyzed;
+    // counting records of tables that are really empty is cheap anyway
+    if (!ok || records <= 0) {
+        return cancelled;
+    }
+    *count = int(qMin(records, double(std::numeric_limits<int>::max())));
+    return true;
+}
+
 bool PostgresqlConnection::drv_isDatabaseUsed() const
 {
     return d->conn;
@@ -87,6 +87,16 @@ private:
     //! Executes an SQL statement
     Q_REQUIRED_RESULT KDbSqlResult *drv_prepareSql(const KDbEscapedString &sql) override;
     bool drv_executeSql(const KDbEscapedString& sql) override;
+    //! Requests cancellation of the current statement using PQcancel()
+    bool drv_cancel() override;
+    //! Sets the statement_timeout parameter for the session
+    bool drv_setStatementTimeout(int msecs) override;
+    //! Inserts records using COPY ... FROM STDIN
+    bool drv_insertBatch(KDbFieldList *fields, const KDbImportBatch &batch) override;
+    //! Executes ANALYZE for the table
+    bool drv_updateTableStatistics(const QString &tableName) override;
+    //! Reads number of records from pg_class.reltuples
+    tristate drv_approximateRecordCount(const KDbTableSchema &tableSchema, int *count) override;
 
     //! Implemented for KDbResultable
     QString serverResultName() const override;
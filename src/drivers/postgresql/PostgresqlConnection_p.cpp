@@ -47,6 +47,12 @@ void PostgresqlConnectionInternal::storeResultAndClear(KDbResult *result, PGresu
     }
     result->setServerMessage(QString::fromLatin1(msg));
     if (*pgResult) {
+        // "query_canceled" is reported for both PQcancel() and exceeded statement_timeout;
+        // the former is already known to the connection
+        const char *sqlState = PQresultErrorField(*pgResult, PG_DIAG_SQLSTATE);
+        if (sqlState && qstrcmp(sqlState, "57014") == 0) {
+            statementTimedOut();
+        }
         result->setServerErrorCode(execStatus);
         PQclear(*pgResult);
         *pgResult = nullptr;
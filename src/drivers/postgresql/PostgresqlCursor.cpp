@@ -24,6 +24,7 @@
 #include "PostgresqlDriver.h"
 #include "postgresql_debug.h"
 
+#include "KDbColumnBatch.h"
 #include "KDbError.h"
 #include "KDbGlobal.h"
 #include "KDbRecordData.h"
@@ -129,7 +130,7 @@ void PostgresqlCursor::drv_getPrevRecord()
 QVariant PostgresqlCursor::value(int pos)
 {
     if (pos < m_fieldCount)
-        return pValue(pos);
+        return pValue(at(), pos);
     else
         return QVariant();
 }
@@ -219,10 +220,9 @@ static inline QByteArray byteArrayFromData(const char *data)
 
 //==================================================================================
 //Return the value for a given column for the current record - Private const version
-QVariant PostgresqlCursor::pValue(int pos) const
+QVariant PostgresqlCursor::pValue(qint64 row, int pos) const
 {
 //  postgresqlWarning() << "PostgresqlCursor::value - ERROR: requested position is greater than the number of fields";
-    const qint64 row = at();
 
     KDbField *f = (m_visibleFieldsExpanded && pos < qMin(m_visibleFieldsExpanded->count(), m_fieldCount))
                        ? m_visibleFieldsExpanded->at(pos)->field() : nullptr;
@@ -301,11 +301,59 @@ const char** PostgresqlCursor::recordData() const
 bool PostgresqlCursor::drv_storeCurrentRecord(KDbRecordData* data) const
 {
 // postgresqlDebug() << "POSITION IS" << (long)m_at;
+    const qint64 row = at();
     for (int i = 0; i < m_fieldsToStoreInRecord; i++)
-        (*data)[i] = pValue(i);
+        (*data)[i] = pValue(row, i);
     return true;
 }
 
+//==================================================================================
+//Store slices of columns of the result in [batch]
+int PostgresqlCursor::drv_fetchBatch(KDbColumnBatch *batch, int maxRecords)
+{
+    const qint64 first = m_at; // index of the record following the current one
+    const qint64 numRows = m_numRows;
+    if (first < 0 || first >= numRows) {
+        m_fetchResult = FetchResult::End;
+        return 0;
+    }
+    const int count = int(qMin(qint64(maxRecords), numRows - first));
+    for (int i = 0; i < batch->columnCount(); ++i) {
+        const KDbColumnBatch::Storage storage = batch->storage(i);
+        const KDbField::Type type = m_realTypes[i];
+        const int maxLength = m_realLengths[i];
+        for (qint64 row = first; row < first + count; ++row) {
+            if (PQgetisnull(d->res, row, i)) {
+                batch->appendNull(i);
+                continue;
+            }
+            const char *data = PQgetvalue(d->res, row, i);
+            int len = PQgetlength(d->res, row, i);
+            if (storage == KDbColumnBatch::Storage::Integer
+                && (type == KDbField::Integer || type == KDbField::BigInteger))
+            {
+                batch->appendInteger(i, QByteArray::fromRawData(data, len).toLongLong());
+            } else if (storage == KDbColumnBatch::Storage::Integer && type == KDbField::Boolean) {
+                batch->appendInteger(i, data[0] == 't' ? 1 : 0);
+            } else if (storage == KDbColumnBatch::Storage::Real && type == KDbField::Double) {
+                batch->appendReal(i, QByteArray::fromRawData(data, len).toDouble());
+            } else if (storage == KDbColumnBatch::Storage::Text
+                       && (type == KDbField::Text || type == KDbField::LongText))
+            {
+                if (maxLength > 0) {
+                    len = qMin(len, maxLength);
+                }
+                batch->appendText(i, d->unicode ? QString::fromUtf8(data, len)
+                                                : QString::fromLatin1(data, len));
+            } else {
+                batch->appendValue(i, pValue(row, i));
+            }
+        }
+    }
+    m_fetchResult = count < maxRecords ? FetchResult::End : FetchResult::Ok;
+    return count;
+}
+
 //==================================================================================
 //
 /*void PostgresqlCursor::drv_clearServerResult()
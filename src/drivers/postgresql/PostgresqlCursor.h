@@ -44,6 +44,7 @@ public:
     bool drv_open(const KDbEscapedString& sql) override;
     bool drv_close() override;
     void drv_getNextRecord() override;
+    int drv_fetchBatch(KDbColumnBatch *batch, int maxRecords) override;
     void drv_appendCurrentRecordToBuffer() override;
     void drv_bufferMovePointerNext() override;
     void drv_bufferMovePointerPrev() override;
@@ -52,7 +53,8 @@ public:
     void storeResultAndClear(PGresult **pgResult, ExecStatusType execStatus);
 
 private:
-    QVariant pValue(int pos)const;
+    //! @return value of column @a pos of record @a row
+    QVariant pValue(qint64 row, int pos) const;
 
     unsigned long m_numRows;
     QVector<KDbField::Type> m_realTypes;
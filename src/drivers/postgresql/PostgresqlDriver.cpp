@@ -25,6 +25,7 @@
 #include "KDbDriverBehavior.h"
 #include "KDbExpression.h"
 #include "KDb.h"
+#include "KDbEscaping_p.h"
 
 #include "PostgresqlConnection.h"
 
@@ -57,11 +58,12 @@ PostgresqlDriver::PostgresqlDriver(QObject *parent, const QVariantList &args)
     beh->BOOLEAN_TRUE_LITERAL = QLatin1String("TRUE");
     beh->BOOLEAN_FALSE_LITERAL = QLatin1String("FALSE");
     beh->USE_TEMPORARY_DATABASE_FOR_CONNECTION_IF_NEEDED = true;
+    beh->FAILED_STATEMENT_ABORTS_TRANSACTION = true;
     beh->GET_TABLE_NAMES_SQL = KDbEscapedString(
         "SELECT table_name FROM information_schema.tables WHERE "
         "table_type='BASE TABLE' AND table_schema NOT IN ('pg_catalog', 'information_schema')");
 
-    initDriverSpecificKeywords(m_keywords);
+    initDriverSpecificKeywords(&keywords);
     initPgsqlToKDbMap();
 
     //predefined properties
@@ -103,6 +105,13 @@ QString PostgresqlDriver::sqlTypeName(KDbField::Type type, const KDbField &field
     return KDbDriver::sqlTypeName(type, field);
 }
 
+KDbEscapedString PostgresqlDriver::typeConversionToString(const KDbEscapedString &expression,
+                                                          const KDbField &field) const
+{
+    return KDbEscapedString("CAST(%1 AS %2)").arg(expression)
+            .arg(sqlTypeName(field.type(), field));
+}
+
 KDbConnection* PostgresqlDriver::drv_createConnection(const KDbConnectionData& connData,
                                                       const KDbConnectionOptions &options)
 {
@@ -128,14 +137,19 @@ bool PostgresqlDriver::isSystemDatabaseName(const QString& name) const
            || 0 == name.compare(QLatin1String("postgres"), Qt::CaseInsensitive);
 }
 
+//! Rules of escaping string literals for PostgreSQL
+static const KDbStringEscapingRules& postgresqlEscapingRules()
+{
+    static const KDbStringEscapingRules rules{{'\\', "\\\\"}, {'\'', "\\'"}};
+    return rules;
+}
+
 KDbEscapedString PostgresqlDriver::escapeString(const QString& str) const
 {
     //Cannot use libpq escape functions as they require a db connection
     //to escape using the char encoding of the database
     //see https://www.postgresql.org/docs/8.1/static/libpq-exec.html#LIBPQ-EXEC-ESCAPE-STRING
-    return KDbEscapedString("E'")
-           + KDbEscapedString(str).replace("\\", "\\\\").replace("'", "\\\'")
-           + "'";
+    return kdbEscapeString(str, postgresqlEscapingRules(), "E'");
 }
 
 KDbEscapedString PostgresqlDriver::escapeString(const QByteArray& str) const
@@ -143,9 +157,7 @@ KDbEscapedString PostgresqlDriver::escapeString(const QByteArray& str) const
     //Cannot use libpq escape functions as they require a db connection
     //to escape using the char encoding of the database
     //see https://www.postgresql.org/docs/8.1/static/libpq-exec.html#LIBPQ-EXEC-ESCAPE-STRING
-    return KDbEscapedString("'")
-           + QByteArray(str).replace("\\", "\\\\").replace("'", "\\\'")
-           + "'";
+    return kdbEscapeString(str, postgresqlEscapingRules());
 }
 
 QString PostgresqlDriver::drv_escapeIdentifier(const QString& str) const
@@ -160,7 +172,7 @@ QByteArray PostgresqlDriver::drv_escapeIdentifier(const QByteArray& str) const
 
 KDbEscapedString PostgresqlDriver::escapeBLOB(const QByteArray& array) const
 {
-    return KDbEscapedString(KDb::escapeBLOB(array, KDb::BLOBEscapingType::ByteaHex));
+    return kdbEscapeBLOB(array, KDb::BLOBEscapingType::ByteaHex);
 }
 
 KDbEscapedString PostgresqlDriver::hexFunctionToString(const KDbNArgExpression &args,
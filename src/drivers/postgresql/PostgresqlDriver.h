@@ -134,6 +134,11 @@ public:
                                              KDbQuerySchemaParameterValueListIterator* params,
                                              KDb::ExpressionCallStack* callStack) const override;
 
+    //! Generates native (driver-specific) type conversion.
+    //! Uses CAST(X AS T) because values are not converted implicitly between all types.
+    KDbEscapedString typeConversionToString(const KDbEscapedString &expression,
+                                            const KDbField &field) const override;
+
 protected:
     QString drv_escapeIdentifier(const QString& str) const override;
     QByteArray drv_escapeIdentifier(const QByteArray& str) const override;
@@ -144,7 +149,7 @@ protected:
 private:
     void initPgsqlToKDbMap();
 
-    static const char *m_keywords[];
+    static const KDbKeywordTable keywords;
     QMap<int, KDbField::Type> m_pgsqlToKDbTypes;
     Q_DISABLE_COPY(PostgresqlDriver)
 };
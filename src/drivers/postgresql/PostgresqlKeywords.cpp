@@ -1,10 +1,9 @@
 /* This file is part of the KDE project
    Copyright (C) 2004 Martin Ellis <martin.ellis@kdemail.net>
-   Copyright (C) 2004 Jarosław Staniek <staniek@kde.org>
+   Copyright (C) 2004-2018 Jarosław Staniek <staniek@kde.org>
 
    This file has been automatically generated from
-   tools/sql_keywords/sql_keywords.sh and
-   postgresql-7.4.6/src/backend/parser/keywords.c.
+   tools/sql_keywords.sh and postgresql-7.4.6/src/backend/parser/keywords.c.
 
    Please edit the sql_keywords.sh, not this file!
 
@@ -25,237 +24,160 @@
 */
 
 #include "PostgresqlDriver.h"
+#include "KDbKeywordTable_p.h"
 
-const char* PostgresqlDriver::m_keywords[] = {
-    "ABORT",
-    "ABSOLUTE",
-    "ACCESS",
-    "ACTION",
-    "ADD",
-    "AGGREGATE",
-    "ALTER",
-    "ANALYSE",
-    "ANALYZE",
-    "ANY",
-    "ARRAY",
-    "ASSERTION",
-    "ASSIGNMENT",
-    "AT",
-    "AUTHORIZATION",
-    "BACKWARD",
-    "BIGINT",
-    "BINARY",
-    "BIT",
-    "BOOLEAN",
-    "BOTH",
-    "CACHE",
-    "CALLED",
-    "CAST",
-    "CHAIN",
-    "CHAR",
-    "CHARACTER",
-    "CHARACTERISTICS",
-    "CHECKPOINT",
-    "CLASS",
-    "CLOSE",
-    "CLUSTER",
-    "COALESCE",
-    "COLUMN",
-    "COMMENT",
-    "COMMITTED",
-    "CONSTRAINTS",
-    "CONVERSION",
-    "CONVERT",
-    "COPY",
-    "CREATEDB",
-    "CREATEUSER",
-    "CURRENT_DATE",
-    "CURRENT_TIME",
-    "CURRENT_TIMESTAMP",
-    "CURRENT_USER",
-    "CURSOR",
-    "CYCLE",
-    "DAY",
-    "DEALLOCATE",
-    "DEC",
-    "DECIMAL",
-    "DECLARE",
-    "DEFAULTS",
-    "DEFERRABLE",
-    "DEFERRED",
-    "DEFINER",
-    "DELIMITER",
-    "DELIMITERS",
-    "DO",
-    "DOMAIN",
-    "DOUBLE",
-    "EACH",
-    "ENCODING",
-    "ENCRYPTED",
-    "ESCAPE",
-    "EXCEPT",
-    "EXCLUDING",
-    "EXCLUSIVE",
-    "EXECUTE",
-    "EXISTS",
-    "EXTERNAL",
-    "EXTRACT",
-    "FALSE",
-    "FETCH",
-    "FIRST",
-    "FLOAT",
-    "FORCE",
-    "FORWARD",
-    "FREEZE",
-    "FUNCTION",
-    "GLOBAL",
-    "GRANT",
-    "HANDLER",
-    "HOLD",
-    "HOUR",
-    "ILIKE",
-    "IMMEDIATE",
-    "IMMUTABLE",
-    "IMPLICIT",
-    "INCLUDING",
-    "INCREMENT",
-    "INHERITS",
-    "INITIALLY",
-    "INOUT",
-    "INPUT",
-    "INSENSITIVE",
-    "INSTEAD",
-    "INT",
-    "INTERSECT",
-    "INTERVAL",
-    "INVOKER",
-    "ISNULL",
-    "ISOLATION",
-    "LANCOMPILER",
-    "LANGUAGE",
-    "LAST",
-    "LEADING",
-    "LEVEL",
-    "LISTEN",
-    "LOAD",
-    "LOCAL",
-    "LOCALTIME",
-    "LOCALTIMESTAMP",
-    "LOCATION",
-    "LOCK",
-    "MAXVALUE",
-    "MINUTE",
-    "MINVALUE",
-    "MODE",
-    "MONTH",
-    "MOVE",
-    "NAMES",
-    "NATIONAL",
-    "NCHAR",
-    "NEW",
-    "NEXT",
-    "NO",
-    "NOCREATEDB",
-    "NOCREATEUSER",
-    "NONE",
-    "NOTHING",
-    "NOTIFY",
-    "NOTNULL",
-    "NULLIF",
-    "NUMERIC",
-    "OF",
-    "OFF",
-    "OIDS",
-    "OLD",
-    "ONLY",
-    "OPERATOR",
-    "OPTION",
-    "OUT",
-    "OVERLAPS",
-    "OVERLAY",
-    "OWNER",
-    "PARTIAL",
-    "PASSWORD",
-    "PATH",
-    "PENDANT",
-    "PLACING",
-    "POSITION",
-    "PRECISION",
-    "PREPARE",
-    "PRESERVE",
-    "PRIOR",
-    "PRIVILEGES",
-    "PROCEDURAL",
-    "PROCEDURE",
-    "READ",
-    "REAL",
-    "RECHECK",
-    "REINDEX",
-    "RELATIVE",
-    "RENAME",
-    "RESET",
-    "RESTART",
-    "RETURNS",
-    "REVOKE",
-    "ROWS",
-    "RULE",
-    "SCHEMA",
-    "SCROLL",
-    "SECOND",
-    "SECURITY",
-    "SEQUENCE",
-    "SERIALIZABLE",
-    "SESSION",
-    "SESSION_USER",
-    "SETOF",
-    "SHARE",
-    "SHOW",
-    "SIMPLE",
-    "SMALLINT",
-    "SOME",
-    "STABLE",
-    "START",
-    "STATEMENT",
-    "STATISTICS",
-    "STDIN",
-    "STDOUT",
-    "STORAGE",
-    "STRICT",
-    "SUBSTRING",
-    "SYSID",
-    "TEMP",
-    "TEMPLATE",
-    "TIME",
-    "TIMESTAMP",
-    "TOAST",
-    "TRAILING",
-    "TREAT",
-    "TRIGGER",
-    "TRIM",
-    "TRUE",
-    "TRUNCATE",
-    "TRUSTED",
-    "TYPE",
-    "UNENCRYPTED",
-    "UNKNOWN",
-    "UNLISTEN",
-    "UNTIL",
-    "USAGE",
-    "USER",
-    "VACUUM",
-    "VALID",
-    "VALIDATOR",
-    "VARCHAR",
-    "VARYING",
-    "VERBOSE",
-    "VERSION",
-    "VIEW",
-    "VOLATILE",
-    "WITH",
-    "WITHOUT",
-    "WORK",
-    "WRITE",
-    "YEAR",
-    "ZONE",
-    nullptr
+//! 230 keywords in 512 slots
+static constexpr const char* postgresqlKeywordSlots[] = {
+    "YEAR", "NOCREATEDB", "ISNULL", "ROWS",
+    "ADD", "BIGINT", "SESSION", "INOUT",
+    "PASSWORD", "FREEZE", "RELATIVE", "VALID",
+    "REVOKE", "EXCLUDING", "PATH", "ALTER",
+    "DAY", "TYPE", "NAMES", "INCLUDING",
+    "FALSE", "REINDEX", "PROCEDURAL", "STATEMENT",
+    "UNKNOWN", "PRIVILEGES", "REAL", "EXCLUSIVE",
+    "PREPARE", "DEC", "SHOW", "PROCEDURE",
+    "COPY", "BOTH", "DOUBLE", "ENCODING",
+    "LAST", "TEMP", "RULE", "INSENSITIVE",
+    "ABSOLUTE", "PRECISION", "VIEW", "LANGUAGE",
+    "SESSION_USER", "HOUR", "FORWARD", "FETCH",
+    "OUT", "TEMPLATE", "FIRST", "CHECKPOINT",
+    "SETOF", "STDIN", "NO", "VARYING",
+    "INPUT", "SECOND", "CURSOR", "CYCLE",
+    "DEFINER", "SEQUENCE", "WITHOUT", "CLOSE",
+    "EXECUTE", "STABLE", "TRUNCATE", nullptr,
+    "SMALLINT", "OLD", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "OIDS", "TRUE", nullptr,
+    "INTERVAL", "INHERITS", "IMMEDIATE", "SCHEMA",
+    "ACTION", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "MOVE", "LEVEL", "COLUMN", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "CONSTRAINTS", nullptr, nullptr, "PLACING",
+    "UNENCRYPTED", "DEFERRABLE", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "NEXT", "BIT", nullptr, nullptr,
+    nullptr, "INITIALLY", "DEALLOCATE", nullptr,
+    nullptr, nullptr, "MODE", nullptr,
+    nullptr, "BOOLEAN", nullptr, nullptr,
+    nullptr, nullptr, nullptr, "COMMITTED",
+    nullptr, nullptr, nullptr, "LANCOMPILER",
+    nullptr, "ANALYZE", "DECIMAL", "DECLARE",
+    "TIME", nullptr, nullptr, "CURRENT_TIMESTAMP",
+    nullptr, nullptr, nullptr, nullptr,
+    "CURRENT_DATE", "COALESCE", nullptr, nullptr,
+    nullptr, nullptr, nullptr, "OVERLAY",
+    nullptr, "FORCE", "TRUSTED", nullptr,
+    nullptr, "STATISTICS", nullptr, nullptr,
+    nullptr, "CLASS", nullptr, nullptr,
+    "LOCALTIME", nullptr, nullptr, nullptr,
+    nullptr, "SOME", "MINVALUE", nullptr,
+    nullptr, nullptr, "CAST", "AT",
+    "DO", "BACKWARD", nullptr, "USAGE",
+    nullptr, nullptr, nullptr, "MONTH",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "VERBOSE",
+    nullptr, nullptr, "RESET", nullptr,
+    "CREATEUSER", "NEW", nullptr, nullptr,
+    "TRAILING", nullptr, nullptr, "PRIOR",
+    nullptr, nullptr, nullptr, "EXTRACT",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "ANALYSE", "CLUSTER",
+    "ARRAY", "LOCAL", "AUTHORIZATION", "OPTION",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "TOAST", "SYSID", "ACCESS",
+    "RESTART", nullptr, nullptr, nullptr,
+    "CONVERSION", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "TREAT",
+    nullptr, nullptr, nullptr, "DEFERRED",
+    nullptr, nullptr, nullptr, "NOTHING",
+    nullptr, nullptr, nullptr, "SUBSTRING",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "OPERATOR", nullptr, nullptr,
+    nullptr, nullptr, "LOAD", nullptr,
+    nullptr, "GRANT", nullptr, nullptr,
+    "STRICT", nullptr, "VACUUM", nullptr,
+    nullptr, nullptr, "TIMESTAMP", "LOCK",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "ZONE", nullptr, nullptr,
+    nullptr, nullptr, nullptr, "POSITION",
+    nullptr, nullptr, "IMPLICIT", nullptr,
+    nullptr, "ILIKE", "VERSION", nullptr,
+    nullptr, nullptr, "COMMENT", nullptr,
+    "LISTEN", nullptr, nullptr, "VARCHAR",
+    "STORAGE", "PENDANT", "WRITE", "ASSIGNMENT",
+    nullptr, nullptr, "HANDLER", "PRESERVE",
+    nullptr, nullptr, "DELIMITER", "USER",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "UNTIL",
+    "STDOUT", nullptr, "LEADING", "CHARACTER",
+    nullptr, nullptr, nullptr, nullptr,
+    "SIMPLE", nullptr, "AGGREGATE", nullptr,
+    "NOCREATEUSER", "BINARY", nullptr, "INT",
+    nullptr, nullptr, "SHARE", nullptr,
+    nullptr, "OFF", nullptr, "CHARACTERISTICS",
+    "EXTERNAL", nullptr, "DEFAULTS", nullptr,
+    nullptr, nullptr, "VOLATILE", nullptr,
+    nullptr, nullptr, "CACHE", "CREATEDB",
+    "SERIALIZABLE", nullptr, nullptr, nullptr,
+    nullptr, nullptr, "NUMERIC", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "CHAR", "ASSERTION", nullptr, "EXCEPT",
+    nullptr, nullptr, "OVERLAPS", "WORK",
+    "LOCATION", nullptr, "EACH", "FUNCTION",
+    nullptr, "MAXVALUE", nullptr, nullptr,
+    nullptr, "INTERSECT", "NOTNULL", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "NCHAR", nullptr, "FLOAT", nullptr,
+    "INSTEAD", nullptr, "SECURITY", nullptr,
+    "ONLY", nullptr, nullptr, nullptr,
+    "TRIGGER", "OWNER", nullptr, nullptr,
+    "ENCRYPTED", nullptr, nullptr, nullptr,
+    nullptr, nullptr, "START", nullptr,
+    nullptr, nullptr, "CHAIN", nullptr,
+    nullptr, nullptr, "MINUTE", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "CURRENT_TIME", "ISOLATION", nullptr,
+    "NOTIFY", nullptr, "RENAME", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "NATIONAL", nullptr,
+    nullptr, "EXISTS", nullptr, nullptr,
+    nullptr, "DELIMITERS", "DOMAIN", "IMMUTABLE",
+    nullptr, "INCREMENT", nullptr, nullptr,
+    "VALIDATOR", "CONVERT", nullptr, nullptr,
+    "GLOBAL", "PARTIAL", "READ", nullptr,
+    nullptr, "ABORT", nullptr, "RECHECK",
+    "HOLD", "NONE", nullptr, "CURRENT_USER",
+    nullptr, nullptr, "WITH", nullptr,
+    "UNLISTEN", "ANY", "NULLIF", "ESCAPE",
+    "TRIM", nullptr, nullptr, "LOCALTIMESTAMP",
+    "SCROLL", nullptr, nullptr, nullptr,
+    "OF", nullptr, nullptr, "RETURNS",
+    nullptr, "INVOKER", nullptr, "CALLED",
 };
+
+static constexpr int postgresqlKeywordDisplacements[] = {
+    2, 3, 1, 1, 1, 2, 1, 2, 3, -1,
+    2, 1, 1, 1, -4, -5, 1, -1, 1, 1,
+    -1, -6, 5, 1, -7, 1, 2, -9, 2, -1,
+    2, -1, 1, 1, -10, 3, 1, -1, 2, -1,
+    1, 5, 1, -14, 1, 4, 2, -17, -20, 5,
+    2, 2, 5, 3, 1, 1, 1, 1, -21, -1,
+    2, -1, -22, -1, -23, -1, -26, 1, 1, 1,
+    -1, 1, 1, -27, -1, -28, -1, 1, -29, -30,
+    -1, 3, -1, -32, -33, -34, 1, -35, -1, -37,
+    1, -38, 4, 2, -39, -41, -43, 3, -44, -46,
+    3, -49, -1, 1, -52, -54, 1, -57, 2, -58,
+    3, 1, -1, 1, -63, 3, 3, -64, 1, -1,
+    -65, -1, -1, 4, 3, -67, 1, 1,
+};
+
+static constexpr KDbKeywordTable postgresqlKeywordTable = {
+    postgresqlKeywordSlots, 512, postgresqlKeywordDisplacements, 128
+};
+
+static_assert(postgresqlKeywordTable.isValid(), "Invalid keyword table");
+
+const KDbKeywordTable PostgresqlDriver::keywords = postgresqlKeywordTable;
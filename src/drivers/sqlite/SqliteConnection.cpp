@@ -36,6 +36,8 @@
 #include <QDir>
 #include <QRegularExpression>
 
+#include <limits>
+
 SqliteConnection::SqliteConnection(KDbDriver *driver, const KDbConnectionData& connData,
                                    const KDbConnectionOptions &options)
         : KDbConnection(driver, connData, options)
@@ -152,26 +154,26 @@ bool SqliteConnection::drv_useDatabaseInternal(bool *cancelled,
 //    const bool wasReadOnly = KDbConnection::isReadOnly();
 
     //sqliteDebug() << data().databaseName();
+    sqlite3 *handle = nullptr;
     int res = sqlite3_open_v2(
                  /* unicode expected since SQLite 3.1 */
                  QDir::toNativeSeparators(data().databaseName()).toUtf8().constData(),
-                 &d->data,
+                 &handle,
                  openFlags, /*exclusiveFlag,
                  allowReadonly *//* If 1 and locking fails, try opening in read-only mode */
                  nullptr
              );
+    {
+        QMutexLocker locker(&d->dataMutex);
+        d->data = handle;
+    }
     if (res != SQLITE_OK) {
         m_result.setServerErrorCode(res);
     }
     storeResult();
 
     if (!m_result.isError()) {
-        // Set the secure-delete on, so SQLite overwrites deleted content with zeros.
-        // The default setting is determined by the SQLITE_SECURE_DELETE compile-time option but we overwrite it here.
-        // Works with 3.6.23. Earlier version just ignore this pragma.
-        // See https://www.sqlite.org/pragma.html#pragma_secure_delete
-//! @todo add connection flags to the driver and global setting to control the "secure delete" pragma
-        if (!drv_executeSql(KDbEscapedString("PRAGMA secure_delete = on"))) {
+        if (!applyPerformanceSettings()) {
             drv_closeDatabaseSilently();
             return false;
         }
@@ -237,6 +239,129 @@ bool SqliteConnection::drv_useDatabaseInternal(bool *cancelled,
     return res == SQLITE_OK;
 }
 
+namespace {
+
+//! Sets @a target to value of option @a name if it is one of @a allowed (case-insensitive).
+//! @return false if the option exists and has other value.
+bool readNameOverride(const KDbConnectionOptions &options, const QByteArray &name,
+                      const QList<QByteArray> &allowed, QByteArray *target)
+{
+    const KDbUtils::Property property = options.property(name);
+    if (property.isNull()) {
+        return true;
+    }
+    const QByteArray value = property.value().toString().toLatin1().toLower();
+    if (!allowed.contains(value)) {
+        return false;
+    }
+    *target = value;
+    return true;
+}
+
+//! Sets @a target to value of option @a name if it is an integer from @a min to @a max.
+//! @return false if the option exists and has other value.
+bool readNumberOverride(const KDbConnectionOptions &options, const QByteArray &name,
+                        qint64 min, qint64 max, QVariant *target)
+{
+    const KDbUtils::Property property = options.property(name);
+    if (property.isNull()) {
+        return true;
+    }
+    bool ok;
+    const qint64 value = property.value().toLongLong(&ok);
+    if (!ok || value < min || value > max) {
+        return false;
+    }
+    *target = value;
+    return true;
+}
+
+} // namespace
+
+bool SqliteConnection::applyPerformanceSettings()
+{
+    const KDbConnectionOptions &opt = *options();
+    SqlitePerformanceSettings settings(opt.performanceProfile());
+    QByteArray invalidOption;
+    if (!readNameOverride(opt, "sqliteJournalMode",
+                          { "delete", "truncate", "persist", "memory", "wal", "off" },
+                          &settings.journalMode))
+    {
+        invalidOption = "sqliteJournalMode";
+    } else if (!readNameOverride(opt, "sqliteSynchronous", { "off", "normal", "full", "extra" },
+                                 &settings.synchronous))
+    {
+        invalidOption = "sqliteSynchronous";
+    } else if (!readNameOverride(opt, "sqliteTempStore", { "default", "file", "memory" },
+                                 &settings.tempStore))
+    {
+        invalidOption = "sqliteTempStore";
+    } else if (!readNumberOverride(opt, "sqliteCacheSize", std::numeric_limits<int>::min(),
+                                   std::numeric_limits<int>::max(), &settings.cacheSize))
+    {
+        invalidOption = "sqliteCacheSize";
+    } else if (!readNumberOverride(opt, "sqliteMmapSize", 0, std::numeric_limits<qint64>::max(),
+                                   &settings.mmapSize))
+    {
+        invalidOption = "sqliteMmapSize";
+    } else if (!readNumberOverride(opt, "sqlitePageSize", 512, 65536, &settings.pageSize)
+               || (settings.pageSize.toLongLong() & (settings.pageSize.toLongLong() - 1)) != 0)
+    {
+        invalidOption = "sqlitePageSize";
+    }
+    if (!invalidOption.isEmpty()) {
+        m_result = KDbResult(ERR_OTHER,
+                             tr("Invalid value \"%1\" of connection option \"%2\".")
+                             .arg(opt.property(invalidOption).value().toString(),
+                                  QLatin1String(invalidOption)));
+        return false;
+    }
+    const KDbUtils::Property secureDelete = opt.property("sqliteSecureDelete");
+    if (!secureDelete.isNull()) {
+        settings.secureDelete = secureDelete.value().toBool();
+    }
+
+    const auto pragma = [this](const char *name, const QByteArray &value) {
+        QByteArray sql("PRAGMA ");
+        sql += name;
+        sql += " = ";
+        sql += value;
+        return drv_executeSql(KDbEscapedString(sql));
+    };
+    // page size has to be set before switching to WAL mode
+    if (!settings.pageSize.isNull()
+        && !pragma("page_size", QByteArray::number(settings.pageSize.toLongLong())))
+    {
+        return false;
+    }
+    if (!pragma("secure_delete", settings.secureDelete ? "on" : "off")) {
+        return false;
+    }
+    // changing journal mode requires write access
+    if (!settings.journalMode.isEmpty() && !opt.isReadOnly()
+        && !pragma("journal_mode", settings.journalMode))
+    {
+        return false;
+    }
+    if (!settings.synchronous.isEmpty() && !pragma("synchronous", settings.synchronous)) {
+        return false;
+    }
+    if (!settings.tempStore.isEmpty() && !pragma("temp_store", settings.tempStore)) {
+        return false;
+    }
+    if (!settings.cacheSize.isNull()
+        && !pragma("cache_size", QByteArray::number(settings.cacheSize.toLongLong())))
+    {
+        return false;
+    }
+    if (!settings.mmapSize.isNull()
+        && !pragma("mmap_size", QByteArray::number(settings.mmapSize.toLongLong())))
+    {
+        return false;
+    }
+    return true;
+}
+
 void SqliteConnection::drv_closeDatabaseSilently()
 {
     KDbResult result = this->result(); // save
@@ -249,6 +374,7 @@ bool SqliteConnection::drv_closeDatabase()
     if (!d->data)
         return false;
 
+    QMutexLocker locker(&d->dataMutex); // drv_cancel() can't use the handle while it's closed
     const int res = sqlite3_close(d->data);
     if (SQLITE_OK == res) {
         d->data = nullptr;
@@ -325,12 +451,15 @@ bool SqliteConnection::drv_executeSql(const KDbEscapedString& sql)
 #endif
 
     char *errmsg_p = nullptr;
+    QElapsedTimer statementTimer;
+    d->beginStatementStep(&statementTimer);
     const int res = sqlite3_exec(
                  d->data,
                  sql.constData(),
                  nullptr/*callback*/,
                  nullptr,
                  &errmsg_p);
+    d->endStatementStep();
     if (res != SQLITE_OK) {
         m_result.setServerErrorCode(res);
     }
@@ -348,6 +477,122 @@ bool SqliteConnection::drv_executeSql(const KDbEscapedString& sql)
     return res == SQLITE_OK;
 }
 
+bool SqliteConnection::drv_cancel()
+{
+    QMutexLocker locker(&d->dataMutex);
+    if (!d->data) {
+        return false;
+    }
+    // thread-safe, the statement fails with SQLITE_INTERRUPT
+    sqlite3_interrupt(d->data);
+    return true;
+}
+
+bool SqliteConnection::drv_setStatementTimeout(int msecs)
+{
+    if (!d->data) {
+        return false;
+    }
+    d->setStatementTimeout(msecs);
+    return true;
+}
+
+KDbReadSnapshotData* SqliteConnection::drv_pinReadSnapshot()
+{
+#ifdef KDB_SQLITE_SNAPSHOT
+    // BEGIN is deferred, the read transaction starts with the first read
+    if (!drv_executeSql(KDbEscapedString("BEGIN"))) {
+        return nullptr;
+    }
+    if (!drv_executeSql(KDbEscapedString("SELECT COUNT(*) FROM sqlite_master"))) {
+        sqlite3_exec(d->data, "ROLLBACK", nullptr, nullptr, nullptr);
+        return nullptr;
+    }
+    sqlite3_snapshot *snapshot = nullptr;
+    const int res = sqlite3_snapshot_get(d->data, "main", &snapshot);
+    if (res != SQLITE_OK) {
+        clearResult();
+        m_result.setServerErrorCode(res);
+        storeResult();
+        m_result.setMessage(SqliteConnection::tr("Could not pin snapshot of the database. "
+                                                 "WAL journal mode is required."));
+        sqlite3_exec(d->data, "ROLLBACK", nullptr, nullptr, nullptr);
+        return nullptr;
+    }
+    return new SqliteReadSnapshotData(snapshot);
+#else
+    m_result = KDbResult(ERR_UNSUPPORTED_DRV_FEATURE,
+                         SqliteConnection::tr("SQLite library is built without support "
+                                              "for snapshots."));
+    return nullptr;
+#endif
+}
+
+bool SqliteConnection::drv_beginReadSnapshot(KDbReadSnapshotData *snapshot)
+{
+#ifdef KDB_SQLITE_SNAPSHOT
+    if (!drv_executeSql(KDbEscapedString("BEGIN"))) {
+        return false;
+    }
+    const int res = sqlite3_snapshot_open(d->data, "main",
+                                          static_cast<SqliteReadSnapshotData*>(snapshot)->snapshot);
+    if (res != SQLITE_OK) {
+        clearResult();
+        m_result.setServerErrorCode(res);
+        storeResult();
+        m_result.setMessage(SqliteConnection::tr("Could not open snapshot of the database."));
+        sqlite3_exec(d->data, "ROLLBACK", nullptr, nullptr, nullptr);
+        return false;
+    }
+    return true;
+#else
+    Q_UNUSED(snapshot);
+    m_result = KDbResult(ERR_UNSUPPORTED_DRV_FEATURE,
+                         SqliteConnection::tr("SQLite library is built without support "
+                                              "for snapshots."));
+    return false;
+#endif
+}
+
+bool SqliteConnection::drv_endReadSnapshot()
+{
+    return drv_executeSql(KDbEscapedString("COMMIT"));
+}
+
+bool SqliteConnection::drv_updateTableStatistics(const QString &tableName)
+{
+    return drv_executeSql(KDbEscapedString("ANALYZE %1").arg(escapeIdentifier(tableName)));
+}
+
+tristate SqliteConnection::drv_approximateRecordCount(const KDbTableSchema &tableSchema,
+                                                      int *count)
+{
+    // sqlite_stat1 only exists after ANALYZE has been executed
+    const tristate statExists = resultExists(
+        KDbEscapedString("SELECT 1 FROM sqlite_master WHERE type='table' AND name='sqlite_stat1'"));
+    if (~statExists) {
+        return false;
+    }
+    if (statExists == false) {
+        return cancelled;
+    }
+    // the first number of each "stat" value is the number of records of the table
+    QString stat;
+    const tristate result = querySingleString(
+        KDbEscapedString("SELECT stat FROM sqlite_stat1 WHERE tbl=%1")
+            .arg(escapeString(tableSchema.name())), &stat);
+    if (result != true) {
+        return result == false ? tristate(false) : cancelled;
+    }
+    bool ok;
+    const qint64 records = stat.section(QLatin1Char(' '), 0, 0).toLongLong(&ok);
+    if (!ok) {
+        return cancelled;
+    }
+    *count = int(qMin(records, qint64(std::numeric_limits<int>::max())));
+    return true;
+}
+
 QString SqliteConnection::serverResultName() const
 {
     return SqliteConnectionInternal::serverResultName(m_result.serverErrorCode());
@@ -32,6 +32,27 @@ class KDbDriver;
     - extraSqliteExtensionPaths (read/write, QStringList): adds extra seach paths for SQLite
                                 extensions. Set them before KDbConnection::useDatabase()
                                 is called. Absolute paths are recommended.
+    - performanceProfile (read/write, QString): see KDbConnectionOptions::PerformanceProfile.
+      Profiles set the following PRAGMAs (- means SQLite's default):
+      profile          | journal_mode | synchronous | secure_delete | temp_store | cache_size | mmap_size
+      ---------------- | ------------ | ----------- | ------------- | ---------- | ---------- | ---------
+      default          | -            | -           | on            | -          | -          | -
+      durable          | delete       | full        | on            | -          | -          | -
+      fast-wal         | wal          | normal      | off           | memory     | 16 MiB     | -
+      read-mostly-mmap | wal          | normal      | off           | memory     | 64 MiB     | 256 MiB
+    Settings of the profile can be overridden by inserting the following options.
+    Invalid values make KDbConnection::useDatabase() fail.
+    - sqliteJournalMode (QString): delete, truncate, persist, memory, wal or off;
+                                   ignored for read-only connections
+    - sqliteSynchronous (QString): off, normal, full or extra
+    - sqliteSecureDelete (bool)
+    - sqliteTempStore (QString): default, file or memory
+    - sqliteCacheSize (qint64): cache size in pages if positive, in KiB if negative
+    - sqliteMmapSize (qint64): maximum number of bytes used for memory-mapped I/O, 0 disables it
+    - sqlitePageSize (int): page size in bytes for new databases, power of two from 512 to 65536
+    Effective settings can be retrieved using PRAGMA statements.
+    Snapshots of KDbReaderPool are supported if SQLite is built with SQLITE_ENABLE_SNAPSHOT
+    and the database uses WAL journal mode, e.g. set by the fast-wal profile of the writer.
 */
 class SqliteConnection : public KDbConnection
 {
@@ -89,6 +110,26 @@ protected:
 
     bool drv_executeSql(const KDbEscapedString& sql) override;
 
+    //! Interrupts the current statement using sqlite3_interrupt()
+    bool drv_cancel() override;
+
+    //! Implemented using progress handler, see sqlite3_progress_handler()
+    bool drv_setStatementTimeout(int msecs) override;
+
+    /*! Begins a read transaction and gets its snapshot using sqlite3_snapshot_get().
+     Requires WAL journal mode and SQLite built with SQLITE_ENABLE_SNAPSHOT. */
+    KDbReadSnapshotData* drv_pinReadSnapshot() override;
+
+    //! Begins a read transaction on the snapshot using sqlite3_snapshot_open()
+    bool drv_beginReadSnapshot(KDbReadSnapshotData *snapshot) override;
+
+    bool drv_endReadSnapshot() override;
+
+    //! Executes ANALYZE for the table
+    bool drv_updateTableStatistics(const QString &tableName) override;
+    //! Reads number of records from the sqlite_stat1 table filled by ANALYZE
+    tristate drv_approximateRecordCount(const KDbTableSchema &tableSchema, int *count) override;
+
     //! Implemented for KDbResultable
     QString serverResultName() const override;
 
@@ -108,6 +149,10 @@ private:
     //! Closes database without altering stored result number and message
     void drv_closeDatabaseSilently();
 
+    /*! Applies performance profile and overrides from options() using PRAGMA statements.
+     Sets error and returns false if an override has invalid value or a statement fails. */
+    bool applyPerformanceSettings();
+
     //! Finds a native SQLite extension @a name in the search path and loads it.
     //! Path and filename extension should not be provided.
     //! @return true on success
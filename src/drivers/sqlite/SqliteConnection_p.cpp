@@ -84,6 +84,28 @@ void SqliteConnectionInternal::storeResult(KDbResult *result)
                                     : QString());
 }
 
+void SqliteConnectionInternal::setStatementTimeout(int msecs)
+{
+    m_statementTimeout = msecs;
+    // Check elapsed time every 1000 virtual machine instructions, this is cheap enough
+    // not to slow down execution noticeably.
+    sqlite3_progress_handler(data, msecs > 0 ? 1000 : 0,
+                             msecs > 0 ? &SqliteConnectionInternal::statementProgressHandler : nullptr,
+                             this);
+}
+
+//static
+int SqliteConnectionInternal::statementProgressHandler(void *arg)
+{
+    SqliteConnectionInternal *d = static_cast<SqliteConnectionInternal*>(arg);
+    if (d->m_statementTimer && d->m_statementTimer->hasExpired(d->m_statementTimeout)) {
+        d->m_statementTimer = nullptr;
+        d->statementTimedOut();
+        return 1; // the statement fails with SQLITE_INTERRUPT
+    }
+    return 0;
+}
+
 bool SqliteConnectionInternal::extensionsLoadingEnabled() const
 {
     return m_extensionsLoadingEnabled;
@@ -97,6 +119,58 @@ void SqliteConnectionInternal::setExtensionsLoadingEnabled(bool set)
     m_extensionsLoadingEnabled = set;
 }
 
+SqlitePerformanceSettings::SqlitePerformanceSettings(KDbConnectionOptions::PerformanceProfile profile)
+{
+    switch (profile) {
+    case KDbConnectionOptions::PerformanceProfile::Default:
+        break;
+    case KDbConnectionOptions::PerformanceProfile::Durable:
+        journalMode = "delete";
+        synchronous = "full";
+        break;
+    case KDbConnectionOptions::PerformanceProfile::FastWal:
+        journalMode = "wal";
+        synchronous = "normal";
+        secureDelete = false;
+        tempStore = "memory";
+        cacheSize = qint64(-16 * 1024); // KiB
+        break;
+    case KDbConnectionOptions::PerformanceProfile::ReadMostlyMmap:
+        journalMode = "wal";
+        synchronous = "normal";
+        secureDelete = false;
+        tempStore = "memory";
+        cacheSize = qint64(-64 * 1024); // KiB
+        mmapSize = qint64(256) * 1024 * 1024;
+        break;
+    }
+}
+
+QString SqlitePerformanceSettings::toString() const
+{
+    QStringList result;
+    if (!pageSize.isNull()) {
+        result.append(QLatin1String("page_size=") + pageSize.toString());
+    }
+    result.append(QLatin1String("secure_delete=") + QLatin1String(secureDelete ? "on" : "off"));
+    if (!journalMode.isEmpty()) {
+        result.append(QLatin1String("journal_mode=") + QLatin1String(journalMode));
+    }
+    if (!synchronous.isEmpty()) {
+        result.append(QLatin1String("synchronous=") + QLatin1String(synchronous));
+    }
+    if (!tempStore.isEmpty()) {
+        result.append(QLatin1String("temp_store=") + QLatin1String(tempStore));
+    }
+    if (!cacheSize.isNull()) {
+        result.append(QLatin1String("cache_size=") + cacheSize.toString());
+    }
+    if (!mmapSize.isNull()) {
+        result.append(QLatin1String("mmap_size=") + mmapSize.toString());
+    }
+    return result.join(QLatin1Char(' '));
+}
+
 //static
 KDbField::Type SqliteSqlResult::type(int sqliteType)
 {
@@ -21,12 +21,18 @@
 #define KDB_SQLITECONN_P_H
 
 #include "KDbConnection_p.h"
+#include "KDbConnectionOptions.h"
+#include "KDbReaderPool.h"
 #include "SqliteConnection.h"
+#include "SqliteGlobal.h"
 #include "KDbSqlField.h"
 #include "KDbSqlRecord.h"
 #include "KDbSqlResult.h"
 #include "KDbSqlString.h"
 
+#include <QElapsedTimer>
+#include <QMutex>
+
 #include <sqlite3.h>
 
 /*! Internal SQLite connection data. Also used by SqliteCursor. */
@@ -46,14 +52,79 @@ public:
 
     void storeResult(KDbResult *result);
 
+    /*! Installs progress handler that interrupts statements taking longer than @a msecs
+     milliseconds, or removes the handler if @a msecs is 0. */
+    void setStatementTimeout(int msecs);
+
+    /*! Marks beginning of a step of statement whose execution time is measured by @a timer.
+     The timer is started on the first step of the statement, i.e. if it is not valid yet, and
+     should be invalidated when the statement is reset or finalized. This way the statement
+     timeout limits execution of the whole statement, not of its individual steps. */
+    inline void beginStatementStep(QElapsedTimer *timer) {
+        if (m_statementTimeout > 0) {
+            if (!timer->isValid()) {
+                timer->start();
+            }
+            m_statementTimer = timer;
+        }
+    }
+
+    //! Marks end of a step started by beginStatementStep()
+    inline void endStatementStep() {
+        m_statementTimer = nullptr;
+    }
+
     sqlite3 *data;
     bool data_owned; //!< true if data pointer should be freed on destruction
 
+    //! Guards setting and closing of the data handle against interrupting it from other
+    //! threads by SqliteConnection::drv_cancel()
+    QMutex dataMutex;
+
 private:
+    //! Progress handler for sqlite3_progress_handler(), @a arg is SqliteConnectionInternal.
+    //! @return nonzero if the statement should be interrupted.
+    static int statementProgressHandler(void *arg);
+
     bool m_extensionsLoadingEnabled;
+    int m_statementTimeout = 0;
+    QElapsedTimer *m_statementTimer = nullptr; //!< timer of the statement being stepped
     Q_DISABLE_COPY(SqliteConnectionInternal)
 };
 
+//! SQLite settings of a performance profile, empty or null values mean SQLite's defaults
+//! @see KDbConnectionOptions::PerformanceProfile
+class SqlitePerformanceSettings
+{
+public:
+    explicit SqlitePerformanceSettings(KDbConnectionOptions::PerformanceProfile profile);
+
+    //! @return PRAGMA assignments for the settings, e.g. "secure_delete=on journal_mode=wal"
+    QString toString() const;
+
+    QByteArray journalMode;
+    QByteArray synchronous;
+    QByteArray tempStore;
+    QVariant cacheSize;
+    QVariant mmapSize;
+    QVariant pageSize;
+    //! Set by default so SQLite overwrites deleted content with zeros. Works with 3.6.23,
+    //! earlier versions ignore this pragma. See https://www.sqlite.org/pragma.html#pragma_secure_delete
+    bool secureDelete = true;
+};
+
+#ifdef KDB_SQLITE_SNAPSHOT
+//! SQLite snapshot returned by SqliteConnection::drv_pinReadSnapshot()
+class SqliteReadSnapshotData : public KDbReadSnapshotData
+{
+public:
+    explicit SqliteReadSnapshotData(sqlite3_snapshot *nativeSnapshot) : snapshot(nativeSnapshot) {}
+    ~SqliteReadSnapshotData() override { sqlite3_snapshot_free(snapshot); }
+
+    sqlite3_snapshot * const snapshot;
+};
+#endif
+
 class SqliteSqlField : public KDbSqlField
 {
 public:
@@ -150,7 +221,7 @@ public:
     Q_REQUIRED_RESULT inline QSharedPointer<KDbSqlRecord> fetchRecord() override
     {
         SqliteSqlRecord *record;
-        const int res = sqlite3_step(prepared_st);
+        const int res = step();
         if (res == SQLITE_ROW) {
             record = new SqliteSqlRecord(prepared_st);
         } else {
@@ -195,9 +266,32 @@ protected:
     //! @todo Default values are only encoded as string
     bool cacheFieldInfo(const QString &tableName);
 
+    /*! Performs sqlite3_step() for the statement, limited by the statement timeout.
+     SQLite executes statements on their first step, so the connection is informed about
+     the executed statement after the first successful step. */
+    inline int step() {
+        conn->d->beginStatementStep(&statementTimer);
+        const int res = sqlite3_step(prepared_st);
+        conn->d->endStatementStep();
+        if (!executed && (res == SQLITE_ROW || res == SQLITE_DONE)) {
+            executed = true;
+            conn->d->statementExecuted(KDbEscapedString(sqlite3_sql(prepared_st)));
+        }
+        return res;
+    }
+
+    //! Performs sqlite3_reset() for the statement, next step() starts the statement timeout again
+    inline int reset() {
+        statementTimer.invalidate();
+        executed = false;
+        return sqlite3_reset(prepared_st);
+    }
+
 private:
     SqliteConnection * const conn;
     sqlite3_stmt * const prepared_st;
+    QElapsedTimer statementTimer; //!< measures time since the first step for the statement timeout
+    bool executed = false; //!< true after the first successful step()
     KDbUtils::AutodeletedHash<QString, SqliteSqlFieldInfo*> cachedFieldInfos;
     friend class SqlitePreparedStatement;
     Q_DISABLE_COPY(SqliteSqlResult)
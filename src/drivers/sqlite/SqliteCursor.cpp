@@ -23,6 +23,7 @@
 #include "SqliteConnection_p.h"
 #include "sqlite_debug.h"
 
+#include "KDbColumnBatch.h"
 #include "KDbDriver.h"
 #include "KDbError.h"
 #include "KDbRecordData.h"
@@ -75,6 +76,7 @@ public:
     const char **curr_colname;
     int cols_pointers_mem_size; //!< size of record's array of pointers to values
     QVector<const char**> records; //!< buffer data
+    QElapsedTimer statementTimer; //!< measures time since the first step for the statement timeout
 
     inline QVariant getValue(KDbField *f, int i) {
         int type = sqlite3_column_type(prepared_st_handle, i);
@@ -142,6 +144,51 @@ public:
         }
         return QVariant();
     }
+
+    /*! Appends value of column @a i of the current record to column @a i of @a batch.
+     Values matching storage of the column are appended directly, other values are
+     converted by getValue() using fields @a fields. */
+    inline void appendToBatch(KDbColumnBatch *batch, int i,
+                              const KDbQueryColumnInfo::Vector *fields)
+    {
+        const int type = sqlite3_column_type(prepared_st_handle, i);
+        if (type == SQLITE_NULL) {
+            batch->appendNull(i);
+            return;
+        }
+        switch (batch->storage(i)) {
+        case KDbColumnBatch::Storage::Integer:
+            if (type == SQLITE_INTEGER) {
+                batch->appendInteger(i, sqlite3_column_int64(prepared_st_handle, i));
+                return;
+            }
+            break;
+        case KDbColumnBatch::Storage::Real:
+            if (type == SQLITE_FLOAT || type == SQLITE_INTEGER) {
+                batch->appendReal(i, sqlite3_column_double(prepared_st_handle, i));
+                return;
+            }
+            break;
+        case KDbColumnBatch::Storage::Text:
+            if (type == SQLITE_TEXT) {
+                batch->appendText(i, QString::fromUtf8(
+                    (const char*)sqlite3_column_text(prepared_st_handle, i),
+                    sqlite3_column_bytes(prepared_st_handle, i)));
+                return;
+            }
+            break;
+        case KDbColumnBatch::Storage::Blob:
+            if (type == SQLITE_BLOB) {
+                batch->appendBlob(i, QByteArray((const char*)sqlite3_column_blob(prepared_st_handle, i),
+                                                sqlite3_column_bytes(prepared_st_handle, i)));
+                return;
+            }
+            break;
+        default:;
+        }
+        batch->appendValue(i, getValue((fields && i < fields->count()) ? fields->at(i)->field()
+                                                                       : nullptr, i));
+    }
     Q_DISABLE_COPY(SqliteCursorData)
 };
 
@@ -189,6 +236,7 @@ bool SqliteCursor::drv_open(const KDbEscapedString& sql)
         storeResult();
         return false;
     }
+    d->statementTimer.invalidate();
     if (isBuffered()) {
 //! @todo manage size dynamically
         d->records.resize(128);
@@ -199,6 +247,7 @@ bool SqliteCursor::drv_open(const KDbEscapedString& sql)
 
 bool SqliteCursor::drv_close()
 {
+    d->statementTimer.invalidate();
     int res = sqlite3_finalize(d->prepared_st_handle);
     if (res != SQLITE_OK) {
         m_result.setServerErrorCode(res);
@@ -210,7 +259,10 @@ bool SqliteCursor::drv_close()
 
 void SqliteCursor::drv_getNextRecord()
 {
+    SqliteConnectionInternal *connd = static_cast<SqliteConnection*>(connection())->d;
+    connd->beginStatementStep(&d->statementTimer);
     int res = sqlite3_step(d->prepared_st_handle);
+    connd->endStatementStep();
     if (res == SQLITE_ROW) {
         m_fetchResult = FetchResult::Ok;
         m_fieldCount = sqlite3_data_count(d->prepared_st_handle);
@@ -223,6 +275,7 @@ void SqliteCursor::drv_getNextRecord()
             m_fetchResult = FetchResult::End;
         } else {
             m_result.setServerErrorCode(res);
+            storeResult();
             m_fetchResult = FetchResult::Error;
         }
     }
@@ -238,6 +291,41 @@ void SqliteCursor::drv_getNextRecord()
       }*/
 }
 
+int SqliteCursor::drv_fetchBatch(KDbColumnBatch *batch, int maxRecords)
+{
+    if (isBuffered()) {
+        return -1; // records have to be stored in the buffer
+    }
+    SqliteConnectionInternal *connd = static_cast<SqliteConnection*>(connection())->d;
+    const int columnCount = batch->columnCount();
+    int count = 0;
+    m_fetchResult = FetchResult::Ok;
+    while (count < maxRecords) {
+        connd->beginStatementStep(&d->statementTimer);
+        const int res = sqlite3_step(d->prepared_st_handle);
+        connd->endStatementStep();
+        if (res != SQLITE_ROW) {
+            if (res == SQLITE_DONE) {
+                m_fetchResult = FetchResult::End;
+            } else {
+                m_result.setServerErrorCode(res);
+                storeResult();
+                m_fetchResult = FetchResult::Error;
+            }
+            break;
+        }
+        if (count == 0) {
+            m_fieldCount = sqlite3_data_count(d->prepared_st_handle);
+            m_fieldsToStoreInRecord = m_fieldCount;
+        }
+        for (int i = 0; i < columnCount; ++i) {
+            d->appendToBatch(batch, i, m_visibleFieldsExpanded);
+        }
+        ++count;
+    }
+    return count;
+}
+
 void SqliteCursor::drv_appendCurrentRecordToBuffer()
 {
 // sqliteDebug();
@@ -60,6 +60,9 @@ protected:
     bool drv_close() override;
     void drv_getNextRecord() override;
 
+    //! Fetches records in a sqlite3_step() loop
+    int drv_fetchBatch(KDbColumnBatch *batch, int maxRecords) override;
+
     void drv_appendCurrentRecordToBuffer() override;
     void drv_bufferMovePointerNext() override;
     void drv_bufferMovePointerPrev() override;
@@ -27,6 +27,7 @@
 #include "KDbDriverBehavior.h"
 #include "KDbExpression.h"
 #include "KDb.h"
+#include "KDbEscaping_p.h"
 
 #include <KPluginFactory>
 
@@ -72,11 +73,22 @@ SqliteDriver::SqliteDriver(QObject *parent, const QVariantList &args)
     beh->GET_TABLE_NAMES_SQL
         = KDbEscapedString("SELECT name FROM sqlite_master WHERE type='table'");
 
-    initDriverSpecificKeywords(keywords);
+    initDriverSpecificKeywords(&keywords);
 
     // internal properties
     beh->properties.insert("client_library_version", QLatin1String(sqlite3_libversion()));
     beh->properties.insert("default_server_encoding", QLatin1String("UTF8")); //OK?
+    // performance profiles, see KDbConnectionOptions::PerformanceProfile and SqliteConnection
+    QStringList profileNames;
+    for (int i = 0; i <= static_cast<int>(KDbConnectionOptions::PerformanceProfile::ReadMostlyMmap); ++i) {
+        const auto profile = static_cast<KDbConnectionOptions::PerformanceProfile>(i);
+        const QString name = KDbConnectionOptions::performanceProfileName(profile);
+        profileNames.append(name);
+        // e.g. "performance_profile_fast_wal"
+        beh->properties.insert("performance_profile_" + name.toLatin1().replace('-', '_'),
+                               SqlitePerformanceSettings(profile).toString());
+    }
+    beh->properties.insert("performance_profiles", profileNames);
 
     beh->typeNames[KDbField::Byte] = QLatin1String("Byte");
     beh->typeNames[KDbField::ShortInteger] = QLatin1String("ShortInteger");
@@ -124,19 +136,26 @@ bool SqliteDriver::drv_isSystemFieldName(const QString& name) const
            || 0 == name.compare(QLatin1String("oid"), Qt::CaseInsensitive);
 }
 
+//! Rules of escaping string literals for SQLite
+static const KDbStringEscapingRules& sqliteEscapingRules()
+{
+    static const KDbStringEscapingRules rules{{'\'', "''"}};
+    return rules;
+}
+
 KDbEscapedString SqliteDriver::escapeString(const QString& str) const
 {
-    return KDbEscapedString("'") + KDbEscapedString(str).replace('\'', "''") + '\'';
+    return kdbEscapeString(str, sqliteEscapingRules());
 }
 
 KDbEscapedString SqliteDriver::escapeString(const QByteArray& str) const
 {
-    return KDbEscapedString("'") + KDbEscapedString(str).replace('\'', "''") + '\'';
+    return kdbEscapeString(str, sqliteEscapingRules());
 }
 
 KDbEscapedString SqliteDriver::escapeBLOB(const QByteArray& array) const
 {
-    return KDbEscapedString(KDb::escapeBLOB(array, KDb::BLOBEscapingType::XHex));
+    return kdbEscapeBLOB(array, KDb::BLOBEscapingType::XHex);
 }
 
 QString SqliteDriver::drv_escapeIdentifier(const QString& str) const
@@ -107,7 +107,7 @@ protected:
     SqliteDriverPrivate * const dp;
 
 private:
-    static const char * const keywords[];
+    static const KDbKeywordTable keywords;
     Q_DISABLE_COPY(SqliteDriver)
 };
 
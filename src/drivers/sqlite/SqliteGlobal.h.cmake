@@ -25,4 +25,7 @@
 //! Support for SQLite vacuum (compacting) feature
 #cmakedefine KDB_SQLITE_VACUUM
 
+//! Support for SQLite snapshots (sqlite3_snapshot_open() and related functions)
+#cmakedefine KDB_SQLITE_SNAPSHOT
+
 #endif
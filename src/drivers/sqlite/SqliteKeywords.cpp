@@ -1,6 +1,11 @@
 /* This file is part of the KDE project
    Copyright (C) 2004 Martin Ellis <martin.ellis@kdemail.net>
-   Copyright (C) 2004-2016 Jarosław Staniek <staniek@kde.org>
+   Copyright (C) 2004-2018 Jarosław Staniek <staniek@kde.org>
+
+   This file has been automatically generated from
+   tools/sql_keywords.sh and the list created by hand based on parse.c from SQLite 3.13.0.
+
+   Please edit the sql_keywords.sh, not this file!
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU Library General Public
@@ -19,141 +24,160 @@
 */
 
 #include "SqliteDriver.h"
+#include "KDbKeywordTable_p.h"
+
+//! 130 keywords in 512 slots
+static constexpr const char* sqliteKeywordSlots[] = {
+    "VARIABLE", "EXCEPT", "INSERT", "PLAN",
+    "WITH", "ASC", "ALTER", "COMMIT",
+    "BEFORE", "NO", "INTEGER", "ADD",
+    "USING", "RECURSIVE", "COLLATE", "OF",
+    "ISNULL", "DEFERRED", "CAST", "OUTER",
+    "REPLACE", "DETACH", "COLUMN", "IMMEDIATE",
+    "CONFLICT", "LIMIT", "DEFAULT", "CURRENT_DATE",
+    "CURRENT_TIMESTAMP", "CURRENT_TIME", "UPDATE", "DATABASE",
+    "VACUUM", "TEMPORARY", "DISTINCT", "SAVEPOINT",
+    "FOR", "REINDEX", "INNER", "JOIN",
+    "GROUP", "TO", "BEGIN", "CHECK",
+    "STRING", "CREATE", "AND", "INDEXED",
+    "IF", "NULL", "AUTOINCR", "WHEN",
+    "TEMP", "ACTION", "VIEW", "DEFERRABLE",
+    "OR", "RESTRICT", "LIKE", "BETWEEN",
+    "WITHOUT", "INTERSECT", "ID", "INDEX",
+    "RELEASE", "MATCH", "OFFSET", "THEN",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "ON", nullptr, nullptr, "KEY",
+    "WHERE", nullptr, nullptr, "GLOB",
+    nullptr, nullptr, nullptr, nullptr,
+    "ALL", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "ATTACH", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "HAVING", nullptr, nullptr,
+    nullptr, "BY", "PRIMARY", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "NOT",
+    nullptr, "INTO", nullptr, "DESC",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "ANALYZE", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "RIGHT", nullptr, nullptr, nullptr,
+    nullptr, "PRAGMA", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "EACH", nullptr, nullptr,
+    nullptr, "SELECT", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "REGEXP", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "ROW", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "ELSE", nullptr,
+    nullptr, "DELETE", "BLOB", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "FULL", "AS", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "UNION",
+    nullptr, "SET", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "CONSTRAINT",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "FAIL", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "EXCLUSIVE",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "DROP", "RAISE", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "TRANSACTION", nullptr, nullptr, nullptr,
+    nullptr, "QUERY", nullptr, nullptr,
+    nullptr, "IN", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "TRIGGER", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "FROM",
+    nullptr, nullptr, "LEFT", nullptr,
+    nullptr, "IS", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "NATURAL", nullptr, nullptr, nullptr,
+    nullptr, "END", nullptr, nullptr,
+    nullptr, nullptr, "VIRTUAL", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "REFERENCES", nullptr, nullptr, nullptr,
+    nullptr, nullptr, "NOTNULL", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "FLOAT", nullptr,
+    "INSTEAD", "ROLLBACK", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "AFTER", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "UNIQUE", "EXPLAIN", nullptr,
+    nullptr, nullptr, "CASCADE", nullptr,
+    nullptr, nullptr, "RENAME", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "EXISTS", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "IGNORE", nullptr,
+    nullptr, nullptr, nullptr, "ORDER",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "ABORT", "TABLE", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "ANY", nullptr, "ESCAPE",
+    nullptr, nullptr, nullptr, nullptr,
+    "INITIALLY", "FOREIGN", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, "VALUES", "CASE", nullptr,
+};
 
-//! The list is created by hand based on parse.c from SQLite 3.13.0.
-//! @todo Proces patterns like this from https://www.sqlite.org/draft/tokenreq.html
-//! to extract tokens automatically:
-//! "SQLite shall recognize the *-character sequenence "*" in any combination of upper and lower case letters as the keyword token *."
-const char* const SqliteDriver::keywords[] = {
-    "ABORT",
-    "ACTION",
-    "ADD",
-    "AFTER",
-    "ALL",
-    "ALTER",
-    "ANALYZE",
-    "AND",
-    "ANY",
-    "AS",
-    "ASC",
-    "ATTACH",
-    "AUTOINCR",
-    "BEFORE",
-    "BEGIN",
-    "BETWEEN",
-    "BLOB",
-    "BY",
-    "CASCADE",
-    "CASE",
-    "CAST",
-    "CHECK",
-    "COLLATE",
-    "COLUMN",
-    "COMMIT",
-    "CONFLICT",
-    "CONSTRAINT",
-    "CREATE",
-    "CURRENT_DATE",
-    "CURRENT_TIME",
-    "CURRENT_TIMESTAMP",
-    "DATABASE",
-    "DEFAULT",
-    "DEFERRABLE",
-    "DEFERRED",
-    "DELETE",
-    "DESC",
-    "DETACH",
-    "DISTINCT",
-    "DROP",
-    "EACH",
-    "ELSE",
-    "END",
-    "ESCAPE",
-    "EXCEPT",
-    "EXCLUSIVE",
-    "EXISTS",
-    "EXPLAIN",
-    "FAIL",
-    "FLOAT",
-    "FOR",
-    "FOREIGN",
-    "FROM",
-    "FULL",
-    "GLOB",
-    "GROUP",
-    "HAVING",
-    "ID",
-    "IF",
-    "IGNORE",
-    "IMMEDIATE",
-    "IN",
-    "INDEX",
-    "INDEXED",
-    "INITIALLY",
-    "INNER",
-    "INSERT",
-    "INSTEAD",
-    "INTEGER",
-    "INTERSECT",
-    "INTO",
-    "IS",
-    "ISNULL",
-    "JOIN",
-    "KEY",
-    "LEFT",
-    "LIKE",
-    "LIMIT",
-    "MATCH",
-    "NATURAL",
-    "NO",
-    "NOT",
-    "NOTNULL",
-    "NULL",
-    "OF",
-    "OFFSET",
-    "ON",
-    "OR",
-    "ORDER",
-    "OUTER",
-    "PLAN",
-    "PRAGMA",
-    "PRIMARY",
-    "QUERY",
-    "RAISE",
-    "RECURSIVE",
-    "REFERENCES",
-    "REGEXP",
-    "REINDEX",
-    "RELEASE",
-    "RENAME",
-    "REPLACE",
-    "RESTRICT",
-    "RIGHT",
-    "ROLLBACK",
-    "ROW",
-    "SAVEPOINT",
-    "SELECT",
-    "SET",
-    "STRING",
-    "TABLE",
-    "TEMP",
-    "TEMPORARY",
-    "THEN",
-    "TO",
-    "TRANSACTION",
-    "TRIGGER",
-    "UNION",
-    "UNIQUE",
-    "UPDATE",
-    "USING",
-    "VACUUM",
-    "VALUES",
-    "VARIABLE",
-    "VIEW",
-    "VIRTUAL",
-    "WHEN",
-    "WHERE",
-    "WITH",
-    "WITHOUT",
-    nullptr
+static constexpr int sqliteKeywordDisplacements[] = {
+    -1, -1, -1, -1, -2, -4, -5, -6, -7, -8,
+    -9, -1, -10, -11, -1, -12, -13, -1, -1, -1,
+    1, -1, -14, -1, -15, 1, -16, 1, -1, -1,
+    -17, 1, -1, -1, -1, -19, -20, -1, -21, 1,
+    -22, 1, -23, -1, -24, -25, -1, -26, -27, -28,
+    -30, -31, 1, -32, 1, 1, -33, -34, -35, -1,
+    2, -1, -38, -39, -1, -1, -40, -41, 1, 2,
+    -1, 1, -42, -45, -46, 1, 1, -47, -48, -1,
+    1, -1, 1, 1, -49, -1, 1, -1, -50, -52,
+    -1, -53, -54, -1, 1, -1, -55, 1, -57, -1,
+    1, -1, -1, -58, -1, 1, 1, 1, -1, -59,
+    -1, -60, -1, 2, -61, -62, -63, 1, 1, -64,
+    -1, -65, -1, 1, 1, -66, 1, -67,
 };
+
+static constexpr KDbKeywordTable sqliteKeywordTable = {
+    sqliteKeywordSlots, 512, sqliteKeywordDisplacements, 128
+};
+
+static_assert(sqliteKeywordTable.isValid(), "Invalid keyword table");
+
+const KDbKeywordTable SqliteDriver::keywords = sqliteKeywordTable;
@@ -210,7 +210,7 @@ QSharedPointer<KDbSqlResult> SqlitePreparedStatement::execute(
     }
 
     //real execution
-    const int res = sqlite3_step(sqlResult()->prepared_st);
+    const int res = sqlResult()->step();
     if (type == KDbPreparedStatement::InsertStatement) {
         const bool ok = res == SQLITE_DONE;
         if (ok) {
@@ -220,7 +220,7 @@ QSharedPointer<KDbSqlResult> SqlitePreparedStatement::execute(
             storeResult(&m_result);
             sqliteWarning() << m_result << QString::fromLatin1(sqlite3_sql(sqlResult()->prepared_st));
         }
-        (void)sqlite3_reset(sqlResult()->prepared_st);
+        (void)sqlResult()->reset();
         return m_sqlResult;
     }
     else if (type == KDbPreparedStatement::SelectStatement) {
@@ -234,7 +234,7 @@ QSharedPointer<KDbSqlResult> SqlitePreparedStatement::execute(
             storeResult(&m_result);
             sqliteWarning() << m_result << QString::fromLatin1(sqlite3_sql(sqlResult()->prepared_st));
         }
-        (void)sqlite3_reset(sqlResult()->prepared_st);
+        (void)sqlResult()->reset();
         return m_sqlResult;
     }
     return QSharedPointer<KDbSqlResult>();
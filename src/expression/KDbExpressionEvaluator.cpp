@@ -0,0 +1,1817 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "KDbExpressionEvaluator.h"
+#include "KDbDateTime.h"
+#include "KDbFieldList.h"
+#include "KDbRecordData.h"
+#include "KDbTableSchema.h"
+#include "kdb_debug.h"
+
+#include <QHash>
+#include <QVarLengthArray>
+
+#include <cmath>
+#include <limits>
+
+namespace {
+
+//! Typed register holding a single value computed by a compiled node
+struct Value
+{
+    enum Type : quint8 {
+        Null,
+        Bool,
+        Integer,
+        Double,
+        Text,
+        Other //!< dates, times, byte arrays, etc. stored as QVariant
+    };
+
+    inline Value() : intValue(0) {}
+
+    inline bool isNull() const { return type == Null; }
+    inline bool isNumeric() const { return type == Bool || type == Integer || type == Double; }
+
+    inline void setNull() { type = Null; }
+    inline void setBool(bool value) { type = Bool; boolValue = value; }
+    inline void setInteger(qint64 value) { type = Integer; intValue = value; }
+    inline void setDouble(double value) { type = Double; doubleValue = value; }
+    inline void setText(const QString &value) { type = Text; text = value; }
+
+    void setVariant(const QVariant &value)
+    {
+        if (value.isNull()) {
+            setNull();
+            return;
+        }
+        switch (value.userType()) {
+        case QMetaType::Bool:
+            setBool(value.toBool());
+            break;
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::Short:
+        case QMetaType::UShort:
+        case QMetaType::Long:
+        case QMetaType::Char:
+        case QMetaType::SChar:
+        case QMetaType::UChar:
+            setInteger(value.toLongLong());
+            break;
+        case QMetaType::ULongLong:
+        case QMetaType::ULong:
+            setInteger(qint64(value.toULongLong()));
+            break;
+        case QMetaType::Double:
+        case QMetaType::Float:
+            setDouble(value.toDouble());
+            break;
+        case QMetaType::QString:
+        case QMetaType::QChar:
+            setText(value.toString());
+            break;
+        default:
+            type = Other;
+            other = value;
+        }
+    }
+
+    QVariant toVariant() const
+    {
+        switch (type) {
+        case Null: return QVariant();
+        case Bool: return boolValue;
+        case Integer: return qlonglong(intValue);
+        case Double: return doubleValue;
+        case Text: return text;
+        case Other: return other;
+        }
+        return QVariant();
+    }
+
+    QString toText() const
+    {
+        switch (type) {
+        case Null: return QString();
+        case Bool: return boolValue ? QStringLiteral("1") : QStringLiteral("0");
+        case Integer: return QString::number(intValue);
+        case Double: return QString::number(doubleValue, 'g', 15);
+        case Text: return text;
+        case Other: return other.toString();
+        }
+        return QString();
+    }
+
+    Type type = Null;
+    union {
+        bool boolValue;
+        qint64 intValue;
+        double doubleValue;
+    };
+    QString text;
+    QVariant other;
+};
+
+//! Numeric value of a Value, integer or floating-point
+struct Number
+{
+    explicit Number(const Value &value)
+    {
+        switch (value.type) {
+        case Value::Bool:
+            i = value.boolValue ? 1 : 0;
+            break;
+        case Value::Integer:
+            i = value.intValue;
+            break;
+        case Value::Double:
+            isDouble = true;
+            d = value.doubleValue;
+            break;
+        case Value::Text: {
+            // Like in SQLite, text that does not look like a number is 0
+            bool ok;
+            i = value.text.trimmed().toLongLong(&ok);
+            if (!ok) {
+                d = value.text.trimmed().toDouble(&ok);
+                isDouble = ok;
+                i = 0;
+            }
+            break;
+        }
+        case Value::Other: {
+            bool ok;
+            d = value.other.toDouble(&ok);
+            isDouble = ok;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    inline double toDouble() const { return isDouble ? d : double(i); }
+    inline qint64 toInteger() const { return isDouble ? qint64(d) : i; }
+
+    bool isDouble = false;
+    qint64 i = 0;
+    double d = 0.0;
+};
+
+template <typename T>
+static inline int compareScalars(T a, T b)
+{
+    return a < b ? -1 : (b < a ? 1 : 0);
+}
+
+//! Compares non-null variants of non-scalar types
+static int compareVariants(const QVariant &a, const QVariant &b)
+{
+    if (a.userType() == b.userType()) {
+        switch (a.userType()) {
+        case QMetaType::QDate:
+            return compareScalars(a.toDate(), b.toDate());
+        case QMetaType::QTime:
+            return compareScalars(a.toTime(), b.toTime());
+        case QMetaType::QDateTime:
+            return compareScalars(a.toDateTime(), b.toDateTime());
+        case QMetaType::QByteArray: {
+            const QByteArray ba(a.toByteArray());
+            const QByteArray bb(b.toByteArray());
+            return compareScalars(ba, bb);
+        }
+        default:
+            break;
+        }
+    }
+    return a.toString().compare(b.toString());
+}
+
+/*! Compares non-null values @a a and @a b.
+ Numbers are compared numerically, numbers are lower than text that does not look
+ like a number (as in SQLite), text is compared case-sensitively. */
+static int compareValues(const Value &a, const Value &b)
+{
+    if (a.type == Value::Integer && b.type == Value::Integer) {
+        return compareScalars(a.intValue, b.intValue);
+    }
+    if (a.type == Value::Text && b.type == Value::Text) {
+        return a.text.compare(b.text);
+    }
+    if (a.isNumeric() && b.isNumeric()) {
+        const Number na(a);
+        const Number nb(b);
+        if (na.isDouble || nb.isDouble) {
+            return compareScalars(na.toDouble(), nb.toDouble());
+        }
+        return compareScalars(na.i, nb.i);
+    }
+    if (a.isNumeric() && b.type == Value::Text) {
+        bool ok;
+        const double d = b.text.trimmed().toDouble(&ok);
+        return ok ? compareScalars(Number(a).toDouble(), d) : -1;
+    }
+    if (a.type == Value::Text && b.isNumeric()) {
+        return -compareValues(b, a);
+    }
+    if (a.type == Value::Other && b.type == Value::Other) {
+        return compareVariants(a.other, b.other);
+    }
+    return a.toText().compare(b.toText());
+}
+
+//! Truth value of SQL's three-valued logic
+enum class Truth : qint8 {
+    False,
+    True,
+    Unknown
+};
+
+static Truth truth(const Value &value)
+{
+    switch (value.type) {
+    case Value::Null: return Truth::Unknown;
+    case Value::Bool: return value.boolValue ? Truth::True : Truth::False;
+    case Value::Integer: return value.intValue != 0 ? Truth::True : Truth::False;
+    case Value::Double: return value.doubleValue != 0.0 ? Truth::True : Truth::False;
+    case Value::Text: return Number(value).toDouble() != 0.0 ? Truth::True : Truth::False;
+    case Value::Other: return value.other.toBool() ? Truth::True : Truth::False;
+    }
+    return Truth::Unknown;
+}
+
+static inline void setTruth(Truth t, Value *result)
+{
+    if (t == Truth::Unknown) {
+        result->setNull();
+    } else {
+        result->setBool(t == Truth::True);
+    }
+}
+
+static inline Truth notTruth(Truth t)
+{
+    return t == Truth::Unknown ? t : (t == Truth::True ? Truth::False : Truth::True);
+}
+
+static inline Truth andTruth(Truth a, Truth b)
+{
+    if (a == Truth::False || b == Truth::False) {
+        return Truth::False;
+    }
+    return (a == Truth::Unknown || b == Truth::Unknown) ? Truth::Unknown : Truth::True;
+}
+
+static inline Truth orTruth(Truth a, Truth b)
+{
+    if (a == Truth::True || b == Truth::True) {
+        return Truth::True;
+    }
+    return (a == Truth::Unknown || b == Truth::Unknown) ? Truth::Unknown : Truth::False;
+}
+
+static inline Truth xorTruth(Truth a, Truth b)
+{
+    if (a == Truth::Unknown || b == Truth::Unknown) {
+        return Truth::Unknown;
+    }
+    return a != b ? Truth::True : Truth::False;
+}
+
+//! @return data of @a vector resized to at least @a count registers
+static inline Value* registers(QVector<Value> *vector, int count)
+{
+    if (vector->size() < count) {
+        vector->resize(count);
+    }
+    return vector->data();
+}
+
+//! Node of the compiled expression tree
+class Node
+{
+public:
+    virtual ~Node() {}
+
+    //! Computes value of the node for @a record
+    virtual void eval(const KDbRecordData &record, Value *result) const = 0;
+
+    /*! Computes values of the node for @a count records of @a records starting at @a from.
+     @a result must point to at least @a count registers.
+     The default implementation calls eval() for each record, nodes reimplement it to
+     process the batch column-wise. */
+    virtual void evalBatch(const QList<KDbRecordData*> &records, int from, int count,
+                           Value *result) const
+    {
+        for (int i = 0; i < count; ++i) {
+            eval(*records.at(from + i), result + i);
+        }
+    }
+
+    //! @return true if value of the node does not depend on records
+    virtual bool isConstant() const { return false; }
+};
+
+class ConstNode : public Node
+{
+public:
+    explicit ConstNode(const Value &value) : m_value(value) {}
+
+    void eval(const KDbRecordData &record, Value *result) const override
+    {
+        Q_UNUSED(record)
+        *result = m_value;
+    }
+
+    void evalBatch(const QList<KDbRecordData*> &records, int from, int count,
+                   Value *result) const override
+    {
+        Q_UNUSED(records)
+        Q_UNUSED(from)
+        for (int i = 0; i < count; ++i) {
+            result[i] = m_value;
+        }
+    }
+
+    bool isConstant() const override { return true; }
+
+private:
+    const Value m_value;
+};
+
+class ColumnNode : public Node
+{
+public:
+    explicit ColumnNode(int index) : m_index(index) {}
+
+    void eval(const KDbRecordData &record, Value *result) const override
+    {
+        if (m_index < record.size()) {
+            result->setVariant(record.at(m_index));
+        } else {
+            result->setNull();
+        }
+    }
+
+    void evalBatch(const QList<KDbRecordData*> &records, int from, int count,
+                   Value *result) const override
+    {
+        for (int i = 0; i < count; ++i) {
+            const KDbRecordData *record = records.at(from + i);
+            if (m_index < record->size()) {
+                result[i].setVariant(record->at(m_index));
+            } else {
+                result[i].setNull();
+            }
+        }
+    }
+
+private:
+    const int m_index;
+};
+
+//! Base class for nodes having child nodes evaluated into registers
+class NodeWithArgs : public Node
+{
+public:
+    explicit NodeWithArgs(const QVector<Node*> &args)
+        : m_args(args), m_registers(args.count())
+    {
+    }
+
+    ~NodeWithArgs() override
+    {
+        qDeleteAll(m_args);
+    }
+
+protected:
+    //! Evaluates argument @a i for a batch, @return its registers
+    const Value* evalArgBatch(int i, const QList<KDbRecordData*> &records, int from,
+                              int count) const
+    {
+        Value *result = registers(&m_registers[i], count);
+        m_args[i]->evalBatch(records, from, count, result);
+        return result;
+    }
+
+    const QVector<Node*> m_args;
+    mutable QVector<QVector<Value>> m_registers;
+};
+
+//! Applies operator Op to values of two arguments
+template <typename Op>
+class BinaryNode : public NodeWithArgs
+{
+public:
+    BinaryNode(Node *left, Node *right)
+        : NodeWithArgs(QVector<Node*>() << left << right)
+    {
+    }
+
+    void eval(const KDbRecordData &record, Value *result) const override
+    {
+        Value left;
+        Value right;
+        m_args[0]->eval(record, &left);
+        m_args[1]->eval(record, &right);
+        Op::apply(left, right, result);
+    }
+
+    void evalBatch(const QList<KDbRecordData*> &records, int from, int count,
+                   Value *result) const override
+    {
+        const Value *left = evalArgBatch(0, records, from, count);
+        const Value *right = evalArgBatch(1, records, from, count);
+        for (int i = 0; i < count; ++i) {
+            Op::apply(left[i], right[i], result + i);
+        }
+    }
+};
+
+//! Arithmetic operation; the integer path is tried first so batches of integers
+//! do not need any conversions
+template <typename Impl>
+struct Arithmetic
+{
+    static inline void apply(const Value &a, const Value &b, Value *result)
+    {
+        if (a.type == Value::Integer && b.type == Value::Integer) {
+            Impl::integers(a.intValue, b.intValue, result);
+            return;
+        }
+        if (a.isNull() || b.isNull()) {
+            result->setNull();
+            return;
+        }
+        const Number na(a);
+        const Number nb(b);
+        if (na.isDouble || nb.isDouble) {
+            Impl::doubles(na.toDouble(), nb.toDouble(), result);
+        } else {
+            Impl::integers(na.i, nb.i, result);
+        }
+    }
+};
+
+// Integer operations wrap around on overflow instead of being undefined
+struct AddImpl : public Arithmetic<AddImpl>
+{
+    static inline void integers(qint64 a, qint64 b, Value *r) { r->setInteger(qint64(quint64(a) + quint64(b))); }
+    static inline void doubles(double a, double b, Value *r) { r->setDouble(a + b); }
+};
+
+struct SubtractImpl : public Arithmetic<SubtractImpl>
+{
+    static inline void integers(qint64 a, qint64 b, Value *r) { r->setInteger(qint64(quint64(a) - quint64(b))); }
+    static inline void doubles(double a, double b, Value *r) { r->setDouble(a - b); }
+};
+
+struct MultiplyImpl : public Arithmetic<MultiplyImpl>
+{
+    static inline void integers(qint64 a, qint64 b, Value *r) { r->setInteger(qint64(quint64(a) * quint64(b))); }
+    static inline void doubles(double a, double b, Value *r) { r->setDouble(a * b); }
+};
+
+//! Division by zero gives NULL, as in SQLite
+struct DivideImpl : public Arithmetic<DivideImpl>
+{
+    static inline void integers(qint64 a, qint64 b, Value *r)
+    {
+        if (b == 0) {
+            r->setNull();
+        } else if (b == -1) {
+            r->setInteger(qint64(0 - quint64(a)));
+        } else {
+            r->setInteger(a / b);
+        }
+    }
+    static inline void doubles(double a, double b, Value *r)
+    {
+        if (b == 0.0) {
+            r->setNull();
+        } else {
+            r->setDouble(a / b);
+        }
+    }
+};
+
+//! Integer-only operations; floating-point arguments are truncated, as in SQLite
+template <typename Impl>
+struct IntegerArithmetic : public Arithmetic<Impl>
+{
+    static inline void doubles(double a, double b, Value *r) { Impl::integers(qint64(a), qint64(b), r); }
+};
+
+struct ModuloImpl : public IntegerArithmetic<ModuloImpl>
+{
+    static inline void integers(qint64 a, qint64 b, Value *r)
+    {
+        if (b == 0) {
+            r->setNull();
+        } else if (b == -1) {
+            r->setInteger(0);
+        } else {
+            r->setInteger(a % b);
+        }
+    }
+};
+
+struct BitwiseAndImpl : public IntegerArithmetic<BitwiseAndImpl>
+{
+    static inline void integers(qint64 a, qint64 b, Value *r) { r->setInteger(a & b); }
+};
+
+struct BitwiseOrImpl : public IntegerArithmetic<BitwiseOrImpl>
+{
+    static inline void integers(qint64 a, qint64 b, Value *r) { r->setInteger(a | b); }
+};
+
+//! Shifts by 64 bits or more give 0 (or -1 for right shift of negative numbers),
+//! negative shifts reverse direction, as in SQLite
+struct ShiftImpl
+{
+    static inline void shift(qint64 a, qint64 bits, Value *r)
+    {
+        if (bits >= 0) {
+            r->setInteger(bits >= 64 ? 0 : qint64(quint64(a) << bits));
+        } else {
+            r->setInteger(bits <= -64 ? (a < 0 ? -1 : 0) : (a >> -bits));
+        }
+    }
+};
+
+struct ShiftLeftImpl : public IntegerArithmetic<ShiftLeftImpl>
+{
+    static inline void integers(qint64 a, qint64 b, Value *r) { ShiftImpl::shift(a, b, r); }
+};
+
+struct ShiftRightImpl : public IntegerArithmetic<ShiftRightImpl>
+{
+    static inline void integers(qint64 a, qint64 b, Value *r)
+    {
+        ShiftImpl::shift(a, b == std::numeric_limits<qint64>::min() ? 64 : -b, r);
+    }
+};
+
+struct ConcatenationImpl
+{
+    static inline void apply(const Value &a, const Value &b, Value *result)
+    {
+        if (a.isNull() || b.isNull()) {
+            result->setNull();
+        } else {
+            result->setText(a.toText() + b.toText());
+        }
+    }
+};
+
+//! Comparison; integer and text paths are tried first
+template <typename Impl>
+struct Comparison
+{
+    static inline void apply(const Value &a, const Value &b, Value *result)
+    {
+        if (a.type == Value::Integer && b.type == Value::Integer) {
+            result->setBool(Impl::test(compareScalars(a.intValue, b.intValue)));
+        } else if (a.isNull() || b.isNull()) {
+            result->setNull();
+        } else {
+            result->setBool(Impl::test(compareValues(a, b)));
+        }
+    }
+};
+
+struct EqualImpl : public Comparison<EqualImpl>
+{
+    static inline bool test(int cmp) { return cmp == 0; }
+};
+
+struct NotEqualImpl : public Comparison<NotEqualImpl>
+{
+    static inline bool test(int cmp) { return cmp != 0; }
+};
+
+struct LessImpl : public Comparison<LessImpl>
+{
+    static inline bool test(int cmp) { return cmp < 0; }
+};
+
+struct LessOrEqualImpl : public Comparison<LessOrEqualImpl>
+{
+    static inline bool test(int cmp) { return cmp <= 0; }
+};
+
+struct GreaterImpl : public Comparison<GreaterImpl>
+{
+    static inline bool test(int cmp) { return cmp > 0; }
+};
+
+struct GreaterOrEqualImpl : public Comparison<GreaterOrEqualImpl>
+{
+    static inline bool test(int cmp) { return cmp >= 0; }
+};
+
+struct AndImpl
+{
+    static inline void apply(const Value &a, const Value &b, Value *result)
+    {
+        setTruth(andTruth(truth(a), truth(b)), result);
+    }
+};
+
+struct OrImpl
+{
+    static inline void apply(const Value &a, const Value &b, Value *result)
+    {
+        setTruth(orTruth(truth(a), truth(b)), result);
+    }
+};
+
+struct XorImpl
+{
+    static inline void apply(const Value &a, const Value &b, Value *result)
+    {
+        setTruth(xorTruth(truth(a), truth(b)), result);
+    }
+};
+
+//! AND and OR skip evaluation of the right argument when the left one decides the result.
+//! This is only done for single records, batches are evaluated for both arguments.
+template <typename Impl, bool shortCircuitValue>
+class LogicalNode : public BinaryNode<Impl>
+{
+public:
+    LogicalNode(Node *left, Node *right) : BinaryNode<Impl>(left, right) {}
+
+    void eval(const KDbRecordData &record, Value *result) const override
+    {
+        Value left;
+        this->m_args[0]->eval(record, &left);
+        const Truth leftTruth = truth(left);
+        if (leftTruth == (shortCircuitValue ? Truth::True : Truth::False)) {
+            result->setBool(shortCircuitValue);
+            return;
+        }
+        Value right;
+        this->m_args[1]->eval(record, &right);
+        Impl::apply(left, right, result);
+    }
+};
+
+//! Case-insensitive LIKE matching with % and _ wildcards.
+//! Both @a str and @a pattern are expected to be case-folded.
+static bool likeMatch(const QString &str, const QString &pattern)
+{
+    const int strLength = str.length();
+    const int patternLength = pattern.length();
+    int s = 0;
+    int p = 0;
+    int percentPos = -1;
+    int percentMatchPos = 0;
+    while (s < strLength) {
+        if (p < patternLength && pattern[p] == QLatin1Char('%')) {
+            percentPos = p++;
+            percentMatchPos = s;
+        } else if (p < patternLength
+                   && (pattern[p] == QLatin1Char('_') || pattern[p] == str[s]))
+        {
+            ++s;
+            ++p;
+        } else if (percentPos >= 0) {
+            // backtrack: let the last % consume one more character
+            p = percentPos + 1;
+            s = ++percentMatchPos;
+        } else {
+            return false;
+        }
+    }
+    while (p < patternLength && pattern[p] == QLatin1Char('%')) {
+        ++p;
+    }
+    return p == patternLength;
+}
+
+class LikeNode : public NodeWithArgs
+{
+public:
+    //! Pattern of constant @a right argument is case-folded once
+    LikeNode(Node *left, Node *right, bool negated)
+        : NodeWithArgs(QVector<Node*>() << left << right)
+        , m_negated(negated)
+    {
+        if (right->isConstant()) {
+            Value pattern;
+            right->eval(KDbRecordData(), &pattern);
+            m_constantPatternIsNull = pattern.isNull();
+            m_constantPattern = pattern.toText().toCaseFolded();
+            m_hasConstantPattern = true;
+        }
+    }
+
+    void eval(const KDbRecordData &record, Value *result) const override
+    {
+        Value str;
+        m_args[0]->eval(record, &str);
+        if (m_hasConstantPattern) {
+            apply(str, m_constantPatternIsNull, m_constantPattern, result);
+        } else {
+            Value pattern;
+            m_args[1]->eval(record, &pattern);
+            apply(str, pattern.isNull(), pattern.toText().toCaseFolded(), result);
+        }
+    }
+
+    void evalBatch(const QList<KDbRecordData*> &records, int from, int count,
+                   Value *result) const override
+    {
+        const Value *str = evalArgBatch(0, records, from, count);
+        if (m_hasConstantPattern) {
+            for (int i = 0; i < count; ++i) {
+                apply(str[i], m_constantPatternIsNull, m_constantPattern, result + i);
+            }
+        } else {
+            const Value *pattern = evalArgBatch(1, records, from, count);
+            for (int i = 0; i < count; ++i) {
+                apply(str[i], pattern[i].isNull(), pattern[i].toText().toCaseFolded(),
+                      result + i);
+            }
+        }
+    }
+
+private:
+    inline void apply(const Value &str, bool patternIsNull, const QString &pattern,
+                      Value *result) const
+    {
+        if (str.isNull() || patternIsNull) {
+            result->setNull();
+        } else {
+            result->setBool(likeMatch(str.toText().toCaseFolded(), pattern) != m_negated);
+        }
+    }
+
+    const bool m_negated;
+    bool m_hasConstantPattern = false;
+    bool m_constantPatternIsNull = false;
+    QString m_constantPattern;
+};
+
+class UnaryNode : public NodeWithArgs
+{
+public:
+    enum Operation {
+        Minus,
+        Plus,
+        BitwiseNot,
+        Not,
+        IsNull,
+        IsNotNull
+    };
+
+    UnaryNode(Operation operation, Node *arg)
+        : NodeWithArgs(QVector<Node*>() << arg), m_operation(operation)
+    {
+    }
+
+    void eval(const KDbRecordData &record, Value *result) const override
+    {
+        Value arg;
+        m_args[0]->eval(record, &arg);
+        apply(arg, result);
+    }
+
+    void evalBatch(const QList<KDbRecordData*> &records, int from, int count,
+                   Value *result) const override
+    {
+        const Value *args = evalArgBatch(0, records, from, count);
+        for (int i = 0; i < count; ++i) {
+            apply(args[i], result + i);
+        }
+    }
+
+private:
+    inline void apply(const Value &arg, Value *result) const
+    {
+        switch (m_operation) {
+        case IsNull:
+            result->setBool(arg.isNull());
+            return;
+        case IsNotNull:
+            result->setBool(!arg.isNull());
+            return;
+        case Not:
+            setTruth(notTruth(truth(arg)), result);
+            return;
+        default:
+            break;
+        }
+        if (arg.isNull()) {
+            result->setNull();
+            return;
+        }
+        const Number n(arg);
+        switch (m_operation) {
+        case Minus:
+            if (n.isDouble) {
+                result->setDouble(-n.d);
+            } else {
+                result->setInteger(qint64(0 - quint64(n.i)));
+            }
+            break;
+        case Plus:
+            if (arg.isNumeric()) {
+                *result = arg;
+            } else if (n.isDouble) {
+                result->setDouble(n.d);
+            } else {
+                result->setInteger(n.i);
+            }
+            break;
+        case BitwiseNot:
+            result->setInteger(~n.toInteger());
+            break;
+        default:
+            break;
+        }
+    }
+
+    const Operation m_operation;
+};
+
+//! [NOT] BETWEEN ... AND ..., equivalent of (a >= b AND a <= c)
+class BetweenNode : public NodeWithArgs
+{
+public:
+    BetweenNode(const QVector<Node*> &args, bool negated)
+        : NodeWithArgs(args), m_negated(negated)
+    {
+    }
+
+    void eval(const KDbRecordData &record, Value *result) const override
+    {
+        Value args[3];
+        for (int i = 0; i < 3; ++i) {
+            m_args[i]->eval(record, args + i);
+        }
+        apply(args[0], args[1], args[2], result);
+    }
+
+    void evalBatch(const QList<KDbRecordData*> &records, int from, int count,
+                   Value *result) const override
+    {
+        const Value *values = evalArgBatch(0, records, from, count);
+        const Value *lower = evalArgBatch(1, records, from, count);
+        const Value *upper = evalArgBatch(2, records, from, count);
+        for (int i = 0; i < count; ++i) {
+            apply(values[i], lower[i], upper[i], result + i);
+        }
+    }
+
+private:
+    inline void apply(const Value &value, const Value &lower, const Value &upper,
+                      Value *result) const
+    {
+        if (value.isNull()) {
+            result->setNull();
+            return;
+        }
+        const Truth lowerOk = lower.isNull() ? Truth::Unknown
+            : (compareValues(value, lower) >= 0 ? Truth::True : Truth::False);
+        const Truth upperOk = upper.isNull() ? Truth::Unknown
+            : (compareValues(value, upper) <= 0 ? Truth::True : Truth::False);
+        const Truth t = andTruth(lowerOk, upperOk);
+        setTruth(m_negated ? notTruth(t) : t, result);
+    }
+
+    const bool m_negated;
+};
+
+/*! a IN (b1, .., bN): true if a is equal to any of b1..bN, NULL if a is NULL or
+ no item is equal but at least one is NULL, false otherwise. */
+class InNode : public NodeWithArgs
+{
+public:
+    explicit InNode(const QVector<Node*> &args) : NodeWithArgs(args) {}
+
+    void eval(const KDbRecordData &record, Value *result) const override
+    {
+        Value value;
+        m_args[0]->eval(record, &value);
+        if (value.isNull()) {
+            result->setNull();
+            return;
+        }
+        bool nullFound = false;
+        Value item;
+        for (int j = 1; j < m_args.count(); ++j) {
+            m_args[j]->eval(record, &item);
+            if (item.isNull()) {
+                nullFound = true;
+            } else if (compareValues(value, item) == 0) {
+                result->setBool(true);
+                return;
+            }
+        }
+        setTruth(nullFound ? Truth::Unknown : Truth::False, result);
+    }
+
+    void evalBatch(const QList<KDbRecordData*> &records, int from, int count,
+                   Value *result) const override
+    {
+        const Value *values = evalArgBatch(0, records, from, count);
+        QVarLengthArray<const Value*, 16> items(m_args.count());
+        for (int j = 1; j < m_args.count(); ++j) {
+            items[j] = evalArgBatch(j, records, from, count);
+        }
+        for (int i = 0; i < count; ++i) {
+            if (values[i].isNull()) {
+                result[i].setNull();
+                continue;
+            }
+            Truth t = Truth::False;
+            for (int j = 1; j < m_args.count(); ++j) {
+                const Value &item = items[j][i];
+                if (item.isNull()) {
+                    t = Truth::Unknown;
+                } else if (compareValues(values[i], item) == 0) {
+                    t = Truth::True;
+                    break;
+                }
+            }
+            setTruth(t, result + i);
+        }
+    }
+};
+
+//! Implementation of a built-in function, @a args has @a count elements
+typedef void (*FunctionImplementation)(const Value * const *args, int count, Value *result);
+
+class FunctionNode : public NodeWithArgs
+{
+public:
+    FunctionNode(FunctionImplementation implementation, const QVector<Node*> &args)
+        : NodeWithArgs(args), m_implementation(implementation)
+    {
+    }
+
+    void eval(const KDbRecordData &record, Value *result) const override
+    {
+        QVarLengthArray<Value, 4> values(m_args.count());
+        QVarLengthArray<const Value*, 4> args(m_args.count());
+        for (int j = 0; j < m_args.count(); ++j) {
+            m_args[j]->eval(record, &values[j]);
+            args[j] = &values[j];
+        }
+        m_implementation(args.constData(), args.count(), result);
+    }
+
+    void evalBatch(const QList<KDbRecordData*> &records, int from, int count,
+                   Value *result) const override
+    {
+        QVarLengthArray<const Value*, 4> columns(m_args.count());
+        for (int j = 0; j < m_args.count(); ++j) {
+            columns[j] = evalArgBatch(j, records, from, count);
+        }
+        QVarLengthArray<const Value*, 4> args(m_args.count());
+        for (int i = 0; i < count; ++i) {
+            for (int j = 0; j < m_args.count(); ++j) {
+                args[j] = columns[j] + i;
+            }
+            m_implementation(args.constData(), args.count(), result + i);
+        }
+    }
+
+private:
+    const FunctionImplementation m_implementation;
+};
+
+//! @return true if any of @a count @a args is NULL; sets @a result to NULL in this case
+static inline bool anyNull(const Value * const *args, int count, Value *result)
+{
+    for (int i = 0; i < count; ++i) {
+        if (args[i]->isNull()) {
+            result->setNull();
+            return true;
+        }
+    }
+    return false;
+}
+
+static void absFunction(const Value * const *args, int count, Value *result)
+{
+    if (anyNull(args, count, result)) {
+        return;
+    }
+    const Number n(*args[0]);
+    if (n.isDouble) {
+        result->setDouble(std::fabs(n.d));
+    } else {
+        result->setInteger(n.i < 0 ? qint64(0 - quint64(n.i)) : n.i);
+    }
+}
+
+template <double (*roundingFunction)(double)>
+static void ceilingFloorFunction(const Value * const *args, int count, Value *result)
+{
+    if (anyNull(args, count, result)) {
+        return;
+    }
+    const Number n(*args[0]);
+    if (n.isDouble) {
+        result->setInteger(qint64(roundingFunction(n.d)));
+    } else {
+        result->setInteger(n.i);
+    }
+}
+
+static void charFunction(const Value * const *args, int count, Value *result)
+{
+    QVector<uint> codePoints;
+    codePoints.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        if (!args[i]->isNull()) {
+            codePoints.append(uint(Number(*args[i]).toInteger()));
+        }
+    }
+    result->setText(QString::fromUcs4(codePoints.constData(), codePoints.count()));
+}
+
+static void coalesceFunction(const Value * const *args, int count, Value *result)
+{
+    for (int i = 0; i < count; ++i) {
+        if (!args[i]->isNull()) {
+            *result = *args[i];
+            return;
+        }
+    }
+    result->setNull();
+}
+
+template <bool greatest>
+static void minMaxFunction(const Value * const *args, int count, Value *result)
+{
+    if (anyNull(args, count, result)) {
+        return;
+    }
+    int found = 0;
+    for (int i = 1; i < count; ++i) {
+        const int cmp = compareValues(*args[i], *args[found]);
+        if (greatest ? cmp > 0 : cmp < 0) {
+            found = i;
+        }
+    }
+    *result = *args[found];
+}
+
+static void hexFunction(const Value * const *args, int count, Value *result)
+{
+    if (anyNull(args, count, result)) {
+        return;
+    }
+    const Value &arg = *args[0];
+    const QByteArray data = (arg.type == Value::Other && arg.other.userType() == QMetaType::QByteArray)
+        ? arg.other.toByteArray() : arg.toText().toUtf8();
+    result->setText(QString::fromLatin1(data.toHex().toUpper()));
+}
+
+static void instrFunction(const Value * const *args, int count, Value *result)
+{
+    if (anyNull(args, count, result)) {
+        return;
+    }
+    result->setInteger(args[0]->toText().indexOf(args[1]->toText()) + 1);
+}
+
+static void lengthFunction(const Value * const *args, int count, Value *result)
+{
+    if (anyNull(args, count, result)) {
+        return;
+    }
+    const Value &arg = *args[0];
+    if (arg.type == Value::Other && arg.other.userType() == QMetaType::QByteArray) {
+        result->setInteger(arg.other.toByteArray().size());
+    } else {
+        result->setInteger(arg.toText().length());
+    }
+}
+
+static void lowerFunction(const Value * const *args, int count, Value *result)
+{
+    if (anyNull(args, count, result)) {
+        return;
+    }
+    result->setText(args[0]->toText().toLower());
+}
+
+static void upperFunction(const Value * const *args, int count, Value *result)
+{
+    if (anyNull(args, count, result)) {
+        return;
+    }
+    result->setText(args[0]->toText().toUpper());
+}
+
+static void nullIfFunction(const Value * const *args, int count, Value *result)
+{
+    Q_UNUSED(count)
+    if (!args[0]->isNull() && !args[1]->isNull() && compareValues(*args[0], *args[1]) == 0) {
+        result->setNull();
+    } else {
+        *result = *args[0];
+    }
+}
+
+static void randomFunction(const Value * const *args, int count, Value *result)
+{
+    const double random = double(qrand()) / (double(RAND_MAX) + 1.0);
+    if (count == 0) {
+        result->setDouble(random);
+        return;
+    }
+    if (anyNull(args, count, result)) {
+        return;
+    }
+    const qint64 x = Number(*args[0]).toInteger();
+    const qint64 y = Number(*args[1]).toInteger();
+    result->setInteger(x + qint64(std::floor(random * double(y - x))));
+}
+
+static void roundFunction(const Value * const *args, int count, Value *result)
+{
+    if (anyNull(args, count, result)) {
+        return;
+    }
+    const Number n(*args[0]);
+    const qint64 digits = count > 1 ? qMax(qint64(0), Number(*args[1]).toInteger()) : 0;
+    if (!n.isDouble) {
+        result->setInteger(n.i);
+        return;
+    }
+    if (digits == 0) {
+        result->setInteger(qint64(std::round(n.d)));
+        return;
+    }
+    const double factor = std::pow(10.0, double(qMin(digits, qint64(30))));
+    result->setDouble(std::round(n.d * factor) / factor);
+}
+
+enum TrimSide {
+    TrimLeft = 1,
+    TrimRight = 2,
+    TrimBoth = TrimLeft | TrimRight
+};
+
+template <int side>
+static void trimFunction(const Value * const *args, int count, Value *result)
+{
+    if (anyNull(args, count, result)) {
+        return;
+    }
+    const QString str = args[0]->toText();
+    const QString characters = count > 1 ? args[1]->toText() : QStringLiteral(" ");
+    int start = 0;
+    int end = str.length();
+    if (side & TrimLeft) {
+        while (start < end && characters.contains(str[start])) {
+            ++start;
+        }
+    }
+    if (side & TrimRight) {
+        while (end > start && characters.contains(str[end - 1])) {
+            --end;
+        }
+    }
+    result->setText(str.mid(start, end - start));
+}
+
+//! Soundex encoding compatible with SQLite
+static void soundexFunction(const Value * const *args, int count, Value *result)
+{
+    Q_UNUSED(count)
+    static const char codes[] = "01230120022455012623010202"; // A..Z
+    const QString str = args[0]->toText();
+    int i = 0;
+    while (i < str.length() && !(str[i].unicode() < 128 && str[i].isLetter())) {
+        ++i;
+    }
+    if (args[0]->isNull() || i >= str.length()) {
+        result->setText(QStringLiteral("?000"));
+        return;
+    }
+    QString soundex(4, QLatin1Char('0'));
+    soundex[0] = str[i].toUpper();
+    char previous = codes[soundex[0].unicode() - 'A'];
+    int j = 1;
+    for (++i; j < 4 && i < str.length(); ++i) {
+        const ushort c = str[i].toUpper().unicode();
+        if (c < 'A' || c > 'Z') {
+            continue;
+        }
+        const char code = codes[c - 'A'];
+        if (code != '0' && code != previous) {
+            soundex[j++] = QLatin1Char(code);
+        }
+        previous = code;
+    }
+    result->setText(soundex);
+}
+
+//! substr(X, Y[, Z]) with the same handling of negative and zero arguments as SQLite
+static void substrFunction(const Value * const *args, int count, Value *result)
+{
+    if (anyNull(args, count, result)) {
+        return;
+    }
+    const QString str = args[0]->toText();
+    const qint64 length = str.length();
+    qint64 start = Number(*args[1]).toInteger();
+    qint64 size = length;
+    bool negativeSize = false;
+    if (count > 2) {
+        size = Number(*args[2]).toInteger();
+        if (size < 0) {
+            size = -size;
+            negativeSize = true;
+        }
+    }
+    if (start < 0) {
+        start += length;
+        if (start < 0) {
+            size += start;
+            if (size < 0) {
+                size = 0;
+            }
+            start = 0;
+        }
+    } else if (start > 0) {
+        --start;
+    } else if (size > 0) {
+        --size;
+    }
+    if (negativeSize) {
+        start -= size;
+        if (start < 0) {
+            size += start;
+            start = 0;
+        }
+    }
+    if (start + size > length) {
+        size = qMax(qint64(0), length - start);
+    }
+    result->setText(str.mid(int(start), int(size)));
+}
+
+static void unicodeFunction(const Value * const *args, int count, Value *result)
+{
+    if (anyNull(args, count, result)) {
+        return;
+    }
+    const QVector<uint> codePoints = args[0]->toText().toUcs4();
+    if (codePoints.isEmpty()) {
+        result->setNull();
+    } else {
+        result->setInteger(codePoints.first());
+    }
+}
+
+//! Built-in function supported by the evaluator
+struct FunctionInfo
+{
+    FunctionImplementation implementation;
+    int minArgs;
+    int maxArgs;
+    bool deterministic;
+};
+
+//! Built-in functions supported by the evaluator, see KDbFunctionExpression for definitions
+class BuiltInFunctions : public QHash<QString, FunctionInfo>
+{
+public:
+    BuiltInFunctions()
+    {
+        const int many = KDB_MAX_FUNCTION_ARGS;
+        insert(QStringLiteral("ABS"), { absFunction, 1, 1, true });
+        insert(QStringLiteral("CEILING"), { ceilingFloorFunction<std::ceil>, 1, 1, true });
+        insert(QStringLiteral("CHAR"), { charFunction, 0, many, true });
+        insert(QStringLiteral("COALESCE"), { coalesceFunction, 2, many, true });
+        insert(QStringLiteral("FLOOR"), { ceilingFloorFunction<std::floor>, 1, 1, true });
+        insert(QStringLiteral("GREATEST"), { minMaxFunction<true>, 2, many, true });
+        insert(QStringLiteral("MAX"), value(QStringLiteral("GREATEST")));
+        insert(QStringLiteral("HEX"), { hexFunction, 1, 1, true });
+        insert(QStringLiteral("IFNULL"), { coalesceFunction, 2, 2, true });
+        insert(QStringLiteral("INSTR"), { instrFunction, 2, 2, true });
+        insert(QStringLiteral("LEAST"), { minMaxFunction<false>, 2, many, true });
+        insert(QStringLiteral("MIN"), value(QStringLiteral("LEAST")));
+        insert(QStringLiteral("LENGTH"), { lengthFunction, 1, 1, true });
+        insert(QStringLiteral("LOWER"), { lowerFunction, 1, 1, true });
+        insert(QStringLiteral("LTRIM"), { trimFunction<TrimLeft>, 1, 2, true });
+        insert(QStringLiteral("NULLIF"), { nullIfFunction, 2, 2, true });
+        insert(QStringLiteral("RANDOM"), { randomFunction, 0, 2, false });
+        insert(QStringLiteral("ROUND"), { roundFunction, 1, 2, true });
+        insert(QStringLiteral("RTRIM"), { trimFunction<TrimRight>, 1, 2, true });
+        insert(QStringLiteral("SOUNDEX"), { soundexFunction, 1, 1, true });
+        insert(QStringLiteral("SUBSTR"), { substrFunction, 2, 3, true });
+        insert(QStringLiteral("TRIM"), { trimFunction<TrimBoth>, 1, 2, true });
+        insert(QStringLiteral("UNICODE"), { unicodeFunction, 1, 1, true });
+        insert(QStringLiteral("UPPER"), { upperFunction, 1, 1, true });
+    }
+};
+
+Q_GLOBAL_STATIC(BuiltInFunctions, KDb_builtInFunctions)
+
+//! Lowers expressions to trees of nodes
+class Compiler
+{
+public:
+    Compiler(KDbResult *result, const QList<QVariant> &parameters)
+        : m_result(result), m_parameters(parameters)
+    {
+    }
+
+    //! Makes field @a field available as column @a index for variables
+    void addColumn(int index, const KDbField *field, const QString &alias = QString())
+    {
+        if (!field) {
+            return;
+        }
+        if (!m_columnsForFields.contains(field)) {
+            m_columnsForFields.insert(field, index);
+        }
+        addName(field->name(), index);
+        if (field->table()) {
+            addName(field->table()->name() + QLatin1Char('.') + field->name(), index);
+        }
+        if (!alias.isEmpty()) {
+            addName(alias, index);
+        }
+    }
+
+    //! @return node for expression @a expr or nullptr on failure
+    Node* compile(const KDbExpression &expr)
+    {
+        if (expr.isNull()) {
+            return error(ERR_OTHER, KDbExpressionEvaluator::tr("Expression is empty."));
+        }
+        // the order of checks matters: query parameter is a const expression
+        if (expr.isQueryParameter()) {
+            return compileQueryParameter();
+        }
+        if (expr.isConst()) {
+            return compileConst(expr.toConst());
+        }
+        if (expr.isVariable()) {
+            return compileVariable(expr.toVariable());
+        }
+        if (expr.isFunction()) {
+            return compileFunction(expr.toFunction());
+        }
+        if (expr.isUnary()) {
+            return compileUnary(expr.toUnary());
+        }
+        if (expr.isBinary()) {
+            return compileBinary(expr.toBinary());
+        }
+        if (expr.isNArg()) {
+            return compileNArg(expr.toNArg());
+        }
+        return unsupported(expr);
+    }
+
+private:
+    void addName(const QString &name, int index)
+    {
+        const QString key(name.toLower());
+        if (!m_columnsForNames.contains(key)) {
+            m_columnsForNames.insert(key, index);
+        }
+    }
+
+    Node* error(int code, const QString &message)
+    {
+        if (!m_result->isError()) {
+            *m_result = KDbResult(code, message);
+        }
+        return nullptr;
+    }
+
+    Node* unsupported(const KDbExpression &expr)
+    {
+        return error(ERR_OTHER,
+                     KDbExpressionEvaluator::tr("Expression \"%1\" cannot be evaluated on the client side.")
+                     .arg(expr.toString(nullptr).toString()));
+    }
+
+    //! Replaces @a node with constant if it depends on constant @a args only
+    Node* fold(Node *node, const QVector<Node*> &args)
+    {
+        for (const Node *arg : args) {
+            if (!arg->isConstant()) {
+                return node;
+            }
+        }
+        Value value;
+        node->eval(KDbRecordData(), &value);
+        delete node;
+        return new ConstNode(value);
+    }
+
+    //! Compiles all @a exprs into @a nodes, @return false on failure
+    bool compileArgs(const QList<KDbExpression> &exprs, QVector<Node*> *nodes)
+    {
+        for (const KDbExpression &expr : exprs) {
+            Node *node = compile(expr);
+            if (!node) {
+                qDeleteAll(*nodes);
+                nodes->clear();
+                return false;
+            }
+            nodes->append(node);
+        }
+        return true;
+    }
+
+    Node* compileQueryParameter()
+    {
+        if (m_nextParameter >= m_parameters.count()) {
+            return error(ERR_OTHER,
+                         KDbExpressionEvaluator::tr("Missing value for query parameter."));
+        }
+        Value value;
+        value.setVariant(m_parameters.at(m_nextParameter++));
+        return new ConstNode(value);
+    }
+
+    Node* compileConst(const KDbConstExpression &expr)
+    {
+        QVariant v(expr.value());
+        if (expr.token() == KDbToken::REAL_CONST) {
+            v = v.toDouble(); // stored as text by the parser to avoid precision loss
+        } else if (v.userType() == qMetaTypeId<KDbDate>()) {
+            v = v.value<KDbDate>().toQDate();
+        } else if (v.userType() == qMetaTypeId<KDbTime>()) {
+            v = v.value<KDbTime>().toQTime();
+        } else if (v.userType() == qMetaTypeId<KDbDateTime>()) {
+            v = v.value<KDbDateTime>().toQDateTime();
+        }
+        Value value;
+        value.setVariant(v);
+        return new ConstNode(value);
+    }
+
+    Node* compileVariable(const KDbVariableExpression &expr)
+    {
+        int index = expr.field() ? m_columnsForFields.value(expr.field(), -1) : -1;
+        if (index < 0) {
+            index = m_columnsForNames.value(expr.name().toLower(), -1);
+        }
+        if (index < 0) {
+            return error(ERR_OBJECT_NOT_FOUND,
+                         KDbExpressionEvaluator::tr("Could not find column \"%1\".").arg(expr.name()));
+        }
+        return new ColumnNode(index);
+    }
+
+    Node* compileFunction(const KDbFunctionExpression &expr)
+    {
+        const QString name(expr.name().toUpper());
+        const BuiltInFunctions::ConstIterator it = KDb_builtInFunctions->constFind(name);
+        if (it == KDb_builtInFunctions->constEnd()) {
+            return unsupported(expr);
+        }
+        KDbFunctionExpression function(expr);
+        const KDbNArgExpression arguments(function.arguments());
+        QList<KDbExpression> exprs;
+        for (int i = 0; i < arguments.argCount(); ++i) {
+            exprs.append(arguments.arg(i));
+        }
+        if (exprs.count() < it->minArgs || exprs.count() > it->maxArgs) {
+            return error(ERR_OTHER,
+                         KDbExpressionEvaluator::tr("Incorrect number of arguments of function \"%1\".")
+                         .arg(name));
+        }
+        QVector<Node*> args;
+        if (!compileArgs(exprs, &args)) {
+            return nullptr;
+        }
+        Node *node = new FunctionNode(it->implementation, args);
+        return it->deterministic ? fold(node, args) : node;
+    }
+
+    Node* compileUnary(const KDbUnaryExpression &expr)
+    {
+        const KDbToken token = expr.token();
+        if (token == '(') { // parentheses only group expressions
+            return compile(expr.arg());
+        }
+        UnaryNode::Operation operation;
+        if (token == '-') {
+            operation = UnaryNode::Minus;
+        } else if (token == '+') {
+            operation = UnaryNode::Plus;
+        } else if (token == '~') {
+            operation = UnaryNode::BitwiseNot;
+        } else if (token == KDbToken::NOT) {
+            operation = UnaryNode::Not;
+        } else if (token == KDbToken::SQL_IS_NULL) {
+            operation = UnaryNode::IsNull;
+        } else if (token == KDbToken::SQL_IS_NOT_NULL) {
+            operation = UnaryNode::IsNotNull;
+        } else {
+            return unsupported(expr);
+        }
+        Node *arg = compile(expr.arg());
+        if (!arg) {
+            return nullptr;
+        }
+        return fold(new UnaryNode(operation, arg), QVector<Node*>() << arg);
+    }
+
+    template <typename Impl>
+    static Node* binaryNode(Node *left, Node *right)
+    {
+        return new BinaryNode<Impl>(left, right);
+    }
+
+    Node* compileBinary(const KDbBinaryExpression &expr)
+    {
+        const KDbToken token = expr.token();
+        if (token == KDbToken::SQL_IN) {
+            return compileIn(expr);
+        }
+        Node* (*create)(Node*, Node*) = nullptr;
+        bool like = false;
+        bool negated = false;
+        switch (token.value()) {
+        case '+': create = binaryNode<AddImpl>; break;
+        case '-': create = binaryNode<SubtractImpl>; break;
+        case '*': create = binaryNode<MultiplyImpl>; break;
+        case '/': create = binaryNode<DivideImpl>; break;
+        case '%': create = binaryNode<ModuloImpl>; break;
+        case '&': create = binaryNode<BitwiseAndImpl>; break;
+        case '|': create = binaryNode<BitwiseOrImpl>; break;
+        case '=': create = binaryNode<EqualImpl>; break;
+        case '<': create = binaryNode<LessImpl>; break;
+        case '>': create = binaryNode<GreaterImpl>; break;
+        default:
+            if (token == KDbToken::BITWISE_SHIFT_LEFT) {
+                create = binaryNode<ShiftLeftImpl>;
+            } else if (token == KDbToken::BITWISE_SHIFT_RIGHT) {
+                create = binaryNode<ShiftRightImpl>;
+            } else if (token == KDbToken::CONCATENATION) {
+                create = binaryNode<ConcatenationImpl>;
+            } else if (token == KDbToken::NOT_EQUAL || token == KDbToken::NOT_EQUAL2) {
+                create = binaryNode<NotEqualImpl>;
+            } else if (token == KDbToken::LESS_OR_EQUAL) {
+                create = binaryNode<LessOrEqualImpl>;
+            } else if (token == KDbToken::GREATER_OR_EQUAL) {
+                create = binaryNode<GreaterOrEqualImpl>;
+            } else if (token == KDbToken::AND) {
+                create = [](Node *left, Node *right) -> Node* {
+                    return new LogicalNode<AndImpl, false>(left, right);
+                };
+            } else if (token == KDbToken::OR) {
+                create = [](Node *left, Node *right) -> Node* {
+                    return new LogicalNode<OrImpl, true>(left, right);
+                };
+            } else if (token == KDbToken::XOR) {
+                create = binaryNode<XorImpl>;
+            } else if (token == KDbToken::LIKE || token == KDbToken::ILIKE) {
+                like = true;
+            } else if (token == KDbToken::NOT_LIKE) {
+                like = true;
+                negated = true;
+            } else {
+                return unsupported(expr);
+            }
+        }
+        QVector<Node*> args;
+        if (!compileArgs(QList<KDbExpression>() << expr.left() << expr.right(), &args)) {
+            return nullptr;
+        }
+        Node *node = like ? new LikeNode(args[0], args[1], negated) : create(args[0], args[1]);
+        return fold(node, args);
+    }
+
+    Node* compileIn(const KDbBinaryExpression &expr)
+    {
+        QList<KDbExpression> exprs;
+        exprs.append(expr.left());
+        KDbExpression right(expr.right());
+        if (right.isUnary() && right.token() == '(') {
+            right = right.toUnary().arg();
+        }
+        if (right.isNArg()) {
+            const KDbNArgExpression list(right.toNArg());
+            for (int i = 0; i < list.argCount(); ++i) {
+                exprs.append(list.arg(i));
+            }
+        } else {
+            exprs.append(right);
+        }
+        QVector<Node*> args;
+        if (!compileArgs(exprs, &args)) {
+            return nullptr;
+        }
+        return fold(new InNode(args), args);
+    }
+
+    Node* compileNArg(const KDbNArgExpression &expr)
+    {
+        const KDbToken token = expr.token();
+        if (token != KDbToken::BETWEEN_AND && token != KDbToken::NOT_BETWEEN_AND) {
+            return unsupported(expr);
+        }
+        if (expr.argCount() != 3) {
+            return error(ERR_OTHER,
+                         KDbExpressionEvaluator::tr("%1 operator requires exactly three arguments.",
+                                                    "BETWEEN..AND error")
+                         .arg(QLatin1String("BETWEEN...AND")));
+        }
+        QVector<Node*> args;
+        if (!compileArgs(QList<KDbExpression>() << expr.arg(0) << expr.arg(1) << expr.arg(2),
+                         &args))
+        {
+            return nullptr;
+        }
+        return fold(new BetweenNode(args, token == KDbToken::NOT_BETWEEN_AND), args);
+    }
+
+    KDbResult * const m_result;
+    const QList<QVariant> m_parameters;
+    int m_nextParameter = 0;
+    QHash<const KDbField*, int> m_columnsForFields;
+    QHash<QString, int> m_columnsForNames;
+};
+
+} // namespace
+
+class Q_DECL_HIDDEN KDbExpressionEvaluator::Private
+{
+public:
+    Private()
+    {
+    }
+
+    ~Private()
+    {
+        delete root;
+    }
+
+    //! Evaluates batches of @a records, calls @a handle(index, value) for each record
+    template <typename Handler>
+    void evalBatches(const QList<KDbRecordData*> &records, Handler handle) const
+    {
+        for (int from = 0; from < records.count(); from += batchSize) {
+            const int count = qMin(batchSize, records.count() - from);
+            Value *values = registers(&batchRegisters, count);
+            root->evalBatch(records, from, count, values);
+            for (int i = 0; i < count; ++i) {
+                handle(from + i, values[i]);
+            }
+        }
+    }
+
+    bool compile(KDbExpressionEvaluator *q, const KDbExpression &expr, Compiler *compiler)
+    {
+        q->clear();
+        root = compiler->compile(expr);
+        if (!root) {
+            return false;
+        }
+        expression = expr;
+        return true;
+    }
+
+    KDbExpression expression;
+    Node *root = nullptr;
+    int batchSize = 1024;
+    mutable QVector<Value> batchRegisters;
+};
+
+KDbExpressionEvaluator::KDbExpressionEvaluator()
+    : d(new Private)
+{
+}
+
+KDbExpressionEvaluator::~KDbExpressionEvaluator()
+{
+    delete d;
+}
+
+bool KDbExpressionEvaluator::compile(const KDbExpression &expr,
+                                     const KDbQueryColumnInfo::Vector &columns,
+                                     const QList<QVariant> &parameters)
+{
+    clearResult();
+    Compiler compiler(&m_result, parameters);
+    for (int i = 0; i < columns.count(); ++i) {
+        compiler.addColumn(i, columns[i]->field(), columns[i]->alias());
+    }
+    return d->compile(this, expr, &compiler);
+}
+
+bool KDbExpressionEvaluator::compile(const KDbExpression &expr, const KDbFieldList &fields,
+                                     const QList<QVariant> &parameters)
+{
+    clearResult();
+    Compiler compiler(&m_result, parameters);
+    for (int i = 0; i < fields.fieldCount(); ++i) {
+        compiler.addColumn(i, fields.field(i));
+    }
+    return d->compile(this, expr, &compiler);
+}
+
+bool KDbExpressionEvaluator::isCompiled() const
+{
+    return d->root;
+}
+
+void KDbExpressionEvaluator::clear()
+{
+    delete d->root;
+    d->root = nullptr;
+    d->expression = KDbExpression();
+    d->batchRegisters.clear();
+}
+
+KDbExpression KDbExpressionEvaluator::expression() const
+{
+    return d->expression;
+}
+
+QVariant KDbExpressionEvaluator::evaluate(const KDbRecordData &record) const
+{
+    if (!d->root) {
+        return QVariant();
+    }
+    Value value;
+    d->root->eval(record, &value);
+    return value.toVariant();
+}
+
+QList<QVariant> KDbExpressionEvaluator::evaluate(const QList<KDbRecordData*> &records) const
+{
+    QList<QVariant> result;
+    if (!d->root) {
+        return result;
+    }
+    result.reserve(records.count());
+    d->evalBatches(records, [&result](int index, const Value &value) {
+        Q_UNUSED(index)
+        result.append(value.toVariant());
+    });
+    return result;
+}
+
+bool KDbExpressionEvaluator::matches(const KDbRecordData &record) const
+{
+    if (!d->root) {
+        return false;
+    }
+    Value value;
+    d->root->eval(record, &value);
+    return truth(value) == Truth::True;
+}
+
+QBitArray KDbExpressionEvaluator::filter(const QList<KDbRecordData*> &records) const
+{
+    QBitArray result(records.count());
+    if (!d->root) {
+        return result;
+    }
+    d->evalBatches(records, [&result](int index, const Value &value) {
+        if (truth(value) == Truth::True) {
+            result.setBit(index);
+        }
+    });
+    return result;
+}
+
+int KDbExpressionEvaluator::batchSize() const
+{
+    return d->batchSize;
+}
+
+void KDbExpressionEvaluator::setBatchSize(int size)
+{
+    if (size > 0) {
+        d->batchSize = size;
+    }
+}
@@ -0,0 +1,134 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_EXPRESSIONEVALUATOR_H
+#define KDB_EXPRESSIONEVALUATOR_H
+
+#include "KDbExpression.h"
+#include "KDbQueryColumnInfo.h"
+#include "KDbResult.h"
+
+#include <QBitArray>
+#include <QCoreApplication>
+
+class KDbFieldList;
+class KDbRecordData;
+
+//! @short Client-side evaluator of KDbExpression trees
+/*! KDbExpression objects can be only converted to SQL text that has to be executed by
+ the database server. KDbExpressionEvaluator compiles an expression into a tree of typed
+ closures so it can be evaluated against records that are already fetched, e.g. to filter
+ KDbTableViewData, to check values of a record being edited or to compute derived columns.
+
+ Variables (field names) found in the expression are bound to column positions of records
+ on compilation. Pointers to fields assigned by KDbExpression::validate() are used first,
+ then variables are bound by names of fields in form "name" or "table.name". Values of query
+ parameters are taken from the list passed to compile(), in order of appearance.
+
+ Evaluation follows the SQL NULL semantics documented in KDbFunctionExpression:
+ - arithmetic, comparison and string operators return NULL if any argument is NULL,
+ - AND, OR and XOR follow three-valued logic, e.g. NULL AND false is false,
+ - COALESCE() and IFNULL() return their first non-NULL argument,
+ - GREATEST()/MAX() and LEAST()/MIN() return NULL if any argument is NULL (like SQLite
+   and MySQL >= 5.0.13),
+ - integer division by zero returns NULL.
+ Text is compared case-sensitively, LIKE is case-insensitive for all characters.
+
+ Besides the record-by-record evaluate() and matches() methods, filter() and evaluate()
+ overloads for lists of records are provided. They evaluate the expression column-wise
+ in batches of batchSize() records: each node of the compiled tree computes values for the
+ whole batch before its parent runs, so type dispatch happens once per batch for columns
+ of uniform type.
+
+ Aggregate functions, subqueries, SIMILAR TO and RANDOM() are not supported.
+ Evaluator is not thread-safe, create separate objects for each thread.
+
+ Example:
+ @code
+ KDbExpressionEvaluator evaluator;
+ if (!evaluator.compile(query->whereExpression(), query->fieldsExpanded(conn))) {
+     qWarning() << evaluator.result();
+     return;
+ }
+ const QBitArray matching = evaluator.filter(records);
+ @endcode
+ @since 3.3
+*/
+class KDB_EXPORT KDbExpressionEvaluator : public KDbResultable
+{
+    Q_DECLARE_TR_FUNCTIONS(KDbExpressionEvaluator)
+public:
+    //! Creates an empty evaluator, use compile() to prepare it for evaluation.
+    KDbExpressionEvaluator();
+
+    ~KDbExpressionEvaluator() override;
+
+    /*! Compiles expression @a expr. Values of variables will be taken from record positions
+     of respective @a columns. Values of query parameters are taken from @a parameters.
+     @return true on success. On failure result() contains error information
+     and isCompiled() returns false. */
+    bool compile(const KDbExpression &expr, const KDbQueryColumnInfo::Vector &columns,
+                 const QList<QVariant> &parameters = QList<QVariant>());
+
+    /*! @overload
+     Values of variables will be taken from record positions of respective fields
+     of @a fields, e.g. of a table schema. */
+    bool compile(const KDbExpression &expr, const KDbFieldList &fields,
+                 const QList<QVariant> &parameters = QList<QVariant>());
+
+    //! @return true if an expression has been successfully compiled
+    bool isCompiled() const;
+
+    //! Clears the compiled expression
+    void clear();
+
+    /*! @return the compiled expression.
+     A null expression is returned if isCompiled() is false. */
+    KDbExpression expression() const;
+
+    /*! @return value of the compiled expression for @a record.
+     Null value is returned for SQL NULL or if isCompiled() is false. */
+    QVariant evaluate(const KDbRecordData &record) const;
+
+    /*! @return values of the compiled expression for each of @a records.
+     This is a batched equivalent of evaluate(const KDbRecordData&). */
+    QList<QVariant> evaluate(const QList<KDbRecordData*> &records) const;
+
+    /*! @return true if the compiled expression is true for @a record.
+     This is useful for conditions, NULL is treated as false, as in the WHERE clause. */
+    bool matches(const KDbRecordData &record) const;
+
+    /*! @return bit array with bits set for each of @a records for which the compiled
+     expression is true. This is a batched equivalent of matches(). */
+    QBitArray filter(const QList<KDbRecordData*> &records) const;
+
+    //! @return maximum number of records evaluated column-wise at once. The default is 1024.
+    int batchSize() const;
+
+    //! Sets maximum number of records evaluated column-wise at once.
+    //! Values smaller than 1 are ignored.
+    void setBatchSize(int size);
+
+private:
+    Q_DISABLE_COPY(KDbExpressionEvaluator)
+    class Private;
+    Private * const d;
+};
+
+#endif
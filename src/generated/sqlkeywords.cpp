@@ -1,10 +1,9 @@
 /* This file is part of the KDE project
    Copyright (C) 2004 Martin Ellis <martin.ellis@kdemail.net>
-   Copyright (C) 2004 Jarosław Staniek <staniek@kde.org>
+   Copyright (C) 2004-2018 Jarosław Staniek <staniek@kde.org>
 
    This file has been automatically generated from
-   tools/sql_keywords.sh and src/parser/KDbSqlScanner.l
-   and tools/kdb_keywords.txt.
+   tools/sql_keywords.sh and src/parser/KDbSqlScanner.l and tools/kdb_keywords.txt.
 
    Please edit the sql_keywords.sh, not this file!
 
@@ -25,84 +24,90 @@
 */
 
 #include "KDbDriver_p.h"
+#include "KDbKeywordTable_p.h"
 
-const char* const KDbDriverPrivate::kdbSQLKeywords[] = {
-    "AND",
-    "AS",
-    "CREATE",
-    "FROM",
-    "IN",
-    "INTEGER",
-    "IS",
-    "JOIN",
-    "LEFT",
-    "LIKE",
-    "NOT",
-    "NULL",
-    "ON",
-    "OR",
-    "RIGHT",
-    "SELECT",
-    "SIMILAR",
-    "TABLE",
-    "TO",
-    "WHERE",
-    "XOR",
-    "AFTER",
-    "ALL",
-    "ASC",
-    "BEFORE",
-    "BEGIN",
-    "BETWEEN",
-    "BY",
-    "CASCADE",
-    "CASE",
-    "CHECK",
-    "COLLATE",
-    "COMMIT",
-    "CONSTRAINT",
-    "CROSS",
-    "DATABASE",
-    "DEFAULT",
-    "DELETE",
-    "DESC",
-    "DISTINCT",
-    "DROP",
-    "END",
-    "ELSE",
-    "EXPLAIN",
-    "FOR",
-    "FOREIGN",
-    "FULL",
-    "GROUP",
-    "HAVING",
-    "IGNORE",
-    "INDEX",
-    "INNER",
-    "INSERT",
-    "INTO",
-    "KEY",
-    "LIMIT",
-    "MATCH",
-    "NATURAL",
-    "OFFSET",
-    "ORDER",
-    "OUTER",
-    "PRIMARY",
-    "REFERENCES",
-    "REPLACE",
-    "RESTRICT",
-    "ROLLBACK",
-    "ROW",
-    "SET",
-    "TEMPORARY",
-    "THEN",
-    "TRANSACTION",
-    "UNION",
-    "UNIQUE",
-    "UPDATE",
-    "USING",
-    "VALUES",
-    "WHEN",
-    nullptr
+//! 77 keywords in 256 slots
+static constexpr const char* kdbSqlKeywordSlots[] = {
+    "JOIN", "GROUP", "INSERT", "NOT",
+    "TABLE", "END", "COMMIT", "WHEN",
+    "ALL", "FROM", "REFERENCES", "CONSTRAINT",
+    "OR", "DATABASE", "REPLACE", "SIMILAR",
+    "BEFORE", "IS", "LIKE", "DEFAULT",
+    "USING", "UPDATE", "TEMPORARY", "DISTINCT",
+    "CASCADE", "ASC", "INTO", "MATCH",
+    "EXPLAIN", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "OUTER",
+    "FOR", "DROP", nullptr, nullptr,
+    nullptr, nullptr, "BEGIN", "CHECK",
+    "INNER", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "HAVING", nullptr,
+    nullptr, "IN", "CREATE", "THEN",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "ON", "UNION", nullptr, "KEY",
+    "BETWEEN", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "OFFSET", nullptr, nullptr, nullptr,
+    nullptr, nullptr, "LEFT", "WHERE",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "NULL", nullptr,
+    "NATURAL", "BY", "PRIMARY", "FULL",
+    nullptr, "COLLATE", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "DESC",
+    nullptr, nullptr, nullptr, nullptr,
+    "TO", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "RIGHT", nullptr, nullptr, "INDEX",
+    nullptr, "ROLLBACK", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "AFTER", nullptr, nullptr, nullptr,
+    nullptr, "SELECT", nullptr, nullptr,
+    "CROSS", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "AND", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    "TRANSACTION", "UNIQUE", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "ROW", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "INTEGER", nullptr,
+    nullptr, nullptr, "IGNORE", nullptr,
+    nullptr, "DELETE", "LIMIT", "ORDER",
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "RESTRICT",
+    nullptr, "ELSE", "AS", nullptr,
+    nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "XOR",
+    nullptr, "FOREIGN", nullptr, nullptr,
+    nullptr, "SET", nullptr, nullptr,
+    nullptr, "VALUES", "CASE", nullptr,
 };
+
+static constexpr int kdbSqlKeywordDisplacements[] = {
+    -1, -1, -1, -2, -4, -5, -1, 1, 1, -7,
+    2, 1, 1, 2, -1, -1, 1, -1, 1, 1,
+    1, -1, -1, -1, 1, -8, -1, 2, -1, -1,
+    -9, -10, -1, -11, -13, -1, 2, -1, -15, 1,
+    -16, 2, 1, -18, -1, -19, -1, 1, -20, -1,
+    -1, -22, 3, 1, 1, 1, -1, -23, -24, -27,
+    1, -28, -29, 1,
+};
+
+static constexpr KDbKeywordTable kdbSqlKeywordTable = {
+    kdbSqlKeywordSlots, 256, kdbSqlKeywordDisplacements, 64
+};
+
+static_assert(kdbSqlKeywordTable.isValid(), "Invalid keyword table");
+
+const KDbKeywordTable KDbDriverPrivate::kdbSQLKeywords = kdbSqlKeywordTable;
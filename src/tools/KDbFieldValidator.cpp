@@ -37,7 +37,7 @@ KDbFieldValidator::KDbFieldValidator(const KDbField &field, QWidget * parent)
     if (KDbField::isIntegerType(t)) {
         QValidator *validator = nullptr;
         const bool u = field.isUnsigned();
-        int bottom = 0, top = 0;
+        qint64 bottom = 0, top = 0;
         if (t == KDbField::Byte) {
             bottom = u ? 0 : -0x80;
             top = u ? 0xff : 0x7f;
@@ -54,7 +54,7 @@ KDbFieldValidator::KDbFieldValidator(const KDbField &field, QWidget * parent)
         }
 
         if (!validator)
-            validator = new QIntValidator(bottom, top, nullptr); //the default
+            validator = new QIntValidator(static_cast<int>(bottom), static_cast<int>(top), nullptr); //the default
         addSubvalidator(validator);
     } else if (KDbField::isFPNumericType(t)) {
         QValidator *validator;
@@ -25,22 +25,168 @@
 
 #include <QList>
 #include <QPluginLoader>
+#include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QDirIterator>
 #include <QDir>
 #include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QStandardPaths>
 
 Q_GLOBAL_STATIC(KDbJsonTrader, KDbJsonTrader_instance)
 
+//! Version of the plugin index format, increase on incompatible changes
+static const int PLUGIN_INDEX_VERSION = 1;
+
+static qint64 modificationTime(const QFileInfo &info)
+{
+    return info.lastModified().toMSecsSinceEpoch();
+}
+
+//! @return name of the index file for plugin path @a path stored in @a indexDirectory
+static QString indexFileName(const QString &indexDirectory, const QString &path)
+{
+    const QByteArray hash(
+        QCryptographicHash::hash(path.toUtf8(), QCryptographicHash::Md5).toHex());
+    return indexDirectory + QLatin1String("/plugin-index-") + QString::fromLatin1(hash)
+           + QLatin1String(".json");
+}
+
+/*! @return index of plugin path @a path. All files found in the path and its subdirectories
+ are loaded to obtain their metadata. Modification times of the path, its subdirectories
+ and the files are stored so changes can be detected later without loading the files. */
+static QJsonObject scanPath(const QString &path)
+{
+    QJsonObject directories;
+    directories.insert(path, double(modificationTime(QFileInfo(path))));
+    QJsonArray files;
+    QDirIterator dirIter(path, QDir::AllEntries | QDir::NoDotAndDotDot,
+                         QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+    while (dirIter.hasNext()) {
+        dirIter.next();
+        const QFileInfo info(dirIter.fileInfo());
+        if (info.isDir()) {
+            directories.insert(dirIter.filePath(), double(modificationTime(info)));
+        } else if (info.isFile()) {
+            const QPluginLoader loader(dirIter.filePath());
+            QJsonObject file;
+            file.insert(QLatin1String("file"), dirIter.filePath());
+            file.insert(QLatin1String("modified"), double(modificationTime(info)));
+            file.insert(QLatin1String("size"), double(info.size()));
+            // not inserted if there is no metadata, e.g. for non-plugin files
+            file.insert(QLatin1String("metaData"),
+                        loader.metaData().value(QLatin1String("MetaData")));
+            files.append(file);
+        }
+    }
+    QJsonObject index;
+    index.insert(QLatin1String("version"), PLUGIN_INDEX_VERSION);
+    index.insert(QLatin1String("path"), path);
+    index.insert(QLatin1String("directories"), directories);
+    index.insert(QLatin1String("files"), files);
+    return index;
+}
+
+/*! @return true if @a index is an index of plugin path @a path and no directory
+ or file it lists has been modified since the index has been created. Directory
+ modification times change when files or subdirectories are added or removed. */
+static bool isUpToDate(const QJsonObject &index, const QString &path)
+{
+    if (index.value(QLatin1String("version")).toInt() != PLUGIN_INDEX_VERSION
+        || index.value(QLatin1String("path")).toString() != path)
+    {
+        return false;
+    }
+    const QJsonObject directories = index.value(QLatin1String("directories")).toObject();
+    if (!directories.contains(path)) {
+        return false;
+    }
+    for (QJsonObject::ConstIterator it = directories.constBegin();
+         it != directories.constEnd(); ++it)
+    {
+        const QFileInfo info(it.key());
+        if (!info.isDir() || double(modificationTime(info)) != it.value().toDouble()) {
+            return false;
+        }
+    }
+    for (const QJsonValue &value : index.value(QLatin1String("files")).toArray()) {
+        const QJsonObject file = value.toObject();
+        const QFileInfo info(file.value(QLatin1String("file")).toString());
+        if (!info.isFile()
+            || double(modificationTime(info)) != file.value(QLatin1String("modified")).toDouble()
+            || double(info.size()) != file.value(QLatin1String("size")).toDouble())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static QJsonObject readIndex(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QJsonObject();
+    }
+    return QJsonDocument::fromJson(file.readAll()).object();
+}
+
+static void writeIndex(const QString &fileName, const QJsonObject &index)
+{
+    if (!QDir().mkpath(QFileInfo(fileName).absolutePath())) {
+        kdbDebug() << "Could not create directory for plugin index" << fileName;
+        return;
+    }
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)
+        || file.write(QJsonDocument(index).toJson(QJsonDocument::Compact)) == -1
+        || !file.commit())
+    {
+        kdbDebug() << "Could not write plugin index" << fileName << file.errorString();
+    }
+}
+
 class Q_DECL_HIDDEN KDbJsonTrader::Private
 {
 public:
     Private() : pluginPathFound(false)
     {
+        if (qEnvironmentVariableIsEmpty("KDB_NO_PLUGIN_INDEX")) {
+            const QString cacheDir(
+                QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation));
+            if (!cacheDir.isEmpty()) {
+                indexDirectory = cacheDir + QLatin1Char('/')
+                                 + QLatin1String(KDB_BASE_NAME_LOWER);
+            }
+        }
+    }
+
+    //! @return index of plugin path @a path, read from the index file if it is up to date
+    QJsonObject pathIndex(const QString &path)
+    {
+        const QString fileName(indexDirectory.isEmpty() ? QString()
+                                                        : indexFileName(indexDirectory, path));
+        if (!fileName.isEmpty()) {
+            const QJsonObject index = readIndex(fileName);
+            if (isUpToDate(index, path)) {
+                return index;
+            }
+        }
+        ++lastScannedPathCount;
+        const QJsonObject index = scanPath(path);
+        if (!fileName.isEmpty()) {
+            writeIndex(fileName, index);
+        }
+        return index;
     }
+
     bool pluginPathFound;
     QStringList pluginPaths;
+    QString indexDirectory;
+    int lastScannedPathCount = 0;
 private:
     Q_DISABLE_COPY(Private)
 };
@@ -63,13 +209,11 @@ KDbJsonTrader* KDbJsonTrader::self()
     return KDbJsonTrader_instance;
 }
 
-//! Checks loader @a loader
-static bool checkLoader(QPluginLoader *loader, const QString &servicetype,
-                        const QString &mimetype)
+//! Checks plugin metadata @a json
+static bool checkMetaData(const QJsonObject &json, const QString &servicetype,
+                          const QString &mimetype)
 {
-    QJsonObject json = loader->metaData().value(QLatin1String("MetaData")).toObject();
     if (json.isEmpty()) {
-        //kdbDebug() << dirIter.filePath() << "has no json!";
         return false;
     }
     QJsonObject pluginData = json.value(QLatin1String("KPlugin")).toObject();
@@ -90,19 +234,35 @@ static bool checkLoader(QPluginLoader *loader, const QString &servicetype,
     return true;
 }
 
-static QList<QPluginLoader *> findPlugins(const QString &path, const QString &servicetype,
-                                          const QString &mimetype)
+QList<KDbJsonTrader::Plugin> KDbJsonTrader::plugins(const QString &servicetype,
+                                                    const QString &mimetype)
 {
-    QList<QPluginLoader*> list;
-    QDirIterator dirIter(path, QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
-    while (dirIter.hasNext()) {
-        dirIter.next();
-        if (dirIter.fileInfo().isFile()) {
-            QPluginLoader *loader = new QPluginLoader(dirIter.filePath());
-            if (checkLoader(loader, servicetype, mimetype)) {
-                list.append(loader);
-            } else {
-                delete loader;
+    QList<Plugin> list;
+    for (const QStaticPlugin &staticPlugin : QPluginLoader::staticPlugins()) {
+        const QJsonObject json
+            = staticPlugin.metaData().value(QLatin1String("MetaData")).toObject();
+        if (checkMetaData(json, servicetype, mimetype)) {
+            Plugin plugin;
+            plugin.metaData = json;
+            plugin.staticInstance = staticPlugin.instance;
+            list.append(plugin);
+        }
+    }
+
+    if (!d->pluginPathFound) {
+        d->pluginPaths = KDb::libraryPaths();
+    }
+    d->lastScannedPathCount = 0;
+    foreach(const QString &path, d->pluginPaths) {
+        const QJsonObject index = d->pathIndex(path);
+        for (const QJsonValue &value : index.value(QLatin1String("files")).toArray()) {
+            const QJsonObject file = value.toObject();
+            const QJsonObject json = file.value(QLatin1String("metaData")).toObject();
+            if (checkMetaData(json, servicetype, mimetype)) {
+                Plugin plugin;
+                plugin.fileName = file.value(QLatin1String("file")).toString();
+                plugin.metaData = json;
+                list.append(plugin);
             }
         }
     }
@@ -112,13 +272,28 @@ static QList<QPluginLoader *> findPlugins(const QString &path, const QString &se
 QList<QPluginLoader *> KDbJsonTrader::query(const QString &servicetype,
                                             const QString &mimetype)
 {
-    if (!d->pluginPathFound) {
-        d->pluginPaths = KDb::libraryPaths();
-    }
-
     QList<QPluginLoader *> list;
-    foreach(const QString &path, d->pluginPaths) {
-        list += findPlugins(path, servicetype, mimetype);
+    for (const Plugin &plugin : plugins(servicetype, mimetype)) {
+        if (!plugin.fileName.isEmpty()) {
+            list.append(new QPluginLoader(plugin.fileName));
+        }
     }
     return list;
 }
+
+QString KDbJsonTrader::indexDirectory() const
+{
+    return d->indexDirectory;
+}
+
+void KDbJsonTrader::setIndexDirectory(const QString &dir)
+{
+    d->indexDirectory = dir;
+}
+
+#ifdef BUILD_TESTING
+int KDbJsonTrader::lastScannedPathCount() const
+{
+    return d->lastScannedPathCount;
+}
+#endif
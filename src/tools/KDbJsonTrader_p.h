@@ -22,17 +22,42 @@
 #ifndef KDB_JSONTRADER_P_H
 #define KDB_JSONTRADER_P_H
 
+#include <QJsonObject>
 #include <QList>
 #include <QString>
+#include <QtPlugin>
+
+#include "config-kdb.h"
+#include "kdb_export.h"
 
 class QPluginLoader;
 
 /**
  *  Support class to fetch a list of relevant plugins
+ *
+ *  Metadata of plugins found in every plugin path is persisted in an index file stored
+ *  in indexDirectory(). The index is keyed by modification times of the plugin path,
+ *  its subdirectories and files found in them. Subsequent queries only compare the times
+ *  with the index and do not load plugin files unless something has changed.
+ *  Plugins registered at link time using Q_IMPORT_PLUGIN() are found as well.
  */
-class KDbJsonTrader
+class KDB_TESTING_EXPORT KDbJsonTrader
 {
 public:
+    //! Information about a single plugin found by plugins()
+    class Plugin
+    {
+    public:
+        //! File name of the plugin, empty for static plugins
+        QString fileName;
+
+        //! Metadata of the plugin, i.e. contents of the "MetaData" object
+        QJsonObject metaData;
+
+        //! Function returning instance of a static plugin, @c nullptr for plugin files
+        QtPluginInstanceFunction staticInstance = nullptr;
+    };
+
     KDbJsonTrader();
 
     ~KDbJsonTrader();
@@ -61,6 +86,33 @@ public:
      */
      QList<QPluginLoader *> query(const QString &servicetype, const QString &mimetype = QString());
 
+    /**
+     * Like query() but returns plugin metadata instead of plugin loaders.
+     *
+     * Static plugins are returned first, followed by plugin files in order of the plugin
+     * paths. Plugin files are not opened if the persisted index of their path is up to date.
+     */
+    QList<Plugin> plugins(const QString &servicetype, const QString &mimetype = QString());
+
+    /**
+     * @return directory where the plugin index files are stored
+     *
+     * By default it is the "kdb3" subdirectory of the generic cache location. An empty
+     * string is returned if the index is disabled, e.g. because the KDB_NO_PLUGIN_INDEX
+     * environment variable is set.
+     */
+    QString indexDirectory() const;
+
+    //! Sets directory where the plugin index files are stored.
+    //! Empty @a dir disables the index.
+    void setIndexDirectory(const QString &dir);
+
+#ifdef BUILD_TESTING
+    //! @return number of plugin paths that had to be scanned by the recent query because
+    //! their index was missing or out of date
+    int lastScannedPathCount() const;
+#endif
+
 private:
      Q_DISABLE_COPY(KDbJsonTrader)
      class Private;
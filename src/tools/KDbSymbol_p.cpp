@@ -0,0 +1,110 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbSymbol_p.h"
+
+class Q_DECL_HIDDEN KDbSymbol::Data
+{
+public:
+    explicit Data(const QString &n) : name(n) {}
+    const QString name;
+    KDbTableSchema *table = nullptr;
+    KDbQuerySchema *query = nullptr;
+private:
+    Q_DISABLE_COPY(Data)
+};
+
+QString KDbSymbol::name() const
+{
+    return m_data ? m_data->name : QString();
+}
+
+KDbTableSchema* KDbSymbol::table() const
+{
+    return m_data ? m_data->table : nullptr;
+}
+
+void KDbSymbol::setTable(KDbTableSchema *table)
+{
+    if (m_data) {
+        m_data->table = table;
+    }
+}
+
+KDbQuerySchema* KDbSymbol::query() const
+{
+    return m_data ? m_data->query : nullptr;
+}
+
+void KDbSymbol::setQuery(KDbQuerySchema *query)
+{
+    if (m_data) {
+        m_data->query = query;
+    }
+}
+
+//--------------------------------------
+
+KDbSymbolTable::KDbSymbolTable()
+{
+}
+
+KDbSymbolTable::~KDbSymbolTable()
+{
+    clear();
+}
+
+KDbSymbol KDbSymbolTable::intern(const QString &name)
+{
+    if (name.isEmpty()) {
+        return KDbSymbol();
+    }
+    KDbSymbol::Data *data = m_symbols.value(name);
+    if (!data) {
+        data = new KDbSymbol::Data(name);
+        m_symbols.insert(data->name, data);
+    }
+    return KDbSymbol(data);
+}
+
+KDbSymbol KDbSymbolTable::find(const QString &name) const
+{
+    return KDbSymbol(m_symbols.value(name));
+}
+
+void KDbSymbolTable::release(KDbSymbol symbol)
+{
+    KDbSymbol::Data *data = symbol.m_data;
+    if (!data || data->table || data->query) {
+        return;
+    }
+    m_symbols.remove(data->name);
+    delete data;
+}
+
+int KDbSymbolTable::count() const
+{
+    return m_symbols.count();
+}
+
+void KDbSymbolTable::clear()
+{
+    qDeleteAll(m_symbols);
+    m_symbols.clear();
+}
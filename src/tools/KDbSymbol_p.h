@@ -0,0 +1,127 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_SYMBOL_P_H
+#define KDB_SYMBOL_P_H
+
+#include <QHash>
+#include <QString>
+
+#include "config-kdb.h"
+#include "kdb_export.h"
+
+class KDbQuerySchema;
+class KDbTableSchema;
+
+/*! @internal
+ @short Name of a table or query interned in a KDbSymbolTable
+
+ A symbol is bound to the table and query schemas of its name, so once a symbol is
+ found, getting the schema does not need any further hashing. Equal names of a single
+ symbol table are represented by the same symbol; comparing and hashing symbols only
+ compares and hashes pointers.
+
+ Symbols are owned by their KDbSymbolTable and are valid until they are released
+ or the table is destroyed.
+*/
+class KDB_TESTING_EXPORT KDbSymbol
+{
+public:
+    //! Creates a null symbol
+    inline KDbSymbol() : m_data(nullptr) {}
+
+    //! @return true if this is a null symbol
+    inline bool isNull() const { return !m_data; }
+
+    //! @return name of the symbol, empty for null symbol
+    QString name() const;
+
+    //! @return table schema bound to the symbol, @c nullptr if there is no such table
+    //! or the symbol is null
+    KDbTableSchema* table() const;
+
+    //! Binds table schema @a table to the symbol, @c nullptr unbinds the table
+    void setTable(KDbTableSchema *table);
+
+    //! @return query schema bound to the symbol, @c nullptr if there is no such query
+    //! or the symbol is null
+    KDbQuerySchema* query() const;
+
+    //! Binds query schema @a query to the symbol, @c nullptr unbinds the query
+    void setQuery(KDbQuerySchema *query);
+
+    inline bool operator==(const KDbSymbol &other) const { return m_data == other.m_data; }
+
+    inline bool operator!=(const KDbSymbol &other) const { return m_data != other.m_data; }
+
+    //! Symbols are unique so their addresses are used as hash values
+    friend inline uint qHash(const KDbSymbol &symbol, uint seed = 0) {
+        return ::qHash(reinterpret_cast<quintptr>(symbol.m_data), seed);
+    }
+
+    class Data;
+
+private:
+    explicit inline KDbSymbol(Data *data) : m_data(data) {}
+
+    Data *m_data;
+    friend class KDbSymbolTable;
+};
+
+Q_DECLARE_TYPEINFO(KDbSymbol, Q_PRIMITIVE_TYPE);
+
+/*! @internal
+ @short Per-connection table of names of loaded table and query schemas
+
+ Names are interned with intern() only when schemas are loaded or created, so the table
+ does not grow when arbitrary user-provided names are looked up with find(). Symbols
+ that are not bound to any schema anymore should be returned to the table with
+ release(), so the table only contains names of schemas that are currently loaded.
+ The table is not thread-safe, like the connection owning it.
+*/
+class KDB_TESTING_EXPORT KDbSymbolTable
+{
+public:
+    KDbSymbolTable();
+
+    //! Deletes all symbols
+    ~KDbSymbolTable();
+
+    //! @return symbol for @a name, it is created if it does not exist yet.
+    //! Null symbol is returned for empty @a name.
+    KDbSymbol intern(const QString &name);
+
+    //! @return existing symbol for @a name or a null symbol if @a name has not been interned
+    KDbSymbol find(const QString &name) const;
+
+    //! Deletes @a symbol if it is not bound to a table or query schema
+    void release(KDbSymbol symbol);
+
+    //! @return number of symbols
+    int count() const;
+
+    //! Deletes all symbols
+    void clear();
+
+private:
+    QHash<QString, KDbSymbol::Data*> m_symbols;
+    Q_DISABLE_COPY(KDbSymbolTable)
+};
+
+#endif
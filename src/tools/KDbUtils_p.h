@@ -26,7 +26,9 @@
 #ifndef KDB_TOOLS_UTILS_P_H
 #define KDB_TOOLS_UTILS_P_H
 
-#include <QtGlobal>
+#include <QHash>
+#include <QString>
+#include <QVarLengthArray>
 
 #if QT_VERSION < 0x050700
 //! @internal for qAsConst()
@@ -43,6 +45,37 @@ template <typename T>
 void qAsConst(const T &&) Q_DECL_EQ_DELETE;
 #endif // QT_VERSION < 0x050700
 
+/*! @internal @return value for lowercase version of @a name from @a hash having lowercase keys,
+ or @a defaultValue if there is no such key. Equal to hash.value(name.toLower(), defaultValue)
+ but ASCII names are converted on the stack without allocating memory. */
+template <typename T>
+T kdbValueForLowerCaseName(const QHash<QString, T> &hash, const QString &name,
+                           const T &defaultValue = T())
+{
+    const int size = name.size();
+    const QChar *chars = name.constData();
+    bool hasUpper = false;
+    for (int i = 0; i < size; ++i) {
+        const ushort c = chars[i].unicode();
+        if (c >= 0x80) { // non-ASCII: use full case mapping
+            return hash.value(name.toLower(), defaultValue);
+        }
+        if (c >= 'A' && c <= 'Z') {
+            hasUpper = true;
+        }
+    }
+    if (!hasUpper) {
+        return hash.value(name, defaultValue);
+    }
+    QVarLengthArray<QChar, 64> lower(size);
+    for (int i = 0; i < size; ++i) {
+        const ushort c = chars[i].unicode();
+        lower[i] = QChar((c >= 'A' && c <= 'Z') ? ushort(c + ('a' - 'A')) : c);
+    }
+    // no copy of the characters is made
+    return hash.value(QString::fromRawData(lower.constData(), size), defaultValue);
+}
+
 //! @def KDB_SHARED_LIB_EXTENSION operating system-dependent extension for shared library files
 #if defined(Q_OS_WIN)
 #define KDB_SHARED_LIB_EXTENSION ".dll"
@@ -29,13 +29,21 @@
 #include "KDbCursor.h"
 #include "KDbError.h"
 #include "KDb.h"
+#include "KDbExpression.h"
+#include "KDbExpressionEvaluator.h"
+#include "KDbFieldList.h"
+#include "KDbIndexSchema.h"
 #include "KDbOrderByColumn.h"
 #include "KDbQuerySchema.h"
 #include "KDbRecordEditBuffer.h"
+#include "KDbTableSchema.h"
 #include "KDbTableViewColumn.h"
 #include "kdb_debug.h"
 
 #include <QApplication>
+#include <QBitArray>
+
+#include <limits>
 
 #include <unicode/coll.h>
 
@@ -240,6 +248,355 @@ public:
 #undef _IIF
 #undef CAST_AND_COMPARE
 
+//! @internal Sliding window of records used by KDbTableViewData in windowed mode
+/*! Values of the primary key are retrieved for all records, in order defined by
+ the query or by sorting, and are kept in memory. Records are fetched page by page on
+ demand and the least recently used pages are deleted. @see KDbTableViewData::setWindowed() */
+class KDbTableViewDataWindow
+{
+public:
+    KDbTableViewDataWindow(KDbCursor *cursor, KDbField *keyField, int keyColumn,
+                           int recordSize, int pageSize, int maxCachedPages)
+            : m_cursor(cursor)
+            , m_keyField(keyField)
+            , m_keyColumn(keyColumn)
+            , m_recordSize(recordSize)
+            , m_pageSize(pageSize)
+            , m_maxCachedPages(maxCachedPages)
+    {
+    }
+
+    ~KDbTableViewDataWindow() {
+        clear();
+    }
+
+    //! Sets field used for sorting at the backend. If @a field is @c nullptr, order defined
+    //! by the query is used. All the cached records are removed.
+    void setSorting(KDbField *field, KDbOrderByColumn::SortOrder order) {
+        m_sortField = field;
+        m_sortOrder = order;
+        clear();
+    }
+
+    int count() {
+        if (m_count < 0) {
+            m_count = m_cursor->connection()->recordCount(m_cursor->query(),
+                                                          m_cursor->queryParameters());
+            if (m_count < 0) {
+                kdbWarning() << "Could not count records";
+                m_count = 0;
+            }
+        }
+        return m_count;
+    }
+
+    KDbRecordData* at(int index) {
+        if (index < 0 || index >= count()) {
+            return nullptr;
+        }
+        const Page *p = page(index / m_pageSize);
+        return p ? p->value(index % m_pageSize) : nullptr;
+    }
+
+    //! @return index of @a record. Cached records are found by pointer, other records,
+    //! e.g. copies of records that have been dropped from the cache, are found by key.
+    int indexOf(const KDbRecordData *record) {
+        for (QHash<int, Page*>::ConstIterator it = m_pages.constBegin(); it != m_pages.constEnd(); ++it) {
+            const int index = it.value()->indexOf(const_cast<KDbRecordData*>(record));
+            if (index != -1) {
+                return it.key() * m_pageSize + index;
+            }
+        }
+        if (m_keyColumn >= record->count() || record->at(m_keyColumn).isNull()) {
+            return -1;
+        }
+        if (m_keyIndices.isEmpty()) {
+            for (int i = 0; i < m_keys.count(); ++i) {
+                m_keyIndices.insert(m_keys.at(i).toString(), i);
+            }
+        }
+        return m_keyIndices.value(record->at(m_keyColumn).toString(), -1);
+    }
+
+    //! Removes record at @a index, e.g. after it has been deleted at the backend.
+    void removeAt(int index) {
+        removeAll(QList<int>() << index);
+    }
+
+    //! Removes records at @a indices, in ascending order.
+    //! Cached pages starting from the one that contains the first record are removed.
+    void removeAll(const QList<int> &indices) {
+        if (indices.isEmpty() || !fetchKeys(indices.last() + 1)) {
+            return;
+        }
+        int removed = 0;
+        for (QList<int>::ConstReverseIterator it = indices.crbegin(); it != indices.crend(); ++it) {
+            if (*it >= 0 && *it < m_keys.count()) {
+                m_keys.remove(*it);
+                ++removed;
+            }
+        }
+        if (m_count > 0) {
+            m_count = qMax(0, m_count - removed);
+        }
+        m_keyIndices.clear();
+        removePagesFrom(indices.first() / m_pageSize);
+    }
+
+    /*! Inserts @a record at @a index, the window takes ownership of the record.
+     All the keys are retrieved first, so keys returned by the backend later do not
+     duplicate the key of the inserted record. The record is stored in its page,
+     cached pages that follow it are removed. */
+    bool insert(int index, KDbRecordData *record) {
+        if (!fetchKeys(std::numeric_limits<int>::max())) {
+            return false;
+        }
+        index = qBound(0, index, m_keys.count());
+        const int pageNumber = index / m_pageSize;
+        Page *p = page(pageNumber);
+        if (!p) {
+            if (index < m_keys.count()) {
+                return false;
+            }
+            // index is at the end of the last page, start a new page
+            p = new Page;
+            cachePage(pageNumber, p);
+        }
+        p->insert(index % m_pageSize, record);
+        if (p->count() > m_pageSize) { // the last record belongs to the next page now
+            delete p->takeLast();
+        }
+        removePagesFrom(pageNumber + 1);
+        m_keys.insert(index, record->at(m_keyColumn));
+        m_keyIndices.clear();
+        m_count = m_keys.count();
+        return true;
+    }
+
+    //! Updates key of the record at @a index after the @a record has been saved
+    void updateKey(int index, const KDbRecordData &record) {
+        if (index >= 0 && index < m_keys.count()) {
+            m_keys[index] = record.at(m_keyColumn);
+            m_keyIndices.clear();
+        }
+    }
+
+    //! Removes all cached keys and records, they will be retrieved again on demand.
+    void clear() {
+        closeKeysCursor();
+        m_keys.clear();
+        m_keyIndices.clear();
+        m_keysFetched = false;
+        m_count = -1;
+        removePagesFrom(0);
+    }
+
+private:
+    typedef QVector<KDbRecordData*> Page;
+
+    bool openKeysCursor() {
+        KDbQuerySchema *query = m_cursor->query();
+        m_keysQuery = new KDbQuerySchema;
+        if (!m_keysQuery->addField(m_keyField)) {
+            closeKeysCursor();
+            return false;
+        }
+        if (!query->whereExpression().isNull()
+            && !m_keysQuery->setWhereExpression(query->whereExpression()))
+        {
+            closeKeysCursor();
+            return false;
+        }
+        KDbOrderByColumnList orderBy;
+        if (m_sortField) {
+            orderBy.appendField(m_sortField, m_sortOrder);
+        } else {
+            for (QList<KDbOrderByColumn*>::ConstIterator it(query->orderByColumnList()->constBegin());
+                 it != query->orderByColumnList()->constEnd(); ++it)
+            {
+                KDbField *field = (*it)->column() ? (*it)->column()->field() : (*it)->field();
+                if (field && field->table() == m_keyField->table()) {
+                    orderBy.appendField(field, (*it)->sortOrder());
+                }
+            }
+        }
+        // the key makes the order stable for equal values of the sorted field
+        orderBy.appendField(m_keyField);
+        m_keysQuery->setOrderByColumnList(orderBy);
+        m_keysCursor = m_cursor->connection()->executeQuery(m_keysQuery, m_cursor->queryParameters());
+        if (!m_keysCursor
+            || (!m_keysCursor->moveFirst() && m_keysCursor->result().isError()))
+        {
+            closeKeysCursor();
+            return false;
+        }
+        return true;
+    }
+
+    void closeKeysCursor() {
+        if (m_keysCursor) {
+            m_cursor->connection()->deleteCursor(m_keysCursor);
+            m_keysCursor = nullptr;
+        }
+        delete m_keysQuery;
+        m_keysQuery = nullptr;
+    }
+
+    //! Retrieves keys until there are at least @a count of them or there are no more keys.
+    bool fetchKeys(int count) {
+        if (m_keys.count() >= count || m_keysFetched) {
+            return true;
+        }
+        if (!m_keysCursor && !openKeysCursor()) {
+            return false;
+        }
+        m_keyIndices.clear();
+        while (m_keys.count() < count && !m_keysCursor->eof()) {
+            m_keys.append(m_keysCursor->value(0));
+            if (!m_keysCursor->moveNext() && m_keysCursor->result().isError()) {
+                closeKeysCursor();
+                return false;
+            }
+        }
+        if (m_keysCursor->eof()) {
+            closeKeysCursor();
+            m_keysFetched = true;
+            m_count = m_keys.count(); // the backend could change since count() was called
+        }
+        return true;
+    }
+
+    //! @return "key = value1 OR key = value2 ..." expression for keys from @a from to @a to - 1
+    //! Balanced tree of OR expressions is created to keep depth of the tree low.
+    KDbExpression keysExpression(int from, int to) const {
+        if (to - from > 1) {
+            const int middle = from + (to - from) / 2;
+            return KDbBinaryExpression(keysExpression(from, middle), KDbToken::OR,
+                                       keysExpression(middle, to));
+        }
+        const QVariant value(m_keys.at(from));
+        KDbToken token;
+        if (value.isNull()) {
+            token = KDbToken::SQL_NULL;
+        } else if (KDbField::isIntegerType(m_keyField->type())) {
+            token = KDbToken::INTEGER_CONST;
+        } else if (KDbField::isFPNumericType(m_keyField->type())) {
+            token = KDbToken::REAL_CONST;
+        } else {
+            token = KDbToken::CHARACTER_STRING_LITERAL;
+        }
+        return KDbBinaryExpression(
+            KDbConstExpression(token, value), '=',
+            KDbVariableExpression(m_keyField->table()->name() + QLatin1Char('.') + m_keyField->name()));
+    }
+
+    //! @return page @a pageNumber, fetches it if needed
+    Page* page(int pageNumber) {
+        Page *p = m_pages.value(pageNumber);
+        if (p) {
+            m_recentPages.removeOne(pageNumber);
+            m_recentPages.prepend(pageNumber);
+            return p;
+        }
+        const int from = pageNumber * m_pageSize;
+        if (!fetchKeys(from + m_pageSize) || m_keys.count() <= from) {
+            return nullptr;
+        }
+        const int to = qMin(from + m_pageSize, m_keys.count());
+        KDbConnection *conn = m_cursor->connection();
+        KDbQuerySchema *query = m_cursor->query();
+        KDbQuerySchema pageQuery(*query, conn);
+        KDbExpression where = KDbUnaryExpression('(', keysExpression(from, to));
+        if (!query->whereExpression().isNull()) {
+            where = KDbBinaryExpression(KDbUnaryExpression('(', query->whereExpression()),
+                                        KDbToken::AND, where);
+        }
+        if (!pageQuery.setWhereExpression(where)) {
+            return nullptr;
+        }
+        KDbCursor *cursor = conn->executeQuery(&pageQuery, m_cursor->queryParameters());
+        if (!cursor) {
+            return nullptr;
+        }
+        QHash<QString, int> positions;
+        for (int i = from; i < to; ++i) {
+            positions.insert(m_keys.at(i).toString(), i - from);
+        }
+        p = new Page(to - from, nullptr);
+        if (cursor->moveFirst() || !cursor->result().isError()) {
+            while (!cursor->eof()) {
+                KDbRecordData *record = cursor->storeCurrentRecord();
+                if (!record) {
+                    break;
+                }
+                const int position = positions.value(record->at(m_keyColumn).toString(), -1);
+                if (position >= 0 && !p->at(position)) {
+                    (*p)[position] = record;
+                } else {
+                    delete record;
+                }
+                if (!cursor->moveNext()) {
+                    break;
+                }
+            }
+        }
+        conn->deleteCursor(cursor);
+        // records removed at the backend in the meantime are replaced by empty ones
+        for (int i = 0; i < p->count(); ++i) {
+            if (!p->at(i)) {
+                (*p)[i] = new KDbRecordData(m_recordSize);
+            }
+        }
+        cachePage(pageNumber, p);
+        return p;
+    }
+
+    //! Adds page @a p as the most recently used one, removes the least recently used pages
+    void cachePage(int pageNumber, Page *p) {
+        m_pages.insert(pageNumber, p);
+        m_recentPages.prepend(pageNumber);
+        while (m_recentPages.count() > m_maxCachedPages) {
+            removePage(m_recentPages.takeLast());
+        }
+    }
+
+    void removePage(int pageNumber) {
+        Page *p = m_pages.take(pageNumber);
+        if (p) {
+            qDeleteAll(*p);
+            delete p;
+        }
+    }
+
+    void removePagesFrom(int pageNumber) {
+        for (QList<int>::Iterator it = m_recentPages.begin(); it != m_recentPages.end();) {
+            if (*it >= pageNumber) {
+                removePage(*it);
+                it = m_recentPages.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    KDbCursor * const m_cursor;
+    KDbField * const m_keyField;
+    const int m_keyColumn; //!< index of the key within records
+    const int m_recordSize;
+    const int m_pageSize;
+    const int m_maxCachedPages;
+    KDbField *m_sortField = nullptr;
+    KDbOrderByColumn::SortOrder m_sortOrder = KDbOrderByColumn::SortOrder::Ascending;
+    KDbQuerySchema *m_keysQuery = nullptr;
+    KDbCursor *m_keysCursor = nullptr;
+    QVector<QVariant> m_keys;
+    QHash<QString, int> m_keyIndices; //!< indices of keys, built on demand by indexOf()
+    bool m_keysFetched = false; //!< true if all the keys have been retrieved
+    int m_count = -1; //!< cached number of records, -1 if unknown
+    QHash<int, Page*> m_pages;
+    QList<int> m_recentPages; //!< numbers of cached pages, most recently used first
+};
+
 //! @internal
 class Q_DECL_HIDDEN KDbTableViewData::Private
 {
@@ -253,11 +610,56 @@ public:
             , readOnly(false)
             , insertingEnabled(true)
             , containsRecordIdInfo(false)
-            , autoIncrementedColumn(-2) {
+            , autoIncrementedColumn(-2)
+            , window(nullptr) {
     }
 
     ~Private() {
         delete pRecordEditBuffer;
+        delete window;
+        delete filter;
+    }
+
+    //! @return position of @a index within filteredIndices, or position at which
+    //! it would be inserted if it is not there
+    int filterPosition(int index) const {
+        return std::lower_bound(filteredIndices.constBegin(), filteredIndices.constEnd(), index)
+                - filteredIndices.constBegin();
+    }
+
+    //! Updates filteredIndices after inserting @a record at @a index
+    void filterRecordInserted(int index, const KDbRecordData &record) {
+        const int position = filterPosition(index);
+        for (int i = position; i < filteredIndices.count(); ++i) {
+            filteredIndices[i]++;
+        }
+        if (filter->matches(record)) {
+            filteredIndices.insert(position, index);
+        }
+    }
+
+    //! Updates filteredIndices before removing record at @a index
+    void filterRecordRemoved(int index) {
+        int position = filterPosition(index);
+        if (position < filteredIndices.count() && filteredIndices.at(position) == index) {
+            filteredIndices.remove(position);
+        }
+        for (int i = position; i < filteredIndices.count(); ++i) {
+            filteredIndices[i]--;
+        }
+    }
+
+    //! Updates filteredIndices after @a record at @a index has been changed
+    void filterRecordUpdated(int index, const KDbRecordData &record) {
+        const int position = filterPosition(index);
+        const bool found = position < filteredIndices.count()
+                && filteredIndices.at(position) == index;
+        const bool matches = filter->matches(record);
+        if (matches && !found) {
+            filteredIndices.insert(position, index);
+        } else if (!matches && found) {
+            filteredIndices.remove(position);
+        }
     }
 
     //! Number of physical columns
@@ -300,6 +702,15 @@ public:
     bool containsRecordIdInfo;
 
     mutable int autoIncrementedColumn;
+
+    //! Set in windowed mode, @see KDbTableViewData::setWindowed()
+    KDbTableViewDataWindow *window;
+
+    //! Set if filter is set, @see KDbTableViewData::setFilter()
+    KDbExpressionEvaluator *filter = nullptr;
+
+    //! Indices of records matching the filter, in ascending order
+    QVector<int> filteredIndices;
 };
 
 //-------------------------------
@@ -537,7 +948,7 @@ void KDbTableViewData::setSorting(int column, KDbOrderByColumn::SortOrder order)
     const KDbQueryColumnInfo* visibleLookupColumnInfo = tvcol->visibleLookupColumnInfo();
     const KDbField *field = visibleLookupColumnInfo ? visibleLookupColumnInfo->field() : tvcol->field();
     d->sortColumn = column;
-    d->realSortColumn = tvcol->columnInfo()->indexForVisibleLookupValue() != -1
+    d->realSortColumn = tvcol->columnInfo() && tvcol->columnInfo()->indexForVisibleLookupValue() != -1
                           ? tvcol->columnInfo()->indexForVisibleLookupValue() : d->sortColumn;
 
     // setup compare functor
@@ -558,10 +969,145 @@ KDbOrderByColumn::SortOrder KDbTableViewData::sortOrder() const
 
 void KDbTableViewData::sort()
 {
+    if (d->window) {
+        // sorting by columns of the master table is performed at the backend
+        const KDbTableViewColumn *tvcol = d->columns.value(d->sortColumn);
+        KDbField *field = tvcol ? tvcol->field() : nullptr;
+        if (field && (tvcol->visibleLookupColumnInfo()
+                      || field->table() != d->cursor->query()->masterTable()))
+        {
+            kdbWarning() << "Sorting by column" << d->sortColumn
+                         << "is not supported in windowed mode";
+            field = nullptr;
+        }
+        d->window->setSorting(field, d->sortOrder);
+        return;
+    }
     if (d->sortColumn < 0 || d->sortColumn >= d->columns.count()) {
         return;
     }
-    std::sort(begin(), end(), d->lessThanFunctor);
+    if (!d->filter) {
+        std::sort(begin(), end(), d->lessThanFunctor);
+        return;
+    }
+    // compute a single permutation and apply it to both records and filtered indices
+    const int c = KDbTableViewDataBase::count();
+    QVector<int> order(c);
+    for (int i = 0; i < c; i++) {
+        order[i] = i;
+    }
+    const QList<KDbRecordData*> records(*this);
+    LessThanFunctor *lessThan = &d->lessThanFunctor;
+    std::sort(order.begin(), order.end(), [&records, lessThan](int left, int right) {
+        return (*lessThan)(records.at(left), records.at(right));
+    });
+    QBitArray matching(c);
+    for (int index : d->filteredIndices) {
+        matching.setBit(index);
+    }
+    d->filteredIndices.clear();
+    for (int i = 0; i < c; i++) {
+        KDbTableViewDataBase::operator[](i) = records.at(order.at(i));
+        if (matching.testBit(order.at(i))) {
+            d->filteredIndices.append(i);
+        }
+    }
+}
+
+bool KDbTableViewData::setFilter(const KDbExpression &expr, const QList<QVariant> &parameters)
+{
+    d->result.clear();
+    if (expr.isNull()) {
+        clearFilter();
+        return true;
+    }
+    if (d->window) {
+        d->result.success = false;
+        d->result.message = tr("Filtering is not available in windowed mode.");
+        return false;
+    }
+    KDbExpressionEvaluator *filter = new KDbExpressionEvaluator;
+    bool ok;
+    if (d->cursor && d->cursor->query()) {
+        ok = filter->compile(expr, d->cursor->query()->fieldsExpanded(
+                                 d->cursor->connection(),
+                                 KDbQuerySchema::FieldsExpandedMode::WithInternalFields),
+                             parameters);
+    } else {
+        KDbFieldList fields(false /* !owner */);
+        for (KDbTableViewColumn *col : d->columns) {
+            fields.addField(col->field());
+        }
+        ok = filter->compile(expr, fields, parameters);
+    }
+    if (!ok) {
+        d->result.success = false;
+        d->result.message = tr("Could not set filter.");
+        d->result.description = filter->result().message();
+        delete filter;
+        return false;
+    }
+    delete d->filter;
+    d->filter = filter;
+    const QBitArray matching = d->filter->filter(*this);
+    d->filteredIndices.clear();
+    d->filteredIndices.reserve(matching.count(true));
+    for (int i = 0; i < matching.size(); i++) {
+        if (matching.testBit(i)) {
+            d->filteredIndices.append(i);
+        }
+    }
+    return true;
+}
+
+void KDbTableViewData::clearFilter()
+{
+    delete d->filter;
+    d->filter = nullptr;
+    d->filteredIndices.clear();
+}
+
+KDbExpression KDbTableViewData::filter() const
+{
+    return d->filter ? d->filter->expression() : KDbExpression();
+}
+
+bool KDbTableViewData::isFiltered() const
+{
+    return d->filter;
+}
+
+int KDbTableViewData::filteredCount() const
+{
+    return d->filter ? d->filteredIndices.count() : count();
+}
+
+KDbRecordData* KDbTableViewData::filteredAt(int position)
+{
+    if (!d->filter) {
+        return (position >= 0 && position < count()) ? at(position) : nullptr;
+    }
+    const int index = d->filteredIndices.value(position, -1);
+    return index >= 0 ? KDbTableViewDataBase::at(index) : nullptr;
+}
+
+QVector<int> KDbTableViewData::filteredIndices() const
+{
+    return d->filteredIndices;
+}
+
+void KDbTableViewData::filterRecordInserted(int index)
+{
+    if (d->filter) {
+        d->filterRecordInserted(index, *KDbTableViewDataBase::at(index));
+    }
+}
+
+void KDbTableViewData::filterRecordRemoved(int index)
+{
+    if (d->filter && index >= 0) {
+        d->filterRecordRemoved(index);
+    }
 }
 
 void KDbTableViewData::setReadOnly(bool set)
@@ -767,6 +1313,16 @@ bool KDbTableViewData::saveRecordChanges(KDbRecordData *record, bool repaint)
         return false;
 
     if (saveRecord(record, false /*update*/, repaint)) {
+        if (d->filter || d->window) {
+            const int index = indexOf(record);
+            if (index != -1) {
+                if (d->window) {
+                    d->window->updateKey(index, *record);
+                } else {
+                    d->filterRecordUpdated(index, *record);
+                }
+            }
+        }
         emit recordUpdated(record);
         return true;
     }
@@ -781,6 +1337,17 @@ bool KDbTableViewData::saveNewRecord(KDbRecordData *record, bool repaint)
         return false;
 
     if (saveRecord(record, true /*insert*/, repaint)) {
+        // the record is usually already inserted using insertRecord(), now it has values
+        if (d->filter || d->window) {
+            const int index = indexOf(record);
+            if (index != -1) {
+                if (d->window) {
+                    d->window->updateKey(index, *record);
+                } else {
+                    d->filterRecordUpdated(index, *record);
+                }
+            }
+        }
         emit recordInserted(record, repaint);
         return true;
     }
@@ -812,7 +1379,12 @@ bool KDbTableViewData::deleteRecord(KDbRecordData *record, bool repaint)
         d->result.success = false;
         return false;
     }
-    removeAt(index);
+    if (d->window) {
+        d->window->removeAt(index);
+    } else {
+        filterRecordRemoved(index);
+        removeAt(index);
+    }
     emit recordDeleted();
     return true;
 }
@@ -823,37 +1395,107 @@ void KDbTableViewData::deleteRecords(const QList<int> &recordsToDelete, bool rep
 
     if (recordsToDelete.isEmpty())
         return;
-    int last_r = 0;
-    KDbTableViewDataIterator it(begin());
-    for (QList<int>::ConstIterator r_it = recordsToDelete.constBegin(); r_it != recordsToDelete.constEnd(); ++r_it) {
-        for (; last_r < (*r_it); last_r++)
-            ++it;
-        it = erase(it);   /* this will delete *it */
-        last_r++;
+    const int c = count();
+    QBitArray toDelete(c);
+    for (int r : recordsToDelete) {
+        if (r >= 0 && r < c) {
+            toDelete.setBit(r);
+        }
+    }
+    if (d->window) {
+        QList<int> deletedIndices;
+        for (int i = 0; i < c; i++) {
+            if (toDelete.testBit(i)) {
+                deletedIndices.append(i);
+            }
+        }
+        if (deletedIndices.isEmpty())
+            return;
+        d->window->removeAll(deletedIndices);
+        emit recordsDeleted(deletedIndices);
+        return;
+    }
+    // compact the list in a single pass, then delete the records at once
+    QList<int> deletedIndices;
+    QVector<KDbRecordData*> deletedRecords;
+    deletedRecords.reserve(toDelete.count(true));
+    int newCount = 0;
+    for (int i = 0; i < c; i++) {
+        KDbRecordData *record = KDbTableViewDataBase::at(i);
+        if (toDelete.testBit(i)) {
+            deletedIndices.append(i);
+            deletedRecords.append(record);
+        } else {
+            if (newCount != i) {
+                KDbTableViewDataBase::operator[](newCount) = record;
+            }
+            newCount++;
+        }
+    }
+    if (deletedRecords.isEmpty())
+        return;
+    // the tail contains pointers that are kept elsewhere now, so do not autodelete them
+    QList<KDbRecordData*>::erase(KDbTableViewDataBase::begin() + newCount,
+                                 KDbTableViewDataBase::end());
+    qDeleteAll(deletedRecords);
+    if (d->filter) {
+        // shift remaining filtered indices by the number of deleted records preceding them
+        int deletedBefore = 0;
+        int newFilteredCount = 0;
+        QList<int>::ConstIterator deletedIt = deletedIndices.constBegin();
+        for (int index : d->filteredIndices) {
+            while (deletedIt != deletedIndices.constEnd() && *deletedIt < index) {
+                ++deletedIt;
+                ++deletedBefore;
+            }
+            if (!toDelete.testBit(index)) {
+                d->filteredIndices[newFilteredCount++] = index - deletedBefore;
+            }
+        }
+        d->filteredIndices.resize(newFilteredCount);
     }
 //DON'T CLEAR BECAUSE KexiTableViewPropertyBuffer will clear BUFFERS!
 //--> emit reloadRequested(); //! \todo more effective?
-    emit recordsDeleted(recordsToDelete);
+    emit recordsDeleted(deletedIndices);
 }
 
 void KDbTableViewData::insertRecord(KDbRecordData *record, int index, bool repaint)
 {
-    insert(index = qMin(index, count()), record);
+    index = qMin(index, count());
+    if (d->window) {
+        if (!d->window->insert(index, record)) {
+            kdbWarning() << "Could not insert record at" << index << "in windowed mode";
+            delete record;
+            return;
+        }
+        emit recordInserted(record, index, repaint);
+        return;
+    }
+    insert(index, record);
+    filterRecordInserted(index);
     emit recordInserted(record, index, repaint);
 }
 
 void KDbTableViewData::clearInternal(bool processEvents)
 {
     clearRecordEditBuffer();
-//! @todo this is time consuming: find better data model
-    const int c = count();
+    if (d->window) {
+        d->window->clear();
+    }
+    // detach all records at once so the data is consistent while events are processed
+    const QList<KDbRecordData*> records(*this);
+    QList<KDbRecordData*>::clear();
+    d->filteredIndices.clear();
 #ifndef TABLEVIEW_NO_PROCESS_EVENTS
     const bool _processEvents = processEvents && !qApp->closingDown();
+#else
+    Q_UNUSED(processEvents)
 #endif
+    const int c = records.count();
     for (int i = 0; i < c; i++) {
-        removeLast();
+        delete records.at(i);
 #ifndef TABLEVIEW_NO_PROCESS_EVENTS
-        if (_processEvents && i % 1000 == 0)
+        if (_processEvents && i % 10000 == 0)
             qApp->processEvents(QEventLoop::AllEvents, 1);
 #endif
     }
@@ -919,6 +1561,85 @@ bool KDbTableViewData::preloadAllRecords()
     return true;
 }
 
+bool KDbTableViewData::setWindowed(int pageSize, int maxCachedPages)
+{
+    if (d->window) {
+        return true;
+    }
+    if (!d->cursor || !d->cursor->query() || pageSize < 1 || maxCachedPages < 1) {
+        return false;
+    }
+    KDbQuerySchema *query = d->cursor->query();
+    KDbTableSchema *table = query->masterTable();
+    if (!table || query->tables()->count() != 1) {
+        kdbWarning() << "Windowed mode requires a query based on a single table";
+        return false;
+    }
+    KDbIndexSchema *pkey = table->primaryKey();
+    if (!pkey || pkey->fieldCount() != 1) {
+        kdbWarning() << "Windowed mode requires a single-field primary key";
+        return false;
+    }
+    KDbField *keyField = pkey->field(0);
+    const KDbQueryColumnInfo::Vector fields = query->fieldsExpanded(d->cursor->connection());
+    int keyColumn = -1;
+    for (int i = 0; i < fields.count(); ++i) {
+        if (fields[i]->field() == keyField) {
+            keyColumn = i;
+            break;
+        }
+    }
+    if (keyColumn == -1) {
+        kdbWarning() << "Windowed mode requires primary key" << keyField->name()
+                     << "to be present in the query";
+        return false;
+    }
+    clearInternal(false /* !processEvents */);
+    clearFilter();
+    d->window = new KDbTableViewDataWindow(d->cursor, keyField, keyColumn, d->realColumnCount,
+                                           pageSize, maxCachedPages);
+    return true;
+}
+
+bool KDbTableViewData::isWindowed() const
+{
+    return d->window != nullptr;
+}
+
+KDbRecordData* KDbTableViewData::at(int index)
+{
+    return d->window ? d->window->at(index) : KDbTableViewDataBase::at(index);
+}
+
+int KDbTableViewData::count() const
+{
+    return d->window ? d->window->count() : KDbTableViewDataBase::count();
+}
+
+bool KDbTableViewData::isEmpty() const
+{
+    return d->window ? d->window->count() == 0 : KDbTableViewDataBase::isEmpty();
+}
+
+KDbRecordData* KDbTableViewData::first()
+{
+    return d->window ? d->window->at(0) : KDbTableViewDataBase::first();
+}
+
+KDbRecordData* KDbTableViewData::last()
+{
+    return d->window ? d->window->at(d->window->count() - 1) : KDbTableViewDataBase::last();
+}
+
+int KDbTableViewData::indexOf(const KDbRecordData* record, int from) const
+{
+    if (d->window) {
+        const int index = d->window->indexOf(record);
+        return index >= from ? index : -1;
+    }
+    return KDbTableViewDataBase::indexOf(const_cast<KDbRecordData*>(record), from);
+}
+
 bool KDbTableViewData::isReadOnly() const
 {
     return d->readOnly || (d->cursor && d->cursor->connection()->options()->isReadOnly());
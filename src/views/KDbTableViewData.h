@@ -32,6 +32,7 @@
 #include "KDbOrderByColumn.h"
 
 class KDbCursor;
+class KDbExpression;
 class KDbRecordEditBuffer;
 class KDbResultInfo;
 class KDbTableViewColumn;
@@ -75,6 +76,31 @@ public:
     /*! Preloads all records provided by cursor (only for db-aware version). */
     bool preloadAllRecords();
 
+    /*! Switches db-aware data to windowed mode, an alternative to preloadAllRecords()
+     for large tables. Instead of keeping all records in memory, only primary key values
+     of the records are retrieved. Note that the key values of all the records are kept
+     in memory. Records are fetched on demand, in pages of @a pageSize records, using
+     queries that select them by key. At most @a maxCachedPages pages are kept,
+     the least recently used pages are deleted first.
+     In windowed mode count() is provided by the backend and sort() is performed by
+     the backend too, using ORDER BY.
+
+     Windowed mode is only available if the cursor's query is based on a single table
+     having a single-field primary key that is present in the query's columns.
+     Iterators such as begin() and end() are not available in windowed mode and pointers
+     returned by at() are only valid until the page containing the record is dropped
+     from the cache. indexOf() finds records that are not cached anymore by their keys.
+
+     Any records loaded before are removed.
+     @return true on success or if the windowed mode is already enabled.
+     @since 3.3 */
+    bool setWindowed(int pageSize = 256, int maxCachedPages = 16);
+
+    /*! @return true if windowed mode is enabled for this data.
+     @see setWindowed()
+     @since 3.3 */
+    bool isWindowed() const;
+
     /*! Sets sorting for @a column. If @a column is -1, sorting is disabled. */
     void setSorting(int column, KDbOrderByColumn::SortOrder order = KDbOrderByColumn::SortOrder::Ascending);
 
@@ -88,9 +114,62 @@ public:
      (by default it is not). */
     KDbOrderByColumn::SortOrder sortOrder() const;
 
-    //! Sorts this data using previously set order.
+    /*! Sorts this data using previously set order.
+     If a filter is set, the permutation computed for sorting is applied to the records
+     and to the indices of filtered records at once, so the filter is not re-evaluated. */
     void sort();
 
+    /*! Sets filter for this data to @a expr. Only records for which @a expr is true are
+     available through filteredCount(), filteredAt() and filteredIndices(), all the records
+     are still available through count() and at().
+     The expression is compiled using KDbExpressionEvaluator and evaluated on the client side,
+     without re-executing the query. Names of variables in @a expr refer to the query columns
+     (db-aware data) or to fields of columns (non-db-aware data). Values of query parameters
+     are taken from @a parameters.
+
+     Indices of matching records are updated incrementally when records are inserted, updated
+     or deleted using methods of this class: only the affected records are evaluated.
+     Records modified directly, e.g. using iterators, are not re-evaluated; call setFilter()
+     again in this case.
+
+     If @a expr is null, the filter is removed, what is equivalent to clearFilter().
+     Filtering is not available in windowed mode.
+     Presenters are not reloaded automatically, use reload() if needed.
+     @return true on success. On failure result() contains error information
+     and previous filter is kept.
+     @see KDbExpressionEvaluator
+     @since 3.3 */
+    bool setFilter(const KDbExpression &expr, const QList<QVariant> &parameters = QList<QVariant>());
+
+    /*! Removes filter set by setFilter().
+     @since 3.3 */
+    void clearFilter();
+
+    /*! @return expression of the filter set by setFilter() or null expression
+     if there is no filter.
+     @since 3.3 */
+    KDbExpression filter() const;
+
+    /*! @return true if filter is set for this data.
+     @since 3.3 */
+    bool isFiltered() const;
+
+    /*! @return number of records matching the filter.
+     If there is no filter, count() is returned.
+     @since 3.3 */
+    int filteredCount() const;
+
+    /*! @return record at position @a position among records matching the filter,
+     @c nullptr if @a position is out of range.
+     If there is no filter, at() is returned.
+     @since 3.3 */
+    KDbRecordData* filteredAt(int position);
+
+    /*! @return indices (as used by at()) of records matching the filter, in ascending order.
+     Empty vector is returned if there is no filter.
+     @since 3.3 */
+    QVector<int> filteredIndices() const;
+
     /*! Adds column @a col.
      Warning: @a col will be owned by this object, and deleted on its destruction. */
     void addColumn(KDbTableViewColumn* col);
@@ -192,7 +271,8 @@ public:
     bool deleteRecord(KDbRecordData *record, bool repaint = false);
 
     /*! Deletes records (by number) passed with @a recordsToDelete.
-     Currently, this method is only for non data-aware tables. */
+     Currently, this method is only for non data-aware tables and for windowed mode,
+     where the records are removed from the window only. */
     void deleteRecords(const QList<int> &recordsToDelete, bool repaint = false);
 
     /*! Deletes all records. Works either for db-aware and non db-aware tables.
@@ -230,35 +310,36 @@ public:
         emit reloadRequested();
     }
 
-    inline KDbRecordData* at(int index) {
-        return KDbTableViewDataBase::at(index);
-    }
-    inline virtual int count() const {
-        return KDbTableViewDataBase::count();
-    }
-    inline bool isEmpty() const {
-        return KDbTableViewDataBase::isEmpty();
-    }
-    inline KDbRecordData* first() {
-        return KDbTableViewDataBase::first();
-    }
-    inline KDbRecordData* last() {
-        return KDbTableViewDataBase::last();
-    }
-    inline int indexOf(const KDbRecordData* record, int from = 0) const {
-        return KDbTableViewDataBase::indexOf(const_cast<KDbRecordData*>(record), from);
-    }
+    //! @return record at @a index. In windowed mode the record is fetched if needed.
+    KDbRecordData* at(int index);
+
+    //! @return number of records. In windowed mode the number is provided by the backend.
+    virtual int count() const;
+
+    bool isEmpty() const;
+
+    KDbRecordData* first();
+
+    KDbRecordData* last();
+
+    //! @return index of @a record or -1 if not found.
+    //! In windowed mode records that are not cached are found by value of the primary key.
+    int indexOf(const KDbRecordData* record, int from = 0) const;
     inline void removeFirst() {
+        filterRecordRemoved(0);
         KDbTableViewDataBase::removeFirst();
     }
     inline void removeLast() {
+        filterRecordRemoved(KDbTableViewDataBase::count() - 1);
         KDbTableViewDataBase::removeLast();
     }
     inline void append(KDbRecordData* record) {
         KDbTableViewDataBase::append(record);
+        filterRecordInserted(KDbTableViewDataBase::count() - 1);
     }
     inline void prepend(KDbRecordData* record) {
         KDbTableViewDataBase::prepend(record);
+        filterRecordInserted(0);
     }
     inline KDbTableViewDataConstIterator constBegin() const {
         return KDbTableViewDataBase::constBegin();
@@ -344,6 +425,12 @@ private:
     //! @internal for saveRecordChanges() and saveNewRecord()
     bool saveRecord(KDbRecordData *record, bool insert, bool repaint);
 
+    //! @internal Updates filtered records after inserting record at @a index
+    void filterRecordInserted(int index);
+
+    //! @internal Updates filtered records before removing record at @a index
+    void filterRecordRemoved(int index);
+
     friend class KDbTableViewColumn;
 
     Q_DISABLE_COPY(KDbTableViewData)
@@ -0,0 +1,597 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbBenchmarks.h"
+#include "KDbEscaping_p.h"
+
+#include <KDbConnectionData>
+#include <KDbCursor>
+#include <KDbExpression>
+#include <KDbGlobal>
+#include <KDbNativeStatementBuilder>
+#include <KDbParser>
+#include <KDbPreparedStatement>
+#include <KDbQuerySchema>
+#include <KDbRecordData>
+#include <KDbTableSchema>
+#include <KDbTableViewData>
+#include <KDbTransactionGuard>
+
+#include <QCoreApplication>
+#include <QDate>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryFile>
+#include <QXmlStreamReader>
+
+#include <algorithm>
+
+//! Seed of the generator of fixture data
+static const quint32 fixtureSeed = 20180701;
+
+//! Number of records of the "records" table
+static const int recordCount = 20000;
+
+//! Number of tables loaded by the schemaLoad() benchmark
+static const int schemaTableCount = 50;
+
+//! Number of fields of each of the tables loaded by schemaLoad()
+static const int schemaTableFieldCount = 10;
+
+//! Number of records inserted by each iteration of insert benchmarks
+static const int insertCount = 2000;
+
+//! Number of statements parsed or generated by each iteration
+static const int statementCount = 200;
+
+//! Number of records sorted by the tableViewDataSort() benchmark
+static const int viewRecordCount = 100000;
+
+//! Number of records of table view data deleted, cleared or filtered by the benchmarks
+static const int largeViewRecordCount = 5000000;
+
+//! Number of characters of strings escaped by the escapeString() benchmark
+static const int escapedTextLength = 65536;
+
+//! Number of bytes of BLOBs escaped by the escapeBLOB() benchmark
+static const int escapedBlobSize = 1048576;
+
+namespace {
+
+//! Deterministic pseudo-random generator (LCG) so the data is the same on all platforms
+class Generator
+{
+public:
+    explicit Generator(quint32 seed) : m_state(seed) {}
+
+    //! @return next value from 0 to @a max - 1
+    int bounded(int max) {
+        m_state = m_state * 1664525u + 1013904223u;
+        return int((m_state >> 8) % quint32(max));
+    }
+
+    //! @return word of lowercase letters, 3 to 12 characters long
+    QString word() {
+        const int length = 3 + bounded(10);
+        QString result(length, Qt::Uninitialized);
+        for (int i = 0; i < length; ++i) {
+            result[i] = QLatin1Char(char('a' + bounded(26)));
+        }
+        return result;
+    }
+
+    //! @return values for a record of table created by createRecordsTable()
+    QList<QVariant> record(qint64 id) {
+        return QList<QVariant>() << id << bounded(100000) << bounded(10000000) / 100.0 << word()
+                                 << QDate(2000, 1, 1).addDays(bounded(7000));
+    }
+
+private:
+    quint32 m_state;
+};
+
+/*! @return text of about @a length characters: words separated by spaces or line breaks,
+ with an apostrophe in every @a quoteEvery-th word if it is not 0 and with non-ASCII
+ letters if @a unicode is true. */
+QString generateText(Generator *generator, int length, int quoteEvery, bool unicode)
+{
+    QString result;
+    result.reserve(length + 16);
+    for (int i = 1; result.length() < length; ++i) {
+        result += generator->word();
+        if (unicode && i % 3 == 0) {
+            result += QString::fromUtf8("\xc5\xbc\xc3\xb3\xc5\x82\xe4\xb8\xad");
+        }
+        if (quoteEvery && i % quoteEvery == 0) {
+            result += QLatin1String("'s");
+        }
+        result += QLatin1Char(i % 10 == 0 ? '\n' : ' ');
+    }
+    return result;
+}
+
+//! Hex escaping of BLOBs the way KDb::escapeBLOB() did before using escaping kernels,
+//! used as a baseline in the escapeBLOB() benchmark
+QString legacyEscapeBLOB(const QByteArray &array)
+{
+    QString str;
+    str.reserve(array.size() * 2 + 3);
+    str = QString::fromLatin1("X'");
+    for (int i = 0; i < array.size(); i++) {
+        const unsigned char val = array[i];
+        str.append(QChar::fromLatin1(val / 16 < 10 ? '0' + val / 16 : 'A' + val / 16 - 10));
+        str.append(QChar::fromLatin1(val % 16 < 10 ? '0' + val % 16 : 'A' + val % 16 - 10));
+    }
+    str.append(QLatin1Char('\''));
+    return str;
+}
+
+//! Creates table @a name with (id, num, price, name, created) columns
+KDbTableSchema* createRecordsTable(KDbConnection *conn, const QString &name)
+{
+    KDbTableSchema *table = new KDbTableSchema(name);
+    table->addField(new KDbField("id", KDbField::BigInteger, KDbField::PrimaryKey));
+    table->addField(new KDbField("num", KDbField::Integer));
+    table->addField(new KDbField("price", KDbField::Double));
+    table->addField(new KDbField("name", KDbField::Text));
+    table->addField(new KDbField("created", KDbField::Date));
+    if (!conn->createTable(table)) {
+        qWarning() << conn->result();
+        delete table;
+        return nullptr;
+    }
+    return table;
+}
+
+//! @return table view data with @a count records with keys 0..count-1
+KDbTableViewData* createKeysViewData(int count)
+{
+    KDbTableViewData *data = new KDbTableViewData(KDbField::Integer, KDbField::Text);
+    for (int i = 0; i < count; ++i) {
+        KDbRecordData *record = data->createItem();
+        (*record)[0] = i;
+        data->append(record);
+    }
+    return data;
+}
+
+//! @return "key % 2 = 0" expression
+KDbExpression evenKeyExpression()
+{
+    return KDbBinaryExpression(
+        KDbBinaryExpression(KDbVariableExpression("key"), '%',
+                            KDbConstExpression(KDbToken::INTEGER_CONST, 2)),
+        '=', KDbConstExpression(KDbToken::INTEGER_CONST, 0));
+}
+
+} // namespace
+
+void KDbBenchmarks::initTestCase()
+{
+    QVERIFY(utils.testCreateDb("KDbBenchmarks"));
+    KDbConnection *conn = utils.connection();
+    KDB_VERIFY(conn, conn->useDatabase(), "Failed to use database");
+
+    KDbTransactionGuard tg(conn);
+    QVERIFY(tg.transaction().isActive());
+    KDbTableSchema *records = createRecordsTable(conn, "records");
+    QVERIFY(records);
+    QVERIFY(createRecordsTable(conn, "inserts"));
+    Generator generator(fixtureSeed);
+    for (int i = 1; i <= recordCount; ++i) {
+        KDB_VERIFY(conn, conn->insertRecord(records, generator.record(i)), "Failed to insert record");
+    }
+    for (int i = 1; i <= schemaTableCount; ++i) {
+        KDbTableSchema *table = new KDbTableSchema(QString::fromLatin1("schema_table_%1").arg(i));
+        table->setCaption(QString::fromLatin1("Table %1").arg(i));
+        table->addField(new KDbField("id", KDbField::Integer,
+                                     KDbField::PrimaryKey | KDbField::AutoInc));
+        for (int f = 1; f < schemaTableFieldCount; ++f) {
+            KDbField *field = new KDbField(QString::fromLatin1("field%1").arg(f),
+                                           f % 2 ? KDbField::Text : KDbField::Integer);
+            field->setCaption(QString::fromLatin1("Field %1").arg(f));
+            table->addField(field);
+        }
+        if (!conn->createTable(table)) {
+            delete table;
+            KDB_VERIFY(conn, false, "Failed to create table");
+        }
+    }
+    KDB_VERIFY(conn, tg.commit(), "Failed to commit fixture data");
+}
+
+void KDbBenchmarks::cursorScan_data()
+{
+    QTest::addColumn<bool>("buffered");
+
+    QTest::newRow("unbuffered") << false;
+    QTest::newRow("buffered") << true;
+}
+
+void KDbBenchmarks::cursorScan()
+{
+    QFETCH(bool, buffered);
+    KDbConnection *conn = utils.connection();
+    QBENCHMARK {
+        KDbCursor *cursor = conn->executeQuery(KDbEscapedString("SELECT * FROM records"),
+            buffered ? KDbCursor::Option::Buffered : KDbCursor::Option::None);
+        QVERIFY(cursor);
+        int count = 0;
+        for (cursor->moveFirst(); !cursor->eof(); cursor->moveNext()) {
+            ++count;
+        }
+        QVERIFY(conn->deleteCursor(cursor));
+        QCOMPARE(count, recordCount);
+    }
+}
+
+void KDbBenchmarks::storeCurrentRecord()
+{
+    KDbConnection *conn = utils.connection();
+    KDbCursor *cursor = conn->executeQuery(KDbEscapedString("SELECT * FROM records"));
+    QVERIFY(cursor);
+    KDbRecordData data;
+    QBENCHMARK {
+        int count = 0;
+        for (cursor->moveFirst(); !cursor->eof(); cursor->moveNext()) {
+            QVERIFY(cursor->storeCurrentRecord(&data));
+            ++count;
+        }
+        QCOMPARE(count, recordCount);
+    }
+    QVERIFY(conn->deleteCursor(cursor));
+}
+
+void KDbBenchmarks::preparedStatementInsert()
+{
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *inserts = conn->tableSchema("inserts");
+    QVERIFY(inserts);
+    KDbPreparedStatement statement
+        = conn->prepareStatement(KDbPreparedStatement::InsertStatement, inserts);
+    QVERIFY(statement.isValid());
+    Generator generator(fixtureSeed);
+    QBENCHMARK {
+        KDbTransactionGuard tg(conn);
+        for (int i = 0; i < insertCount; ++i) {
+            QVERIFY(statement.execute(generator.record(m_nextInsertId++)));
+        }
+        QVERIFY(tg.commit());
+    }
+}
+
+void KDbBenchmarks::bulkInsert()
+{
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *inserts = conn->tableSchema("inserts");
+    QVERIFY(inserts);
+    Generator generator(fixtureSeed);
+    QBENCHMARK {
+        KDbTransactionGuard tg(conn);
+        for (int i = 0; i < insertCount; ++i) {
+            QVERIFY(conn->insertRecord(inserts, generator.record(m_nextInsertId++)));
+        }
+        QVERIFY(tg.commit());
+    }
+}
+
+void KDbBenchmarks::schemaLoad()
+{
+    KDbConnectionData cdata;
+    cdata.setDatabaseName(utils.connection()->data().databaseName());
+    const KDbConnectionOptions options(*utils.connection()->options());
+    QBENCHMARK {
+        QScopedPointer<KDbConnection> conn(utils.driver->createConnection(cdata, options));
+        QVERIFY(conn);
+        KDB_VERIFY(conn, conn->connect(), "Failed to connect");
+        KDB_VERIFY(conn, conn->useDatabase(), "Failed to use database");
+        int count = 0;
+        for (const QString &name : conn->tableNames()) {
+            QVERIFY(conn->tableSchema(name));
+            ++count;
+        }
+        QCOMPARE(count, schemaTableCount + 2);
+        QVERIFY(conn->disconnect());
+    }
+}
+
+void KDbBenchmarks::parser_data()
+{
+    QTest::addColumn<QString>("sql");
+
+    QTest::newRow("simple") << QString("SELECT * FROM records");
+    QTest::newRow("where and order") << QString("SELECT id, name, price FROM records "
+        "WHERE num > 100 AND name LIKE 'a%' ORDER BY price DESC");
+    QTest::newRow("expressions") << QString("SELECT id, price * 2 + num AS total, name || 'x' "
+        "FROM records WHERE num >= 10 AND num <= 1000 OR id <> 3");
+    QTest::newRow("join") << QString("SELECT r.id, s.field1 FROM records r, schema_table_1 s "
+        "WHERE r.id = s.id");
+}
+
+void KDbBenchmarks::parser()
+{
+    QFETCH(QString, sql);
+    const KDbEscapedString statement(sql);
+    KDbParser parser(utils.connection());
+    QBENCHMARK {
+        for (int i = 0; i < statementCount; ++i) {
+            QVERIFY(parser.parse(statement));
+            delete parser.query();
+        }
+    }
+}
+
+void KDbBenchmarks::statementBuilder()
+{
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *records = conn->tableSchema("records");
+    QVERIFY(records);
+    KDbQuerySchema query(records);
+    QVERIFY(query.addToWhereExpression(records->field("num"), 100, '>'));
+    KDbNativeStatementBuilder builder(conn, KDb::DriverEscaping);
+    KDbEscapedString sql;
+    QBENCHMARK {
+        for (int i = 0; i < statementCount; ++i) {
+            QVERIFY(builder.generateSelectStatement(&sql, &query));
+        }
+    }
+}
+
+void KDbBenchmarks::tableViewDataSort_data()
+{
+    QTest::addColumn<int>("column");
+
+    QTest::newRow("integer") << 0;
+    QTest::newRow("text") << 1;
+}
+
+void KDbBenchmarks::tableViewDataSort()
+{
+    QFETCH(int, column);
+    KDbTableViewData data(KDbField::Integer, KDbField::Text);
+    Generator generator(fixtureSeed);
+    for (int i = 0; i < viewRecordCount; ++i) {
+        KDbRecordData *record = data.createItem();
+        (*record)[0] = generator.bounded(viewRecordCount);
+        (*record)[1] = generator.word();
+        data.append(record);
+    }
+    bool ascending = true;
+    QBENCHMARK {
+        // order is changed in each iteration so the data is never already sorted
+        data.setSorting(column, ascending ? KDbOrderByColumn::SortOrder::Ascending
+                                          : KDbOrderByColumn::SortOrder::Descending);
+        data.sort();
+        ascending = !ascending;
+    }
+}
+
+void KDbBenchmarks::tableViewDataDeleteRecords()
+{
+    QScopedPointer<KDbTableViewData> data(createKeysViewData(largeViewRecordCount));
+    QList<int> recordsToDelete;
+    for (int i = 0; i < largeViewRecordCount; i += 2) {
+        recordsToDelete.append(i);
+    }
+    QBENCHMARK_ONCE {
+        data->deleteRecords(recordsToDelete);
+    }
+    QCOMPARE(data->count(), largeViewRecordCount / 2);
+}
+
+void KDbBenchmarks::tableViewDataClear()
+{
+    QScopedPointer<KDbTableViewData> data(createKeysViewData(largeViewRecordCount));
+    QBENCHMARK_ONCE {
+        data->clearInternal(false /* !processEvents */);
+    }
+    QCOMPARE(data->count(), 0);
+}
+
+void KDbBenchmarks::tableViewDataFilter()
+{
+    QScopedPointer<KDbTableViewData> data(createKeysViewData(largeViewRecordCount));
+    QBENCHMARK_ONCE {
+        QVERIFY(data->setFilter(evenKeyExpression()));
+    }
+    QCOMPARE(data->filteredCount(), largeViewRecordCount / 2);
+}
+
+void KDbBenchmarks::escapeString_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<int>("kernel"); // -1 for KDb::escapeString() converted to KDbEscapedString
+
+    Generator generator(fixtureSeed);
+    const QString plain(generateText(&generator, escapedTextLength, 0, false));
+    const QString quoted(generateText(&generator, escapedTextLength, 4, false));
+    const QString unicode(generateText(&generator, escapedTextLength, 4, true));
+    const QList<QPair<const char*, int>> kernels{
+        { "QString", -1 },
+        { "scalar", int(KDbEscapingKernel::Scalar) },
+        { "sse2", int(KDbEscapingKernel::Sse2) },
+        { "avx2", int(KDbEscapingKernel::Avx2) } };
+    for (const QPair<const char*, int> &kernel : kernels) {
+        QTest::newRow(qPrintable(QString::fromLatin1("plain/%1").arg(kernel.first)))
+            << plain << kernel.second;
+        QTest::newRow(qPrintable(QString::fromLatin1("quoted/%1").arg(kernel.first)))
+            << quoted << kernel.second;
+        QTest::newRow(qPrintable(QString::fromLatin1("unicode/%1").arg(kernel.first)))
+            << unicode << kernel.second;
+    }
+}
+
+void KDbBenchmarks::escapeString()
+{
+    QFETCH(QString, text);
+    QFETCH(int, kernel);
+    const KDbStringEscapingRules &rules = kdbSqlStringEscapingRules();
+    qint64 size = 0;
+    QBENCHMARK {
+        if (kernel < 0) {
+            size += KDbEscapedString(KDb::escapeString(text)).size();
+        } else {
+            size += kdbEscapeString(text, rules, "'", "'", KDbEscapingKernel(kernel)).size();
+        }
+    }
+    QVERIFY(size > text.length());
+}
+
+void KDbBenchmarks::escapeBLOB_data()
+{
+    QTest::addColumn<int>("kernel"); // -1 for per-character QString escaping
+
+    QTest::newRow("QString") << -1;
+    QTest::newRow("scalar") << int(KDbEscapingKernel::Scalar);
+    QTest::newRow("sse2") << int(KDbEscapingKernel::Sse2);
+    QTest::newRow("avx2") << int(KDbEscapingKernel::Avx2);
+}
+
+void KDbBenchmarks::escapeBLOB()
+{
+    QFETCH(int, kernel);
+    Generator generator(fixtureSeed);
+    QByteArray blob(escapedBlobSize, Qt::Uninitialized);
+    for (int i = 0; i < blob.size(); ++i) {
+        blob[i] = char(generator.bounded(256));
+    }
+    qint64 size = 0;
+    QBENCHMARK {
+        if (kernel < 0) {
+            size += KDbEscapedString(legacyEscapeBLOB(blob)).size();
+        } else {
+            size += kdbEscapeBLOB(blob, KDb::BLOBEscapingType::XHex, KDbEscapingKernel(kernel)).size();
+        }
+    }
+    QVERIFY(size > blob.size());
+}
+
+void KDbBenchmarks::cleanupTestCase()
+{
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+//! Converts benchmark results of QTest's XML log @a xmlFileName to JSON file @a jsonFileName
+static bool writeJson(const QString &xmlFileName, const QString &jsonFileName)
+{
+    QFile xmlFile(xmlFileName);
+    if (!xmlFile.open(QIODevice::ReadOnly)) {
+        qWarning() << "Could not open" << xmlFileName;
+        return false;
+    }
+    QList<QJsonObject> results;
+    QXmlStreamReader xml(&xmlFile);
+    QString function;
+    while (!xml.atEnd()) {
+        if (xml.readNext() != QXmlStreamReader::StartElement) {
+            continue;
+        }
+        const QXmlStreamAttributes attributes(xml.attributes());
+        if (xml.name() == QLatin1String("TestFunction")) {
+            function = attributes.value(QLatin1String("name")).toString();
+        } else if (xml.name() == QLatin1String("BenchmarkResult")) {
+            const QString tag = attributes.value(QLatin1String("tag")).toString();
+            const double value = attributes.value(QLatin1String("value")).toString().toDouble();
+            const int iterations = attributes.value(QLatin1String("iterations")).toString().toInt();
+            QJsonObject result;
+            result.insert(QLatin1String("name"),
+                          tag.isEmpty() ? function : (function + QLatin1Char(':') + tag));
+            result.insert(QLatin1String("function"), function);
+            result.insert(QLatin1String("tag"), tag);
+            result.insert(QLatin1String("metric"),
+                          attributes.value(QLatin1String("metric")).toString());
+            result.insert(QLatin1String("value"), value);
+            result.insert(QLatin1String("iterations"), iterations);
+            results.append(result);
+        }
+    }
+    if (xml.hasError()) {
+        qWarning() << "Could not parse" << xmlFileName << xml.errorString();
+        return false;
+    }
+    // sort by name so the files can be easily compared
+    std::sort(results.begin(), results.end(), [](const QJsonObject &a, const QJsonObject &b) {
+        return a.value(QLatin1String("name")).toString() < b.value(QLatin1String("name")).toString();
+    });
+    QJsonArray resultArray;
+    for (const QJsonObject &result : results) {
+        resultArray.append(result);
+    }
+    QJsonObject fixture;
+    fixture.insert(QLatin1String("seed"), qint64(fixtureSeed));
+    fixture.insert(QLatin1String("records"), recordCount);
+    fixture.insert(QLatin1String("schemaTables"), schemaTableCount);
+    fixture.insert(QLatin1String("schemaTableFields"), schemaTableFieldCount);
+    fixture.insert(QLatin1String("inserts"), insertCount);
+    fixture.insert(QLatin1String("statements"), statementCount);
+    fixture.insert(QLatin1String("viewRecords"), viewRecordCount);
+    fixture.insert(QLatin1String("escapedTextLength"), escapedTextLength);
+    fixture.insert(QLatin1String("escapedBlobSize"), escapedBlobSize);
+    fixture.insert(QLatin1String("escapingKernel"), int(kdbDefaultEscapingKernel()));
+    QJsonObject root;
+    root.insert(QLatin1String("suite"), QLatin1String("kdbbenchmarks"));
+    root.insert(QLatin1String("kdbVersion"), QLatin1String(KDB_VERSION_STRING));
+    root.insert(QLatin1String("qtVersion"), QLatin1String(qVersion()));
+    root.insert(QLatin1String("fixture"), fixture);
+    root.insert(QLatin1String("results"), resultArray);
+
+    QFile jsonFile(jsonFileName);
+    if (!jsonFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Could not write" << jsonFileName;
+        return false;
+    }
+    jsonFile.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    return true;
+}
+
+/*! Usage: kdbbenchmarks [-json <file>] [QTest options] [benchmarks]
+ Results are written to kdbbenchmarks.json by default. */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QStringList args(app.arguments());
+    QString jsonFileName(QLatin1String("kdbbenchmarks.json"));
+    const int jsonIndex = args.indexOf(QLatin1String("-json"));
+    if (jsonIndex > 0) {
+        if (jsonIndex + 1 >= args.count()) {
+            qWarning() << "Missing file name for -json";
+            return 1;
+        }
+        jsonFileName = args.at(jsonIndex + 1);
+        args.erase(args.begin() + jsonIndex, args.begin() + jsonIndex + 2);
+    }
+    // QTest's XML log is converted to JSON, results are also displayed in the console
+    QTemporaryFile xmlFile;
+    if (!xmlFile.open()) {
+        qWarning() << "Could not create temporary file";
+        return 1;
+    }
+    xmlFile.close();
+    args << QLatin1String("-o") << (xmlFile.fileName() + QLatin1String(",xml"))
+         << QLatin1String("-o") << QLatin1String("-,txt");
+
+    KDbBenchmarks benchmarks;
+    const int result = QTest::qExec(&benchmarks, args);
+    if (!writeJson(xmlFile.fileName(), jsonFileName)) {
+        return result == 0 ? 1 : result;
+    }
+    return result;
+}
@@ -0,0 +1,63 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 agent <agent@local>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_BENCHMARKS_H
+#define KDB_BENCHMARKS_H
+
+#include "KDbTestUtils.h"
+
+/**
+ * Benchmarks of KDb hot paths
+ *
+ * A SQLite database with generated data is created in initTestCase(). The data only
+ * depends on constants defined in KDbBenchmarks.cpp so results are reproducible.
+ */
+class KDbBenchmarks : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+
+    void cursorScan_data();
+    void cursorScan();
+    void storeCurrentRecord();
+    void preparedStatementInsert();
+    void bulkInsert();
+    void schemaLoad();
+    void parser_data();
+    void parser();
+    void statementBuilder();
+    void tableViewDataSort_data();
+    void tableViewDataSort();
+    void tableViewDataDeleteRecords();
+    void tableViewDataClear();
+    void tableViewDataFilter();
+    void escapeString_data();
+    void escapeString();
+    void escapeBLOB_data();
+    void escapeBLOB();
+
+    void cleanupTestCase();
+
+private:
+    KDbTestUtils utils;
+    qint64 m_nextInsertId = 1;
+};
+
+#endif
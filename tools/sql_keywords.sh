@@ -9,8 +9,8 @@
 #
 # It extracts keywords from the lexer of the DB sources, deletes keywords that
 # are already going to be escaped because they are part of KDb's SQL dialect,
-# and writes the resulting keywords to a "char *keywords[]" construct in a .cpp 
-# file that can then be used in the driver.
+# and writes the resulting keywords to a perfect hash table (KDbKeywordTable)
+# in a .cpp file that can then be used in the driver.
 #
 # To use:
 # Put the DB source tarballs/sources (e.g. mysql-4.1.7.tar.gz, 
@@ -25,68 +25,26 @@
 
 set -e
 progname="sql_keywords.sh"
+tooldir=`dirname "$0"`
 
 ################################################################################
 # C++ file generator
-# params : array   - scoped datatype and name of the array to generate
-#          include - a file to include (or "" if none)
-#          inFile  - file containing raw keywords
-#          outfile - file to write 
-header () {
-  local array="$1"
+# Writes perfect hash table (KDbKeywordTable) of keywords using sql_keywords_table.py.
+# params : variable - scoped name of the KDbKeywordTable to generate
+#          include  - a file to include, declaring the variable
+#          prefix   - prefix for names of static arrays
+#          inFile   - file containing raw keywords
+#          source   - description of the source of keywords
+#          outfile  - file to write
+table () {
+  local variable="$1"
   local include="$2"
-  local inFile="$3"
-  local outFile="$4"
+  local prefix="$3"
+  local inFile="$4"
+  local source="$5"
+  local outFile="$6"
   echo "Writing keywords in $inFile to $outFile"
-  cat <<EOF1 > "$outFile";
-/* This file is part of the KDE project
-   Copyright (C) 2004 Martin Ellis <martin.ellis@kdemail.net>
-   Copyright (C) 2004 Jarosław Staniek <staniek@kde.org>
-
-   This file has been automatically generated from
-   tools/$progname and $inFile.
-
-   Please edit the $progname, not this file!
-
-   This program is free software; you can redistribute it and/or
-   modify it under the terms of the GNU Library General Public
-   License as published by the Free Software Foundation; either
-   version 2 of the License, or (at your option) any later version.
-
-   This program is distributed in the hope that it will be useful,
-   but WITHOUT ANY WARRANTY; without even the implied warranty of
-   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
-   Library General Public License for more details.
-
-   You should have received a copy of the GNU Library General Public License
-   along with this program; see the file COPYING.  If not, write to
-   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
- * Boston, MA 02110-1301, USA.
-*/
-EOF1
-  if [ "$include" != "" ] ; then
-    echo "#include <$include>" >> "$outFile"
-  fi
-  cat <<EOF2 >> "$outFile";
-
-  ${array}[] = {
-EOF2
-}
-
-body() {
-  local inFile="$1"
-  local outFile="$2"
-  awk '/^[a-zA-Z_0-9]*/ { print "\t\t\""$$1"\","; } ' "$inFile" >> "$outFile"
-}
-
-footer() {
-  local outFile="$1"
-  cat <<EOF >> "$outFile";
-		0
-  };
-}
-EOF
-
+  python "$tooldir/sql_keywords_table.py" "$inFile" "$outFile" "$variable" "$include" "$prefix" "$source"
 }
 
 ################################################################################
@@ -243,7 +201,7 @@ checkTarballs () {
   local appVer
 
   # SQLite (native DB backend) keywords
-  appName="SQLite"
+  appName="Sqlite"
   appVer=sqlite
   inFile="tokenize.c"
   filePrefix="sqlite"
@@ -252,16 +210,14 @@ checkTarballs () {
   fi
   if [ "$appVer.all" -nt "$appVer.new" ] ; then
     getDriverKeywords "kdb.all" "$appVer.all" "$appVer.new"
-    header "const char* const ${appName}Driver::keywords" "${filePrefix}driver.h" "$inFile" "${filePrefix}keywords.cpp"
-    body   "$appVer.new" "${filePrefix}keywords.cpp"
-    footer "${filePrefix}keywords.cpp"
+    table "${appName}Driver::keywords" "${appName}Driver.h" "$filePrefix" "$appVer.new" "$inFile" "${appName}Keywords.cpp"
   fi
 
   ls mysql-*.tar.gz postgresql-*.tar.gz 2>/dev/null | while read tarball ; do
    case "$tarball" in
      mysql-4.1.[0-9\.]*.tar.gz)
        pathInTar="sql/lex.h"
-       appName="MySql"
+       appName="Mysql"
        filePrefix="mysql"
        appVer="${tarball%.tar.gz}"
        if [ ! -r "$appVer.all" ] || [ ! -r "$appVer.new" ] ; then
@@ -272,16 +228,14 @@ checkTarballs () {
 
        if [ "$appVer.all" -nt "$appVer.new" ] ; then
          getDriverKeywords "kdb.all" "$appVer.all" "$appVer.new"
-         header "const char* const ${appName}Driver::keywords" "${filePrefix}driver.h" "$appVer/$pathInTar" "${filePrefix}keywords.cpp"
-         body   "$appVer.new" "${filePrefix}keywords.cpp"
-         footer "${filePrefix}keywords.cpp"
+         table "${appName}Driver::keywords" "${appName}Driver.h" "$filePrefix" "$appVer.new" "$appVer/$pathInTar" "${appName}Keywords.cpp"
        fi
        ;;
 
      postgresql-base-7.4.[0-9\.]*.tar.gz)
        pathInTar="src/backend/parser/keywords.c"
-       appName="pqxxSql"
-       filePrefix="pqxx"
+       appName="Postgresql"
+       filePrefix="postgresql"
        appVer=`echo "${tarball%.tar.gz}" | sed 's/-base//'`
        if [ ! -r "$appVer.all" ] || [ ! -r "$appVer.new" ] ; then
          checkExtracted "$tarball" "$appVer/$pathInTar"
@@ -291,9 +245,7 @@ checkTarballs () {
 
        if [ "$appVer.all" -nt "$appVer.new" ] ; then
          getDriverKeywords "kdb.all" "$appVer.all" "$appVer.new"
-         header "const char* const ${appName}Driver::keywords" "${filePrefix}driver.h" "$appVer/$pathInTar" "${filePrefix}keywords.cpp"
-         body   "$appVer.new" "${filePrefix}keywords.cpp"
-         footer "${filePrefix}keywords.cpp"
+         table "${appName}Driver::keywords" "${appName}Driver.h" "$filePrefix" "$appVer.new" "$appVer/$pathInTar" "${appName}Keywords.cpp"
        fi
        ;;
 
@@ -305,11 +257,8 @@ checkTarballs () {
 }
 
 checkKDbKeywords
-src=`printf "src/parser/KDbSqlScanner.l\n"\
-"   and tools/kdb_keywords.txt"`
-header "const char* const KDbDriverPrivate::kdbSQLKeywords" "Driver_p.h" "$src" "keywords.cpp"
-body "kdb.all" "keywords.cpp"
-footer "keywords.cpp"
+table "KDbDriverPrivate::kdbSQLKeywords" "KDbDriver_p.h" "kdbSql" "kdb.all" \
+  "src/parser/KDbSqlScanner.l and tools/kdb_keywords.txt" "sqlkeywords.cpp"
 
 checkTarballs
 wc -l *.all *.new | awk '{print $2" "$1}' |sort|awk '{print $1"\t"$2}'
@@ -0,0 +1,164 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+from __future__ import print_function, unicode_literals
+#
+#   This file is part of the KDE project
+#   Copyright (C) 2026 agent <agent@local>
+#
+#   SQL keyword table generator
+
+#   Generates a .cpp file with perfect hash table (KDbKeywordTable) of SQL keywords.
+#   Used by sql_keywords.sh.
+#
+#   Syntax:
+#    sql_keywords_table.py KEYWORDS_FILE OUTPUT_FILE VARIABLE INCLUDE PREFIX SOURCE
+#
+#    KEYWORDS_FILE - file with one keyword per line
+#    OUTPUT_FILE - .cpp file to write
+#    VARIABLE - scoped name of the KDbKeywordTable variable to define,
+#               e.g. SqliteDriver::keywords
+#    INCLUDE - header to include, declaring VARIABLE
+#    PREFIX - prefix for names of static arrays, e.g. sqlite
+#    SOURCE - description of source of the keywords for the file's header
+#
+#   The hash function has to be kept in sync with kdbKeywordHash() from
+#   src/KDbKeywordTable_p.h. The generated table is checked at compile time.
+#
+#   This program is free software; you can redistribute it and/or
+#   modify it under the terms of the GNU Library General Public
+#   License as published by the Free Software Foundation; either
+#   version 2 of the License, or (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+#   Library General Public License for more details.
+#
+#   You should have received a copy of the GNU Library General Public License
+#   along with this program; see the file COPYING.  If not, write to
+#   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+#   Boston, MA 02110-1301, USA.
+
+import io
+import sys
+
+MASK = 0xffffffff
+MAX_DISPLACEMENT = 1000000
+
+def keyword_hash(word, seed):
+    """ Equivalent of kdbKeywordHash() """
+    h = 2166136261 ^ ((seed * 0x9e3779b9) & MASK)
+    for c in word.upper():
+        h = ((h ^ ord(c)) * 16777619) & MASK
+    h = ((h ^ (h >> 15)) * 0x2c1b3c6d) & MASK
+    return h ^ (h >> 12)
+
+def power_of_two(n):
+    result = 1
+    while result < n:
+        result *= 2
+    return result
+
+def build_table(keywords):
+    """ Hash and displace: returns (slots, displacements) """
+    slot_count = power_of_two(2 * len(keywords))
+    bucket_count = power_of_two(max(1, len(keywords) // 2))
+    buckets = [[] for i in range(bucket_count)]
+    for keyword in keywords:
+        buckets[keyword_hash(keyword, 0) & (bucket_count - 1)].append(keyword)
+    slots = [None] * slot_count
+    displacements = [0] * bucket_count
+    # largest buckets first, they are the hardest to place
+    order = sorted(range(bucket_count), key=lambda b: (-len(buckets[b]), b))
+    for b in order:
+        bucket = buckets[b]
+        if len(bucket) > 1:
+            for d in range(1, MAX_DISPLACEMENT):
+                positions = [keyword_hash(k, d) & (slot_count - 1) for k in bucket]
+                if len(set(positions)) == len(positions) \
+                   and all(slots[p] is None for p in positions):
+                    break
+            else:
+                raise Exception('No displacement found for bucket %d' % b)
+            for keyword, position in zip(bucket, positions):
+                slots[position] = keyword
+            displacements[b] = d
+    # single keywords are put to free slots directly; empty buckets point to any slot,
+    # the final comparison fails for words hashed to them
+    free_slots = [i for i in range(slot_count) if slots[i] is None]
+    for b in order:
+        if len(buckets[b]) == 1:
+            position = free_slots.pop(0)
+            slots[position] = buckets[b][0]
+            displacements[b] = -position - 1
+        elif not buckets[b]:
+            displacements[b] = -1
+    return slots, displacements
+
+def write_table(keywords_file, output_file, variable, include, prefix, source):
+    with io.open(keywords_file, encoding='utf-8') as f:
+        keywords = []
+        for line in f:
+            keyword = line.strip().upper()
+            if keyword and keyword not in keywords:
+                keywords.append(keyword)
+    slots, displacements = build_table(keywords)
+    out = io.open(output_file, 'w', encoding='utf-8')
+    out.write('''/* This file is part of the KDE project
+   Copyright (C) 2004 Martin Ellis <martin.ellis@kdemail.net>
+   Copyright (C) 2004-2018 Jarosław Staniek <staniek@kde.org>
+
+   This file has been automatically generated from
+   tools/sql_keywords.sh and %s.
+
+   Please edit the sql_keywords.sh, not this file!
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "%s"
+#include "KDbKeywordTable_p.h"
+
+//! %d keywords in %d slots
+static constexpr const char* %sKeywordSlots[] = {
+''' % (source, include, len(keywords), len(slots), prefix))
+    for i in range(0, len(slots), 4):
+        items = ['"%s"' % s if s else 'nullptr' for s in slots[i:i + 4]]
+        out.write('    %s,\n' % ', '.join(items))
+    out.write('''};
+
+static constexpr int %sKeywordDisplacements[] = {
+''' % prefix)
+    for i in range(0, len(displacements), 10):
+        items = ['%d' % d for d in displacements[i:i + 10]]
+        out.write('    %s,\n' % ', '.join(items))
+    out.write('''};
+
+static constexpr KDbKeywordTable %sKeywordTable = {
+    %sKeywordSlots, %d, %sKeywordDisplacements, %d
+};
+
+static_assert(%sKeywordTable.isValid(), "Invalid keyword table");
+
+const KDbKeywordTable %s = %sKeywordTable;
+''' % (prefix, prefix, len(slots), prefix, len(displacements), prefix, variable, prefix))
+    out.close()
+
+if __name__ == '__main__':
+    if len(sys.argv) != 7:
+        print('Usage: %s KEYWORDS_FILE OUTPUT_FILE VARIABLE INCLUDE PREFIX SOURCE' % sys.argv[0])
+        sys.exit(1)
+    write_table(*sys.argv[1:])